@@ -52,7 +52,9 @@
 #include "units/udisplay.hpp"
 #include "units/unit.hpp"
 #include "units/types.hpp"
+#include <map>
 #include <optional>
+#include <sstream>
 #include "whiteboard/manager.hpp"
 #include "wml_exception.hpp"
 
@@ -388,16 +390,107 @@ battle_context::battle_context(
 	defender_stats_.reset(new battle_context_unit_stats(defender, d_loc, d_wep_index, false, attacker, a_loc, a_wep, units));
 }
 
+namespace
+{
+/** A memoized fight outcome, owning the stats its combatants reference. */
+struct combat_cache_entry
+{
+	combat_cache_entry(const battle_context_unit_stats& att, const battle_context_unit_stats& def)
+		: attacker_stats(att)
+		, defender_stats(def)
+		, attacker(attacker_stats)
+		, defender(defender_stats)
+	{
+		attacker.fight(defender);
+	}
+
+	battle_context_unit_stats attacker_stats;
+	battle_context_unit_stats defender_stats;
+	combatant attacker;
+	combatant defender;
+};
+
+constexpr std::size_t combat_cache_max_size = 4096;
+
+std::map<std::string, combat_cache_entry> combat_cache;
+std::size_t combat_cache_lookups = 0;
+std::size_t combat_cache_hits = 0;
+
+/** Serializes the fields of @a s that determine a fight's outcome. */
+void append_combat_cache_key(std::ostringstream& key, const battle_context_unit_stats& s)
+{
+	// Note that experience, max_experience and level matter: fight()
+	// considers forced level-ups. backstab is already baked into damage.
+	key << s.hp << '|' << s.max_hp << '|' << s.chance_to_hit << '|' << s.damage << '|' << s.slow_damage << '|'
+		<< s.drain_percent << '|' << s.drain_constant << '|' << s.num_blows << '|' << s.swarm_min << '|'
+		<< s.swarm_max << '|' << s.rounds << '|' << s.experience << '|' << s.max_experience << '|' << s.level << '|'
+		<< s.is_slowed << s.is_poisoned << s.slows << s.drains << s.petrifies << s.plagues << s.poisons << s.swarm
+		<< s.firststrike << s.disable;
+}
+
+/**
+ * Returns the fight outcome for the given stats pair, simulating it only if
+ * no identical pairing has been evaluated before. The AI rebuilds
+ * battle_context objects for the same matchups thousands of times per turn,
+ * so the hit rate is typically high; it is logged periodically to the
+ * engine/attack domain.
+ */
+const combat_cache_entry& memoized_outcome(
+		const battle_context_unit_stats& att, const battle_context_unit_stats& def)
+{
+	std::ostringstream key_stream;
+	append_combat_cache_key(key_stream, att);
+	key_stream << '/';
+	append_combat_cache_key(key_stream, def);
+	std::string key = key_stream.str();
+
+	++combat_cache_lookups;
+	if(combat_cache_lookups % 8192 == 0) {
+		DBG_AT << "combat outcome cache: " << combat_cache_hits << " hits / " << combat_cache_lookups
+			   << " lookups, " << combat_cache.size() << " entries\n";
+	}
+
+	const auto it = combat_cache.find(key);
+	if(it != combat_cache.end()) {
+		++combat_cache_hits;
+		return it->second;
+	}
+
+	if(combat_cache.size() >= combat_cache_max_size) {
+		combat_cache.clear();
+	}
+
+	return combat_cache
+		.emplace(std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(att, def))
+		.first->second;
+}
+
+} // namespace
+
 void battle_context::simulate(const combatant* prev_def)
 {
 	assert((attacker_combatant_.get() != nullptr) == (defender_combatant_.get() != nullptr));
 	assert(attacker_stats_);
 	assert(defender_stats_);
-	if(!attacker_combatant_) {
-		attacker_combatant_.reset(new combatant(*attacker_stats_));
-		defender_combatant_.reset(new combatant(*defender_stats_, prev_def));
-		attacker_combatant_->fight(*defender_combatant_);
+
+	if(attacker_combatant_) {
+		return;
 	}
+
+	if(!prev_def) {
+		// The cached combatants reference the entry's own stats copies;
+		// rebind copies of them to this context's stats.
+		const combat_cache_entry& entry = memoized_outcome(*attacker_stats_, *defender_stats_);
+		attacker_combatant_.reset(new combatant(entry.attacker, *attacker_stats_));
+		defender_combatant_.reset(new combatant(entry.defender, *defender_stats_));
+		return;
+	}
+
+	// Cumulative calculations depend on the previous defender distribution,
+	// which is not part of the cache key; simulate those directly.
+	attacker_combatant_.reset(new combatant(*attacker_stats_));
+	defender_combatant_.reset(new combatant(*defender_stats_, prev_def));
+	attacker_combatant_->fight(*defender_combatant_);
 }
 
 // more like a factory method than a constructor, always calls one of the other constructors.
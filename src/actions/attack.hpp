@@ -212,6 +212,12 @@ public:
 	const combatant& get_attacker_combatant(const combatant* prev_def = nullptr);
 	const combatant& get_defender_combatant(const combatant* prev_def = nullptr);
 
+	/** Whether the fight outcome has already been simulated. */
+	bool has_simulation() const
+	{
+		return attacker_combatant_ != nullptr;
+	}
+
 	/** Given this harm_weight, is this attack better than that? */
 	bool better_attack(class battle_context& that, double harm_weight);
 	/** Given this harm_weight, is this attack better than that? */
@@ -163,7 +163,7 @@ void undo_list::add_dummy()
 /**
  * Adds a dismissal to the undo stack.
  */
-void undo_list::add_dismissal(const unit_const_ptr u)
+void undo_list::add_dismissal(const unit_ptr& u)
 {
 	add(new undo::dismiss_action(u));
 }
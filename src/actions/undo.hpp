@@ -57,7 +57,7 @@ public:
 	/** Adds an auto-shroud toggle to the undo stack. */
 	void add_dummy();
 	/** Adds a dismissal to the undo stack. */
-	void add_dismissal(const unit_const_ptr u);
+	void add_dismissal(const unit_ptr& u);
 	/** Adds a move to the undo stack. */
 	void add_move(const unit_const_ptr u,
 	              const std::vector<map_location>::const_iterator & begin,
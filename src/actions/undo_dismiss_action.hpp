@@ -27,9 +27,12 @@ struct dismiss_action : undo_action
 	unit_ptr dismissed_unit;
 
 
-	explicit dismiss_action(const unit_const_ptr dismissed)
+	// The dismissed unit is about to be removed from the recall list, so
+	// nothing else keeps it; share the existing object rather than
+	// deep-copying it into the undo stack.
+	explicit dismiss_action(const unit_ptr& dismissed)
 		: undo_action()
-		, dismissed_unit(make_unit_ptr(*dismissed))
+		, dismissed_unit(dismissed)
 	{
 	}
 	explicit dismiss_action(const config & cfg, const config & unit_cfg)
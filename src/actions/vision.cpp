@@ -252,18 +252,21 @@ bool shroud_clearer::clear_loc(team &tm, const map_location &loc,
 				const map_location corner(-1, map.h());
 				tm.clear_shroud(corner);
 				tm.clear_fog(corner);
+				display::get_singleton()->invalidate_minimap_loc(corner);
 			}
 			// Lower-right corner, odd width:
 			else if ( is_odd(map.w())  &&  loc.x == map.w()-1  &&  loc.y == map.h()-1 ) {
 				const map_location corner(map.w(), map.h());
 				tm.clear_shroud(corner);
 				tm.clear_fog(corner);
+				display::get_singleton()->invalidate_minimap_loc(corner);
 			}
 			// Upper-right corner, even width:
 			else if ( is_even(map.w())  &&  loc.x == map.w()-1  &&  loc.y == 0) {
 				const map_location corner(map.w(), -1);
 				tm.clear_shroud(corner);
 				tm.clear_fog(corner);
+				display::get_singleton()->invalidate_minimap_loc(corner);
 			}
 		}
 	}
@@ -271,6 +274,7 @@ bool shroud_clearer::clear_loc(team &tm, const map_location &loc,
 	// Possible screen invalidation.
 	if ( was_fogged ) {
 		display::get_singleton()->invalidate(loc);
+		display::get_singleton()->invalidate_minimap_loc(loc);
 		// Need to also invalidate adjacent hexes to get rid of the "fog edge" graphics.
 		for(const map_location& adj : get_adjacent_tiles(loc)) {
 			display::get_singleton()->invalidate(adj);
@@ -489,6 +493,60 @@ bool shroud_clearer::clear_unit(const map_location &view_loc, const unit &viewer
 }
 
 
+/**
+ * Clears shroud (and fog) for @a view_team around every unit of @a side.
+ *
+ * The sight flood of each unit is computed first and the results merged,
+ * remembering the first unit whose flood reached each hex so that sighted
+ * events keep the attribution the per-unit loop would have produced. Only
+ * then is the team's map touched, so hexes covered by several overlapping
+ * vision ranges are cleared and checked for uncovered units exactly once.
+ * End-of-turn fog recalculation on crowded maps spends most of its time in
+ * that overlap.
+ *
+ * @return whether or not information was uncovered (i.e. returns true if any
+ *         locations in visual range were fogged/shrouded under shared vision/maps).
+ */
+bool shroud_clearer::clear_side(team &view_team, int side,
+                                const std::set<map_location>* known_units)
+{
+	// One jamming map serves every flood.
+	if ( view_team_ != &view_team )
+		calculate_jamming(&view_team);
+
+	// Compute and merge the sight floods.
+	std::map<map_location, std::pair<std::size_t, map_location>> seen;
+	for (const unit &u : resources::gameboard->units())
+	{
+		if ( u.side() != side )
+			continue;
+		const map_location & view_loc = u.get_location();
+		pathfind::vision_path sight(u, view_loc, jamming_);
+		for (const pathfind::paths::step &dest : sight.destinations)
+			seen.emplace(dest.curr, std::make_pair(u.underlying_id(), view_loc));
+		for (const map_location &dest : sight.edges)
+			seen.emplace(dest, std::make_pair(u.underlying_id(), view_loc));
+	}
+
+	// Apply the merged set. (Passing the sighter's location as the
+	// event_non_loc keeps units from sighting themselves, just as the
+	// per-unit clear_unit() calls did.)
+	bool cleared_something = false;
+	std::size_t enemies = 0, friends = 0;
+	for (const auto & entry : seen) {
+		const map_location & loc = entry.first;
+		const std::size_t viewer_id = entry.second.first;
+		const map_location & viewer_loc = entry.second.second;
+		const bool known = known_units  &&  known_units->count(loc) != 0;
+		if ( clear_loc(view_team, loc, viewer_loc, viewer_loc, viewer_id,
+		               !known, enemies, friends) )
+			cleared_something = true;
+	}
+
+	return cleared_something;
+}
+
+
 /**
  * Clears shroud (and fog) at the provided location and its immediate neighbors.
  * This is an aid for the [teleport] action, allowing the destination to be
@@ -588,7 +646,9 @@ game_events::pump_result_t shroud_clearer::fire_events()
 void shroud_clearer::invalidate_after_clear()
 {
 	display::get_singleton()->invalidate_game_status();
-	display::get_singleton()->recalculate_minimap();
+	// The cleared hexes were marked on the minimap by clear_loc(), so a
+	// redraw updating just those cells suffices here.
+	display::get_singleton()->redraw_minimap();
 	display::get_singleton()->labels().recalculate_shroud();
 	// The tiles are invalidated as they are cleared, so no need
 	// to invalidate them here.
@@ -729,13 +789,12 @@ void recalculate_fog(int side)
 	// Invalidate the screen before clearing the shroud.
 	// This speeds up the invalidations within clear_shroud_unit().
 	display::get_singleton()->invalidate_all();
+	// Refogging changes hexes that the per-cell minimap tracking doesn't
+	// see, so a full minimap recalculation is needed.
+	display::get_singleton()->recalculate_minimap();
 
 	shroud_clearer clearer;
-	for (const unit &u : resources::gameboard->units())
-	{
-		if ( u.side() == side )
-			clearer.clear_unit(u.get_location(), u, tm, &visible_locs);
-	}
+	clearer.clear_side(tm, side, &visible_locs);
 	// Update the screen.
 	clearer.invalidate_after_clear();
 
@@ -767,11 +826,7 @@ bool clear_shroud(int side, bool reset_fog, bool fire_events)
 	bool result = false;
 
 	shroud_clearer clearer;
-	for (const unit &u : resources::gameboard->units())
-	{
-		if ( u.side() == side )
-			result |= clearer.clear_unit(u.get_location(), u, tm);
-	}
+	result |= clearer.clear_side(tm, side);
 	// Update the screen.
 	if ( result )
 		clearer.invalidate_after_clear();
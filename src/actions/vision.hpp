@@ -132,6 +132,14 @@ public:
 	                bool can_delay = false, bool invalidate = true,
 	                bool instant = true);
 
+	/**
+	 * Clears shroud (and fog) around every unit belonging to @a side.
+	 * The independent per-unit sight floods are computed up front and
+	 * merged, so overlapping vision ranges clear each hex only once.
+	 */
+	bool clear_side(team &view_team, int side,
+	                const std::set<map_location>* known_units = nullptr);
+
 	/** Clears shroud (and fog) at the provided location and its immediate neighbors. */
 	bool clear_dest(const map_location &dest, const unit &viewer);
 
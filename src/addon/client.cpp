@@ -19,6 +19,7 @@
 #include "addon/state.hpp"
 #include "addon/validation.hpp"
 #include "cursor.hpp"
+#include "filesystem.hpp"
 #include "font/pango/escape.hpp"
 #include "formula/string_utils.hpp"
 #include "gettext.hpp"
@@ -33,6 +34,7 @@
 #include "serialization/utf8_exception.hpp"
 #include "utils/parse_network_address.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "addon/client.hpp"
@@ -120,12 +122,125 @@ bool addons_client::request_addons_list(config& cfg)
 	/** @todo FIXME: get rid of this legacy "campaign"/"campaigns" silliness
 	 */
 
+	// When the server can serve list deltas and a cached copy of the list
+	// exists, only ask for the campaigns changed since the cached timestamp.
+	// Routine refreshes then transfer kilobytes instead of the full list.
+	config cached;
+	if(server_supports("list:sync") && load_addons_list_cache(cached) && !cached["timestamp"].empty()) {
+		config request;
+		config& body = request.add_child("request_campaign_list");
+		body["sync"] = true;
+		// Resume one second early, so entries uploaded while the previous
+		// list response was being built are not missed. Resending a couple
+		// of entries is harmless, the merge simply overwrites them.
+		body["after"] = cached["timestamp"].to_time_t() - 1;
+
+		send_request(request, response_buf);
+		wait_for_transfer_done(_("Downloading list of add-ons..."));
+
+		if(update_last_error(response_buf)) {
+			return false;
+		}
+
+		const config& delta = response_buf.child("campaigns");
+		if(delta && delta["sync"].to_bool() && apply_addons_list_delta(cached, delta)) {
+			save_addons_list_cache(cached);
+			std::swap(cfg, cached);
+			return true;
+		}
+
+		// The delta could not be reconciled (e.g. an unhidden add-on whose
+		// timestamp predates the cache); fall through to a full refresh.
+		LOG_ADDONS << "list delta could not be applied, requesting the full list\n";
+		response_buf.clear();
+	}
+
 	send_simple_request("request_campaign_list", response_buf);
 	wait_for_transfer_done(_("Downloading list of add-ons..."));
 
 	std::swap(cfg, response_buf.child("campaigns"));
 
-	return !update_last_error(response_buf);
+	if(update_last_error(response_buf)) {
+		return false;
+	}
+
+	save_addons_list_cache(cfg);
+	return true;
+}
+
+bool addons_client::apply_addons_list_delta(config& cached, const config& delta)
+{
+	// Replace or add the entries the server reports as changed.
+	for(const config& item : delta.child_range("campaign")) {
+		if(config& existing = cached.find_child("campaign", "name", item["name"])) {
+			existing = item;
+		} else {
+			cached.add_child("campaign", item);
+		}
+	}
+
+	// The delta carries the full set of visible ids, so deletions (and
+	// freshly hidden add-ons) can be detected without a full transfer.
+	const std::set<std::string> ids = utils::split_set(delta["ids"].str());
+
+	cached.remove_children("campaign", [&ids](const config& item) {
+		return ids.count(item["name"].str()) == 0;
+	});
+
+	// An id the server lists but we don't have after merging means an entry
+	// became visible again without a timestamp bump; only a full refresh can
+	// recover its data.
+	std::set<std::string> have;
+	for(const config& item : cached.child_range("campaign")) {
+		have.insert(item["name"].str());
+	}
+
+	for(const std::string& id : ids) {
+		if(have.count(id) == 0) {
+			return false;
+		}
+	}
+
+	cached["timestamp"] = delta["timestamp"];
+	return true;
+}
+
+std::string addons_client::addons_list_cache_path() const
+{
+	std::string key = addr_;
+	std::replace(key.begin(), key.end(), ':', '_');
+	return filesystem::get_cache_dir() + "/addons-list-" + key + ".gz";
+}
+
+bool addons_client::load_addons_list_cache(config& cfg)
+{
+	const std::string path = addons_list_cache_path();
+	if(!filesystem::file_exists(path)) {
+		return false;
+	}
+
+	try {
+		filesystem::scoped_istream in = filesystem::istream_file(path);
+		read_gz(cfg, *in);
+	} catch(const std::exception& e) {
+		WRN_ADDONS << "could not read add-ons list cache " << path << ": " << e.what() << '\n';
+		cfg.clear();
+		return false;
+	}
+
+	return !cfg.empty();
+}
+
+void addons_client::save_addons_list_cache(const config& cfg)
+{
+	const std::string path = addons_list_cache_path();
+
+	try {
+		filesystem::scoped_ostream out = filesystem::ostream_file(path);
+		write_gz(*out, cfg);
+	} catch(const std::exception& e) {
+		WRN_ADDONS << "could not write add-ons list cache " << path << ": " << e.what() << '\n';
+	}
 }
 
 bool addons_client::request_distribution_terms(std::string& terms)
@@ -303,7 +418,13 @@ bool addons_client::delete_remote_addon(const std::string& id, std::string& resp
 	return !update_last_error(response_buf);
 }
 
-bool addons_client::download_addon(config& archive_cfg, const std::string& id, const std::string& title, const version_info& version, bool increase_downloads)
+bool addons_client::download_addon(config& archive_cfg, const std::string& id, const std::string& title, const version_info& version, bool increase_downloads, bool force_full_pack)
+{
+	start_download_addon(archive_cfg, id, version, increase_downloads, force_full_pack);
+	return finish_download_addon(archive_cfg, title);
+}
+
+void addons_client::start_download_addon(config& archive_cfg, const std::string& id, const version_info& version, bool increase_downloads, bool force_full_pack)
 {
 	archive_cfg.clear();
 
@@ -313,14 +434,26 @@ bool addons_client::download_addon(config& archive_cfg, const std::string& id, c
 	request_body["name"] = id;
 	request_body["increase_downloads"] = increase_downloads;
 	request_body["version"] = version.str();
-	request_body["from_version"] = get_addon_version_info(id);
-
-	utils::string_map i18n_symbols;
-	i18n_symbols["addon_title"] = font::escape_text(title);
+	if(!force_full_pack) {
+		request_body["from_version"] = get_addon_version_info(id);
+	}
 
 	LOG_ADDONS << "downloading " << id << '\n';
 
 	send_request(request_buf, archive_cfg);
+
+	// Flush the request onto the wire so the server starts working on it
+	// right away. Polling stops making progress once the write has been
+	// handed to the socket.
+	while(conn_->bytes_written() < conn_->bytes_to_write() && conn_->poll() > 0) {
+	}
+}
+
+bool addons_client::finish_download_addon(config& archive_cfg, const std::string& title)
+{
+	utils::string_map i18n_symbols;
+	i18n_symbols["addon_title"] = font::escape_text(title);
+
 	wait_for_transfer_done(VGETTEXT("Downloading add-on <i>$addon_title</i>...", i18n_symbols));
 
 	return !update_last_error(archive_cfg);
@@ -361,7 +494,36 @@ bool addons_client::install_addon(config& archive_cfg, const addon_info& info)
 
 		LOG_ADDONS << "Update completed.\n";
 
-		//#TODO: hash verification ???
+		// Check the result against the server's hash index for the add-on, so
+		// a stale or broken delta chain can't leave a corrupt install behind.
+		// On a mismatch, fall back to fetching a fresh full pack.
+		config remote_index, index_request;
+		index_request.add_child("request_campaign_hash")["name"] = info.id;
+		send_request(index_request, remote_index);
+		wait_for_transfer_done(_("Requesting file index..."));
+
+		// Servers without index files for this add-on respond with an error;
+		// in that case there's nothing to verify against.
+		if(!remote_index.child("error")) {
+			config local_data;
+			archive_addon(info.id, local_data);
+
+			if(!contains_hashlist(local_data, remote_index) || !contains_hashlist(remote_index, local_data)) {
+				ERR_ADDONS << "update pack installation for " << info.id
+						   << " does not match the server's file index, fetching a full pack instead\n";
+
+				config full_archive;
+				if(!download_addon(full_archive, info.id, info.title, info.current_version, false, true)) {
+					return false;
+				}
+
+				// The full pack takes the non-delta branch below, so this
+				// cannot recurse further.
+				return install_addon(full_archive, info);
+			}
+
+			LOG_ADDONS << "file index check passed\n";
+		}
 	} else {
 		LOG_ADDONS << "Received a full pack for the addon '" << info.id << "'\n";
 
@@ -412,6 +574,62 @@ bool addons_client::try_fetch_addon(const addon_info & addon)
 	}
 }
 
+std::vector<std::string> addons_client::try_fetch_addons(const std::vector<const addon_info*>& batch)
+{
+	std::vector<std::string> failed_titles;
+
+	if(batch.empty()) {
+		return failed_titles;
+	}
+
+	// Two archives suffice: one being installed, one being received.
+	config archives[2];
+
+	const auto start_download = [this, &batch, &archives](std::size_t i) {
+		const addon_info& next = *batch[i];
+		start_download_addon(archives[i % 2], next.id, next.current_version, !is_addon_installed(next.id));
+	};
+
+	start_download(0);
+
+	for(std::size_t i = 0; i < batch.size(); ++i) {
+		const addon_info& addon = *batch[i];
+		config& archive = archives[i % 2];
+
+		bool ok = finish_download_addon(archive, addon.display_title_full());
+
+		// Installing an update pack talks to the server again (file index
+		// check, possibly a full re-download), so only a full pack allows
+		// requesting the next add-on before unpacking this one.
+		const bool delta_pack = ok && (archive.has_child("removelist") || archive.has_child("addlist"));
+
+		if(!delta_pack && i + 1 < batch.size()) {
+			start_download(i + 1);
+		}
+
+		if(ok) {
+			ok = install_addon(archive, addon);
+		}
+
+		if(delta_pack && i + 1 < batch.size()) {
+			start_download(i + 1);
+		}
+
+		if(!ok) {
+			const std::string& server_error = get_last_server_error();
+			if(!server_error.empty()) {
+				gui2::show_error_message(
+					_("The server responded with an error:") + "\n" + server_error);
+			}
+			failed_titles.push_back(addon.title);
+		}
+
+		archive.clear();
+	}
+
+	return failed_titles;
+}
+
 addons_client::install_result addons_client::do_resolve_addon_dependencies(const addons_list& addons, const addon_info& addon)
 {
 	install_result result;
@@ -494,16 +712,19 @@ addons_client::install_result addons_client::do_resolve_addon_dependencies(const
 	// Install dependencies now.
 	//
 
-	std::vector<std::string> failed_titles;
+	std::vector<const addon_info*> to_fetch;
+	to_fetch.reserve(missing_deps.size());
 
 	for(const std::string& dep : missing_deps) {
-		const addon_info& missing_addon = addons.at(dep);
+		to_fetch.push_back(&addons.at(dep));
+	}
 
-		if(!try_fetch_addon(missing_addon)) {
-			failed_titles.push_back(missing_addon.title);
-		} else {
-			result.wml_changed = true;
-		}
+	// Fetching the whole batch at once lets the downloads overlap with the
+	// installations instead of paying a round trip per dependency.
+	const std::vector<std::string> failed_titles = try_fetch_addons(to_fetch);
+
+	if(failed_titles.size() < to_fetch.size()) {
+		result.wml_changed = true;
 	}
 
 	if(!failed_titles.empty()) {
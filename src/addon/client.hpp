@@ -245,8 +245,37 @@ private:
 	* @param version             Specifies an add-on version to download.
 	* @param increase_downloads  Whether to request the server to increase the add-on's
 	*                            download count or not (e.g. when upgrading).
+	* @param force_full_pack     Don't advertise the installed version to the server,
+	*                            so it sends a full pack instead of an update sequence
+	*                            (e.g. after a failed delta update).
 	*/
-	bool download_addon(config& archive_cfg, const std::string& id, const std::string& title, const version_info& version, bool increase_downloads = true);
+	bool download_addon(config& archive_cfg, const std::string& id, const std::string& title, const version_info& version, bool increase_downloads = true, bool force_full_pack = false);
+
+	/**
+	* Requests an add-on from the server without waiting for the response.
+	*
+	* The request is flushed onto the wire, so the server starts preparing
+	* and transmitting the archive while the caller does other work
+	* (typically installing a previously downloaded archive). The transfer
+	* must be completed with finish_download_addon() before any other
+	* request is sent over the connection.
+	*/
+	void start_download_addon(config& archive_cfg, const std::string& id, const version_info& version, bool increase_downloads = true, bool force_full_pack = false);
+
+	/** Completes a transfer begun by start_download_addon() and checks it for errors. */
+	bool finish_download_addon(config& archive_cfg, const std::string& title);
+
+	/**
+	* Downloads and installs a batch of add-ons, in the given order.
+	*
+	* Where possible the next add-on's request is pipelined: it is sent
+	* before the previous archive is unpacked, so the server prepares and
+	* transmits one archive while the client installs another instead of
+	* sitting out a full round trip per add-on.
+	*
+	* @return The titles of the add-ons that could not be fetched or installed.
+	*/
+	std::vector<std::string> try_fetch_addons(const std::vector<const addon_info*>& batch);
 
 	/**
 	* Installs the specified add-on using an archive received from the server.
@@ -273,6 +302,28 @@ private:
 	/** Makes sure the add-ons server connection is working. */
 	void check_connected() const;
 
+	/**
+	 * Reads the cached copy of this server's add-ons list, if one exists.
+	 *
+	 * The cache keeps the server's timestamp attribute, which is the point
+	 * request_addons_list() resumes from when asking for a list delta.
+	 */
+	bool load_addons_list_cache(config& cfg);
+
+	/** Stores @a cfg as the cached add-ons list for this server. */
+	void save_addons_list_cache(const config& cfg);
+
+	/**
+	 * Merges a list delta from the server into @a cached.
+	 *
+	 * @return @a true on success, @a false if the result could not be
+	 *         reconciled and a full list refresh is required.
+	 */
+	bool apply_addons_list_delta(config& cached, const config& delta);
+
+	/** Returns the path of the on-disk add-ons list cache for this server. */
+	std::string addons_list_cache_path() const;
+
 	/**
 	 * Sends a request to the add-ons server.
 	 *
@@ -263,10 +263,13 @@ void protect_goal::add_targets(std::back_insert_iterator< std::vector< target >>
 	// Look for directions to protect a specific location or specific unit.
 	for (const map_location &loc : items)
 	{
-		for (const unit &u : units)
+		// Only units within radius_ - 1 hexes can be threats; let the unit
+		// map's spatial index find them instead of scanning every unit.
+		for (const unit_map::unit_iterator &ui : units.units_in_radius(loc, radius_ - 1))
 		{
+			const unit &u = *ui;
 			int distance = distance_between(u.get_location(), loc);
-			if (current_team().is_enemy(u.side()) && distance < radius_ &&
+			if (current_team().is_enemy(u.side()) &&
 			    !u.invisible(u.get_location()))
 			{
 				DBG_AI_GOAL << "side " << get_side() << ": in " << goal_type << ": found threat target. " << u.get_location() << " is a threat to "<< loc << '\n';
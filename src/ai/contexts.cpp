@@ -174,6 +174,10 @@ readonly_context_impl::readonly_context_impl(side_context &context, const config
 	dstsrc_(),enemy_dstsrc_(),
 	enemy_possible_moves_(),
 	enemy_srcdst_(),
+	fullmove_dstsrc_(),
+	fullmove_maps_valid_(false),
+	fullmove_possible_moves_(),
+	fullmove_srcdst_(),
 	grouping_(),
 	goals_(),
 	keeps_(),
@@ -592,6 +596,30 @@ const move_map& readonly_context_impl::get_enemy_srcdst() const
 	return enemy_srcdst_;
 }
 
+const move_map& readonly_context_impl::get_fullmove_dstsrc() const
+{
+	if (!fullmove_maps_valid_) {
+		recalculate_move_maps_fullmove();
+	}
+	return fullmove_dstsrc_;
+}
+
+const moves_map& readonly_context_impl::get_fullmove_possible_moves() const
+{
+	if (!fullmove_maps_valid_) {
+		recalculate_move_maps_fullmove();
+	}
+	return fullmove_possible_moves_;
+}
+
+const move_map& readonly_context_impl::get_fullmove_srcdst() const
+{
+	if (!fullmove_maps_valid_) {
+		recalculate_move_maps_fullmove();
+	}
+	return fullmove_srcdst_;
+}
+
 engine_ptr readonly_context_impl::get_engine_by_cfg(const config& cfg)
 {
 	std::string engine_name = cfg["engine"];
@@ -862,6 +890,7 @@ void readonly_context_impl::invalidate_move_maps() const
 {
 	move_maps_valid_ = false;
 	move_maps_enemy_valid_ = false;
+	fullmove_maps_valid_ = false;
 
 	dst_src_valid_lua_ = false;
 	dst_src_enemy_valid_lua_ = false;
@@ -1115,6 +1144,15 @@ void readonly_context_impl::recalculate_move_maps() const
 	src_dst_valid_lua_ = false;
 }
 
+void readonly_context_impl::recalculate_move_maps_fullmove() const
+{
+	fullmove_dstsrc_ = move_map();
+	fullmove_possible_moves_ = moves_map();
+	fullmove_srcdst_ = move_map();
+	calculate_possible_moves(fullmove_possible_moves_, fullmove_srcdst_, fullmove_dstsrc_, false, true);
+	fullmove_maps_valid_ = true;
+}
+
 void readonly_context_impl::recalculate_move_maps_enemy() const
 {
 	enemy_dstsrc_ = move_map();
@@ -233,6 +233,12 @@ public:
 
 	virtual std::vector<engine_ptr>& get_engines() = 0;
 
+	virtual const move_map& get_fullmove_dstsrc() const = 0;
+
+	virtual const moves_map& get_fullmove_possible_moves() const = 0;
+
+	virtual const move_map& get_fullmove_srcdst() const = 0;
+
 	virtual std::string get_grouping() const = 0;
 
 	virtual const std::vector<goal_ptr>& get_goals() const = 0;
@@ -628,6 +634,21 @@ public:
 		return target_->get_engines();
 	}
 
+	virtual const move_map& get_fullmove_dstsrc() const override
+	{
+		return target_->get_fullmove_dstsrc();
+	}
+
+	virtual const moves_map& get_fullmove_possible_moves() const override
+	{
+		return target_->get_fullmove_possible_moves();
+	}
+
+	virtual const move_map& get_fullmove_srcdst() const override
+	{
+		return target_->get_fullmove_srcdst();
+	}
+
 	virtual std::string get_grouping() const override
 	{
 		return target_->get_grouping();
@@ -1163,6 +1184,12 @@ public:
 
 	virtual std::vector<engine_ptr>& get_engines() override;
 
+	virtual const move_map& get_fullmove_dstsrc() const override;
+
+	virtual const moves_map& get_fullmove_possible_moves() const override;
+
+	virtual const move_map& get_fullmove_srcdst() const override;
+
 	virtual std::string get_grouping() const override;
 
 	virtual const std::vector<goal_ptr>& get_goals() const override;
@@ -1245,6 +1272,9 @@ public:
 
 	virtual void recalculate_move_maps_enemy() const override;
 
+	/** Recalculates the cached full-movement move maps. */
+	void recalculate_move_maps_fullmove() const;
+
 	virtual void add_aspects(std::vector< aspect_ptr > &aspects) override;
 
 	virtual void add_facet(const std::string &id, const config &cfg) const override;
@@ -1291,6 +1321,10 @@ private:
 	mutable move_map enemy_dstsrc_;
 	mutable moves_map enemy_possible_moves_;
 	mutable move_map enemy_srcdst_;
+	mutable move_map fullmove_dstsrc_;
+	mutable bool fullmove_maps_valid_;
+	mutable moves_map fullmove_possible_moves_;
+	mutable move_map fullmove_srcdst_;
 	typesafe_aspect_ptr<std::string> grouping_;
 	std::vector< goal_ptr > goals_;
 	mutable keeps_cache keeps_;
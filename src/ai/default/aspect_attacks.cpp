@@ -82,6 +82,36 @@ std::shared_ptr<attacks_vector> aspect_attacks_base::analyze_targets() const
 	auto res = std::make_shared<attacks_vector>();
 	const unit_map& units_ = resources::gameboard->units();
 
+	// Diff the unit states against the previous enumeration to find the hexes
+	// where something changed. An executed action only perturbs the analyses
+	// of targets within combat range of those hexes; the analyses of all
+	// other targets are still valid and taken from the cache below.
+	std::map<std::size_t, unit_snapshot> current_states;
+	std::set<map_location> changed_hexes;
+	int max_moves = 0;
+
+	for(const unit& u : units_) {
+		current_states.emplace(u.underlying_id(),
+			unit_snapshot{u.get_location(), u.side(), u.hitpoints(), u.experience(), u.attacks_left(), u.movement_left()});
+		max_moves = std::max(max_moves, u.total_movement());
+	}
+
+	for(const auto& state : current_states) {
+		const auto old = unit_states_.find(state.first);
+		if(old == unit_states_.end()) {
+			changed_hexes.insert(state.second.loc);
+		} else if(!(old->second == state.second)) {
+			changed_hexes.insert(state.second.loc);
+			changed_hexes.insert(old->second.loc);
+		}
+	}
+
+	for(const auto& state : unit_states_) {
+		if(current_states.find(state.first) == current_states.end()) {
+			changed_hexes.insert(state.second.loc);
+		}
+	}
+
 	std::vector<map_location> unit_locs;
 	for(const unit& u : units_) {
 		if(u.side() == get_side() && u.attacks_left() && !(u.can_recruit() && is_passive_leader(u.id()))) {
@@ -93,15 +123,37 @@ std::shared_ptr<attacks_vector> aspect_attacks_base::analyze_targets() const
 		}
 	}
 
+	// Attackers that entered or left the eligible set for a reason the unit
+	// diff cannot see (e.g. a filter) count as changes too.
+	{
+		const std::set<map_location> cur_locs(unit_locs.begin(), unit_locs.end());
+		for(const map_location& loc : prev_unit_locs_) {
+			if(cur_locs.count(loc) == 0) {
+				changed_hexes.insert(loc);
+			}
+		}
+		for(const map_location& loc : cur_locs) {
+			if(prev_unit_locs_.count(loc) == 0) {
+				changed_hexes.insert(loc);
+			}
+		}
+		prev_unit_locs_ = cur_locs;
+	}
+
+	// A changed hex can alter the reach of any unit within movement range of
+	// it, and thereby the analyses of any target adjacent to that reach.
+	const std::size_t radius = max_moves + 1;
+
 	std::array<bool, 6> used_locations;
 	used_locations.fill(false);
 
-	moves_map dummy_moves;
-	move_map fullmove_srcdst, fullmove_dstsrc;
-	calculate_possible_moves(dummy_moves, fullmove_srcdst, fullmove_dstsrc, false, true);
+	const move_map& fullmove_srcdst = get_fullmove_srcdst();
+	const move_map& fullmove_dstsrc = get_fullmove_dstsrc();
 
 	unit_stats_cache().clear();
 
+	std::map<map_location, attacks_vector> new_cache;
+
 	for(const unit& u : units_) {
 		// Attack anyone who is on the enemy side,
 		// and who is not invisible or petrified.
@@ -110,16 +162,41 @@ std::shared_ptr<attacks_vector> aspect_attacks_base::analyze_targets() const
 				continue;
 			}
 
-			const auto adjacent = get_adjacent_tiles(u.get_location());
+			const map_location& target = u.get_location();
+
+			const auto cached = target_cache_.find(target);
+			bool reusable = cached != target_cache_.end();
+			if(reusable) {
+				for(const map_location& hex : changed_hexes) {
+					if(distance_between(hex, target) <= radius) {
+						reusable = false;
+						break;
+					}
+				}
+			}
+
+			if(reusable) {
+				res->insert(res->end(), cached->second.begin(), cached->second.end());
+				new_cache.emplace(target, cached->second);
+				continue;
+			}
+
+			const std::size_t first = res->size();
+			const auto adjacent = get_adjacent_tiles(target);
 			attack_analysis analysis;
-			analysis.target = u.get_location();
+			analysis.target = target;
 			analysis.vulnerability = 0.0;
 			analysis.support = 0.0;
 
-			do_attack_analysis(u.get_location(), srcdst, dstsrc, fullmove_srcdst, fullmove_dstsrc, enemy_srcdst,
+			do_attack_analysis(target, srcdst, dstsrc, fullmove_srcdst, fullmove_dstsrc, enemy_srcdst,
 				enemy_dstsrc, adjacent, used_locations, unit_locs, *res, analysis, current_team());
+
+			new_cache.emplace(target, attacks_vector(res->begin() + first, res->end()));
 		}
 	}
+
+	unit_states_.swap(current_states);
+	target_cache_.swap(new_cache);
 	return res;
 }
 
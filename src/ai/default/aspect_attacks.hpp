@@ -21,8 +21,12 @@
 #pragma once
 
 #include "ai/composite/aspect.hpp"
+#include "ai/default/contexts.hpp"
 #include "units/filter.hpp"
 
+#include <map>
+#include <set>
+
 namespace ai {
 
 namespace ai_default_rca {
@@ -56,6 +60,37 @@ protected:
 		const team& current_team) const;
 
 	static int rate_terrain(const unit& u, const map_location& loc);
+
+	/** The parts of a unit's state the attack analyses depend on. */
+	struct unit_snapshot
+	{
+		map_location loc;
+		int side;
+		int hitpoints;
+		int experience;
+		int attacks_left;
+		int movement_left;
+
+		bool operator==(const unit_snapshot& o) const
+		{
+			return loc == o.loc && side == o.side && hitpoints == o.hitpoints
+				&& experience == o.experience && attacks_left == o.attacks_left
+				&& movement_left == o.movement_left;
+		}
+	};
+
+	/** Unit states as of the last enumeration, keyed by underlying unit id. */
+	mutable std::map<std::size_t, unit_snapshot> unit_states_;
+
+	/** Eligible attacker locations as of the last enumeration. */
+	mutable std::set<map_location> prev_unit_locs_;
+
+	/**
+	 * Analyses from the last enumeration, grouped by target hex. An executed
+	 * action only perturbs the analyses of targets within combat range of the
+	 * hexes it touched; the rest are reused instead of re-enumerated.
+	 */
+	mutable std::map<map_location, attacks_vector> target_cache_;
 };
 
 class aspect_attacks : public aspect_attacks_base {
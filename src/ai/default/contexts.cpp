@@ -167,9 +167,7 @@ std::vector<target> default_ai_context_impl::find_targets(const move_map& enemy_
 	double corner_distance = distance_between(map_location::ZERO(), map_location(map_.w(),map_.h()));
 	double village_value = get_village_value();
 	if(has_leader && village_value > 0.0) {
-		std::map<map_location,pathfind::paths> friends_possible_moves;
-		move_map friends_srcdst, friends_dstsrc;
-		calculate_possible_moves(friends_possible_moves, friends_srcdst, friends_dstsrc, false, true);
+		const move_map& friends_dstsrc = get_fullmove_dstsrc();
 
 		const std::vector<map_location>& villages = map_.villages();
 		for(std::vector<map_location>::const_iterator t =
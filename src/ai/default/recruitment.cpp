@@ -119,6 +119,7 @@ recruitment::recruitment(rca_context& context, const config& cfg)
 	: candidate_action(context, cfg),
 	important_hexes_(),
 	important_terrain_(),
+	average_defense_cache_(),
 	own_units_in_combat_counter_(0),
 	average_local_cost_(),
 	cheapest_unit_costs_(),
@@ -687,6 +688,10 @@ void recruitment::compare_cost_maps_and_update_important_hexes(
  * (According to important_hexes_ / important_terrain_)
  */
 double recruitment::get_average_defense(const std::string& u_type) const {
+	const std::map<std::string, double>::const_iterator cached = average_defense_cache_.find(u_type);
+	if (cached != average_defense_cache_.end()) {
+		return cached->second;
+	}
 	const unit_type* const u_info = unit_types.find(u_type);
 	if (!u_info) {
 		return 0.0;
@@ -702,6 +707,7 @@ double recruitment::get_average_defense(const std::string& u_type) const {
 	}
 	double average_defense = (total_terrains == 0) ? 0.0 :
 			static_cast<double>(summed_defense) / total_terrains;
+	average_defense_cache_[u_type] = average_defense;
 	return average_defense;
 }
 
@@ -815,6 +821,7 @@ void recruitment::update_average_local_cost() {
 void recruitment::update_important_hexes() {
 	important_hexes_.clear();
 	important_terrain_.clear();
+	average_defense_cache_.clear();
 	own_units_in_combat_counter_ = 0;
 
 	update_average_local_cost();
@@ -831,11 +838,10 @@ void recruitment::update_important_hexes() {
 		if (is_enemy_in_radius(unit.get_location(), 1)) {
 			// We found a enemy next to us. Mark our unit and all adjacent
 			// hexes as important.
-			std::vector<map_location> surrounding;
-			get_tiles_in_radius(unit.get_location(), 1, surrounding);
 			important_hexes_.insert(unit.get_location());
-			std::copy(surrounding.begin(), surrounding.end(),
-					std::inserter(important_hexes_, important_hexes_.begin()));
+			for (const map_location& hex : tiles_in_radius(unit.get_location(), 1)) {
+				important_hexes_.insert(hex);
+			}
 			++own_units_in_combat_counter_;
 		}
 	}
@@ -861,9 +867,7 @@ void recruitment::update_important_hexes() {
 	// to important_hexes_ in a second step.
 	std::vector<map_location> important_villages;
 	for (const map_location& village : map.villages()) {
-		std::vector<map_location> surrounding;
-		get_tiles_in_radius(village, MAP_VILLAGE_NEARNESS_THRESHOLD, surrounding);
-		for (const map_location& hex : surrounding) {
+		for (const map_location& hex : tiles_in_radius(village, MAP_VILLAGE_NEARNESS_THRESHOLD)) {
 			if (important_hexes_.find(hex) != important_hexes_.end()) {
 				important_villages.push_back(village);
 				break;
@@ -872,9 +876,7 @@ void recruitment::update_important_hexes() {
 	}
 	for (const map_location& village : important_villages) {
 		important_hexes_.insert(village);
-		std::vector<map_location> surrounding;
-		get_tiles_in_radius(village, MAP_VILLAGE_SURROUNDING, surrounding);
-		for (const map_location& hex : surrounding) {
+		for (const map_location& hex : tiles_in_radius(village, MAP_VILLAGE_SURROUNDING)) {
 			// only add hex if one of our units can reach the hex
 			if (map.on_board(hex) && my_cost_map.get_cost_at(hex) != -1) {
 				important_hexes_.insert(hex);
@@ -933,11 +935,11 @@ double recruitment::compare_unit_types(const std::string& a, const std::string&
 		double value_of_b = damage_to_a / (a_max_hp * b_cost);
 
 		if (value_of_a > value_of_b) {
-			return value_of_a / value_of_b;
+			retval = value_of_a / value_of_b;
 		} else if (value_of_a < value_of_b) {
-			return -value_of_b / value_of_a;
+			retval = -value_of_b / value_of_a;
 		} else {
-			return 0.;
+			retval = 0.;
 		}
 	}
 
@@ -1696,12 +1698,7 @@ void recruitment::handle_recruitment_more(std::vector<data>* leader_data) const
  */
 bool recruitment::is_enemy_in_radius(const map_location& loc, int radius) const {
 	const unit_map& units = resources::gameboard->units();
-	std::vector<map_location> surrounding;
-	get_tiles_in_radius(loc, radius, surrounding);
-	if (surrounding.empty()) {
-		return false;
-	}
-	for (const map_location& l : surrounding) {
+	for (const map_location& l : tiles_in_radius(loc, radius)) {
 		const unit_map::const_iterator& enemy_it = units.find(l);
 		if(enemy_it == units.end()) {
 			continue;
@@ -254,6 +254,8 @@ private:
 
 	std::set<map_location> important_hexes_;
 	terrain_count_map important_terrain_;
+	/** Average defenses derived from important_terrain_, cleared when it is rebuilt. */
+	mutable std::map<std::string, double> average_defense_cache_;
 	int own_units_in_combat_counter_;
 	std::map<map_location, double> average_local_cost_;
 	std::map<std::size_t, int> cheapest_unit_costs_;
@@ -92,6 +92,14 @@ bool candidate_action_evaluation_loop::do_play_stage()
 
 	bool executed = false;
 	bool gamestate_changed = false;
+
+	// Scores are remembered between iterations of the loop below; a score
+	// stays valid until the game state actually changes, so executions that
+	// changed nothing (or only disabled the lying CA) don't force the whole
+	// roster to be re-evaluated. The evaluations themselves must stay
+	// serialized: evaluate() implementations share the AI's cached move
+	// maps and may call into Lua.
+	std::map<candidate_action_ptr, double> cached_scores;
 	do {
 		executed = false;
 		double best_score = candidate_action::BAD_SCORE;
@@ -109,9 +117,23 @@ bool candidate_action_evaluation_loop::do_play_stage()
 				break;
 			}
 
-			DBG_AI_TESTING_RCA_DEFAULT << "Evaluating candidate action: "<< *ca_ptr << std::endl;
-			double score = ca_ptr->evaluate();
-			DBG_AI_TESTING_RCA_DEFAULT << "Evaluated candidate action to score "<< score << " : " << *ca_ptr << std::endl;
+			double score;
+			const std::map<candidate_action_ptr, double>::const_iterator cached = cached_scores.find(ca_ptr);
+			if (cached != cached_scores.end()) {
+				score = cached->second;
+				DBG_AI_TESTING_RCA_DEFAULT << "Reusing cached score "<< score << " : " << *ca_ptr << std::endl;
+			} else {
+				// Let the display pump between evaluations (throttled by the
+				// manager), so queued animations keep playing and the screen
+				// stays live while the AI thinks instead of freezing until
+				// the whole roster has been scored.
+				raise_user_interact();
+
+				DBG_AI_TESTING_RCA_DEFAULT << "Evaluating candidate action: "<< *ca_ptr << std::endl;
+				score = ca_ptr->evaluate();
+				cached_scores.emplace(ca_ptr, score);
+				DBG_AI_TESTING_RCA_DEFAULT << "Evaluated candidate action to score "<< score << " : " << *ca_ptr << std::endl;
+			}
 
 			if (score>best_score) {
 				best_score = score;
@@ -131,8 +153,11 @@ bool candidate_action_evaluation_loop::do_play_stage()
 				DBG_AI_TESTING_RCA_DEFAULT << "Disabling candidate action because it failed to change the game state: "<< *best_ptr << std::endl;
 				best_ptr->disable();
 				//since we don't re-enable at this play_stage, if we disable this CA, other may get the chance to go.
+				//the remembered scores stay valid, since nothing changed.
 			} else {
 				gamestate_changed = true;
+				//every score may be different against the new game state.
+				cached_scores.clear();
 			}
 		} else {
 			LOG_AI_TESTING_RCA_DEFAULT << "Ending candidate action evaluation loop due to best score "<< best_score<<"<="<< candidate_action::BAD_SCORE<<std::endl;
@@ -74,12 +74,16 @@ void arrow::set_path(const arrow_path_t& path)
 {
 	if (valid_path(path))
 	{
+		// Dragging a planned move fires this once per (coalesced) mouse
+		// event, usually without the path having changed at all.
+		if (path == path_)
+			return;
+
 		previous_path_ = path_;
 		path_ = path;
 		update_symbols();
 		if(!hidden_)
 		{
-			invalidate_arrow_path(previous_path_);
 			notify_arrow_changed();
 		}
 	}
@@ -160,8 +164,11 @@ void arrow::update_symbols()
 		return;
 	}
 
-	symbols_map_.clear();
-	invalidate_arrow_path(path_);
+	// Compose the new symbols aside and diff them against the current ones
+	// below, so that extending or shortening the path during a drag only
+	// redraws the hexes whose segment actually changed (the head and tail);
+	// the middle of a long arrow is carried over untouched.
+	arrow_symbols_map_t new_symbols;
 
 	const std::string mods = "~RC(FF00FF>"+ color_ + ")"; //magenta to current color
 
@@ -278,8 +285,32 @@ void arrow::update_symbols()
 			ERR_ARR << "Image " << image_filename << " not found." << std::endl;
 			image = image::locator(game_config::images::missing);
 		}
-		symbols_map_[*hex] = image;
+		new_symbols[*hex] = image;
+	}
+
+	// Invalidate only the hexes whose symbol changed: hexes that left the
+	// path, hexes that joined it, and hexes drawing a different segment
+	// image (locators are interned, so comparing them is cheap).
+	if(display* disp = display::get_singleton()) {
+		for (const arrow_symbols_map_t::value_type& entry : symbols_map_)
+		{
+			arrow_symbols_map_t::const_iterator new_entry = new_symbols.find(entry.first);
+			if (new_entry == new_symbols.end() || new_entry->second != entry.second)
+			{
+				disp->invalidate(entry.first);
+			}
+		}
+
+		for (const arrow_symbols_map_t::value_type& entry : new_symbols)
+		{
+			if (symbols_map_.find(entry.first) == symbols_map_.end())
+			{
+				disp->invalidate(entry.first);
+			}
+		}
 	}
+
+	symbols_map_ = std::move(new_symbols);
 }
 
 void arrow::invalidate_arrow_path(const arrow_path_t& path)
@@ -87,7 +87,7 @@ protected:
 
 	/**
 	 * Calculate the symbols to place along the arrow path.
-	 * Invalidates every hex along the path.
+	 * Invalidates the hexes whose symbol changed since the last update.
 	 */
 	virtual void update_symbols();
 
@@ -45,6 +45,11 @@
 #include <numeric>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ATTACK_PREDICTION_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 #if defined(BENCHMARK) || defined(CHECK)
 #include <chrono>
 #include <cstdio>
@@ -358,6 +363,21 @@ private:
 			int drain_constant,
 			int drain_percent);
 
+	/** Dense, vectorizable form of shift_cols() for the drain-free case. */
+	void shift_cols_dense(unsigned dst,
+			unsigned src,
+			unsigned damage,
+			double prob,
+			const std::vector<unsigned>& rows,
+			const std::vector<unsigned>& cols);
+	/** Dense, vectorizable form of shift_rows() for the drain-free case. */
+	void shift_rows_dense(unsigned dst,
+			unsigned src,
+			unsigned damage,
+			double prob,
+			const std::vector<unsigned>& rows,
+			const std::vector<unsigned>& cols);
+
 private: // data
 	const unsigned int rows_, cols_;
 	std::array<std::unique_ptr<double[]>, NUM_PLANES> plane_;
@@ -679,6 +699,13 @@ void prob_matrix::shift_cols(
 	const std::vector<unsigned> rows(used_rows_[src].begin(), used_rows_[src].end());
 	const std::vector<unsigned> cols(used_cols_[src].begin(), used_cols_[src].end());
 
+	if(drain_constant == 0 && drain_percent == 0) {
+		// Without drain every transfer keeps its row index, so each row can
+		// be processed as one dense span instead of per-cell xfer() calls.
+		shift_cols_dense(dst, src, damage, prob, rows, cols);
+		return;
+	}
+
 	// Loop downwards if we drain positive, but upwards if we drain negative,
 	// so we write behind us (for when src == dst).
 	if(drainmax > 0) {
@@ -694,6 +721,75 @@ void prob_matrix::shift_cols(
 	}
 }
 
+/**
+ * Drain-free version of shift_cols(), operating on dense row spans.
+ *
+ * The sparse per-cell path pays for an xfer() call and used-set bookkeeping
+ * per (row, column) pair. Without drain the destination row equals the
+ * source row, so the whole surviving range of a row collapses to one
+ * contiguous multiply-and-shift that SSE2 can process two entries at a time.
+ */
+void prob_matrix::shift_cols_dense(unsigned dst,
+		unsigned src,
+		unsigned damage,
+		double prob,
+		const std::vector<unsigned>& rows,
+		const std::vector<unsigned>& cols)
+{
+	// Mark the destination indices up front. The used sets are conservative
+	// supersets of the nonzero cells, so mapping every marked source column
+	// is sufficient. Index 0 is always marked.
+	for(unsigned row_x = 1; row_x < rows.size(); ++row_x) {
+		used_rows_[dst].insert(rows[row_x]);
+	}
+
+	for(unsigned col_x = 1; col_x < cols.size(); ++col_x) {
+		used_cols_[dst].insert(cols[col_x] < damage ? 0 : cols[col_x] - damage);
+	}
+
+	// Column 0 stays put, so the surviving range starts no earlier than 1.
+	const unsigned shift_begin = std::max(damage, 1u);
+
+	// rows[0] is excluded since that should be 0, representing already dead.
+	for(unsigned row_x = 1; row_x < rows.size(); ++row_x) {
+		double* s = plane_[src].get() + rows[row_x] * cols_;
+		double* d = plane_[dst].get() + rows[row_x] * cols_;
+
+		// Killing blows all land in column 0.
+		double dead = 0.0;
+		for(unsigned c = 1; c < std::min(damage, cols_); ++c) {
+			const double diff = s[c] * prob;
+			s[c] -= diff;
+			dead += diff;
+		}
+
+		d[0] += dead;
+
+		// Surviving entries shift damage columns towards 0. Ascending order
+		// writes behind the read position (as in shift_cols_in_row), which
+		// keeps the in-place src == dst case correct.
+		unsigned c = shift_begin;
+#ifdef ATTACK_PREDICTION_USE_SSE2
+		// The vector step reads [c, c+1] and writes [c-damage, c+1-damage];
+		// for src == dst those ranges only stay disjoint when damage >= 2.
+		if(dst != src || damage >= 2) {
+			const __m128d vprob = _mm_set1_pd(prob);
+			for(; c + 2 <= cols_; c += 2) {
+				const __m128d v = _mm_loadu_pd(s + c);
+				const __m128d diff = _mm_mul_pd(v, vprob);
+				_mm_storeu_pd(s + c, _mm_sub_pd(v, diff));
+				_mm_storeu_pd(d + c - damage, _mm_add_pd(_mm_loadu_pd(d + c - damage), diff));
+			}
+		}
+#endif
+		for(; c < cols_; ++c) {
+			const double diff = s[c] * prob;
+			s[c] -= diff;
+			d[c - damage] += diff;
+		}
+	}
+}
+
 /**
  * Transfers a portion (value * prob) of the values in a column to another.
  * Part of shift_rows().
@@ -752,6 +848,14 @@ void prob_matrix::shift_rows(
 	const std::vector<unsigned> rows(used_rows_[src].begin(), used_rows_[src].end());
 	const std::vector<unsigned> cols(used_cols_[src].begin(), used_cols_[src].end());
 
+	if(drain_constant == 0 && drain_percent == 0) {
+		// Without drain every transfer keeps its column index, so each
+		// source row maps onto one destination row and the transfer is a
+		// dense row-to-row operation.
+		shift_rows_dense(dst, src, damage, prob, rows, cols);
+		return;
+	}
+
 	// Loop downwards if we drain positive, but upwards if we drain negative,
 	// so we write behind us (for when src == dst).
 	if(drainmax > 0) {
@@ -766,6 +870,62 @@ void prob_matrix::shift_rows(
 	}
 }
 
+/**
+ * Drain-free version of shift_rows(), operating on dense row spans.
+ *
+ * Rows shift towards 0 while every entry keeps its column, so each source
+ * row transfers into exactly one destination row (row 0 for killing blows)
+ * and the per-column work is a contiguous multiply-and-add over the row.
+ */
+void prob_matrix::shift_rows_dense(unsigned dst,
+		unsigned src,
+		unsigned damage,
+		double prob,
+		const std::vector<unsigned>& rows,
+		const std::vector<unsigned>& cols)
+{
+	// Mark the destination indices up front. The used sets are conservative
+	// supersets of the nonzero cells, so mapping every marked source row is
+	// sufficient. Index 0 is always marked.
+	for(unsigned row_x = 1; row_x < rows.size(); ++row_x) {
+		used_rows_[dst].insert(rows[row_x] < damage ? 0 : rows[row_x] - damage);
+	}
+
+	for(unsigned col_x = 1; col_x < cols.size(); ++col_x) {
+		used_cols_[dst].insert(cols[col_x]);
+	}
+
+	// Ascending source rows write behind themselves (as in shift_rows()'
+	// non-draining loop), which keeps the in-place src == dst case correct.
+	// rows[0] is excluded since that should be 0, representing already dead.
+	for(unsigned row_x = 1; row_x < rows.size(); ++row_x) {
+		const unsigned row = rows[row_x];
+
+		double* s = plane_[src].get() + row * cols_;
+		double* d = plane_[dst].get() + (row < damage ? 0 : row - damage) * cols_;
+
+		// Column 0 represents already dead and never moves.
+		unsigned c = 1;
+#ifdef ATTACK_PREDICTION_USE_SSE2
+		// Source and destination rows never partially overlap: they are
+		// either distinct rows or (damage == 0, dst == src) the same row,
+		// where the sequential store-then-add still reproduces the no-op.
+		const __m128d vprob = _mm_set1_pd(prob);
+		for(; c + 2 <= cols_; c += 2) {
+			const __m128d v = _mm_loadu_pd(s + c);
+			const __m128d diff = _mm_mul_pd(v, vprob);
+			_mm_storeu_pd(s + c, _mm_sub_pd(v, diff));
+			_mm_storeu_pd(d + c, _mm_add_pd(_mm_loadu_pd(d + c), diff));
+		}
+#endif
+		for(; c < cols_; ++c) {
+			const double diff = s[c] * prob;
+			s[c] -= diff;
+			d[c] += diff;
+		}
+	}
+}
+
 /**
  * Move a column (adding it to the destination).
  */
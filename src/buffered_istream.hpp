@@ -102,6 +102,30 @@ public:
 		return eof_;
 	}
 
+	/**
+	 * Number of contiguous unconsumed bytes in the buffer, refilling it
+	 * from the stream first if needed. Zero once the end of input is
+	 * reached. Allows block-oriented scans over the buffer instead of
+	 * byte-at-a-time get() calls.
+	 */
+	unsigned avail()
+	{
+		fill_buffer();
+		return eof_ ? 0 : buffer_size_ - buffer_offset_;
+	}
+
+	/** The unconsumed bytes; valid up to the last result of avail(). */
+	const char* data() const
+	{
+		return buffer_ + buffer_offset_;
+	}
+
+	/** Consumes @a n bytes previously examined through data(). */
+	void skip(unsigned n)
+	{
+		buffer_offset_ += n;
+	}
+
 	/** Returns the owned stream. */
 	std::istream& stream()
 	{
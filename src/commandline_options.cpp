@@ -141,6 +141,7 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 	, unit_test()
 	, headless_unit_test(false)
 	, noreplaycheck(false)
+	, expected_unit_test_result()
 	, mptest(false)
 	, userconfig_path(false)
 	, userconfig_dir()
@@ -272,7 +273,8 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 	po::options_description testing_opts("Testing options");
 	testing_opts.add_options()
 		("test,t", po::value<std::string>()->implicit_value(std::string()), "runs the game in a small test scenario. If specified, scenario <arg> will be used instead.")
-		("unit,u", po::value<std::vector<std::string>>(), "runs a unit test scenario. The GUI is not shown and the exit code of the program reflects the victory / defeat conditions of the scenario.\n\t0 - PASS\n\t1 - FAIL\n\t3 - FAIL (INVALID REPLAY)\n\t4 - FAIL (ERRORED REPLAY)\n\t5 - FAIL (BROKE STRICT)\n\t6 - FAIL (WML EXCEPTION)\n\tMultiple tests can be run by giving this option multiple times, in this case the test run will stop immediately after any test which doesn't PASS and the return code will be the status of the test that caused the stop.")
+		("unit,u", po::value<std::vector<std::string>>(), "runs a unit test scenario. The GUI is not shown and the exit code of the program reflects the victory / defeat conditions of the scenario.\n\t0 - PASS\n\t1 - FAIL\n\t3 - FAIL (INVALID REPLAY)\n\t4 - FAIL (ERRORED REPLAY)\n\t5 - FAIL (BROKE STRICT)\n\t6 - FAIL (WML EXCEPTION)\n\tMultiple tests can be run by giving this option multiple times, in this case the test run will stop immediately after any test which doesn't return the expected result (see --expected-result) and the return code will be the status of the test that caused the stop.")
+		("expected-result", po::value<int>(), "the status code every test of a batched --unit run is expected to return, so that tests expecting a non-zero status can share one instance. Defaults to 0 (PASS).")
 		("showgui", "don't run headlessly (for debugging a failing test)")
 		("log-strict", po::value<std::string>(), "sets the strict level of the logger. any messages sent to log domains of this level or more severe will cause the unit test to fail regardless of the victory result.")
 		("nobanner", "suppress startup banner.")
@@ -494,6 +496,8 @@ commandline_options::commandline_options(const std::vector<std::string>& args)
 	}
 	if (vm.count("showgui"))
 		headless_unit_test = false;
+	if (vm.count("expected-result"))
+		expected_unit_test_result = vm["expected-result"].as<int>();
 	if (vm.count("noreplaycheck"))
 		noreplaycheck = true;
 	if (vm.count("turns"))
@@ -208,6 +208,8 @@ public:
 	bool headless_unit_test;
 	/** True if --noreplaycheck was given on the command line. Dependent on --unit. */
 	bool noreplaycheck;
+	/** Non-empty if --expected-result was given on the command line. The result every test of a batched --unit run is expected to return; the run stops at the first deviating test. Dependent on --unit. */
+	std::optional<int> expected_unit_test_result;
 	/** True if --mp-test was given on the command line. */
 	bool mptest;
 	/** True if --userconfig-path was given on the command line. Prints path to user config directory and exits. */
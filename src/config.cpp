@@ -21,9 +21,11 @@
 
 #include "config.hpp"
 
+#include "config_arena.hpp"
 #include "formatter.hpp"
 #include "lexical_cast.hpp"
 #include "log.hpp"
+#include "utils/alloc_tracking.hpp"
 #include "utils/const_clone.hpp"
 #include "deprecation.hpp"
 #include "game_version.hpp"
@@ -34,6 +36,7 @@
 #include <cstring>
 #include <istream>
 #include <locale>
+#include <unordered_map>
 
 static lg::log_domain log_config("config");
 #define ERR_CF LOG_STREAM(err, log_config)
@@ -89,6 +92,11 @@ struct config_implementation
 		assert(parent.back() == ']');
 
 		if(config->has_child(key)) {
+			if constexpr(!std::is_const_v<std::remove_pointer_t<T>>) {
+				// The caller gets mutable access to the child.
+				config->invalidate_child_index();
+			}
+
 			return *(config->children_.find(key)->second.front());
 		}
 
@@ -109,6 +117,21 @@ struct config_implementation
 
 /* ** config implementation ** */
 
+/**
+ * Lazily built lookup tables for find_child(): for each (tag, attribute)
+ * pair a lookup was made with, maps the attribute value to the first child
+ * of that tag carrying it.
+ */
+struct config::child_index
+{
+	std::map<std::pair<std::string, std::string>, std::unordered_map<std::string, const config*>> tables;
+};
+
+void config::invalidate_child_index()
+{
+	child_index_.reset();
+}
+
 config config::invalid;
 std::vector<jmp_buf *> config::throw_when_child_not_found::instances;
 
@@ -128,10 +151,58 @@ void config::check_valid(const config& cfg) const
 	}
 }
 
+namespace
+{
+	// Each node is prefixed with a word recording where its storage came
+	// from, so heap and arena nodes can freely coexist in one tree.
+	constexpr std::size_t heap_node_tag = 0x636667u;  // "cfg"
+	constexpr std::size_t arena_node_tag = 0x617265u; // "are"
+	constexpr std::size_t node_header_size = alignof(std::max_align_t);
+}
+
+void* config::operator new(std::size_t size)
+{
+	// config already has class-scope new/delete for the arena, so the
+	// tracking hooks go here instead of through WESNOTH_TRACK_ALLOCATIONS.
+	WESNOTH_RECORD_ALLOC(SUBSYS_CONFIG, size);
+
+	char* base;
+	std::size_t tag;
+
+	if(config_arena* arena = config_arena::current()) {
+		base = static_cast<char*>(arena->allocate(size + node_header_size));
+		tag = arena_node_tag;
+	} else {
+		base = static_cast<char*>(::operator new(size + node_header_size));
+		tag = heap_node_tag;
+	}
+
+	*reinterpret_cast<std::size_t*>(base) = tag;
+	return base + node_header_size;
+}
+
+void config::operator delete(void* p)
+{
+	if(!p) {
+		return;
+	}
+
+	// This operator is only ever invoked for complete config nodes, so the
+	// unsized form still knows how much to retire.
+	WESNOTH_RECORD_DEALLOC(SUBSYS_CONFIG, sizeof(config));
+
+	char* base = static_cast<char*>(p) - node_header_size;
+	if(*reinterpret_cast<std::size_t*>(base) == heap_node_tag) {
+		::operator delete(base);
+	}
+	// Arena nodes are reclaimed when their config_arena is destroyed.
+}
+
 config::config()
 	: values_()
 	, children_()
 	, ordered_children()
+	, child_index_()
 {
 }
 
@@ -139,6 +210,7 @@ config::config(const config& cfg)
 	: values_(cfg.values_)
 	, children_()
 	, ordered_children()
+	, child_index_()
 {
 	append_children(cfg);
 }
@@ -147,6 +219,7 @@ config::config(config_key_type child)
 	: values_()
 	, children_()
 	, ordered_children()
+	, child_index_()
 {
 	add_child(child);
 }
@@ -171,6 +244,7 @@ config::config(config&& cfg)
 	: values_(std::move(cfg.values_))
 	, children_(std::move(cfg.children_))
 	, ordered_children(std::move(cfg.ordered_children))
+	, child_index_(std::move(cfg.child_index_))
 {
 }
 
@@ -345,6 +419,8 @@ void config::merge_children_by_attribute(const std::string& key, const std::stri
 config::child_itors config::child_range(config_key_type key)
 {
 	check_valid();
+	// The caller can mutate the children through the returned iterators.
+	invalidate_child_index();
 
 	child_map::iterator i = children_.find(key);
 	static child_list dummy;
@@ -400,7 +476,7 @@ bool config::has_child(config_key_type key) const
 	return i != children_.end() && !i->second.empty();
 }
 
-config& config::child(config_key_type key, int n)
+const config& config::child_impl(config_key_type key, int n) const
 {
 	check_valid();
 
@@ -433,6 +509,15 @@ config& config::child(config_key_type key, int n)
 	}
 }
 
+config& config::child(config_key_type key, int n)
+{
+	// The caller can mutate the child through the returned reference. Done
+	// first since child_impl() may leave through longjmp().
+	invalidate_child_index();
+
+	return const_cast<config&>(child_impl(key, n));
+}
+
 config& config::child(config_key_type key, const std::string& parent)
 {
 	return config_implementation::child(this, key, parent);
@@ -476,6 +561,8 @@ const config& config::child_or_empty(config_key_type key) const
 
 config& config::child_or_add(config_key_type key)
 {
+	invalidate_child_index();
+
 	child_map::const_iterator i = children_.find(key);
 	if(i != children_.end() && !i->second.empty()) {
 		return *i->second.front();
@@ -513,6 +600,7 @@ config::const_child_itors config::get_deprecated_child_range(config_key_type old
 config& config::add_child(config_key_type key)
 {
 	check_valid();
+	invalidate_child_index();
 
 	child_list& v = map_get(children_, key);
 	v.emplace_back(new config());
@@ -523,6 +611,7 @@ config& config::add_child(config_key_type key)
 config& config::add_child(config_key_type key, const config& val)
 {
 	check_valid(val);
+	invalidate_child_index();
 
 	child_list& v = map_get(children_, key);
 	v.emplace_back(new config(val));
@@ -534,6 +623,7 @@ config& config::add_child(config_key_type key, const config& val)
 config& config::add_child(config_key_type key, config&& val)
 {
 	check_valid(val);
+	invalidate_child_index();
 
 	child_list& v = map_get(children_, key);
 	v.emplace_back(new config(std::move(val)));
@@ -545,6 +635,7 @@ config& config::add_child(config_key_type key, config&& val)
 config& config::add_child_at(config_key_type key, const config& val, unsigned index)
 {
 	check_valid(val);
+	invalidate_child_index();
 
 	child_list& v = map_get(children_, key);
 	if(index > v.size()) {
@@ -592,6 +683,7 @@ size_t config::find_total_first_of(config_key_type key, size_t start)
 
 config& config::add_child_at_total(config_key_type key, const config &val, size_t pos)
 {
+	invalidate_child_index();
 	assert(pos <= ordered_children.size());
 	if(pos == ordered_children.size()) {
 		//optimisation
@@ -648,6 +740,7 @@ private:
 void config::clear_children_impl(config_key_type key)
 {
 	check_valid();
+	invalidate_child_index();
 
 	child_map::iterator i = children_.find(key);
 	if(i == children_.end())
@@ -663,6 +756,8 @@ void config::clear_children_impl(config_key_type key)
 void config::splice_children(config& src, const std::string& key)
 {
 	check_valid(src);
+	invalidate_child_index();
+	src.invalidate_child_index();
 
 	child_map::iterator i_src = src.children_.find(key);
 	if(i_src == src.children_.end()) {
@@ -689,6 +784,8 @@ void config::splice_children(config& src, const std::string& key)
 void config::recursive_clear_value(config_key_type key)
 {
 	check_valid();
+	// This erases the attribute from the children too.
+	invalidate_child_index();
 
 	map_erase_key(values_, key);
 
@@ -701,6 +798,8 @@ void config::recursive_clear_value(config_key_type key)
 
 std::vector<config::child_pos>::iterator config::remove_child(const child_map::iterator& pos, unsigned index)
 {
+	invalidate_child_index();
+
 	/* Find the position with the correct index and decrement all the
 	   indices in the ordering that are above this index. */
 	unsigned found = 0;
@@ -881,30 +980,120 @@ config::attr_itors config::attribute_range()
 	return range;
 }
 
-config& config::find_child(config_key_type key, const std::string& name, const std::string& value)
+namespace
+{
+/** First-match linear scan over a child list, as find_child() always did. */
+const config* scan_for_child(const config::child_list& list, const std::string& name, const std::string& value)
+{
+	const auto j = std::find_if(list.begin(), list.end(),
+		[&](const std::unique_ptr<config>& pcfg) {
+			const config& cfg = *pcfg;
+			return cfg[name] == value;
+		}
+	);
+
+	return j != list.end() ? j->get() : nullptr;
+}
+
+/**
+ * Returns the key under which @a v is filed in a find_child() index table.
+ * The tables are keyed on strings, so key equality must follow
+ * config_attribute_value::equals(): the only values comparing equal across
+ * variant types are the two boolean wrappers, which are canonicalized here.
+ * Accidental string collisions of distinct types (e.g. a t_string rendering
+ * like a plain string) are caught by re-checking the match.
+ */
+std::string child_index_key(const config_attribute_value& v)
+{
+	// to_bool() only reads the boolean variants, so it returns the default
+	// for any other type.
+	if(v.to_bool(false) == v.to_bool(true)) {
+		return v.to_bool() ? "yes" : "no";
+	}
+
+	return v.str();
+}
+} // end anon namespace
+
+const config* config::find_child_impl(config_key_type key, const std::string& name, const std::string& value) const
 {
 	check_valid();
 
-	const child_map::iterator i = children_.find(key);
+	const child_map::const_iterator i = children_.find(key);
 	if(i == children_.end()) {
-		DBG_CF << "Key »" << name << "« value »" << value << "« pair not found as child of key »" << key << "«.\n";
+		return nullptr;
+	}
 
-		if(jmp_buf *env = throw_when_child_not_found::do_throw()) {
-			longjmp(*env, 1);
-		} else {
-			return invalid;
-		}
+	const child_list& list = i->second;
+
+	// Below this size a scan is cheaper than maintaining a hash table.
+	static const std::size_t min_indexed_children = 8;
+
+	if(list.size() < min_indexed_children) {
+		return scan_for_child(list, name, value);
 	}
 
-	const child_list::iterator j = std::find_if(i->second.begin(), i->second.end(),
-		[&](const std::unique_ptr<config>& pcfg) {
+	if(!child_index_) {
+		child_index_.reset(new child_index);
+	}
+
+	const auto [table, is_new] = child_index_->tables.try_emplace(std::make_pair(std::string(key), name));
+	if(is_new) {
+		table->second.reserve(list.size());
+
+		for(const auto& pcfg : list) {
 			const config& cfg = *pcfg;
-			return cfg[name] == value;
+			// emplace() keeps the first child carrying each value, matching
+			// the scan's first-match semantics.
+			table->second.emplace(child_index_key(cfg[name]), pcfg.get());
 		}
-	);
+	}
+
+	attribute_value probe;
+	probe = value;
+
+	const auto j = table->second.find(child_index_key(probe));
+	if(j == table->second.end()) {
+		return nullptr;
+	}
+
+	const config& match = *j->second;
+	if(match[name] == value) {
+		return &match;
+	}
+
+	// Either a string collision between two attribute types, or a child whose
+	// key attribute was rewritten through a stale reference; the scan settles it.
+	return scan_for_child(list, name, value);
+}
+
+config& config::find_child(config_key_type key, const std::string& name, const std::string& value)
+{
+	check_valid();
 
-	if(j != i->second.end()) {
-		return **j;
+	// The caller gets a mutable reference that can rewrite the indexed
+	// attribute, so the index cannot be kept; scan instead of building
+	// a table that would have to be dropped right away.
+	invalidate_child_index();
+
+	const child_map::iterator i = children_.find(key);
+	if(const config* res = i != children_.end() ? scan_for_child(i->second, name, value) : nullptr) {
+		return const_cast<config&>(*res);
+	}
+
+	DBG_CF << "Key »" << name << "« value »" << value << "« pair not found as child of key »" << key << "«.\n";
+
+	if(jmp_buf *env = throw_when_child_not_found::do_throw()) {
+		longjmp(*env, 1);
+	} else {
+		return invalid;
+	}
+}
+
+const config& config::find_child(config_key_type key, const std::string& name, const std::string& value) const
+{
+	if(const config* res = find_child_impl(key, name, value)) {
+		return *res;
 	}
 
 	DBG_CF << "Key »" << name << "« value »" << value << "« pair not found as child of key »" << key << "«.\n";
@@ -922,6 +1111,7 @@ void config::clear()
 	children_.clear();
 	values_.clear();
 	ordered_children.clear();
+	child_index_.reset();
 }
 
 void config::clear_all_children()
@@ -929,6 +1119,7 @@ void config::clear_all_children()
 	// No validity check for this function.
 	children_.clear();
 	ordered_children.clear();
+	child_index_.reset();
 }
 
 void config::clear_attributes()
@@ -984,6 +1175,9 @@ config::const_all_children_itors config::all_children_range() const
 
 config::all_children_iterator config::ordered_begin()
 {
+	// The caller can mutate the children through the returned iterator.
+	invalidate_child_index();
+
 	return all_children_iterator(ordered_children.begin());
 }
 
@@ -994,6 +1188,9 @@ config::all_children_iterator config::ordered_end()
 
 config::all_children_itors config::all_children_range()
 {
+	// The caller can mutate the children through the returned iterators.
+	invalidate_child_index();
+
 	return all_children_itors(
 		all_children_iterator(ordered_children.begin()),
 		all_children_iterator(ordered_children.end())
@@ -1124,6 +1321,8 @@ void config::get_diff(const config& c, config& res) const
 void config::apply_diff(const config& diff, bool track /* = false */)
 {
 	check_valid(diff);
+	// change_child entries mutate the children's attributes in place.
+	invalidate_child_index();
 
 	if(track) {
 		values_[diff_track_attribute] = "modified";
@@ -1186,6 +1385,7 @@ void config::apply_diff(const config& diff, bool track /* = false */)
 
 void config::clear_diff_track(const config& diff)
 {
+	invalidate_child_index();
 	remove_attribute(diff_track_attribute);
 	for(const config& i : diff.child_range("delete_child")) {
 		const std::size_t index = lexical_cast<std::size_t>(i["index"].str());
@@ -1223,6 +1423,8 @@ void config::clear_diff_track(const config& diff)
 void config::merge_with(const config& c)
 {
 	check_valid(c);
+	// Shared tags are merged into the existing children in place.
+	invalidate_child_index();
 
 	std::vector<child_pos> to_remove;
 	std::map<std::string, unsigned> visitations;
@@ -1443,6 +1645,85 @@ std::string config::hash() const
 	return std::string(hash_str);
 }
 
+namespace
+{
+/** Heap payload of a std::string beyond its in-object small-string buffer. */
+std::size_t string_footprint(const std::string& s)
+{
+	static const std::size_t sso_capacity = std::string().capacity();
+	return s.capacity() > sso_capacity ? s.capacity() + 1 : 0;
+}
+
+/** Approximate book-keeping of a node-based map entry (tree links, colour). */
+constexpr std::size_t map_node_overhead = 4 * sizeof(void*);
+
+/** Attributes the heap payload of one attribute value to the stats. */
+struct attribute_value_footprint
+{
+	config::memory_stats& stats;
+	std::set<const t_string_base*>& seen_tstrings;
+
+	void operator()(const std::string& s) const
+	{
+		stats.attribute_bytes += string_footprint(s);
+	}
+
+	void operator()(const t_string& s) const
+	{
+		// Translatable strings share their payload on copy; count each
+		// distinct payload only once.
+		if(seen_tstrings.insert(&s.get()).second) {
+			stats.tstring_bytes += sizeof(t_string_base) + string_footprint(s.get().value());
+		}
+	}
+
+	template<typename T>
+	void operator()(const T&) const
+	{
+	}
+};
+} // namespace
+
+void config::accumulate_memory(memory_stats& stats, std::set<const t_string_base*>& seen_tstrings) const
+{
+	++stats.nodes;
+	stats.node_bytes += sizeof(config);
+
+	for(const attribute& attr : values_) {
+#ifdef CONFIG_FLAT_ATTRIBUTES
+		// Flat storage is contiguous; the first few entries even live in the
+		// node's inline buffer, so this errs slightly on the high side.
+		stats.attribute_bytes += sizeof(attribute);
+#else
+		stats.attribute_bytes += sizeof(attribute) + map_node_overhead;
+#endif
+		stats.attribute_bytes += string_footprint(attr.first);
+		attr.second.apply_visitor(attribute_value_footprint{stats, seen_tstrings});
+	}
+
+	for(const auto& item : children_) {
+		stats.child_bytes += sizeof(child_map::value_type) + map_node_overhead;
+		stats.child_bytes += string_footprint(item.first);
+		stats.child_bytes += item.second.capacity() * sizeof(std::unique_ptr<config>);
+
+		for(const auto& child : item.second) {
+			child->accumulate_memory(stats, seen_tstrings);
+		}
+	}
+
+	stats.child_bytes += ordered_children.capacity() * sizeof(child_pos);
+}
+
+config::memory_stats config::memory_usage() const
+{
+	check_valid();
+
+	memory_stats stats;
+	std::set<const t_string_base*> seen_tstrings;
+	accumulate_memory(stats, seen_tstrings);
+	return stats;
+}
+
 void config::swap(config& cfg)
 {
 	check_valid(cfg);
@@ -1450,6 +1731,9 @@ void config::swap(config& cfg)
 	values_.swap(cfg.values_);
 	children_.swap(cfg.children_);
 	ordered_children.swap(cfg.ordered_children);
+	// The index entries point at the child nodes, which were just swapped
+	// wholesale, so each index stays valid on its new owner.
+	child_index_.swap(cfg.child_index_);
 }
 
 void swap(config& lhs, config& rhs)
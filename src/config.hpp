@@ -40,6 +40,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -48,6 +49,11 @@
 
 #include <boost/range/iterator_range.hpp>
 
+#ifdef CONFIG_FLAT_ATTRIBUTES
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+#endif
+
 using config_key_type = std::string_view;
 enum class DEP_LEVEL : uint8_t;
 
@@ -101,6 +107,14 @@ public:
 
 	~config();
 
+	/**
+	 * Node storage comes from the thread's active config_arena, if any.
+	 * Arena-backed nodes are reclaimed wholesale when the arena dies, so
+	 * deleting them individually is a no-op.
+	 */
+	static void* operator new(std::size_t size);
+	static void operator delete(void* p);
+
 	// Verifies that the string can be used as a tag name
 	static bool valid_tag(config_key_type name);
 
@@ -215,11 +229,27 @@ public:
 	 */
 	using attribute_value = config_attribute_value;
 
+#ifdef CONFIG_FLAT_ATTRIBUTES
+	/**
+	 * Attributes are stored sorted in a contiguous vector, keeping the common
+	 * 2-6 attribute case inline without any heap allocation. Lookups are a
+	 * cache-friendly binary search instead of chasing tree nodes. Unlike
+	 * std::map, insertion and erasure invalidate iterators and references to
+	 * other attributes of the same config.
+	 */
+	typedef boost::container::flat_map<
+		std::string
+		, attribute_value
+		, std::less<>
+		, boost::container::small_vector<std::pair<std::string, attribute_value>, 6>
+	> attribute_map;
+#else
 	typedef std::map<
 		std::string
 		, attribute_value
 		, std::less<>
 	> attribute_map;
+#endif
 	typedef attribute_map::value_type attribute;
 	struct const_attribute_iterator;
 
@@ -352,7 +382,7 @@ public:
 	 *       For instance, -1 is the index of the last child.
 	 */
 	const config& child(config_key_type key, int n = 0) const
-	{ return const_cast<config*>(this)->child(key, n); }
+	{ return child_impl(key, n); }
 
 	/** Euivalent to @ref child, but returns an empty optional if the nth child was not found. */
 	utils::optional_reference<config> optional_child(config_key_type key, int n = 0);
@@ -549,8 +579,7 @@ public:
 		const std::string &value);
 
 	const config& find_child(config_key_type key, const std::string &name,
-		const std::string &value) const
-	{ return const_cast<config *>(this)->find_child(key, name, value); }
+		const std::string &value) const;
 
 private:
 	void clear_children_impl(config_key_type key);
@@ -582,6 +611,37 @@ public:
 	std::string debug() const;
 	std::string hash() const;
 
+	/** Deep memory accounting for a subtree, as filled in by memory_usage(). */
+	struct memory_stats
+	{
+		/** Number of config nodes in the subtree. */
+		std::size_t nodes = 0;
+		/** sizeof(config) summed over all nodes. */
+		std::size_t node_bytes = 0;
+		/** Attribute map entries, including keys and std::string payloads. */
+		std::size_t attribute_bytes = 0;
+		/** Child map and ordering book-keeping: map entries, keys, vectors. */
+		std::size_t child_bytes = 0;
+		/** Distinct translatable string payloads; shared payloads count once. */
+		std::size_t tstring_bytes = 0;
+
+		std::size_t total() const
+		{
+			return node_bytes + attribute_bytes + child_bytes + tstring_bytes;
+		}
+	};
+
+	/**
+	 * Estimates the heap footprint of this subtree.
+	 *
+	 * The numbers are estimates - allocator overhead is approximated from
+	 * element counts and in-object small-string buffers are not subtracted -
+	 * but they are stable between runs, which is what comparing subtrees
+	 * against each other needs. Translatable strings share their payload on
+	 * copy; each distinct payload is counted once per call.
+	 */
+	memory_stats memory_usage() const;
+
 	struct error : public game::error {
 		error(const std::string& message) : game::error(message) {}
 	};
@@ -837,6 +897,26 @@ private:
 	 */
 	std::vector<child_pos>::iterator remove_child(const child_map::iterator &l, unsigned pos);
 
+	/** Implementation of the @ref child overloads; does not touch the child index. */
+	const config& child_impl(config_key_type key, int n) const;
+
+	/**
+	 * Implementation of the @ref find_child overloads, accelerated by
+	 * @ref child_index_ for large child lists. Returns nullptr if there
+	 * is no match.
+	 */
+	const config* find_child_impl(config_key_type key, const std::string& name,
+		const std::string& value) const;
+
+	/**
+	 * Drops the lazy find_child() index. Out of line since child_index is
+	 * incomplete here; a cheap no-op when no index was built.
+	 */
+	void invalidate_child_index();
+
+	/** Recursive worker for @ref memory_usage; @a seen_tstrings dedups shared payloads. */
+	void accumulate_memory(memory_stats& stats, std::set<const t_string_base*>& seen_tstrings) const;
+
 	/** All the attributes of this node. */
 	attribute_map values_;
 
@@ -844,6 +924,16 @@ private:
 	child_map children_;
 
 	std::vector<child_pos> ordered_children;
+
+	/**
+	 * Lazily built per-(tag, attribute) lookup tables for find_child(), see
+	 * find_child_impl(). Null for the vast majority of nodes. The index is
+	 * dropped whenever the child structure changes or a mutable reference to
+	 * a child escapes, since such a reference can rewrite the attribute a
+	 * table is keyed on.
+	 */
+	struct child_index;
+	mutable std::unique_ptr<child_index> child_index_;
 };
 
 /** Implement non-member swap function for std::swap (calls @ref config::swap). */
@@ -0,0 +1,79 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "config_arena.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+	thread_local config_arena* current_arena = nullptr;
+}
+
+config_arena::config_arena(std::size_t block_size)
+	: blocks_()
+	, next_(nullptr)
+	, end_(nullptr)
+	, block_size_(block_size)
+{
+}
+
+config_arena::~config_arena()
+{
+	for(const block& b : blocks_) {
+		::operator delete(b.data);
+	}
+}
+
+void* config_arena::allocate(std::size_t size)
+{
+	// Keep every allocation maximally aligned so the bump pointer stays valid
+	// for any node size.
+	const std::size_t align = alignof(std::max_align_t);
+	size = (size + align - 1) & ~(align - 1);
+
+	if(static_cast<std::size_t>(end_ - next_) < size) {
+		new_block(size);
+	}
+
+	char* res = next_;
+	next_ += size;
+	return res;
+}
+
+void config_arena::new_block(std::size_t min_size)
+{
+	const std::size_t size = std::max(block_size_, min_size);
+	char* data = static_cast<char*>(::operator new(size));
+	blocks_.push_back(block{data, size});
+	next_ = data;
+	end_ = data + size;
+}
+
+config_arena* config_arena::current()
+{
+	return current_arena;
+}
+
+config_arena::scope::scope(config_arena& arena)
+	: previous_(current_arena)
+{
+	current_arena = &arena;
+}
+
+config_arena::scope::~scope()
+{
+	current_arena = previous_;
+}
@@ -0,0 +1,81 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * A monotonic bump allocator for config nodes.
+ *
+ * Building a large config tree allocates one node per child tag, which for a
+ * full game config load means millions of small new/delete pairs for memory
+ * that is discarded wholesale moments later. While a config_arena::scope is
+ * active on the current thread, config nodes are carved out of large blocks
+ * owned by the arena instead; deleting such a node releases no memory, and
+ * the blocks are returned to the system in one step when the arena is
+ * destroyed.
+ *
+ * Nodes allocated from an arena must not outlive it. Their destructors still
+ * run normally, so attribute and child containers are cleaned up as usual;
+ * only the node storage itself is arena-owned.
+ */
+class config_arena
+{
+public:
+	explicit config_arena(std::size_t block_size = 1024 * 1024);
+	~config_arena();
+
+	config_arena(const config_arena&) = delete;
+	config_arena& operator=(const config_arena&) = delete;
+
+	/** Allocates @a size bytes with suitable alignment for a config node. */
+	void* allocate(std::size_t size);
+
+	/** The arena active on the current thread, if any. */
+	static config_arena* current();
+
+	/**
+	 * Activates an arena for config node allocation on the current thread
+	 * for the duration of the object scope. Scopes may nest; the innermost
+	 * one wins.
+	 */
+	class scope
+	{
+	public:
+		explicit scope(config_arena& arena);
+		~scope();
+
+		scope(const scope&) = delete;
+		scope& operator=(const scope&) = delete;
+
+	private:
+		config_arena* previous_;
+	};
+
+private:
+	struct block
+	{
+		char* data;
+		std::size_t size;
+	};
+
+	void new_block(std::size_t min_size);
+
+	std::vector<block> blocks_;
+	char* next_;
+	char* end_;
+	std::size_t block_size_;
+};
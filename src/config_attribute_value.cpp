@@ -274,7 +274,20 @@ public:
 	T operator()(int i)                const { return static_cast<T>(i); }
 	T operator()(unsigned long long u) const { return static_cast<T>(u); }
 	T operator()(double d)             const { return static_cast<T>(d); }
-	T operator()(const std::string& s) const { return lexical_cast_default<T>(s, def_); }
+
+	T operator()(const std::string& s) const
+	{
+		// Strings that parse cleanly were already stored as a numeric type on
+		// assignment, so what reaches this point almost never converts. Skip
+		// the stream machinery when the text cannot even start a number.
+		const char c = s.empty() ? '\0' : s.front();
+		if(!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')) {
+			return def_;
+		}
+
+		return lexical_cast_default<T>(s, def_);
+	}
+
 	T operator()(const t_string&)     const { return def_; }
 
 private:
@@ -284,31 +297,61 @@ private:
 
 int config_attribute_value::to_int(int def) const
 {
+	// Numbers are normalized to int on assignment whenever they fit, so this
+	// is by far the most common case in hot loops; skip the visitor for it.
+	if(const int* p = utils::get_if<int>(&value_)) {
+		return *p;
+	}
+
 	return apply_visitor(attribute_numeric_visitor<int>(def));
 }
 
 long long config_attribute_value::to_long_long(long long def) const
 {
+	if(const int* p = utils::get_if<int>(&value_)) {
+		return *p;
+	}
+
 	return apply_visitor(attribute_numeric_visitor<long long>(def));
 }
 
 unsigned config_attribute_value::to_unsigned(unsigned def) const
 {
+	if(const int* p = utils::get_if<int>(&value_)) {
+		return static_cast<unsigned>(*p);
+	}
+
 	return apply_visitor(attribute_numeric_visitor<unsigned>(def));
 }
 
 std::size_t config_attribute_value::to_size_t(std::size_t def) const
 {
+	if(const int* p = utils::get_if<int>(&value_)) {
+		return static_cast<std::size_t>(*p);
+	}
+
 	return apply_visitor(attribute_numeric_visitor<std::size_t>(def));
 }
 
 std::time_t config_attribute_value::to_time_t(std::time_t def) const
 {
+	if(const int* p = utils::get_if<int>(&value_)) {
+		return *p;
+	}
+
 	return apply_visitor(attribute_numeric_visitor<std::time_t>(def));
 }
 
 double config_attribute_value::to_double(double def) const
 {
+	if(const int* p = utils::get_if<int>(&value_)) {
+		return *p;
+	}
+
+	if(const double* p = utils::get_if<double>(&value_)) {
+		return *p;
+	}
+
 	return apply_visitor(attribute_numeric_visitor<double>(def));
 }
 
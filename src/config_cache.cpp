@@ -22,6 +22,7 @@
 #include "log.hpp"
 #include "hash.hpp"
 #include "serialization/binary_or_text.hpp"
+#include "serialization/binary_wml.hpp"
 #include "serialization/parser.hpp"
 #include "serialization/string_utils.hpp"
 #include "game_version.hpp"
@@ -132,6 +133,47 @@ void config_cache::read_file(const std::string& file_path, config& cfg)
 #endif
 }
 
+bool config_cache::dependencies_unchanged(const std::string& deps_file)
+{
+	if(!filesystem::file_exists(deps_file)) {
+		return false;
+	}
+
+	config deps_cfg;
+	try {
+		read_file(deps_file, deps_cfg);
+	} catch(const config::error&) {
+		return false;
+	} catch(const filesystem::io_exception&) {
+		return false;
+	} catch(const std::ios_base::failure&) {
+		return false;
+	}
+
+	if(deps_cfg.empty()) {
+		return false;
+	}
+
+	for(const config& file_cfg : deps_cfg.child_range("file")) {
+		const std::string& path = file_cfg["path"].str();
+		if(filesystem::file_modified_time(path) != file_cfg["mtime"].to_time_t()
+			|| filesystem::file_size(path) != file_cfg["size"].to_int())
+		{
+			return false;
+		}
+	}
+
+	// A directory's modification time changes when entries are added or
+	// removed, which catches new files the file list above cannot see.
+	for(const config& dir_cfg : deps_cfg.child_range("dir")) {
+		if(filesystem::file_modified_time(dir_cfg["path"].str()) != dir_cfg["mtime"].to_time_t()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 preproc_map& config_cache::make_copy_map()
 {
 	preproc_map& res = config_cache_transaction::instance().get_active_map(defines_map_);
@@ -150,7 +192,15 @@ void config_cache::read_configs(const std::string& file_path, config& cfg, prepr
 {
 	//read the file and then write to the cache
 	filesystem::scoped_istream stream = preprocess_file(file_path, &defines_map);
-	read(cfg, *stream, validator);
+
+	if(validator) {
+		read(cfg, *stream, validator);
+	} else {
+		// Slurp the preprocessed text so the independent top-level blocks
+		// can be parsed on all cores.
+		const std::string buffer{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+		read_parallel(cfg, buffer);
+	}
 }
 
 void config_cache::read_cache(const std::string& file_path, config& cfg, abstract_validator* validator)
@@ -190,7 +240,12 @@ void config_cache::read_cache(const std::string& file_path, config& cfg, abstrac
 		const std::string fname = cache_path + "/" +
 								  cache_file_prefix_ +
 								  utils::sha1(defines_string.str()).hex_digest();
+		// The game config itself is cached in the memory-mappable binary
+		// format, which loads at disk-read speed instead of being re-parsed;
+		// the checksum and define files stay in (compressed) WML.
+		const std::string fname_bin = fname + ".wbc";
 		const std::string fname_checksum = fname + ".checksum" + extension;
+		const std::string fname_deps = fname + ".deps" + extension;
 
 		filesystem::file_tree_checksum dir_checksum;
 
@@ -217,12 +272,18 @@ void config_cache::read_cache(const std::string& file_path, config& cfg, abstrac
 			LOG_CACHE << "skipping cache validation (forced)\n";
 		}
 
-		if(filesystem::file_exists(fname + extension) && (force_valid_cache_ || (dir_checksum == filesystem::data_tree_checksum()))) {
-			LOG_CACHE << "found valid cache at '" << fname << extension << "' with defines_map " << defines_string.str() << "\n";
+		// An entry whose recorded dependencies are all unchanged is valid even
+		// if unrelated parts of the data tree were modified; the global
+		// checksum comparison remains as a fallback for entries written
+		// before a dependency list existed.
+		const bool deps_valid = !force_valid_cache_ && !fake_invalid_cache_ && dependencies_unchanged(fname_deps);
+
+		if(filesystem::file_exists(fname_bin) && (force_valid_cache_ || deps_valid || (dir_checksum == filesystem::data_tree_checksum()))) {
+			LOG_CACHE << "found valid cache at '" << fname_bin << "' with defines_map " << defines_string.str() << "\n";
 			log_scope("read cache");
 
 			try {
-				read_file(fname + extension,cfg);
+				read_binary_file(cfg, fname_bin);
 				const std::string define_file = fname + ".define" + extension;
 
 				if(filesystem::file_exists(define_file)) {
@@ -231,31 +292,47 @@ void config_cache::read_cache(const std::string& file_path, config& cfg, abstrac
 
 				return;
 			} catch(const config::error& e) {
-				ERR_CACHE << "cache " << fname << extension << " is corrupt. Loading from files: "<< e.message << std::endl;
+				ERR_CACHE << "cache " << fname_bin << " is corrupt. Loading from files: "<< e.message << std::endl;
 			} catch(const filesystem::io_exception&) {
-				ERR_CACHE << "error reading cache " << fname << extension << ". Loading from files" << std::endl;
-#ifdef HAVE_ZLIB
-			} catch (const boost::iostreams::gzip_error& e) {
-				//read_file -> ... -> read_gz can throw this exception.
-				ERR_CACHE << "cache " << fname << extension << " is corrupt. Error code: " << e.error() << std::endl;
-#endif
+				ERR_CACHE << "error reading cache " << fname_bin << ". Loading from files" << std::endl;
 			}
 		}
 
-		LOG_CACHE << "no valid cache found. Writing cache to '" << fname << extension << " with defines_map "<< defines_string.str() << "'\n";
+		LOG_CACHE << "no valid cache found. Writing cache to '" << fname_bin << " with defines_map "<< defines_string.str() << "'\n";
 
 		// Now we need queued defines so read them to memory
 		read_defines_queue();
 
 		preproc_map copy_map(make_copy_map());
 
-		read_configs(file_path, cfg, copy_map, validator);
+		std::set<std::string> dep_files, dep_dirs;
+		{
+			preproc_dependency_recorder recorder(dep_files, dep_dirs);
+			read_configs(file_path, cfg, copy_map, validator);
+		}
 		add_defines_map_diff(copy_map);
 
 		try {
-			write_file(fname + extension, cfg);
+			{
+				filesystem::scoped_ostream stream = filesystem::ostream_file(fname_bin);
+				write_binary(*stream, cfg);
+			}
 			write_file(fname + ".define" + extension, copy_map);
 
+			config deps_cfg;
+			for(const std::string& dep : dep_files) {
+				config& file_cfg = deps_cfg.add_child("file");
+				file_cfg["path"] = dep;
+				file_cfg["mtime"] = static_cast<long long>(filesystem::file_modified_time(dep));
+				file_cfg["size"] = filesystem::file_size(dep);
+			}
+			for(const std::string& dep : dep_dirs) {
+				config& dir_cfg = deps_cfg.add_child("dir");
+				dir_cfg["path"] = dep;
+				dir_cfg["mtime"] = static_cast<long long>(filesystem::file_modified_time(dep));
+			}
+			write_file(fname_deps, deps_cfg);
+
 			config checksum_cfg;
 
 			filesystem::data_tree_checksum().write(checksum_cfg);
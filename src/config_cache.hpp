@@ -166,6 +166,14 @@ private:
 
 	void read_cache(const std::string& path, config& cfg, abstract_validator* validator = nullptr);
 
+	/**
+	 * Whether every file and directory recorded in @a deps_file still has
+	 * the modification time and size it had when the cache entry was
+	 * written. Allows validating a single cache entry without checksumming
+	 * the whole data tree.
+	 */
+	bool dependencies_unchanged(const std::string& deps_file);
+
 	void read_configs(const std::string& path, config& cfg, preproc_map& defines, abstract_validator* validator = nullptr);
 	void load_configs(const std::string& path, config& cfg, abstract_validator* validator = nullptr);
 	void read_defines_queue();
@@ -23,6 +23,7 @@
 #include "display.hpp"
 #include "fake_unit_manager.hpp"
 #include "filesystem.hpp"
+#include "floating_label.hpp"
 #include "font/sdl_ttf_compat.hpp"
 #include "font/text.hpp"
 #include "preferences/game.hpp"
@@ -49,6 +50,7 @@
 #include "units/animation_component.hpp"
 #include "units/drawer.hpp"
 #include "units/orb_status.hpp"
+#include "utils/frame_profiler.hpp"
 #include "whiteboard/manager.hpp"
 #include "show_dialog.hpp"
 #include "gui/dialogs/loading_screen.hpp"
@@ -175,6 +177,11 @@ display::display(const display_context* dc,
 	, screen_(CVideo::get_singleton())
 	, currentTeam_(0)
 	, dont_show_all_(false)
+	, vision_cache_shrouded_()
+	, vision_cache_fogged_()
+	, vision_cache_generation_(0)
+	, vision_cache_team_(0)
+	, vision_cache_valid_(false)
 	, xpos_(0)
 	, ypos_(0)
 	, view_locked_(false)
@@ -496,12 +503,15 @@ void display::rebuild_all()
 void display::reload_map()
 {
 	redraw_background_ = true;
+	// The map may have been resized, so the cached visibility no longer lines up.
+	vision_cache_valid_ = false;
 	builder_->reload_map();
 }
 
 void display::change_display_context(const display_context * dc)
 {
 	dc_ = dc;
+	vision_cache_valid_ = false;
 	builder_->change_map(&dc_->map()); //TODO: Should display_context own and initialize the builder object?
 }
 
@@ -724,14 +734,69 @@ bool display::team_valid() const
 	return currentTeam_ < dc_->teams().size();
 }
 
+void display::update_vision_cache() const
+{
+	const std::size_t generation = shroud_map::vision_generation();
+	if(vision_cache_valid_ && vision_cache_generation_ == generation && vision_cache_team_ == currentTeam_) {
+		return;
+	}
+
+	const team& viewer = dc_->teams()[currentTeam_];
+	const int w = get_map().w();
+	const int h = get_map().h();
+
+	// One border row and column on each side, like the draw loop visits.
+	vision_cache_shrouded_.assign((w + 2) * (h + 2), false);
+	vision_cache_fogged_.assign((w + 2) * (h + 2), false);
+
+	std::size_t i = 0;
+	for(int y = -1; y <= h; ++y) {
+		for(int x = -1; x <= w; ++x, ++i) {
+			const map_location loc(x, y);
+			vision_cache_shrouded_[i] = viewer.shrouded(loc);
+			vision_cache_fogged_[i] = viewer.fogged(loc);
+		}
+	}
+
+	vision_cache_generation_ = generation;
+	vision_cache_team_ = currentTeam_;
+	vision_cache_valid_ = true;
+}
+
 bool display::shrouded(const map_location& loc) const
 {
-	return is_blindfolded() || (dont_show_all_ && dc_->teams()[currentTeam_].shrouded(loc));
+	if(is_blindfolded()) {
+		return true;
+	}
+
+	if(!dont_show_all_) {
+		return false;
+	}
+
+	if(loc.x < -1 || loc.x > get_map().w() || loc.y < -1 || loc.y > get_map().h()) {
+		return dc_->teams()[currentTeam_].shrouded(loc);
+	}
+
+	update_vision_cache();
+	return vision_cache_shrouded_[(loc.x + 1) + (loc.y + 1) * (get_map().w() + 2)];
 }
 
 bool display::fogged(const map_location& loc) const
 {
-	return is_blindfolded() || (dont_show_all_ && dc_->teams()[currentTeam_].fogged(loc));
+	if(is_blindfolded()) {
+		return true;
+	}
+
+	if(!dont_show_all_) {
+		return false;
+	}
+
+	if(loc.x < -1 || loc.x > get_map().w() || loc.y < -1 || loc.y > get_map().h()) {
+		return dc_->teams()[currentTeam_].fogged(loc);
+	}
+
+	update_vision_cache();
+	return vision_cache_fogged_[(loc.x + 1) + (loc.y + 1) * (get_map().w() + 2)];
 }
 
 int display::get_location_x(const map_location& loc) const
@@ -1175,19 +1240,19 @@ void display::get_terrain_images(const map_location &loc,
 			// We need to test for the tile to be rendered and
 			// not the location, since the transitions are rendered
 			// over the offmap-terrain and these need a ToD coloring.
-			surface surf;
+			image::atlas_region region;
 			const bool off_map = (image.get_filename() == off_map_name || image.get_modifications().find("NO_TOD_SHIFT()") != std::string::npos);
 
 			if(off_map) {
-				surf = image::get_image(image, image::SCALED_TO_HEX);
+				region = image::get_atlas_region(image, image::SCALED_TO_HEX);
 			} else if(lt.empty()) {
-				surf = image::get_image(image, image::SCALED_TO_HEX);
+				region = image::get_atlas_region(image, image::SCALED_TO_HEX);
 			} else {
-				surf = image::get_lighted_image(image, lt, image::SCALED_TO_HEX);
+				region = image::get_lighted_atlas_region(image, lt, image::SCALED_TO_HEX);
 			}
 
-			if (surf) {
-				terrain_image_vector_.push_back(std::move(surf));
+			if (region.valid()) {
+				terrain_image_vector_.push_back(std::move(region));
 			}
 		}
 	}
@@ -1304,6 +1369,10 @@ void display::drawing_buffer_commit()
 			SDL_Rect srcrect = blit.clip();
 			SDL_Rect *srcrectArg = (srcrect.x | srcrect.y | srcrect.w | srcrect.h)
 				? &srcrect : nullptr;
+			const SDL_Rect blit_rect = srcrectArg
+				? sdl::create_rect(blit.x(), blit.y(), srcrect.w, srcrect.h)
+				: sdl::create_rect(blit.x(), blit.y(), surf->w, surf->h);
+			mark_frame_dirty(sdl::intersect_rects(blit_rect, clip_rect));
 			sdl_blit(surf, srcrectArg, screen, &dstrect);
 			//NOTE: the screen part should already be marked as 'to update'
 		}
@@ -1316,6 +1385,19 @@ void display::drawing_buffer_clear()
 	drawing_buffer_.clear();
 }
 
+void display::mark_frame_dirty(const SDL_Rect& rect)
+{
+	if(rect.w <= 0 || rect.h <= 0) {
+		return;
+	}
+
+	if(frame_dirty_rect_.w == 0) {
+		frame_dirty_rect_ = rect;
+	} else {
+		frame_dirty_rect_ = sdl::union_rects(frame_dirty_rect_, rect);
+	}
+}
+
 void display::toggle_benchmark()
 {
 	benchmark = !benchmark;
@@ -1334,13 +1416,31 @@ void display::flip()
 
 	surface& frameBuffer = video().getSurface();
 
-	font::draw_floating_labels(frameBuffer);
+	const SDL_Rect label_rect = font::draw_floating_labels(frameBuffer);
 	events::raise_volatile_draw_event();
 
-	video().flip();
+	/*
+	 * Present only the area that changed rather than copying the whole
+	 * framebuffer to the display. That is this frame's tracked damage, the
+	 * labels drawn above, and the area restored behind the labels after the
+	 * previous present. Drawing outside the tracked paths (legacy widgets,
+	 * volatile handlers) only bumps the framebuffer change count and can be
+	 * anywhere, so it falls back to a full present.
+	 */
+	const SDL_Rect damage =
+		sdl::union_rects(frame_dirty_rect_, sdl::union_rects(label_restore_rect_, label_rect));
+
+	const bool untracked_changes = video().framebuffer_change_count() != drawn_framebuffer_changes_;
+
+	if(!untracked_changes && damage.w > 0) {
+		video().flip(damage);
+	} else {
+		video().flip();
+	}
 
 	events::raise_volatile_undraw_event();
-	font::undraw_floating_labels(frameBuffer);
+	label_restore_rect_ = font::undraw_floating_labels(frameBuffer);
+	frame_dirty_rect_ = sdl::empty_rect;
 }
 
 // frametime is in milliseconds
@@ -1356,6 +1456,10 @@ void display::update_display()
 	}
 
 	if(preferences::show_fps() || benchmark) {
+		// Collect profiling zones while the FPS display is up; the dump file
+		// is written once it is turned off again.
+		prof::enable(true);
+
 		static int frames = 0;
 		++frames;
 		const int sample_freq = 10;
@@ -1395,6 +1499,8 @@ void display::update_display()
 			drawn_hexes_ = 0;
 			invalidated_hexes_ = 0;
 
+			stream << prof::overlay_report();
+
 			font::floating_label flabel(stream.str());
 			flabel.set_font_size(12);
 			flabel.set_color(benchmark ? font::BAD_COLOR : font::NORMAL_COLOR);
@@ -1404,6 +1510,7 @@ void display::update_display()
 			fps_handle_ = font::add_floating_label(flabel);
 		}
 	} else if(fps_handle_ != 0) {
+		prof::enable(false);
 		font::remove_floating_label(fps_handle_);
 		fps_handle_ = 0;
 		drawn_hexes_ = 0;
@@ -1479,6 +1586,8 @@ void display::draw_all_panels()
 	}
 
 	render_buttons();
+
+	mark_frame_dirty(screen_.screen_area());
 }
 
 static void draw_background(surface screen, const SDL_Rect& area, const std::string& image)
@@ -1660,6 +1769,7 @@ void display::draw_init()
 		clip_rect_setter set_clip_rect(screen, &clip_rect);
 		SDL_FillRect(screen, &clip_rect, 0x00000000);
 		draw_background(screen, clip_rect, theme_.border().background_image);
+		mark_frame_dirty(clip_rect);
 		redraw_background_ = false;
 
 		// Force a full map redraw
@@ -1690,7 +1800,30 @@ void display::draw_wrap(bool update, bool force)
 	}
 
 	if(update) {
-		update_display();
+		/*
+		 * When nothing touched the frame buffer since the last flip, presenting
+		 * it again would only reproduce the image already on screen. Track the
+		 * damage accumulated by this frame's drawing and skip the present when
+		 * there is none, so that frames on an idle map cost nearly nothing.
+		 */
+		const unsigned int framebuffer_changes = screen_.framebuffer_change_count();
+		const int label_revision = font::get_floating_labels_revision();
+
+		const bool changed = frame_dirty_rect_.w != 0
+			|| framebuffer_changes != drawn_framebuffer_changes_
+			|| label_revision != drawn_label_revision_
+			|| font::floating_labels_animating();
+
+		if(force || benchmark || preferences::show_fps() || changed) {
+			DBG_DP << "presenting frame, damage "
+				   << frame_dirty_rect_.w << "x" << frame_dirty_rect_.h
+				   << "@" << frame_dirty_rect_.x << "," << frame_dirty_rect_.y << "\n";
+
+			update_display();
+
+			drawn_framebuffer_changes_ = framebuffer_changes;
+			drawn_label_revision_ = label_revision;
+		}
 
 		frametimes_.push_back(SDL_GetTicks() - last_frame_finished_);
 		fps_counter_++;
@@ -1781,6 +1914,15 @@ void display::announce(const std::string& message, const color_t& color, const a
 	prevLabel = font::add_floating_label(flabel);
 }
 
+void display::invalidate_minimap_loc(const map_location& loc)
+{
+	// No point tracking single cells when a full recalculation is pending.
+	if(minimap_ != nullptr) {
+		minimap_dirty_locs_.insert(loc);
+	}
+	redrawMinimap_ = true;
+}
+
 void display::draw_minimap()
 {
 	const SDL_Rect& area = minimap_area();
@@ -1789,10 +1931,24 @@ void display::draw_minimap()
 		return;
 	}
 
+	const team* viewing_team = dc_->teams().empty() ? nullptr : &dc_->teams()[currentTeam_];
+	const std::map<map_location, unsigned int>* reach_map =
+		(selectedHex_.valid() && !is_blindfolded()) ? &reach_map_ : nullptr;
+
+	if(minimap_ != nullptr && !minimap_dirty_locs_.empty()) {
+		// Only single cells changed; update them in place. A failure means
+		// the cached surfaces no longer match the map, so fall through to a
+		// full regeneration.
+		if(!image::updateMinimap(minimap_unscaled_, minimap_, get_map(),
+				minimap_dirty_locs_, viewing_team, reach_map)) {
+			minimap_ = nullptr;
+		}
+	}
+	minimap_dirty_locs_.clear();
+
 	if(minimap_ == nullptr || minimap_->w > area.w || minimap_->h > area.h) {
 		minimap_ = image::getMinimap(area.w, area.h, get_map(),
-			dc_->teams().empty() ? nullptr : &dc_->teams()[currentTeam_],
-			(selectedHex_.valid() && !is_blindfolded()) ? &reach_map_ : nullptr);
+			viewing_team, reach_map, false, &minimap_unscaled_);
 		if(minimap_ == nullptr) {
 			return;
 		}
@@ -1857,6 +2013,8 @@ void display::draw_minimap()
 	for(const auto& r : outline_parts) {
 		SDL_FillRect(screen_.getSurface(), &r, 0x00FFFFFF);
 	}
+
+	mark_frame_dirty(area);
 }
 
 void display::draw_minimap_units()
@@ -1971,6 +2129,8 @@ bool display::scroll(int xmove, int ymove, bool force)
 		SDL_SetSurfaceBlendMode(screen, SDL_BLENDMODE_NONE);
 		SDL_BlitSurface(screen, &srcrect, screen, &dstrect);
 		SDL_SetSurfaceBlendMode(screen, SDL_BLENDMODE_BLEND);
+
+		mark_frame_dirty(map_area());
 	}
 
 	if(diff_y != 0) {
@@ -2474,6 +2634,7 @@ void display::draw(bool update) {
 
 void display::draw(bool update,bool force) {
 //	log_scope("display::draw");
+	PROFILE_ZONE("display::draw");
 
 	if (screen_.update_locked()) {
 		return;
@@ -2552,6 +2713,7 @@ void display::draw_invalidated() {
 		}
 		draw_hex(loc);
 		drawn_hexes_+=1;
+		mark_frame_dirty(sdl::intersect_rects(hex_rect, clip_rect));
 	}
 	invalidated_hexes_ += invalidated_.size();
 
@@ -2586,11 +2748,15 @@ void display::draw_hex(const map_location& loc) {
 	if(!shrouded(loc)) {
 		// unshrouded terrain (the normal case)
 		get_terrain_images(loc, tod.id, BACKGROUND); // updates terrain_image_vector_
-		drawing_buffer_add(LAYER_TERRAIN_BG, loc, xpos, ypos, terrain_image_vector_);
+		for(const image::atlas_region& region : terrain_image_vector_) {
+			drawing_buffer_add(LAYER_TERRAIN_BG, loc, xpos, ypos, region.page, region.rect);
+		}
 		num_images_bg = terrain_image_vector_.size();
 
 		get_terrain_images(loc, tod.id, FOREGROUND); // updates terrain_image_vector_
-		drawing_buffer_add(LAYER_TERRAIN_FG, loc, xpos, ypos, terrain_image_vector_);
+		for(const image::atlas_region& region : terrain_image_vector_) {
+			drawing_buffer_add(LAYER_TERRAIN_FG, loc, xpos, ypos, region.page, region.rect);
+		}
 		num_images_fg = terrain_image_vector_.size();
 
 		// Draw the grid, if that's been enabled
@@ -2823,6 +2989,11 @@ void display::refresh_report(const std::string& report_name, const config * new_
 		return;
 	}
 
+	// Everything below draws to the screen, so the old and the new report
+	// areas both count as frame damage.
+	mark_frame_dirty(rect);
+	mark_frame_dirty(new_rect);
+
 	// Update the config in reports_.
 	report = *new_cfg;
 
@@ -3102,12 +3273,9 @@ void display::invalidate_animations()
 		}
 	}
 
-	for(const unit& u : dc_->units()) {
-		u.anim_comp().refresh();
-	}
-	for (const unit* u : *fake_unit_man_) {
-		u->anim_comp().refresh();
-	}
+	// Animation upkeep only touches enrolled components: units running a
+	// non-standing animation, plus standing units whose idle wake time is due.
+	unit_animation_component::refresh_active();
 
 
 	bool new_inval;
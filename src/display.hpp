@@ -73,6 +73,7 @@ namespace wb {
 #include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class gamemap;
@@ -624,6 +625,15 @@ public:
 	 */
 	void redraw_minimap() { redrawMinimap_ = true; }
 
+	/**
+	 * Schedule re-rendering of a single minimap cell.
+	 *
+	 * Prefer this over recalculate_minimap() when the affected hexes are
+	 * known (e.g. fog clearing): the next draw updates just those cells
+	 * instead of regenerating the whole minimap.
+	 */
+	void invalidate_minimap_loc(const map_location& loc);
+
 	virtual const time_of_day& get_time_of_day(const map_location& loc = map_location::null_location()) const;
 
 	virtual bool has_time_area() const {return false;}
@@ -718,6 +728,15 @@ protected:
 
 	void draw_minimap();
 
+	/**
+	 * Adds @a rect to the screen area damaged by the current frame's drawing.
+	 *
+	 * draw_wrap() skips presenting the frame buffer entirely when no damage
+	 * has accumulated and no floating label or widget needs a redraw, which
+	 * makes frames on an idle map nearly free.
+	 */
+	void mark_frame_dirty(const SDL_Rect& rect);
+
 	enum TERRAIN_TYPE { BACKGROUND, FOREGROUND};
 
 	void get_terrain_images(const map_location &loc,
@@ -737,6 +756,23 @@ protected:
 	CVideo& screen_;
 	std::size_t currentTeam_;
 	bool dont_show_all_; //const team *viewpoint_;
+
+	/**
+	 * Per-hex shroud and fog state of the viewing team, covering the map
+	 * plus its border. Rebuilt by update_vision_cache() only when the
+	 * vision data or the viewing team changes, so the per-frame draw loop
+	 * doesn't re-run the fog logic for every hex.
+	 */
+	mutable std::vector<bool> vision_cache_shrouded_;
+	mutable std::vector<bool> vision_cache_fogged_;
+	/** shroud_map::vision_generation() value the cache was built against. */
+	mutable std::size_t vision_cache_generation_;
+	/** Viewing team the cache was built for. */
+	mutable std::size_t vision_cache_team_;
+	mutable bool vision_cache_valid_;
+
+	/** Rebuilds the vision cache if it no longer matches the game state. */
+	void update_vision_cache() const;
 	/**
 	 * Position of the top-left corner of the viewport, in pixels.
 	 *
@@ -757,6 +793,10 @@ protected:
 	const std::unique_ptr<fake_unit_manager> fake_unit_man_;
 	const std::unique_ptr<terrain_builder> builder_;
 	surface minimap_;
+	/** Minimap before the final rescale, kept for incremental cell updates. */
+	surface minimap_unscaled_;
+	/** Hexes whose minimap cells need re-rendering on the next draw. */
+	std::set<map_location> minimap_dirty_locs_;
 	SDL_Rect minimap_location_;
 	bool redrawMinimap_;
 	bool redraw_background_;
@@ -802,6 +842,22 @@ protected:
 	/** Local version of preferences::animate_water, used to detect when it's changed. */
 	bool animate_water_;
 
+	/** Screen area damaged by the current frame's drawing, see mark_frame_dirty(). */
+	SDL_Rect frame_dirty_rect_ = sdl::empty_rect;
+
+	/**
+	 * Area restored behind the floating labels after the last present; the
+	 * screen still shows the labels there, so the next present has to cover
+	 * it even if nothing else touched it.
+	 */
+	SDL_Rect label_restore_rect_ = sdl::empty_rect;
+
+	/** Framebuffer change count when the frame buffer was last presented. */
+	unsigned int drawn_framebuffer_changes_ = 0u;
+
+	/** Floating label revision when the frame buffer was last presented. */
+	int drawn_label_revision_ = 0;
+
 private:
 
 	// This surface must be freed by the caller
@@ -812,7 +868,7 @@ private:
 
 	// This vector is a class member to avoid repeated memory allocations in get_terrain_images(),
 	// which turned out to be a significant bottleneck while profiling.
-	std::vector<surface> terrain_image_vector_;
+	std::vector<image::atlas_region> terrain_image_vector_;
 
 public:
 	/**
@@ -1040,7 +1096,12 @@ protected:
 	bool reach_map_changed_;
 	void process_reachmap_changes();
 
-	typedef std::map<map_location, std::vector<overlay>> overlay_map;
+	/**
+	 * The draw loop looks this map up once per visible hex per frame, so it
+	 * is a hash map; code that writes overlays out (the editor) must sort
+	 * the locations itself to get a stable order.
+	 */
+	typedef std::unordered_map<map_location, std::vector<overlay>> overlay_map;
 
 	virtual overlay_map& get_overlays() = 0;
 
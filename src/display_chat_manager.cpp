@@ -112,7 +112,7 @@ void display_chat_manager::add_chat_message(const std::time_t& time, const std::
 	}
 
 	int ypos = chat_message_x;
-	for(std::vector<chat_message>::const_iterator m = chat_messages_.begin(); m != chat_messages_.end(); ++m) {
+	for(std::deque<chat_message>::const_iterator m = chat_messages_.begin(); m != chat_messages_.end(); ++m) {
 		ypos += std::max(font::get_floating_label_rect(m->handle).h,
 			font::get_floating_label_rect(m->speaker_handle).h);
 	}
@@ -209,12 +209,14 @@ void display_chat_manager::prune_chat_messages(bool remove_all)
 			movement += font::get_floating_label_rect(old.handle).h;
 			font::remove_floating_label(old.speaker_handle);
 			font::remove_floating_label(old.handle);
-			chat_messages_.erase(chat_messages_.begin());
+			chat_messages_.pop_front();
 		}
 	}
 
-	for(const chat_message &cm : chat_messages_) {
-		font::move_floating_label(cm.speaker_handle, 0, - movement);
-		font::move_floating_label(cm.handle, 0, - movement);
+	if(movement != 0) {
+		for(const chat_message &cm : chat_messages_) {
+			font::move_floating_label(cm.speaker_handle, 0, - movement);
+			font::move_floating_label(cm.handle, 0, - movement);
+		}
 	}
 }
@@ -19,9 +19,9 @@
 
 #include <cstdint>
 #include <ctime>
+#include <deque>
 #include <set>
 #include <string>
-#include <vector>
 
 class display;
 
@@ -57,7 +57,8 @@ private:
 
 	void prune_chat_messages(bool remove_all=false);
 
-	std::vector<chat_message> chat_messages_;
+	/** Oldest message first; pruning pops the front, new messages push the back. */
+	std::deque<chat_message> chat_messages_;
 
 	display & my_disp_;
 };
@@ -193,9 +193,17 @@ void editor_controller::do_screenshot(const std::string& screenshot_filename /*
 {
 	try {
 		surface screenshot = gui().screenshot(true);
-		if(!screenshot || image::save_image(screenshot, screenshot_filename) != image::save_result::success) {
+		if(!screenshot) {
 			ERR_ED << "Screenshot creation failed!\n";
+			return;
 		}
+		// Nothing here depends on the write; let a worker encode the
+		// (potentially huge) map image while the editor stays responsive.
+		image::save_image_async(screenshot, screenshot_filename, [](image::save_result res) {
+			if(res != image::save_result::success) {
+				ERR_ED << "Screenshot creation failed!\n";
+			}
+		});
 	} catch (const wml_exception& e) {
 		e.show();
 	}
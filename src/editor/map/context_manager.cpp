@@ -540,9 +540,14 @@ void context_manager::refresh_after_action(bool drag_part)
 	const std::set<map_location>& changed_locs = get_map_context().changed_locations();
 
 	if(get_map_context().needs_terrain_rebuild()) {
-		if((auto_update_transitions_ == preferences::editor::TRANSITION_UPDATE_ON)
-		|| ((auto_update_transitions_ == preferences::editor::TRANSITION_UPDATE_PARTIAL)
-		&& (!drag_part || get_map_context().everything_changed())))
+		// A full terrain builder re-run is never done for the individual
+		// parts of a brush stroke, even with transition updates on: on big
+		// maps that made every drag event rebuild the whole map. The painted
+		// hexes get their plain images immediately via the per-location path
+		// below, and the flag stays set so the stroke-ending refresh (mouse
+		// up) runs the one authoritative rebuild.
+		if((auto_update_transitions_ != preferences::editor::TRANSITION_UPDATE_OFF)
+		&& (!drag_part || get_map_context().everything_changed()))
 		{
 			gui_.rebuild_all();
 			get_map_context().set_needs_terrain_rebuild(false);
@@ -566,7 +571,11 @@ void context_manager::refresh_after_action(bool drag_part)
 	}
 
 	get_map_context().clear_changed_locations();
-	gui_.recalculate_minimap();
+
+	// The minimap repaint is likewise deferred to the end of the stroke.
+	if(!drag_part) {
+		gui_.recalculate_minimap();
+	}
 }
 
 void context_manager::resize_map_dialog()
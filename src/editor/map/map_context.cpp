@@ -34,6 +34,8 @@
 
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 namespace editor
 {
 editor_team_info::editor_team_info(const team& t)
@@ -497,12 +499,21 @@ config map_context::to_config()
 
 	labels_.write(scenario);
 
+	// The overlays live in a hash map; write them in location order so a
+	// saved scenario doesn't shuffle its [item] tags from save to save.
+	std::vector<map_location> overlay_locs;
+	overlay_locs.reserve(overlays_.size());
 	for(const auto& overlay_pair : overlays_) {
-		for(const overlay& o : overlay_pair.second) {
+		overlay_locs.push_back(overlay_pair.first);
+	}
+	std::sort(overlay_locs.begin(), overlay_locs.end());
+
+	for(const map_location& loc : overlay_locs) {
+		for(const overlay& o : overlays_[loc]) {
 			config& item = scenario.add_child("item");
 
 			// Write x,y location
-			overlay_pair.first.write(item);
+			loc.write(item);
 
 			// These should always have a value
 			item["image"] = o.image;
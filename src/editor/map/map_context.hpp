@@ -26,6 +26,7 @@
 #include "tod_manager.hpp"
 #include "units/map.hpp"
 #include <optional>
+#include <unordered_map>
 
 #include <vector>
 class game_config_view;
@@ -512,7 +513,9 @@ private:
 	typedef std::map<std::string, sound::music_track> music_map;
 	music_map music_tracks_;
 
-	typedef std::map<map_location, std::vector<overlay>> overlay_map;
+	// Must match display::overlay_map, since editor_display hands this
+	// container to the display code.
+	typedef std::unordered_map<map_location, std::vector<overlay>> overlay_map;
 	overlay_map overlays_;
 
 public:
@@ -246,6 +246,12 @@ void editor_palette<Item>::draw_contents()
 		palette_menu_button->set_overlay(icon);
 	}
 
+	const std::string cache_context = icon_cache_context();
+	if (cache_context != icon_cache_context_) {
+		icon_cache_.clear();
+		icon_cache_context_ = cache_context;
+	}
+
 	unsigned int y = palette_y_;
 	unsigned int x = palette_x_;
 	int starting = items_start_;
@@ -274,17 +280,24 @@ void editor_palette<Item>::draw_contents()
 		//typedef std::map<std::string, Item> item_map_wurscht;
 		typename item_map::iterator item = item_map_.find(item_id);
 
-		surface item_image(nullptr);
-		std::stringstream tooltip_text;
-		draw_item((*item).second, item_image, tooltip_text);
-
-		bool is_core = non_core_items_.find(get_id((*item).second)) == non_core_items_.end();
-		if (!is_core) {
-			tooltip_text << " "
-					<< font::span_color(font::BAD_COLOR)
-			<< _("(non-core)") << "\n"
-			<< _("Will not work in game without extra care.")
-			<< "</span>";
+		// Materialize the icon on first display; afterwards redraws reuse
+		// the cached surface and tooltip.
+		auto icon = icon_cache_.find(item_id);
+		if (icon == icon_cache_.end()) {
+			surface item_image(nullptr);
+			std::stringstream tooltip_text;
+			draw_item((*item).second, item_image, tooltip_text);
+
+			bool is_core = non_core_items_.find(get_id((*item).second)) == non_core_items_.end();
+			if (!is_core) {
+				tooltip_text << " "
+						<< font::span_color(font::BAD_COLOR)
+				<< _("(non-core)") << "\n"
+				<< _("Will not work in game without extra care.")
+				<< "</span>";
+			}
+
+			icon = icon_cache_.emplace(item_id, cached_icon{item_image, tooltip_text.str()}).first;
 		}
 
 		const int counter_from_zero = counter - starting;
@@ -295,8 +308,8 @@ void editor_palette<Item>::draw_contents()
 		dstrect.h = item_size_ + 2;
 
 		tile.set_location(dstrect);
-		tile.set_tooltip_string(tooltip_text.str());
-		tile.set_item_image(item_image);
+		tile.set_tooltip_string(icon->second.tooltip);
+		tile.set_item_image(icon->second.image);
 		tile.set_item_id(item_id);
 
 //		if (get_id((*item).second) == selected_bg_item_
@@ -330,6 +343,20 @@ void editor_palette<Item>::draw_contents()
 			y += item_space_;
 		++counter;
 	}
+
+	// Queue background decodes for the items one screenful away in either
+	// direction, so they are ready by the time they scroll into view.
+	const int prefetch_from = std::max(starting - num_visible_items(), 0);
+	const int prefetch_to = std::min(ending + num_visible_items(), num_items());
+	for (int i = prefetch_from; i < prefetch_to; ++i) {
+		if (i >= starting && i < ending) {
+			continue;
+		}
+		const std::string& item_id = active_group()[i];
+		if (icon_cache_.find(item_id) == icon_cache_.end()) {
+			prefetch_item(item_map_.find(item_id)->second);
+		}
+	}
 }
 
 // Force compilation of the following template instantiations
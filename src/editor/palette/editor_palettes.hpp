@@ -108,6 +108,19 @@ private:
 
 	virtual void draw_item(const Item& item, surface& item_image, std::stringstream& tooltip) = 0;
 
+	/**
+	 * Queues the background decode of an item's image files ahead of the
+	 * item scrolling into view, so that draw_item() finds them already in
+	 * the image cache. Default does nothing.
+	 */
+	virtual void prefetch_item(const Item& /*item*/) {}
+
+	/**
+	 * State the cached icons and tooltips depend on besides the item
+	 * itself; the cache is rebuilt whenever the returned value changes.
+	 */
+	virtual std::string icon_cache_context() { return ""; }
+
 	virtual const std::string& get_id(const Item& item) = 0;
 
 	/** Setup the internal data structure. */
@@ -183,6 +196,23 @@ private:
     std::vector<gui::tristate_button> buttons_;
 
     int help_handle_;
+
+	/** Icon and tooltip produced by draw_item(), built on first display. */
+	struct cached_icon
+	{
+		surface image;
+		std::string tooltip;
+	};
+
+	/**
+	 * Per-item icon cache, so the image modification chain and scaling in
+	 * draw_item() run once per item, when it first scrolls into view,
+	 * instead of on every redraw.
+	 */
+	std::map<std::string, cached_icon> icon_cache_;
+
+	/** The icon_cache_context() value icon_cache_ was built for. */
+	std::string icon_cache_context_;
 };
 
 
@@ -83,6 +83,14 @@ void item_palette::draw_item(const overlay& item, surface& image, std::stringstr
 	tooltip_text << item.name;
 }
 
+void item_palette::prefetch_item(const overlay& item)
+{
+	const std::string& filename = item.image.empty() ? item.halo : item.image;
+	if(!filename.empty()) {
+		image::prefetch_image(filename);
+	}
+}
+
 item_palette::item_palette(editor_display &gui, const game_config_view& cfg,
                            editor_toolkit &toolkit)
 //TODO avoid magic numbers
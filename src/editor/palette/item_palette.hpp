@@ -47,6 +47,8 @@ private:
 
 	virtual void draw_item(const overlay& item, surface& image, std::stringstream& tooltip_text);
 
+	virtual void prefetch_item(const overlay& item);
+
 };
 
 }
@@ -214,6 +214,21 @@ void terrain_palette::draw_item(const t_translation::terrain_code& terrain,
 	}
 }
 
+void terrain_palette::prefetch_item(const t_translation::terrain_code& terrain)
+{
+	const t_translation::terrain_code base_terrain = map().get_terrain_info(terrain).default_base();
+	if(base_terrain != t_translation::NONE_TERRAIN) {
+		image::prefetch_image(map().get_terrain_info(base_terrain).editor_image());
+	}
+	image::prefetch_image(map().get_terrain_info(terrain).editor_image());
+}
+
+std::string terrain_palette::icon_cache_context()
+{
+	// The tooltips embed the terrain codes while their display is enabled.
+	return gui_.get_draw_terrain_codes() ? "codes" : "";
+}
+
 terrain_palette::terrain_palette(editor_display &gui, const game_config_view& cfg, editor_toolkit &toolkit)
 //TODO avoid magic numbers
 	:	editor_palette<t_translation::terrain_code>(gui, cfg, 36, 4, toolkit)
@@ -58,6 +58,10 @@ private:
 
 	virtual void draw_item(const t_translation::terrain_code& terrain, surface& item_image, std::stringstream& tooltip_text);
 
+	virtual void prefetch_item(const t_translation::terrain_code& terrain);
+
+	virtual std::string icon_cache_context();
+
 };
 
 }
@@ -95,6 +95,19 @@ void unit_palette::draw_item(const unit_type& u, surface& image, std::stringstre
 	tooltip_text << u.type_name();
 }
 
+void unit_palette::prefetch_item(const unit_type& u)
+{
+	// The team recoloring still runs on the main thread in draw_item();
+	// only the base image decode is handed to the worker.
+	image::prefetch_image(u.image());
+}
+
+std::string unit_palette::icon_cache_context()
+{
+	// The icons are recolored to the viewing side.
+	return std::to_string(gui_.viewing_side());
+}
+
 unit_palette::unit_palette(editor_display &gui, const game_config_view& cfg,
                            editor_toolkit &toolkit)
 //TODO avoid magic numbers
@@ -50,6 +50,10 @@ private:
 
 	virtual void draw_item(const unit_type& terrain, surface& image, std::stringstream& tooltip_text);
 
+	virtual void prefetch_item(const unit_type& u);
+
+	virtual std::string icon_cache_context();
+
 	virtual bool is_selected_bg_item(const std::string& id);
 
 	virtual void select_bg_item(const std::string& item_id);
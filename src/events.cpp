@@ -20,6 +20,7 @@
 #include "log.hpp"
 #include "quit_confirmation.hpp"
 #include "sdl/userevent.hpp"
+#include "utils/frame_profiler.hpp"
 #include "utils/ranges.hpp"
 #include "video.hpp"
 
@@ -476,6 +477,11 @@ void pump()
 		return;
 	}
 
+	// Each pump is one mainloop iteration, which is as close to a frame
+	// boundary as exists in every loop flavour.
+	prof::new_frame();
+	PROFILE_ZONE("events::pump");
+
 	peek_for_resize();
 	pump_info info;
 
@@ -551,6 +557,29 @@ void pump()
 		events.erase(first_draw_event + 1, events.end());
 	}
 
+	// Only deliver the last mouse motion of each uninterrupted run. Rapid
+	// motion can queue dozens of events per pump and every one of them
+	// triggers hover work such as pathfinding previews, while only the
+	// newest position matters. Runs are broken by any other event and by
+	// button state or device changes, and the relative motion of dropped
+	// events is accumulated so handlers tracking deltas see the full move.
+	auto motion_out = events.begin();
+	for(auto it = events.begin(); it != events.end(); ++it) {
+		const auto next = std::next(it);
+		if(it->type == SDL_MOUSEMOTION && next != events.end()
+			&& next->type == SDL_MOUSEMOTION
+			&& next->motion.which == it->motion.which
+			&& next->motion.state == it->motion.state
+		) {
+			next->motion.xrel += it->motion.xrel;
+			next->motion.yrel += it->motion.yrel;
+			continue;
+		}
+
+		*motion_out++ = *it;
+	}
+	events.erase(motion_out, events.end());
+
 	for(SDL_Event& event : events) {
 		for(context& c : event_contexts) {
 			c.add_staging_handlers();
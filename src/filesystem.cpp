@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <set>
+#include <unordered_set>
 
 // Copied from boost::predef, as it's there only since 1.55.
 #include <SDL2/SDL_filesystem.h>
@@ -149,6 +150,10 @@ static bool create_directory_if_missing(const bfs::path& dirpath)
 		ERR_FS << "Failed to create directory " << dirpath.string() << ": " << ec.message() << '\n';
 	}
 
+	if(created) {
+		path_index_add(dirpath.string(), true);
+	}
+
 	return created;
 }
 
@@ -509,6 +514,10 @@ bool make_directory(const std::string& dirname)
 		ERR_FS << "Failed to create directory " << dirname << ": " << ec.message() << '\n';
 	}
 
+	if(created) {
+		path_index_add(dirname, true);
+	}
+
 	return created;
 }
 
@@ -527,6 +536,8 @@ bool delete_directory(const std::string& dirname, const bool keep_pbl)
 			if(ec) {
 				LOG_FS << "remove(" << f << "): " << ec.message() << '\n';
 				ret = false;
+			} else {
+				path_index_remove(f);
 			}
 		}
 	}
@@ -545,6 +556,8 @@ bool delete_directory(const std::string& dirname, const bool keep_pbl)
 		if(ec) {
 			LOG_FS << "remove(" << dirname << "): " << ec.message() << '\n';
 			ret = false;
+		} else {
+			path_index_remove(dirname);
 		}
 	}
 
@@ -559,9 +572,27 @@ bool delete_file(const std::string& filename)
 		ERR_FS << "Could not delete file " << filename << ": " << ec.message() << '\n';
 	}
 
+	if(ret) {
+		path_index_remove(filename);
+	}
+
 	return ret;
 }
 
+bool rename_file(const std::string& old_name, const std::string& new_name)
+{
+	error_code ec;
+	bfs::rename(bfs::path(old_name), bfs::path(new_name), ec);
+	if(ec) {
+		ERR_FS << "Could not rename file " << old_name << " to " << new_name << ": " << ec.message() << '\n';
+		return false;
+	}
+
+	path_index_remove(old_name);
+	path_index_add(new_name, false);
+	return true;
+}
+
 std::string read_file(const std::string& fname)
 {
 	scoped_istream is = istream_file(fname);
@@ -636,6 +667,11 @@ bool is_bzip2_file(const std::string& filename)
 	return bfs::path(filename).extension() == ".bz2";
 }
 
+bool is_zstd_file(const std::string& filename)
+{
+	return bfs::path(filename).extension() == ".zst";
+}
+
 int file_size(const std::string& fname)
 {
 	error_code ec;
@@ -773,6 +809,195 @@ std::set<std::string> binary_paths;
 typedef std::map<std::string, std::vector<std::string>> paths_map;
 paths_map binary_paths_cache;
 
+/**
+ * In-memory index of every path under the data and userdata roots.
+ *
+ * Binary path resolution probes dozens of candidate locations per lookup
+ * and nearly all of them miss; walking each root once turns those stat
+ * calls into hash lookups. There is no directory watching facility in this
+ * tree, so the index is dropped together with the binary path cache on
+ * config reloads and add-on changes, and files the engine itself creates
+ * or deletes are recorded as it goes (see path_index_add()).
+ */
+class path_index
+{
+public:
+	/**
+	 * Looks up @a fpath, walking its root first when needed. Returns false
+	 * when the path lies outside the indexed roots (or its root could not
+	 * be walked) and the caller has to fall back to a real stat.
+	 */
+	bool lookup(const bfs::path& fpath, bool want_dir, bool& exists)
+	{
+		if(!roots_set_) {
+			init_roots();
+		}
+
+		const std::string p = key(fpath);
+		root_info* root = find_root(p);
+		if(root == nullptr) {
+			return false;
+		}
+
+		if(!root->walked) {
+			walk_root(*root);
+		}
+
+		if(!root->usable) {
+			return false;
+		}
+
+		if(want_dir) {
+			exists = dirs_.count(p) != 0;
+		} else {
+			exists = files_.count(p) != 0 || dirs_.count(p) != 0;
+		}
+
+		return true;
+	}
+
+	/** Records a path the engine created. Ignored outside the walked roots. */
+	void add(const std::string& path, bool is_directory)
+	{
+		const std::string p = key(bfs::path(path));
+		root_info* root = find_root(p);
+		if(root == nullptr || !root->walked) {
+			return;
+		}
+
+		(is_directory ? dirs_ : files_).insert(p);
+	}
+
+	/** Forgets a deleted path along with everything beneath it. */
+	void remove(const std::string& path)
+	{
+		const std::string p = key(bfs::path(path));
+
+		// Plain files just drop out; only directories need the subtree scan.
+		if(files_.erase(p) > 0 && dirs_.count(p) == 0) {
+			return;
+		}
+
+		const std::string prefix = p + "/";
+		const auto erase_subtree = [&p, &prefix](std::unordered_set<std::string>& entries) {
+			for(auto it = entries.begin(); it != entries.end();) {
+				if(*it == p || it->compare(0, prefix.size(), prefix) == 0) {
+					it = entries.erase(it);
+				} else {
+					++it;
+				}
+			}
+		};
+
+		erase_subtree(files_);
+		erase_subtree(dirs_);
+	}
+
+	void clear()
+	{
+		files_.clear();
+		dirs_.clear();
+		roots_.clear();
+		roots_set_ = false;
+	}
+
+private:
+	struct root_info
+	{
+		std::string prefix;
+		bool walked = false;
+		bool usable = false;
+	};
+
+	/**
+	 * Canonical index key: lexically normal, generic separators, no
+	 * trailing slash. Candidate paths arrive in forms like "<root>/data/."
+	 * or "<root>/data/" which must match what the walk stored.
+	 */
+	static std::string key(const bfs::path& fpath)
+	{
+		std::string p = fpath.lexically_normal().generic_string();
+		while(p.size() > 1 && p.back() == '/') {
+			p.pop_back();
+		}
+
+		return p;
+	}
+
+	/**
+	 * The roots are read on the first lookup rather than in add() or
+	 * remove(), which also run while the user data directory is still
+	 * being set up.
+	 */
+	void init_roots()
+	{
+		roots_set_ = true;
+#ifndef NANOHEX
+		roots_.push_back({key(bfs::path(get_user_data_dir()))});
+#endif
+		if(!game_config::path.empty()) {
+			roots_.push_back({key(bfs::path(game_config::path))});
+		}
+	}
+
+	root_info* find_root(const std::string& p)
+	{
+		for(root_info& root : roots_) {
+			if(p.compare(0, root.prefix.size(), root.prefix) == 0
+				&& (p.size() == root.prefix.size() || p[root.prefix.size()] == '/'))
+			{
+				return &root;
+			}
+		}
+
+		return nullptr;
+	}
+
+	void walk_root(root_info& root)
+	{
+		root.walked = true;
+
+		error_code ec;
+		bfs::recursive_directory_iterator it(root.prefix, bfs::directory_options::follow_directory_symlink, ec);
+		if(ec) {
+			LOG_FS << "Failed to walk " << root.prefix << ": " << ec.message() << '\n';
+			return;
+		}
+
+		dirs_.insert(root.prefix);
+		for(const bfs::recursive_directory_iterator end; it != end;) {
+			// Guards against directory symlink cycles.
+			if(it.depth() >= 32) {
+				it.disable_recursion_pending();
+			}
+
+			error_code status_ec;
+			if(bfs::is_directory(it->status(status_ec))) {
+				dirs_.insert(it->path().generic_string());
+			} else {
+				files_.insert(it->path().generic_string());
+			}
+
+			it.increment(ec);
+			if(ec) {
+				// An unreadable subtree would make everything under it look
+				// missing, so give up on the whole root instead.
+				LOG_FS << "Failed to walk " << root.prefix << ": " << ec.message() << '\n';
+				return;
+			}
+		}
+
+		root.usable = true;
+	}
+
+	std::unordered_set<std::string> files_;
+	std::unordered_set<std::string> dirs_;
+	std::vector<root_info> roots_;
+	bool roots_set_ = false;
+};
+
+path_index file_index;
+
 } // namespace
 
 static void init_binary_paths()
@@ -831,6 +1056,39 @@ void binary_paths_manager::cleanup()
 void clear_binary_paths_cache()
 {
 	binary_paths_cache.clear();
+	file_index.clear();
+}
+
+void path_index_add(const std::string& path, bool is_directory)
+{
+	file_index.add(path, is_directory);
+}
+
+void path_index_remove(const std::string& path)
+{
+	file_index.remove(path);
+}
+
+/** file_exists() with the path index consulted first. */
+static bool indexed_file_exists(const bfs::path& fpath)
+{
+	bool exists;
+	if(file_index.lookup(fpath, false, exists)) {
+		return exists;
+	}
+
+	return file_exists(fpath);
+}
+
+/** is_directory_internal() with the path index consulted first. */
+static bool indexed_is_directory(const bfs::path& fpath)
+{
+	bool exists;
+	if(file_index.lookup(fpath, true, exists)) {
+		return exists;
+	}
+
+	return is_directory_internal(fpath);
 }
 
 static bool is_legal_file(const std::string& filename_str)
@@ -936,7 +1194,7 @@ std::string get_binary_file_location(const std::string& type, const std::string&
 
 		DBG_FS << "  checking '" << bp << "'\n";
 
-		if(file_exists(bpath)) {
+		if(indexed_file_exists(bpath)) {
 			DBG_FS << "  found at '" << bpath.string() << "'\n";
 			if(result.empty()) {
 				result = bpath.string();
@@ -961,7 +1219,7 @@ std::string get_binary_dir_location(const std::string& type, const std::string&
 		bfs::path bpath(bp);
 		bpath /= filename;
 		DBG_FS << "  checking '" << bp << "'\n";
-		if(is_directory_internal(bpath)) {
+		if(indexed_is_directory(bpath)) {
 			DBG_FS << "  found at '" << bpath.string() << "'\n";
 			return bpath.string();
 		}
@@ -997,7 +1255,7 @@ std::string get_wml_location(const std::string& filename, const std::string& cur
 		result /= bfs::path(game_config::path) / "data" / fpath;
 	}
 
-	if(result.empty() || !file_exists(result)) {
+	if(result.empty() || !indexed_file_exists(result)) {
 		DBG_FS << "  not found\n";
 		result.clear();
 	} else {
@@ -1125,7 +1383,7 @@ std::string get_localized_path(const std::string& file, const std::string& suff)
 	langs.push_back("en_US");
 	for(const std::string& lang : langs) {
 		std::string loc_file = dir + "/" + "l10n" + "/" + lang + "/" + loc_base;
-		if(filesystem::file_exists(loc_file)) {
+		if(indexed_file_exists(bfs::path(loc_file))) {
 			return loc_file;
 		}
 	}
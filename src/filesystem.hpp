@@ -203,6 +203,8 @@ std::string get_exe_dir();
 bool make_directory(const std::string& dirname);
 bool delete_directory(const std::string& dirname, const bool keep_pbl = false);
 bool delete_file(const std::string& filename);
+/** Moves @a old_name over @a new_name, replacing it atomically if it exists. */
+bool rename_file(const std::string& old_name, const std::string& new_name);
 
 bool looks_like_pbl(const std::string& file);
 
@@ -256,8 +258,11 @@ bool is_gzip_file(const std::string& filename);
 /** Returns true if the file ends with '.bz2'. */
 bool is_bzip2_file(const std::string& filename);
 
+/** Returns true if the file ends with '.zst'. */
+bool is_zstd_file(const std::string& filename);
+
 inline bool is_compressed_file(const std::string& filename) {
-	return is_gzip_file(filename) || is_bzip2_file(filename);
+	return is_gzip_file(filename) || is_bzip2_file(filename) || is_zstd_file(filename);
 }
 
 /**
@@ -289,6 +294,9 @@ struct file_tree_checksum
 /** Get the time at which the data/ tree was last modified at. */
 const file_tree_checksum& data_tree_checksum(bool reset = false);
 
+/** Adds the files under @a path, recursively, to the checksum @a res. */
+void get_tree_checksum(const std::string& path, file_tree_checksum& res);
+
 /** Returns the size of a file, or -1 if the file doesn't exist. */
 int file_size(const std::string& fname);
 
@@ -417,6 +425,14 @@ private:
 
 void clear_binary_paths_cache();
 
+/**
+ * Keeps the cached index of the data and userdata trees (used by
+ * get_binary_file_location() and friends) in sync when the engine itself
+ * creates or deletes files. Paths outside the indexed roots are ignored.
+ */
+void path_index_add(const std::string& path, bool is_directory);
+void path_index_remove(const std::string& path);
+
 /**
  * Returns a vector with all possible paths to a given type of binary,
  * e.g. 'images', 'sounds', etc,
@@ -256,6 +256,11 @@ static void get_file_tree_checksum_internal(const std::string& path, file_tree_c
 	}
 }
 
+void get_tree_checksum(const std::string& path, file_tree_checksum& res)
+{
+	get_file_tree_checksum_internal(path, res);
+}
+
 const file_tree_checksum& data_tree_checksum(bool reset)
 {
 	static file_tree_checksum checksum;
@@ -116,7 +116,9 @@ filesystem::scoped_ostream ostream_file(const std::string& fname, std::ios_base:
 	assert(mode == std::ios_base::binary);
 	LOG_FS << "streaming " << fname << " for writing.\n";
 	try {
-		return std::make_unique<boost::iostreams::stream<rwops_device>>(fname.c_str(), "w");
+		filesystem::scoped_ostream s = std::make_unique<boost::iostreams::stream<rwops_device>>(fname.c_str(), "w");
+		path_index_add(fname, false);
+		return s;
 	} catch(const BOOST_IOSTREAMS_FAILURE& e) {
 		// If this operation failed because the parent directory didn't exist, create the parent directory and
 		// retry.
@@ -20,6 +20,7 @@
 #include "log.hpp"
 #include "video.hpp"
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <stack>
@@ -36,6 +37,9 @@ typedef std::map<int, font::floating_label> label_map;
 label_map labels;
 int label_id = 1;
 
+/** Bumped whenever the set of labels changes, see font::get_floating_labels_revision(). */
+int label_revision = 0;
+
 std::stack<std::set<int>> label_contexts;
 }
 
@@ -180,6 +184,17 @@ void floating_label::draw(int time, surface screen)
 		return;
 	}
 
+	SDL_Point pos = get_loc(time);
+	buf_pos_ = sdl::create_rect(pos.x, pos.y, surf_->w, surf_->h);
+
+	// Map labels scroll with the map and can sit far outside the visible
+	// area; skip the backup copy and the blits entirely when nothing of
+	// the label would show. Dropping buf_ also makes undraw() a no-op.
+	if(!SDL_HasIntersection(&buf_pos_, &clip_rect_)) {
+		buf_ = nullptr;
+		return;
+	}
+
 	if(buf_ == nullptr) {
 		buf_ = surface(surf_->w, surf_->h);
 		if(buf_ == nullptr) {
@@ -187,13 +202,22 @@ void floating_label::draw(int time, surface screen)
 		}
 	}
 
-	SDL_Point pos = get_loc(time);
-	buf_pos_ = sdl::create_rect(pos.x, pos.y, surf_->w, surf_->h);
 	const clip_rect_setter clip_setter(screen, &clip_rect_);
 	//important: make a copy of buf_pos_ because sdl_blit modifies dst_rect.
 	SDL_Rect rect = buf_pos_;
 	sdl_copy_portion(screen, &rect, buf_, nullptr);
-	sdl_blit(get_surface(time), nullptr, screen, &rect);
+
+	// Fade the label with a surface-wide alpha modulation on the blit
+	// rather than cloning the surface to rewrite the per-pixel alpha,
+	// which allocated a full copy per label every frame.
+	const uint8_t alpha = get_alpha(time);
+	if(alpha != SDL_ALPHA_OPAQUE) {
+		adjust_surface_alpha(surf_, alpha);
+	}
+	sdl_blit(surf_, nullptr, screen, &rect);
+	if(alpha != SDL_ALPHA_OPAQUE) {
+		adjust_surface_alpha(surf_, SDL_ALPHA_OPAQUE);
+	}
 }
 
 void floating_label::set_lifetime(int lifetime, int fadeout)
@@ -213,17 +237,16 @@ SDL_Point floating_label::get_loc(int time)
  	};
 }
 
-surface floating_label::get_surface(int time)
+uint8_t floating_label::get_alpha(int time) const
 {
 	if(lifetime_ >= 0 && fadeout_ > 0) {
 		int time_alive = get_time_alive(time);
-		if(time_alive >= lifetime_ && surf_ != nullptr) {
+		if(time_alive >= lifetime_) {
 			// fade out moving floating labels
-			int alpha_add = -255 * (time_alive - lifetime_) / fadeout_;
-			return adjust_surface_alpha_add(surf_, alpha_add);
+			return std::max(0, 255 - 255 * (time_alive - lifetime_) / fadeout_);
 		}
 	}
-	return surf_;
+	return SDL_ALPHA_OPAQUE;
 }
 
 void floating_label::undraw(surface screen)
@@ -244,6 +267,7 @@ int add_floating_label(const floating_label& flabel)
 	}
 
 	++label_id;
+	++label_revision;
 	labels.emplace(label_id, flabel);
 	label_contexts.top().insert(label_id);
 	return label_id;
@@ -254,6 +278,7 @@ void move_floating_label(int handle, double xmove, double ymove)
 	const label_map::iterator i = labels.find(handle);
 	if(i != labels.end()) {
 		i->second.move(xmove, ymove);
+		++label_revision;
 	}
 }
 
@@ -262,6 +287,7 @@ void scroll_floating_labels(double xmove, double ymove)
 	for(label_map::iterator i = labels.begin(); i != labels.end(); ++i) {
 		if(i->second.scroll() == ANCHOR_LABEL_MAP) {
 			i->second.move(xmove, ymove);
+			++label_revision;
 		}
 	}
 }
@@ -270,6 +296,7 @@ void remove_floating_label(int handle, int fadeout)
 {
 	const label_map::iterator i = labels.find(handle);
 	if(i != labels.end()) {
+		++label_revision;
 		if(fadeout > 0) {
 			i->second.set_lifetime(0, fadeout);
 			return;
@@ -287,6 +314,7 @@ void show_floating_label(int handle, bool value)
 	const label_map::iterator i = labels.find(handle);
 	if(i != labels.end()) {
 		i->second.show(value);
+		++label_revision;
 	}
 }
 
@@ -302,10 +330,20 @@ SDL_Rect get_floating_label_rect(int handle)
 	return sdl::empty_rect;
 }
 
+surface get_floating_label_surface(int handle)
+{
+	const label_map::iterator i = labels.find(handle);
+	if(i != labels.end()) {
+		return i->second.create_surface();
+	}
+	return nullptr;
+}
+
 floating_label_context::floating_label_context()
 {
 	//TODO: 'pause' floating labels in other contexrs
 	label_contexts.emplace();
+	++label_revision;
 }
 
 floating_label_context::~floating_label_context()
@@ -320,12 +358,37 @@ floating_label_context::~floating_label_context()
 	}
 
 	label_contexts.pop();
+	++label_revision;
 }
 
-void draw_floating_labels(surface screen)
+int get_floating_labels_revision()
+{
+	return label_revision;
+}
+
+bool floating_labels_animating()
 {
 	if(label_contexts.empty()) {
-		return;
+		return false;
+	}
+
+	const std::set<int>& context = label_contexts.top();
+
+	for(const label_map::value_type& label : labels) {
+		if(context.count(label.first) > 0 && label.second.animated()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+SDL_Rect draw_floating_labels(surface screen)
+{
+	SDL_Rect drawn = sdl::empty_rect;
+
+	if(label_contexts.empty()) {
+		return drawn;
 	}
 	int time = SDL_GetTicks();
 
@@ -336,14 +399,19 @@ void draw_floating_labels(surface screen)
 	for(label_map::iterator i = labels.begin(); i != labels.end(); ++i) {
 		if(context.count(i->first) > 0) {
 			i->second.draw(time, screen);
+			drawn = sdl::union_rects(drawn, i->second.screen_location());
 		}
 	}
+
+	return drawn;
 }
 
-void undraw_floating_labels(surface screen)
+SDL_Rect undraw_floating_labels(surface screen)
 {
+	SDL_Rect restored = sdl::empty_rect;
+
 	if(label_contexts.empty()) {
-		return;
+		return restored;
 	}
 	int time = SDL_GetTicks();
 
@@ -354,6 +422,7 @@ void undraw_floating_labels(surface screen)
 	for(label_map::reverse_iterator i = labels.rbegin(); i != labels.rend(); ++i) {
 		if(context.count(i->first) > 0) {
 			i->second.undraw(screen);
+			restored = sdl::union_rects(restored, i->second.screen_location());
 		}
 	}
 
@@ -362,9 +431,12 @@ void undraw_floating_labels(surface screen)
 		if(context.count(j->first) > 0 && j->second.expired(time)) {
 			context.erase(j->first);
 			labels.erase(j++);
+			++label_revision;
 		} else {
 			++j;
 		}
 	}
+
+	return restored;
 }
 }
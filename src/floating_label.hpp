@@ -72,10 +72,19 @@ public:
 	void draw(int time, surface screen);
 	void undraw(surface screen);
 
+	/** The screen area the label last drew to or restored, see draw() and undraw(). */
+	SDL_Rect screen_location() const
+	{
+		return buf_ != nullptr ? buf_pos_ : SDL_Rect{0, 0, 0, 0};
+	}
+
 	surface create_surface();
 
 	bool expired(int time) const { return lifetime_ >= 0 && get_time_alive(time) > lifetime_ + fadeout_; }
 
+	/** whether the label changes its appearance over time (moves, fades or expires) */
+	bool animated() const { return visible_ && (xmove_ != 0.0 || ymove_ != 0.0 || lifetime_ >= 0); }
+
 	void show(const bool value) { visible_ = value; }
 
 	LABEL_SCROLL_MODE scroll() const { return scroll_; }
@@ -85,7 +94,7 @@ private:
 	int get_time_alive(int current_time) const { return current_time - time_start_; }
 	int xpos(std::size_t width) const;
 	SDL_Point get_loc(int time);
-	surface get_surface(int time);
+	uint8_t get_alpha(int time) const;
 	surface surf_, buf_;
 	SDL_Rect buf_pos_;
 	int fadeout_;
@@ -127,7 +136,24 @@ void remove_floating_label(int handle, int fadeout = 0);
 void show_floating_label(int handle, bool show);
 
 SDL_Rect get_floating_label_rect(int handle);
-void draw_floating_labels(surface screen);
-void undraw_floating_labels(surface screen);
+
+/** Returns the label's rendered surface, rendering it first if needed. */
+surface get_floating_label_surface(int handle);
+
+/** Draws the visible labels; returns the union of the screen areas drawn to. */
+SDL_Rect draw_floating_labels(surface screen);
+
+/** Restores the screen behind the labels; returns the union of the restored areas. */
+SDL_Rect undraw_floating_labels(surface screen);
+
+/**
+ * returns a counter that increases whenever the set of floating labels is
+ * altered (labels added, removed, moved, hidden or shown), so that a renderer
+ * can detect whether the labels it last drew are still up to date
+ */
+int get_floating_labels_revision();
+
+/** returns true when any label in the current context animates on its own (moves or fades) */
+bool floating_labels_animating();
 
 } // end namespace font
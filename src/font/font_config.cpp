@@ -24,6 +24,7 @@
 #include "filesystem.hpp"
 #include "game_config.hpp"
 
+#include "serialization/binary_or_text.hpp"
 #include "serialization/parser.hpp"
 #include "serialization/preprocessor.hpp"
 #include "serialization/string_utils.hpp"
@@ -31,6 +32,7 @@
 #include "preferences/general.hpp"
 
 #include <list>
+#include <map>
 #include <set>
 #include <stack>
 #include <sstream>
@@ -82,6 +84,79 @@ bool is_valid_font_file(const std::string& file)
 
 	return false;
 }
+
+/** Font files found per binary path, shared by the manager's constructor and destructor. */
+std::map<std::string, std::vector<std::string>> win32_font_files;
+
+/**
+ * Returns the font files under the given binary path.
+ *
+ * The enumeration is persisted in the user cache dir and validated by the
+ * directory's timestamp, so on most launches registering the game fonts
+ * doesn't walk the font directories at all.
+ */
+const std::vector<std::string>& font_files_in_dir(const std::string& path)
+{
+	const auto cached = win32_font_files.find(path);
+	if(cached != win32_font_files.end()) {
+		return cached->second;
+	}
+
+	std::vector<std::string>& files = win32_font_files[path];
+
+	const std::string cache_path = filesystem::get_cache_dir() + "/font-files.cfg";
+	const std::time_t dir_modified = filesystem::file_modified_time(path);
+
+	config cache;
+	if(filesystem::file_exists(cache_path)) {
+		try {
+			filesystem::scoped_istream in = filesystem::istream_file(cache_path);
+			read(cache, *in);
+		} catch(const std::exception&) {
+			cache.clear();
+		}
+	}
+
+	if(const config& dir = cache.find_child("dir", "path", path)) {
+		if(dir["modified"].to_time_t(0) == dir_modified) {
+			for(const config& file : dir.child_range("file")) {
+				files.push_back(file["path"].str());
+			}
+
+			return files;
+		}
+	}
+
+	std::vector<std::string> all_files;
+	if(filesystem::is_directory(path)) {
+		filesystem::get_files_in_dir(path, &all_files, nullptr, filesystem::name_mode::ENTIRE_FILE_PATH);
+	}
+
+	for(const std::string& file : all_files) {
+		if(is_valid_font_file(file)) {
+			files.push_back(file);
+		}
+	}
+
+	cache.remove_children("dir", [&path](const config& dir) { return dir["path"] == path; });
+
+	config& entry = cache.add_child("dir");
+	entry["path"] = path;
+	entry["modified"] = dir_modified;
+	for(const std::string& file : files) {
+		entry.add_child("file")["path"] = file;
+	}
+
+	try {
+		filesystem::scoped_ostream out = filesystem::ostream_file(cache_path);
+		config_writer writer(*out, false);
+		writer.write(cache);
+	} catch(const std::exception& e) {
+		WRN_FT << "could not write the font discovery cache: " << e.what() << std::endl;
+	}
+
+	return files;
+}
 #endif
 
 // Current font family for sanserif and monospace fonts in the game
@@ -91,6 +166,74 @@ t_string family_order_mono;
 t_string family_order_light;
 t_string family_order_script;
 
+// Bump when the cache layout changes.
+const int font_cache_version = 1;
+
+std::string font_cache_path()
+{
+	return filesystem::get_cache_dir() + "/fonts.cfg";
+}
+
+/**
+ * Tries to read the resolved fonts config persisted by a previous launch.
+ *
+ * The cache is validated against the source file's path and timestamp, so
+ * it only short-circuits the preprocessor run when hardwired/fonts.cfg is
+ * unchanged (i.e. on virtually every launch).
+ */
+bool load_fonts_config_cache(config& cfg, const std::string& cfg_path)
+{
+	const std::string cache_path = font_cache_path();
+	if(!filesystem::file_exists(cache_path)) {
+		return false;
+	}
+
+	config cache;
+	try {
+		filesystem::scoped_istream in = filesystem::istream_file(cache_path);
+		read(cache, *in);
+	} catch(const std::exception&) {
+		return false;
+	}
+
+	if(cache["version"].to_int() != font_cache_version
+		|| cache["path"] != cfg_path
+		|| cache["modified"].to_time_t(0) != filesystem::file_modified_time(cfg_path))
+	{
+		return false;
+	}
+
+	if(config& fonts = cache.child("fonts")) {
+		cfg.clear();
+		cfg.add_child("fonts", std::move(fonts));
+		return true;
+	}
+
+	return false;
+}
+
+void save_fonts_config_cache(const config& cfg, const std::string& cfg_path)
+{
+	const config& fonts = cfg.child("fonts");
+	if(!fonts) {
+		return;
+	}
+
+	config cache;
+	cache["version"] = font_cache_version;
+	cache["path"] = cfg_path;
+	cache["modified"] = filesystem::file_modified_time(cfg_path);
+	cache.add_child("fonts", fonts);
+
+	try {
+		filesystem::scoped_ostream out = filesystem::ostream_file(font_cache_path());
+		config_writer writer(*out, false);
+		writer.write(cache);
+	} catch(const std::exception& e) {
+		WRN_FT << "could not write the font discovery cache: " << e.what() << std::endl;
+	}
+}
+
 } // end anon namespace
 
 /***
@@ -99,20 +242,24 @@ t_string family_order_script;
 
 bool load_font_config()
 {
+	const std::string& cfg_path = filesystem::get_wml_location("hardwired/fonts.cfg");
+	if(cfg_path.empty()) {
+		ERR_FT << "could not resolve path to fonts.cfg, file not found\n";
+		return false;
+	}
+
 	config cfg;
-	try {
-		const std::string& cfg_path = filesystem::get_wml_location("hardwired/fonts.cfg");
-		if(cfg_path.empty()) {
-			ERR_FT << "could not resolve path to fonts.cfg, file not found\n";
+	if(!load_fonts_config_cache(cfg, cfg_path)) {
+		try {
+			filesystem::scoped_istream stream = preprocess_file(cfg_path);
+			read(cfg, *stream);
+		} catch(const config::error &e) {
+			ERR_FT << "could not read fonts.cfg:\n"
+			       << e.message << '\n';
 			return false;
 		}
 
-		filesystem::scoped_istream stream = preprocess_file(cfg_path);
-		read(cfg, *stream);
-	} catch(const config::error &e) {
-		ERR_FT << "could not read fonts.cfg:\n"
-		       << e.message << '\n';
-		return false;
+		save_fonts_config_cache(cfg, cfg_path);
 	}
 
 	const config &fonts_config = cfg.child("fonts");
@@ -187,16 +334,9 @@ manager::manager()
 
 #ifdef CAIRO_HAS_WIN32_FONT
 	for(const std::string& path : filesystem::get_binary_paths("fonts")) {
-		std::vector<std::string> files;
-		if(filesystem::is_directory(path)) {
-			filesystem::get_files_in_dir(path, &files, nullptr, filesystem::name_mode::ENTIRE_FILE_PATH);
-		}
-		for(const std::string& file : files) {
-			if(is_valid_font_file(file))
-			{
-				const std::wstring wfile = unicode_cast<std::wstring>(file);
-				AddFontResourceExW(wfile.c_str(), FR_PRIVATE, nullptr);
-			}
+		for(const std::string& file : font_files_in_dir(path)) {
+			const std::wstring wfile = unicode_cast<std::wstring>(file);
+			AddFontResourceExW(wfile.c_str(), FR_PRIVATE, nullptr);
 		}
 	}
 #endif
@@ -210,15 +350,9 @@ manager::~manager()
 
 #ifdef CAIRO_HAS_WIN32_FONT
 	for(const std::string& path : filesystem::get_binary_paths("fonts")) {
-		std::vector<std::string> files;
-		if(filesystem::is_directory(path))
-			filesystem::get_files_in_dir(path, &files, nullptr, filesystem::name_mode::ENTIRE_FILE_PATH);
-		for(const std::string& file : files) {
-			if(is_valid_font_file(file))
-			{
-				const std::wstring wfile = unicode_cast<std::wstring>(file);
-				RemoveFontResourceExW(wfile.c_str(), FR_PRIVATE, nullptr);
-			}
+		for(const std::string& file : font_files_in_dir(path)) {
+			const std::wstring wfile = unicode_cast<std::wstring>(file);
+			RemoveFontResourceExW(wfile.c_str(), FR_PRIVATE, nullptr);
 		}
 	}
 #endif
@@ -37,7 +37,9 @@
 
 #include <cassert>
 #include <cstring>
+#include <list>
 #include <stdexcept>
+#include <unordered_map>
 
 void PangoLayout::set_text(std::string s)
 {
@@ -216,6 +218,58 @@ static std::string_view trim_endl(std::string_view s)
 
 namespace font {
 
+namespace {
+
+/*
+ * LRU cache of recently rendered text surfaces.
+ *
+ * The game keeps pushing the same handful of strings (sidebar numbers, damage
+ * labels, button captions) through the single renderer returned by
+ * get_text_renderer(), which makes the renderer's own surface_ useless as a
+ * cache: two alternating strings dirty it on every set_text(). Keeping the
+ * finished surfaces here keyed by text and style turns those repeats into a
+ * hash lookup instead of a TTF rasterization pass per word.
+ *
+ * Callers treat rendered surfaces as read-only (they blit them, or clone()
+ * first when they don't), so handing the same surface out repeatedly is safe.
+ */
+constexpr std::size_t render_cache_max_size = 256;
+
+struct render_cache_entry
+{
+	std::string key;
+	surface surf;
+};
+
+/** Most recently used entries are kept at the front. */
+std::list<render_cache_entry> render_cache;
+std::unordered_map<std::string, std::list<render_cache_entry>::iterator> render_cache_index;
+
+surface* find_cached_render(const std::string& key)
+{
+	const auto it = render_cache_index.find(key);
+	if(it == render_cache_index.end()) {
+		return nullptr;
+	}
+
+	// Move the entry to the front so it's the last to be evicted.
+	render_cache.splice(render_cache.begin(), render_cache, it->second);
+	return &render_cache.front().surf;
+}
+
+void cache_render(const std::string& key, const surface& surf)
+{
+	render_cache.push_front(render_cache_entry{key, surf});
+	render_cache_index[key] = render_cache.begin();
+
+	if(render_cache.size() > render_cache_max_size) {
+		render_cache_index.erase(render_cache.back().key);
+		render_cache.pop_back();
+	}
+}
+
+} // namespace
+
 pango_text::pango_text()
 	: layout_()
 	, rect_()
@@ -674,6 +728,28 @@ void pango_text::render(PangoLayout& layout, const SDL_Rect& viewport, const uns
 	}
 }
 
+std::string pango_text::render_cache_key(const SDL_Rect& viewport) const
+{
+	std::ostringstream key;
+	key << viewport.x << ',' << viewport.y << ',' << viewport.w << ',' << viewport.h
+		<< '|' << static_cast<int>(font_class_)
+		<< '|' << font_size_
+		<< '|' << font_style_
+		<< '|' << foreground_color_.to_rgba_bytes()
+		<< '|' << maximum_width_
+		<< '|' << characters_per_line_
+		<< '|' << maximum_height_
+		<< '|' << ellipse_mode_
+		<< '|' << alignment_
+		<< '|' << add_outline_
+		<< '|' << markedup_text_
+		<< '|' << link_aware_
+		<< '|' << link_color_.to_rgba_bytes()
+		<< '|' << text_;
+
+	return key.str();
+}
+
 void pango_text::rerender(const SDL_Rect& viewport)
 {
 	if(surface_dirty_ || !SDL_RectEquals(&rendered_viewport_, &viewport)) {
@@ -681,6 +757,12 @@ void pango_text::rerender(const SDL_Rect& viewport)
 		surface_dirty_ = false;
 		rendered_viewport_ = viewport;
 
+		const std::string key = render_cache_key(viewport);
+		if(surface* cached = find_cached_render(key)) {
+			surface_ = *cached;
+			return;
+		}
+
 		const int stride = viewport.w * 4;
 		if(stride <= 0 || viewport.h <= 0) {
 			surface_ = surface(0, 0);
@@ -702,6 +784,8 @@ void pango_text::rerender(const SDL_Rect& viewport)
 		// then leave it to the caller to handle; one reason it may throw is that
 		// cairo surfaces are limited to approximately 2**15 pixels in height.
 		render(layout_, viewport, stride);
+
+		cache_render(key, surface_);
 	}
 }
 
@@ -428,6 +428,14 @@ private:
 	/** The area that's cached in surface_, which is the area that was rendered when surface_dirty_ was last set to false. */
 	SDL_Rect rendered_viewport_;
 
+	/**
+	 * Builds the key the rendered surface is cached under.
+	 *
+	 * The key covers the text plus every style setting that influences the
+	 * rendered pixels, so equal keys are guaranteed to produce equal surfaces.
+	 */
+	std::string render_cache_key(const SDL_Rect& viewport) const;
+
 	/**
 	 * Renders the text.
 	 *
@@ -248,13 +248,37 @@ formula::formula(const tk::token* i1, const tk::token* i2, function_symbol_table
 	}
 }
 
+namespace {
+// Parsed formulas are shared between repeated identical strings; macro-heavy
+// eras create the same formula text for every unit. Only formulas that build
+// their own symbol table are cached: parsing against a caller's table may
+// register functions there, and that table's lifetime is not ours to track.
+constexpr std::size_t formula_cache_max_size = 1024;
+std::map<std::string, formula_ptr> formula_cache;
+}
+
 formula_ptr formula::create_optional_formula(const std::string& str, function_symbol_table* symbols)
 {
 	if(str.empty()) {
 		return formula_ptr();
 	}
 
-	return formula_ptr(new formula(str, symbols));
+	if(symbols) {
+		return formula_ptr(new formula(str, symbols));
+	}
+
+	const std::map<std::string, formula_ptr>::const_iterator cached = formula_cache.find(str);
+	if(cached != formula_cache.end()) {
+		return cached->second;
+	}
+
+	if(formula_cache.size() >= formula_cache_max_size) {
+		formula_cache.clear();
+	}
+
+	formula_ptr res(new formula(str));
+	formula_cache[str] = res;
+	return res;
 }
 
 variant formula::execute(const formula_callable& variables, formula_debugger*fdb) const
@@ -326,6 +350,17 @@ public:
 		: items_(items)
 	{}
 
+	bool is_constant() const
+	{
+		for(const auto& i : items_) {
+			if(!i->is_constant()) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 private:
 	variant execute(const formula_callable& variables, formula_debugger*fdb) const
 	{
@@ -384,6 +419,17 @@ public:
 		return s.str();
 	}
 
+	bool is_constant() const
+	{
+		for(const auto& i : items_) {
+			if(!i->is_constant()) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 private:
 	variant execute(const formula_callable& variables, formula_debugger*fdb) const
 	{
@@ -423,6 +469,11 @@ public:
 		return s.str();
 	}
 
+	bool is_constant() const
+	{
+		return operand_->is_constant();
+	}
+
 private:
 	variant execute(const formula_callable& variables, formula_debugger*fdb) const
 	{
@@ -677,6 +728,11 @@ public:
 		return s.str();
 	}
 
+	bool is_constant() const
+	{
+		return left_->is_constant() && key_->is_constant();
+	}
+
 private:
 	variant execute(const formula_callable& variables, formula_debugger*fdb) const
 	{
@@ -730,6 +786,12 @@ public:
 		return s.str();
 	}
 
+	bool is_constant() const
+	{
+		// Dice rolls are random even with constant operands.
+		return op_ != DICE && left_->is_constant() && right_->is_constant();
+	}
+
 private:
 	variant execute(const formula_callable& variables, formula_debugger*fdb) const
 	{
@@ -911,6 +973,11 @@ public:
 		return s.str();
 	}
 
+	bool is_constant() const
+	{
+		return true;
+	}
+
 private:
 	variant execute(const formula_callable& /*variables*/, formula_debugger* /*fdb*/) const
 	{
@@ -935,6 +1002,11 @@ public:
 		return s.str();
 	}
 
+	bool is_constant() const
+	{
+		return true;
+	}
+
 private:
 	variant execute(const formula_callable& /*variables*/, formula_debugger* /*fdb*/) const
 	{
@@ -1036,6 +1108,11 @@ public:
 		return "'" + res + "'";
 	}
 
+	bool is_constant() const
+	{
+		return subs_.empty();
+	}
+
 private:
 	variant execute(const formula_callable& variables, formula_debugger*fdb) const
 	{
@@ -1067,6 +1144,57 @@ private:
 	std::vector<substitution> subs_;
 };
 
+/**
+ * Holds the value of a subexpression that was folded at parse time.
+ *
+ * The original expression is kept around so error reports and the formula
+ * debugger still show the source text instead of the folded value.
+ */
+class const_expression : public formula_expression
+{
+public:
+	const_expression(expression_ptr org, const variant& value)
+		: org_(org)
+		, value_(value)
+	{}
+
+	std::string str() const
+	{
+		return org_->str();
+	}
+
+	bool is_constant() const
+	{
+		return true;
+	}
+
+private:
+	variant execute(const formula_callable& /*variables*/, formula_debugger* /*fdb*/) const
+	{
+		return value_;
+	}
+
+	expression_ptr org_;
+	variant value_;
+};
+
+// Evaluates a constant subexpression once, at parse time. Expressions whose
+// evaluation throws (e.g. a constant division by zero) are returned unchanged
+// so they keep their runtime error behavior.
+static expression_ptr fold_constants(expression_ptr expr)
+{
+	if(!expr->is_constant()) {
+		return expr;
+	}
+
+	try {
+		static map_formula_callable null_callable;
+		return std::make_shared<const_expression>(expr, expr->evaluate(null_callable));
+	} catch(const type_error&) {
+		return expr;
+	}
+}
+
 
 /**
  * Functions to handle the actual parsing of WFL.
@@ -1360,18 +1488,18 @@ expression_ptr parse_expression(const tk::token* i1, const tk::token* i2, functi
 
 					if( is_map ) {
 						parse_set_args(i1+1, i2-1, &args, symbols);
-						return std::make_shared<map_expression>(args);
+						return fold_constants(std::make_shared<map_expression>(args));
 					} else {
 						parse_args(i1+1,i2-1,&args,symbols);
-						return std::make_shared<list_expression>(args);
+						return fold_constants(std::make_shared<list_expression>(args));
 					}
 				} else {
 					// Execute operator [ ]
 					try{
-						return std::make_shared<square_bracket_expression>(
+						return fold_constants(std::make_shared<square_bracket_expression>(
 							parse_expression(i1,      tok,    symbols),
 							parse_expression(tok + 1, i2 - 1, symbols)
-						);
+						));
 					} catch (const formula_error& e){
 						throw formula_error( e.type, tokens_to_string(i1, i2-1), *i1->filename, i1->line_number );
 					}
@@ -1451,8 +1579,8 @@ expression_ptr parse_expression(const tk::token* i1, const tk::token* i2, functi
 
 	if(op == i1) {
 		try{
-			return expression_ptr(
-				new unary_operator_expression(std::string(op->begin, op->end), parse_expression(op + 1, i2 ,symbols)));
+			return fold_constants(expression_ptr(
+				new unary_operator_expression(std::string(op->begin, op->end), parse_expression(op + 1, i2 ,symbols))));
 		} catch(const formula_error& e)	{
 			throw formula_error( e.type, tokens_to_string(begin,end - 1), *op->filename, op->line_number);
 		}
@@ -1476,12 +1604,12 @@ expression_ptr parse_expression(const tk::token* i1, const tk::token* i2, functi
 		return std::make_shared<where_expression>(parse_expression(i1, op, symbols), table);
 	}
 
-	return expression_ptr(
+	return fold_constants(expression_ptr(
 		new operator_expression(op_name,
 			parse_expression(i1,     op, symbols),
 			parse_expression(op + 1, i2, symbols)
 		)
-	);
+	));
 }
 
 } // namespace wfl
@@ -348,7 +348,7 @@ DEFINE_WFL_FUNCTION(tolist, 1, 1)
 		tmp.push_back(*it);
 	}
 
-	return variant(tmp);
+	return variant(std::move(tmp));
 }
 
 DEFINE_WFL_FUNCTION(tomap, 1, 2)
@@ -382,7 +382,7 @@ DEFINE_WFL_FUNCTION(tomap, 1, 2)
 		}
 	}
 
-	return variant(tmp);
+	return variant(std::move(tmp));
 }
 
 DEFINE_WFL_FUNCTION(substring, 2, 3)
@@ -774,7 +774,7 @@ DEFINE_WFL_FUNCTION(sort, 1, 2)
 		std::sort(vars.begin(), vars.end(), variant_comparator(args()[1], variables));
 	}
 
-	return variant(vars);
+	return variant(std::move(vars));
 }
 
 DEFINE_WFL_FUNCTION(reverse, 1, 1)
@@ -790,7 +790,7 @@ DEFINE_WFL_FUNCTION(reverse, 1, 1)
 		std::vector<variant> list = args()[0]->evaluate(variables, fdb).as_list();
 		std::reverse(list.begin(), list.end());
 
-		return variant(list);
+		return variant(std::move(list));
 	}
 
 	return variant();
@@ -820,6 +820,10 @@ DEFINE_WFL_FUNCTION(filter, 2, 3)
 
 	const variant items = args()[0]->evaluate(variables, fdb);
 
+	if(items.is_list()) {
+		list_vars.reserve(items.num_elements());
+	}
+
 	if(args().size() == 2) {
 		for(variant_iterator it = items.begin(); it != items.end(); ++it) {
 			const variant val = args()[1]->evaluate(formula_variant_callable_with_backup(*it, variables), fdb);
@@ -853,10 +857,10 @@ DEFINE_WFL_FUNCTION(filter, 2, 3)
 	}
 
 	if(items.is_map()) {
-		return variant(map_vars);
+		return variant(std::move(map_vars));
 	}
 
-	return variant(list_vars);
+	return variant(std::move(list_vars));
 }
 
 DEFINE_WFL_FUNCTION(find, 2, 3)
@@ -895,6 +899,10 @@ DEFINE_WFL_FUNCTION(map, 2, 3)
 	std::map<variant, variant> map_vars;
 	const variant items = args()[0]->evaluate(variables, fdb);
 
+	if(items.is_list()) {
+		list_vars.reserve(items.num_elements());
+	}
+
 	if(args().size() == 2) {
 		for(variant_iterator it = items.begin(); it != items.end(); ++it) {
 			const variant val = args().back()->evaluate(formula_variant_callable_with_backup(*it, variables), fdb);
@@ -923,10 +931,10 @@ DEFINE_WFL_FUNCTION(map, 2, 3)
 	}
 
 	if(items.is_map()) {
-		return variant(map_vars);
+		return variant(std::move(map_vars));
 	}
 
-	return variant(list_vars);
+	return variant(std::move(list_vars));
 }
 
 DEFINE_WFL_FUNCTION(take_while, 2, 2)
@@ -1010,10 +1018,10 @@ DEFINE_WFL_FUNCTION(zip, 1, -1)
 	for(std::size_t i = 0; i < max_i; i++) {
 		std::vector<variant> elem(input.size());
 		std::transform(input.begin(), input.end(), elem.begin(), indexer(i));
-		output.emplace_back(elem);
+		output.emplace_back(std::move(elem));
 	}
 
-	return variant(output);
+	return variant(std::move(output));
 }
 
 DEFINE_WFL_FUNCTION(reduce, 2, 3)
@@ -1096,8 +1104,9 @@ DEFINE_WFL_FUNCTION(head, 1, 2)
 	std::advance(end, count);
 
 	std::vector<variant> res;
+	res.reserve(count);
 	std::copy(it, end, std::back_inserter(res));
-	return variant(res);
+	return variant(std::move(res));
 }
 
 DEFINE_WFL_FUNCTION(tail, 1, 2)
@@ -1117,9 +1126,10 @@ DEFINE_WFL_FUNCTION(tail, 1, 2)
 
 	std::advance(it, -count);
 	std::vector<variant> res;
+	res.reserve(count);
 
 	std::copy(it, items.end(), std::back_inserter(res));
-	return variant(res);
+	return variant(std::move(res));
 }
 
 DEFINE_WFL_FUNCTION(size, 1, 1)
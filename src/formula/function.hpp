@@ -90,6 +90,16 @@ public:
 
 	virtual std::string str() const = 0;
 
+	/**
+	 * Whether this expression yields the same value no matter which
+	 * callable it is evaluated against. Constant subexpressions are
+	 * evaluated once at parse time.
+	 */
+	virtual bool is_constant() const
+	{
+		return false;
+	}
+
 private:
 	virtual variant execute(const formula_callable& variables, formula_debugger* fdb = nullptr) const = 0;
 
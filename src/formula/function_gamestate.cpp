@@ -58,17 +58,15 @@ DEFINE_WFL_FUNCTION(locations_in_radius, 2, 2)
 		return variant(std::make_shared<location_callable>(loc));
 	}
 
-	std::vector<map_location> res;
-
-	get_tiles_in_radius(loc, range, res);
+	const tile_offset_view disk = tiles_in_radius(loc, range);
 
 	std::vector<variant> v;
-	v.reserve(res.size() + 1);
+	v.reserve(disk.size() + 1);
 	v.emplace_back(std::make_shared<location_callable>(loc));
 
-	for(std::size_t n = 0; n != res.size(); ++n) {
-		if(resources::gameboard->map().on_board(res[n])) {
-			v.emplace_back(std::make_shared<location_callable>(res[n]));
+	for(const map_location& l : disk) {
+		if(resources::gameboard->map().on_board(l)) {
+			v.emplace_back(std::make_shared<location_callable>(l));
 		}
 	}
 
@@ -40,6 +40,29 @@ namespace wfl
 // Static value to initialize null variants to ensure its value is never nullptr.
 static value_base_ptr null_value(new variant_value_base);
 
+// Small integers dominate formula evaluation, so their value objects are
+// created once and shared, like null_value above. variant_int carries no
+// mutable state, which makes the sharing safe.
+static value_base_ptr get_int_value(int n)
+{
+	constexpr int small_int_min = -256;
+	constexpr int small_int_max = 256;
+
+	if(n < small_int_min || n > small_int_max) {
+		return std::make_shared<variant_int>(n);
+	}
+
+	static std::vector<value_base_ptr> pool;
+	if(pool.empty()) {
+		pool.reserve(small_int_max - small_int_min + 1);
+		for(int i = small_int_min; i <= small_int_max; ++i) {
+			pool.push_back(std::make_shared<variant_int>(i));
+		}
+	}
+
+	return pool[n - small_int_min];
+}
+
 static std::string variant_type_to_string(VARIANT_TYPE type)
 {
 	return VARIANT_TYPE::enum_to_string(type);
@@ -146,7 +169,7 @@ variant::variant()
 {}
 
 variant::variant(int n)
-	: value_(std::make_shared<variant_int>(n))
+	: value_(get_int_value(n))
 {
 	assert(value_.get());
 }
@@ -169,6 +192,12 @@ variant::variant(const std::vector<variant>& vec)
 	assert(value_.get());
 }
 
+variant::variant(std::vector<variant>&& vec)
+    : value_((std::make_shared<variant_list>(std::move(vec))))
+{
+	assert(value_.get());
+}
+
 variant::variant(const std::string& str)
 	: value_(std::make_shared<variant_string>(str))
 {
@@ -181,6 +210,12 @@ variant::variant(const std::map<variant,variant>& map)
 	assert(value_.get());
 }
 
+variant::variant(std::map<variant,variant>&& map)
+	: value_((std::make_shared<variant_map>(std::move(map))))
+{
+	assert(value_.get());
+}
+
 variant variant::operator[](std::size_t n) const
 {
 	if(is_callable()) {
@@ -218,7 +253,7 @@ variant variant::operator[](const variant& v) const
 				slice.push_back((*this)[v[i]]);
 			}
 
-			return variant(slice);
+			return variant(std::move(slice));
 		} else if(v.as_int() < 0) {
 			return operator[](num_elements() + v.as_int());
 		}
@@ -238,7 +273,7 @@ variant variant::get_keys() const
 		tmp.push_back(i.first);
 	}
 
-	return variant(tmp);
+	return variant(std::move(tmp));
 }
 
 variant variant::get_values() const
@@ -250,7 +285,7 @@ variant variant::get_values() const
 		tmp.push_back(i.second);
 	}
 
-	return variant(tmp);
+	return variant(std::move(tmp));
 }
 
 variant_iterator variant::begin() const
@@ -354,7 +389,7 @@ variant variant::operator+(const variant& v) const
 			res.push_back(member);
 		}
 
-		return variant(res);
+		return variant(std::move(res));
 	}
 
 	if(is_map() && v.is_map()) {
@@ -364,7 +399,7 @@ variant variant::operator+(const variant& v) const
 			res[member.first] = member.second;
 		}
 
-		return variant(res);
+		return variant(std::move(res));
 	}
 
 	if(is_decimal() || v.is_decimal()) {
@@ -577,7 +612,7 @@ variant variant::concatenate(const variant& v) const
 			res.push_back(v[i]);
 		}
 
-		return variant(res);
+		return variant(std::move(res));
 	} else if(is_string()) {
 		v.must_be(VARIANT_TYPE::TYPE_STRING);
 		std::string res = as_string() + v.as_string();
@@ -698,7 +733,7 @@ variant variant::execute_variant(const variant& var)
 		vars.pop();
 	}
 
-	return variant(made_moves);
+	return variant(std::move(made_moves));
 }
 
 }
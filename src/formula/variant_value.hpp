@@ -438,6 +438,13 @@ public:
 			"variant_container only accepts vector or map specifications.");
 	}
 
+	explicit variant_container(T&& container)
+		: container_(std::move(container))
+	{
+		static_assert((std::is_same_v<variant_vector, T> || std::is_same_v<variant_map_raw, T>),
+			"variant_container only accepts vector or map specifications.");
+	}
+
 	virtual bool is_empty() const override
 	{
 		return container_.empty();
@@ -507,6 +514,10 @@ public:
 		: variant_container<variant_vector>(vec)
 	{}
 
+	explicit variant_list(variant_vector&& vec)
+		: variant_container<variant_vector>(std::move(vec))
+	{}
+
 	/**
 	 * Applies the provided function to the corresponding variants in this and another list.
 	 */
@@ -538,6 +549,10 @@ public:
 		: variant_container<variant_map_raw>(map)
 	{}
 
+	explicit variant_map(variant_map_raw&& map)
+		: variant_container<variant_map_raw>(std::move(map))
+	{}
+
 	virtual bool equals(variant_value_base& other) const override;
 	virtual bool less_than(variant_value_base& other) const override;
 
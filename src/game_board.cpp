@@ -19,6 +19,7 @@
 #include "map/map.hpp"
 #include "preferences/game.hpp"
 #include "recall_list_manager.hpp"
+#include "units/abilities.hpp"
 #include "units/unit.hpp"
 
 #include <set>
@@ -208,6 +209,24 @@ bool game_board::has_visible_unit(const map_location& loc, const team& current_t
 	return true;
 }
 
+unit_ptr game_board::find_unit_by_id(const std::string& id)
+{
+	unit_ptr u = units_.find_unit_ptr(id);
+	if(u) {
+		return u;
+	}
+
+	// Recall lists are small per-side vectors, so a linear pass is fine.
+	for(team& t : teams_) {
+		u = t.recall_list().find_if_matches_id(id);
+		if(u) {
+			return u;
+		}
+	}
+
+	return unit_ptr();
+}
+
 unit* game_board::get_visible_unit(const map_location& loc, const team& current_team, bool see_all)
 {
 	unit_map::iterator ui = find_visible_unit(loc, current_team, see_all);
@@ -373,6 +392,10 @@ bool game_board::change_terrain(const map_location &loc, const t_translation::te
 		preferences::encountered_terrains().insert(ut);
 	}
 
+	// Movement costs and terrain filters changed under the cached reachmaps
+	// and ability aggregates keyed on this generation.
+	unit_abilities::invalidate_cache();
+
 	return true;
 }
 
@@ -175,6 +175,12 @@ public:
 	// Wrapped functions from unit_map. These should ultimately provide notification to observers, pathfinding.
 
 	unit_map::iterator find_unit(const map_location & loc) { return units_.find(loc); }
+
+	/**
+	 * Finds the unit with the given string id, on the map first and then on
+	 * the sides' recall lists. Returns a null pointer if no such unit exists.
+	 */
+	unit_ptr find_unit_by_id(const std::string& id);
 	/** Calculates whether a team is defeated */
 	bool team_is_defeated(const team& t) const;
 };
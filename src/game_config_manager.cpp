@@ -51,10 +51,13 @@ static game_config_manager* singleton;
 
 game_config_manager::game_config_manager(const commandline_options& cmdline_opts)
 	: cmdline_opts_(cmdline_opts)
+	, arena_()
 	, game_config_()
 	, game_config_view_()
 	, addon_cfgs_()
 	, active_addons_()
+	, addon_checksums_()
+	, mainline_checksum_()
 	, old_defines_map_()
 	, paths_manager_()
 	, cache_(game_config::config_cache::instance())
@@ -143,6 +146,63 @@ bool map_includes(const preproc_map& general, const preproc_map& special)
 		return it != general.end() && it->second == pair.second;
 	});
 }
+
+/** Top-level tags an add-on contributes to the main config rather than to its own layer. */
+const std::set<std::string> addon_entry_tags {
+	"era",
+	"modification",
+	"resource",
+	"multiplayer",
+	"scenario",
+	"campaign"
+};
+
+/**
+ * Checksum of every data file that is not part of an installed add-on, i.e.
+ * the part of the data tree whose changes cannot be handled by swapping a
+ * single add-on layer.
+ */
+filesystem::file_tree_checksum non_addon_tree_checksum()
+{
+	filesystem::file_tree_checksum res;
+	filesystem::get_tree_checksum("data/", res);
+
+	const std::string user_data = filesystem::get_user_data_dir() + "/data";
+	std::vector<std::string> dirs;
+	filesystem::get_files_in_dir(user_data, nullptr, &dirs, filesystem::name_mode::ENTIRE_FILE_PATH,
+		filesystem::filter_mode::SKIP_MEDIA_DIR, filesystem::reorder_mode::DONT_REORDER, &res);
+
+	for(const std::string& dir : dirs) {
+		if(dir != filesystem::get_addons_dir()) {
+			filesystem::get_tree_checksum(dir, res);
+		}
+	}
+
+	return res;
+}
+
+/** Shows the errors collected while loading add-ons, if there are any. */
+void show_addon_load_errors(const std::vector<std::string>& error_addons, const std::vector<std::string>& error_log)
+{
+	if(error_addons.empty()) {
+		return;
+	}
+
+	const std::size_t n = error_addons.size();
+	const std::string& msg1 =
+		_n("The following add-on had errors and could not be loaded:",
+		   "The following add-ons had errors and could not be loaded:",
+		   n);
+	const std::string& msg2 =
+		_n("Please report this to the author or maintainer of this add-on.",
+		   "Please report this to the respective authors or maintainers of these add-ons.",
+		   n);
+
+	const std::string& report = utils::join(error_log, "\n\n");
+	events::call_in_main_thread([&]() {
+		gui2::dialogs::wml_error::display(msg1, msg2, error_addons, report);
+	});
+}
 } // end anonymous namespace
 
 void game_config_manager::load_game_config_with_loadscreen(
@@ -200,8 +260,20 @@ void game_config_manager::load_game_config(bool reload_everything, const game_cl
 		// Handle terrains so that they are last loaded from the core.
 		// Load every compatible addon.
 		if(reload_everything) {
+			// The old trees must be gone before their backing arena is;
+			// afterwards the whole load becomes bump allocation into the
+			// fresh arena instead of millions of small new/delete pairs.
+			game_config_.clear();
+			addon_cfgs_.clear();
+			addon_checksums_.clear();
+			arena_ = std::make_unique<config_arena>();
+			config_arena::scope arena_scope(*arena_);
+
 			gui2::dialogs::loading_screen::progress(loading_stage::verify_cache);
 			filesystem::data_tree_checksum();
+			// Record the non-add-on part separately, so reload_addon_layers()
+			// can tell add-on-only changes apart from mainline edits.
+			mainline_checksum_ = non_addon_tree_checksum();
 			gui2::dialogs::loading_screen::progress(loading_stage::create_cache);
 
 			// Start transaction so macros are shared.
@@ -335,18 +407,7 @@ void game_config_manager::load_game_config(bool reload_everything, const game_cl
 			set_enabled_addon_all();
 		}
 
-		// Extract the Lua scripts at toplevel.
-		game_lua_kernel::extract_preload_scripts(game_config());
-
-		set_unit_data();
-		terrain_builder::set_terrain_rules_cfg(game_config());
-		tdata_ = std::make_shared<terrain_type_data>(game_config());
-		::init_strings(game_config());
-		theme::set_known_themes(&game_config());
-
-		set_multiplayer_hashes();
-
-		game_config::add_color_info(game_config());
+		rebuild_derived_config_data();
 
 	} catch(const game::error& e) {
 		ERR_CONFIG << "Error loading game configuration files\n" << e.message << '\n';
@@ -427,211 +488,201 @@ void game_config_manager::load_addons_cfg()
 	// Load the addons.
 	for(const std::string& addon_id : user_dirs) {
 		log_scope2(log_config, "Loading add-on '" + addon_id + "'");
-		const std::string addon_dir = user_campaign_dir + "/" + addon_id;
-
-		const std::string main_cfg = addon_dir + "/_main.cfg";
-		const std::string info_cfg = addon_dir + "/_info.cfg";
+		load_addon_cfg(addon_id, error_log, error_addons);
+	}
 
-		if(!filesystem::file_exists(main_cfg)) {
-			continue;
+	if(cmdline_opts_.validate_addon) {
+		if(!addon_cfgs_.count(*cmdline_opts_.validate_addon)) {
+			ERR_CONFIG << "Didn’t find an add-on for --validate-addon - check whether the id has a typo" << std::endl;
+			const std::string log_msg = formatter()
+				<< "Didn't find an add-on for --validate-addon - check whether the id has a typo";
+			error_log.push_back(log_msg);
+			throw game::error("Did not find an add-on for --validate-addon");
 		}
 
-		// Try to find this addon's metadata. Author publishing info (_server.pbl) is given
-		// precedence over addon sever-generated info (_info.cfg). If neither are found, it
-		// probably means the addon was installed manually and certain defaults will be used.
-		config metadata;
-
-		if(have_addon_pbl_info(addon_id)) {
-			// Publishing info needs to be read from disk.
-			try {
-				metadata = get_addon_pbl_info(addon_id);
-			} catch(const invalid_pbl_exception& e) {
-				const std::string log_msg = formatter()
-				<< "The provided addon has an invalid pbl file"
-				<< " for addon "
-				<< addon_id;
-
-				error_addons.push_back(e.message);
-				error_log.push_back(log_msg);
-			}
-		} else if(filesystem::file_exists(info_cfg)) {
-			// Addon server-generated info can be fetched from cache.
-			config temp;
-			cache_.get_config(info_cfg, temp);
+		WRN_CONFIG << "Note: for --validate-addon to find errors, you have to play (in the GUI) a game that uses the add-on.";
+	}
 
-			metadata = temp.child_or_empty("info");
-		}
+	show_addon_load_errors(error_addons, error_log);
+}
 
-		std::string using_core = metadata["core"];
-		if(using_core.empty()) {
-			using_core = "default";
-		}
+void game_config_manager::load_addon_cfg(const std::string& addon_id,
+	std::vector<std::string>& error_log, std::vector<std::string>& error_addons)
+{
+	const std::string addon_dir = filesystem::get_addons_dir() + "/" + addon_id;
 
-		// Skip add-ons not matching our current core. Cores themselves should be selectable
-		// at all times, so they aren't considered here.
-		if(!metadata.empty() && metadata["type"] != "core" && using_core != preferences::core_id()) {
-			continue;
-		}
+	const std::string main_cfg = addon_dir + "/_main.cfg";
+	const std::string info_cfg = addon_dir + "/_info.cfg";
 
-		std::string addon_title = metadata["title"].str();
-		if(addon_title.empty()) {
-			addon_title = addon_id;
-		}
+	// Record what was on disk before parsing, so an edit made while we load
+	// still registers as a change on the next reload.
+	filesystem::file_tree_checksum checksum;
+	filesystem::get_tree_checksum(addon_dir, checksum);
+	addon_checksums_[addon_id] = checksum;
 
-		version_info addon_version(metadata["version"]);
+	if(!filesystem::file_exists(main_cfg)) {
+		return;
+	}
 
+	// Try to find this addon's metadata. Author publishing info (_server.pbl) is given
+	// precedence over addon sever-generated info (_info.cfg). If neither are found, it
+	// probably means the addon was installed manually and certain defaults will be used.
+	config metadata;
+
+	if(have_addon_pbl_info(addon_id)) {
+		// Publishing info needs to be read from disk.
 		try {
-			std::unique_ptr<schema_validation::schema_validator> validator;
-			if(cmdline_opts_.validate_addon && *cmdline_opts_.validate_addon == addon_id) {
-				validator.reset(new schema_validation::schema_validator(filesystem::get_wml_location("schema/game_config.cfg")));
-				validator->set_create_exceptions(false); // Don't crash if there's an error, just go ahead anyway
-			}
+			metadata = get_addon_pbl_info(addon_id);
+		} catch(const invalid_pbl_exception& e) {
+			const std::string log_msg = formatter()
+			<< "The provided addon has an invalid pbl file"
+			<< " for addon "
+			<< addon_id;
 
-			// Load this addon from the cache to a config.
-			config umc_cfg;
-			cache_.get_config(main_cfg, umc_cfg, validator.get());
-
-			static const std::set<std::string> tags_with_addon_id {
-				"era",
-				"modification",
-				"resource",
-				"multiplayer",
-				"scenario",
-				"campaign",
-				"test"
-			};
-
-			// Annotate appropriate addon types with addon_id info.
-			for(auto child : umc_cfg.all_children_range()) {
-				if(tags_with_addon_id.count(child.key) > 0) {
-					auto& cfg = child.cfg;
-					cfg["addon_id"] = addon_id;
-					cfg["addon_title"] = addon_title;
-					// Note that this may reformat the string in a canonical form.
-					cfg["addon_version"] = addon_version.str();
-				}
-			}
+			error_addons.push_back(e.message);
+			error_log.push_back(log_msg);
+		}
+	} else if(filesystem::file_exists(info_cfg)) {
+		// Addon server-generated info can be fetched from cache.
+		config temp;
+		cache_.get_config(info_cfg, temp);
 
-			config advancefroms;
-			for(auto& units : umc_cfg.child_range("units")) {
-				for(auto& unit_type : units.child_range("unit_type")) {
-					for(const auto& advancefrom : units.child_range("advancefrom")) {
-						config modify_unit_type {
-							"type", unit_type["id"],
-							"add_advancement", advancefrom["unit"],
-							"set_experience", advancefrom["experience"]
-						};
-						deprecated_message(
-							"[advancefrom]",
-							DEP_LEVEL::FOR_REMOVAL,
-							{1, 17, 0},
-							_("Use [modify_unit_type]\n") + modify_unit_type.debug()  + "\n [/modify_unit_type] instead in [campaign]"
-						);
-
-						advancefroms.add_child("modify_unit_type", modify_unit_type);
-					}
-					unit_type.remove_children("advancefrom", [](const config&){return true;});
-				}
+		metadata = temp.child_or_empty("info");
+	}
+
+	std::string using_core = metadata["core"];
+	if(using_core.empty()) {
+		using_core = "default";
+	}
+
+	// Skip add-ons not matching our current core. Cores themselves should be selectable
+	// at all times, so they aren't considered here.
+	if(!metadata.empty() && metadata["type"] != "core" && using_core != preferences::core_id()) {
+		continue;
+	}
+
+	std::string addon_title = metadata["title"].str();
+	if(addon_title.empty()) {
+		addon_title = addon_id;
+	}
+
+	version_info addon_version(metadata["version"]);
+
+	try {
+		std::unique_ptr<schema_validation::schema_validator> validator;
+		if(cmdline_opts_.validate_addon && *cmdline_opts_.validate_addon == addon_id) {
+			validator.reset(new schema_validation::schema_validator(filesystem::get_wml_location("schema/game_config.cfg")));
+			validator->set_create_exceptions(false); // Don't crash if there's an error, just go ahead anyway
+		}
+
+		// Load this addon from the cache to a config.
+		config umc_cfg;
+		cache_.get_config(main_cfg, umc_cfg, validator.get());
+
+		static const std::set<std::string> tags_with_addon_id {
+			"era",
+			"modification",
+			"resource",
+			"multiplayer",
+			"scenario",
+			"campaign",
+			"test"
+		};
+
+		// Annotate appropriate addon types with addon_id info.
+		for(auto child : umc_cfg.all_children_range()) {
+			if(tags_with_addon_id.count(child.key) > 0) {
+				auto& cfg = child.cfg;
+				cfg["addon_id"] = addon_id;
+				cfg["addon_title"] = addon_title;
+				// Note that this may reformat the string in a canonical form.
+				cfg["addon_version"] = addon_version.str();
 			}
+		}
 
-			// hardcoded list of 1.14 advancement macros, just used for the error mesage below.
-			static const std::set<std::string> deprecated_defines {
-				"ENABLE_PARAGON",
-				"DISABLE_GRAND_MARSHAL",
-				"ENABLE_ARMAGEDDON_DRAKE",
-				"ENABLE_DWARVISH_ARCANISTER",
-				"ENABLE_DWARVISH_RUNESMITH",
-				"ENABLE_WOLF_ADVANCEMENT",
-				"ENABLE_NIGHTBLADE",
-				"ENABLE_TROLL_SHAMAN",
-				"ENABLE_ANCIENT_LICH",
-				"ENABLE_DEATH_KNIGHT",
-				"ENABLE_WOSE_SHAMAN"
-			};
-
-			for(auto& campaign : umc_cfg.child_range("campaign")) {
-				campaign.append_children(std::move(advancefroms));
-
-				for(auto str : utils::split(campaign["extra_defines"])) {
-					if(deprecated_defines.count(str) > 0) {
-						//TODO: we could try to implement a compatibility path by
-						//      somehow getting the content of that macro from the
-						//      cache_ object, but considering that 1) the breakage
-						//      isn't that bad (just one disabled unit) and 2)
-						//      it before also didn't work in all cases (see #4402)
-						//      i don't think it is worth it.
-						deprecated_message(
-							"campaign id='" + campaign["id"].str() + "' has extra_defines=" + str,
-							DEP_LEVEL::REMOVED,
-							{1, 15, 4},
-							_("instead, use the macro with the same name in the [campaign] tag")
-						);
-					}
+		config advancefroms;
+		for(auto& units : umc_cfg.child_range("units")) {
+			for(auto& unit_type : units.child_range("unit_type")) {
+				for(const auto& advancefrom : units.child_range("advancefrom")) {
+					config modify_unit_type {
+						"type", unit_type["id"],
+						"add_advancement", advancefrom["unit"],
+						"set_experience", advancefrom["experience"]
+					};
+					deprecated_message(
+						"[advancefrom]",
+						DEP_LEVEL::FOR_REMOVAL,
+						{1, 17, 0},
+						_("Use [modify_unit_type]\n") + modify_unit_type.debug()  + "\n [/modify_unit_type] instead in [campaign]"
+					);
+
+					advancefroms.add_child("modify_unit_type", modify_unit_type);
 				}
+				unit_type.remove_children("advancefrom", [](const config&){return true;});
 			}
+		}
 
-			static const std::set<std::string> entry_tags {
-				"era",
-				"modification",
-				"resource",
-				"multiplayer",
-				"scenario",
-				"campaign"
-			};
-
-			for(const std::string& tagname : entry_tags) {
-				game_config_.append_children_by_move(umc_cfg, tagname);
+		// hardcoded list of 1.14 advancement macros, just used for the error mesage below.
+		static const std::set<std::string> deprecated_defines {
+			"ENABLE_PARAGON",
+			"DISABLE_GRAND_MARSHAL",
+			"ENABLE_ARMAGEDDON_DRAKE",
+			"ENABLE_DWARVISH_ARCANISTER",
+			"ENABLE_DWARVISH_RUNESMITH",
+			"ENABLE_WOLF_ADVANCEMENT",
+			"ENABLE_NIGHTBLADE",
+			"ENABLE_TROLL_SHAMAN",
+			"ENABLE_ANCIENT_LICH",
+			"ENABLE_DEATH_KNIGHT",
+			"ENABLE_WOSE_SHAMAN"
+		};
+
+		for(auto& campaign : umc_cfg.child_range("campaign")) {
+			campaign.append_children(std::move(advancefroms));
+
+			for(auto str : utils::split(campaign["extra_defines"])) {
+				if(deprecated_defines.count(str) > 0) {
+					//TODO: we could try to implement a compatibility path by
+					//      somehow getting the content of that macro from the
+					//      cache_ object, but considering that 1) the breakage
+					//      isn't that bad (just one disabled unit) and 2)
+					//      it before also didn't work in all cases (see #4402)
+					//      i don't think it is worth it.
+					deprecated_message(
+						"campaign id='" + campaign["id"].str() + "' has extra_defines=" + str,
+						DEP_LEVEL::REMOVED,
+						{1, 15, 4},
+						_("instead, use the macro with the same name in the [campaign] tag")
+					);
+				}
 			}
-
-			addon_cfgs_[addon_id] = std::move(umc_cfg);
-		} catch(const config::error& err) {
-			ERR_CONFIG << "config error reading usermade add-on '" << main_cfg << "'" << std::endl;
-			ERR_CONFIG << err.message << '\n';
-			error_addons.push_back(main_cfg);
-			error_log.push_back(err.message);
-		} catch(const preproc_config::error& err) {
-			ERR_CONFIG << "preprocessor config error reading usermade add-on '" << main_cfg << "'" << std::endl;
-			ERR_CONFIG << err.message << '\n';
-			error_addons.push_back(main_cfg);
-			error_log.push_back(err.message);
-		} catch(const filesystem::io_exception&) {
-			ERR_CONFIG << "filesystem I/O error reading usermade add-on '" << main_cfg << "'" << std::endl;
-			error_addons.push_back(main_cfg);
 		}
-	}
 
-	if(cmdline_opts_.validate_addon) {
-		if(!addon_cfgs_.count(*cmdline_opts_.validate_addon)) {
-			ERR_CONFIG << "Didn’t find an add-on for --validate-addon - check whether the id has a typo" << std::endl;
-			const std::string log_msg = formatter()
-				<< "Didn't find an add-on for --validate-addon - check whether the id has a typo";
-			error_log.push_back(log_msg);
-			throw game::error("Did not find an add-on for --validate-addon");
+		for(const std::string& tagname : addon_entry_tags) {
+			game_config_.append_children_by_move(umc_cfg, tagname);
 		}
 
-		WRN_CONFIG << "Note: for --validate-addon to find errors, you have to play (in the GUI) a game that uses the add-on.";
-	}
-
-	if(!error_addons.empty()) {
-		const std::size_t n = error_addons.size();
-		const std::string& msg1 =
-			_n("The following add-on had errors and could not be loaded:",
-			   "The following add-ons had errors and could not be loaded:",
-			   n);
-		const std::string& msg2 =
-			_n("Please report this to the author or maintainer of this add-on.",
-			   "Please report this to the respective authors or maintainers of these add-ons.",
-			   n);
-
-		const std::string& report = utils::join(error_log, "\n\n");
-		events::call_in_main_thread([&]() {
-			gui2::dialogs::wml_error::display(msg1, msg2, error_addons, report);
-		});
+		addon_cfgs_[addon_id] = std::move(umc_cfg);
+	} catch(const config::error& err) {
+		ERR_CONFIG << "config error reading usermade add-on '" << main_cfg << "'" << std::endl;
+		ERR_CONFIG << err.message << '\n';
+		error_addons.push_back(main_cfg);
+		error_log.push_back(err.message);
+	} catch(const preproc_config::error& err) {
+		ERR_CONFIG << "preprocessor config error reading usermade add-on '" << main_cfg << "'" << std::endl;
+		ERR_CONFIG << err.message << '\n';
+		error_addons.push_back(main_cfg);
+		error_log.push_back(err.message);
+	} catch(const filesystem::io_exception&) {
+		ERR_CONFIG << "filesystem I/O error reading usermade add-on '" << main_cfg << "'" << std::endl;
+		error_addons.push_back(main_cfg);
 	}
 }
 
 void game_config_manager::set_multiplayer_hashes()
 {
+	// Drop the block from any earlier load; lookups return the first match.
+	game_config_.clear_children("multiplayer_hashes");
 	config& hashes = game_config_.add_child("multiplayer_hashes");
 	for(const config& ch : game_config().child_range("multiplayer")) {
 		hashes[ch["id"].str()] = ch.hash();
@@ -644,6 +695,135 @@ void game_config_manager::set_unit_data()
 	unit_types.set_config(game_config().merged_children_view("units"));
 }
 
+void game_config_manager::rebuild_derived_config_data()
+{
+	// Extract the Lua scripts at toplevel.
+	game_lua_kernel::extract_preload_scripts(game_config());
+
+	set_unit_data();
+	terrain_builder::set_terrain_rules_cfg(game_config());
+	tdata_ = std::make_shared<terrain_type_data>(game_config());
+	::init_strings(game_config());
+	theme::set_known_themes(&game_config());
+
+	set_multiplayer_hashes();
+
+	game_config::add_color_info(game_config());
+}
+
+void game_config_manager::remove_addon_toplevel_tags(const std::string& addon_id)
+{
+	for(const std::string& tagname : addon_entry_tags) {
+		game_config_.remove_children(tagname, [&addon_id](const config& cfg) {
+			return cfg["addon_id"] == addon_id;
+		});
+	}
+}
+
+bool game_config_manager::reload_addon_layers()
+{
+	if(game_config_.empty() || game_config::no_addons || cmdline_opts_.noaddons) {
+		return false;
+	}
+
+	// Mainline or loose userdata content changed; only whole add-on
+	// directories can be swapped as layers, so everything must be re-read.
+	if(non_addon_tree_checksum() != mainline_checksum_) {
+		return false;
+	}
+
+	std::vector<std::string> addon_ids;
+	filesystem::get_files_in_dir(filesystem::get_addons_dir(), nullptr, &addon_ids,
+		filesystem::name_mode::FILE_NAME_ONLY);
+
+	std::vector<std::string> changed, removed;
+	std::set<std::string> present;
+
+	for(const std::string& id : addon_ids) {
+		filesystem::file_tree_checksum checksum;
+		filesystem::get_tree_checksum(filesystem::get_addons_dir() + "/" + id, checksum);
+		present.insert(id);
+
+		const auto known = addon_checksums_.find(id);
+		if(known == addon_checksums_.end() || known->second != checksum) {
+			changed.push_back(id);
+		}
+	}
+
+	for(const auto& known : addon_checksums_) {
+		if(present.count(known.first) == 0) {
+			removed.push_back(known.first);
+		}
+	}
+
+	if(changed.empty() && removed.empty()) {
+		LOG_CONFIG << "no add-on changed on disk; keeping the merged config\n";
+		return true;
+	}
+
+	// Cores are merged into the main config at load time rather than kept in
+	// their add-on's layer, so a touched core needs the full reload.
+	for(const std::string& id : changed) {
+		if(filesystem::file_exists(filesystem::get_addons_dir() + "/" + id + "/cores.cfg")) {
+			return false;
+		}
+	}
+
+	for(const std::string& id : removed) {
+		for(const config& core : game_config_.child_range("core")) {
+			if(core["path"].str().find("add-ons/" + id + "/") != std::string::npos) {
+				return false;
+			}
+		}
+	}
+
+	LOG_CONFIG << "reloading " << changed.size() << " changed and dropping "
+			   << removed.size() << " removed add-on layer(s)\n";
+
+	// New nodes must come from the arena backing the layers we keep.
+	config_arena::scope arena_scope(*arena_);
+
+	// Re-parse under the defines of the previous load, so the new layers see
+	// the same preprocessor environment as the ones that are kept.
+	std::deque<game_config::scoped_preproc_define> last_defines;
+	for(const preproc_map::value_type& define : old_defines_map_) {
+		if(cache_.get_preproc_map().count(define.first) == 0) {
+			last_defines.emplace_back(define.first);
+		}
+	}
+
+	std::vector<std::string> error_log;
+	std::vector<std::string> error_addons;
+
+	for(const std::string& id : removed) {
+		addon_cfgs_.erase(id);
+		addon_checksums_.erase(id);
+		remove_addon_toplevel_tags(id);
+	}
+
+	for(const std::string& id : changed) {
+		log_scope2(log_config, "Reloading add-on '" + id + "'");
+		addon_cfgs_.erase(id);
+		remove_addon_toplevel_tags(id);
+		load_addon_cfg(id, error_log, error_addons);
+	}
+
+	show_addon_load_errors(error_addons, error_log);
+
+	// Recompose the view over the new set of layers and rebuild everything
+	// derived from the merged config.
+	if(active_addons_.empty()) {
+		set_enabled_addon_all();
+	} else {
+		set_enabled_addon(active_addons_);
+	}
+
+	rebuild_derived_config_data();
+	paths_manager_.set_paths(game_config());
+
+	return true;
+}
+
 void game_config_manager::reload_changed_game_config()
 {
 	// Rebuild addon version info cache.
@@ -651,9 +831,14 @@ void game_config_manager::reload_changed_game_config()
 
 	// Force a reload of configuration information.
 	cache_.recheck_filetree_checksum();
-	old_defines_map_.clear();
 	filesystem::clear_binary_paths_cache();
-	init_game_config(FORCE_RELOAD);
+
+	// When only installed add-ons changed, swap their layers into the merged
+	// config instead of re-reading the whole data tree.
+	if(!reload_addon_layers()) {
+		old_defines_map_.clear();
+		init_game_config(FORCE_RELOAD);
+	}
 
 	image::flush_cache();
 	sound::flush_cache();
@@ -740,11 +925,14 @@ void game_config_manager::load_game_config_for_create(bool is_mp, bool is_test)
 	}
 }
 
+std::size_t game_config_manager::generation_ = 0;
+
 void game_config_manager::set_enabled_addon(std::set<std::string> addon_ids)
 {
 	auto& vec = game_config_view_.data();
 	vec.clear();
 	vec.push_back(game_config_);
+	++generation_;
 
 	for(const std::string& id : addon_ids) {
 		auto it = addon_cfgs_.find(id);
@@ -759,6 +947,7 @@ void game_config_manager::set_enabled_addon_all()
 	auto& vec = game_config_view_.data();
 	vec.clear();
 	vec.push_back(game_config_);
+	++generation_;
 
 	for(const auto& pair : addon_cfgs_) {
 		vec.push_back(pair.second);
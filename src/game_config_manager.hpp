@@ -17,6 +17,7 @@
 
 #include "commandline_options.hpp"
 #include "config.hpp"
+#include "config_arena.hpp"
 #include "config_cache.hpp"
 #include "filesystem.hpp"
 #include "game_config_view.hpp"
@@ -53,6 +54,14 @@ public:
 
 	static game_config_manager * get();
 
+	/**
+	 * Monotonically increasing counter, bumped whenever the set of configs
+	 * visible through game_config() changes (full reloads, add-on layer
+	 * swaps, enabling a different add-on selection). Lets caches built
+	 * from the merged config detect staleness cheaply.
+	 */
+	static std::size_t generation() { return generation_; }
+
 
 private:
 	void set_enabled_addon(std::set<std::string> addon_ids);
@@ -66,19 +75,51 @@ private:
 
 	// load_game_config() helper functions.
 	void load_addons_cfg();
+	void load_addon_cfg(const std::string& addon_id,
+		std::vector<std::string>& error_log, std::vector<std::string>& error_addons);
 	void set_multiplayer_hashes();
 	void set_unit_data();
 
+	/** Rebuilds everything computed from the merged config: unit types, terrains, themes, etc. */
+	void rebuild_derived_config_data();
+
+	/** Removes an add-on's contributions to the main config (campaigns, eras, ...). */
+	void remove_addon_toplevel_tags(const std::string& addon_id);
+
+	/**
+	 * Swaps only the add-on layers whose files changed on disk into the
+	 * merged config, keeping mainline and every unchanged layer as loaded.
+	 * Returns false when that is not possible (mainline content changed, a
+	 * core was touched, ...) and a full reload is required instead.
+	 */
+	bool reload_addon_layers();
+
 	const commandline_options& cmdline_opts_;
 
+	/**
+	 * Backing store for the nodes of game_config_ and addon_cfgs_; must be
+	 * declared before them so it outlives them, and is replaced on reload
+	 * once the old trees have been dropped.
+	 */
+	std::unique_ptr<config_arena> arena_;
+
 	config game_config_;
 	game_config_view game_config_view_;
 
 	std::map<std::string, config> addon_cfgs_;
 	std::set<std::string> active_addons_;
 
+	/** On-disk state of each add-on directory as of the last time its layer was parsed. */
+	std::map<std::string, filesystem::file_tree_checksum> addon_checksums_;
+
+	/** On-disk state of everything outside the add-ons directory as of the last full load. */
+	filesystem::file_tree_checksum mainline_checksum_;
+
 	preproc_map old_defines_map_;
 
+	/** See generation(). */
+	static std::size_t generation_;
+
 	filesystem::binary_paths_manager paths_manager_;
 
 	game_config::config_cache& cache_;
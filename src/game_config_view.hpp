@@ -51,6 +51,11 @@ public:
       return cfgs_;
    }
 
+   const config_array_view& data() const
+   {
+      return cfgs_;
+   }
+
 private:
 
 	explicit game_config_view(const config& cfg)
@@ -31,6 +31,8 @@ static lg::log_domain log_engine("engine");
 #define LOG_NG LOG_STREAM(info, log_engine)
 #define DBG_NG LOG_STREAM(debug, log_engine)
 
+std::size_t game_data::variable_generation_ = 0;
+
 game_data::game_data(const config& level)
 	: variable_set()
 	, scoped_variables()
@@ -52,8 +52,34 @@ public:
 	variable_access_create get_variable_access_write(const std::string& varname)
 	{
 		activate_scope_variable(varname);
+		bump_variable_generation();
 		return variable_access_create(varname, variables_);
 	}
+	/** as above, but resolved through a precompiled path */
+	variable_access_const get_variable_access_read(const variable_path& path) const override
+	{
+		activate_scope_variable(path.name());
+		return variable_access_const(path, variables_);
+	}
+	/** as above, but resolved through a precompiled path */
+	variable_access_create get_variable_access_write(const variable_path& path)
+	{
+		activate_scope_variable(path.name());
+		bump_variable_generation();
+		return variable_access_create(path, variables_);
+	}
+
+	/**
+	 * Monotonically increasing counter, bumped on every write access to the
+	 * game variables and whenever a scoped variable (e.g. $unit) enters or
+	 * leaves scope. Shared by all instances. Lets caches of
+	 * variable-substituted data detect staleness cheaply, see
+	 * vconfig::get_parsed_config().
+	 */
+	static std::size_t variable_generation() { return variable_generation_; }
+
+	/** See variable_generation(). */
+	static void bump_variable_generation() { ++variable_generation_; }
 	/**
 	 * Clears attributes config children
 	 * does nothing if varname is no valid variable name.
@@ -114,9 +140,13 @@ private:
 	variable_access_throw get_variable_access_throw(const std::string& varname)
 	{
 		activate_scope_variable(varname);
+		bump_variable_generation();
 		return variable_access_throw(varname, variables_);
 	}
 
+	/** See variable_generation(). */
+	static std::size_t variable_generation_;
+
 	randomness::mt_rng rng_;
 	config variables_;
 	PHASE phase_;
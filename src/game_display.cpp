@@ -76,6 +76,7 @@ game_display::game_display(game_board& board,
 	, in_game_(false)
 	, chat_man_(new display_chat_manager(*this))
 	, mode_(RUNNING)
+	, last_frame_report_refresh_(0)
 	, needs_rebuild_(false)
 {
 	video().clear_screen();
@@ -244,7 +245,11 @@ void game_display::draw_invalidated()
 
 void game_display::post_commit()
 {
-	halo_man_->render();
+	// Halo additions can arrive outside of the invalidation machinery, so the
+	// damage they cause to the screen has to be reported here by hand.
+	if(halo_man_->render()) {
+		mark_frame_dirty(map_area());
+	}
 }
 
 void game_display::draw_hex(const map_location& loc)
@@ -369,9 +374,16 @@ void game_display::draw_sidebar()
 	if ( !team_valid() )
 		return;
 
-	refresh_report("report_clock");
-    refresh_report("report_battery");
-	refresh_report("report_countdown");
+	// These three have no invalidation event, so they used to regenerate
+	// every frame; half-second granularity is plenty for their contents.
+	const uint32_t ticks = SDL_GetTicks();
+	if(ticks - last_frame_report_refresh_ >= 500) {
+		last_frame_report_refresh_ = ticks;
+
+		refresh_report("report_clock");
+		refresh_report("report_battery");
+		refresh_report("report_countdown");
+	}
 
 	if (invalidateGameStatus_)
 	{
@@ -552,8 +564,24 @@ std::vector<surface> footsteps_images(const map_location& loc, const pathfind::m
 
 void game_display::highlight_reach(const pathfind::paths &paths_list)
 {
-	unhighlight_reach();
-	highlight_another_reach(paths_list);
+	// The destinations are sorted by location, so folding with an end
+	// hint avoids a fresh tree lookup per destination.
+	reach_map new_reach;
+	for (const pathfind::paths::step &dest : paths_list.destinations) {
+		new_reach.emplace_hint(new_reach.end(), dest.curr, 0)->second++;
+	}
+
+	units_that_can_reach_goal_.clear();
+
+	// Re-showing the reach that is already displayed (hovering back onto
+	// the same unit before the old highlight was dropped) must not kick
+	// off the invalidate/redraw cycle of every affected hex.
+	if(new_reach == reach_map_) {
+		return;
+	}
+
+	reach_map_ = std::move(new_reach);
+	reach_map_changed_ = true;
 }
 
 void game_display::highlight_another_reach(const pathfind::paths &paths_list,
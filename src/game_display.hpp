@@ -239,6 +239,15 @@ private:
 
 	game_mode mode_;
 
+	/**
+	 * When the clock, battery and countdown reports were last regenerated.
+	 *
+	 * Unlike the other sidebar reports these have no invalidation event, so
+	 * they are refreshed from draw_sidebar() on a timer instead of every
+	 * frame; their contents only have second granularity anyway.
+	 */
+	uint32_t last_frame_report_refresh_;
+
 	// For debug mode
 	static std::map<map_location, int> debugHighlights_;
 
@@ -40,14 +40,21 @@ static lg::log_domain log_event_handler("event_handler");
 // This file is in the game_events namespace.
 namespace game_events
 {
+namespace
+{
+	// Monotonic source for event_handler::sequence().
+	unsigned next_sequence = 0;
+}
+
 /* ** event_handler ** */
 
 event_handler::event_handler(config&& cfg, bool imi, const std::vector<std::string>& types)
 	: first_time_only_(cfg["first_time_only"].to_bool(true))
 	, is_menu_item_(imi)
 	, disabled_(false)
-	, cfg_(cfg)
+	, cfg_(std::move(cfg))
 	, types_(types)
+	, sequence_(next_sequence++)
 {
 }
 
@@ -71,12 +71,23 @@ public:
 		return cfg_;
 	}
 
+	/**
+	 * Position in the order of handler registration.
+	 * Used to restore definition order when the handlers matching an event
+	 * are gathered from more than one index.
+	 */
+	unsigned sequence() const
+	{
+		return sequence_;
+	}
+
 private:
 	bool first_time_only_;
 	bool is_menu_item_;
 	bool disabled_;
 	config cfg_;
 	std::vector<std::string> types_;
+	unsigned sequence_;
 };
 
 }
@@ -26,6 +26,7 @@
 #include "resources.hpp"
 #include "serialization/string_utils.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 static lg::log_domain log_engine("engine");
@@ -163,29 +164,26 @@ void manager::execute_on_events(const std::string& event_id, manager::event_func
 {
 	const std::string standardized_event_id = event_handlers::standardize_name(event_id);
 	const game_data* gd = resources::gamedata;
-	auto& active_handlers = event_handlers_->get_active();
-
-	// Save the end outside the loop so the end point remains constant,
-	// even if new events are added to the queue.
-	const unsigned saved_end = active_handlers.size();
-
 
 	{
 		// Ensure that event handlers won't be cleaned up while we're iterating them.
 		event_handler_list_lock lock;
 
-		for (unsigned i = 0; i < saved_end; ++i) {
-			handler_ptr handler = nullptr;
+		// Gather the matching handlers from the by-name index plus the (usually short)
+		// list of handlers with variables in their names, instead of scanning every
+		// active handler. Snapshotting them up front also keeps the set of handlers to
+		// run stable, even if one of them registers new events.
+		std::vector<handler_ptr> matching_handlers;
 
-			try {
-				handler = active_handlers.at(i);
-			}
-			catch (const std::out_of_range&) {
-				continue;
+		for (const weak_handler_ptr& weak : event_handlers_->get(standardized_event_id)) {
+			if (handler_ptr handler = weak.lock()) {
+				matching_handlers.push_back(std::move(handler));
 			}
+		}
 
-			// Shouldn't happen, but we're just being safe.
-			if (!handler || handler->disabled()) {
+		for (const weak_handler_ptr& weak : event_handlers_->get_dynamic()) {
+			handler_ptr handler = weak.lock();
+			if (!handler) {
 				continue;
 			}
 
@@ -208,11 +206,25 @@ void manager::execute_on_events(const std::string& event_id, manager::event_func
 				}
 
 				if (matches) {
-					func(*this, handler);
+					matching_handlers.push_back(std::move(handler));
 					break;
 				}
 			}
 		}
+
+		// Each index list is kept in registration order, but the relative order between
+		// the two is lost, so restore the order the handlers were defined in.
+		std::sort(matching_handlers.begin(), matching_handlers.end(),
+			[](const handler_ptr& a, const handler_ptr& b) { return a->sequence() < b->sequence(); });
+
+		for (const handler_ptr& handler : matching_handlers) {
+			// An earlier handler in this very batch may have disabled this one.
+			if (handler->disabled()) {
+				continue;
+			}
+
+			func(*this, handler);
+		}
 	}
 
 	// Clean up expired ptrs. This saves us effort later since it ensures every ptr is valid.
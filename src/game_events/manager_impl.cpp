@@ -127,18 +127,27 @@ void event_handlers::add_event_handler(const config& cfg, bool is_menu_item)
 	std::vector<std::string> standardized_names = utils::split(name);
 
 	if(!name.empty()) {
-		// ...and standardize each one individually. This ensures they're all valid for by-name lookup.
+		// ...and standardize each one individually. This ensures they're all valid
+		// for by-name lookup. utils::split() already trimmed the ends, so only
+		// names with internal spaces actually need rewriting; in particular,
+		// handlers reloaded from a save went through this once before being
+		// written out and can skip the rewrite wholesale.
+		bool rewritten = false;
+
 		for(std::string& single_name : standardized_names) {
-			if(!utils::might_contain_variables(single_name)) {
+			if(!utils::might_contain_variables(single_name) && single_name.find(' ') != std::string::npos) {
 				single_name = standardize_name(single_name);
+				rewritten = true;
 			}
 		}
 
 		assert(!standardized_names.empty());
 
-		// Write the new name back to the config.
-		name = utils::join(standardized_names);
-		event_cfg["name"] = name;
+		if(rewritten) {
+			// Write the new name back to the config.
+			name = utils::join(standardized_names);
+			event_cfg["name"] = name;
+		}
 	}
 
 	// Create a new handler.
@@ -318,15 +318,54 @@ void connect_engine::update_level()
 
 void connect_engine::update_and_send_diff(bool /*update_time_of_day*/)
 {
-	config old_level = level_;
-	update_level();
+	config& scen = scenario();
+	config::child_itors sides = scen.child_range("side");
+
+	// Nothing else in the level changes between diffs, so regenerate and
+	// transmit only the sides whose engine state changed instead of copying
+	// and diffing the entire level for every faction or color click.
+	if(static_cast<std::size_t>(sides.size()) != side_engines_.size()) {
+		// The side list has an unexpected shape; fall back to a full rebuild.
+		config old_level = level_;
+		update_level();
+
+		config diff = level_.get_diff(old_level);
+		if(!diff.empty()) {
+			config scenario_diff;
+			scenario_diff.add_child("scenario_diff", std::move(diff));
+			mp::send_to_server(scenario_diff);
+		}
+		return;
+	}
 
-	config diff = level_.get_diff(old_level);
-	if(!diff.empty()) {
-		config scenario_diff;
-		scenario_diff.add_child("scenario_diff", std::move(diff));
-		mp::send_to_server(scenario_diff);
+	DBG_MP << "updating level" << std::endl;
+
+	config scenario_changes;
+	for(std::size_t i = 0; i < side_engines_.size(); ++i) {
+		config new_side = side_engines_[i]->new_config();
+		if(new_side == sides[i]) {
+			continue;
+		}
+
+		// Same shape config::get_diff() would emit for this side.
+		config& change = scenario_changes.add_child("change_child");
+		change["index"] = static_cast<int>(i);
+		change.add_child("side", new_side.get_diff(sides[i]));
+		sides[i].swap(new_side);
+	}
+
+	if(scenario_changes.empty()) {
+		return;
 	}
+
+	config diff;
+	config& change = diff.add_child("change_child");
+	change["index"] = 0;
+	change.add_child(level_.has_child("scenario") ? "scenario" : "snapshot", std::move(scenario_changes));
+
+	config scenario_diff;
+	scenario_diff.add_child("scenario_diff", std::move(diff));
+	mp::send_to_server(scenario_diff);
 }
 
 bool connect_engine::can_start_game() const
@@ -25,6 +25,7 @@
 #include "gui/dialogs/depcheck_confirm_change.hpp"
 #include "gui/dialogs/depcheck_select_new.hpp"
 #include "gui/dialogs/message.hpp"
+#include "game_config_manager.hpp"
 #include "game_config_view.hpp"
 
 static lg::log_domain log_mp_create_depcheck("mp/create/depcheck");
@@ -51,6 +52,15 @@ void copy_keys(config& out, const config& in, const std::string& type, bool copy
 		}
 	}
 }
+
+/**
+ * The dependency info collected from the last manager construction, kept
+ * until the merged game config changes (see manager::manager()).
+ */
+std::size_t cached_depinfo_generation = 0;
+bool cached_depinfo_mp = false;
+config cached_depinfo;
+
 } // anonymous namespace
 
 namespace ng
@@ -68,6 +78,18 @@ manager::manager(const game_config_view& gamecfg, bool mp)
 {
 	DBG_MP << "Initializing the dependency manager" << std::endl;
 
+	// Collecting the dependency info walks every [era], [modification],
+	// [multiplayer] and [campaign] in the merged config, which gets slow
+	// with many add-ons installed — and the create screen builds a new
+	// manager every time it opens. The result only depends on the config
+	// and the sp/mp flag, so reuse the previous collection until the
+	// config changes.
+	const std::size_t generation = game_config_manager::generation();
+	if(!cached_depinfo.empty() && cached_depinfo_generation == generation && cached_depinfo_mp == mp) {
+		depinfo_ = cached_depinfo;
+		return;
+	}
+
 	for(const config& cfg : gamecfg.child_range("modification")) {
 		component_availability type = cfg["type"].to_enum<component_availability>(component_availability::HYBRID);
 
@@ -123,6 +145,10 @@ manager::manager(const game_config_view& gamecfg, bool mp)
 
 		depinfo_.add_child("scenario", std::move(info));
 	}
+
+	cached_depinfo = depinfo_;
+	cached_depinfo_mp = mp;
+	cached_depinfo_generation = generation;
 }
 
 void manager::save_state()
@@ -107,6 +107,13 @@ struct game_info
 	bool has_friends;
 	bool has_ignored;
 
+	/**
+	 * Cached result of the last game filter evaluation for this game. Only
+	 * re-evaluated when the game changes or the filters themselves do, see
+	 * lobby_info::apply_game_filter().
+	 */
+	bool matches_filters;
+
 	enum class disp_status {
 		CLEAN,
 		NEW,
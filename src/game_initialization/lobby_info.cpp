@@ -275,6 +275,12 @@ std::function<void()> lobby_info::begin_state_sync()
 			if(i->second.display_status == game_info::disp_status::DELETED) {
 				i = games_by_id_.erase(i);
 			} else {
+				// The filter functions are expensive, so only run them against the
+				// games this update actually touched; the rest keep their verdict.
+				if(i->second.display_status != game_info::disp_status::CLEAN) {
+					i->second.matches_filters = is_game_visible(i->second);
+				}
+
 				i->second.display_status = game_info::disp_status::CLEAN;
 				++i;
 			}
@@ -284,9 +290,8 @@ std::function<void()> lobby_info::begin_state_sync()
 
 		make_games_vector();
 
-		// Now that both containers are again in sync, update the visibility mask. We want to do
-		// this last since the filer functions are expensive.
-		apply_game_filter();
+		// Now that both containers are again in sync, update the visibility mask.
+		refresh_visibility_mask();
 	};
 }
 
@@ -340,13 +345,22 @@ bool lobby_info::is_game_visible(const game_info& game)
 }
 
 void lobby_info::apply_game_filter()
+{
+	for(game_info* game : games_) {
+		game->matches_filters = is_game_visible(*game);
+	}
+
+	refresh_visibility_mask();
+}
+
+void lobby_info::refresh_visibility_mask()
 {
 	// Since games_visibility_ is a visibility mask over games_,
 	// they need to be the same size or we'll end up with issues.
 	assert(games_visibility_.size() == games_.size());
 
 	for(unsigned i = 0; i < games_.size(); ++i) {
-		games_visibility_[i] = is_game_visible(*games_[i]);
+		games_visibility_[i] = games_[i]->matches_filters;
 	}
 }
 
@@ -83,7 +83,7 @@ public:
 	/** Returns whether the game would be visible after the game filters are applied */
 	bool is_game_visible(const game_info&);
 
-	/** Generates a new list of games that match the current filter functions and inversion setting. */
+	/** Re-evaluates every game against the current filter functions and inversion setting. */
 	void apply_game_filter();
 
 	/** Returns info on a game with the given game ID. */
@@ -133,6 +133,9 @@ private:
 	 */
 	void make_games_vector();
 
+	/** Rebuilds the visibility mask from each game's cached filter verdict. */
+	void refresh_visibility_mask();
+
 	std::vector<std::string> installed_addons_;
 
 	config gamelist_;
@@ -22,8 +22,10 @@
 #include "game_initialization/playcampaign.hpp"
 
 #include "carryover.hpp"
+#include "filesystem.hpp"
 #include "formula/string_utils.hpp"
 #include "game_config.hpp"
+#include "game_config_manager.hpp"
 #include "game_errors.hpp"
 #include "game_initialization/connect_engine.hpp"
 #include "game_initialization/mp_game_utils.hpp"
@@ -43,7 +45,9 @@
 #include "preferences/game.hpp"
 #include "saved_game.hpp"
 #include "savegame.hpp"
+#include "serialization/string_utils.hpp"
 #include "sound.hpp"
+#include "units/types.hpp"
 #include "wesnothd_connection.hpp"
 #include "wml_exception.hpp"
 
@@ -179,6 +183,90 @@ void campaign_controller::show_carryover_message(
 	}
 }
 
+void campaign_controller::prestage_next_scenario(
+	playsingle_controller& playcontroller, const end_level_data& end_level, const LEVEL_RESULT res)
+{
+	if(res != LEVEL_RESULT::VICTORY || !end_level.proceed_to_next_level) {
+		return;
+	}
+
+	const std::string& next_scenario = playcontroller.gamestate().get_game_data()->next_scenario();
+	if(next_scenario.empty() || next_scenario == "null") {
+		return;
+	}
+
+	// If the next scenario needs a different set of preprocessor defines the
+	// whole game config is rebuilt under a loading screen and there is nothing
+	// useful to overlap. Pre-stage only when it is part of the tree that's
+	// already loaded, which is the common case within a campaign.
+	const config& scenario = game_config_manager::get()->game_config().find_child(
+		state_.classification().get_tagname(), "id", next_scenario);
+
+	if(!scenario) {
+		return;
+	}
+
+	// Collect the images the next scenario asks for first: the story screen
+	// backgrounds and the sprites of each side's leader and recruits.
+	std::set<std::string> images;
+
+	const auto add_image = [&images](const std::string& name) {
+		if(!name.empty()) {
+			// Strip any image path functions; only the file is read.
+			images.insert(name.substr(0, name.find('~')));
+		}
+	};
+
+	const auto add_unit_image = [&add_image](const std::string& type_id) {
+		// CREATED is enough for the sprite path and avoids forcing a full
+		// build of the type.
+		if(const unit_type* type = unit_types.find(type_id, unit_type::CREATED)) {
+			add_image(type->image());
+		}
+	};
+
+	for(const config& story : scenario.child_range("story")) {
+		for(const config& part : story.child_range("part")) {
+			add_image(part["background"]);
+
+			for(const config& layer : part.child_range("background_layer")) {
+				add_image(layer["image"]);
+			}
+		}
+	}
+
+	for(const config& side : scenario.child_range("side")) {
+		add_unit_image(side["type"]);
+
+		for(const std::string& recruit : utils::split(side["recruit"])) {
+			add_unit_image(recruit);
+		}
+	}
+
+	// Resolve the names on this thread -- the binary path caches behind
+	// get_binary_file_location() are not thread safe -- and hand the worker
+	// plain paths. The decoded-image caches are flushed between scenarios, so
+	// decoding now would be thrown away; what the worker buys is the disk
+	// reads, pulled into the OS cache while the player reads the dialogs.
+	std::vector<std::string> files;
+	for(const std::string& img : images) {
+		std::string path = filesystem::get_binary_file_location("images", img);
+		if(!path.empty()) {
+			files.push_back(std::move(path));
+		}
+	}
+
+	if(files.empty()) {
+		return;
+	}
+
+	prestage_ = std::async(std::launch::async, [files = std::move(files)]() {
+		for(const std::string& file : files) {
+			filesystem::read_file(file);
+		}
+	});
+}
+
 LEVEL_RESULT campaign_controller::playsingle_scenario(end_level_data &end_level)
 {
 	const config& starting_point = is_replay_
@@ -206,6 +294,7 @@ LEVEL_RESULT campaign_controller::playsingle_scenario(end_level_data &end_level)
 	}
 
 	end_level = playcontroller.get_end_level_data();
+	prestage_next_scenario(playcontroller, end_level, res);
 	show_carryover_message(playcontroller, end_level, res);
 
 	if(!CVideo::get_singleton().faked()) {
@@ -369,6 +458,13 @@ LEVEL_RESULT campaign_controller::play_game()
 			// clear previous game content information
 			// otherwise it keeps getting appended for each scenario resulting in incorrect data being sent to the server to be stored
 			state_.mp_settings().addons.clear();
+
+			// Don't let a still-running asset prewarm compete with the load
+			// machinery for the disk.
+			if(prestage_.valid()) {
+				prestage_.wait();
+			}
+
 			// Retrieve next scenario data.
 			state_.expand_scenario();
 
@@ -18,6 +18,7 @@
 
 #include "game_end_exceptions.hpp"
 
+#include <future>
 #include <memory>
 #include <sstream>
 #include <set>
@@ -59,6 +60,7 @@ public:
 		, is_unit_test_(is_unit_test)
 		, is_replay_(false)
 		, mp_info_(nullptr)
+		, prestage_()
 	{
 	}
 
@@ -81,8 +83,19 @@ private:
 	void show_carryover_message(
 		playsingle_controller& playcontroller, const end_level_data& end_level, LEVEL_RESULT res);
 
+	/**
+	 * Kicked off the moment victory is decided: pulls the next scenario's
+	 * first-draw assets into the OS file cache on a background thread,
+	 * overlapped with the player reading the carryover dialog and lingering.
+	 */
+	void prestage_next_scenario(
+		playsingle_controller& playcontroller, const end_level_data& end_level, LEVEL_RESULT res);
+
 	saved_game& state_;
 	const bool is_unit_test_;
 	bool is_replay_;
 	mp_game_metadata* mp_info_;
+
+	/** Pending asset prewarm from prestage_next_scenario(), if any. */
+	std::future<void> prestage_;
 };
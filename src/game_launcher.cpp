@@ -490,6 +490,15 @@ game_launcher::unit_test_result game_launcher::unit_test()
 	}
 
 	auto ret = unit_test_result::TEST_FAIL; // will only be returned if no test is run
+
+	// run_wml_tests only batches tests which all expect the same result, and
+	// tells us which one via --expected-result. Stopping at the first test
+	// that deviates from it means a failure can never be masked by a later
+	// test returning the expected status.
+	const auto expected_result = cmdline_opts_.expected_unit_test_result
+		? static_cast<unit_test_result>(*cmdline_opts_.expected_unit_test_result)
+		: unit_test_result::TEST_PASS;
+
 	for(const auto& scenario : test_scenarios_) {
 		set_test(scenario);
 		ret = single_unit_test();
@@ -531,7 +540,7 @@ game_launcher::unit_test_result game_launcher::unit_test()
 		}
 
 		std::cerr << describe_result << ": " << scenario << std::endl;
-		if(ret != unit_test_result::TEST_PASS) {
+		if(ret != expected_result) {
 			break;
 		}
 	}
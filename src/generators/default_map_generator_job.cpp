@@ -229,17 +229,25 @@ namespace {
 
 
 default_map_generator_job::default_map_generator_job()
-	: rng_(seed_rng::next_seed())
-	, game_config_(game_config_manager::get()->game_config())
+	: default_map_generator_job(seed_rng::next_seed())
 {
 }
 
 default_map_generator_job::default_map_generator_job(uint32_t seed)
-	: rng_(seed)
+	: seed_(seed)
+	, rng_(seed)
 	, game_config_(game_config_manager::get()->game_config())
 {
 }
 
+void default_map_generator_job::start_pass(uint32_t pass)
+{
+	// A seed sequence keeps the sub-streams decorrelated even though the
+	// pass numbers only differ in their low bits.
+	std::seed_seq seq{seed_, pass};
+	rng_.seed(seq);
+}
+
 /**
  * Generate a height-map.
  *
@@ -291,6 +299,15 @@ height_map default_map_generator_job::generate_height_map(size_t width, size_t h
 {
 	height_map res(width, std::vector<int>(height,0));
 
+	// The hill heights only depend on the squared distance from the hill's
+	// center, so precompute the square roots once instead of calling
+	// std::sqrt for every tile of every hill. Both offsets are below
+	// hill_size, so 2*hill_size^2 bounds the squared distances we can see.
+	std::vector<int> root_of(hill_size*hill_size*2 + 1);
+	for(std::size_t d2 = 0; d2 != root_of.size(); ++d2) {
+		root_of[d2] = static_cast<int>(std::sqrt(static_cast<double>(d2)));
+	}
+
 	DBG_NG << iterations << " iterations\n";
 	for(std::size_t i = 0; i != iterations; ++i) {
 
@@ -327,21 +344,23 @@ height_map default_map_generator_job::generate_height_map(size_t width, size_t h
 		const int max_y = y1 + radius < static_cast<long>(res.front().size()) ? y1 + radius : res.front().size();
 
 		for(int x2 = min_x; x2 < max_x; ++x2) {
+			std::vector<int>& column = res[x2];
+			const int xdiff2 = (x2-x1)*(x2-x1);
+
 			for(int y2 = min_y; y2 < max_y; ++y2) {
-				const int xdiff = (x2-x1);
 				const int ydiff = (y2-y1);
 
-				const int hill_height = radius - static_cast<int>(std::sqrt(static_cast<double>(xdiff*xdiff + ydiff*ydiff)));
+				const int hill_height = radius - root_of[xdiff2 + ydiff*ydiff];
 
 				if(hill_height > 0) {
 					if(is_valley) {
-						if(hill_height > res[x2][y2]) {
-							res[x2][y2] = 0;
+						if(hill_height > column[y2]) {
+							column[y2] = 0;
 						} else {
-							res[x2][y2] -= hill_height;
+							column[y2] -= hill_height;
 						}
 					} else {
-						res[x2][y2] += hill_height;
+						column[y2] += hill_height;
 					}
 				}
 			}
@@ -750,6 +769,10 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 	}
 
 	// Generate the height of everything.
+	// Every pass below draws from its own deterministic sub-stream of the
+	// master seed, so the amount of randomness one pass consumes cannot
+	// shift the results of the ones after it.
+	start_pass(0);
 	const height_map heights = generate_height_map(data.width, data.height, data.iterations, data.hill_size, data.island_size, data.island_off_center);
 
 	LOG_NG << "Done generating height map. " << (SDL_GetTicks() - ticks) << " ticks elapsed" << "\n";
@@ -768,15 +791,23 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 		height_conversion.emplace_back(h);
 	}
 
+	// Heights are normalized to 0-1000, so tabulate the first matching
+	// [height] rule for every possible value up front rather than scanning
+	// the rule list again for each of the w*h*9 tiles.
+	std::vector<t_translation::terrain_code> height_to_terrain(1001, grassland);
+	for(int h = 0; h != 1001; ++h) {
+		for(auto i : height_conversion) {
+			if(i.convert_terrain(h)) {
+				height_to_terrain[h] = i.convert_to();
+				break;
+			}
+		}
+	}
+
 	terrain_map terrain(data.width, data.height, grassland);
 	for(std::size_t x = 0; x != heights.size(); ++x) {
 		for(std::size_t y = 0; y != heights[x].size(); ++y) {
-			for(auto i : height_conversion) {
-				if(i.convert_terrain(heights[x][y])) {
-					terrain[x][y] = i.convert_to();
-					break;
-				}
-			}
+			terrain[x][y] = height_to_terrain[heights[x][y]];
 		}
 	}
 
@@ -801,6 +832,7 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 
 	std::map<map_location, std::string> river_names, lake_names, road_names, bridge_names, mountain_names, forest_names, swamp_names;
 
+	start_pass(1);
 	const std::size_t nlakes = data.max_lakes > 0 ? (rng_()%data.max_lakes) : 0;
 	for(std::size_t lake = 0; lake != nlakes; ++lake) {
 		for(int tries = 0; tries != 100; ++tries) {
@@ -885,6 +917,7 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 	 * can use a combination of height and terrain to divide terrain up into
 	 * more interesting types than the default.
 	 */
+	start_pass(2);
 	const height_map temperature_map = generate_height_map(data.width,data.height,
 		cfg["temperature_iterations"].to_int() * data.width * data.height / default_dimensions,
 		cfg["temperature_size"], 0, 0);
@@ -993,6 +1026,7 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 
 	std::set<map_location> bridges;
 
+	start_pass(3);
 	road_path_calculator calc(terrain, cfg, rng_());
 	for(int road = 0; road != nroads; ++road) {
 		lg::scope_logger another_inner_scope_logging_object__(lg::general(), "creating road");
@@ -1173,6 +1207,7 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 	 * we name these now that everything else is placed (as e.g., placing
 	 * roads could split a forest)
 	 */
+	start_pass(4);
 	if(misc_labels != nullptr) {
 		std::set<std::string> used_names;
 		for(int x = data.width / 3; x < (data.width / 3)*2; x++) {
@@ -1235,6 +1270,7 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 	 */
 	std::set<map_location> villages;
 
+	start_pass(5);
 	if(data.nvillages > 0) {
 
 		// First we work out the size of the x and y distance between villages
@@ -1264,6 +1300,19 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 		// If the [village_naming] child is empty, we cannot provide good names.
 		std::map<map_location,std::string>* village_labels = village_naming.empty() ? nullptr : labels;
 
+		// The factory precomputes a generator (and its transition tables) per
+		// feature type, so build it once here rather than once per village.
+		name_generator_factory village_name_generator_factory{ village_naming,
+			{"base", "male", "village", "lake", "river", "bridge", "grassland", "forest", "hill", "mountain", "mountain_anon", "road", "swamp"} };
+
+		village_naming.get_old_attribute("base_names", "male_names", "village_naming");
+		//Due to the attribute detection feature of the factory we also support male_name_generator= but keep it undocumented.
+
+		if(village_labels != nullptr) {
+			base_name_generator = village_name_generator_factory.get_name_generator(
+				(village_naming.has_attribute("base_names") || village_naming.has_attribute("base_name_generator")) ? "base" : "male" );
+		}
+
 		for(int vx = 0; vx < data.width; vx += village_x) {
 			LOG_NG << "village at " << vx << "\n";
 
@@ -1296,15 +1345,6 @@ std::string default_map_generator_job::default_generate_map(generator_data data,
 					continue;
 				}
 
-				name_generator_factory village_name_generator_factory{ village_naming,
-					{"base", "male", "village", "lake", "river", "bridge", "grassland", "forest", "hill", "mountain", "mountain_anon", "road", "swamp"} };
-
-				village_naming.get_old_attribute("base_names", "male_names", "village_naming");
-				//Due to the attribute detection feature of the factory we also support male_name_generator= but keep it undocumented.
-
-				base_name_generator = village_name_generator_factory.get_name_generator(
-					(village_naming.has_attribute("base_names") || village_naming.has_attribute("base_name_generator")) ? "base" : "male" );
-
 				const map_location loc(res.x-data.width/3,res.y-data.height/3);
 				const auto adj = get_adjacent_tiles(loc);
 
@@ -61,6 +61,19 @@ private:
 	bool generate_lake(t_translation::ter_map& terrain, int x, int y, int lake_fall_off, std::set<map_location>& locs_touched);
 	map_location random_point_at_side(std::size_t width, std::size_t height);
 
+	/**
+	 * Reseeds rng_ with the sub-stream for one generation pass.
+	 *
+	 * Each pass (heightmap, lakes and rivers, roads, naming, villages)
+	 * draws from its own stream derived from the master seed and the pass
+	 * number, so how much randomness one pass consumes no longer shifts
+	 * the draws of the passes after it. This keeps maps reproducible from
+	 * a seed while allowing passes to be tuned - or eventually run -
+	 * independently of each other.
+	 */
+	void start_pass(uint32_t pass);
+
+	uint32_t seed_;
 	std::mt19937 rng_;
 	const game_config_view& game_config_;
 
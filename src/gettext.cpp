@@ -129,6 +129,11 @@ int icompare(const std::string& s1, const std::string& s2)
 	return compare(ascii_to_lowercase(s1), ascii_to_lowercase(s2));
 }
 
+std::string icompare_key(const std::string& s)
+{
+	return ascii_to_lowercase(s);
+}
+
 std::string strftime(const std::string& format, const std::tm* time)
 {
 	std::basic_ostringstream<char> dummy;
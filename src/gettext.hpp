@@ -75,6 +75,15 @@ namespace translation
 	/** Case-insensitive lexicographical comparison. */
 	int icompare(const std::string& s1,const std::string& s2);
 
+	/**
+	 * Returns a key that orders like icompare(): comparing two keys with
+	 * compare() gives the same result as icompare() on the original
+	 * strings. When sorting a large list, computing each element's key
+	 * once is much cheaper than lowercasing both operands on every
+	 * comparison.
+	 */
+	std::string icompare_key(const std::string& s);
+
 	std::string strftime(const std::string& format, const std::tm* time);
 
 	bool ci_search(const std::string& s1, const std::string& s2);
@@ -143,6 +143,10 @@ public:
 
 	void set_width(const unsigned width)
 	{
+		if(width == w_) {
+			return;
+		}
+
 		w_ = width;
 		set_is_dirty(true);
 		invalidate_cache();
@@ -155,6 +159,10 @@ public:
 
 	void set_height(const unsigned height)
 	{
+		if(height == h_) {
+			return;
+		}
+
 		h_ = height;
 		set_is_dirty(true);
 		invalidate_cache();
@@ -167,6 +175,13 @@ public:
 
 	void set_variable(const std::string& key, wfl::variant&& value)
 	{
+		// Widgets re-set all their canvas variables on every
+		// update_canvas() call, mostly with unchanged values. Only a real
+		// change may throw the rendered output away.
+		if(variables_.query_value(key) == value) {
+			return;
+		}
+
 		variables_.add(key, std::move(value));
 		set_is_dirty(true);
 		invalidate_cache();
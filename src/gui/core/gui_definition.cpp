@@ -33,6 +33,8 @@ gui_theme_map_t::iterator default_gui = guis.end();
 gui_definition::gui_definition(const config& cfg)
 	: widget_types()
 	, window_types()
+	, widget_configs_()
+	, window_configs_()
 	, id_(cfg["id"])
 	, description_(cfg["description"].t_str())
 	, popup_show_delay_(0)
@@ -56,11 +58,17 @@ gui_definition::gui_definition(const config& cfg)
 	// Widget parsing
 	//
 
-	/** Parse widget definitions of each registered type. */
+	/**
+	 * Index widget definitions of each registered type by id. The WML is
+	 * only stored here; the definition parsers run on first use, since most
+	 * definitions belong to dialogs that are never opened in a session.
+	 */
 	for(auto& widget_type : registered_widget_types()) {
 		const std::string& type_id = widget_type.first;
 
-		gui_definition::widget_definition_map_t& def_map = widget_types[type_id];
+		// Ensure the type is known even if the theme defines nothing for it.
+		widget_types[type_id];
+		auto& cfg_map = widget_configs_[type_id];
 
 		const std::string key =	widget_type.second.key
 			? widget_type.second.key
@@ -69,18 +77,13 @@ gui_definition::gui_definition(const config& cfg)
 		bool found_default_def = false;
 
 		for(const config& definition : cfg.child_range(key)) {
-			// Run the static parser to get a definition ptr.
-			styled_widget_definition_ptr def_ptr = widget_type.second.parser(definition);
-
-			const std::string& def_id = def_ptr->id;
+			const std::string& def_id = definition["id"];
 
-			if(def_map.find(def_id) != def_map.end()) {
+			if(!cfg_map.emplace(def_id, definition).second) {
 				ERR_GUI_P << "Skipping duplicate definition '" << def_id << "' for '" << type_id << "'\n";
 				continue;
 			}
 
-			def_map.emplace(def_id, std::move(def_ptr));
-
 			if(def_id == "default") {
 				found_default_def = true;
 			}
@@ -94,12 +97,12 @@ gui_definition::gui_definition(const config& cfg)
 	}
 
 	//
-	// Window parsing
+	// Window indexing
 	//
 
-	/** Parse each window. */
+	/** Index each window by id; parsed on first use as well. */
 	for(auto& w : cfg.child_range("window")) {
-		window_types.emplace(w["id"], builder_window(w));
+		window_configs_.emplace(w["id"], w);
 	}
 
 	if(id_ == "default") {
@@ -110,7 +113,7 @@ gui_definition::gui_definition(const config& cfg)
 				"Window not defined in WML: '" + window_type + "'."
 				"Perhaps a mismatch between data and source versions. Try --data-dir <trunk-dir>");
 
-			VALIDATE(window_types.find(window_type) != window_types.end(), error_msg);
+			VALIDATE(window_configs_.find(window_type) != window_configs_.end(), error_msg);
 		}
 	}
 
@@ -145,6 +148,79 @@ gui_definition::gui_definition(const config& cfg)
 	VALIDATE(!has_helptip_message_.empty(), missing_mandatory_wml_key("[settings]", "has_helptip_message"));
 }
 
+styled_widget_definition_ptr gui_definition::find_widget(const std::string& type, const std::string& definition_id)
+{
+	auto type_iter = widget_types.find(type);
+	if(type_iter == widget_types.end()) {
+		return nullptr;
+	}
+
+	const auto parsed = type_iter->second.find(definition_id);
+	if(parsed != type_iter->second.end()) {
+		return parsed->second;
+	}
+
+	auto& cfg_map = widget_configs_[type];
+	const auto unparsed = cfg_map.find(definition_id);
+	if(unparsed == cfg_map.end()) {
+		return nullptr;
+	}
+
+	DBG_GUI_P << "Lazily parsing definition '" << definition_id << "' for '" << type << "'\n";
+
+	// Run the static parser to get a definition ptr.
+	styled_widget_definition_ptr def_ptr = registered_widget_types().at(type).parser(unparsed->second);
+	type_iter->second.emplace(definition_id, def_ptr);
+
+	// The WML isn't needed again once the parsed form exists.
+	cfg_map.erase(unparsed);
+
+	return def_ptr;
+}
+
+builder_window* gui_definition::find_window(const std::string& id)
+{
+	auto parsed = window_types.find(id);
+	if(parsed != window_types.end()) {
+		return &parsed->second;
+	}
+
+	const auto unparsed = window_configs_.find(id);
+	if(unparsed == window_configs_.end()) {
+		return nullptr;
+	}
+
+	DBG_GUI_P << "Lazily parsing window '" << id << "'\n";
+
+	parsed = window_types.emplace(id, builder_window(unparsed->second)).first;
+	window_configs_.erase(unparsed);
+
+	return &parsed->second;
+}
+
+bool gui_definition::add_widget_definition(
+		const std::string& widget_type, const std::string& definition_id, const config& cfg)
+{
+	auto parser = registered_widget_types().find(widget_type);
+
+	if(parser == registered_widget_types().end()) {
+		throw std::invalid_argument("widget '" + widget_type + "' doesn't exist");
+	}
+
+	if(widget_types[widget_type].count(definition_id) != 0 || widget_configs_[widget_type].count(definition_id) != 0) {
+		return false;
+	}
+
+	widget_types[widget_type].emplace(definition_id, parser->second.parser(cfg));
+	return true;
+}
+
+void gui_definition::remove_widget_definition(const std::string& widget_type, const std::string& definition_id)
+{
+	widget_types[widget_type].erase(definition_id);
+	widget_configs_[widget_type].erase(definition_id);
+}
+
 void gui_definition::activate() const
 {
 	settings::popup_show_delay = popup_show_delay_;
@@ -202,45 +278,23 @@ const typename TList::value_type& get_best_resolution(const TList& list, const T
 
 resolution_definition_ptr get_control(const std::string& control_type, const std::string& definition)
 {
-	const auto& current_types = current_gui->second.widget_types;
-	const auto& default_types = default_gui->second.widget_types;
-
-	const auto widget_definitions = current_types.find(control_type);
-
-	gui_definition::widget_definition_map_t::const_iterator control;
+	styled_widget_definition_ptr control = current_gui->second.find_widget(control_type, definition);
 
-	if(widget_definitions == current_types.end()) {
-		goto fallback;
+	if(!control && current_gui != default_gui) {
+		control = default_gui->second.find_widget(control_type, definition);
 	}
 
-	control = widget_definitions->second.find(definition);
-
-	if(control == widget_definitions->second.end()) {
-	fallback:
-		bool found_fallback = false;
-
-		if(current_gui != default_gui) {
-			auto default_widget_definitions = default_types.find(control_type);
-
-			VALIDATE(widget_definitions != current_types.end(),
-				formatter() << "Type '" << control_type << "' is unknown.");
-
-			control = default_widget_definitions->second.find(definition);
-			found_fallback = control != default_widget_definitions->second.end();
+	if(!control) {
+		if(definition != "default") {
+			LOG_GUI_G << "Control: type '" << control_type << "' definition '" << definition
+					  << "' not found, falling back to 'default'.\n";
+			return get_control(control_type, "default");
 		}
 
-		if(!found_fallback) {
-			if(definition != "default") {
-				LOG_GUI_G << "Control: type '" << control_type << "' definition '" << definition
-						  << "' not found, falling back to 'default'.\n";
-				return get_control(control_type, "default");
-			}
-
-			FAIL(formatter() << "default definition not found for styled_widget " << control_type);
-		}
+		FAIL(formatter() << "default definition not found for styled_widget " << control_type);
 	}
 
-	const auto& resolutions = (*control->second).resolutions;
+	const auto& resolutions = control->resolutions;
 
 	VALIDATE(!resolutions.empty(),
 		formatter() << "Control: type '" << control_type << "' definition '" << definition << "' has no resolutions.\n");
@@ -257,26 +311,18 @@ const builder_window::window_resolution& get_window_builder(const std::string& t
 {
 	settings::update_screen_size_variables();
 
-	const auto& current_windows = current_gui->second.window_types;
-	const auto& default_windows = default_gui->second.window_types;
-
-	auto iter = current_windows.find(type);
+	builder_window* window = current_gui->second.find_window(type);
 
-	if(iter == current_windows.end()) {
-		// Current GUI is the default one and no window type was found. Throw.
-		if(current_gui == default_gui) {
-			throw window_builder_invalid_id();
-		}
-
-		// Else, try again to find the window, this time in the default GUI.
-		iter = default_windows.find(type);
+	// Not in the current GUI; try again in the default GUI.
+	if(!window && current_gui != default_gui) {
+		window = default_gui->second.find_window(type);
+	}
 
-		if(iter == default_windows.end()) {
-			throw window_builder_invalid_id();
-		}
+	if(!window) {
+		throw window_builder_invalid_id();
 	}
 
-	const auto& resolutions = iter->second.resolutions;
+	const auto& resolutions = window->resolutions;
 
 	VALIDATE(!resolutions.empty(), formatter() << "Window '" << type << "' has no resolutions.\n");
 
@@ -290,29 +336,12 @@ const builder_window::window_resolution& get_window_builder(const std::string& t
 
 bool add_single_widget_definition(const std::string& widget_type, const std::string& definition_id, const config& cfg)
 {
-	auto& def_map = current_gui->second.widget_types[widget_type];
-	auto parser = registered_widget_types().find(widget_type);
-
-	if(parser == registered_widget_types().end()) {
-		throw std::invalid_argument("widget '" + widget_type + "' doesn't exist");
-	}
-
-	if(def_map.find(definition_id) != def_map.end()) {
-		return false;
-	}
-
-	def_map.emplace(definition_id, parser->second.parser(cfg));
-	return true;
+	return current_gui->second.add_widget_definition(widget_type, definition_id, cfg);
 }
 
 void remove_single_widget_definition(const std::string& widget_type, const std::string& definition_id)
 {
-	auto& definition_map = current_gui->second.widget_types[widget_type];
-
-	auto it = definition_map.find(definition_id);
-	if(it != definition_map.end()) {
-		definition_map.erase(it);
-	}
+	current_gui->second.remove_widget_definition(widget_type, definition_id);
 }
 
 } // namespace gui2
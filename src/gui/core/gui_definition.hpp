@@ -51,16 +51,54 @@ public:
 
 	using widget_definition_map_t = std::map<std::string, styled_widget_definition_ptr>;
 
-	/** Map of each widget type, by id, and a sub-map of each of the type's definitions, also by id. */
+	/**
+	 * Map of each widget type, by id, and a sub-map of each of the type's definitions, also by id.
+	 *
+	 * Definitions are parsed on first use; this only holds the ones requested
+	 * so far. Use find_widget() instead of accessing it directly.
+	 */
 	std::map<std::string, widget_definition_map_t> widget_types;
 
-	/** Map of all known windows (the builder class builds a window). */
+	/**
+	 * Map of the windows parsed so far (the builder class builds a window).
+	 *
+	 * Like widget_types, filled lazily; use find_window().
+	 */
 	std::map<std::string, builder_window> window_types;
 
+	/**
+	 * Returns the definition of the given widget type, running the widget
+	 * type's parser on first use.
+	 *
+	 * @returns               The definition, or nullptr if this theme has no
+	 *                        definition with that id for the type.
+	 */
+	styled_widget_definition_ptr find_widget(const std::string& type, const std::string& definition_id);
+
+	/**
+	 * Returns the builder for the given window, parsing the window's WML on
+	 * first use.
+	 *
+	 * @returns               The builder, or nullptr if this theme defines no
+	 *                        window with that id.
+	 */
+	builder_window* find_window(const std::string& id);
+
+	/** Adds a widget definition parsed from @a cfg. Returns false if the id already exists. */
+	bool add_widget_definition(const std::string& widget_type, const std::string& definition_id, const config& cfg);
+
+	void remove_widget_definition(const std::string& widget_type, const std::string& definition_id);
+
 	/** Activates this GUI. */
 	void activate() const;
 
 private:
+	/** Unparsed widget definition WML, by widget type and definition id. */
+	std::map<std::string, std::map<std::string, config>> widget_configs_;
+
+	/** Unparsed [window] WML, by window id. */
+	std::map<std::string, config> window_configs_;
+
 	std::string id_;
 
 	t_string description_;
@@ -19,6 +19,7 @@
 #include "gui/core/linked_group_definition.hpp"
 #include "gui/widgets/grid.hpp"
 #include "color.hpp"
+#include "utils/alloc_tracking.hpp"
 
 #include <functional>
 
@@ -33,6 +34,8 @@ class window;
 struct builder_widget
 {
 public:
+	WESNOTH_TRACK_ALLOCATIONS(SUBSYS_GUI2)
+
 	/**
 	 * The replacements type is used to define replacement types.
 	 *
@@ -20,6 +20,7 @@
 #include "attack_prediction.hpp"
 #include "color.hpp"
 #include "config.hpp"
+#include "events.hpp"
 #include "font/text_formatting.hpp"
 #include "formatter.hpp"
 #include "formula/variant.hpp"
@@ -36,7 +37,9 @@
 #include "units/abilities.hpp"
 #include "units/unit.hpp"
 
+#include <cmath>
 #include <iomanip>
+#include <thread>
 
 namespace gui2::dialogs
 {
@@ -47,9 +50,33 @@ const unsigned int attack_predictions::graph_width = 270;
 const unsigned int attack_predictions::graph_height = 170;
 const unsigned int attack_predictions::graph_max_rows = 10;
 
+/** The fight outcome computed by the worker, owning the stats its combatants reference. */
+struct attack_predictions::simulation_result
+{
+	simulation_result(const battle_context_unit_stats& att, const battle_context_unit_stats& def)
+		: attacker_stats(att)
+		, defender_stats(def)
+		, attacker(attacker_stats)
+		, defender(defender_stats)
+	{
+	}
+
+	void run()
+	{
+		attacker.fight(defender);
+	}
+
+	battle_context_unit_stats attacker_stats;
+	battle_context_unit_stats defender_stats;
+	combatant attacker;
+	combatant defender;
+};
+
 attack_predictions::attack_predictions(battle_context& bc, unit_const_ptr attacker, unit_const_ptr defender)
-	: attacker_data_(attacker, bc.get_attacker_combatant(), bc.get_attacker_stats())
-	, defender_data_(defender, bc.get_defender_combatant(), bc.get_defender_stats())
+	: attacker_data_(attacker, bc.has_simulation() ? &bc.get_attacker_combatant() : nullptr, bc.get_attacker_stats())
+	, defender_data_(defender, bc.has_simulation() ? &bc.get_defender_combatant() : nullptr, bc.get_defender_stats())
+	, simulation_()
+	, simulation_running_()
 {
 }
 
@@ -57,6 +84,46 @@ void attack_predictions::pre_show(window& window)
 {
 	set_data(window, attacker_data_, defender_data_);
 	set_data(window, defender_data_, attacker_data_);
+
+	// If the caller's battle_context hadn't simulated the fight yet, the
+	// fields above show the closed-form estimate; refine them off-thread
+	// instead of stalling the dialog on the full HP matrices.
+	if(!attacker_data_.combatant_) {
+		start_simulation();
+	}
+}
+
+void attack_predictions::start_simulation()
+{
+	// The worker owns copies of the stats and its own combatants; the
+	// caller's battle_context is never touched off the main thread.
+	auto result = std::make_shared<simulation_result>(attacker_data_.stats_, defender_data_.stats_);
+
+	simulation_running_ = std::make_shared<bool>(true);
+	const std::weak_ptr<bool> alive(simulation_running_);
+
+	std::thread([this, result, alive]() {
+		result->run();
+
+		// Hand the outcome back through the events queue; any gui2 loop
+		// picks it up. This also blocks the worker until the main thread
+		// has run the callback, so the captures stay valid.
+		events::call_in_main_thread([this, &result, &alive]() {
+			if(alive.expired()) {
+				// The dialog was dismissed before the fight finished.
+				return;
+			}
+
+			simulation_running_.reset();
+			simulation_ = result;
+			attacker_data_.combatant_ = &simulation_->attacker;
+			defender_data_.combatant_ = &simulation_->defender;
+
+			window& window = *get_window();
+			set_prediction_data(window, attacker_data_, defender_data_);
+			set_prediction_data(window, defender_data_, attacker_data_);
+		});
+	}).detach();
 }
 
 static std::string get_probability_string(const double prob)
@@ -97,15 +164,9 @@ void attack_predictions::set_data(window& window, const combatant_data& attacker
 	// Always visible fields
 	//
 
-	// Unscathed probability
-	const color_t ndc_color = game_config::red_to_green(attacker.combatant_.untouched * 100);
-
-	ss << font::span_color(ndc_color) << get_probability_string(attacker.combatant_.untouched) << "</span>";
-	set_label_helper("chance_unscathed", ss.str());
-
-	// HP probability graph
-	drawing& graph_widget = find_widget<drawing>(&window, get_prefixed_widget_id("hp_graph"), false);
-	draw_hp_graph(graph_widget, attacker, defender);
+	// Unscathed probability and HP probability graph (possibly still the
+	// estimate; see set_prediction_data).
+	set_prediction_data(window, attacker, defender);
 
 	//
 	// Weapon detail fields (only shown if a weapon is present)
@@ -268,7 +329,43 @@ void attack_predictions::set_data(window& window, const combatant_data& attacker
 	set_label_helper("chance_to_hit", ss.str());
 }
 
-void attack_predictions::draw_hp_graph(drawing& hp_graph, const combatant_data& attacker, const combatant_data& defender) const
+void attack_predictions::set_prediction_data(window& window, const combatant_data& attacker, const combatant_data& defender) const
+{
+	const std::string widget_id_prefix = attacker.stats_.is_attacker ? "attacker" : "defender";
+
+	double untouched;
+	hp_probability_vector hp_probs;
+
+	if(attacker.combatant_) {
+		untouched = attacker.combatant_->untouched;
+		hp_probs = get_hitpoint_probabilities(attacker.combatant_->hp_dist);
+	} else {
+		// Chance that every enemy strike misses; swarm and extra combat
+		// rounds (berserk) make the real value differ, which is what the
+		// async refinement corrects.
+		if(defender.stats_.weapon) {
+			untouched = std::pow(1.0 - defender.stats_.chance_to_hit / 100.0, defender.stats_.num_blows);
+		} else {
+			untouched = 1.0;
+		}
+
+		hp_probs = get_estimated_hp_probabilities(attacker, defender);
+	}
+
+	// Unscathed probability
+	std::stringstream ss;
+	const color_t ndc_color = game_config::red_to_green(untouched * 100);
+
+	ss << font::span_color(ndc_color) << get_probability_string(untouched) << "</span>";
+	find_widget<label>(&window, widget_id_prefix + "_chance_unscathed", false).set_label(ss.str());
+
+	// HP probability graph
+	drawing& graph_widget = find_widget<drawing>(&window, widget_id_prefix + "_hp_graph", false);
+	draw_hp_graph(graph_widget, hp_probs, attacker, defender);
+}
+
+void attack_predictions::draw_hp_graph(drawing& hp_graph, const hp_probability_vector& hp_probs,
+	const combatant_data& attacker, const combatant_data& defender) const
 {
 	// Font size. If you change this, you must update the separator space.
 	// TODO: probably should remove this.
@@ -294,7 +391,7 @@ void attack_predictions::draw_hp_graph(drawing& hp_graph, const combatant_data&
 	int i = 0;
 
 	// Draw the rows (lower HP values are at the bottom).
-	for(const auto& probability : get_hitpoint_probabilities(attacker.combatant_.hp_dist)) {
+	for(const auto& probability : hp_probs) {
 
 		// Get the HP and probability.
 		auto [hp, prob] = probability;
@@ -365,7 +462,9 @@ void attack_predictions::draw_hp_graph(drawing& hp_graph, const combatant_data&
 		++i;
 	}
 
-	hp_graph.append_drawing_data(cfg);
+	// Replace (not append) any rows from a previous call, so the refined
+	// distribution can overwrite the estimate.
+	hp_graph.set_drawing_data(cfg);
 }
 
 hp_probability_vector attack_predictions::get_hitpoint_probabilities(const std::vector<double>& hp_dist) const
@@ -398,4 +497,37 @@ hp_probability_vector attack_predictions::get_hitpoint_probabilities(const std::
 	return res;
 }
 
+hp_probability_vector attack_predictions::get_estimated_hp_probabilities(
+	const combatant_data& attacker, const combatant_data& defender) const
+{
+	const int hp = attacker.stats_.hp;
+
+	std::vector<double> hp_dist(attacker.stats_.max_hp + 1, 0.0);
+
+	if(!defender.stats_.weapon || defender.stats_.num_blows <= 0) {
+		hp_dist[hp] = 1.0;
+		return get_hitpoint_probabilities(hp_dist);
+	}
+
+	const double p = defender.stats_.chance_to_hit / 100.0;
+	const int blows = defender.stats_.num_blows;
+	const int damage = defender.stats_.damage;
+
+	if(p >= 1.0) {
+		// Every strike lands.
+		hp_dist[std::max(0, hp - blows * damage)] = 1.0;
+		return get_hitpoint_probabilities(hp_dist);
+	}
+
+	// Binomial distribution over the number of hits taken, computed
+	// iteratively: P(k+1) = P(k) * (n-k)/(k+1) * p/(1-p).
+	double p_k = std::pow(1.0 - p, blows);
+	for(int k = 0; k <= blows; ++k) {
+		hp_dist[std::max(0, hp - k * damage)] += p_k;
+		p_k *= static_cast<double>(blows - k) / (k + 1) * p / (1.0 - p);
+	}
+
+	return get_hitpoint_probabilities(hp_dist);
+}
+
 } // namespace dialogs
@@ -19,6 +19,8 @@
 #include "gui/dialogs/modal_dialog.hpp"
 #include "units/ptr.hpp"
 
+#include <memory>
+
 class battle_context;
 
 struct battle_context_unit_stats;
@@ -46,30 +48,63 @@ private:
 
 	struct combatant_data
 	{
-		combatant_data(unit_const_ptr unit, const combatant& combatant, const battle_context_unit_stats& stats)
+		combatant_data(unit_const_ptr unit, const combatant* combatant, const battle_context_unit_stats& stats)
 			: stats_(stats)
 			, combatant_(combatant)
 			, unit_(unit)
 		{}
 
 		const battle_context_unit_stats& stats_;
-		const combatant& combatant_;
+		/** Full simulation outcome; null until the async refinement arrives. */
+		const combatant* combatant_;
 		/** never null */
 		unit_const_ptr unit_;
 	};
 
 	void set_data(window& window, const combatant_data& attacker, const combatant_data& defender) const;
 
+	/**
+	 * Sets the widgets that depend on the simulated fight outcome: the
+	 * unscathed probability and the HP distribution graph. While the full
+	 * simulation is still pending these show a closed-form estimate; the
+	 * async refinement calls this again to replace it.
+	 */
+	void set_prediction_data(window& window, const combatant_data& attacker, const combatant_data& defender) const;
+
+	/**
+	 * Runs the full fight simulation on a worker thread and refreshes the
+	 * prediction widgets on the main thread once it finishes, so the dialog
+	 * opens without waiting on the big HP matrices of high-HP/berserk fights.
+	 */
+	void start_simulation();
+
 	hp_probability_vector get_hitpoint_probabilities(const std::vector<double>& hp_dist) const;
 
+	/**
+	 * Closed-form stand-in for a combatant's HP distribution: a single
+	 * binomial pass over the opponent's strikes, ignoring swarm, drain and
+	 * extra combat rounds.
+	 */
+	hp_probability_vector get_estimated_hp_probabilities(
+		const combatant_data& attacker, const combatant_data& defender) const;
+
 	static const unsigned int graph_width;
 	static const unsigned int graph_height;
 	static const unsigned int graph_max_rows;
 
-	void draw_hp_graph(drawing& hp_graph, const combatant_data& attacker, const combatant_data& defender) const;
+	void draw_hp_graph(drawing& hp_graph, const hp_probability_vector& hp_probs,
+		const combatant_data& attacker, const combatant_data& defender) const;
 
 	combatant_data attacker_data_;
 	combatant_data defender_data_;
+
+	struct simulation_result;
+
+	/** Owns the async simulation outcome and the stats its combatants reference. */
+	std::shared_ptr<simulation_result> simulation_;
+
+	/** Liveness token for the async refinement (see start_simulation()). */
+	std::shared_ptr<bool> simulation_running_;
 };
 
 } // namespace dialogs
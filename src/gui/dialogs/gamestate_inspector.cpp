@@ -245,12 +245,25 @@ public:
 class event_mode_controller : public single_mode_controller
 {
 public:
-	event_mode_controller(gamestate_inspector::controller& c);
+	event_mode_controller(gamestate_inspector::controller& c)
+		: single_mode_controller(c)
+		, events_written_(false)
+	{
+	}
+
 	void show_list(tree_view_node& node, bool is_wmi);
 	void show_event(tree_view_node& node, bool is_wmi);
 
 private:
+	/**
+	 * Serializes the event handlers on first use. Doing this in the
+	 * constructor would stringify every event while the dialog is opening,
+	 * before the user has even clicked on the events node.
+	 */
+	const config& get_events();
+
 	config events;
+	bool events_written_;
 };
 
 class unit_mode_controller : public single_mode_controller
@@ -486,10 +499,13 @@ const display_context& single_mode_controller::dc() const {
 	return c.dc_;
 }
 
-event_mode_controller::event_mode_controller(gamestate_inspector::controller& c)
-	: single_mode_controller(c)
+const config& event_mode_controller::get_events()
 {
-	single_mode_controller::events().write_events(events);
+	if(!events_written_) {
+		single_mode_controller::events().write_events(events);
+		events_written_ = true;
+	}
+	return events;
 }
 
 void variable_mode_controller::show_list(tree_view_node& node)
@@ -554,7 +570,7 @@ void event_mode_controller::show_list(tree_view_node& node, bool is_wmi)
 		return;
 	}
 
-	for(const auto & cfg : events.child_range(is_wmi ? "menu_item" : "event"))
+	for(const auto & cfg : get_events().child_range(is_wmi ? "menu_item" : "event"))
 	{
 		std::string name = is_wmi ? cfg["id"] : cfg["name"];
 		bool named_event = !is_wmi && !cfg["id"].empty();
@@ -577,7 +593,7 @@ void event_mode_controller::show_list(tree_view_node& node, bool is_wmi)
 void event_mode_controller::show_event(tree_view_node& node, bool is_wmi)
 {
 	int n = node.describe_path().back();
-	model().set_data(config_to_string(events.child(is_wmi ? "menu_item" : "event", n)));
+	model().set_data(config_to_string(get_events().child(is_wmi ? "menu_item" : "event", n)));
 }
 
 static stuff_list_adder add_unit_entry(stuff_list_adder& progress, const unit& u, const display_context& dc)
@@ -45,6 +45,7 @@ screenshot_notification::screenshot_notification(const std::string& path, surfac
 	: path_(path)
 	, screenshots_dir_path_(filesystem::get_screenshot_dir())
 	, screenshot_(screenshot)
+	, save_pending_()
 {
 }
 
@@ -87,6 +88,10 @@ void screenshot_notification::pre_show(window& window)
 
 void screenshot_notification::save_screenshot()
 {
+	if(save_pending_) {
+		return;
+	}
+
 	text_box& path_box = find_widget<text_box>(get_window(), "path", false);
 	std::string filename = path_box.get_value();
 	bfs::path path(screenshots_dir_path_);
@@ -94,7 +99,33 @@ void screenshot_notification::save_screenshot()
 
 	path_ = path.string();
 
-	image::save_result res = image::save_image(screenshot_, path.string());
+	// Encoding a 4K screenshot takes long enough to freeze the UI, so hand
+	// it to a worker; the dialog keeps pumping events meanwhile. Lock the
+	// save controls until the result comes back.
+	path_box.set_active(false);
+	find_widget<button>(get_window(), "save", false).set_active(false);
+
+	save_pending_ = std::make_shared<bool>(true);
+	const std::weak_ptr<bool> alive(save_pending_);
+
+	image::save_image_async(screenshot_, path.string(), [this, alive](image::save_result res) {
+		if(alive.expired()) {
+			// The dialog was dismissed; the file was still written.
+			return;
+		}
+		save_pending_.reset();
+		save_finished(res);
+	});
+}
+
+void screenshot_notification::save_finished(image::save_result res)
+{
+	if(res != image::save_result::success) {
+		// Give the controls back so the user can retry with another name.
+		find_widget<text_box>(get_window(), "path", false).set_active(true);
+		find_widget<button>(get_window(), "save", false).set_active(true);
+	}
+
 	if(res == image::save_result::unsupported_format) {
 		gui2::show_error_message(_("Unsupported image format.\n\n"
 			"Try to save the screenshot as PNG instead."));
@@ -105,9 +136,8 @@ void screenshot_notification::save_screenshot()
 	} else if(res != image::save_result::success) {
 		throw std::logic_error("Unexpected error while trying to save a screenshot");
 	} else {
-		path_box.set_active(false);
+		// The path box and save button stay locked.
 		find_widget<button>(get_window(), "open", false).set_active(true);
-		find_widget<button>(get_window(), "save", false).set_active(false);
 
 		if(desktop::clipboard::available()) {
 			find_widget<button>(get_window(), "copy", false).set_active(true);
@@ -18,6 +18,13 @@
 #include "gui/dialogs/modal_dialog.hpp"
 #include "sdl/surface.hpp"
 
+#include <memory>
+
+namespace image
+{
+enum class save_result;
+}
+
 namespace gui2::dialogs
 {
 
@@ -56,7 +63,16 @@ private:
 	const std::string screenshots_dir_path_;
 	surface screenshot_;
 
+	/**
+	 * Non-null while a save is running on the worker thread. Doubles as a
+	 * liveness token: the completion callback holds a weak_ptr to it, so a
+	 * save that outlives the dialog finishes writing but skips the widget
+	 * updates.
+	 */
+	std::shared_ptr<bool> save_pending_;
+
 	void save_screenshot();
+	void save_finished(image::save_result res);
 	void keypress_callback(bool& handled, const SDL_Keycode key);
 
 	virtual const std::string& window_id() const override;
@@ -18,6 +18,7 @@
 #include "gui/widgets/generator_private.hpp"
 
 #include "gui/widgets/window.hpp"
+#include "sdl/rect.hpp"
 #include "wml_exception.hpp"
 
 #include <numeric>
@@ -212,6 +213,12 @@ widget* horizontal_list::find_at(const point& coordinate, const bool must_be_act
 			continue;
 		}
 
+		// Drop rows that can't contain the point without walking their
+		// widgets; with thousands of rows the recursion dominates hit tests.
+		if(!sdl::point_in_rect(coordinate, item(i).get_rectangle())) {
+			continue;
+		}
+
 		widget* widget = item(i).find_at(coordinate, must_be_active);
 
 		if(widget) {
@@ -231,6 +238,10 @@ const widget* horizontal_list::find_at(const point& coordinate, const bool must_
 			continue;
 		}
 
+		if(!sdl::point_in_rect(coordinate, item(i).get_rectangle())) {
+			continue;
+		}
+
 		const widget* widget = item(i).find_at(coordinate, must_be_active);
 
 		if(widget) {
@@ -423,6 +434,10 @@ widget* vertical_list::find_at(const point& coordinate, const bool must_be_activ
 			continue;
 		}
 
+		if(!sdl::point_in_rect(coordinate, item(i).get_rectangle())) {
+			continue;
+		}
+
 		widget* widget = item(i).find_at(coordinate, must_be_active);
 
 		if(widget) {
@@ -441,6 +456,10 @@ const widget* vertical_list::find_at(const point& coordinate, const bool must_be
 			continue;
 		}
 
+		if(!sdl::point_in_rect(coordinate, item(i).get_rectangle())) {
+			continue;
+		}
+
 		const widget* widget = item(i).find_at(coordinate, must_be_active);
 
 		if(widget) {
@@ -715,6 +734,10 @@ widget* table::find_at(const point& coordinate, const bool must_be_active)
 			continue;
 		}
 
+		if(!sdl::point_in_rect(coordinate, item(i).get_rectangle())) {
+			continue;
+		}
+
 		widget* widget = item(i).find_at(coordinate, must_be_active);
 
 		if(widget) {
@@ -733,6 +756,10 @@ const widget* table::find_at(const point& coordinate, const bool must_be_active)
 			continue;
 		}
 
+		if(!sdl::point_in_rect(coordinate, item(i).get_rectangle())) {
+			continue;
+		}
+
 		const widget* widget = item(i).find_at(coordinate, must_be_active);
 
 		if(widget) {
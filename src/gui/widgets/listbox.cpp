@@ -61,6 +61,7 @@ listbox::listbox(const implementation::builder_styled_widget& builder,
 	, list_builder_(list_builder)
 	, need_layout_(false)
 	, orders_()
+	, sort_key_caches_()
 	, callback_order_change_()
 {
 }
@@ -70,6 +71,7 @@ grid& listbox::add_row(const string_map& item, const int index)
 	assert(generator_);
 	grid& row = generator_->create_item(index, *list_builder_, item, std::bind(&listbox::list_item_clicked, this, std::placeholders::_1));
 
+	invalidate_sort_key_caches();
 	resize_content(row);
 
 	return row;
@@ -80,6 +82,7 @@ grid& listbox::add_row(const std::map<std::string /* widget id */, string_map>&
 	assert(generator_);
 	grid& row = generator_->create_item(index, *list_builder_, data, std::bind(&listbox::list_item_clicked, this, std::placeholders::_1));
 
+	invalidate_sort_key_caches();
 	resize_content(row);
 
 	return row;
@@ -117,6 +120,8 @@ void listbox::remove_row(const unsigned row, unsigned count)
 		generator_->delete_item(row);
 	}
 
+	invalidate_sort_key_caches();
+
 	if((height_reduced != 0 || width_reduced != 0) && get_item_count() != 0) {
 		resize_content(-width_reduced, -height_reduced, row_pos_x, row_pos_y);
 	} else {
@@ -127,6 +132,7 @@ void listbox::remove_row(const unsigned row, unsigned count)
 void listbox::clear()
 {
 	generator_->clear();
+	invalidate_sort_key_caches();
 	update_content_size();
 }
 
@@ -636,10 +642,33 @@ void listbox::set_column_order(unsigned col, const generator_sort_array& func)
 
 void listbox::register_translatable_sorting_option(const int col, translatable_sorter_func_t f)
 {
+	// Sorting through icompare() lowercases both operands on every
+	// comparison, which gets expensive on big lists. Compute each row's
+	// key once and compare the keys instead.
+	auto keys = std::make_shared<std::map<int, std::string>>();
+
+	const auto key = [f, keys](int row) -> const std::string& {
+		auto iter = keys->find(row);
+		if(iter == keys->end()) {
+			iter = keys->emplace(row, translation::icompare_key(f(row))).first;
+		}
+
+		return iter->second;
+	};
+
 	set_column_order(col, {{
-		[f](int lhs, int rhs) { return translation::icompare(f(lhs), f(rhs)) < 0; },
-		[f](int lhs, int rhs) { return translation::icompare(f(lhs), f(rhs)) > 0; }
+		[key](int lhs, int rhs) { return key(lhs) < key(rhs); },
+		[key](int lhs, int rhs) { return key(lhs) > key(rhs); }
 	}});
+
+	sort_key_caches_.push_back(std::move(keys));
+}
+
+void listbox::invalidate_sort_key_caches()
+{
+	for(auto& cache : sort_key_caches_) {
+		cache->clear();
+	}
 }
 
 void listbox::set_active_sorting_option(const order_pair& sort_by, const bool select_first)
@@ -375,6 +375,17 @@ private:
 	typedef std::vector<std::pair<selectable_item*, generator_sort_array>> torder_list;
 	torder_list orders_;
 
+	/**
+	 * Cached per-row sort keys of the translatable sorting options.
+	 *
+	 * The keys are indexed by row number, so the caches are dropped
+	 * whenever rows are added or removed.
+	 */
+	std::vector<std::shared_ptr<std::map<int, std::string>>> sort_key_caches_;
+
+	/** Drops all cached translatable sort keys. */
+	void invalidate_sort_key_caches();
+
 	std::function<void(unsigned, preferences::SORT_ORDER)> callback_order_change_;
 
 	/**
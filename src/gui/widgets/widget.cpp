@@ -37,6 +37,7 @@ widget::widget()
 	, width_(0)
 	, height_(0)
 	, layout_size_()
+	, cached_best_size_()
 #ifdef DEBUG_WINDOW_LAYOUT_GRAPHS
 	, last_best_size_()
 #endif
@@ -60,6 +61,7 @@ widget::widget(const builder_widget& builder)
 	, width_(0)
 	, height_(0)
 	, layout_size_()
+	, cached_best_size_()
 #ifdef DEBUG_WINDOW_LAYOUT_GRAPHS
 	, last_best_size_()
 #endif
@@ -170,6 +172,7 @@ void widget::layout_initialize(const bool /*full_initialization*/)
 	assert(get_window());
 
 	layout_size_ = point();
+	cached_best_size_ = point();
 	if(!linked_group_.empty()) {
 		get_window()->add_linked_widget(linked_group_, this);
 	}
@@ -196,7 +199,11 @@ point widget::get_best_size() const
 
 	point result = layout_size_;
 	if(result == point()) {
-		result = calculate_best_size();
+		if(cached_best_size_ == point()) {
+			cached_best_size_ = calculate_best_size();
+		}
+
+		result = cached_best_size_;
 		//Adjust to linked widget size if linked widget size was already calculated.
 		if(!get_window()->get_need_layout() && !linked_group_.empty())
 		{
@@ -334,6 +341,13 @@ unsigned widget::get_height() const
 
 void widget::set_layout_size(const point& size)
 {
+	// The best size of a container depends on those of its children, so a
+	// size change also invalidates the memoized best sizes up the parent
+	// chain; siblings keep theirs.
+	for(widget* w = this; w != nullptr; w = w->parent_) {
+		w->cached_best_size_ = point();
+	}
+
 	layout_size_ = size;
 }
 
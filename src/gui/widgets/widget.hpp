@@ -489,6 +489,20 @@ private:
 	 */
 	point layout_size_;
 
+	/**
+	 * Memoized result of calculate_best_size().
+	 *
+	 * During a layout phase the best size of the same subtree is queried
+	 * several times, and for containers every query recurses into all
+	 * children. This caches the result between queries; it is thrown away
+	 * by layout_initialize() at the start of every layout phase and by
+	 * set_layout_size() for the widget and its ancestors, so only the
+	 * changed subtree is recalculated.
+	 *
+	 * If (0,0), no size is cached.
+	 */
+	mutable point cached_best_size_;
+
 #ifdef DEBUG_WINDOW_LAYOUT_GRAPHS
 
 	/**
@@ -67,6 +67,9 @@ private:
 	surface surf_, buffer_;
 	SDL_Rect rect_;
 
+	/** The zoom level rect_'s dimensions were rendered at, see render(). */
+	int rendered_hex_size_;
+
 	/** The location of the center of the halo. */
 	map_location loc_;
 
@@ -131,7 +134,7 @@ void remove(int handle);
  * internal state in the control sets (in halo.cpp).
  */
 void unrender(std::set<map_location> invalidated_locations);
-void render();
+bool render();
 
 }; //end halo_impl
 
@@ -144,6 +147,7 @@ halo_impl::effect::effect(display * screen, int xpos, int ypos, const animated<i
 	surf_(nullptr),
 	buffer_(nullptr),
 	rect_(sdl::empty_rect),
+	rendered_hex_size_(0),
 	loc_(loc),
 	overlayed_hexes_(),
 	disp(screen)
@@ -192,6 +196,24 @@ bool halo_impl::effect::render()
 	}
 
 	images_.update_last_draw_time();
+
+	// Cull off-screen haloes before fetching and orienting this frame's
+	// image. The frames of a halo animation share their dimensions, so the
+	// previously rendered rect is a reliable bound as long as the zoom
+	// level didn't change in between.
+	if(rect_.w > 0 && rendered_hex_size_ == disp->hex_size()) {
+		const SDL_Rect last_rect {
+			x_ + disp->get_location_x(map_location::ZERO()) - rect_.w / 2,
+			y_ + disp->get_location_y(map_location::ZERO()) - rect_.h / 2,
+			rect_.w, rect_.h
+		};
+
+		if(sdl::rects_overlap(last_rect, disp->map_outside_area()) == false) {
+			buffer_ = nullptr;
+			return false;
+		}
+	}
+
 	surf_ = image::get_image(current_image(),image::SCALED_TO_ZOOM);
 	if(surf_ == nullptr) {
 		return false;
@@ -211,6 +233,7 @@ bool halo_impl::effect::render()
 
 	SDL_Rect rect {xpos, ypos, surf_->w, surf_->h};
 	rect_ = rect;
+	rendered_hex_size_ = disp->hex_size();
 	SDL_Rect clip_rect = disp->map_outside_area();
 
 	// If rendered the first time, need to determine the area affected.
@@ -428,11 +451,11 @@ void halo_impl::unrender(std::set<map_location> invalidated_locations)
 	deleted_haloes.clear();
 }
 
-void halo_impl::render()
+bool halo_impl::render()
 {
 	if(haloes.empty() ||
 			invalidated_haloes.empty()) {
-		return;
+		return false;
 	}
 
 	// Render the haloes: draw all invalidated haloes
@@ -441,6 +464,7 @@ void halo_impl::render()
 	}
 
 	invalidated_haloes.clear();
+	return true;
 }
 
 // end halo_impl implementations
@@ -481,9 +505,9 @@ void manager::unrender(std::set<map_location> invalidated_locations)
 	impl_->unrender(invalidated_locations);
 }
 
-void manager::render()
+bool manager::render()
 {
-	impl_->render();
+	return impl_->render();
 }
 
 // end halo::manager implementation
@@ -63,9 +63,11 @@ public:
 	 *
 	 * Which haloes are rendered is determined by invalidated_locations and the
 	 * internal state in the control sets (in halo.cpp).
+	 *
+	 * @returns whether any halo was actually (re)drawn to the screen.
 	 */
 	void unrender(std::set<map_location> invalidated_locations);
-	void render();
+	bool render();
 
 private:
 	std::shared_ptr<halo_impl> impl_;
@@ -1465,6 +1465,24 @@ void generate_contents()
 			// can be referenced later on when showing help about
 			// specified things, but that should not be shown when
 			// opening the help browser in the default manner.
+			// Gather every referenced id in one scan, instead of rescanning
+			// all [section] tags for each candidate id below.
+			std::set<std::string> referenced_sections, referenced_topics;
+			const auto add_references = [&](const config &cfg) {
+				for (const std::string &s : utils::quoted_split(cfg["sections"])) {
+					referenced_sections.insert(s);
+				}
+				for (const std::string &t : utils::quoted_split(cfg["topics"])) {
+					referenced_topics.insert(t);
+				}
+			};
+			if (const config &toplevel = help_config->child("toplevel")) {
+				add_references(toplevel);
+			}
+			for (const config &section : help_config->child_range("section")) {
+				add_references(section);
+			}
+
 			config hidden_toplevel;
 			std::stringstream ss;
 			for (const config &section : help_config->child_range("section"))
@@ -1474,7 +1492,7 @@ void generate_contents()
 					// This section does not exist referenced from the
 					// toplevel. Hence, add it to the hidden ones if it
 					// is not referenced from another section.
-					if (!section_is_referenced(id, *help_config)) {
+					if (referenced_sections.count(id) == 0) {
 						if (!ss.str().empty()) {
 							ss << ",";
 						}
@@ -1488,7 +1506,7 @@ void generate_contents()
 			{
 				const std::string id = topic["id"];
 				if (find_topic(default_toplevel, id) == nullptr) {
-					if (!topic_is_referenced(id, *help_config)) {
+					if (referenced_topics.count(id) == 0) {
 						if (!ss.str().empty()) {
 							ss << ",";
 						}
@@ -1497,11 +1515,10 @@ void generate_contents()
 				}
 			}
 			hidden_toplevel["topics"] = ss.str();
-			config hidden_cfg = *help_config;
-			// Change the toplevel to our new, custom built one.
-			hidden_cfg.clear_children("toplevel");
-			hidden_cfg.add_child("toplevel", std::move(hidden_toplevel));
-			hidden_sections = parse_config(&hidden_cfg);
+			// Parse the hidden sections against the original help config with
+			// our custom toplevel; building a modified copy of the config
+			// just to replace its [toplevel] would deep-copy every topic.
+			parse_config_internal(help_config, &hidden_toplevel, hidden_sections);
 		}
 		catch (parse_error& e) {
 			std::stringstream msg;
@@ -358,11 +358,12 @@ bool is_scope_active(hk_scopes s)
 
 const hotkey_command& get_hotkey_command(const std::string& command)
 {
-	if(command_map_.find(command) == command_map_.end()) {
+	const auto itor = command_map_.find(command);
+	if(itor == command_map_.end()) {
 		return get_hotkey_null();
 	}
 
-	return known_hotkeys[command_map_[command]];
+	return known_hotkeys[itor->second];
 }
 
 const std::vector<hotkey_command>& get_hotkey_commands()
@@ -124,12 +124,19 @@ bool hotkey_base::bindings_equal(hotkey_ptr other)
 
 bool hotkey_base::matches(const SDL_Event &event) const
 {
-	if (!hotkey::is_scope_active(hotkey::get_hotkey_command(get_command()).scope) ||
-			!active() || is_disabled()) {
+	if (!active() || is_disabled()) {
 		return false;
 	}
 
-	return matches_helper(event);
+	// Look the command up once and hand it down to the helper, so checking
+	// an event against the whole hotkey list doesn't hash each command
+	// string a second time for the helper's own needs.
+	const hotkey_command& command = hotkey::get_hotkey_command(get_command());
+	if (!hotkey::is_scope_active(command.scope)) {
+		return false;
+	}
+
+	return matches_helper(event, command);
 }
 
 void hotkey_base::save(config& item) const
@@ -245,7 +252,7 @@ hotkey_ptr load_from_config(const config& cfg)
 	return base;
 }
 
-bool hotkey_mouse::matches_helper(const SDL_Event &event) const
+bool hotkey_mouse::matches_helper(const SDL_Event &event, const hotkey_command&) const
 {
 	if (event.type != SDL_MOUSEBUTTONUP
 		&& event.type != SDL_MOUSEBUTTONDOWN
@@ -284,10 +291,9 @@ const std::string hotkey_keyboard::get_name_helper() const
 	return text_;
 }
 
-bool hotkey_keyboard::matches_helper(const SDL_Event &event) const
+bool hotkey_keyboard::matches_helper(const SDL_Event &event, const hotkey_command& command) const
 {
 	unsigned int mods = sdl_get_mods();
-	const hotkey_command& command = get_hotkey_command(get_command());
 
 	if ((event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) &&
 			(mods & KMOD_CTRL || mods & KMOD_ALT || mods & KMOD_GUI ||
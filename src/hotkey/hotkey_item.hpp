@@ -30,6 +30,7 @@ namespace hotkey {
 class hotkey_base;
 class hotkey_mouse;
 class hotkey_keyboard;
+struct hotkey_command;
 typedef std::shared_ptr<hotkey_base> hotkey_ptr;
 typedef std::shared_ptr<hotkey_mouse> hotkey_mouse_ptr;
 typedef std::shared_ptr<hotkey_keyboard> hotkey_keyboard_ptr;
@@ -195,9 +196,12 @@ protected:
 	 * This is invoked by hotkey_base::matches as a helper for the concrete classes.
 	 * Implementing classes should only check their parts of the hotkey.
 	 * @param event The SDL_Event being generated.
+	 * @param command The hotkey_command this hotkey is bound to, already
+	 * looked up by the caller so that matching an event against the whole
+	 * hotkey list does one command lookup per hotkey instead of several.
 	 * @returns true if they match, false otherwise.
 	 */
-	virtual bool matches_helper(const SDL_Event &event) const = 0;
+	virtual bool matches_helper(const SDL_Event &event, const hotkey_command& command) const = 0;
 	virtual void save_helper(config& cfg) const = 0;
 	/**
 	 * This is invoked by hotkey_base::bindings_equal as a helper for the concrete classes.
@@ -274,7 +278,7 @@ protected:
 
 	virtual void save_helper(config& cfg) const;
 	virtual const std::string get_name_helper() const;
-	virtual bool matches_helper(const SDL_Event &event) const;
+	virtual bool matches_helper(const SDL_Event &event, const hotkey_command& command) const;
 	virtual bool bindings_equal_helper (hotkey_ptr other) const;
 };
 
@@ -298,7 +302,7 @@ protected:
 	{
 		return "";
 	}
-	virtual bool matches_helper(const SDL_Event&) const
+	virtual bool matches_helper(const SDL_Event&, const hotkey_command&) const
 	{
 		return false;
 	}
@@ -339,7 +343,7 @@ protected:
 
 	virtual void save_helper(config& cfg) const;
 	virtual const std::string get_name_helper() const;
-	virtual bool matches_helper(const SDL_Event &event) const;
+	virtual bool matches_helper(const SDL_Event &event, const hotkey_command& command) const;
 	virtual bool bindings_equal_helper (hotkey_ptr other) const;
 };
 
@@ -0,0 +1,79 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "image_atlas.hpp"
+
+#include "sdl/rect.hpp"
+
+#include <algorithm>
+
+namespace image {
+
+surface_atlas::surface_atlas(int page_size)
+	: page_size_(page_size)
+	, pages_()
+	, x_(0)
+	, y_(0)
+	, shelf_height_(0)
+{
+}
+
+atlas_region surface_atlas::insert(const surface& surf)
+{
+	if(!surf) {
+		return atlas_region();
+	}
+
+	// Oversized images would waste most of a page; hand them back unpacked.
+	if(surf->w > page_size_ || surf->h > page_size_) {
+		return atlas_region{surf, sdl::create_rect(0, 0, surf->w, surf->h)};
+	}
+
+	if(pages_.empty() || x_ + surf->w > page_size_ || y_ + surf->h > page_size_) {
+		// Open a new shelf, and a new page if this one has no room left.
+		y_ += shelf_height_;
+		x_ = 0;
+		shelf_height_ = 0;
+
+		if(pages_.empty() || y_ + surf->h > page_size_) {
+			pages_.emplace_back(page_size_, page_size_);
+			y_ = 0;
+		}
+	}
+
+	surface& page = pages_.back();
+	const atlas_region region{page, sdl::create_rect(x_, y_, surf->w, surf->h)};
+
+	// A regular blit would blend the image with the (transparent) page;
+	// copy the pixels verbatim instead, alpha channel included.
+	SDL_Rect dst = region.rect;
+	SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_NONE);
+	SDL_BlitSurface(surf, nullptr, page, &dst);
+	SDL_SetSurfaceBlendMode(surf, SDL_BLENDMODE_BLEND);
+
+	x_ += surf->w;
+	shelf_height_ = std::max(shelf_height_, surf->h);
+
+	return region;
+}
+
+void surface_atlas::clear()
+{
+	pages_.clear();
+	x_ = 0;
+	y_ = 0;
+	shelf_height_ = 0;
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include "sdl/surface.hpp"
+
+#include <vector>
+
+namespace image {
+
+/**
+ * A sub-rectangle of a shared atlas page.
+ *
+ * Since surfaces are reference counted a region keeps its page alive, so it
+ * stays usable even after the atlas it came from has been cleared (it just
+ * won't share pixels with regions handed out after the clear).
+ */
+struct atlas_region
+{
+	/**
+	 * The page holding the pixels, or the image's own surface if it was too
+	 * large to pack.
+	 */
+	surface page;
+
+	/** The area of @ref page occupied by the image. */
+	SDL_Rect rect {0, 0, 0, 0};
+
+	/** Returns @a true if the region refers to an actual image. */
+	bool valid() const { return page && rect.w > 0 && rect.h > 0; }
+};
+
+/**
+ * Packs small surfaces into shared fixed-size pages.
+ *
+ * The packer is a plain shelf allocator: images are placed left to right on
+ * the current shelf, a new shelf is opened below it when it is full, and a new
+ * page when the page is full. That wastes some space when image heights vary
+ * wildly, but the terrain tiles this is meant for are all hex-sized, where a
+ * shelf packs almost perfectly.
+ *
+ * Images wider or taller than a page are not packed; they are returned as a
+ * region covering their own surface.
+ */
+class surface_atlas
+{
+public:
+	explicit surface_atlas(int page_size);
+
+	/**
+	 * Copies @a surf into an atlas page and returns the occupied region.
+	 *
+	 * @param surf               The image to pack; returns an invalid region
+	 *                           if null.
+	 */
+	atlas_region insert(const surface& surf);
+
+	/** Releases all pages and starts packing from scratch. */
+	void clear();
+
+	std::size_t page_count() const { return pages_.size(); }
+
+private:
+	int page_size_;
+	std::vector<surface> pages_;
+
+	/** Position of the next free spot on the current shelf. */
+	int x_, y_;
+	/** Height of the tallest image on the current shelf. */
+	int shelf_height_;
+};
+
+}
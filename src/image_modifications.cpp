@@ -27,6 +27,8 @@
 #include "formula/formula.hpp"
 #include "formula/callable.hpp"
 
+#include <unordered_map>
+
 #define GETTEXT_DOMAIN "wesnoth-lib"
 
 static lg::log_domain log_display("display");
@@ -114,6 +116,16 @@ modification* decode_modification(const std::string& encoded_mod)
 	return mod_parsers[mod_type](args);
 }
 
+/** Decoded modification chains, keyed by the encoded ~MOD chain string.
+ *
+ * Identical chains are shared by many locators (every unit with the same
+ * team coloring, for instance), so memoizing the decode step saves
+ * re-tokenizing the string each time a locator is resolved. Copying a
+ * queue out of the cache only copies shared_ptrs; the modification
+ * objects themselves are immutable once parsed.
+ */
+std::unordered_map<std::string, modification_queue> decoded_chains;
+
 } // end anon namespace
 
 
@@ -138,6 +150,11 @@ modification::imod_exception::imod_exception(const std::string& message)
  */
 modification_queue modification::decode(const std::string& encoded_mods)
 {
+	auto cached = decoded_chains.find(encoded_mods);
+	if(cached != decoded_chains.end()) {
+		return cached->second;
+	}
+
 	modification_queue mods;
 
 	for(const std::string& encoded_mod : utils::parenthetical_split(encoded_mods, '~')) {
@@ -148,9 +165,15 @@ modification_queue modification::decode(const std::string& encoded_mods)
 		}
 	}
 
+	decoded_chains.emplace(encoded_mods, mods);
 	return mods;
 }
 
+void modification::flush_decode_cache()
+{
+	decoded_chains.clear();
+}
+
 surface rc_modification::operator()(const surface& src) const
 {
 	// unchecked
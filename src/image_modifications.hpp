@@ -99,6 +99,14 @@ public:
 	/** Decodes modifications from a modification string */
 	static modification_queue decode(const std::string&);
 
+	/**
+	 * Drops all cached decoded modification chains.
+	 *
+	 * Needed when the game config is reloaded, since some modifications
+	 * (e.g. ~TC()) bake config-dependent data in at decode time.
+	 */
+	static void flush_decode_cache();
+
 	virtual ~modification() {}
 
 	/** Applies the image-path modification on the specified surface */
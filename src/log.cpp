@@ -22,11 +22,16 @@
 
 #include "log.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <sstream>
 #include <ctime>
 #include <mutex>
 #include <iomanip>
+#include <thread>
 
 namespace {
 
@@ -68,7 +73,7 @@ redirect_output_setter::~redirect_output_setter()
 	output_stream = old_stream_;
 }
 
-typedef std::map<std::string, int> domain_map;
+typedef std::map<std::string, log_domain_state> domain_map;
 static domain_map *domains;
 static int strict_level_ = -1;
 void timestamps(bool t) { timestamp = t; }
@@ -110,8 +115,8 @@ log_domain::log_domain(char const *name, int severity)
 {
 	// Indirection to prevent initialization depending on link order.
 	if (!domains) domains = new domain_map;
-	domain_ = &*domains->insert(logd(name, severity)).first;
-	domain_->second = severity;
+	domain_ = &*domains->insert(logd(name, log_domain_state(severity))).first;
+	domain_->second.severity = severity;
 }
 
 bool set_log_domain_severity(const std::string& name, int severity)
@@ -119,18 +124,18 @@ bool set_log_domain_severity(const std::string& name, int severity)
 	std::string::size_type s = name.size();
 	if (name == "all") {
 		for(logd &l : *domains) {
-			l.second = severity;
+			l.second.severity = severity;
 		}
 	} else if (s > 2 && name.compare(s - 2, 2, "/*") == 0) {
 		for(logd &l : *domains) {
 			if (l.first.compare(0, s - 1, name, 0, s - 1) == 0)
-				l.second = severity;
+				l.second.severity = severity;
 		}
 	} else {
 		domain_map::iterator it = domains->find(name);
 		if (it == domains->end())
 			return false;
-		it->second = severity;
+		it->second.severity = severity;
 	}
 	return true;
 }
@@ -138,12 +143,34 @@ bool set_log_domain_severity(const std::string& name, const logger &lg) {
 	return set_log_domain_severity(name, lg.get_severity());
 }
 
+bool set_log_domain_sample_rate(const std::string& name, int rate)
+{
+	rate = std::max(rate, 1);
+	std::string::size_type s = name.size();
+	if (name == "all") {
+		for(logd &l : *domains) {
+			l.second.sample_rate = rate;
+		}
+	} else if (s > 2 && name.compare(s - 2, 2, "/*") == 0) {
+		for(logd &l : *domains) {
+			if (l.first.compare(0, s - 1, name, 0, s - 1) == 0)
+				l.second.sample_rate = rate;
+		}
+	} else {
+		domain_map::iterator it = domains->find(name);
+		if (it == domains->end())
+			return false;
+		it->second.sample_rate = rate;
+	}
+	return true;
+}
+
 bool get_log_domain_severity(const std::string& name, int &severity)
 {
 	domain_map::iterator it = domains->find(name);
 	if (it == domains->end())
 		return false;
-	severity = it->second;
+	severity = it->second.severity;
 	return true;
 }
 
@@ -195,10 +222,9 @@ std::string get_timespan(const std::time_t& t) {
 	return sout.str();
 }
 
-static void print_precise_timestamp(std::ostream& out) noexcept
+static void print_precise_timestamp(std::ostream& out, int64_t micros) noexcept
 {
 	try {
-		int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
 		std::time_t seconds = micros/1'000'000;
 		int fractional = micros-(seconds*1'000'000);
 		char c = out.fill('0');
@@ -207,9 +233,154 @@ static void print_precise_timestamp(std::ostream& out) noexcept
 	} catch(...) {}
 }
 
+static int64_t current_micros()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+namespace {
+
+/** One queued log write; the text is fully formatted by the producer. */
+struct async_record
+{
+	int64_t micros;
+	std::string text;
+	bool timestamped;
+	bool precise;
+};
+
+/**
+ * Hands queued records to a background thread, so that producers only pay for
+ * the enqueue and never block on the output stream. The queue is bounded;
+ * when it overruns, records are dropped and a notice is written in their
+ * place once the writer catches up again.
+ */
+class async_log_writer
+{
+public:
+	static const std::size_t max_queue_size = 4096;
+
+	~async_log_writer()
+	{
+		stop();
+	}
+
+	void start()
+	{
+		std::scoped_lock lock(log_mutex);
+		if(running_) {
+			return;
+		}
+		running_ = true;
+		thread_ = std::thread(&async_log_writer::run, this);
+	}
+
+	void stop()
+	{
+		{
+			std::scoped_lock lock(log_mutex);
+			if(!running_) {
+				return;
+			}
+			running_ = false;
+			cond_.notify_one();
+		}
+		thread_.join();
+	}
+
+	void enqueue(async_record&& rec)
+	{
+		std::scoped_lock lock(log_mutex);
+		if(!running_) {
+			// Raced with stop(); fall back to writing in place.
+			write_record(rec, 0);
+			return;
+		}
+		if(queue_.size() >= max_queue_size) {
+			++dropped_;
+			return;
+		}
+		queue_.push_back(std::move(rec));
+		cond_.notify_one();
+	}
+
+private:
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(log_mutex);
+		while(running_ || !queue_.empty()) {
+			if(queue_.empty()) {
+				cond_.wait(lock);
+				continue;
+			}
+
+			std::deque<async_record> batch;
+			batch.swap(queue_);
+			uint64_t dropped = dropped_;
+			dropped_ = 0;
+
+			// The stream is written without the lock, so producers can keep
+			// queueing while a slow write is in flight.
+			lock.unlock();
+			for(const async_record& rec : batch) {
+				write_record(rec, dropped);
+				dropped = 0;
+			}
+			lock.lock();
+		}
+	}
+
+	static void write_record(const async_record& rec, uint64_t dropped)
+	{
+		std::ostream& out = output();
+		if(dropped > 0) {
+			out << "warning log: dropped " << dropped << " log records under load\n";
+		}
+		if(rec.timestamped) {
+			if(rec.precise) {
+				print_precise_timestamp(out, rec.micros);
+			} else {
+				out << get_timestamp(rec.micros / 1'000'000);
+			}
+		}
+		out << rec.text;
+	}
+
+	std::deque<async_record> queue_;
+	std::condition_variable cond_;
+	std::thread thread_;
+	bool running_ = false;
+	uint64_t dropped_ = 0;
+};
+
+async_log_writer& async_writer()
+{
+	static async_log_writer instance;
+	return instance;
+}
+
+std::atomic<bool> async_logging_enabled{false};
+
+} // end anonymous namespace
+
+void set_async_logging(bool enable)
+{
+	if(enable) {
+		async_writer().start();
+		async_logging_enabled = true;
+	} else {
+		async_logging_enabled = false;
+		async_writer().stop();
+	}
+}
+
 log_in_progress logger::operator()(const log_domain& domain, bool show_names, bool do_indent) const
 {
-	if (severity_ > domain.domain_->second) {
+	const log_domain_state& state = domain.domain_->second;
+	if (severity_ > state.severity) {
+		return null_ostream;
+	} else if (state.sample_rate > 1 && state.sample_counter++ % state.sample_rate != 0) {
 		return null_ostream;
 	} else {
 		if (!strict_threw_ && (severity_ <= strict_level_)) {
@@ -238,12 +409,25 @@ log_in_progress::log_in_progress(std::ostream& stream)
 
 void log_in_progress::operator|(formatter&& message)
 {
+	if(async_logging_enabled && &stream_ == &output()) {
+		async_record rec;
+		rec.micros = current_micros();
+		rec.timestamped = timestamp_;
+		rec.precise = precise_timestamp;
+		std::string text;
+		for(int i = 0; i < indent; ++i)
+			text += "  ";
+		rec.text = text + prefix_ + message.str();
+		async_writer().enqueue(std::move(rec));
+		return;
+	}
+
 	std::scoped_lock lock(log_mutex);
 	for(int i = 0; i < indent; ++i)
 		stream_ << "  ";
 	if(timestamp_) {
 		if(precise_timestamp) {
-			print_precise_timestamp(stream_);
+			print_precise_timestamp(stream_, current_micros());
 		} else {
 			stream_ << get_timestamp(std::time(nullptr));
 		}
@@ -100,7 +100,18 @@ private:
 
 class logger;
 
-typedef std::pair<const std::string, int> logd;
+/** Runtime state of one log domain: the enabled severity plus the sampling rate. */
+struct log_domain_state {
+	log_domain_state(int sev = 1) : severity(sev) {}
+
+	int severity;
+	/** Pass only every Nth record on this domain to the output; 1 passes everything. */
+	int sample_rate = 1;
+	/** Rolling counter used to apply sample_rate; racing increments merely shift the phase. */
+	mutable unsigned sample_counter = 0;
+};
+
+typedef std::pair<const std::string, log_domain_state> logd;
 
 class log_domain {
 	logd *domain_;
@@ -114,6 +125,25 @@ bool set_log_domain_severity(const std::string& name, const logger &lg);
 bool get_log_domain_severity(const std::string& name, int &severity);
 std::string list_logdomains(const std::string& filter);
 
+/**
+ * Keeps only one out of every @a rate records logged on the matching domains;
+ * the name accepts the same "all" and "prefix/*" forms as
+ * set_log_domain_severity(). A rate of 1 (the default) disables sampling.
+ */
+bool set_log_domain_sample_rate(const std::string& name, int rate);
+
+/**
+ * Moves the writing of log records to a background thread, so that callers
+ * only pay for formatting the message and enqueueing it. Timestamps reflect
+ * when the record was enqueued, not when it was written. When the queue
+ * overruns, records are dropped and a notice is emitted instead; disabling
+ * (also done automatically at exit) flushes everything still queued.
+ *
+ * Off by default; meant for the servers, where a synchronous write to a
+ * redirected stderr can stall the main loop.
+ */
+void set_async_logging(bool enable);
+
 void set_strict_severity(int severity);
 void set_strict_severity(const logger &lg);
 bool broke_strict();
@@ -148,7 +178,7 @@ public:
 
 	bool dont_log(const log_domain& domain) const
 	{
-		return severity_ > domain.domain_->second;
+		return severity_ > domain.domain_->second.severity;
 	}
 
 	/**
@@ -31,6 +31,8 @@
 
 #include <boost/functional/hash_fwd.hpp>
 
+#include <map>
+
 static lg::log_domain log_config("config");
 #define ERR_CF LOG_STREAM(err, log_config)
 
@@ -493,6 +495,36 @@ void get_adjacent_tiles(const map_location& a, map_location* res)
 	res->y = a.y - (((a.x & 1) == 0) ? 1 : 0);
 }
 
+adjacency_table::adjacency_table(int width, int height)
+	: width_(width)
+	, rows_(static_cast<std::size_t>(width) * height)
+{
+	for(int y = 0; y < height; ++y) {
+		for(int x = 0; x < width; ++x) {
+			row& r = rows_[y * width + x];
+			r.count = 0;
+			for(const map_location& adj : get_adjacent_tiles(map_location(x, y))) {
+				if(adj.x >= 0 && adj.x < width && adj.y >= 0 && adj.y < height) {
+					r.locs[r.count++] = adj;
+				}
+			}
+		}
+	}
+}
+
+const adjacency_table& adjacency_table::get(int width, int height)
+{
+	// Usually only the active map's size is ever requested, but scenarios
+	// can resize the map mid-game, so keep a table per size seen.
+	static std::map<std::pair<int, int>, adjacency_table> tables;
+	const auto key = std::make_pair(width, height);
+	auto it = tables.find(key);
+	if(it == tables.end()) {
+		it = tables.emplace(key, adjacency_table(width, height)).first;
+	}
+	return it->second;
+}
+
 std::array<map_location, 6> get_adjacent_tiles(const map_location& center)
 {
 	std::array<map_location, 6> res;
@@ -175,6 +175,39 @@ void get_adjacent_tiles(const map_location& a, map_location* res);
 /** Returns an array of the six hexes adjacent to @p center. */
 std::array<map_location, 6> get_adjacent_tiles(const map_location& center);
 
+/**
+ * Precomputed, flat table of the on-board neighbors of every hex of a
+ * width x height map.
+ *
+ * Each hex's row holds its (up to six) on-board neighbors, in the order
+ * get_adjacent_tiles() produces them with the off-board entries removed.
+ * Tables are cached per map size, so pathfinding loops can walk adjacency
+ * without recomputing parity offsets and bounds checks on every step.
+ */
+class adjacency_table {
+public:
+	struct row {
+		map_location locs[6];
+		int count;
+	};
+
+	/** Builds the table for a width x height map. Prefer get(). */
+	adjacency_table(int width, int height);
+
+	/** Returns the (cached) table for a width x height map. */
+	static const adjacency_table& get(int width, int height);
+
+	/** Returns the neighbor row of the on-board hex with flat index @a index (y * width + x). */
+	const row& neighbors(std::size_t index) const { return rows_[index]; }
+
+	/** Returns the neighbor row of the on-board hex @a loc. */
+	const row& neighbors(const map_location& loc) const { return rows_[loc.y * width_ + loc.x]; }
+
+private:
+	int width_;
+	std::vector<row> rows_;
+};
+
 /**
  * Function which gives the number of hexes between two tiles
  * (i.e. the minimum number of hexes that have to be traversed
@@ -75,9 +75,11 @@
 #include "replay_helper.hpp"
 #include "resources.hpp"
 #include "save_index.hpp"
+#include "saved_game.hpp"
 #include "savegame.hpp"
 #include "scripting/game_lua_kernel.hpp"
 #include "scripting/plugins/manager.hpp"
+#include "serialization/string_utils.hpp"
 #include "synced_context.hpp"
 #include "terrain/builder.hpp"
 #include "units/udisplay.hpp"
@@ -1163,6 +1165,7 @@ protected:
 	void do_set_var();
 	void do_show_var();
 	void do_inspect();
+	void do_memory_stats();
 	void do_control_dialog();
 	void do_unit();
 	// void do_buff();
@@ -1277,6 +1280,8 @@ protected:
 		register_command("give_control", &console_handler::do_control_dialog,
 				_("Invoke a dialog allowing changing control of MP sides."), "", "N");
 		register_command("inspect", &console_handler::do_inspect, _("Launch the gamestate inspector"), "", "D");
+		register_command("memstats", &console_handler::do_memory_stats,
+				_("Log the heaviest WML subtrees of the game configuration and the save data."), _("[top_n]"), "D");
 		register_command(
 				"alias", &console_handler::do_set_alias, _("Set or show alias to a command"), _("<name>[=<command>]"));
 		register_command(
@@ -1969,6 +1974,67 @@ void console_handler::do_inspect()
 		menu_handler_.gamedata().get_variables(), *resources::game_events, menu_handler_.board());
 }
 
+namespace
+{
+/**
+ * Collects (bytes, path) for every subtree of @a cfg down to @a depth tag
+ * levels; each entry accounts the full subtree below its path.
+ */
+void collect_heavy_paths(
+		const config& cfg, const std::string& path, int depth, std::vector<std::pair<std::size_t, std::string>>& out)
+{
+	if(depth == 0) {
+		return;
+	}
+
+	for(const config::any_child item : cfg.all_children_range()) {
+		const std::string child_path = path + "[" + item.key + "]";
+		out.emplace_back(item.cfg.memory_usage().total(), child_path);
+		collect_heavy_paths(item.cfg, child_path, depth - 1, out);
+	}
+}
+} // namespace
+
+void console_handler::do_memory_stats()
+{
+	int top_n = 10;
+	if(!get_data().empty()) {
+		try {
+			top_n = std::max(1, lexical_cast<int>(get_data()));
+		} catch(const bad_lexical_cast&) {
+			command_failed(_("Invalid number of paths: ") + get_data());
+			return;
+		}
+	}
+
+	std::vector<std::pair<std::size_t, std::string>> paths;
+
+	for(const config& cfg : menu_handler_.game_config_.data()) {
+		paths.emplace_back(cfg.memory_usage().total(), "game_config");
+		collect_heavy_paths(cfg, "game_config", 3, paths);
+	}
+
+	// The save isn't kept as one config in memory; account a freshly built
+	// snapshot, which is what would be written to disk.
+	const config save = menu_handler_.pc_.get_saved_game().to_config();
+	paths.emplace_back(save.memory_usage().total(), "saved_game");
+	collect_heavy_paths(save, "saved_game", 3, paths);
+
+	std::sort(paths.begin(), paths.end(), std::greater<>());
+	if(paths.size() > static_cast<std::size_t>(top_n)) {
+		paths.resize(top_n);
+	}
+
+	std::ostringstream report;
+	report << "heaviest WML subtrees:";
+	for(const auto& [bytes, path] : paths) {
+		report << "\n" << utils::si_string(bytes, true, _("unit_byte^B")) << " " << path;
+	}
+
+	print(get_cmd(), report.str());
+	LOG_NG << report.str() << "\n";
+}
+
 void console_handler::do_control_dialog()
 {
 	gui2::dialogs::mp_change_control::display(menu_handler_);
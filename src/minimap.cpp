@@ -26,10 +26,13 @@
 #include "map/map.hpp"
 #include "preferences/general.hpp"
 #include "resources.hpp"
+#include "sdl/rect.hpp"
 #include "sdl/surface.hpp"
 #include "team.hpp"
 #include "terrain/type_data.hpp"
 
+#include <cmath>
+
 static lg::log_domain log_display("display");
 #define DBG_DP LOG_STREAM(debug, log_display)
 #define WRN_DP LOG_STREAM(warn, log_display)
@@ -37,11 +40,225 @@ static lg::log_domain log_display("display");
 
 namespace image {
 
-surface getMinimap(int w, int h, const gamemap &map, const team *vw, const std::map<map_location,unsigned int> *reach_map, bool ignore_terrain_disabled)
+namespace {
+
+/** The cell occupied by a hex on the unscaled minimap. */
+SDL_Rect minimap_cell(const map_location& loc, int scale)
+{
+	// we need a balanced shift up and down of the hexes.
+	// if not, only the bottom half-hexes are clipped
+	// and it looks asymmetrical.
+	return {
+			loc.x * scale * 3 / 4 - (scale / 4)
+			, loc.y * scale + scale / 4 * (is_odd(loc.x) ? 1 : -1) - (scale / 4)
+			, scale
+			, scale
+	};
+}
+
+/** Renders a single hex onto the unscaled minimap surface. */
+void draw_minimap_hex(surface& minimap, const map_location& loc, const gamemap& map,
+		const team* vw, const std::map<map_location, unsigned int>* reach_map, int scale,
+		bool preferences_minimap_draw_terrain, bool preferences_minimap_terrain_coding,
+		bool preferences_minimap_draw_villages, bool preferences_minimap_unit_coding)
 {
-	const terrain_type_data & tdata = *map.tdata();
+	const terrain_type_data& tdata = *map.tdata();
+
+	typedef mini_terrain_cache_map cache_map;
+	cache_map *normal_cache = &mini_terrain_cache;
+	cache_map *fog_cache = &mini_fogged_terrain_cache;
+	cache_map *highlight_cache = &mini_highlighted_terrain_cache;
+
+	const bool shrouded = (display::get_singleton() != nullptr && display::get_singleton()->is_blindfolded()) || (vw != nullptr && vw->shrouded(loc));
+	// shrouded hex are not considered fogged (no need to fog a black image)
+	const bool fogged = (vw != nullptr && !shrouded && vw->fogged(loc));
+
+	const bool highlighted = reach_map && reach_map->count(loc) != 0 && !shrouded;
+
+	const t_translation::terrain_code terrain = shrouded ?
+			t_translation::VOID_TERRAIN : map[loc];
+	const terrain_type& terrain_info = tdata.get_terrain_info(terrain);
+
+	SDL_Rect maprect = minimap_cell(loc, scale);
+	maprect.w = 0;
+	maprect.h = 0;
+
+	if (preferences_minimap_draw_terrain) {
+
+		if (preferences_minimap_terrain_coding) {
+
+			surface surf(nullptr);
+
+			bool need_fogging = false;
+			bool need_highlighting = false;
+
+			cache_map* cache = fogged ? fog_cache : normal_cache;
+			if (highlighted)
+				cache = highlight_cache;
+			cache_map::iterator i = cache->find(terrain);
+
+			if (fogged && i == cache->end()) {
+				// we don't have the fogged version in cache
+				// try the normal cache and ask fogging the image
+				cache = normal_cache;
+				i = cache->find(terrain);
+				need_fogging = true;
+			}
+
+			if (highlighted && i == cache->end()) {
+				// we don't have the highlighted version in cache
+				// try the normal cache and ask fogging the image
+				cache = normal_cache;
+				i = cache->find(terrain);
+				need_highlighting = true;
+			}
+
+			if(i == cache->end() && !terrain_info.minimap_image().empty()) {
+				std::string base_file =
+						"terrain/" + terrain_info.minimap_image() + ".png";
+				surface tile = get_image(base_file,image::HEXED);
+
+				//Compose images of base and overlay if necessary
+				// NOTE we also skip overlay when base is missing (to avoid hiding the error)
+				if(tile != nullptr && tdata.get_terrain_info(terrain).is_combined() && !terrain_info.minimap_image_overlay().empty()) {
+					std::string overlay_file =
+							"terrain/" + terrain_info.minimap_image_overlay() + ".png";
+					surface overlay = get_image(overlay_file,image::HEXED);
+
+					if(overlay != nullptr && overlay != tile) {
+						surface combined(tile->w, tile->h);
+						SDL_Rect r {0,0,0,0};
+						sdl_blit(tile, nullptr, combined, &r);
+						r.x = std::max(0, (tile->w - overlay->w)/2);
+						r.y = std::max(0, (tile->h - overlay->h)/2);
+						sdl_blit(overlay, nullptr, combined, &r);
+						tile = combined;
+					}
+				}
+
+				surf = scale_surface_sharp(tile, scale, scale);
+
+				i = normal_cache->emplace(terrain, surf).first;
+			}
+
+			if (i != cache->end())
+			{
+				surf = i->second;
+
+				if (need_fogging) {
+					surf = adjust_surface_color(surf, -50, -50, -50);
+					fog_cache->emplace(terrain, surf);
+				}
+
+				if (need_highlighting) {
+					surf = adjust_surface_color(surf, 50, 50, 50);
+					highlight_cache->emplace(terrain, surf);
+				}
+			}
+
+			if(surf != nullptr)
+				sdl_blit(surf, nullptr, minimap, &maprect);
+
+		} else {
+
+			// Despite its name, game_config::team_rgb_range isn't just team colors,
+			// it has "red", "lightblue", "cave", "reef", "fungus", etc.
+			color_t col;
+			std::map<std::string, color_range>::const_iterator it = game_config::team_rgb_range.find(terrain_info.id());
+			if (it == game_config::team_rgb_range.end()) {
+				col = color_t(0,0,0,0);
+			} else
+				col = it->second.rep();
+
+			bool first = true;
+			const t_translation::ter_list& underlying_terrains = tdata.underlying_union_terrain(terrain);
+			for(const t_translation::terrain_code& underlying_terrain : underlying_terrains) {
+
+				const std::string& terrain_id = tdata.get_terrain_info(underlying_terrain).id();
+				it = game_config::team_rgb_range.find(terrain_id);
+				if (it == game_config::team_rgb_range.end())
+					continue;
+
+				color_t tmp = it->second.rep();
+
+				if (fogged) {
+					if (tmp.b < 50) tmp.b = 0;
+					else tmp.b -= 50;
+					if (tmp.g < 50) tmp.g = 0;
+					else tmp.g -= 50;
+					if (tmp.r < 50) tmp.r = 0;
+					else tmp.r -= 50;
+				}
+
+				if (highlighted) {
+					if (tmp.b > 205) tmp.b = 255;
+					else tmp.b += 50;
+					if (tmp.g > 205) tmp.g = 255;
+					else tmp.g += 50;
+					if (tmp.r > 205) tmp.r = 255;
+					else tmp.r += 50;
+				}
+
+				if (first) {
+					first = false;
+					col = tmp;
+				} else {
+					col.r = col.r - (col.r - tmp.r)/2;
+					col.g = col.g - (col.g - tmp.g)/2;
+					col.b = col.b - (col.b - tmp.b)/2;
+				}
+			}
+			SDL_Rect fillrect {maprect.x, maprect.y, scale * 3/4, scale};
+			const uint32_t mapped_col = SDL_MapRGB(minimap->format,col.r,col.g,col.b);
+			sdl::fill_surface_rect(minimap, &fillrect, mapped_col);
+		}
+	}
+
+	if (terrain_info.is_village() && preferences_minimap_draw_villages) {
+
+		int side_num = (resources::gameboard ? resources::gameboard->village_owner(loc) : 0); //check needed for mp create dialog
+
+		// TODO: Add a key to [game_config][colors] for this
+		auto iter = game_config::team_rgb_range.find("white");
+		color_t col(255,255,255);
+		if(iter != game_config::team_rgb_range.end()) {
+			col = iter->second.min();
+		}
+
+		if (!fogged) {
+			if (side_num > 0) {
+
+				if (preferences_minimap_unit_coding || !vw ) {
+					col = team::get_minimap_color(side_num);
+				} else {
+
+					if (vw->owns_village(loc))
+						col = game_config::color_info(preferences::unmoved_color()).rep();
+					else if (vw->is_enemy(side_num))
+						col = game_config::color_info(preferences::enemy_color()).rep();
+					else
+						col = game_config::color_info(preferences::allied_color()).rep();
+				}
+			}
+		}
+
+		SDL_Rect fillrect {
+				maprect.x
+				, maprect.y
+				, scale * 3/4
+				, scale
+		};
+
+		const uint32_t mapped_col = SDL_MapRGB(minimap->format,col.r,col.g,col.b);
+		sdl::fill_surface_rect(minimap, &fillrect, mapped_col);
+
+	}
+}
 
+} // namespace
 
+surface getMinimap(int w, int h, const gamemap &map, const team *vw, const std::map<map_location,unsigned int> *reach_map, bool ignore_terrain_disabled, surface* unscaled)
+{
 	const bool preferences_minimap_draw_terrain = preferences::minimap_draw_terrain() || ignore_terrain_disabled;
 	const bool preferences_minimap_terrain_coding = preferences::minimap_terrain_coding();
 	const bool preferences_minimap_draw_villages = preferences::minimap_draw_villages();
@@ -51,6 +268,10 @@ surface getMinimap(int w, int h, const gamemap &map, const team *vw, const std::
 
 	DBG_DP << "creating minimap " << int(map.w()*scale*0.75) << "," << map.h()*scale << "\n";
 
+	if(unscaled != nullptr) {
+		*unscaled = surface(nullptr);
+	}
+
 	const std::size_t map_width = map.w()*scale*3/4;
 	const std::size_t map_height = map.h()*scale;
 	if(map_width == 0 || map_height == 0) {
@@ -69,11 +290,6 @@ surface getMinimap(int w, int h, const gamemap &map, const team *vw, const std::
 	if(minimap == nullptr)
 		return surface(nullptr);
 
-	typedef mini_terrain_cache_map cache_map;
-	cache_map *normal_cache = &mini_terrain_cache;
-	cache_map *fog_cache = &mini_fogged_terrain_cache;
-	cache_map *highlight_cache = &mini_highlighted_terrain_cache;
-
 	for(int y = 0; y <= map.total_height(); ++y)
 		for(int x = 0; x <= map.total_width(); ++x) {
 
@@ -81,210 +297,112 @@ surface getMinimap(int w, int h, const gamemap &map, const team *vw, const std::
 			if(!map.on_board_with_border(loc))
 				continue;
 
-			const bool shrouded = (display::get_singleton() != nullptr && display::get_singleton()->is_blindfolded()) || (vw != nullptr && vw->shrouded(loc));
-			// shrouded hex are not considered fogged (no need to fog a black image)
-			const bool fogged = (vw != nullptr && !shrouded && vw->fogged(loc));
-
-			const bool highlighted = reach_map && reach_map->count(loc) != 0 && !shrouded;
-
-			const t_translation::terrain_code terrain = shrouded ?
-					t_translation::VOID_TERRAIN : map[loc];
-			const terrain_type& terrain_info = tdata.get_terrain_info(terrain);
-
-			// we need a balanced shift up and down of the hexes.
-			// if not, only the bottom half-hexes are clipped
-			// and it looks asymmetrical.
-
-			SDL_Rect maprect {
-					x * scale * 3 / 4 - (scale / 4)
-					, y * scale + scale / 4 * (is_odd(x) ? 1 : -1) - (scale / 4)
-					, 0
-					, 0
-			};
-
-			if (preferences_minimap_draw_terrain) {
-
-				if (preferences_minimap_terrain_coding) {
-
-					surface surf(nullptr);
+			draw_minimap_hex(minimap, loc, map, vw, reach_map, scale,
+					preferences_minimap_draw_terrain, preferences_minimap_terrain_coding,
+					preferences_minimap_draw_villages, preferences_minimap_unit_coding);
+		}
 
-					bool need_fogging = false;
-					bool need_highlighting = false;
+	if(unscaled != nullptr) {
+		*unscaled = minimap;
+	}
 
-					cache_map* cache = fogged ? fog_cache : normal_cache;
-					if (highlighted)
-						cache = highlight_cache;
-					cache_map::iterator i = cache->find(terrain);
+	double wratio = w*1.0 / minimap->w;
+	double hratio = h*1.0 / minimap->h;
+	double ratio = std::min<double>(wratio, hratio);
 
-					if (fogged && i == cache->end()) {
-						// we don't have the fogged version in cache
-						// try the normal cache and ask fogging the image
-						cache = normal_cache;
-						i = cache->find(terrain);
-						need_fogging = true;
-					}
+	minimap = scale_surface_sharp(minimap,
+		static_cast<int>(minimap->w * ratio), static_cast<int>(minimap->h * ratio));
 
-					if (highlighted && i == cache->end()) {
-						// we don't have the highlighted version in cache
-						// try the normal cache and ask fogging the image
-						cache = normal_cache;
-						i = cache->find(terrain);
-						need_highlighting = true;
-					}
+	DBG_DP << "done generating minimap\n";
 
-					if(i == cache->end() && !terrain_info.minimap_image().empty()) {
-						std::string base_file =
-								"terrain/" + terrain_info.minimap_image() + ".png";
-						surface tile = get_image(base_file,image::HEXED);
-
-						//Compose images of base and overlay if necessary
-						// NOTE we also skip overlay when base is missing (to avoid hiding the error)
-						if(tile != nullptr && tdata.get_terrain_info(terrain).is_combined() && !terrain_info.minimap_image_overlay().empty()) {
-							std::string overlay_file =
-									"terrain/" + terrain_info.minimap_image_overlay() + ".png";
-							surface overlay = get_image(overlay_file,image::HEXED);
-
-							if(overlay != nullptr && overlay != tile) {
-								surface combined(tile->w, tile->h);
-								SDL_Rect r {0,0,0,0};
-								sdl_blit(tile, nullptr, combined, &r);
-								r.x = std::max(0, (tile->w - overlay->w)/2);
-								r.y = std::max(0, (tile->h - overlay->h)/2);
-								sdl_blit(overlay, nullptr, combined, &r);
-								tile = combined;
-							}
-						}
-
-						surf = scale_surface_sharp(tile, scale, scale);
-
-						i = normal_cache->emplace(terrain, surf).first;
-					}
+	return minimap;
+}
 
-					if (i != cache->end())
-					{
-						surf = i->second;
+bool updateMinimap(surface& unscaled, surface& scaled, const gamemap &map, const std::set<map_location>& locs, const team *vw, const std::map<map_location,unsigned int> *reach_map, bool ignore_terrain_disabled)
+{
+	const bool preferences_minimap_draw_terrain = preferences::minimap_draw_terrain() || ignore_terrain_disabled;
+	const bool preferences_minimap_terrain_coding = preferences::minimap_terrain_coding();
+	const bool preferences_minimap_draw_villages = preferences::minimap_draw_villages();
+	const bool preferences_minimap_unit_coding = preferences::minimap_movement_coding();
 
-						if (need_fogging) {
-							surf = adjust_surface_color(surf, -50, -50, -50);
-							fog_cache->emplace(terrain, surf);
-						}
+	const int scale = (preferences_minimap_draw_terrain && preferences_minimap_terrain_coding) ? 24 : 4;
 
-						if (need_highlighting) {
-							surf = adjust_surface_color(surf, 50, 50, 50);
-							highlight_cache->emplace(terrain, surf);
-						}
-					}
+	const int map_width = map.w()*scale*3/4;
+	const int map_height = map.h()*scale;
 
-					if(surf != nullptr)
-						sdl_blit(surf, nullptr, minimap, &maprect);
+	// A size mismatch means the map got resized or the minimap preferences
+	// changed since the surfaces were generated; only a full regeneration
+	// can handle those.
+	if(unscaled == nullptr || scaled == nullptr
+			|| unscaled->w != map_width || unscaled->h != map_height) {
+		return false;
+	}
 
-				} else {
+	if(!preferences_minimap_draw_villages && !preferences_minimap_draw_terrain) {
+		// nothing is drawn on the minimap, so nothing to update
+		return true;
+	}
 
-					// Despite its name, game_config::team_rgb_range isn't just team colors,
-					// it has "red", "lightblue", "cave", "reef", "fungus", etc.
-					color_t col;
-					std::map<std::string, color_range>::const_iterator it = game_config::team_rgb_range.find(terrain_info.id());
-					if (it == game_config::team_rgb_range.end()) {
-						col = color_t(0,0,0,0);
-					} else
-						col = it->second.rep();
-
-					bool first = true;
-					const t_translation::ter_list& underlying_terrains = tdata.underlying_union_terrain(terrain);
-					for(const t_translation::terrain_code& underlying_terrain : underlying_terrains) {
-
-						const std::string& terrain_id = tdata.get_terrain_info(underlying_terrain).id();
-						it = game_config::team_rgb_range.find(terrain_id);
-						if (it == game_config::team_rgb_range.end())
-							continue;
-
-						color_t tmp = it->second.rep();
-
-						if (fogged) {
-							if (tmp.b < 50) tmp.b = 0;
-							else tmp.b -= 50;
-							if (tmp.g < 50) tmp.g = 0;
-							else tmp.g -= 50;
-							if (tmp.r < 50) tmp.r = 0;
-							else tmp.r -= 50;
-						}
-
-						if (highlighted) {
-							if (tmp.b > 205) tmp.b = 255;
-							else tmp.b += 50;
-							if (tmp.g > 205) tmp.g = 255;
-							else tmp.g += 50;
-							if (tmp.r > 205) tmp.r = 255;
-							else tmp.r += 50;
-						}
-
-						if (first) {
-							first = false;
-							col = tmp;
-						} else {
-							col.r = col.r - (col.r - tmp.r)/2;
-							col.g = col.g - (col.g - tmp.g)/2;
-							col.b = col.b - (col.b - tmp.b)/2;
-						}
-					}
-					SDL_Rect fillrect {maprect.x, maprect.y, scale * 3/4, scale};
-					const uint32_t mapped_col = SDL_MapRGB(minimap->format,col.r,col.g,col.b);
-					sdl::fill_surface_rect(minimap, &fillrect, mapped_col);
-				}
-			}
+	// Union of the cells of the damaged hexes on the unscaled minimap.
+	SDL_Rect damage = sdl::empty_rect;
+	for(const map_location& loc : locs) {
+		if(!map.on_board_with_border(loc)) {
+			continue;
+		}
 
-			if (terrain_info.is_village() && preferences_minimap_draw_villages) {
+		const SDL_Rect cell = minimap_cell(loc, scale);
+		damage = damage.w == 0 ? cell : sdl::union_rects(damage, cell);
+	}
 
-				int side_num = (resources::gameboard ? resources::gameboard->village_owner(loc) : 0); //check needed for mp create dialog
+	if(damage.w == 0) {
+		return true;
+	}
 
-				// TODO: Add a key to [game_config][colors] for this
-				auto iter = game_config::team_rgb_range.find("white");
-				color_t col(255,255,255);
-				if(iter != game_config::team_rgb_range.end()) {
-					col = iter->second.min();
-				}
+	DBG_DP << "updating " << locs.size() << " minimap cells, damage "
+			<< damage.x << ',' << damage.y << ' ' << damage.w << 'x' << damage.h << "\n";
 
-				if (!fogged) {
-					if (side_num > 0) {
+	// The damaged area is redrawn from scratch, and since neighboring cells
+	// overlap, every hex whose cell touches it has to be redrawn. Clipping
+	// to the damaged area keeps the composition identical to a full
+	// regeneration; hexes are iterated in the same order for the same reason.
+	sdl::fill_surface_rect(unscaled, &damage, 0);
+	{
+		clip_rect_setter clip(unscaled, &damage);
 
-						if (preferences_minimap_unit_coding || !vw ) {
-							col = team::get_minimap_color(side_num);
-						} else {
+		const int cell_stride = scale * 3 / 4;
+		const int x_begin = std::max(0, (damage.x - scale) / cell_stride - 1);
+		const int x_end = std::min(map.total_width(), (damage.x + damage.w) / cell_stride + 2);
+		const int y_begin = std::max(0, (damage.y - scale) / scale - 1);
+		const int y_end = std::min(map.total_height(), (damage.y + damage.h) / scale + 2);
 
-							if (vw->owns_village(loc))
-								col = game_config::color_info(preferences::unmoved_color()).rep();
-							else if (vw->is_enemy(side_num))
-								col = game_config::color_info(preferences::enemy_color()).rep();
-							else
-								col = game_config::color_info(preferences::allied_color()).rep();
-						}
-					}
-				}
+		for(int y = y_begin; y <= y_end; ++y)
+			for(int x = x_begin; x <= x_end; ++x) {
 
-				SDL_Rect fillrect {
-						maprect.x
-						, maprect.y
-						, scale * 3/4
-						, scale
-				};
+				const map_location loc(x,y);
+				if(!map.on_board_with_border(loc))
+					continue;
 
-				const uint32_t mapped_col = SDL_MapRGB(minimap->format,col.r,col.g,col.b);
-				sdl::fill_surface_rect(minimap, &fillrect, mapped_col);
+				const SDL_Rect cell = minimap_cell(loc, scale);
+				if(!SDL_HasIntersection(&cell, &damage))
+					continue;
 
+				draw_minimap_hex(unscaled, loc, map, vw, reach_map, scale,
+						preferences_minimap_draw_terrain, preferences_minimap_terrain_coding,
+						preferences_minimap_draw_villages, preferences_minimap_unit_coding);
 			}
+	}
 
-		}
-
-	double wratio = w*1.0 / minimap->w;
-	double hratio = h*1.0 / minimap->h;
-	double ratio = std::min<double>(wratio, hratio);
-
-	minimap = scale_surface_sharp(minimap,
-		static_cast<int>(minimap->w * ratio), static_cast<int>(minimap->h * ratio));
-
-	DBG_DP << "done generating minimap\n";
-
-	return minimap;
+	// Rescale only the damaged region, padded a pixel to pick up rounding.
+	const double ratio = std::min<double>(scaled->w * 1.0 / unscaled->w, scaled->h * 1.0 / unscaled->h);
+	const SDL_Rect scaled_damage {
+			static_cast<int>(std::floor(damage.x * ratio)) - 1
+			, static_cast<int>(std::floor(damage.y * ratio)) - 1
+			, static_cast<int>(std::ceil(damage.w * ratio)) + 2
+			, static_cast<int>(std::ceil(damage.h * ratio)) + 2
+	};
+	scale_surface_sharp_region(unscaled, scaled, scaled_damage);
+
+	return true;
 }
 
 
@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <map>
+#include <set>
 
 class gamemap;
 class surface;
@@ -27,6 +28,22 @@ namespace image {
 	/**
     * function to create the minimap for a given map
     * the surface returned must be freed by the user
+    *
+    * If unscaled is non-null it receives the minimap before the final
+    * rescale; handing it back to updateMinimap() later allows updating
+    * single cells without a full regeneration.
     */
-	surface getMinimap(int w, int h, const gamemap &map_, const team *vm = nullptr, const std::map<map_location,unsigned int> *reach_map = nullptr, bool ignore_terrain_disabled = false);
+	surface getMinimap(int w, int h, const gamemap &map_, const team *vm = nullptr, const std::map<map_location,unsigned int> *reach_map = nullptr, bool ignore_terrain_disabled = false, surface* unscaled = nullptr);
+
+	/**
+    * updates single cells of a previously generated minimap in place
+    *
+    * Re-renders the given hexes (plus the neighbors overlapping them) on the
+    * unscaled minimap and rescales only the damaged region into scaled.
+    *
+    * @returns false when the surfaces don't match the map and settings any
+    * more (map resized, minimap preferences changed); the caller should then
+    * regenerate the minimap with getMinimap().
+    */
+	bool updateMinimap(surface& unscaled, surface& scaled, const gamemap &map_, const std::set<map_location>& locs, const team *vm = nullptr, const std::map<map_location,unsigned int> *reach_map = nullptr, bool ignore_terrain_disabled = false);
 }
@@ -751,6 +751,18 @@ pathfind::marked_route mouse_handler::get_route(const unit* un, map_location go_
 {
 	game_board& board = pc_.gamestate().board_;
 
+	// Planned moves only exist on the whiteboard's future unit map, which the
+	// cache knows nothing about, so don't use it while planning.
+	const bool cache_usable = !pc_.get_whiteboard()->is_active();
+	const auto key = std::make_tuple(team.side(), un->get_location(), go_to);
+
+	if(cache_usable) {
+		const auto cached = route_cache_.find(key);
+		if(cached != route_cache_.end()) {
+			return cached->second;
+		}
+	}
+
 	// The pathfinder will check unit visibility (fogged/stealthy).
 	const pathfind::shortest_path_calculator calc(*un, team, board.teams(), board.map());
 
@@ -761,7 +773,13 @@ pathfind::marked_route mouse_handler::get_route(const unit* un, map_location go_
 	route = pathfind::a_star_search(
 		un->get_location(), go_to, 10000.0, calc, board.map().w(), board.map().h(), &allowed_teleports);
 
-	return mark_route(route);
+	pathfind::marked_route res = mark_route(route);
+
+	if(cache_usable) {
+		route_cache_.emplace(key, res);
+	}
+
+	return res;
 }
 
 bool mouse_handler::right_click_show_menu(int x, int y, const bool /*browse*/)
@@ -1005,6 +1023,7 @@ void mouse_handler::touch_action(const map_location touched_hex, bool browse)
 void mouse_handler::select_hex(const map_location& hex, const bool browse, const bool highlight, const bool fire_event)
 {
 	selected_hex_ = hex;
+	route_cache_.clear();
 
 	gui().select_hex(selected_hex_);
 	gui().clear_attack_indicator();
@@ -1480,6 +1499,7 @@ void mouse_handler::set_current_paths(const pathfind::paths& new_paths)
 
 	current_paths_ = new_paths;
 	current_route_.steps.clear();
+	route_cache_.clear();
 
 	gui().set_route(nullptr);
 
@@ -22,7 +22,9 @@
 #include "pathfind/pathfind.hpp"        // for marked_route, paths
 #include "units/map.hpp"                 // for unit_map, etc
 
+#include <map>                          // for map
 #include <set>                          // for set
+#include <tuple>                        // for tuple
 #include <vector>                       // for vector
 #include <SDL2/SDL_events.h>                 // for SDL_MouseButtonEvent
 
@@ -57,7 +59,11 @@ public:
 	void set_path_turns(const int path_turns) { path_turns_ = path_turns; }
 	void set_current_paths(const pathfind::paths & new_paths);
 	void deselect_hex();
-	void invalidate_reachmap() { reachmap_invalid_ = true; }
+	void invalidate_reachmap()
+	{
+		reachmap_invalid_ = true;
+		route_cache_.clear();
+	}
 
 	void set_gui(game_display* gui) { gui_ = gui; }
 
@@ -179,6 +185,13 @@ private:
 	map_location selected_hex_;
 	map_location next_unit_;
 	pathfind::marked_route current_route_;
+	/**
+	 * Routes already computed by get_route(), keyed by (side, source,
+	 * destination). Mouse movement tends to hover the same hexes over and
+	 * over, so reusing them avoids a pathfinder run per motion event. The
+	 * cache is dropped whenever the selection changes or a unit moves.
+	 */
+	mutable std::map<std::tuple<int, map_location, map_location>, pathfind::marked_route> route_cache_;
 	pathfind::paths current_paths_;
 	bool unselected_paths_;
 	bool unselected_reach_;
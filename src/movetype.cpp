@@ -142,7 +142,19 @@ private:
 	          const terrain_info * fallback, unsigned recurse_count) const;
 
 private:
-	typedef std::map<t_translation::terrain_code, int> cache_t;
+	/**
+	 * The cache is keyed by the terrain code's two layers packed into one
+	 * integer, hashed as-is. Pathfinding asks for these values millions of
+	 * times, and a flat hash probe beats walking an ordered tree of
+	 * two-field comparisons. A dense array indexed by terrain isn't
+	 * possible, as terrain codes are sparse 2x32-bit values, not indices.
+	 */
+	typedef std::unordered_map<uint64_t, int> cache_t;
+
+	static uint64_t cache_key(const t_translation::terrain_code & terrain)
+	{
+		return (static_cast<uint64_t>(terrain.base) << 32) | terrain.overlay;
+	}
 
 	/** Config describing the terrain values. */
 	config cfg_;
@@ -383,7 +395,7 @@ int movetype::terrain_info::data::value(
 {
 	// Check the cache.
 	std::pair<cache_t::iterator, bool> cache_it =
-		cache_.emplace(terrain, -127); // Bogus value that should never be seen.
+		cache_.emplace(cache_key(terrain), -127); // Bogus value that should never be seen.
 	if ( cache_it.second )
 		// The cache did not have an entry for this terrain, so calculate the value.
 		cache_it.first->second = calc_value(terrain, fallback, recurse_count);
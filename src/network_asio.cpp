@@ -241,8 +241,22 @@ void connection::transfer(const config& request, config& response)
 	io_context_.restart();
 	done_ = false;
 
-	write_buf_.reset(new boost::asio::streambuf);
-	read_buf_.reset(new boost::asio::streambuf);
+	// Reuse the buffers between transfers: discarding any residue keeps the
+	// already-grown storage, so a connection that just moved a large payload
+	// (e.g. the addon list) doesn't regrow its buffers from scratch for the
+	// next request.
+	if(!write_buf_) {
+		write_buf_.reset(new boost::asio::streambuf);
+	} else {
+		write_buf_->consume(write_buf_->size());
+	}
+
+	if(!read_buf_) {
+		read_buf_.reset(new boost::asio::streambuf);
+	} else {
+		read_buf_->consume(read_buf_->size());
+	}
+
 	std::ostream os(write_buf_.get());
 	write_gz(os, request);
 
@@ -334,6 +348,11 @@ std::size_t connection::is_read_complete(const boost::system::error_code& ec, st
 		// Close immediately if we receive an invalid length
 		if(bytes_to_read_ < 4) {
 			bytes_to_read_ = bytes_transferred;
+		} else if(bytes_to_read_ > bytes_transferred) {
+			// Now that the payload size is known, reserve it in one go.
+			// Otherwise the buffer regrows - copying everything received so
+			// far - several times over the course of a large transfer.
+			read_buf_->prepare(bytes_to_read_ - bytes_transferred);
 		}
 	}
 
@@ -59,7 +59,7 @@ double heuristic(const map_location& src, const map_location& dst)
 // values 0 and 1 mean uninitialized
 const unsigned bad_search_counter = 0;
 // The number of nodes already processed.
-static unsigned search_counter = bad_search_counter;
+static thread_local unsigned search_counter = bad_search_counter;
 
 struct node {
 	double g, h, t;
@@ -161,16 +161,25 @@ plain_route a_star_search(const map_location& src, const map_location& dst,
 	if (search_counter - bad_search_counter <= 1u)
 		search_counter += 2;
 
-	static std::vector<node> nodes;
+	static thread_local std::vector<node> nodes;
 	nodes.resize(width * height);  // this create uninitialized nodes
 
 	indexer index(width);
 	comp node_comp(nodes);
 
+	// Border searches address hexes outside the precomputed table, so only
+	// plain on-board searches can use it.
+	const adjacency_table* adjacency = border ? nullptr : &adjacency_table::get(width, height);
+
 	nodes[index(dst)].g = stop_at + 1;
 	nodes[index(src)] = node(0, src, map_location::null_location(), dst, true, teleports);
 
-	std::vector<int> pq;
+	// The queue and the neighbor scratch list keep their capacity between
+	// calls, so repeated searches (e.g. mouse-hover path previews) do not
+	// allocate once warmed up.
+	static thread_local std::vector<int> pq;
+	static thread_local std::vector<map_location> locs;
+	pq.clear();
 	pq.push_back(index(src));
 
 	while (!pq.empty()) {
@@ -183,8 +192,13 @@ plain_route a_star_search(const map_location& src, const map_location& dst,
 
 		if (n.t >= nodes[index(dst)].g) break;
 
-		std::vector<map_location> locs(6);
-		get_adjacent_tiles(n.curr, locs.data());
+		if (adjacency) {
+			const adjacency_table::row& neighbors = adjacency->neighbors(n.curr);
+			locs.assign(neighbors.locs, neighbors.locs + neighbors.count);
+		} else {
+			locs.resize(6);
+			get_adjacent_tiles(n.curr, locs.data());
+		}
 
 		if (teleports && !teleports->empty()) {
 			auto allowed_teleports = teleports->get_adjacents(n.curr);
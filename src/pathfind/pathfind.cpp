@@ -29,11 +29,14 @@
 #include "map/map.hpp"
 #include "resources.hpp"
 #include "team.hpp"
+#include "units/abilities.hpp"
 #include "units/unit.hpp"
 #include "units/map.hpp"
 #include "wml_exception.hpp"
 
 #include <iostream>
+#include <sstream>
+#include <tuple>
 #include <vector>
 #include <algorithm>
 
@@ -304,6 +307,7 @@ static void find_routes(
 	nodes.resize(map.w() * map.h());
 	findroute_comp node_comp(nodes);
 	findroute_indexer index(map.w(), map.h());
+	const adjacency_table& adjacency = adjacency_table::get(map.w(), map.h());
 
 	assert(index.on_board(origin));
 
@@ -339,20 +343,21 @@ static void find_routes(
 		std::pop_heap(hexes_to_process.begin(), hexes_to_process.end(), node_comp);
 		hexes_to_process.pop_back();
 
-		// Get the locations adjacent to current.
-		std::vector<map_location> adj_locs(6);
-		get_adjacent_tiles(cur_hex, adj_locs.data());
+		// Get the on-board locations adjacent to current from the
+		// precomputed table; this keeps the hot loop free of per-step
+		// adjacency arithmetic, bounds checks and allocation.
+		const adjacency_table::row& neighbors = adjacency.neighbors(cur_index);
+		static std::vector<map_location> adj_locs;
+		adj_locs.assign(neighbors.locs, neighbors.locs + neighbors.count);
 
-		// Sort adjacents by on-boardness
-		auto off_board_it = std::partition(adj_locs.begin(), adj_locs.end(), [&index](map_location loc){
-			return index.on_board(loc);
-		});
 		// Store off-board edges if needed
 		if(edges != nullptr){
-			edges->insert(off_board_it, adj_locs.end());
+			for(const map_location& adj : get_adjacent_tiles(cur_hex)) {
+				if(!index.on_board(adj)) {
+					edges->insert(adj);
+				}
+			}
 		}
-		// Remove off-board map locations
-		adj_locs.erase(off_board_it, adj_locs.end());
 
 		if ( teleporter ) {
 			auto allowed_teleports = teleports.get_adjacents(cur_hex);
@@ -530,11 +535,43 @@ bool paths::dest_vect::contains(const map_location &loc) const
  * @param see_all          Set to true to remove unit visibility from consideration.
  * @param ignore_units     Set to true if units should never obstruct paths (implies ignoring ZoC as well).
  */
+namespace {
+	/**
+	 * Cached reachable sets, so that repeatedly selecting the same unit does
+	 * not flood the map again. Keyed on the unit, its position and movement
+	 * state, and the construction flags; all entries are dropped when the
+	 * ability cache generation moves (unit placement, terrain edits and
+	 * time-of-day changes) or the vision generation moves (fog and shroud
+	 * changes, which alter routes unless see_all is set).
+	 */
+	typedef std::tuple<std::size_t, map_location, int, int, bool,
+			bool, bool, int, int, bool, bool> reach_cache_key;
+	std::map<reach_cache_key, paths::dest_vect> reach_cache;
+	std::size_t reach_cache_generation = 0;
+}
+
 paths::paths(const unit& u, bool force_ignore_zoc,
 		bool allow_teleport, const team &viewing_team,
 		int additional_turns, bool see_all, bool ignore_units)
 	: destinations()
 {
+	const std::size_t generation =
+		unit_abilities::cache_generation() * 8191 + shroud_map::vision_generation();
+	if ( generation != reach_cache_generation ) {
+		reach_cache.clear();
+		reach_cache_generation = generation;
+	}
+
+	const reach_cache_key key(u.underlying_id(), u.get_location(),
+			u.movement_left(), u.total_movement(), u.get_state(unit::STATE_SLOWED),
+			force_ignore_zoc, allow_teleport, viewing_team.side(),
+			additional_turns, see_all, ignore_units);
+	const auto cached = reach_cache.find(key);
+	if ( cached != reach_cache.end() ) {
+		destinations = cached->second;
+		return;
+	}
+
 	try {
 		find_routes(
 			u.get_location(),
@@ -553,6 +590,8 @@ paths::paths(const unit& u, bool force_ignore_zoc,
 	} catch(const std::out_of_range&) {
 		// Invalid unit side.
 	}
+
+	reach_cache[key] = destinations;
 }
 
 /**
@@ -908,6 +947,30 @@ full_cost_map::full_cost_map(bool force_ignore_zoc,
  */
 void full_cost_map::add_unit(const unit& u, bool use_max_moves)
 {
+	const int moves_left = use_max_moves ? u.total_movement() : u.movement_left();
+
+	// Units with the same origin, type and movement produce the same flood,
+	// and callers building a cost map over many units tend to add such units
+	// over and over. Flood once per equivalence class and replay the cached
+	// contribution afterwards. The serialized movement costs catch per-unit
+	// [movement_costs] modifications; teleport filters matching on a specific
+	// unit id are the one thing this key cannot distinguish.
+	config costs;
+	u.movement_type().get_movement().write(costs, "", true);
+
+	std::ostringstream key;
+	key << u.get_location() << '|' << u.type_id() << '|' << u.side() << '|'
+	    << u.get_state(unit::STATE_SLOWED) << '|' << moves_left << '|'
+	    << u.total_movement() << '|' << costs;
+
+	const auto cached = flood_cache_.find(key.str());
+	if(cached != flood_cache_.end()) {
+		merge(cached->second);
+		return;
+	}
+
+	std::vector<std::pair<int, int>> contribution(cost_map.size(), std::pair(-1, 0));
+
 	try {
 		// We don't need the destinations, but find_routes() wants to have this parameter
 		paths::dest_vect dummy = paths::dest_vect();
@@ -916,7 +979,7 @@ void full_cost_map::add_unit(const unit& u, bool use_max_moves)
 			u.get_location(),
 			u.movement_type().get_movement(),
 			u.get_state(unit::STATE_SLOWED),
-			(use_max_moves) ? u.total_movement() : u.movement_left(),
+			moves_left,
 			u.total_movement(),
 			99,
 			dummy,
@@ -926,10 +989,32 @@ void full_cost_map::add_unit(const unit& u, bool use_max_moves)
 			force_ignore_zoc_ ? nullptr : &u,
 			see_all_          ? nullptr : &viewing_team_,
 			nullptr,
-			&cost_map
+			&contribution
 		);
 	} catch(const std::out_of_range&) {
 		// Invalid unit side.
+		return;
+	}
+
+	merge(contribution);
+	flood_cache_.emplace(key.str(), std::move(contribution));
+}
+
+/**
+ * Adds one flood's result to cost_map, following the accumulation scheme
+ * described in pathfind.hpp.
+ */
+void full_cost_map::merge(const std::vector<std::pair<int, int>>& contribution)
+{
+	for(std::size_t i = 0; i < cost_map.size(); ++i) {
+		if(contribution[i].second == 0) {
+			continue;
+		}
+		if(cost_map[i].second == 0) {
+			cost_map[i].first = 0;
+		}
+		cost_map[i].first += contribution[i].first;
+		cost_map[i].second += contribution[i].second;
 	}
 }
 
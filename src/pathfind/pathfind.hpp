@@ -296,10 +296,18 @@ struct full_cost_map
 	std::vector<std::pair<int, int>> cost_map;
 
 private:
+	void merge(const std::vector<std::pair<int, int>>& contribution);
+
 	const bool force_ignore_zoc_;
 	const bool allow_teleport_;
 	const team &viewing_team_;
 	const bool see_all_;
 	const bool ignore_units_;
+
+	// Floods already run for this cost map, keyed by everything the flood
+	// depends on. When a cost map is built over many units (AI goals,
+	// recruitment), units with the same origin, type and movement repeat,
+	// and their contribution can be replayed instead of recomputed.
+	std::map<std::string, std::vector<std::pair<int, int>>> flood_cache_;
 };
 }
@@ -23,10 +23,13 @@
 #include "serialization/string_utils.hpp"
 #include "team.hpp"
 #include "terrain/filter.hpp"
+#include "units/abilities.hpp"
 #include "units/unit.hpp"
 #include "units/filter.hpp"
 #include "units/map.hpp"
 
+#include <tuple>
+
 static lg::log_domain log_engine("engine");
 #define ERR_PF LOG_STREAM(err, log_engine)
 
@@ -267,10 +270,34 @@ std::set<map_location> teleport_map::get_targets() const
 	return res;
 }
 
+namespace {
+	/**
+	 * Computed teleport maps, keyed on the querying unit and the view
+	 * parameters. Mouse-hover path previews recompute them continuously for
+	 * the same unit; entries stay valid until the ability cache generation
+	 * moves, which covers unit placement, time of day and tunnel changes.
+	 */
+	typedef std::tuple<std::size_t, int, bool, bool, bool> teleport_cache_key;
+	std::map<teleport_cache_key, teleport_map> teleport_cache;
+	std::size_t teleport_cache_generation = 0;
+}
+
 const teleport_map get_teleport_locations(const unit &u,
 	const team &viewing_team,
 	bool see_all, bool ignore_units, bool check_vision)
 {
+	const std::size_t generation = unit_abilities::cache_generation();
+	if (generation != teleport_cache_generation) {
+		teleport_cache.clear();
+		teleport_cache_generation = generation;
+	}
+
+	const teleport_cache_key key(u.underlying_id(), viewing_team.side(), see_all, ignore_units, check_vision);
+	const auto cached = teleport_cache.find(key);
+	if (cached != teleport_cache.end()) {
+		return cached->second;
+	}
+
 	std::vector<teleport_group> groups;
 
 	for (const unit_ability & teleport : u.get_abilities("teleport")) {
@@ -284,7 +311,8 @@ const teleport_map get_teleport_locations(const unit &u,
 	const std::vector<teleport_group>& global_groups = resources::tunnels->get();
 	groups.insert(groups.end(), global_groups.begin(), global_groups.end());
 
-	return teleport_map(groups, u, viewing_team, see_all, ignore_units, check_vision);
+	return teleport_cache.emplace(key,
+		teleport_map(groups, u, viewing_team, see_all, ignore_units, check_vision)).first->second;
 }
 
 manager::manager(const config &cfg) : tunnels_(), id_(cfg["next_teleport_group_id"].to_int(0)) {
@@ -303,6 +331,8 @@ manager::manager(const config &cfg) : tunnels_(), id_(cfg["next_teleport_group_i
 
 void manager::add(const teleport_group &group) {
 	tunnels_.push_back(group);
+	// Drop cached teleport maps built against the old tunnel list.
+	unit_abilities::invalidate_cache();
 }
 
 void manager::remove(const std::string &id) {
@@ -314,6 +344,8 @@ void manager::remove(const std::string &id) {
 			++t;
 		}
 	}
+	// Drop cached teleport maps built against the old tunnel list.
+	unit_abilities::invalidate_cache();
 }
 
 const std::vector<teleport_group>& manager::get() const {
@@ -24,6 +24,98 @@
 #include "map/map.hpp"
 
 
+namespace { // Precomputed ring offsets.
+
+	/**
+	 * The shape of a ring is invariant under translation of its center except
+	 * for the center's column parity (the y-offsets of hexes in neighbouring
+	 * columns depend on whether the center column is even or odd), so one
+	 * offset table per parity and radius covers every hex on any map.
+	 */
+	const std::vector<map_location>& ring_offsets(const int radius, const int parity)
+	{
+		static std::array<std::vector<std::vector<map_location>>, 2> tables;
+
+		std::vector<std::vector<map_location>>& table = tables[parity];
+		while ( table.size() <= static_cast<std::size_t>(radius) ) {
+			const int r = static_cast<int>(table.size());
+			std::vector<map_location> ring;
+
+			if ( r > 0 ) {
+				ring.reserve(6 * r);
+
+				// Walk the ring once around a canonical center of the right
+				// parity and record the relative offsets.
+				const map_location center(parity, 0);
+				map_location loc = center.get_direction(map_location::SOUTH_WEST, r);
+
+				for(int n = 0; n != 6; ++n) {
+					const map_location::DIRECTION dir = static_cast<map_location::DIRECTION>(n);
+					for(int i = 0; i != r; ++i) {
+						ring.emplace_back(loc.x - center.x, loc.y - center.y);
+						loc = loc.get_direction(dir, 1);
+					}
+				}
+			}
+
+			table.push_back(std::move(ring));
+		}
+
+		return table[radius];
+	}
+
+	/** Like ring_offsets(), but for the full disk of rings 1 through @a radius. */
+	const std::vector<map_location>& disk_offsets(const int radius, const int parity)
+	{
+		static std::array<std::vector<std::vector<map_location>>, 2> tables;
+
+		std::vector<std::vector<map_location>>& table = tables[parity];
+		while ( table.size() <= static_cast<std::size_t>(radius) ) {
+			const int r = static_cast<int>(table.size());
+			std::vector<map_location> disk;
+
+			if ( r > 0 ) {
+				disk = table[r - 1];
+				disk.reserve(3 * r * (r + 1));
+				const std::vector<map_location>& ring = ring_offsets(r, parity);
+				disk.insert(disk.end(), ring.begin(), ring.end());
+			}
+
+			table.push_back(std::move(disk));
+		}
+
+		return table[radius];
+	}
+
+	/** Column parity of a location, correct for the negative border columns. */
+	inline int col_parity(const map_location& loc)
+	{
+		return loc.x & 1;
+	}
+
+} // namespace for precomputed ring offsets
+
+
+tile_offset_view tile_ring(const map_location& center, int radius)
+{
+	if ( radius < 0 ) {
+		radius = 0;
+	}
+
+	return tile_offset_view(center, ring_offsets(radius, col_parity(center)));
+}
+
+
+tile_offset_view tiles_in_radius(const map_location& center, int radius)
+{
+	if ( radius < 0 ) {
+		radius = 0;
+	}
+
+	return tile_offset_view(center, disk_offsets(radius, col_parity(center)));
+}
+
+
 /**
  * Function that will add to @a result all locations exactly @a radius tiles
  * from @a center (or nothing if @a radius is not positive). @a result must be
@@ -36,15 +128,9 @@ void get_tile_ring(const map_location& center, const int radius,
 		return;
 	}
 
-	map_location loc = center.get_direction(map_location::SOUTH_WEST, radius);
-
-	for(int n = 0; n != 6; ++n) {
-		const map_location::DIRECTION dir = static_cast<map_location::DIRECTION>(n);
-		for(int i = 0; i != radius; ++i) {
-			result.push_back(loc);
-			loc = loc.get_direction(dir, 1);
-		}
-	}
+	const tile_offset_view ring = tile_ring(center, radius);
+	result.reserve(result.size() + ring.size());
+	result.insert(result.end(), ring.begin(), ring.end());
 }
 
 
@@ -56,9 +142,13 @@ void get_tile_ring(const map_location& center, const int radius,
 void get_tiles_in_radius(const map_location& center, const int radius,
                          std::vector<map_location>& result)
 {
-	for(int n = 1; n <= radius; ++n) {
-		get_tile_ring(center, n, result);
+	if ( radius <= 0 ) {
+		return;
 	}
+
+	const tile_offset_view disk = tiles_in_radius(center, radius);
+	result.reserve(result.size() + disk.size());
+	result.insert(result.end(), disk.begin(), disk.end());
 }
 
 
@@ -17,6 +17,8 @@
 
 #include "map/location.hpp"
 
+#include <iterator>
+
 class gamemap;
 
 class xy_pred
@@ -27,6 +29,86 @@ protected:
 	virtual ~xy_pred() {}
 };
 
+/**
+ * Lightweight range-for view over the hexes at fixed offsets from a center
+ * hex. The offsets come from tables precomputed once per radius (see
+ * tile_ring() and tiles_in_radius()), so iterating runs no per-hex direction
+ * math and materializes no container. Off-board hexes are included, just as
+ * with get_tile_ring(); callers must filter if they need on-board hexes only.
+ */
+class tile_offset_view
+{
+public:
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = map_location;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const map_location*;
+		using reference = map_location;
+
+		iterator(const map_location& center, const map_location* offset)
+			: center_(center)
+			, offset_(offset)
+		{
+		}
+
+		map_location operator*() const
+		{
+			return map_location(center_.x + offset_->x, center_.y + offset_->y);
+		}
+
+		iterator& operator++()
+		{
+			++offset_;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator res = *this;
+			++offset_;
+			return res;
+		}
+
+		bool operator==(const iterator& o) const { return offset_ == o.offset_; }
+		bool operator!=(const iterator& o) const { return offset_ != o.offset_; }
+
+	private:
+		map_location center_;
+		const map_location* offset_;
+	};
+
+	tile_offset_view(const map_location& center, const std::vector<map_location>& offsets)
+		: center_(center)
+		, offsets_(&offsets)
+	{
+	}
+
+	iterator begin() const { return iterator(center_, offsets_->data()); }
+	iterator end() const { return iterator(center_, offsets_->data() + offsets_->size()); }
+
+	std::size_t size() const { return offsets_->size(); }
+	bool empty() const { return offsets_->empty(); }
+
+private:
+	map_location center_;
+	const std::vector<map_location>* offsets_;
+};
+
+/**
+ * Returns a view of the locations exactly @a radius tiles from @a center
+ * (empty if @a radius is not positive).
+ */
+tile_offset_view tile_ring(const map_location& center, int radius);
+
+/**
+ * Returns a view of the locations within @a radius tiles of @a center,
+ * excluding @a center itself (empty if @a radius is not positive).
+ */
+tile_offset_view tiles_in_radius(const map_location& center, int radius);
+
 /**
  * Function that will add to @a result all locations exactly @a radius tiles
  * from @a center (or nothing if @a radius is not positive). @a result must be
@@ -45,6 +45,7 @@ void persist_file_context::load()
 			}
 		}
 	}
+	dirty_ = false;
 }
 
 persist_file_context::persist_file_context(const std::string &name_space)
@@ -62,6 +63,9 @@ bool persist_file_context::clear_var(const std::string &global, bool immediate)
 		config *node = get_node(bak, namespace_);
 		if (node)
 			bactive = node->child_or_add("variables");
+		// Merging starts from the on-disk state, so deferred writes have to
+		// hit the disk first or the reload would discard them.
+		flush();
 		load();
 	}
 	config *active = get_node(cfg_, namespace_);
@@ -108,9 +112,12 @@ bool persist_file_context::clear_var(const std::string &global, bool immediate)
 				}
 			}
 
-			if (!in_transaction_)
-				ret = save_context();
-			else if (immediate) {
+			if (!in_transaction_) {
+				// Write-behind: serve later reads from memory and let a
+				// flush() at the next safe point rewrite the file.
+				dirty_ = true;
+				ret = true;
+			} else if (immediate) {
 				ret = save_context();
 				cfg_ = bak;
 				active = get_node(cfg_, namespace_);
@@ -198,8 +205,15 @@ bool persist_file_context::save_context() {
 			}
 		}
 	}
+	if (success)
+		dirty_ = false;
 	return success;
 }
+
+bool persist_file_context::flush()
+{
+	return dirty_ ? save_context() : true;
+}
 bool persist_file_context::set_var(const std::string &global,const config &val, bool immediate)
 {
 	config bak;
@@ -207,6 +221,7 @@ bool persist_file_context::set_var(const std::string &global,const config &val,
 	if (immediate) {
 		bak = cfg_;
 		bactive = get_node(bak, namespace_, true)->child_or_add("variables");
+		flush();
 		load();
 	}
 
@@ -227,10 +242,10 @@ bool persist_file_context::set_var(const std::string &global,const config &val,
 			bactive.append(val);
 		}
 	}
-//	dirty_ = true;
-	if (!in_transaction_)
-		return save_context();
-	else if (immediate) {
+	if (!in_transaction_) {
+		dirty_ = true;
+		return true;
+	} else if (immediate) {
 		bool ret = save_context();
 		cfg_ = bak;
 		active = get_node(cfg_, namespace_, true);
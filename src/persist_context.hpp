@@ -104,12 +104,14 @@ protected:
 	name_space namespace_;
 	bool valid_;
 	bool in_transaction_;
+	bool dirty_;
 
 	persist_context()
 		: cfg_()
 		, namespace_()
 		, valid_(false)
 		, in_transaction_(false)
+		, dirty_(false)
 	{}
 
 	persist_context(const std::string &name_space)
@@ -117,6 +119,7 @@ protected:
 		, namespace_(name_space,true)
 		, valid_(namespace_.valid())
 		, in_transaction_(false)
+		, dirty_(false)
 	{}
 
 	config *get_node(config &cfg, name_space &ns, bool force = false) {
@@ -152,11 +155,13 @@ public:
 	virtual bool start_transaction () = 0;
 	virtual bool end_transaction () = 0;
 	virtual bool cancel_transaction () = 0;
+	/** Writes any unsaved changes to the backing store. */
+	virtual bool flush() = 0;
 	std::string get_node() const;
 	void set_node(const std::string &);
 	bool valid() const { return valid_; }
 	bool dirty() const {
-		return true;
+		return dirty_;
 	}
 	operator bool() const { return valid_; }
 };
@@ -169,9 +174,15 @@ private:
 
 public:
 	persist_file_context(const std::string &name_space);
+	virtual ~persist_file_context() {
+		try {
+			flush();
+		} catch (...) {}
+	}
 	bool clear_var(const std::string &, bool immediate = false);
 	config get_var(const std::string &) const;
 	bool set_var(const std::string &, const config &, bool immediate = false);
+	bool flush();
 
 	bool start_transaction () {
 		if (in_transaction_)
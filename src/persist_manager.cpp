@@ -42,6 +42,14 @@ persist_context &persist_manager::get_context(const std::string &ns)
 	return *ret;
 }
 
+bool persist_manager::flush_all() {
+	bool result = true;
+	for (context_map::reference ctx : contexts_) {
+		result &= ctx.second->flush();
+	}
+	return result;
+}
+
 bool persist_manager::start_transaction() {
 	if (in_transaction_) return false;
 	bool result = true;
@@ -31,6 +31,9 @@ class persist_manager {
 		bool end_transaction();
 		bool cancel_transaction();
 
+		/** Writes the unsaved changes of every context to disk, e.g. when saving the game. */
+		bool flush_all();
+
 		persist_manager();
 		virtual ~persist_manager();
 
@@ -22,8 +22,11 @@
 
 #include "config.hpp"
 #include "display.hpp"
+#include "events.hpp"
 #include "filesystem.hpp"
 #include "game_config.hpp"
+#include "game_version.hpp"
+#include "hash.hpp"
 #include "image_modifications.hpp"
 #include "log.hpp"
 #include "preferences/general.hpp"
@@ -33,7 +36,15 @@
 
 #include <SDL2/SDL_image.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/functional/hash_fwd.hpp>
@@ -42,6 +53,7 @@
 
 static lg::log_domain log_display("display");
 #define ERR_DP LOG_STREAM(err, log_display)
+#define WRN_DP LOG_STREAM(warn, log_display)
 #define LOG_DP LOG_STREAM(info, log_display)
 
 static lg::log_domain log_config("config");
@@ -117,6 +129,17 @@ public:
 		content_.clear();
 	}
 
+	/** Calls @a f on every cached element; used for cache budgeting. */
+	template<typename F>
+	void for_each(F f) const
+	{
+		for(const cache_item<T>& elt : content_) {
+			if(elt.loaded) {
+				f(elt.item);
+			}
+		}
+	}
+
 private:
 	std::vector<cache_item<T>> content_;
 };
@@ -154,6 +177,19 @@ namespace
 {
 image::locator::locator_finder_t locator_finder;
 
+/**
+ * Values of all interned locators, indexed by locator id. A deque keeps the
+ * references returned by locator::val() stable as new values are interned.
+ */
+std::deque<image::locator::locator_finder_t::key_type> locator_values;
+
+/**
+ * Maps unparsed path~MODS strings to locator ids, so repeatedly constructing
+ * a locator from the same string (as draw loops do every frame) skips both
+ * the markup parsing and the value hash.
+ */
+std::unordered_map<std::string, int> locator_string_memo;
+
 /** Definition of all image maps */
 image::image_cache images_, scaled_to_zoom_, hexed_images_, scaled_to_hex_images_, tod_colored_images_,
 		brightened_images_;
@@ -169,6 +205,15 @@ image::lit_cache lit_images_, lit_scaled_images_;
 // caches storing each lightmap generated
 image::lit_variants lightmaps_;
 
+// atlas pages shared by the terrain images, and the region caches into them.
+// Lit tiles get their own atlas since their cache is rebuilt on every Time of
+// Day color change; giving them separate pages lets those be released instead
+// of accumulating dead pixels in the long-lived pages.
+image::surface_atlas terrain_atlas(1024);
+image::surface_atlas lit_terrain_atlas(1024);
+image::atlas_cache atlas_regions_;
+image::lit_atlas_cache lit_atlas_regions_;
+
 // const int cache_version_ = 0;
 
 std::map<std::string, bool> image_existence_map;
@@ -183,6 +228,113 @@ int red_adjust = 0, green_adjust = 0, blue_adjust = 0;
 unsigned int zoom = tile_size;
 unsigned int cached_zoom = 0;
 
+/**
+ * Retired generations of the zoom-dependent caches, keyed by the zoom they
+ * were rendered at. Wheel zooming bounces between a handful of fixed
+ * levels, so instead of rescaling everything again on each step, the
+ * previous level's surfaces are kept around and swapped back in when that
+ * level is revisited. The retired levels share a byte budget; the levels
+ * furthest from the current zoom are dropped first when it overflows.
+ */
+struct zoom_cache_level
+{
+	image::image_cache scaled_to_zoom;
+	image::image_cache scaled_to_hex;
+	image::lit_cache lit_scaled;
+};
+
+std::map<unsigned int, zoom_cache_level> retired_zoom_caches;
+const std::size_t retired_zoom_cache_budget = 64 * 1024 * 1024;
+
+std::size_t surface_bytes(const surface& surf)
+{
+	return surf ? static_cast<std::size_t>(surf->w) * surf->h * 4 : 0;
+}
+
+std::size_t zoom_cache_level_bytes(const zoom_cache_level& level)
+{
+	std::size_t total = 0;
+	level.scaled_to_zoom.for_each([&total](const surface& s) { total += surface_bytes(s); });
+	level.scaled_to_hex.for_each([&total](const surface& s) { total += surface_bytes(s); });
+	level.lit_scaled.for_each([&total](const image::lit_variants& variants) {
+		for(const auto& lit : variants) {
+			total += surface_bytes(lit.second);
+		}
+	});
+
+	return total;
+}
+
+void prune_retired_zoom_caches()
+{
+	std::size_t total = 0;
+	for(const auto& level : retired_zoom_caches) {
+		total += zoom_cache_level_bytes(level.second);
+	}
+
+	while(total > retired_zoom_cache_budget && !retired_zoom_caches.empty()) {
+		const auto furthest = std::max_element(
+			retired_zoom_caches.begin(), retired_zoom_caches.end(), [](const auto& a, const auto& b) {
+				return std::abs(static_cast<int>(a.first) - static_cast<int>(zoom))
+					< std::abs(static_cast<int>(b.first) - static_cast<int>(zoom));
+			});
+
+		total -= zoom_cache_level_bytes(furthest->second);
+		retired_zoom_caches.erase(furthest);
+	}
+}
+
+/**
+ * Retired generations of the color-adjustment-dependent caches, keyed by
+ * the (r, g, b) adjustment they were rendered under. A time-of-day
+ * schedule cycles through the same few tints every day, so like the zoom
+ * levels above, a phase change swaps the previous generation back in
+ * instead of recoloring every visible image again.
+ */
+struct tint_cache_level
+{
+	image::image_cache tod_colored;
+	image::image_cache brightened;
+	image::lit_cache lit;
+};
+
+std::map<std::tuple<int, int, int>, tint_cache_level> retired_tint_caches;
+const std::size_t retired_tint_cache_budget = 64 * 1024 * 1024;
+
+std::size_t tint_cache_level_bytes(const tint_cache_level& level)
+{
+	std::size_t total = 0;
+	level.tod_colored.for_each([&total](const surface& s) { total += surface_bytes(s); });
+	level.brightened.for_each([&total](const surface& s) { total += surface_bytes(s); });
+	level.lit.for_each([&total](const image::lit_variants& variants) {
+		for(const auto& lit : variants) {
+			total += surface_bytes(lit.second);
+		}
+	});
+
+	return total;
+}
+
+void prune_retired_tint_caches()
+{
+	std::size_t total = 0;
+	for(const auto& level : retired_tint_caches) {
+		total += tint_cache_level_bytes(level.second);
+	}
+
+	// Unlike zoom levels, tints have no useful distance metric, so just
+	// drop the biggest levels until the budget is met.
+	while(total > retired_tint_cache_budget && !retired_tint_caches.empty()) {
+		const auto biggest = std::max_element(
+			retired_tint_caches.begin(), retired_tint_caches.end(), [](const auto& a, const auto& b) {
+				return tint_cache_level_bytes(a.second) < tint_cache_level_bytes(b.second);
+			});
+
+		total -= tint_cache_level_bytes(biggest->second);
+		retired_tint_caches.erase(biggest);
+	}
+}
+
 const std::string data_uri_prefix = "data:";
 struct parsed_data_URI{
 	explicit parsed_data_URI(std::string_view data_URI);
@@ -219,17 +371,163 @@ mini_terrain_cache_map mini_highlighted_terrain_cache;
 
 static int last_index_ = 0;
 
+static void add_localized_overlay(const std::string& ovr_file, surface& orig_surf);
+
+namespace
+{
+
+/**
+ * Background image decoding pipeline (see prefetch_image()).
+ *
+ * All path resolution happens on the caller's thread when a job is queued;
+ * the workers only read and decode the already resolved files, so they never
+ * touch the filesystem lookup caches or the image caches.
+ */
+struct prefetch_job
+{
+	std::string filename;
+	std::string location;
+	std::string ovr_location;
+};
+
+std::mutex prefetch_mutex;
+std::condition_variable prefetch_cond;
+std::deque<prefetch_job> prefetch_queue;
+std::set<std::string> prefetch_pending;
+std::map<std::string, surface> prefetch_ready;
+std::vector<std::thread> prefetch_workers;
+bool prefetch_exit = false;
+
+surface decode_image_file(const prefetch_job& job)
+{
+	filesystem::rwops_ptr rwops = filesystem::make_read_RWops(job.location);
+	surface res = IMG_Load_RW(rwops.release(), true); // SDL takes ownership of rwops
+
+	if(res && !job.ovr_location.empty()) {
+		add_localized_overlay(job.ovr_location, res);
+	}
+
+	return res;
+}
+
+void prefetch_worker()
+{
+	for(;;) {
+		prefetch_job job;
+
+		{
+			std::unique_lock<std::mutex> lock(prefetch_mutex);
+			prefetch_cond.wait(lock, []() { return prefetch_exit || !prefetch_queue.empty(); });
+
+			if(prefetch_exit) {
+				return;
+			}
+
+			job = std::move(prefetch_queue.front());
+			prefetch_queue.pop_front();
+		}
+
+		surface res = decode_image_file(job);
+
+		{
+			std::lock_guard<std::mutex> lock(prefetch_mutex);
+			prefetch_pending.erase(job.filename);
+			if(res) {
+				prefetch_ready[job.filename] = res;
+			}
+		}
+
+		prefetch_cond.notify_all();
+	}
+}
+
+/**
+ * Takes the prefetched decode result for @a filename, if there is one.
+ * A decode that is already running is waited for instead of being duplicated;
+ * a job that is merely queued is dropped so the caller decodes it itself.
+ */
+surface take_prefetched(const std::string& filename)
+{
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+
+	for(auto job = prefetch_queue.begin(); job != prefetch_queue.end(); ++job) {
+		if(job->filename == filename) {
+			prefetch_queue.erase(job);
+			prefetch_pending.erase(filename);
+			return surface(nullptr);
+		}
+	}
+
+	if(prefetch_pending.count(filename) != 0) {
+		prefetch_cond.wait(lock, [&filename]() { return prefetch_pending.count(filename) == 0; });
+	}
+
+	auto it = prefetch_ready.find(filename);
+	if(it == prefetch_ready.end()) {
+		return surface(nullptr);
+	}
+
+	surface res = it->second;
+	prefetch_ready.erase(it);
+	return res;
+}
+
+void stop_prefetch_workers()
+{
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		prefetch_exit = true;
+	}
+
+	prefetch_cond.notify_all();
+
+	for(std::thread& worker : prefetch_workers) {
+		worker.join();
+	}
+
+	prefetch_workers.clear();
+	prefetch_queue.clear();
+	prefetch_pending.clear();
+	prefetch_ready.clear();
+	prefetch_exit = false;
+}
+
+/** Makes sure the workers are also stopped when no image::manager was ever created. */
+struct prefetch_shutdown_guard
+{
+	~prefetch_shutdown_guard()
+	{
+		stop_prefetch_workers();
+	}
+} shutdown_guard;
+
+} // end anon namespace
+
 void flush_cache()
 {
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		for(const prefetch_job& job : prefetch_queue) {
+			prefetch_pending.erase(job.filename);
+		}
+		prefetch_queue.clear();
+		prefetch_ready.clear();
+	}
 	{
 		images_.flush();
 		hexed_images_.flush();
 		tod_colored_images_.flush();
 		scaled_to_zoom_.flush();
 		scaled_to_hex_images_.flush();
+		retired_zoom_caches.clear();
+		retired_tint_caches.clear();
 		brightened_images_.flush();
 		lit_images_.flush();
 		lit_scaled_images_.flush();
+		atlas_regions_.flush();
+		lit_atlas_regions_.flush();
+		terrain_atlas.clear();
+		lit_terrain_atlas.clear();
 		in_hex_info_.flush();
 		is_empty_hex_.flush();
 		mini_terrain_cache.clear();
@@ -238,6 +536,7 @@ void flush_cache()
 		reversed_images_.clear();
 		image_existence_map.clear();
 		precached_dirs.clear();
+		modification::flush_decode_cache();
 	}
 	/* We can't reset last_index_, since some locators are still alive
 	   when using :refresh. That would cause them to point to the wrong
@@ -245,21 +544,29 @@ void flush_cache()
 	// last_index_ = 0;
 }
 
-void locator::init_index()
+int locator::intern(value val)
 {
-	auto i = locator_finder.find(val_);
+	auto i = locator_finder.find(val);
 
-	if(i == locator_finder.end()) {
-		index_ = last_index_++;
-		locator_finder.emplace(val_, index_);
-	} else {
-		index_ = i->second;
+	if(i != locator_finder.end()) {
+		return i->second;
 	}
+
+	int index = last_index_++;
+	locator_finder.emplace(val, index);
+	locator_values.push_back(std::move(val));
+	return index;
+}
+
+const locator::value& locator::val() const
+{
+	static const value none;
+	return index_ < 0 ? none : locator_values[index_];
 }
 
-void locator::parse_arguments()
+void locator::parse_arguments(value& val)
 {
-	std::string& fn = val_.filename_;
+	std::string& fn = val.filename_;
 	if(fn.empty()) {
 		return;
 	}
@@ -273,58 +580,57 @@ void locator::parse_arguments()
 			ERR_DP << "Invalid data URI: " << stripped << std::endl;
 		}
 
-		val_.is_data_uri_ = true;
+		val.is_data_uri_ = true;
 	}
 
 	std::size_t markup_field = fn.find('~');
 
 	if(markup_field != std::string::npos) {
-		val_.type_ = SUB_FILE;
-		val_.modifications_ = fn.substr(markup_field, fn.size() - markup_field);
+		val.type_ = SUB_FILE;
+		val.modifications_ = fn.substr(markup_field, fn.size() - markup_field);
 		fn = fn.substr(0, markup_field);
 	}
 }
 
 locator::locator()
 	: index_(-1)
-	, val_()
 {
 }
 
 locator::locator(const locator& a, const std::string& mods)
-	: index_(-1)
-	, val_(a.val_)
+	: index_(a.index_)
 {
 	if(!mods.empty()) {
-		val_.modifications_ += mods;
-		val_.type_ = SUB_FILE;
-		init_index();
-	} else {
-		index_ = a.index_;
+		value val = a.val();
+		val.modifications_ += mods;
+		val.type_ = SUB_FILE;
+		index_ = intern(std::move(val));
 	}
 }
 
 locator::locator(const char* filename)
-	: index_(-1)
-	, val_(filename)
+	: locator(std::string(filename))
 {
-	parse_arguments();
-	init_index();
 }
 
 locator::locator(const std::string& filename)
 	: index_(-1)
-	, val_(filename)
 {
-	parse_arguments();
-	init_index();
+	auto cached = locator_string_memo.find(filename);
+	if(cached != locator_string_memo.end()) {
+		index_ = cached->second;
+		return;
+	}
+
+	value val(filename);
+	parse_arguments(val);
+	index_ = intern(std::move(val));
+	locator_string_memo.emplace(filename, index_);
 }
 
 locator::locator(const std::string& filename, const std::string& modifications)
-	: index_(-1)
-	, val_(filename, modifications)
+	: index_(intern(value(filename, modifications)))
 {
-	init_index();
 }
 
 locator::locator(const std::string& filename,
@@ -332,16 +638,13 @@ locator::locator(const std::string& filename,
 		int center_x,
 		int center_y,
 		const std::string& modifications)
-	: index_(-1)
-	, val_(filename, loc, center_x, center_y, modifications)
+	: index_(intern(value(filename, loc, center_x, center_y, modifications)))
 {
-	init_index();
 }
 
 locator& locator::operator=(const locator& a)
 {
 	index_ = a.index_;
-	val_ = a.val_;
 
 	return *this;
 }
@@ -456,6 +759,11 @@ static void add_localized_overlay(const std::string& ovr_file, surface& orig_sur
 
 static surface load_image_file(const image::locator& loc)
 {
+	// A background prefetch may already have decoded this file.
+	if(surface pre = take_prefetched(loc.get_filename())) {
+		return pre;
+	}
+
 	surface res;
 
 	std::string location = filesystem::get_binary_file_location("images", loc.get_filename());
@@ -490,6 +798,48 @@ static surface load_image_file(const image::locator& loc)
 	return res;
 }
 
+/** Bump to invalidate every on-disk cache entry for composed image chains. */
+static const int mod_cache_version = 1;
+
+/**
+ * Returns the on-disk cache file holding the composed result of running
+ * @a loc's modification chain, or an empty string when the result cannot be
+ * cached. The name is content-addressed: it hashes the source image bytes,
+ * the modification string and the game revision, so edited images or changed
+ * chains never hit a stale entry.
+ */
+static std::string modified_image_cache_file(const image::locator& loc)
+{
+	const std::string& cache_dir = filesystem::get_cache_dir();
+	if(cache_dir.empty()) {
+		return std::string();
+	}
+
+	std::string location = filesystem::get_binary_file_location("images", loc.get_filename());
+	if(location.empty()) {
+		return std::string();
+	}
+
+	const std::string loc_location = filesystem::get_localized_path(location);
+	if(!loc_location.empty()) {
+		location = loc_location;
+	}
+
+	std::string source;
+	try {
+		source = filesystem::read_file(location);
+	} catch(const filesystem::io_exception&) {
+		return std::string();
+	}
+
+	const std::string key = std::to_string(mod_cache_version) + "\n"
+		+ game_config::revision + "\n"
+		+ loc.get_modifications() + "\n"
+		+ utils::sha1(source).hex_digest();
+
+	return cache_dir + "/images/" + utils::sha1(key).hex_digest() + ".png";
+}
+
 static surface load_image_sub_file(const image::locator& loc)
 {
 	surface surf = get_image(loc.get_filename(), UNSCALED);
@@ -497,29 +847,58 @@ static surface load_image_sub_file(const image::locator& loc)
 		return nullptr;
 	}
 
-	modification_queue mods = modification::decode(loc.get_modifications());
+	// Composed modification chains are expensive to recompute on every start,
+	// so the result of the whole chain is kept on disk, keyed by the source
+	// image contents and the modification string. The per-hex cutting below
+	// is cheap and is always done on the composed image.
+	std::string cache_file;
+	bool composed_from_cache = false;
+
+	if(!loc.get_modifications().empty()) {
+		cache_file = modified_image_cache_file(loc);
+	}
+
+	if(!cache_file.empty() && filesystem::file_exists(cache_file)) {
+		surface cached = IMG_Load_RW(filesystem::make_read_RWops(cache_file).release(), true);
+		if(cached != nullptr) {
+			surf = cached;
+			composed_from_cache = true;
+		}
+	}
+
+	if(!composed_from_cache) {
+		modification_queue mods = modification::decode(loc.get_modifications());
 
-	while(!mods.empty()) {
-		modification* mod = mods.top();
+		while(!mods.empty()) {
+			modification* mod = mods.top();
 
-		try {
-			surf = (*mod)(surf);
-		} catch(const image::modification::imod_exception& e) {
-			std::ostringstream ss;
-			ss << "\n";
+			try {
+				surf = (*mod)(surf);
+			} catch(const image::modification::imod_exception& e) {
+				std::ostringstream ss;
+				ss << "\n";
+
+				for(const std::string& mod_name : utils::parenthetical_split(loc.get_modifications(), '~')) {
+					ss << "\t" << mod_name << "\n";
+				}
 
-			for(const std::string& mod_name : utils::parenthetical_split(loc.get_modifications(), '~')) {
-				ss << "\t" << mod_name << "\n";
+				ERR_CFG << "Failed to apply a modification to an image:\n"
+						<< "Image: " << loc.get_filename() << "\n"
+						<< "Modifications: " << ss.str() << "\n"
+						<< "Error: " << e.message << "\n";
 			}
 
-			ERR_CFG << "Failed to apply a modification to an image:\n"
-					<< "Image: " << loc.get_filename() << "\n"
-					<< "Modifications: " << ss.str() << "\n"
-					<< "Error: " << e.message << "\n";
+			// NOTE: do this *after* applying the mod or you'll get crashes!
+			mods.pop();
 		}
 
-		// NOTE: do this *after* applying the mod or you'll get crashes!
-		mods.pop();
+		if(!cache_file.empty() && surf != nullptr) {
+			filesystem::make_directory(filesystem::get_cache_dir() + "/images");
+			if(IMG_SavePNG_RW(surf, filesystem::make_write_RWops(cache_file).release(), true) != 0) {
+				WRN_DP << "could not cache composed image " << loc.get_filename()
+					   << loc.get_modifications() << std::endl;
+			}
+		}
 	}
 
 	if(loc.get_loc().valid()) {
@@ -658,9 +1037,56 @@ static surface apply_light(surface surf, const light_string& ls)
 
 bool locator::file_exists() const
 {
-	return val_.is_data_uri_
-		? parsed_data_URI{val_.filename_}.good
-		: !filesystem::get_binary_file_location("images", val_.filename_).empty();
+	return val().is_data_uri_
+		? parsed_data_URI{val().filename_}.good
+		: !filesystem::get_binary_file_location("images", val().filename_).empty();
+}
+
+void prefetch_image(const std::string& filename)
+{
+	if(filename.empty()) {
+		return;
+	}
+
+	// Skip files that are already decoded.
+	if(locator(filename).in_cache(images_)) {
+		return;
+	}
+
+	// Resolve all paths up front; the workers must not touch the filesystem
+	// lookup caches.
+	std::string location = filesystem::get_binary_file_location("images", filename);
+	if(location.empty()) {
+		return;
+	}
+
+	const std::string loc_location = filesystem::get_localized_path(location);
+	std::string ovr_location;
+	if(!loc_location.empty()) {
+		location = loc_location;
+	} else {
+		ovr_location = filesystem::get_localized_path(location, "--overlay");
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+		if(prefetch_pending.count(filename) != 0 || prefetch_ready.count(filename) != 0) {
+			return;
+		}
+
+		prefetch_pending.insert(filename);
+		prefetch_queue.push_back(prefetch_job{filename, location, ovr_location});
+
+		// A small pool is plenty; decoding is cheap compared to rendering,
+		// it just should not happen on the main thread mid-battle.
+		const std::size_t max_workers = 2;
+		if(prefetch_workers.size() < max_workers && prefetch_workers.size() < prefetch_queue.size()) {
+			prefetch_workers.emplace_back(&prefetch_worker);
+		}
+	}
+
+	prefetch_cond.notify_one();
 }
 
 surface load_from_disk(const locator& loc)
@@ -685,20 +1111,50 @@ manager::manager()
 
 manager::~manager()
 {
+	stop_prefetch_workers();
 	flush_cache();
 }
 
 void set_color_adjustment(int r, int g, int b)
 {
 	if(r != red_adjust || g != green_adjust || b != blue_adjust) {
+		// Retire the current tint's caches and revive the new tint's
+		// generation when one exists, so that after the first full
+		// day/night cycle a phase change is a cache swap rather than a
+		// recoloring of every visible image.
+		tint_cache_level& retired = retired_tint_caches[std::make_tuple(red_adjust, green_adjust, blue_adjust)];
+		retired.tod_colored = std::move(tod_colored_images_);
+		retired.brightened = std::move(brightened_images_);
+		retired.lit = std::move(lit_images_);
+
 		red_adjust = r;
 		green_adjust = g;
 		blue_adjust = b;
-		tod_colored_images_.flush();
-		brightened_images_.flush();
-		lit_images_.flush();
+
+		const auto revived = retired_tint_caches.find(std::make_tuple(r, g, b));
+		if(revived != retired_tint_caches.end()) {
+			tod_colored_images_ = std::move(revived->second.tod_colored);
+			brightened_images_ = std::move(revived->second.brightened);
+			lit_images_ = std::move(revived->second.lit);
+			retired_tint_caches.erase(revived);
+		} else {
+			tod_colored_images_.flush();
+			brightened_images_.flush();
+			lit_images_.flush();
+		}
+
 		lit_scaled_images_.flush();
+		lit_atlas_regions_.flush();
+		lit_terrain_atlas.clear();
 		reversed_images_.clear();
+
+		// The retired lit surfaces were rendered under the old adjustment
+		// and must not be swapped back in.
+		for(auto& level : retired_zoom_caches) {
+			level.second.lit_scaled.flush();
+		}
+
+		prune_retired_tint_caches();
 	}
 }
 
@@ -710,14 +1166,42 @@ void set_zoom(unsigned int amount)
 		brightened_images_.flush();
 		reversed_images_.clear();
 
-		// We keep these caches if:
-		// we use default zoom (it doesn't need those)
-		// or if they are already at the wanted zoom.
-		if(zoom != tile_size && zoom != cached_zoom) {
-			scaled_to_zoom_.flush();
-			scaled_to_hex_images_.flush();
-			lit_scaled_images_.flush();
+		// The retired tint generations hold zoom-dependent surfaces too.
+		retired_tint_caches.clear();
+
+		// The atlas region caches don't distinguish the zoom the packed
+		// surfaces were rendered at, so they can't be kept across any change.
+		atlas_regions_.flush();
+		lit_atlas_regions_.flush();
+		terrain_atlas.clear();
+		lit_terrain_atlas.clear();
+
+		if(zoom != cached_zoom) {
+			// Retire the current generation instead of flushing it, and
+			// bring back the generation of the new zoom when it is still
+			// around, so stepping the wheel between levels only rescales
+			// images which were never rendered at that level before.
+			if(cached_zoom != 0) {
+				zoom_cache_level& retired = retired_zoom_caches[cached_zoom];
+				retired.scaled_to_zoom = std::move(scaled_to_zoom_);
+				retired.scaled_to_hex = std::move(scaled_to_hex_images_);
+				retired.lit_scaled = std::move(lit_scaled_images_);
+			}
+
+			const auto revived = retired_zoom_caches.find(zoom);
+			if(revived != retired_zoom_caches.end()) {
+				scaled_to_zoom_ = std::move(revived->second.scaled_to_zoom);
+				scaled_to_hex_images_ = std::move(revived->second.scaled_to_hex);
+				lit_scaled_images_ = std::move(revived->second.lit_scaled);
+				retired_zoom_caches.erase(revived);
+			} else {
+				scaled_to_zoom_.flush();
+				scaled_to_hex_images_.flush();
+				lit_scaled_images_.flush();
+			}
+
 			cached_zoom = zoom;
+			prune_retired_zoom_caches();
 		}
 	}
 }
@@ -938,6 +1422,48 @@ surface get_lighted_image(const image::locator& i_locator, const light_string& l
 	return res;
 }
 
+atlas_region get_atlas_region(const image::locator& i_locator, TYPE type)
+{
+	if(i_locator.is_void()) {
+		return atlas_region();
+	}
+
+	if(i_locator.in_cache(atlas_regions_)) {
+		return i_locator.locate_in_cache(atlas_regions_);
+	}
+
+	atlas_region res = terrain_atlas.insert(get_image(i_locator, type));
+	i_locator.add_to_cache(atlas_regions_, res);
+
+	return res;
+}
+
+atlas_region get_lighted_atlas_region(const image::locator& i_locator, const light_string& ls, TYPE type)
+{
+	if(i_locator.is_void()) {
+		return atlas_region();
+	}
+
+	// if no light variants yet, need to add an empty map
+	if(!i_locator.in_cache(lit_atlas_regions_)) {
+		i_locator.add_to_cache(lit_atlas_regions_, lit_region_variants());
+	}
+
+	// need access to add it if not found
+	{ // enclose reference pointing to data stored in a changing vector
+		const lit_region_variants& lvar = i_locator.locate_in_cache(lit_atlas_regions_);
+		auto lvi = lvar.find(ls);
+		if(lvi != lvar.end()) {
+			return lvi->second;
+		}
+	}
+
+	atlas_region res = lit_terrain_atlas.insert(get_lighted_image(i_locator, ls, type));
+	i_locator.access_in_cache(lit_atlas_regions_)[ls] = res;
+
+	return res;
+}
+
 surface get_hexmask()
 {
 	static const image::locator terrain_mask(game_config::images::terrain_mask);
@@ -1106,4 +1632,18 @@ save_result save_image(const surface& surf, const std::string& filename)
 	return save_result::unsupported_format;
 }
 
+void save_image_async(const surface& surf, const std::string& filename,
+		const std::function<void(save_result)>& callback)
+{
+	// Encoding a 4K screenshot blocks for a second or more, so do the
+	// encode and write on a throwaway worker. The surface refcount keeps
+	// the pixels alive; call_in_main_thread() hands the result back through
+	// the events queue and also keeps the worker joined-in-spirit — it
+	// blocks until the main thread has run the callback.
+	std::thread([surf, filename, callback]() {
+		const save_result res = save_image(surf, filename);
+		events::call_in_main_thread([&callback, res]() { callback(res); });
+	}).detach();
+}
+
 } // end namespace image
@@ -15,9 +15,11 @@
 
 #pragma once
 
+#include "image_atlas.hpp"
 #include "map/location.hpp"
 #include "terrain/translation.hpp"
 
+#include <functional>
 #include <unordered_map>
 
 class surface;
@@ -75,19 +77,19 @@ public:
 	bool operator!=(const locator& a) const { return index_ != a.index_; }
 	bool operator<(const locator& a) const { return index_ < a.index_; }
 
-	const std::string& get_filename() const { return val_.filename_; }
-	bool is_data_uri() const { return val_.is_data_uri_; }
-	const map_location& get_loc() const { return val_.loc_ ; }
-	int get_center_x() const { return val_.center_x_; }
-	int get_center_y() const { return val_.center_y_; }
-	const std::string& get_modifications() const {return val_.modifications_;}
-	type get_type() const { return val_.type_; }
+	const std::string& get_filename() const { return val().filename_; }
+	bool is_data_uri() const { return val().is_data_uri_; }
+	const map_location& get_loc() const { return val().loc_ ; }
+	int get_center_x() const { return val().center_x_; }
+	int get_center_y() const { return val().center_y_; }
+	const std::string& get_modifications() const {return val().modifications_;}
+	type get_type() const { return val().type_; }
 	// const int get_index() const { return index_; };
 
 	/**
 	 * Returns @a true if the locator does not correspond to an actual image.
 	 */
-	bool is_void() const { return val_.type_ == NONE; }
+	bool is_void() const { return val().type_ == NONE; }
 
 	/**
 	 * Tests whether the file the locator points at exists.
@@ -115,11 +117,6 @@ public:
 	void add_to_cache(cache_type<T>& cache, const T& data) const;
 
 private:
-	// Called by each constructor after actual construction to
-	// initialize the index_ field
-	void init_index();
-	void parse_arguments();
-
 	struct value
 	{
 		value();
@@ -146,8 +143,16 @@ public:
 private:
 	friend struct std::hash<value>;
 
+	/** Returns the id of the interned @a val, creating it on first sight. */
+	static int intern(value val);
+
+	/** Strips any trailing ~MOD() chain of @a val's filename into its modifications. */
+	static void parse_arguments(value& val);
+
+	/** The interned value this locator stands for. */
+	const value& val() const;
+
 	int index_;
-	value val_;
 };
 
 surface load_from_disk(const locator& loc);
@@ -181,6 +186,15 @@ typedef std::map<light_string, surface> lit_variants;
 /** Lit variants for each locator. */
 typedef cache_type<lit_variants> lit_cache;
 
+/** Atlas regions for each locator. */
+typedef cache_type<atlas_region> atlas_cache;
+
+/** Type used to pair light possibilities with the corresponding lit atlas region. */
+typedef std::map<light_string, atlas_region> lit_region_variants;
+
+/** Lit atlas region variants for each locator. */
+typedef cache_type<lit_region_variants> lit_atlas_cache;
+
 /**
  * Returns the light_string for one light operation.
  *
@@ -259,6 +273,28 @@ surface get_image(const locator& i_locator, TYPE type = UNSCALED);
  */
 surface get_lighted_image(const image::locator& i_locator, const light_string& ls, TYPE type);
 
+/**
+ * Caches and returns an image packed into a shared atlas page.
+ *
+ * Terrain tiles are drawn thousands at a time each frame from a pool of a few
+ * hundred distinct images. Packing them into shared pages lets the blit loop
+ * read from a handful of large surfaces instead of one small allocation per
+ * tile, which is considerably friendlier to the CPU cache.
+ *
+ * @param i_locator            Image path.
+ * @param type                 This should be either HEXED or SCALED_TO_HEX.
+ */
+atlas_region get_atlas_region(const locator& i_locator, TYPE type);
+
+/**
+ * Caches and returns an atlas region with a lightmap applied to it.
+ *
+ * @param i_locator            Image path.
+ * @param ls                   Light map to apply to the image.
+ * @param type                 This should be either HEXED or SCALED_TO_HEX.
+ */
+atlas_region get_lighted_atlas_region(const image::locator& i_locator, const light_string& ls, TYPE type);
+
 /**
  * Retrieves the standard hexagonal tile mask.
  */
@@ -290,6 +326,15 @@ surface reverse_image(const surface& surf);
  */
 bool exists(const locator& i_locator);
 
+/**
+ * Queues @a filename (a standard image path, without modifications) for
+ * decoding on a background worker thread, so that a later get_image() call
+ * finds it already decoded. Use this to warm the cache as soon as it becomes
+ * known that an image will be needed, e.g. for the unit types in a side's
+ * recruit list, instead of hitching on PNG decoding at first render.
+ */
+void prefetch_image(const std::string& filename);
+
 /**
  * Precache the existence of files in a binary path subdirectory (e.g. "terrain/").
  */
@@ -308,4 +353,14 @@ enum class save_result
 save_result save_image(const locator& i_locator, const std::string& outfile);
 save_result save_image(const surface& surf, const std::string& outfile);
 
+/**
+ * As save_image(), but encodes and writes the file on a worker thread.
+ *
+ * @a callback runs on the main thread via the events queue once the write
+ * has finished, so the caller must keep pumping events (any gui2 loop
+ * does). The surface must not be modified before the callback has run.
+ */
+void save_image_async(const surface& surf, const std::string& outfile,
+		const std::function<void(save_result)>& callback);
+
 }
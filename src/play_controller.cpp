@@ -45,6 +45,7 @@
 #include "log.hpp"
 #include "map/label.hpp"
 #include "pathfind/teleport.hpp"
+#include "picture.hpp"
 #include "preferences/credentials.hpp"
 #include "preferences/display.hpp"
 #include "preferences/game.hpp"
@@ -70,6 +71,7 @@
 #include "whiteboard/manager.hpp"
 
 #include <functional>
+#include <set>
 
 static lg::log_domain log_aitesting("ai/testing");
 #define LOG_AIT LOG_STREAM(info, log_aitesting)
@@ -234,6 +236,49 @@ void play_controller::init(const config& level)
 		gui2::dialogs::loading_screen::progress(loading_stage::load_units);
 		preferences::encounter_all_content(gamestate().board_);
 
+		// Decode the sounds of the unit types on the map while the loading
+		// screen is still up, so the first hit or death sound doesn't stall
+		// on disk access mid-battle. The sound lists are gathered straight
+		// from the animation configs, without forcing animation parsing.
+		std::set<std::string> unit_sound_lists;
+		std::set<std::string> preloaded_types;
+		const std::function<void(const config&)> collect_sounds = [&](const config& cfg) {
+			for(const config::any_child child : cfg.all_children_range()) {
+				if(!child.cfg["sound"].empty()) {
+					unit_sound_lists.insert(child.cfg["sound"].str());
+				}
+				collect_sounds(child.cfg);
+			}
+		};
+
+		for(const unit& u : gamestate().board_.units()) {
+			if(preloaded_types.insert(u.type_id()).second) {
+				collect_sounds(u.type().get_cfg());
+			}
+		}
+
+		for(const std::string& files : unit_sound_lists) {
+			sound::preload_sound(files);
+		}
+
+		// Likewise queue the sprites of the units on the map and of the
+		// sides' recruitable types for background decoding, so the first
+		// turn renders without waiting on the disk.
+		for(const unit& u : gamestate().board_.units()) {
+			image::prefetch_image(u.absolute_image());
+			image::prefetch_image(u.small_profile());
+		}
+
+		for(const team& t : get_teams()) {
+			for(const std::string& recruit : t.recruits()) {
+				// CREATED is enough for the sprite path and avoids forcing
+				// a full build of types that may never be recruited.
+				if(const unit_type* type = unit_types.find(recruit, unit_type::CREATED)) {
+					image::prefetch_image(type->image());
+				}
+			}
+		}
+
 		LOG_NG << "initializing theme... " << (SDL_GetTicks() - ticks()) << std::endl;
 		gui2::dialogs::loading_screen::progress(loading_stage::init_theme);
 		const config& theme_cfg = controller_base::get_theme(game_config_, theme());
@@ -595,6 +640,13 @@ void play_controller::finish_side_turn()
 
 	mouse_handler_.deselect_hex();
 	gamestate_->init_side_done() = false;
+
+	// A side change is a natural pause point: run a full collection so
+	// incremental debt left by the side's events doesn't spill over into
+	// interactive play.
+	if(gamestate().lua_kernel_) {
+		gamestate().lua_kernel_->full_gc();
+	}
 }
 
 void play_controller::finish_turn()
@@ -1149,6 +1201,13 @@ void play_controller::play_slice_catch()
 		return;
 	}
 
+	// Pay the Lua collection debt in a small budgeted slice per loop
+	// iteration, so heavy UMC allocation doesn't trip a collector pause
+	// in the middle of a frame.
+	if(gamestate().lua_kernel_) {
+		gamestate().lua_kernel_->step_gc();
+	}
+
 	try {
 		play_slice();
 	} catch(const return_to_play_side_exception&) {
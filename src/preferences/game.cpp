@@ -867,6 +867,10 @@ compression::format save_compression_format()
 	} else if(choice == "bzip2") {
 #ifdef HAVE_BZIP2
 		return compression::BZIP2;
+#endif
+	} else if(choice == "zstd") {
+#ifdef HAVE_ZSTD
+		return compression::ZSTD;
 #endif
 	} else if(choice == "none" || choice == "no") { // see above
 		return compression::NONE;
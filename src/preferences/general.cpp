@@ -35,6 +35,9 @@
 #include "video.hpp" // non_interactive()
 #include "game_config_view.hpp"
 
+#include <future>
+#include <sstream>
+
 static lg::log_domain log_config("config");
 #define ERR_CFG LOG_STREAM(err , log_config)
 
@@ -48,6 +51,16 @@ bool no_preferences_save = false;
 bool fps = false;
 
 config prefs;
+
+/**
+ * Cached scroll_speed(); negative until the first read. This getter is
+ * consulted for every scroll event, so it shouldn't do a config lookup
+ * and lexical cast each time.
+ */
+int scroll_speed_cache = -1;
+
+/** The preferences write still running on the background thread, if any. */
+std::future<void> pending_prefs_write;
 }
 
 namespace preferences {
@@ -95,6 +108,10 @@ base_manager::~base_manager()
 		prefs["scroll_threshold"] = mouse_scroll_threshold();
 
 		write_preferences();
+
+		// This is the last chance before the process exits; make sure the
+		// background write actually reached the disk.
+		finish_preferences_write();
 	} catch (...) {}
 }
 
@@ -129,16 +146,38 @@ void prefs_event_handler::handle_window_event(const SDL_Event& event)
 
 void write_preferences()
 {
-	try {
-		filesystem::scoped_ostream prefs_file = filesystem::ostream_file(filesystem::get_prefs_file());
-		write(*prefs_file, prefs);
-	} catch(const filesystem::io_exception&) {
-		ERR_FS << "error writing to preferences file '" << filesystem::get_prefs_file() << "'" << std::endl;
-	}
+	// Serialize on this thread while the state is stable; the disk write,
+	// which is what can stutter the UI on slow disks, runs on a background
+	// thread into a temporary file that then atomically replaces the old
+	// one, so a crash or full disk can no longer truncate the preferences.
+	finish_preferences_write();
+
+	std::ostringstream out;
+	write(out, prefs);
+
+	pending_prefs_write = std::async(std::launch::async,
+		[text = out.str(), path = filesystem::get_prefs_file()]() {
+			const std::string temp = path + ".new";
+			try {
+				filesystem::write_file(temp, text);
+			} catch(const filesystem::io_exception&) {
+				ERR_FS << "error writing to preferences file '" << temp << "'" << std::endl;
+				return;
+			}
+
+			filesystem::rename_file(temp, path);
+		});
 
 	preferences::save_credentials();
 }
 
+void finish_preferences_write()
+{
+	if(pending_prefs_write.valid()) {
+		pending_prefs_write.get();
+	}
+}
+
 void set(const std::string &key, bool value)
 {
 	prefs[key] = value;
@@ -235,6 +274,9 @@ void load_base_prefs() {
 				<< e.what()
 				<< std::endl;
 	}
+
+	// Reloading can change any value, so drop the mirrored copies.
+	scroll_speed_cache = -1;
 }
 
 
@@ -729,16 +771,19 @@ namespace {
 
 int scroll_speed()
 {
-	const int value = std::clamp<int>(lexical_cast_default<int>(get("scroll"), 50), 1, 100);
-	scroll = value/100.0;
+	if(scroll_speed_cache < 0) {
+		scroll_speed_cache = std::clamp<int>(lexical_cast_default<int>(get("scroll"), 50), 1, 100);
+		scroll = scroll_speed_cache / 100.0;
+	}
 
-	return value;
+	return scroll_speed_cache;
 }
 
 void set_scroll_speed(const int new_speed)
 {
 	prefs["scroll"] = new_speed;
 	scroll = new_speed / 100.0;
+	scroll_speed_cache = std::clamp<int>(new_speed, 1, 100);
 }
 
 bool middle_click_scrolls()
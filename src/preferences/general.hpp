@@ -44,8 +44,16 @@ namespace preferences {
 	extern const int min_font_scaling;
 	extern const int max_font_scaling;
 
+	/**
+	 * Writes the preferences to disk. The preferences are serialized right
+	 * away, but the file itself is written on a background thread and
+	 * atomically replaces the previous one.
+	 */
 	void write_preferences();
 
+	/** Blocks until a background preferences write has finished. */
+	void finish_preferences_write();
+
 	void set(const std::string& key, const std::string &value);
 	void set(const std::string& key, char const *value);
 	void set(const std::string& key, bool value);
@@ -20,6 +20,7 @@
 #include "replay.hpp"
 #include "resources.hpp"
 #include "playsingle_controller.hpp"
+#include "video.hpp"
 
 static lg::log_domain log_engine("engine");
 #define DBG_NG LOG_STREAM(debug, log_engine)
@@ -54,6 +55,15 @@ struct replay_play_turn : public replay_controller::replay_stop_condition
 	virtual bool should_stop() { return turn_begin_ != turn_current_; }
 };
 
+struct replay_play_upto_turn : public replay_controller::replay_stop_condition
+{
+	int turn_target_;
+	int turn_current_;
+	replay_play_upto_turn(int turn_current, int turn_target) : turn_target_(turn_target), turn_current_(turn_current) {}
+	virtual void new_side_turn(int , int turn) { turn_current_ = turn; }
+	virtual bool should_stop() { return turn_current_ >= turn_target_; }
+};
+
 struct replay_play_side : public replay_controller::replay_stop_condition
 {
 	bool next_side_;
@@ -71,6 +81,7 @@ replay_controller::replay_controller(play_controller& controller, bool control_v
 	, reset_state_(reset_state)
 	, on_end_replay_(on_end_replay)
 	, return_to_play_side_(false)
+	, skip_until_stopped_(false)
 {
 	if(control_view) {
 		vision_ = HUMAN_TEAM;
@@ -127,6 +138,19 @@ void replay_controller::replay_next_move()
 	update_enabled_buttons();
 }
 
+void replay_controller::replay_goto_turn(int turn)
+{
+	stop_condition_.reset(new replay_play_upto_turn(controller_.gamestate().tod_manager_.turn(), turn));
+	// Force skipping until the target turn so the fast-forward doesn't
+	// animate or redraw anything on the way; play_side_impl() restores the
+	// previous mode and refreshes the display once the condition stops.
+	if(!controller_.is_skipping_replay()) {
+		controller_.toggle_skipping_replay();
+	}
+	skip_until_stopped_ = true;
+	update_enabled_buttons();
+}
+
 //move all sides till stop/end
 void replay_controller::play_replay()
 {
@@ -169,6 +193,17 @@ REPLAY_RETURN replay_controller::play_side_impl()
 	update_enabled_buttons();
 	while(!return_to_play_side_ && !static_cast<playsingle_controller&>(controller_).get_player_type_changed())
 	{
+		if(skip_until_stopped_ && stop_condition_->should_stop()) {
+			// A fast-forward requested by replay_goto_turn() has reached its
+			// target (or was stopped early); drop the forced skipping and
+			// bring the frozen display up to date.
+			skip_until_stopped_ = false;
+			if(controller_.is_skipping_replay()) {
+				controller_.toggle_skipping_replay();
+			}
+			update_gui();
+		}
+
 		if(!stop_condition_->should_stop())
 		{
 			if(resources::recorder->at_end()) {
@@ -191,7 +226,13 @@ REPLAY_RETURN replay_controller::play_side_impl()
 					stop_condition_->new_side_turn(controller_.current_side(), controller_.gamestate().tod_manager_.turn());
 				}
 			}
-			controller_.play_slice(false);
+			// Keep presentation suppressed between commands as well: without
+			// this the slice below redraws every hex the last command
+			// invalidated, which is what dominates fast-forward time.
+			{
+				update_locker lock_update(CVideo::get_singleton(), controller_.is_skipping_replay());
+				controller_.play_slice(false);
+			}
 
 			// Update the buttons once, on the transition from not-stopped to stopped.
 			if(stop_condition_->should_stop()) {
@@ -43,6 +43,13 @@ public:
 	void replay_next_turn();
 	void replay_next_side();
 	void replay_next_move();
+	/**
+	 * Fast-forward to the start of turn @a turn with the presentation layer
+	 * suppressed: no animations, no redraws, just the synced commands run
+	 * against the game state. Does nothing if that turn has already begun;
+	 * jumping backwards goes through the replay reset instead.
+	 */
+	void replay_goto_turn(int turn);
 	REPLAY_RETURN play_side_impl();
 
 	bool recorder_at_end() const;
@@ -91,4 +98,6 @@ private:
 	std::shared_ptr<config> reset_state_;
 	std::function<void()> on_end_replay_;
 	bool return_to_play_side_;
+	/** True while a replay_goto_turn() fast-forward forces skipping on. */
+	bool skip_until_stopped_;
 };
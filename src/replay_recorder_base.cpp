@@ -15,10 +15,14 @@
 #include "replay_recorder_base.hpp"
 #include "serialization/binary_or_text.hpp"
 
+#include <sstream>
+
 replay_recorder_base::replay_recorder_base(void)
 	: upload_log_()
 	, commands_()
 	, pos_(0)
+	, serialized_()
+	, serialized_ends_()
 {
 
 }
@@ -34,6 +38,8 @@ void replay_recorder_base::swap(replay_recorder_base& other)
 	commands_.swap(other.commands_);
 	std::swap(pos_, other.pos_);
 	upload_log_.swap(other.upload_log_);
+	serialized_.swap(other.serialized_);
+	serialized_ends_.swap(other.serialized_ends_);
 }
 
 int replay_recorder_base::get_pos() const
@@ -49,12 +55,15 @@ int replay_recorder_base::size() const
 config& replay_recorder_base::get_command_at(int pos)
 {
 	assert(pos < size());
+	// The caller may edit the command through the returned reference.
+	truncate_serialized(pos);
 	return commands_[pos];
 }
 
 config& replay_recorder_base::add_child()
 {
 	assert(pos_ <= size());
+	truncate_serialized(pos_);
 	commands_.insert(commands_.begin() + pos_, new config());
 	++pos_;
 	return commands_[pos_ - 1];
@@ -76,6 +85,7 @@ config& replay_recorder_base::get_upload_log()
 void replay_recorder_base::remove_command(int index)
 {
 	assert(index < size());
+	truncate_serialized(index);
 	commands_.erase(commands_.begin() + index);
 	if(index < pos_)
 	{
@@ -86,6 +96,7 @@ void replay_recorder_base::remove_command(int index)
 config& replay_recorder_base::insert_command(int index)
 {
 	assert(index <= size());
+	truncate_serialized(index);
 	if(index < pos_)
 	{
 		++pos_;
@@ -139,8 +150,51 @@ void replay_recorder_base::write(config& out) const
 		out.add_child("command", commands_[i]);
 	}
 }
+const std::string& replay_recorder_base::serialized_commands(config& remainder)
+{
+	// Everything from the last "real" command onwards may still be edited in
+	// place through references held by the current synced action (checkup
+	// results and trailing chat), so only the commands before it are cached.
+	int stable = pos_;
+	while(stable > 0) {
+		const config& c = commands_[stable - 1];
+		--stable;
+		if(!(c["dependent"].to_bool(false) || !c["undo"].to_bool(true) || c["async"].to_bool(false))) {
+			break;
+		}
+	}
+
+	truncate_serialized(stable);
+
+	std::ostringstream out;
+	for(int i = static_cast<int>(serialized_ends_.size()); i < stable; ++i) {
+		out.str("");
+		// This matches what config_writer::write_child("command", ...) emits
+		// inside an open [replay] child.
+		write_open_child(out, "command", 1);
+		::write(out, commands_[i], 2);
+		write_close_child(out, "command", 1);
+		serialized_ += out.str();
+		serialized_ends_.push_back(serialized_.size());
+	}
+
+	for(int i = stable; i < pos_; ++i) {
+		remainder.add_child("command", commands_[i]);
+	}
+	return serialized_;
+}
+
+void replay_recorder_base::truncate_serialized(int fresh)
+{
+	if(static_cast<int>(serialized_ends_.size()) > fresh) {
+		serialized_.resize(fresh > 0 ? serialized_ends_[fresh - 1] : 0);
+		serialized_ends_.resize(fresh);
+	}
+}
+
 void replay_recorder_base::delete_upcoming_commands()
 {
+	truncate_serialized(pos_);
 	commands_.resize(pos_);
 }
 
@@ -53,11 +53,32 @@ public:
 
 	void write(config& out) const;
 
+	/**
+	 * Returns the commands before @a get_pos() as WML text, split for saving.
+	 *
+	 * The leading commands that can no longer be edited in place are kept as
+	 * an incrementally maintained, pre-serialized text (formatted for nesting
+	 * level 1, i.e. directly inside [replay]), so each save appends only the
+	 * commands recorded since the previous one instead of re-serializing the
+	 * whole history. The trailing commands that the running synced action may
+	 * still write to, e.g. checkup results, are copied into @a remainder and
+	 * have to be serialized by the caller.
+	 */
+	const std::string& serialized_commands(config& remainder);
+
 	void delete_upcoming_commands();
 protected:
+	/** Drops cached command text from index @a fresh onwards. */
+	void truncate_serialized(int fresh);
+
 	config upload_log_;
 	boost::ptr_vector<config> commands_;
 	int pos_;
+
+	/** Pre-serialized WML of the leading commands, see serialized_commands(). */
+	std::string serialized_;
+	/** End offset of each cached command's text within @ref serialized_. */
+	std::vector<std::size_t> serialized_ends_;
 };
 
 /** Implement non-member swap function for std::swap (calls @ref replay_recorder_base::swap). */
@@ -107,9 +107,10 @@ void save_index_class::clean_up_index()
 	filesystem::get_files_in_dir(dir(), &filenames);
 
 	if(root.all_children_count() > filenames.size()) {
-		root.remove_children("save", [&filenames](const config& d)
+		const std::set<std::string> present(filenames.begin(), filenames.end());
+		root.remove_children("save", [&present](const config& d)
 			{
-				return std::find(filenames.begin(), filenames.end(), d["save"]) == filenames.end();
+				return present.count(d["save"]) == 0;
 			}
 		);
 	}
@@ -319,7 +320,7 @@ static filesystem::scoped_istream find_save_file(const std::string& dir,
 
 void read_save_file(const std::string& dir, const std::string& name, config& cfg, std::string* error_log)
 {
-	static const std::vector<std::string> suffixes{"", ".gz", ".bz2"};
+	static const std::vector<std::string> suffixes{"", ".gz", ".bz2", ".zst"};
 	filesystem::scoped_istream file_stream = find_save_file(dir, name, suffixes);
 
 	cfg.clear();
@@ -332,6 +333,8 @@ void read_save_file(const std::string& dir, const std::string& name, config& cfg
 			read_gz(cfg, *file_stream);
 		} else if(filesystem::is_bzip2_file(name)) {
 			read_bz2(cfg, *file_stream);
+		} else if(filesystem::is_zstd_file(name)) {
+			read_zstd(cfg, *file_stream);
 		} else {
 			read(cfg, *file_stream);
 		}
@@ -373,13 +376,27 @@ void save_index_class::delete_old_auto_saves(const int autosavemax, const int in
 		return;
 	}
 
+	// Batch the index update: delete_game() would rewrite and recompress the
+	// whole index once per deleted save, which gets expensive with hundreds
+	// of autosaves in the directory.
+	bool removed_any = false;
+	config& root = data();
+
 	std::vector<save_info> games = get_saves_list(&auto_save);
 	for(std::vector<save_info>::iterator i = games.begin(); i != games.end(); ++i) {
 		if(countdown-- <= 0) {
 			LOG_SAVE << "Deleting savegame '" << i->name() << "'\n";
-			delete_game(i->name());
+			filesystem::delete_file(dir() + "/" + i->name());
+
+			const std::string& name = i->name();
+			root.remove_children("save", [&name](const config& d) { return name == d["save"]; });
+			removed_any = true;
 		}
 	}
+
+	if(removed_any) {
+		write_save_index();
+	}
 }
 
 void save_index_class::delete_game(const std::string& name)
@@ -158,20 +158,22 @@ saved_game::saved_game(const saved_game& state)
 
 void saved_game::set_carryover_sides_start(config carryover_sides_start)
 {
-	carryover_.swap(carryover_sides_start);
+	carryover_ = std::move(carryover_sides_start);
 	has_carryover_expanded_ = false;
 }
 
 void saved_game::set_random_seed()
 {
-	if(has_carryover_expanded_ || !carryover_["random_seed"].empty()) {
+	if(has_carryover_expanded_ || !carryover_.read()["random_seed"].empty()) {
 		return;
 	}
 
 	std::stringstream stream;
 	stream << std::setfill('0') << std::setw(8) << std::hex << randomness::generator->get_random_int(0, INT_MAX);
-	carryover_["random_seed"] = stream.str();
-	carryover_["random_calls"] = 0;
+
+	config& carryover = carryover_.write();
+	carryover["random_seed"] = stream.str();
+	carryover["random_calls"] = 0;
 }
 
 void saved_game::write_config(config_writer& out) const
@@ -179,8 +181,8 @@ void saved_game::write_config(config_writer& out) const
 	write_general_info(out);
 	write_starting_point(out);
 
-	if(!replay_start_.empty()) {
-		out.write_child("replay_start", replay_start_);
+	if(!replay_start_.read().empty()) {
+		out.write_child("replay_start", replay_start_.read());
 	}
 
 	out.open_child("replay");
@@ -193,16 +195,16 @@ void saved_game::write_config(config_writer& out) const
 void saved_game::write_starting_point(config_writer& out) const
 {
 	if(starting_point_type_ == starting_point::SNAPSHOT) {
-		out.write_child("snapshot", starting_point_);
+		out.write_child("snapshot", starting_point_.read());
 	} else if(starting_point_type_ == starting_point::SCENARIO) {
-		out.write_child("scenario", starting_point_);
+		out.write_child("scenario", starting_point_.read());
 	}
 }
 
 void saved_game::write_carryover(config_writer& out) const
 {
 	assert(not_corrupt());
-	out.write_child(has_carryover_expanded_ ? "carryover_sides" : "carryover_sides_start", carryover_);
+	out.write_child(carryover_tag(), carryover_.read());
 }
 
 void saved_game::write_general_info(config_writer& out) const
@@ -222,12 +224,14 @@ void saved_game::set_defaults()
 		"carryover_add",
 	};
 
+	config& starting_point = starting_point_.write();
+
 	if(const config& campaign = game_config.find_child("campaign", "id", classification_.campaign)) {
 		bool require_campaign = campaign["require_campaign"].to_bool(true);
-		starting_point_["require_scenario"] = require_campaign;
+		starting_point["require_scenario"] = require_campaign;
 	}
 
-	for(config& side : starting_point_.child_range("side")) {
+	for(config& side : starting_point.child_range("side")) {
 		// Set save_id default value directly after loading to its default to prevent different default behaviour in
 		// mp_connect code and sp code.
 
@@ -253,7 +257,7 @@ void saved_game::set_defaults()
 
 		// Set some team specific values to their defaults specified in scenario
 		for(const std::string& att_name : team_defaults) {
-			const config::attribute_value* scenario_value = starting_point_.get(att_name);
+			const config::attribute_value* scenario_value = starting_point.get(att_name);
 			config::attribute_value& team_value = side[att_name];
 
 			if(scenario_value && team_value.empty()) {
@@ -266,11 +270,11 @@ void saved_game::set_defaults()
 void saved_game::expand_scenario()
 {
 	if(starting_point_type_ == starting_point::NONE && !has_carryover_expanded_) {
-		game_config_manager::get()->load_game_config_for_game(classification(), carryover_["next_scenario"]);
+		game_config_manager::get()->load_game_config_for_game(classification(), carryover_.read()["next_scenario"]);
 
 		const game_config_view& game_config = game_config_manager::get()->game_config();
 		const config& scenario =
-			game_config.find_child(classification().get_tagname(), "id", carryover_["next_scenario"]);
+			game_config.find_child(classification().get_tagname(), "id", carryover_.read()["next_scenario"]);
 
 		if(scenario) {
 			starting_point_type_ = starting_point::SCENARIO;
@@ -284,7 +288,7 @@ void saved_game::expand_scenario()
 			update_label();
 			set_defaults();
 		} else {
-			ERR_NG << "Couldn't find [" << classification().get_tagname() << "] with id=" << carryover_["next_scenario"] << std::endl;
+			ERR_NG << "Couldn't find [" << classification().get_tagname() << "] with id=" << carryover_.read()["next_scenario"] << std::endl;
 			starting_point_type_ = starting_point::INVALID;
 			starting_point_.clear();
 		}
@@ -293,16 +297,17 @@ void saved_game::expand_scenario()
 
 void saved_game::check_require_scenario()
 {
-	const std::string version_default = starting_point_["addon_id"].empty() ? game_config::wesnoth_version.str() : "";
+	const config& starting_point = starting_point_.read();
+	const std::string version_default = starting_point["addon_id"].empty() ? game_config::wesnoth_version.str() : "";
 	config scenario;
-	scenario["id"] = starting_point_["addon_id"].str("mainline");
-	scenario["name"] = starting_point_["addon_title"].str("mainline");
-	scenario["version"] = starting_point_["addon_version"].str(version_default);
-	scenario["min_version"] = starting_point_["addon_min_version"];
-	scenario["required"] = starting_point_["require_scenario"].to_bool(false);
+	scenario["id"] = starting_point["addon_id"].str("mainline");
+	scenario["name"] = starting_point["addon_title"].str("mainline");
+	scenario["version"] = starting_point["addon_version"].str(version_default);
+	scenario["min_version"] = starting_point["addon_min_version"];
+	scenario["required"] = starting_point["require_scenario"].to_bool(false);
 	config& content = scenario.add_child("content");
-	content["id"] = starting_point_["id"];
-	content["name"] = starting_point_["name"];
+	content["id"] = starting_point["id"];
+	content["name"] = starting_point["name"];
 	content["type"] = "scenario";
 
 	mp_settings_.update_addon_requirements(scenario);
@@ -334,27 +339,29 @@ void saved_game::load_non_scenario(const std::string& type, const std::string& i
 		mp_settings_.update_addon_requirements(non_scenario);
 
 		// Copy events
+		config& starting_point = starting_point_.write();
+
 		for(const config& modevent : cfg.child_range("event")) {
 			if(modevent["enable_if"].empty()
-				|| variable_to_bool(carryover_.child_or_empty("variables"), modevent["enable_if"])
+				|| variable_to_bool(carryover_.read().child_or_empty("variables"), modevent["enable_if"])
 			) {
-				starting_point_.add_child_at_total("event", modevent, pos++);
+				starting_point.add_child_at_total("event", modevent, pos++);
 			}
 		}
 
 		// Copy lua
 		for(const config& modlua : cfg.child_range("lua")) {
-			starting_point_.add_child_at_total("lua", modlua, pos++);
+			starting_point.add_child_at_total("lua", modlua, pos++);
 		}
 
 		// Copy modify_unit_type
 		for(const config& modlua : cfg.child_range("modify_unit_type")) {
-			starting_point_.add_child_at_total("modify_unit_type", modlua, pos++);
+			starting_point.add_child_at_total("modify_unit_type", modlua, pos++);
 		}
 
 		// Copy load_resource
 		for(const config& load_resource : cfg.child_range("load_resource")) {
-			starting_point_.add_child_at_total("load_resource", load_resource, pos++);
+			starting_point.add_child_at_total("load_resource", load_resource, pos++);
 		}
 	} else {
 		// TODO: A user message instead?
@@ -370,7 +377,7 @@ void saved_game::expand_mp_events()
 {
 	expand_scenario();
 
-	if(starting_point_type_ == starting_point::SCENARIO && !starting_point_["has_mod_events"].to_bool(false)) {
+	if(starting_point_type_ == starting_point::SCENARIO && !starting_point_.read()["has_mod_events"].to_bool(false)) {
 		std::vector<modevents_entry> mods;
 		std::set<std::string> loaded_resources;
 
@@ -388,22 +395,25 @@ void saved_game::expand_mp_events()
 		}
 
 		for(modevents_entry& mod : mods) {
-			load_non_scenario(mod.type, mod.id, starting_point_.all_children_count());
+			load_non_scenario(mod.type, mod.id, starting_point_.read().all_children_count());
 		}
 		mods.clear();
 
-		while(starting_point_.has_child("load_resource")) {
-			assert(starting_point_.child_count("load_resource") > 0);
-			std::string id = starting_point_.child("load_resource")["id"];
-			size_t pos = starting_point_.find_total_first_of("load_resource");
-			starting_point_.remove_child("load_resource", 0);
+		while(starting_point_.read().has_child("load_resource")) {
+			config& starting_point = starting_point_.write();
+			assert(starting_point.child_count("load_resource") > 0);
+			std::string id = starting_point.child("load_resource")["id"];
+			size_t pos = starting_point.find_total_first_of("load_resource");
+			starting_point.remove_child("load_resource", 0);
 			if(loaded_resources.find(id) == loaded_resources.end()) {
 				loaded_resources.insert(id);
 				load_non_scenario("resource", id, pos);
 			}
 		}
-		starting_point_["has_mod_events"] = true;
-		starting_point_["loaded_resources"] = utils::join(loaded_resources);
+
+		config& starting_point = starting_point_.write();
+		starting_point["has_mod_events"] = true;
+		starting_point["loaded_resources"] = utils::join(loaded_resources);
 	}
 }
 
@@ -420,7 +430,7 @@ void saved_game::expand_mp_options()
 		mods.emplace_back("multiplayer", get_scenario_id());
 		mods.emplace_back("campaign", classification().campaign);
 
-		config& variables = carryover_.child_or_add("variables");
+		config& variables = carryover_.write().child_or_add("variables");
 
 		for(modevents_entry& mod : mods) {
 			if(const config& cfg = mp_settings().options.find_child(mod.type, "id", mod.id)) {
@@ -477,30 +487,32 @@ void saved_game::expand_random_scenario()
 
 	if(starting_point_type_ == starting_point::SCENARIO) {
 		// If the entire scenario should be randomly generated
-		if(!starting_point_["scenario_generation"].empty()) {
+		if(!starting_point_.read()["scenario_generation"].empty()) {
 			LOG_NG << "randomly generating scenario...\n";
 			const cursor::setter cursor_setter(cursor::WAIT);
 
 			config scenario_new =
-				random_generate_scenario(starting_point_["scenario_generation"], starting_point_.child("generator"), &carryover_.child_or_empty("variables"));
+				random_generate_scenario(starting_point_.read()["scenario_generation"], starting_point_.read().child("generator"), &carryover_.read().child_or_empty("variables"));
 
-			post_scenario_generation(starting_point_, scenario_new);
+			post_scenario_generation(starting_point_.read(), scenario_new);
 			starting_point_ = std::move(scenario_new);
 
 			update_label();
 			set_defaults();
 		}
 
+		config& starting_point = starting_point_.write();
+
 		// If no map_data is provided, try to load the specified file directly
-		expand_map_file(starting_point_);
+		expand_map_file(starting_point);
 		// If the map should be randomly generated
 		// We don’t want that we accidentally to this twice so we check for starting_point_["map_data"].empty()
-		if(starting_point_["map_data"].empty() && !starting_point_["map_generation"].empty()) {
+		if(starting_point["map_data"].empty() && !starting_point["map_generation"].empty()) {
 			LOG_NG << "randomly generating map...\n";
 			const cursor::setter cursor_setter(cursor::WAIT);
 
-			starting_point_["map_data"] =
-				random_generate_map(starting_point_["map_generation"], starting_point_.child("generator"), &carryover_.child_or_empty("variables"));
+			starting_point["map_data"] =
+				random_generate_map(starting_point["map_generation"], starting_point.child("generator"), &carryover_.read().child_or_empty("variables"));
 		}
 	}
 }
@@ -536,7 +548,7 @@ void saved_game::expand_carryover()
 {
 	expand_scenario();
 	if(starting_point_type_ == starting_point::SCENARIO && !has_carryover_expanded_) {
-		carryover_info sides(carryover_);
+		carryover_info sides(carryover_.read());
 
 		sides.transfer_to(get_starting_point());
 		for(config& side_cfg : get_starting_point().child_range("side")) {
@@ -556,15 +568,15 @@ bool saved_game::valid() const
 config& saved_game::set_snapshot(config snapshot)
 {
 	starting_point_type_ = starting_point::SNAPSHOT;
-	starting_point_.swap(snapshot);
+	starting_point_ = std::move(snapshot);
 
-	return starting_point_;
+	return starting_point_.write();
 }
 
 void saved_game::set_scenario(config scenario)
 {
 	starting_point_type_ = starting_point::SCENARIO;
-	starting_point_.swap(scenario);
+	starting_point_ = std::move(scenario);
 
 	has_carryover_expanded_ = false;
 
@@ -579,13 +591,13 @@ void saved_game::remove_snapshot()
 
 config& saved_game::get_starting_point()
 {
-	return starting_point_;
+	return starting_point_.write();
 }
 
 const config& saved_game::get_replay_starting_point()
 {
-	if(!replay_start_.empty()) {
-		return replay_start_;
+	if(!replay_start_.read().empty()) {
+		return replay_start_.read();
 	}
 
 	if(!has_carryover_expanded_) {
@@ -595,19 +607,19 @@ const config& saved_game::get_replay_starting_point()
 	}
 
 	if(starting_point_type_ == starting_point::SCENARIO) {
-		return starting_point_;
+		return starting_point_.read();
 	}
 
-	return replay_start_.child("some_non_existet_invalid");
+	return replay_start_.read().child("some_non_existet_invalid");
 }
 
 void saved_game::convert_to_start_save()
 {
 	assert(starting_point_type_ == starting_point::SNAPSHOT);
 
-	carryover_info sides(starting_point_, true);
+	carryover_info sides(starting_point_.read(), true);
 
-	sides.merge_old_carryover(carryover_info(carryover_));
+	sides.merge_old_carryover(carryover_info(carryover_.read()));
 	sides.rng().rotate_random();
 
 	carryover_ = sides.to_config();
@@ -625,19 +637,19 @@ config saved_game::to_config() const
 	// TODO: remove this code duplication with write_... functions.
 	config r = classification_.to_config();
 
-	if(!replay_start_.empty()) {
-		r.add_child("replay_start", replay_start_);
+	if(!replay_start_.read().empty()) {
+		r.add_child("replay_start", replay_start_.read());
 	}
 
 	replay_data_.write(r.add_child("replay"));
 
 	if(starting_point_type_ == starting_point::SNAPSHOT) {
-		r.add_child("snapshot", starting_point_);
+		r.add_child("snapshot", starting_point_.read());
 	} else if(starting_point_type_ == starting_point::SCENARIO) {
-		r.add_child("scenario", starting_point_);
+		r.add_child("scenario", starting_point_.read());
 	}
 
-	r.add_child(has_carryover_expanded_ ? "carryover_sides" : "carryover_sides_start", carryover_);
+	r.add_child(has_carryover_expanded_ ? "carryover_sides" : "carryover_sides_start", carryover_.read());
 	r.add_child("multiplayer", mp_settings_.to_config());
 
 	return r;
@@ -648,11 +660,11 @@ std::string saved_game::get_scenario_id() const
 	std::string scenario_id;
 
 	if(starting_point_type_ == starting_point::SNAPSHOT || starting_point_type_ == starting_point::SCENARIO) {
-		scenario_id = starting_point_["id"].str();
+		scenario_id = starting_point_.read()["id"].str();
 	} else if(!has_carryover_expanded_) {
-		scenario_id = carryover_["next_scenario"].str();
-	} else if(!replay_start_.empty()) {
-		scenario_id = replay_start_["id"].str();
+		scenario_id = carryover_.read()["next_scenario"].str();
+	} else if(!replay_start_.read().empty()) {
+		scenario_id = replay_start_.read()["id"].str();
 	} else {
 		assert(!"cannot figure out scenario_id");
 		throw "assertion ignored";
@@ -671,9 +683,9 @@ void saved_game::update_label()
 	std::string& label = classification().label;
 
 	if(classification().abbrev.empty()) {
-		label = starting_point_["name"].str();
+		label = starting_point_.read()["name"].str();
 	} else {
-		label = classification().abbrev + "-" + starting_point_["name"];
+		label = classification().abbrev + "-" + starting_point_.read()["name"];
 	}
 
 	label.erase(std::remove_if(label.begin(), label.end(), is_illegal_file_char), label.end());
@@ -682,7 +694,7 @@ void saved_game::update_label()
 
 void saved_game::cancel_orders()
 {
-	for(config& side : starting_point_.child_range("side")) {
+	for(config& side : starting_point_.write().child_range("side")) {
 		// for humans "goto_x/y" is used for multi-turn-moves
 		// for the ai "goto_x/y" is a way for wml to order the ai to move a unit to a certain place.
 		// we want to cancel human order but not to break wml.
@@ -699,7 +711,7 @@ void saved_game::cancel_orders()
 
 void saved_game::unify_controllers()
 {
-	for(config& side : starting_point_.child_range("side")) {
+	for(config& side : starting_point_.write().child_range("side")) {
 		side.remove_attribute("is_local");
 		//TODO: the old code below is probably not needed anymore
 		if(side["controller"] == "network") {
@@ -774,7 +786,7 @@ void saved_game::set_data(config& cfg)
 		starting_point_.clear();
 	}
 
-	LOG_NG << "scenario: '" << carryover_["next_scenario"].str() << "'\n";
+	LOG_NG << "scenario: '" << carryover_.read()["next_scenario"].str() << "'\n";
 
 	if(const config& stats = cfg.child("statistics")) {
 		statistics::fresh_stats();
@@ -18,6 +18,7 @@
 #include "game_classification.hpp"
 #include "mp_game_settings.hpp"
 #include "replay_recorder_base.hpp"
+#include "utils/cow_config.hpp"
 
 class config_writer;
 
@@ -119,9 +120,21 @@ public:
 	std::string get_scenario_id() const;
 	/** @return the config from which the game will be started. (this is [scenario] or [snapshot] in the savefile) */
 	config& get_starting_point();
-	const config& get_starting_point() const { return starting_point_; }
-	config& replay_start() { return replay_start_; }
-	const config& replay_start() const { return replay_start_; }
+	const config& get_starting_point() const { return starting_point_.read(); }
+	config& replay_start() { return replay_start_.write(); }
+	const config& replay_start() const { return replay_start_.read(); }
+
+	/**
+	 * O(1) copy-on-write captures of the large state blocks, for
+	 * serializing a mid-game save off the main thread. The returned
+	 * handles share the trees; the game's next mutation through write()
+	 * clones first, so the captures stay consistent without a deep copy.
+	 */
+	utils::cow_config share_starting_point() const { return starting_point_; }
+	utils::cow_config share_replay_start() const { return replay_start_; }
+	utils::cow_config share_carryover() const { return carryover_; }
+	/** The tag write_carryover() serializes the carryover under. */
+	const char* carryover_tag() const { return has_carryover_expanded_ ? "carryover_sides" : "carryover_sides_start"; }
 
 	bool not_corrupt() const;
 	/** sets classification().label to the correct value. */
@@ -146,9 +159,9 @@ private:
 		if true:  The carryover information for all sides from the previous scenario that aren't used in this scenario (to be carried over to the next scenario).
 		if false: The carryover information for all sides from the previous scenario.
 	*/
-	config carryover_;
+	utils::cow_config carryover_;
 	/** snapshot made before the start event. To be used as a starting pos for replays */
-	config replay_start_;
+	utils::cow_config replay_start_;
 	/** some general information of the game that doesn't change during the game */
 	game_classification classification_;
 	mp_game_settings mp_settings_;
@@ -158,7 +171,7 @@ private:
 		The starting pos where the (non replay) game will be started from.
 		This can eigher be a [scenario] for a fresh game or a [snapshot] if this is a reloaded game
 	*/
-	config starting_point_;
+	utils::cow_config starting_point_;
 
 	replay_recorder_base replay_data_;
 
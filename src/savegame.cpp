@@ -50,7 +50,11 @@
 #include "video.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <iomanip>
+#include <mutex>
+#include <utility>
 
 static lg::log_domain log_engine("engine");
 #define LOG_SAVE LOG_STREAM(info, log_engine)
@@ -70,6 +74,8 @@ bool save_game_exists(std::string name, compression::format compressed)
 
 void clean_saves(const std::string& label)
 {
+	savegame::wait_for_pending_saves();
+
 	const std::string prefix = label + "-" + _("Auto-Save");
 	LOG_SAVE << "Cleaning saves with prefix '" << prefix << "'\n";
 
@@ -127,6 +133,8 @@ bool loadgame::load_game_ingame()
 		return false;
 	}
 
+	savegame::wait_for_pending_saves();
+
 	if(!gui2::dialogs::game_load::execute(game_config_, load_data_)) {
 		return false;
 	}
@@ -166,6 +174,8 @@ bool loadgame::load_game_ingame()
 
 bool loadgame::load_game()
 {
+	savegame::wait_for_pending_saves();
+
 	bool skip_version_check = true;
 
 	if(load_data_.filename.empty()) {
@@ -288,6 +298,8 @@ void loadgame::set_gamestate()
 
 bool loadgame::load_multiplayer_game()
 {
+	savegame::wait_for_pending_saves();
+
 	if(!gui2::dialogs::game_load::execute(game_config_, load_data_)) {
 		return false;
 	}
@@ -355,10 +367,103 @@ void loadgame::copy_era(config& cfg)
 	snapshot.add_child("era", era);
 }
 
+namespace
+{
+/**
+ * Saves are serialized to plain text on the main thread and then compressed
+ * and written out, for autosaves on a background thread. The multi-megabyte
+ * serialization buffer is recycled between saves instead of being reallocated
+ * and regrown each time.
+ */
+std::mutex save_buffer_mutex;
+std::string save_buffer_pool;
+
+std::string acquire_save_buffer()
+{
+	std::lock_guard<std::mutex> lock(save_buffer_mutex);
+	return std::exchange(save_buffer_pool, std::string());
+}
+
+void release_save_buffer(std::string&& buffer)
+{
+	buffer.clear();
+	std::lock_guard<std::mutex> lock(save_buffer_mutex);
+	if(buffer.capacity() > save_buffer_pool.capacity()) {
+		save_buffer_pool = std::move(buffer);
+	}
+}
+
+/** The save still being written on the background thread, if any. */
+std::future<void> pending_save_write;
+
+/**
+ * Runs @a f after the pending background write has finished, on the same
+ * background thread. If no write is pending, runs it right away. @a f is
+ * skipped if the pending write failed.
+ */
+void schedule_after_pending_save(std::function<void()> f)
+{
+	if(pending_save_write.valid()) {
+		pending_save_write = std::async(std::launch::async,
+			[prev = std::move(pending_save_write), f = std::move(f)]() mutable {
+				prev.get();
+				f();
+			});
+	} else {
+		f();
+	}
+}
+
+/** A streambuf appending to a caller-provided string, so the serialization
+    buffer can be recycled across saves. */
+class string_appender : public std::streambuf
+{
+public:
+	explicit string_appender(std::string& out)
+		: out_(out)
+	{
+	}
+
+private:
+	int overflow(int c) override
+	{
+		if(c != EOF) {
+			out_.push_back(static_cast<char>(c));
+		}
+		return c;
+	}
+
+	std::streamsize xsputn(const char* s, std::streamsize n) override
+	{
+		out_.append(s, n);
+		return n;
+	}
+
+	std::string& out_;
+};
+
+} // namespace
+
+void savegame::wait_for_pending_saves()
+{
+	if(pending_save_write.valid()) {
+		try {
+			pending_save_write.get();
+		} catch(const game::save_game_failed& e) {
+			// Background writes are only used for autosaves, and by the time
+			// the failure is noticed there is no interactive context left to
+			// report it in.
+			ERR_SAVE << "background save failed: " << e.message << std::endl;
+		}
+	}
+}
+
 savegame::savegame(saved_game& gamestate, const compression::format compress_saves, const std::string& title)
 	: filename_()
 	, title_(title)
 	, save_index_manager_(save_index_class::default_saves_dir())
+	, write_in_background_(false)
+	, deferring_large_parts_(false)
 	, gamestate_(gamestate)
 	, error_message_(_("The game could not be saved: "))
 	, show_confirmation_(false)
@@ -473,18 +578,10 @@ bool savegame::save_game(const std::string& filename)
 		write_game_to_disk(filename_);
 		if(resources::persist != nullptr) {
 			resources::persist->end_transaction();
+			resources::persist->flush_all();
 			resources::persist->start_transaction();
 		}
 
-		// Create an entry in the save_index. Doing this here ensures all leader image paths
-		// sre expanded in a context-independent fashion and can appear in the Load Game dialog
-		// even if a campaign-specific sprite is used. This is because the image's full path is
-		// only available if the binary-path context its a part of is loaded. Without this, if
-		// a player saves a game and exits the game or reloads the cache, the leader image will
-		// only be available within that specific binary context (when playing another game from
-		// the came campaign, for example).
-		save_index_manager_->rebuild(filename_);
-
 		end = SDL_GetTicks();
 		LOG_SAVE << "Milliseconds to save " << filename_ << ": " << end - start << std::endl;
 
@@ -507,21 +604,78 @@ void savegame::write_game_to_disk(const std::string& filename)
 {
 	LOG_SAVE << "savegame::save_game" << std::endl;
 
+	// A previous background write must be finished before its buffer can be
+	// recycled and before the save index is touched again.
+	wait_for_pending_saves();
+
 	filename_ = filename;
 	filename_ += compression::format_extension(compress_saves_);
 
-	std::stringstream ss;
+	// For background saves, capture the heavyweight state blocks as
+	// copy-on-write handles so their serialization can run on the writer
+	// thread; write_game() below then only serializes the small remainder.
+	std::function<void(config_writer&)> background_parts;
+	if(write_in_background_) {
+		background_parts = capture_background_parts();
+	}
+
+	// Serialization of everything else reads the live game state and must
+	// stay on this thread.
+	deferring_large_parts_ = background_parts != nullptr;
+	std::string text = acquire_save_buffer();
 	{
-		config_writer out(ss, compress_saves_);
+		string_appender appender(text);
+		std::ostream os(&appender);
+		config_writer out(os, compression::NONE);
 		write_game(out);
 		finish_save_game(out);
 	}
+	deferring_large_parts_ = false;
+
+	auto write_file = [path = save_index_manager_->dir() + "/" + filename_,
+			compress = compress_saves_,
+			manager = save_index_manager_,
+			filename = filename_,
+			text = std::move(text),
+			parts = std::move(background_parts)]() mutable {
+		if(parts) {
+			string_appender appender(text);
+			std::ostream os(&appender);
+			config_writer out(os, compression::NONE);
+			parts(out);
+
+			if(!out.good()) {
+				throw game::save_game_failed(_("Could not write to file"));
+			}
+		}
 
-	filesystem::scoped_ostream os(open_save_game(filename_));
-	(*os) << ss.str();
+		try {
+			filesystem::scoped_ostream os = filesystem::ostream_file(path);
+			write_compressed(*os, text, compress);
+
+			if(!os->good()) {
+				throw game::save_game_failed(_("Could not write to file"));
+			}
+		} catch(const filesystem::io_exception& e) {
+			throw game::save_game_failed(e.what());
+		}
+
+		release_save_buffer(std::move(text));
 
-	if(!os->good()) {
-		throw game::save_game_failed(_("Could not write to file"));
+		// Create an entry in the save_index. Doing this here ensures all leader image paths
+		// are expanded in a context-independent fashion and can appear in the Load Game dialog
+		// even if a campaign-specific sprite is used. This is because the image's full path is
+		// only available if the binary-path context its a part of is loaded. Without this, if
+		// a player saves a game and exits the game or reloads the cache, the leader image will
+		// only be available within that specific binary context (when playing another game from
+		// the came campaign, for example).
+		manager->rebuild(filename);
+	};
+
+	if(write_in_background_) {
+		pending_save_write = std::async(std::launch::async, std::move(write_file));
+	} else {
+		write_file();
 	}
 }
 
@@ -548,16 +702,6 @@ void savegame::finish_save_game(const config_writer& out)
 	}
 }
 
-// Throws game::save_game_failed
-filesystem::scoped_ostream savegame::open_save_game(const std::string& label)
-{
-	try {
-		return filesystem::ostream_file(save_index_manager_->dir() + "/" + label);
-	} catch(const filesystem::io_exception& e) {
-		throw game::save_game_failed(e.what());
-	}
-}
-
 scenariostart_savegame::scenariostart_savegame(saved_game& gamestate, const compression::format compress_saves)
 	: savegame(gamestate, compress_saves)
 {
@@ -606,6 +750,7 @@ autosave_savegame::autosave_savegame(saved_game& gamestate, const compression::f
 	: ingame_savegame(gamestate, compress_saves)
 {
 	set_error_message(_("Could not auto save the game. Please save the game manually."));
+	write_in_background_ = true;
 }
 
 void autosave_savegame::autosave(const bool disable_autosave, const int autosave_max, const int infinite_autosaves)
@@ -615,8 +760,12 @@ void autosave_savegame::autosave(const bool disable_autosave, const int autosave
 
 	save_game_automatic();
 
+	// The save may still be being written in the background; clean up old
+	// autosaves on the same thread once it is done.
 	auto manager = save_index_class::default_saves_dir();
-	manager->delete_old_auto_saves(autosave_max, infinite_autosaves);
+	schedule_after_pending_save([manager, autosave_max, infinite_autosaves]() {
+		manager->delete_old_auto_saves(autosave_max, infinite_autosaves);
+	});
 }
 
 std::string autosave_savegame::create_initial_filename(unsigned int turn_number) const
@@ -674,6 +823,11 @@ void ingame_savegame::write_game(config_writer& out)
 
 	savegame::write_game(out);
 
+	if(deferring_large_parts_) {
+		// capture_background_parts() serializes the rest on the writer thread.
+		return;
+	}
+
 	gamestate().write_carryover(out);
 	out.write_child("snapshot", gamestate().get_starting_point());
 	out.write_child("replay_start", gamestate().replay_start());
@@ -682,6 +836,37 @@ void ingame_savegame::write_game(config_writer& out)
 	out.close_child("replay");
 }
 
+std::function<void(config_writer&)> ingame_savegame::capture_background_parts()
+{
+	// The carryover, snapshot and replay_start are captured in O(1) as
+	// copy-on-write handles. The replay command history is captured as the
+	// recorder's incrementally maintained WML text plus the few commands
+	// that are still editable in place, so capturing it no longer costs a
+	// deep copy that grows with the length of the game.
+	config replay_remainder;
+	std::string replay_prefix = gamestate().get_replay().serialized_commands(replay_remainder);
+	config upload_log = gamestate().get_replay().get_upload_log();
+
+	return [carryover_tag = std::string(gamestate().carryover_tag()),
+			carryover = gamestate().share_carryover(),
+			snapshot = gamestate().share_starting_point(),
+			replay_start = gamestate().share_replay_start(),
+			upload_log = std::move(upload_log),
+			replay_prefix = std::move(replay_prefix),
+			replay_remainder = std::move(replay_remainder)](config_writer& out) {
+		out.write_child(carryover_tag, carryover.read());
+		out.write_child("snapshot", snapshot.read());
+		out.write_child("replay_start", replay_start.read());
+		out.open_child("replay");
+		out.write_child("upload_log", upload_log);
+		out.write_raw(replay_prefix);
+		for(const config& command : replay_remainder.child_range("command")) {
+			out.write_child("command", command);
+		}
+		out.close_child("replay");
+	};
+}
+
 // changes done during 1.11.0-dev
 static void convert_old_saves_1_11_0(config& cfg)
 {
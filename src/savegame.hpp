@@ -23,6 +23,7 @@
 #include "serialization/compression.hpp"
 
 #include <exception>
+#include <functional>
 
 class config_writer;
 class game_config_view;
@@ -185,6 +186,13 @@ public:
 	/** Build the filename for the specified turn. */
 	std::string create_filename(unsigned int turn_number) const;
 
+	/**
+	 * Blocks until any save still being compressed and written on the
+	 * background thread has finished. Must be called before anything touches
+	 * the save directory or the save index behind the writer's back.
+	 */
+	static void wait_for_pending_saves();
+
 protected:
 	/**
 		Save a game without any further user interaction.
@@ -207,6 +215,19 @@ protected:
 	/** Writing the savegame config to a file. */
 	virtual void write_game(config_writer &out);
 
+	/**
+	 * Captures the heavyweight state blocks and returns a callback that
+	 * serializes them, so a background save runs the expensive part of
+	 * config_writer on the writer thread. While the capture is in effect
+	 * write_game() must leave those blocks out; deferring_large_parts_
+	 * tells it to. The default returns nullptr, meaning write_game()
+	 * writes everything on the main thread as usual.
+	 */
+	virtual std::function<void(config_writer&)> capture_background_parts() { return nullptr; }
+
+	/** See capture_background_parts(). Only set inside write_game_to_disk(). */
+	bool deferring_large_parts_;
+
 	/** Filename of the savegame file on disk */
 	std::string filename_;
 
@@ -220,6 +241,11 @@ protected:
 		Making this a class member anyway, while I'm refactoring. */
 	std::shared_ptr<save_index_class> save_index_manager_;
 
+	/** If set, compression and disk I/O run on a background thread, so the
+		save overlaps with gameplay instead of stalling it. Only suitable for
+		non-interactive saves; errors are logged instead of shown. */
+	bool write_in_background_;
+
 private:
 	/** Subclass-specific part of filename building. */
 	virtual std::string create_initial_filename(unsigned int turn_number) const = 0;
@@ -234,8 +260,6 @@ private:
 
 	/** Update the save_index */
 	void finish_save_game(const config_writer &out);
-	/** Throws game::save_game_failed. */
-	filesystem::scoped_ostream open_save_game(const std::string &label);
 	friend class save_info;
 	//before_save (write replay data) changes this so it cannot be const
 	saved_game& gamestate_;
@@ -260,6 +284,8 @@ private:
 
 
 	void write_game(config_writer &out) override;
+
+	std::function<void(config_writer&)> capture_background_parts() override;
 };
 
 /** Class for replay saves (either manually or automatically). */
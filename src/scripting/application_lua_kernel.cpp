@@ -113,7 +113,7 @@ application_lua_kernel::application_lua_kernel()
 	cmd_log_ << lua_preferences::register_table(mState);
 }
 
-application_lua_kernel::thread::thread(lua_State * T) : T_(T), started_(false) {}
+application_lua_kernel::thread::thread(lua_State * T) : T_(T), started_(false), waiting_(false) {}
 
 std::string application_lua_kernel::thread::status()
 {
@@ -307,7 +307,16 @@ application_lua_kernel::request_list application_lua_kernel::thread::run_script(
 
 	this_context_backend->valid = false; //invalidate the context object for lua
 
-	if (lua_status(T_) != LUA_YIELD) {
+	if (lua_status(T_) == LUA_YIELD) {
+		// A script may yield the string "events" to declare that it has nothing
+		// to do until the next event arrives, letting the manager skip its
+		// slices in the meantime. Pop the yielded values either way, the next
+		// resume expects only its arguments on the stack.
+		waiting_ = numres >= 1 && lua_type(T_, 1) == LUA_TSTRING
+			&& std::string(lua_tostring(T_, 1)) == "events";
+		lua_pop(T_, numres);
+	} else {
+		waiting_ = false;
 		LOG_LUA << "Thread status = '" << lua_status(T_) << "'\n";
 		if (lua_status(T_) != LUA_OK) {
 			std::stringstream ss;
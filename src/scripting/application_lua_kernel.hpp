@@ -35,6 +35,7 @@ public:
 	class thread {
 		lua_State * T_;
 		bool started_;
+		bool waiting_;
 
 		thread(const thread&) = delete;
 		thread& operator=(const thread&) = delete;
@@ -44,6 +45,14 @@ public:
 		bool is_running();
 		std::string status();
 
+		/**
+		 * True if the script's last yield declared that it is idle until the
+		 * next event arrives (it yielded the string "events"). The plugins
+		 * manager skips such threads in play_slice while their event queue
+		 * is empty, instead of resuming them every main loop iteration.
+		 */
+		bool is_waiting() const { return waiting_; }
+
 		request_list run_script(const plugins_context & ctxt, const std::vector<plugins_manager::event> & queue);
 
 		friend class application_lua_kernel;
@@ -434,11 +434,10 @@ int game_lua_kernel::intf_get_unit(lua_State *L)
 	map_location loc;
 	if(lua_isstring(L, 1) && !lua_isnumber(L, 1)) {
 		std::string id = luaL_checkstring(L, 1);
-		for(const unit& u : units()) {
-			if(u.id() == id) {
-				luaW_pushunit(L, u.underlying_id());
-				return 1;
-			}
+		unit_map::const_unit_iterator ui = units().find(id);
+		if(ui.valid()) {
+			luaW_pushunit(L, ui->underlying_id());
+			return 1;
 		}
 		return 0;
 	}
@@ -561,7 +561,7 @@ namespace {
 		void operator()(double d) const
 		{ lua_pushnumber(L, d); }
 		void operator()(const std::string& s) const
-		{ lua_pushstring(L, s.c_str()); }
+		{ lua_pushlstring(L, s.c_str(), s.length()); }
 		void operator()(const t_string& s) const
 		{ luaW_pushtstring(L, s); }
 	};
@@ -652,17 +652,19 @@ void luaW_filltable(lua_State *L, const config& cfg)
 	for (const config::any_child ch : cfg.all_children_range())
 	{
 		luaW_push_namedtuple(L, {"tag", "contents"});
-		lua_pushstring(L, ch.key.c_str());
+		lua_pushlstring(L, ch.key.c_str(), ch.key.length());
 		lua_rawseti(L, -2, 1);
-		lua_newtable(L);
+		// Sizing the table up front avoids rehashing while it fills.
+		lua_createtable(L, ch.cfg.all_children_count(), ch.cfg.attribute_count());
 		luaW_filltable(L, ch.cfg);
 		lua_rawseti(L, -2, 2);
 		lua_rawseti(L, -2, k++);
 	}
 	for (const config::attribute &attr : cfg.attribute_range())
 	{
+		lua_pushlstring(L, attr.first.c_str(), attr.first.length());
 		luaW_pushscalar(L, attr.second);
-		lua_setfield(L, -2, attr.first.c_str());
+		lua_rawset(L, -3);
 	}
 }
 
@@ -811,7 +813,7 @@ std::set<map_location> luaW_check_locationset(lua_State* L, int idx)
 
 void luaW_pushconfig(lua_State *L, const config& cfg)
 {
-	lua_newtable(L);
+	lua_createtable(L, cfg.all_children_count(), cfg.attribute_count());
 	luaW_filltable(L, cfg);
 }
 
@@ -985,8 +987,9 @@ bool luaW_pushvariable(lua_State *L, variable_access_const& v)
 		}
 		else if(v.exists_as_container())
 		{
-			lua_newtable(L);
-			luaW_filltable(L, v.as_container());
+			const config& cfg = v.as_container();
+			lua_createtable(L, cfg.all_children_count(), cfg.attribute_count());
+			luaW_filltable(L, cfg);
 			return true;
 		}
 		else
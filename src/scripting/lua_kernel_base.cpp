@@ -45,6 +45,7 @@
 
 #include "game_version.hpp"                  // for do_version_check, etc
 
+#include <algorithm>
 #include <functional>
 #include "utils/name_generator.hpp"
 #include "utils/markov_generator.hpp"
@@ -52,6 +53,7 @@
 
 #include <cstring>
 #include <exception>
+#include <map>
 #include <new>
 #include <string>
 #include <sstream>
@@ -516,6 +518,8 @@ int dispatch(lua_State *L) {
 lua_kernel_base::lua_kernel_base()
  : mState(luaL_newstate())
  , cmd_log_()
+ , last_gc_ms_(0)
+ , max_gc_ms_(0)
 {
 	get_lua_kernel_base_ptr(mState) = this;
 	lua_State *L = mState;
@@ -618,6 +622,7 @@ lua_kernel_base::lua_kernel_base()
 		{ "named_tuple",              &intf_named_tuple              },
 		{ "log",                      &intf_log                      },
 		{ "ms_since_init",            &intf_ms_since_init           },
+		{ "gc_stats",                 &dispatch<&lua_kernel_base::intf_gc_stats>          },
 		{ "get_language",             &intf_get_language             },
 		{ "version",                  &intf_make_version       },
 		{ "current_version",          &intf_current_version    },
@@ -846,10 +851,42 @@ bool lua_kernel_base::protected_call(lua_State * L, int nArgs, int nRets, error_
 	return true;
 }
 
+namespace {
+// Compiled chunks are kept around as lua_dump() bytecode keyed by chunk name
+// and source, so repeated loads of the same [lua] code= string or preload
+// script skip the parser. Only bytecode dumped by this process is ever
+// loaded back; caller-supplied text still goes through the source-only
+// parser below, so the CVE-2018-1999023 protection is unaffected.
+constexpr std::size_t chunk_cache_max_size = 1024;
+std::map<std::string, std::string> chunk_cache;
+
+int dump_to_string(lua_State* /*L*/, const void* data, std::size_t size, void* out)
+{
+	static_cast<std::string*>(out)->append(static_cast<const char*>(data), size);
+	return 0;
+}
+} // end anonymous namespace
+
 bool lua_kernel_base::load_string(char const * prog, const std::string& name, error_handler e_h)
 {
+	char const * chunk_name = name.empty() ? name.c_str() : prog;
+
+	std::string cache_key = name;
+	cache_key += '\0';
+	cache_key += prog;
+
+	const std::map<std::string, std::string>::iterator cached = chunk_cache.find(cache_key);
+	if (cached != chunk_cache.end()) {
+		if (luaL_loadbufferx(mState, cached->second.data(), cached->second.size(), chunk_name, "b") == LUA_OK) {
+			return true;
+		}
+		// Our own dump should always load back; recompile from source if it somehow does not.
+		lua_pop(mState, 1);
+		chunk_cache.erase(cached);
+	}
+
 	// pass 't' to prevent loading bytecode which is unsafe and can be used to escape the sandbox.
-	int errcode = luaL_loadbufferx(mState, prog, strlen(prog), name.empty() ? name.c_str() : prog, "t");
+	int errcode = luaL_loadbufferx(mState, prog, strlen(prog), chunk_name, "t");
 	if (errcode != LUA_OK) {
 		char const * msg = lua_tostring(mState, -1);
 		std::string message = msg ? msg : "null string";
@@ -870,6 +907,13 @@ bool lua_kernel_base::load_string(char const * prog, const std::string& name, er
 
 		return false;
 	}
+
+	if (chunk_cache.size() >= chunk_cache_max_size) {
+		chunk_cache.clear();
+	}
+
+	std::string& dump = chunk_cache[cache_key];
+	lua_dump(mState, &dump_to_string, &dump, 0);
 	return true;
 }
 
@@ -1182,3 +1226,40 @@ uint32_t lua_kernel_base::get_random_seed()
 {
 	return seed_rng::next_seed();
 }
+
+void lua_kernel_base::step_gc()
+{
+	const uint32_t start = SDL_GetTicks();
+	// The step size is the budget, in kilobytes of allocation debt, the
+	// collector works off in one slice; small enough to stay well below
+	// a frame even on heavy UMC heaps.
+	lua_gc(mState, LUA_GCSTEP, 64);
+	last_gc_ms_ = SDL_GetTicks() - start;
+	max_gc_ms_ = std::max(max_gc_ms_, last_gc_ms_);
+}
+
+void lua_kernel_base::full_gc()
+{
+	const uint32_t start = SDL_GetTicks();
+	lua_gc(mState, LUA_GCCOLLECT, 0);
+	last_gc_ms_ = SDL_GetTicks() - start;
+	max_gc_ms_ = std::max(max_gc_ms_, last_gc_ms_);
+}
+
+/**
+* Returns a table with the kernel's heap size and collection pause timings.
+* - Ret 1: table { heap_kb, last_pause_ms, max_pause_ms, running }
+*/
+int lua_kernel_base::intf_gc_stats(lua_State* L)
+{
+	lua_createtable(L, 0, 4);
+	lua_pushinteger(L, lua_gc(L, LUA_GCCOUNT, 0));
+	lua_setfield(L, -2, "heap_kb");
+	lua_pushinteger(L, last_gc_ms_);
+	lua_setfield(L, -2, "last_pause_ms");
+	lua_pushinteger(L, max_gc_ms_);
+	lua_setfield(L, -2, "max_pause_ms");
+	lua_pushboolean(L, lua_gc(L, LUA_GCISRUNNING, 0));
+	lua_setfield(L, -2, "running");
+	return 1;
+}
@@ -76,6 +76,23 @@ public:
 	}
 
 	virtual uint32_t get_random_seed();
+
+	/**
+	 * Runs one budgeted incremental garbage collection step.
+	 *
+	 * Driven from the game loop, so collection debt is paid off in small
+	 * slices instead of whenever an allocation happens to trip the
+	 * collector mid-frame. The step duration is recorded and exposed to
+	 * scripts through wesnoth.gc_stats().
+	 */
+	void step_gc();
+
+	/** Runs a full garbage collection cycle, e.g. at turn boundaries. */
+	void full_gc();
+
+	/** Reports heap size and collection pause timings, see wesnoth.gc_stats(). */
+	int intf_gc_stats(lua_State* L);
+
 	lua_State * get_state() { return mState; }
 	void add_widget_definition(const std::string& type, const std::string& id) { registered_widget_definitions_.emplace_back(type, id); }
 protected:
@@ -143,4 +160,8 @@ protected:
 private:
 	static lua_kernel_base*& get_lua_kernel_base_ptr(lua_State *L);
 	std::vector<std::tuple<std::string, std::string>> registered_widget_definitions_;
+
+	/** Duration of the most recent and the longest explicit GC pause, in ms. */
+	uint32_t last_gc_ms_;
+	uint32_t max_gc_ms_;
 };
@@ -177,6 +177,11 @@ void plugins_manager::play_slice(const plugins_context & ctxt)
 				return;
 			}
 
+			if (plugins_[idx].thread->is_waiting() && plugins_[idx].queue.empty()) {
+				DBG_PLG << "waiting for events, skipping\n";
+				continue;
+			}
+
 			std::vector<event> input = plugins_[idx].queue; //empty the queue to a temporary variable
 			plugins_[idx].queue = std::vector<event>();
 
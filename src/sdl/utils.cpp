@@ -27,10 +27,307 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include <boost/circular_buffer.hpp>
 #include <boost/math/constants/constants.hpp>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SDL_UTILS_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+// Vectorized pixel kernels for the recoloring and color-adjustment routines
+// below, processing four packed ARGB pixels per step where SSE2 is available
+// with a scalar tail. Fully transparent pixels are always left untouched,
+// matching the behavior of the old per-pixel loops.
+
+/** Adds the (possibly negative) per-channel deltas to every pixel, clamping to [0,255]. */
+void adjust_color_pixels(uint32_t* beg, uint32_t* end, int red, int green, int blue)
+{
+#ifdef SDL_UTILS_USE_SSE2
+	const auto clamped = [](int v) { return std::max(0, std::min(255, v)); };
+
+	// Split each delta into a saturating byte add and a saturating byte
+	// subtract; the alpha lane stays zero in both.
+	const __m128i add = _mm_set1_epi32((clamped(red) << 16) | (clamped(green) << 8) | clamped(blue));
+	const __m128i sub = _mm_set1_epi32((clamped(-red) << 16) | (clamped(-green) << 8) | clamped(-blue));
+	const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	const __m128i zero = _mm_setzero_si128();
+
+	for(; beg + 4 <= end; beg += 4) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+		__m128i res = _mm_subs_epu8(_mm_adds_epu8(v, add), sub);
+
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), zero);
+		res = _mm_or_si128(_mm_and_si128(transparent, v), _mm_andnot_si128(transparent, res));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(beg), res);
+	}
+#endif
+
+	for(; beg != end; ++beg) {
+		uint8_t alpha = (*beg) >> 24;
+
+		if(alpha) {
+			uint8_t r, g, b;
+			r = (*beg) >> 16;
+			g = (*beg) >> 8;
+			b = (*beg) >> 0;
+
+			r = std::max<int>(0, std::min<int>(255, static_cast<int>(r) + red));
+			g = std::max<int>(0, std::min<int>(255, static_cast<int>(g) + green));
+			b = std::max<int>(0, std::min<int>(255, static_cast<int>(b) + blue));
+
+			*beg = (alpha << 24) + (r << 16) + (g << 8) + b;
+		}
+	}
+}
+
+/** Replaces every pixel with its (77r + 150g + 29b) / 256 grey value. */
+void greyscale_pixels(uint32_t* beg, uint32_t* end)
+{
+#ifdef SDL_UTILS_USE_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	// 16-bit weights in memory order B,G,R,A for two pixels.
+	const __m128i weights = _mm_set_epi16(0, 77, 150, 29, 0, 77, 150, 29);
+
+	for(; beg + 4 <= end; beg += 4) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+
+		// madd yields (29b + 150g | 77r) pairs; fold the pairs and shift to
+		// get one grey value per 32-bit lane 0 and 2.
+		const __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), weights);
+		const __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), weights);
+		const __m128i lo_sum = _mm_srli_epi32(_mm_add_epi32(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1))), 8);
+		const __m128i hi_sum = _mm_srli_epi32(_mm_add_epi32(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1))), 8);
+
+		const __m128i grey = _mm_unpacklo_epi64(
+			_mm_shuffle_epi32(lo_sum, _MM_SHUFFLE(3, 3, 2, 0)),
+			_mm_shuffle_epi32(hi_sum, _MM_SHUFFLE(3, 3, 2, 0)));
+
+		const __m128i rgb = _mm_or_si128(grey, _mm_or_si128(_mm_slli_epi32(grey, 8), _mm_slli_epi32(grey, 16)));
+		__m128i res = _mm_or_si128(_mm_and_si128(v, alpha_mask), rgb);
+
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), zero);
+		res = _mm_or_si128(_mm_and_si128(transparent, v), _mm_andnot_si128(transparent, res));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(beg), res);
+	}
+#endif
+
+	for(; beg != end; ++beg) {
+		uint8_t alpha = (*beg) >> 24;
+
+		if(alpha) {
+			uint8_t r, g, b;
+			r = (*beg) >> 16;
+			g = (*beg) >> 8;
+			b = (*beg);
+
+			const uint8_t avg = static_cast<uint8_t>((
+				77  * static_cast<uint16_t>(r) +
+				150 * static_cast<uint16_t>(g) +
+				29  * static_cast<uint16_t>(b)  ) / 256);
+
+			*beg = (alpha << 24) | (avg << 16) | (avg << 8) | avg;
+		}
+	}
+}
+
+/** A color_range_map flattened into parallel arrays for sequential scanning. */
+struct flat_palette
+{
+	explicit flat_palette(const color_range_map& map_rgb)
+		: from()
+		, to()
+	{
+		from.reserve(map_rgb.size());
+		to.reserve(map_rgb.size());
+
+		for(const auto& mapping : map_rgb) {
+			// Pixels are compared with their alpha forced to 0xFF, so a key
+			// with any other alpha can never match, like with the map lookup.
+			from.push_back(mapping.first.to_argb_bytes());
+			// Palettes use only the RGB channels.
+			to.push_back(mapping.second.to_argb_bytes() & 0x00FFFFFFu);
+		}
+	}
+
+	std::vector<uint32_t> from;
+	std::vector<uint32_t> to;
+};
+
+/**
+ * Replaces the RGB channels of every pixel found in the palette. Team
+ * palettes are small, so a sequential compare against each entry - four
+ * pixels at a time - beats a hash lookup per pixel by a wide margin.
+ */
+void recolor_pixels(uint32_t* beg, uint32_t* end, const flat_palette& palette)
+{
+#ifdef SDL_UTILS_USE_SSE2
+	const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	const __m128i zero = _mm_setzero_si128();
+
+	for(; beg + 4 <= end; beg += 4) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+		const __m128i key = _mm_or_si128(v, alpha_mask);
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), zero);
+		__m128i res = v;
+
+		for(std::size_t i = 0; i < palette.from.size(); ++i) {
+			const __m128i match = _mm_andnot_si128(
+				transparent, _mm_cmpeq_epi32(key, _mm_set1_epi32(static_cast<int>(palette.from[i]))));
+
+			if(_mm_movemask_epi8(match) == 0) {
+				continue;
+			}
+
+			const __m128i replacement = _mm_or_si128(
+				_mm_and_si128(v, alpha_mask), _mm_set1_epi32(static_cast<int>(palette.to[i])));
+
+			res = _mm_or_si128(_mm_andnot_si128(match, res), _mm_and_si128(match, replacement));
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(beg), res);
+	}
+#endif
+
+	for(; beg != end; ++beg) {
+		uint8_t alpha = (*beg) >> 24;
+
+		if(alpha) {
+			uint32_t oldrgb = (*beg) | 0xFF000000u;
+
+			for(std::size_t i = 0; i < palette.from.size(); ++i) {
+				if(palette.from[i] == oldrgb) {
+					*beg = (alpha << 24) | palette.to[i];
+					break;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Clamps every pixel's alpha to the alpha of the corresponding mask pixel,
+ * leaving the color channels alone. Returns true when no pixel is left
+ * with a nonzero alpha.
+ */
+bool mask_pixels(uint32_t* beg, uint32_t* end, const uint32_t* mbeg, const uint32_t* mend)
+{
+	bool empty = true;
+
+#ifdef SDL_UTILS_USE_SSE2
+	const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	__m128i seen = _mm_setzero_si128();
+
+	// min(alpha, mask alpha) maps directly onto the byte-wise unsigned
+	// minimum, restricted to the alpha lane. Transparent pixels keep their
+	// color bytes since the minimum leaves their zero alpha in place.
+	for(; beg + 4 <= end && mbeg + 4 <= mend; beg += 4, mbeg += 4) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+		const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mbeg));
+		const __m128i alpha = _mm_and_si128(_mm_min_epu8(v, m), alpha_mask);
+
+		seen = _mm_or_si128(seen, alpha);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(beg), _mm_or_si128(_mm_andnot_si128(alpha_mask, v), alpha));
+	}
+
+	if(_mm_movemask_epi8(_mm_cmpeq_epi8(seen, _mm_setzero_si128())) != 0xFFFF) {
+		empty = false;
+	}
+#endif
+
+	for(; beg != end && mbeg != mend; ++beg, ++mbeg) {
+		uint8_t alpha = (*beg) >> 24;
+
+		if(alpha) {
+			uint8_t r, g, b;
+			r = (*beg) >> 16;
+			g = (*beg) >> 8;
+			b = (*beg);
+
+			uint8_t malpha = (*mbeg) >> 24;
+			if (alpha > malpha) {
+				alpha = malpha;
+			}
+			if(alpha)
+				empty = false;
+
+			*beg = (alpha << 24) + (r << 16) + (g << 8) + b;
+		}
+	}
+
+	return empty;
+}
+
+/**
+ * Adds 2 * (light - 128) per channel, clamped to [0,255], to every pixel
+ * with a nonzero alpha - the ~L() time-of-day lighting kernel.
+ */
+void light_pixels(uint32_t* beg, uint32_t* end, const uint32_t* lbeg, const uint32_t* lend)
+{
+#ifdef SDL_UTILS_USE_SSE2
+	const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+	const __m128i half = _mm_set1_epi8(static_cast<char>(0x80));
+	const __m128i zero = _mm_setzero_si128();
+
+	// 2 * (light - 128) splits into a saturating byte add of
+	// 2 * max(light - 128, 0) and a saturating byte subtract of
+	// 2 * max(128 - light, 0); only one of the two is ever nonzero, so
+	// the saturation points match the scalar clamping exactly.
+	for(; beg + 4 <= end && lbeg + 4 <= lend; beg += 4, lbeg += 4) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+		const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lbeg));
+
+		const __m128i up = _mm_subs_epu8(l, half);
+		const __m128i down = _mm_subs_epu8(half, l);
+
+		__m128i res = _mm_subs_epu8(_mm_adds_epu8(v, _mm_adds_epu8(up, up)), _mm_adds_epu8(down, down));
+		res = _mm_or_si128(_mm_andnot_si128(alpha_mask, res), _mm_and_si128(v, alpha_mask));
+
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(v, alpha_mask), zero);
+		res = _mm_or_si128(_mm_and_si128(transparent, v), _mm_andnot_si128(transparent, res));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(beg), res);
+	}
+#endif
+
+	for(; beg != end && lbeg != lend; ++beg, ++lbeg) {
+		uint8_t alpha = (*beg) >> 24;
+		if(alpha) {
+			uint8_t lr, lg, lb;
+
+			lr = (*lbeg) >> 16;
+			lg = (*lbeg) >> 8;
+			lb = (*lbeg);
+
+			uint8_t r, g, b;
+			r = (*beg) >> 16;
+			g = (*beg) >> 8;
+			b = (*beg);
+
+			int dr = (static_cast<int>(lr) - 128) * 2;
+			int dg = (static_cast<int>(lg) - 128) * 2;
+			int db = (static_cast<int>(lb) - 128) * 2;
+			//note that r + dr will promote r to int (needed to avoid uint8_t math)
+			r = std::max<int>(0,std::min<int>(255, r + dr));
+			g = std::max<int>(0,std::min<int>(255, g + dg));
+			b = std::max<int>(0,std::min<int>(255, b + db));
+
+			*beg = (alpha << 24) + (r << 16) + (g << 8) + b;
+		}
+	}
+}
+
+} // end anon namespace
+
 version_info sdl_get_version()
 {
 	SDL_version sdl_version;
@@ -151,7 +448,35 @@ surface scale_surface_xbrz(const surface & surf, std::size_t z)
 		const_surface_lock src_lock(surf);
 		surface_lock dst_lock(dst);
 
-		xbrz::scale(z, src_lock.pixels(), dst_lock.pixels(), surf->w, surf->h);
+		// xBRZ supports processing non-overlapping row slices of the same
+		// image concurrently; it only reads (up to two rows) outside its
+		// slice. Dispatch large images across a thread per slice. Single-row
+		// slices are inefficient, hence the minimum slice height.
+		const int rows = surf->h;
+		const unsigned max_slices = std::max(1, std::min<int>(
+			std::thread::hardware_concurrency(), rows / 8));
+
+		if(max_slices <= 1) {
+			xbrz::scale(z, src_lock.pixels(), dst_lock.pixels(), surf->w, surf->h);
+		} else {
+			const uint32_t* src = src_lock.pixels();
+			uint32_t* trg = dst_lock.pixels();
+			const int chunk = (rows + max_slices - 1) / max_slices;
+
+			std::vector<std::thread> workers;
+			workers.reserve(max_slices);
+
+			for(int y_first = 0; y_first < rows; y_first += chunk) {
+				const int y_last = std::min(rows, y_first + chunk);
+				workers.emplace_back([z, src, trg, w = surf->w, h = surf->h, y_first, y_last]() {
+					xbrz::scale(z, src, trg, w, h, xbrz::ScalerCfg(), y_first, y_last);
+				});
+			}
+
+			for(std::thread& worker : workers) {
+				worker.join();
+			}
+		}
 	}
 
 	return dst;
@@ -549,6 +874,83 @@ surface scale_surface_sharp(const surface& surf, int w, int h)
 	return dst;
 }
 
+void scale_surface_sharp_region(const surface& surf, surface& dst, const SDL_Rect& dst_area)
+{
+	assert(SDL_ALPHA_TRANSPARENT==0);
+
+	if(surf == nullptr || dst == nullptr)
+		return;
+
+	SDL_Rect area = dst_area;
+	if(area.x < 0) { area.w += area.x; area.x = 0; }
+	if(area.y < 0) { area.h += area.y; area.y = 0; }
+	area.w = std::min(area.w, dst->w - area.x);
+	area.h = std::min(area.h, dst->h - area.y);
+	if(area.w <= 0 || area.h <= 0)
+		return;
+
+	{
+		const_surface_lock src_lock(surf);
+		surface_lock dst_lock(dst);
+
+		const uint32_t* const src_pixels = src_lock.pixels();
+		uint32_t* const dst_pixels = dst_lock.pixels();
+
+		float xratio = static_cast<float>(surf->w) / dst->w;
+		float yratio = static_cast<float>(surf->h) / dst->h;
+
+		// Same sampling as scale_surface_sharp(), restricted to the region.
+		float ysrc = yratio * area.y;
+		for(int ydst = area.y; ydst != area.y + area.h; ++ydst, ysrc += yratio) {
+			float xsrc = xratio * area.x;
+			for(int xdst = area.x; xdst != area.x + area.w; ++xdst, xsrc += xratio) {
+				float red = 0.0f, green = 0.0f, blue = 0.0f, alpha = 0.0f;
+
+				float summation = 0.0f;
+
+				// We now have a rectangle, (xsrc,ysrc,xratio,yratio)
+				// which we want to derive the pixel from
+				for(float xloc = xsrc; xloc < xsrc+xratio; xloc += 1) {
+					const float xsize = std::min<float>(std::floor(xloc+1)-xloc,xsrc+xratio-xloc);
+
+					for(float yloc = ysrc; yloc < ysrc+yratio; yloc += 1) {
+						const int xsrcint = std::max<int>(0,std::min<int>(surf->w-1,static_cast<int>(xsrc)));
+						const int ysrcint = std::max<int>(0,std::min<int>(surf->h-1,static_cast<int>(ysrc)));
+						const float ysize = std::min<float>(std::floor(yloc+1)-yloc,ysrc+yratio-yloc);
+
+						uint8_t r,g,b,a;
+
+						SDL_GetRGBA(src_pixels[ysrcint*surf->w + xsrcint],surf->format,&r,&g,&b,&a);
+						float value = xsize * ysize;
+						summation += value;
+						if (!a) continue;
+						value *= a;
+						alpha += value;
+						red += r * value;
+						green += g * value;
+						blue += b * value;
+					}
+				}
+
+				if (alpha != 0) {
+					red = red / alpha + 0.5f;
+					green = green / alpha + 0.5f;
+					blue = blue / alpha + 0.5f;
+					alpha = alpha / summation + 0.5f;
+				}
+
+				dst_pixels[ydst*dst->w + xdst] = SDL_MapRGBA(
+				dst->format
+				, static_cast<uint8_t>(red)
+				, static_cast<uint8_t>(green)
+				, static_cast<uint8_t>(blue)
+				, static_cast<uint8_t>(alpha));
+			}
+
+		}
+	}
+}
+
 
 surface tile_surface(const surface& surf, int w, int h, bool centered)
 {
@@ -612,27 +1014,7 @@ surface adjust_surface_color(const surface &surf, int red, int green, int blue)
 
 	{
 		surface_lock lock(nsurf);
-		uint32_t* beg = lock.pixels();
-		uint32_t* end = beg + nsurf->w*surf->h;
-
-		while(beg != end) {
-			uint8_t alpha = (*beg) >> 24;
-
-			if(alpha) {
-				uint8_t r, g, b;
-				r = (*beg) >> 16;
-				g = (*beg) >> 8;
-				b = (*beg) >> 0;
-
-				r = std::max<int>(0,std::min<int>(255,static_cast<int>(r)+red));
-				g = std::max<int>(0,std::min<int>(255,static_cast<int>(g)+green));
-				b = std::max<int>(0,std::min<int>(255,static_cast<int>(b)+blue));
-
-				*beg = (alpha << 24) + (r << 16) + (g << 8) + b;
-			}
-
-			++beg;
-		}
+		adjust_color_pixels(lock.pixels(), lock.pixels() + nsurf->w * surf->h, red, green, blue);
 	}
 
 	return nsurf;
@@ -651,33 +1033,10 @@ surface greyscale_image(const surface &surf)
 
 	{
 		surface_lock lock(nsurf);
-		uint32_t* beg = lock.pixels();
-		uint32_t* end = beg + nsurf->w*surf->h;
-
-		while(beg != end) {
-			uint8_t alpha = (*beg) >> 24;
-
-			if(alpha) {
-				uint8_t r, g, b;
-				r = (*beg) >> 16;
-				g = (*beg) >> 8;
-				b = (*beg);
-				//const uint8_t avg = (red+green+blue)/3;
-
-				// Use the correct formula for RGB to grayscale conversion.
-				// Ok, this is no big deal :)
-				// The correct formula being:
-				// gray=0.299red+0.587green+0.114blue
-				const uint8_t avg = static_cast<uint8_t>((
-					77  * static_cast<uint16_t>(r) +
-					150 * static_cast<uint16_t>(g) +
-					29  * static_cast<uint16_t>(b)  ) / 256);
-
-				*beg = (alpha << 24) | (avg << 16) | (avg << 8) | avg;
-			}
 
-			++beg;
-		}
+		// The correct formula for RGB to grayscale conversion,
+		// gray = 0.299 red + 0.587 green + 0.114 blue, in 8.8 fixed point.
+		greyscale_pixels(lock.pixels(), lock.pixels() + nsurf->w * surf->h);
 	}
 
 	return nsurf;
@@ -1019,27 +1378,38 @@ surface recolor_image(surface surf, const color_range_map& map_rgb)
 	}
 
 	surface_lock lock(nsurf);
-	uint32_t* beg = lock.pixels();
-	uint32_t* end = beg + nsurf->w*surf->h;
+	recolor_pixels(lock.pixels(), lock.pixels() + nsurf->w * surf->h, flat_palette(map_rgb));
 
-	while(beg != end) {
-		uint8_t alpha = (*beg) >> 24;
+	return nsurf;
+}
 
-		// Don't recolor invisible pixels.
-		if(alpha) {
-			// Palette use only RGB channels, so remove alpha
-			uint32_t oldrgb = (*beg) | 0xFF000000;
+std::vector<surface> recolor_images(const std::vector<surface>& surfs, const color_range_map& map_rgb)
+{
+	std::vector<surface> result;
+	result.reserve(surfs.size());
 
-			auto i = map_rgb.find(color_t::from_argb_bytes(oldrgb));
-			if(i != map_rgb.end()) {
-				*beg = (alpha << 24) | (i->second.to_argb_bytes() & 0x00FFFFFF);
-			}
+	// Flatten the palette once for the whole frame set.
+	const flat_palette palette(map_rgb);
+
+	for(const surface& surf : surfs) {
+		if(surf == nullptr || map_rgb.empty()) {
+			result.push_back(surf);
+			continue;
+		}
+
+		surface nsurf = surf.clone();
+		if(nsurf == nullptr) {
+			std::cerr << "failed to make neutral surface" << std::endl;
+			result.push_back(nullptr);
+			continue;
 		}
 
-		++beg;
+		surface_lock lock(nsurf);
+		recolor_pixels(lock.pixels(), lock.pixels() + nsurf->w * surf->h, palette);
+		result.push_back(nsurf);
 	}
 
-	return nsurf;
+	return result;
 }
 
 surface brighten_image(const surface &surf, fixed_t amount)
@@ -1171,28 +1541,7 @@ surface mask_surface(const surface &surf, const surface &mask, bool* empty_resul
 		const uint32_t* mbeg = mlock.pixels();
 		const uint32_t* mend = mbeg + nmask->w*nmask->h;
 
-		while(beg != end && mbeg != mend) {
-			uint8_t alpha = (*beg) >> 24;
-
-			if(alpha) {
-				uint8_t r, g, b;
-				r = (*beg) >> 16;
-				g = (*beg) >> 8;
-				b = (*beg);
-
-				uint8_t malpha = (*mbeg) >> 24;
-				if (alpha > malpha) {
-					alpha = malpha;
-				}
-				if(alpha)
-					empty = false;
-
-				*beg = (alpha << 24) + (r << 16) + (g << 8) + b;
-			}
-
-			++beg;
-			++mbeg;
-		}
+		empty = mask_pixels(beg, end, mbeg, mend);
 	}
 	if(empty_result)
 		*empty_result = empty;
@@ -1341,33 +1690,7 @@ surface light_surface(const surface &surf, const surface &lightmap)
 		const uint32_t* lbeg = llock.pixels();
 		const uint32_t* lend = lbeg + lightmap->w * lightmap->h;
 
-		while(beg != end && lbeg != lend) {
-			uint8_t alpha = (*beg) >> 24;
-			if(alpha) {
-				uint8_t lr, lg, lb;
-
-				lr = (*lbeg) >> 16;
-				lg = (*lbeg) >> 8;
-				lb = (*lbeg);
-
-				uint8_t r, g, b;
-				r = (*beg) >> 16;
-				g = (*beg) >> 8;
-				b = (*beg);
-
-				int dr = (static_cast<int>(lr) - 128) * 2;
-				int dg = (static_cast<int>(lg) - 128) * 2;
-				int db = (static_cast<int>(lb) - 128) * 2;
-				//note that r + dr will promote r to int (needed to avoid uint8_t math)
-				r = std::max<int>(0,std::min<int>(255, r + dr));
-				g = std::max<int>(0,std::min<int>(255, g + dg));
-				b = std::max<int>(0,std::min<int>(255, b + db));
-
-				*beg = (alpha << 24) + (r << 16) + (g << 8) + b;
-			}
-			++beg;
-			++lbeg;
-		}
+		light_pixels(beg, end, lbeg, lend);
 	}
 
 	return nsurf;
@@ -2077,6 +2400,20 @@ void blit_surface(const surface& surf,
 		uint32_t* dst_pixels = dst_lock.pixels();
 
 		for(unsigned y = 0; y < height; ++y) {
+			const uint32_t* const src_row = src_pixels + (y + src_rect.y) * surf->w + src_rect.x;
+
+			// Map art is mostly fully opaque; when a whole row is, the
+			// per-pixel blend below degenerates into a straight copy.
+			uint32_t opaque = 0xFFFFFFFFu;
+			for(unsigned x = 0; x < width; ++x) {
+				opaque &= src_row[x];
+			}
+
+			if(opaque >= 0xFF000000u) {
+				std::copy_n(src_row, width, dst_pixels + (y + dst_rect.y) * dst->w + dst_rect.x);
+				continue;
+			}
+
 			for(unsigned x = 0; x < width; ++x) {
 
 				// We need to do the blitting using some optimizations
@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include <map>
 #include <string>
+#include <vector>
 
 version_info sdl_get_version();
 
@@ -122,6 +123,17 @@ surface scale_surface_legacy(const surface &surf, int w, int h);
  */
 surface scale_surface_sharp(const surface& surf, int w, int h);
 
+/** Recompute a region of an already scaled surface, as produced by
+ * scale_surface_sharp(). Only the pixels inside dst_area are recalculated
+ * from the source, so the cost is proportional to the region instead of the
+ * whole surface.
+ *  @param surf              The source surface.
+ *  @param dst               The scaled surface to update; must have the
+ *                           dimensions scale_surface_sharp() returned.
+ *  @param dst_area          The region of dst to recompute; clipped to dst.
+ */
+void scale_surface_sharp_region(const surface& surf, surface& dst, const SDL_Rect& dst_area);
+
 /** Tile a surface
  * @param surf               The source surface.
  * @param w                  The width of the resulting surface.
@@ -158,6 +170,15 @@ surface swap_channels_image(const surface& surf, channel r, channel g, channel b
  */
 surface recolor_image(surface surf, const color_range_map& map_rgb);
 
+/**
+ * Recolors a whole set of frames with one palette map in a single pass.
+ *
+ * Equivalent to calling recolor_image() on each surface, but the palette is
+ * flattened only once for the entire set, which matters when team-coloring
+ * the thousands of animation frames prepared at scenario start.
+ */
+std::vector<surface> recolor_images(const std::vector<surface>& surfs, const color_range_map& map_rgb);
+
 surface brighten_image(const surface &surf, fixed_t amount);
 
 /** Get a portion of the screen.
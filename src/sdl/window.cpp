@@ -139,6 +139,11 @@ void window::render()
 	SDL_RenderPresent(*this);
 }
 
+void window::update_rects(const SDL_Rect* rects, int count)
+{
+	SDL_UpdateWindowSurfaceRects(window_, rects, count);
+}
+
 void window::set_title(const std::string& title)
 {
 	SDL_SetWindowTitle(window_, title.c_str());
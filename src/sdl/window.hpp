@@ -137,6 +137,15 @@ public:
 	/** Renders the contents of the window. */
 	void render();
 
+	/**
+	 * Copies only the given regions of the window surface to the display,
+	 * instead of presenting the whole frame.
+	 *
+	 * @param rects               The regions, in window surface coordinates.
+	 * @param count               The number of regions.
+	 */
+	void update_rects(const SDL_Rect* rects, int count);
+
 	/**
 	 * Sets the title of the window.
 	 *
@@ -32,10 +32,48 @@
 #ifdef HAVE_ZLIB
 #include <boost/iostreams/filter/gzip.hpp>
 #endif
+#ifdef HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
 
 static lg::log_domain log_config("config");
 #define ERR_CF LOG_STREAM(err, log_config)
 
+void write_compressed(std::ostream& out, const std::string& in, compression::format compress)
+{
+	if(compress == compression::NONE) {
+		out.write(in.data(), in.size());
+		return;
+	}
+
+	boost::iostreams::filtering_stream<boost::iostreams::output> filter;
+
+	if(compress == compression::GZIP) {
+#ifdef HAVE_ZLIB
+		filter.push(boost::iostreams::gzip_compressor(boost::iostreams::gzip_params(9)));
+#else
+		throw config::error("gzip not supported");
+#endif
+	} else if(compress == compression::BZIP2) {
+#ifdef HAVE_BZIP2
+		filter.push(boost::iostreams::bzip2_compressor(boost::iostreams::bzip2_params()));
+#else
+		throw config::error("bzip2 not supported");
+#endif
+	} else if(compress == compression::ZSTD) {
+#ifdef HAVE_ZSTD
+		filter.push(boost::iostreams::zstd_compressor(boost::iostreams::zstd_params()));
+#else
+		throw config::error("zstd not supported");
+#endif
+	}
+
+	filter.push(out);
+	filter.write(in.data(), in.size());
+	// prevent empty gz files because of https://svn.boost.org/trac/boost/ticket/5237
+	filter << "\n";
+}
+
 config_writer::config_writer(std::ostream& out, compression::format compress)
 	: filter_()
 	, out_ptr_(compress ? &filter_ : &out) // ternary indirection creates a temporary
@@ -56,7 +94,14 @@ config_writer::config_writer(std::ostream& out, compression::format compress)
 		filter_.push(boost::iostreams::bzip2_compressor(boost::iostreams::bzip2_params()));
 		filter_.push(out);
 #else
-		throw config::error("bzip2 not supported");		
+		throw config::error("bzip2 not supported");
+#endif
+	} else if(compress_ == compression::ZSTD) {
+#ifdef HAVE_ZSTD
+		filter_.push(boost::iostreams::zstd_compressor(boost::iostreams::zstd_params()));
+		filter_.push(out);
+#else
+		throw config::error("zstd not supported");
 #endif
 	}
 }
@@ -84,8 +129,8 @@ config_writer::config_writer(std::ostream& out, bool compress, int level)
 
 config_writer::~config_writer()
 {
-	// we only need this for gzip but we also do it for bz2 for unification.
-	if(compress_ == compression::GZIP || compress_ == compression::BZIP2) {
+	// we only need this for gzip but we also do it for bz2 and zstd for unification.
+	if(compress_ != compression::NONE) {
 		// prevent empty gz files because of https://svn.boost.org/trac/boost/ticket/5237
 		out_ << "\n";
 	}
@@ -113,6 +158,11 @@ void config_writer::close_child(const std::string& key)
 	::write_close_child(out_, key, --level_);
 }
 
+void config_writer::write_raw(const std::string& data)
+{
+	out_.write(data.data(), data.size());
+}
+
 bool config_writer::good() const
 {
 	return out_.good();
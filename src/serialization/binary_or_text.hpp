@@ -23,6 +23,14 @@
 
 #include <boost/iostreams/filtering_stream.hpp>
 
+/**
+ * Compresses an already serialized buffer with @a compress and writes the
+ * result to @a out. With compression::NONE the buffer is written unchanged.
+ * Separating serialization from compression this way allows the (usually much
+ * slower) compression step to run on another thread.
+ */
+void write_compressed(std::ostream& out, const std::string& in, compression::format compress);
+
 /** Class for writing a config out to a file in pieces. */
 class config_writer
 {
@@ -37,6 +45,12 @@ public:
 	void write_child(const std::string &key, const config &cfg);
 	void open_child(const std::string &key);
 	void close_child(const std::string &key);
+
+	/**
+	 * Writes already-serialized WML. The caller is responsible for having
+	 * formatted @a data for the current nesting level.
+	 */
+	void write_raw(const std::string &data);
 	bool good() const;
 
 	/** This template function will work with any type that can be assigned to an attribute_value. */
@@ -0,0 +1,313 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "serialization/binary_wml.hpp"
+
+#include "config.hpp"
+#include "filesystem.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+const uint32_t binary_wml_magic = 0x424c4d57; // "WMLB" on little-endian disks
+const uint32_t binary_wml_version = 1;
+
+// Attribute value kinds; the order is part of the format.
+enum class attr_kind : uint8_t
+{
+	true_false = 1,
+	yes_no = 2,
+	integer = 3,
+	unsigned_integer = 4,
+	floating = 5,
+	string = 6,
+	tstring = 7,
+};
+
+/** Interns tag and attribute names, which repeat massively across a tree. */
+class string_table
+{
+public:
+	uint32_t index_of(const std::string& s)
+	{
+		auto res = indices_.emplace(s, static_cast<uint32_t>(strings_.size()));
+		if(res.second) {
+			strings_.push_back(&res.first->first);
+		}
+		return res.first->second;
+	}
+
+	void write(std::ostream& out) const;
+
+private:
+	std::map<std::string, uint32_t> indices_;
+	std::vector<const std::string*> strings_;
+};
+
+template<typename T>
+void write_raw(std::ostream& out, const T& value)
+{
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_string(std::ostream& out, const std::string& s)
+{
+	write_raw(out, static_cast<uint32_t>(s.size()));
+	out.write(s.data(), s.size());
+}
+
+void string_table::write(std::ostream& out) const
+{
+	write_raw(out, static_cast<uint32_t>(strings_.size()));
+	for(const std::string* s : strings_) {
+		write_string(out, *s);
+	}
+}
+
+/** Writes one attribute value tagged with its exact variant kind. */
+struct value_writer
+{
+	std::ostream& out;
+
+	void operator()(const utils::monostate&) const
+	{
+		// Unreachable: write_node() skips blank values, treating them as
+		// nonexistent just like the textual writer. The overload only exists
+		// because variant visitation has to be exhaustive.
+		throw config::error("attempt to serialize a blank attribute value");
+	}
+
+	void operator()(const config_attribute_value::true_false& v) const
+	{
+		write_raw(out, attr_kind::true_false);
+		write_raw(out, static_cast<uint8_t>(bool(v)));
+	}
+
+	void operator()(const config_attribute_value::yes_no& v) const
+	{
+		write_raw(out, attr_kind::yes_no);
+		write_raw(out, static_cast<uint8_t>(bool(v)));
+	}
+
+	void operator()(int v) const
+	{
+		write_raw(out, attr_kind::integer);
+		write_raw(out, static_cast<int64_t>(v));
+	}
+
+	void operator()(unsigned long long v) const
+	{
+		write_raw(out, attr_kind::unsigned_integer);
+		write_raw(out, static_cast<uint64_t>(v));
+	}
+
+	void operator()(double v) const
+	{
+		write_raw(out, attr_kind::floating);
+		write_raw(out, v);
+	}
+
+	void operator()(const std::string& v) const
+	{
+		write_raw(out, attr_kind::string);
+		write_string(out, v);
+	}
+
+	void operator()(const t_string& v) const
+	{
+		write_raw(out, attr_kind::tstring);
+		write_string(out, v.to_serialized());
+	}
+};
+
+void write_node(std::ostream& out, const config& cfg, string_table& strings)
+{
+	// Blank attribute values occur — non-const config::operator[] inserts a
+	// persistent one on mere read access — and, like the textual writer,
+	// they are not serialized. attribute_count() happens to exclude blanks
+	// too, but the record framing must match the loop below exactly, so
+	// count the records the loop itself will emit.
+	uint32_t n_attrs = 0;
+	for(const config::attribute& a : cfg.attribute_range()) {
+		if(!a.second.blank()) {
+			++n_attrs;
+		}
+	}
+
+	write_raw(out, n_attrs);
+	for(const config::attribute& a : cfg.attribute_range()) {
+		if(a.second.blank()) {
+			continue;
+		}
+		write_raw(out, strings.index_of(a.first));
+		a.second.apply_visitor(value_writer{out});
+	}
+
+	write_raw(out, static_cast<uint32_t>(cfg.all_children_count()));
+	for(const config::any_child& child : cfg.all_children_range()) {
+		write_raw(out, strings.index_of(child.key));
+		write_node(out, child.cfg, strings);
+	}
+}
+
+/** Bounds-checked cursor over the mapped bytes. */
+class reader
+{
+public:
+	reader(const char* begin, std::size_t size)
+		: pos_(begin)
+		, end_(begin + size)
+	{
+	}
+
+	template<typename T>
+	T get()
+	{
+		T res;
+		require(sizeof(T));
+		std::memcpy(&res, pos_, sizeof(T));
+		pos_ += sizeof(T);
+		return res;
+	}
+
+	std::string_view get_string()
+	{
+		const uint32_t len = get<uint32_t>();
+		require(len);
+		std::string_view res(pos_, len);
+		pos_ += len;
+		return res;
+	}
+
+private:
+	void require(std::size_t n) const
+	{
+		if(static_cast<std::size_t>(end_ - pos_) < n) {
+			throw config::error("binary WML cache is truncated");
+		}
+	}
+
+	const char* pos_;
+	const char* end_;
+};
+
+void read_node(reader& in, config& cfg, const std::vector<std::string>& strings)
+{
+	auto string_at = [&strings](uint32_t i) -> const std::string& {
+		if(i >= strings.size()) {
+			throw config::error("binary WML cache references an unknown string");
+		}
+		return strings[i];
+	};
+
+	const uint32_t n_attrs = in.get<uint32_t>();
+	for(uint32_t i = 0; i != n_attrs; ++i) {
+		config::attribute_value& value = cfg[string_at(in.get<uint32_t>())];
+
+		switch(static_cast<attr_kind>(in.get<uint8_t>())) {
+		case attr_kind::true_false:
+			value = in.get<uint8_t>() != 0;
+			break;
+		case attr_kind::yes_no:
+			// Assignment through the string form restores the yes_no variant.
+			value = std::string(in.get<uint8_t>() != 0 ? "yes" : "no");
+			break;
+		case attr_kind::integer:
+			value = static_cast<long long>(in.get<int64_t>());
+			break;
+		case attr_kind::unsigned_integer:
+			value = static_cast<unsigned long long>(in.get<uint64_t>());
+			break;
+		case attr_kind::floating:
+			value = in.get<double>();
+			break;
+		case attr_kind::string:
+			value = in.get_string();
+			break;
+		case attr_kind::tstring:
+			value = t_string::from_serialized(std::string(in.get_string()));
+			break;
+		default:
+			throw config::error("binary WML cache contains an unknown value kind");
+		}
+	}
+
+	const uint32_t n_children = in.get<uint32_t>();
+	for(uint32_t i = 0; i != n_children; ++i) {
+		config& child = cfg.add_child(string_at(in.get<uint32_t>()));
+		read_node(in, child, strings);
+	}
+}
+
+} // namespace
+
+void write_binary(std::ostream& out, const config& cfg)
+{
+	write_raw(out, binary_wml_magic);
+	write_raw(out, binary_wml_version);
+
+	// The node stream references the string table by index, so the table has
+	// to be known before the nodes can be emitted; serialize the nodes to a
+	// side buffer while filling it.
+	std::ostringstream nodes;
+	string_table strings;
+	write_node(nodes, cfg, strings);
+
+	strings.write(out);
+	out << nodes.str();
+
+	if(!out.good()) {
+		throw config::error("error writing binary WML cache");
+	}
+}
+
+void read_binary_file(config& cfg, const std::string& file_path)
+{
+	boost::iostreams::mapped_file_source file;
+
+	try {
+		file.open(file_path);
+	} catch(const std::exception&) {
+		throw filesystem::io_exception("Could not map file: " + file_path);
+	}
+
+	reader in(file.data(), file.size());
+
+	if(in.get<uint32_t>() != binary_wml_magic) {
+		throw config::error("not a binary WML cache: " + file_path);
+	}
+	if(in.get<uint32_t>() != binary_wml_version) {
+		throw config::error("binary WML cache version mismatch: " + file_path);
+	}
+
+	const uint32_t n_strings = in.get<uint32_t>();
+	std::vector<std::string> strings;
+	strings.reserve(n_strings);
+	for(uint32_t i = 0; i != n_strings; ++i) {
+		strings.emplace_back(in.get_string());
+	}
+
+	cfg.clear();
+	read_node(in, cfg, strings);
+}
@@ -0,0 +1,42 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+/**
+ * @file
+ * Versioned binary serialization of config trees.
+ *
+ * Unlike the textual WML formats in parser.hpp this keeps the typed
+ * attribute values intact, interns repeated tag and attribute names in a
+ * string table, and can be read back straight from a memory-mapped file
+ * without any tokenizing or parsing. It is intended for machine-local
+ * caches (see config_cache), not for interchange: the byte order is the
+ * host's and the format version is bumped whenever the layout changes.
+ */
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+class config;
+
+/** Writes @a cfg to @a out in the binary cache format. Throws config::error. */
+void write_binary(std::ostream& out, const config& cfg);
+
+/**
+ * Reads a binary cache file into @a cfg by memory-mapping it.
+ * Throws config::error on malformed input or a format version mismatch,
+ * and filesystem::io_exception if the file cannot be mapped.
+ */
+void read_binary_file(config& cfg, const std::string& file_path);
@@ -21,7 +21,8 @@ namespace compression {
 	enum format {
 		NONE,
 		GZIP,
-		BZIP2
+		BZIP2,
+		ZSTD
 	};
 
 	inline std::string format_extension(format compression_format)
@@ -31,6 +32,8 @@ namespace compression {
 			return ".gz";
 		case BZIP2:
 			return ".bz2";
+		case ZSTD:
+			return ".zst";
 		case NONE:
 			return "";
 		}
@@ -46,12 +46,18 @@
 #ifdef HAVE_ZLIB
 #include <boost/iostreams/filter/gzip.hpp>
 #endif
+#ifdef HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
 
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
 
+#include <future>
 #include <stack>
+#include <string_view>
+#include <thread>
 
 static lg::log_domain log_config("config");
 #define ERR_CF LOG_STREAM(err, log_config)
@@ -639,6 +645,181 @@ void read(config& cfg, const std::string& in, abstract_validator* validator)
 	parser(cfg, ss, validator)();
 }
 
+namespace
+{
+
+/**
+ * Splits preprocessed WML into independently parseable pieces at balanced
+ * top-level tag boundaries.
+ *
+ * The scanner tracks quoted strings, << >> blocks and comments so brackets
+ * inside them do not count, and records the inline file/line/textdomain
+ * markers emitted by the preprocessor (see tokenizer::skip_comment) so each
+ * chunk can be prefixed with the marker state it starts under. Boundaries are
+ * never placed before [+tag] amendments, which must stay with the block they
+ * amend.
+ */
+std::vector<std::string> split_top_level(const std::string& in, std::size_t target_chunk_size)
+{
+	enum class scan_state { plain, quoted, raw_string };
+	scan_state state = scan_state::plain;
+
+	int depth = 0;
+	std::size_t chunk_start = 0;
+	std::string prefix;
+
+	std::string cur_textdomain;
+	std::string cur_file;
+	int cur_line = 0;
+	bool have_line_marker = false;
+	int newlines_since_marker = 0;
+
+	std::vector<std::string> chunks;
+
+	// Consumes a comment or preprocessor marker up to (not including) the
+	// trailing newline and updates the marker state.
+	auto scan_comment = [&](std::size_t i) {
+		const std::size_t start = i + 1;
+		std::size_t end = in.find('\n', start);
+		if(end == std::string::npos) {
+			end = in.size();
+		}
+
+		const std::string_view body(in.data() + start, end - start);
+		if(body.compare(0, 11, "textdomain ") == 0) {
+			cur_textdomain = std::string(body.substr(11));
+		} else if(body.compare(0, 5, "line ") == 0) {
+			std::size_t p = 5;
+			int line = 0;
+			while(p < body.size() && body[p] >= '0' && body[p] <= '9') {
+				line = line * 10 + (body[p] - '0');
+				++p;
+			}
+			if(p < body.size() && body[p] == ' ') {
+				cur_line = line;
+				cur_file = std::string(body.substr(p + 1));
+				have_line_marker = true;
+				newlines_since_marker = -1; // the marker's own newline follows
+			}
+		}
+
+		return end - 1; // the loop increment lands on the newline
+	};
+
+	auto flush = [&](std::size_t end) {
+		chunks.push_back(prefix + in.substr(chunk_start, end - chunk_start));
+		chunk_start = end;
+
+		prefix.clear();
+		if(!cur_textdomain.empty()) {
+			prefix += '\376';
+			prefix += "textdomain " + cur_textdomain + '\n';
+		}
+		if(have_line_marker) {
+			prefix += '\376';
+			prefix += "line " + std::to_string(cur_line + newlines_since_marker) + ' ' + cur_file + '\n';
+		}
+	};
+
+	for(std::size_t i = 0; i < in.size(); ++i) {
+		const char c = in[i];
+
+		if(c == '\n') {
+			++newlines_since_marker;
+			continue;
+		}
+
+		// Preprocessor markers can appear anywhere, even inside strings.
+		if(static_cast<unsigned char>(c) == 254) {
+			i = scan_comment(i);
+			continue;
+		}
+
+		switch(state) {
+		case scan_state::plain:
+			if(c == '"') {
+				state = scan_state::quoted;
+			} else if(c == '<' && i + 1 < in.size() && in[i + 1] == '<') {
+				state = scan_state::raw_string;
+				++i;
+			} else if(c == '#') {
+				i = scan_comment(i);
+			} else if(c == '[') {
+				const char next = i + 1 < in.size() ? in[i + 1] : '\0';
+				if(next == '/') {
+					--depth;
+				} else {
+					if(depth == 0 && next != '+' && i - chunk_start >= target_chunk_size) {
+						flush(i);
+					}
+					++depth;
+				}
+			}
+			break;
+
+		case scan_state::quoted:
+			// Doubled quotes toggle out and straight back in, which is
+			// exactly the escaping rule, so no special case is needed.
+			if(c == '"') {
+				state = scan_state::plain;
+			}
+			break;
+
+		case scan_state::raw_string:
+			if(c == '>' && i + 1 < in.size() && in[i + 1] == '>') {
+				state = scan_state::plain;
+				++i;
+			}
+			break;
+		}
+	}
+
+	flush(in.size());
+	return chunks;
+}
+
+} // end anon namespace
+
+void read_parallel(config& cfg, const std::string& in, abstract_validator* validator)
+{
+	const std::size_t n_threads = std::thread::hardware_concurrency();
+	// Below this size the split/merge overhead swamps any gain.
+	const std::size_t min_parallel_size = 4u * 1024 * 1024;
+
+	// Validators carry state across elements and are not thread-safe.
+	if(validator || n_threads < 2 || in.size() < min_parallel_size) {
+		read(cfg, in, validator);
+		return;
+	}
+
+	const std::vector<std::string> chunks = split_top_level(in, in.size() / (4 * n_threads) + 1);
+	if(chunks.size() < 2) {
+		read(cfg, in);
+		return;
+	}
+
+	std::vector<config> results(chunks.size());
+	std::vector<std::future<void>> workers;
+	workers.reserve(chunks.size());
+
+	for(std::size_t i = 0; i < chunks.size(); ++i) {
+		workers.push_back(std::async(std::launch::async, [&chunks, &results, i]() {
+			read(results[i], chunks[i]);
+		}));
+	}
+
+	// get() rethrows the first parse error; the remaining futures block in
+	// their destructors until every worker is done.
+	for(std::future<void>& worker : workers) {
+		worker.get();
+	}
+
+	cfg.clear();
+	for(config& result : results) {
+		cfg.append(std::move(result));
+	}
+}
+
 template<typename decompressor>
 void read_compressed(config& cfg, std::istream& file, abstract_validator* validator)
 {
@@ -703,6 +884,16 @@ void read_bz2(config& cfg, std::istream& file, abstract_validator* validator)
 #endif
 }
 
+/** Might throw a std::ios_base::failure especially a zstd_error. */
+void read_zstd(config& cfg, std::istream& file, abstract_validator* validator)
+{
+#ifdef HAVE_ZSTD
+	read_compressed<boost::iostreams::zstd_decompressor>(cfg, file, validator);
+#else
+	throw config::error("zstd not supported");
+#endif
+}
+
 void write_key_val(std::ostream& out,
 		const std::string& key,
 		const config::attribute_value& value,
@@ -809,3 +1000,12 @@ void write_bz2(std::ostream& out, const configr_of& cfg)
 	throw config::error("bzip2 not supported");
 #endif
 }
+
+void write_zstd(std::ostream& out, const configr_of& cfg)
+{
+#ifdef HAVE_ZSTD
+	write_compressed<boost::iostreams::zstd_compressor>(out, cfg);
+#else
+	throw config::error("zstd not supported");
+#endif
+}
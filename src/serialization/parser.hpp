@@ -25,12 +25,20 @@ class abstract_validator;
 // Read data in, clobbering existing data.
 void read(config& cfg, std::istream& in, abstract_validator* validator = nullptr);      // Throws config::error
 void read(config& cfg, const std::string& in, abstract_validator* validator = nullptr); // Throws config::error
+/**
+ * Parses independent top-level tag blocks on all cores and merges the results
+ * in order. Falls back to the sequential read() for small inputs or when a
+ * validator (which is stateful) is supplied.
+ */
+void read_parallel(config& cfg, const std::string& in, abstract_validator* validator = nullptr); // Throws config::error
 void read_gz(config& cfg, std::istream& in, abstract_validator* validator = nullptr);
 void read_bz2(config& cfg, std::istream& in, abstract_validator* validator = nullptr);
+void read_zstd(config& cfg, std::istream& in, abstract_validator* validator = nullptr);
 
 void write(std::ostream& out, const configr_of& cfg, unsigned int level = 0);
 void write_gz(std::ostream& out, const configr_of& cfg);
 void write_bz2(std::ostream& out, const configr_of& cfg);
+void write_zstd(std::ostream& out, const configr_of& cfg);
 void write_key_val(std::ostream& out,
 		const std::string& key,
 		const config::attribute_value& value,
@@ -34,6 +34,8 @@
 
 #include <stdexcept>
 #include <deque>
+#include <optional>
+#include <unordered_map>
 
 static lg::log_domain log_preprocessor("preprocessor");
 #define ERR_PREPROC LOG_STREAM(err, log_preprocessor)
@@ -128,6 +130,18 @@ static std::string get_location(const std::string& loc)
 	return res;
 }
 
+// Strips the embedded line and textdomain markers from a chunk of output.
+static std::string strip_output_markers(std::string str)
+{
+	std::string::size_type pos;
+	while((pos = str.find(OUTPUT_SEPARATOR)) != std::string::npos) {
+		std::string::iterator b = str.begin(); // invalidated at each iteration
+		str.erase(b + pos, b + str.find('\n', pos + 1) + 1);
+	}
+
+	return str;
+}
+
 
 // ==================================================================================
 // PREPROC_DEFINE IMPLEMENTATION
@@ -773,6 +787,73 @@ bool operator!=(char lhs, preprocessor_data::token_desc::TOKEN_TYPE rhs)
 	return rhs != lhs;
 }
 
+namespace
+{
+	// Active dependency collectors, see preproc_dependency_recorder.
+	std::set<std::string>* dependency_files = nullptr;
+	std::set<std::string>* dependency_directories = nullptr;
+
+	/**
+	 * Memoized macro expansions, see the macro substitution code in
+	 * preprocessor_data::get_chunk(). Each entry maps a macro symbol plus its
+	 * bound arguments to the fully preprocessed output of that invocation, so
+	 * repeated identical invocations splice the stored chunk instead of being
+	 * expanded again. #define and #undef bump @ref expansion_generation, which
+	 * invalidates everything recorded before them; the whole cache is dropped
+	 * whenever a new top-level preprocessing scope starts, since the files a
+	 * cached expansion pulled in may have changed in between.
+	 */
+	struct cached_expansion
+	{
+		unsigned generation = 0;
+
+		/** True once the key has been invoked; output is only captured when a key repeats. */
+		bool seen = false;
+
+		std::optional<std::string> text;
+	};
+
+	std::unordered_map<std::string, cached_expansion> expansion_cache;
+	unsigned expansion_generation = 0;
+
+	/** Keeps pathological argument sets from hoarding memory. */
+	const std::size_t max_expansion_cache_bytes = 8'000'000;
+	std::size_t expansion_cache_bytes = 0;
+
+	void store_expansion(const std::string& key, const std::string& text)
+	{
+		if(expansion_cache_bytes + text.size() > max_expansion_cache_bytes) {
+			expansion_cache.clear();
+			expansion_cache_bytes = 0;
+		}
+
+		cached_expansion& entry = expansion_cache[key];
+		entry.generation = expansion_generation;
+		entry.seen = true;
+		entry.text = text;
+
+		expansion_cache_bytes += text.size();
+	}
+
+	void clear_expansion_cache()
+	{
+		expansion_cache.clear();
+		expansion_cache_bytes = 0;
+	}
+}
+
+preproc_dependency_recorder::preproc_dependency_recorder(std::set<std::string>& files, std::set<std::string>& directories)
+{
+	dependency_files = &files;
+	dependency_directories = &directories;
+}
+
+preproc_dependency_recorder::~preproc_dependency_recorder()
+{
+	dependency_files = nullptr;
+	dependency_directories = nullptr;
+}
+
 /** preprocessor_file constructor. */
 preprocessor_file::preprocessor_file(preprocessor_streambuf& t, const std::string& name, std::size_t symbol_index)
 	: preprocessor(t)
@@ -783,6 +864,10 @@ preprocessor_file::preprocessor_file(preprocessor_streambuf& t, const std::strin
 	, is_directory_(filesystem::is_directory(name))
 {
 	if(is_directory_) {
+		if(dependency_directories) {
+			dependency_directories->insert(name);
+		}
+
 		filesystem::get_files_in_dir(name, &files_, nullptr,
 			filesystem::name_mode::ENTIRE_FILE_PATH,
 			filesystem::filter_mode::SKIP_MEDIA_DIR,
@@ -816,6 +901,10 @@ void preprocessor_file::init()
 		return;
 	}
 
+	if(dependency_files) {
+		dependency_files->insert(name_);
+	}
+
 	filesystem::scoped_istream file_stream = filesystem::istream_file(name_);
 
 	if(!file_stream->good()) {
@@ -1318,6 +1407,8 @@ bool preprocessor_data::get_chunk()
 						= preproc_define(buffer, items, optargs, parent_.textdomain_, linenum, parent_.location_,
 						deprecation_detail, deprecation_level, deprecation_version);
 
+				++expansion_generation;
+
 				LOG_PREPROC << "defining macro " << symbol << " (location " << get_location(parent_.location_) << ")\n";
 			}
 		} else if(command == "ifdef" || command == "ifndef") {
@@ -1410,6 +1501,7 @@ bool preprocessor_data::get_chunk()
 			const std::string& symbol = read_word();
 			if(!skipping_) {
 				parent_.defines_->erase(symbol);
+				++expansion_generation;
 				LOG_PREPROC << "undefine macro " << symbol << " (location " << get_location(parent_.location_) << ")\n";
 			}
 		} else if(command == "error") {
@@ -1485,12 +1577,7 @@ bool preprocessor_data::get_chunk()
 				parent_.error("No macro or file substitution target specified", linenum_);
 			}
 
-			std::string symbol = strings_[token.stack_pos];
-			std::string::size_type pos;
-			while((pos = symbol.find(OUTPUT_SEPARATOR)) != std::string::npos) {
-				std::string::iterator b = symbol.begin(); // invalidated at each iteration
-				symbol.erase(b + pos, b + symbol.find('\n', pos + 1) + 1);
-			}
+			std::string symbol = strip_output_markers(strings_[token.stack_pos]);
 
 			std::map<std::string, std::string>::const_iterator arg;
 			preproc_map::const_iterator macro;
@@ -1611,7 +1698,68 @@ bool preprocessor_data::get_chunk()
 
 				pop_token();
 
-				if(!slowpath_) {
+				// Repeated invocations of a macro with the same arguments produce
+				// the same expansion, so the preprocessed output is memoized and
+				// spliced back into the stream when the invocation comes up again.
+				// The line markers embedded in the argument values are ignored by
+				// the key, so a hit replays the markers of the invocation that was
+				// captured; the macro body's own markers never reference the call
+				// site. Macros mentioning CURRENT_FILE or CURRENT_DIRECTORY are
+				// never cached, since those resolve differently per call site.
+				std::string cache_key;
+				const std::string* cached_text = nullptr;
+				bool capture = false;
+
+				if(!parent_.quoted_
+						&& val.value.find(current_file_str) == std::string::npos
+						&& val.value.find(current_dir_str) == std::string::npos) {
+					cache_key = symbol;
+					cache_key += OUTPUT_SEPARATOR;
+					cache_key += parent_.textdomain_;
+
+					for(const auto& define : *defines) {
+						cache_key += OUTPUT_SEPARATOR;
+						cache_key += define.first;
+						cache_key += '=';
+						cache_key += strip_output_markers(define.second);
+					}
+
+					cached_expansion& entry = expansion_cache[cache_key];
+					if(entry.generation != expansion_generation) {
+						if(entry.text) {
+							expansion_cache_bytes -= entry.text->size();
+						}
+
+						entry.generation = expansion_generation;
+						entry.seen = false;
+						entry.text.reset();
+					}
+
+					if(entry.text) {
+						cached_text = &*entry.text;
+					}
+
+					// Streaming an expansion is cheaper than capturing it, so the
+					// output is only captured once a key is seen a second time.
+					capture = !cached_text && entry.seen;
+					entry.seen = true;
+				}
+
+				if(cached_text) {
+					DBG_PREPROC << "substituting (cached) macro " << symbol << '\n';
+
+					if(slowpath_) {
+						put(*cached_text);
+					} else {
+						// Like macro argument substitution above: splice the text,
+						// then restore our position with explicit markers.
+						std::ostringstream v;
+						v << *cached_text << OUTPUT_SEPARATOR << "line " << linenum_ << ' ' << parent_.location_
+						  << "\n" << OUTPUT_SEPARATOR << "textdomain " << parent_.textdomain_ << '\n';
+
+						put(v.str());
+					}
+				} else if(!slowpath_ && !capture) {
 					DBG_PREPROC << "substituting macro " << symbol << '\n';
 
 					parent_.add_preprocessor<preprocessor_data>(
@@ -1625,6 +1773,8 @@ bool preprocessor_data::get_chunk()
 					// restoring our current textdomain if needed.
 					buf->textdomain_ = parent_.textdomain_;
 
+					const unsigned generation = expansion_generation;
+
 					std::ostringstream res;
 					{
 						std::istream in(buf.get());
@@ -1634,7 +1784,21 @@ bool preprocessor_data::get_chunk()
 						res << in.rdbuf();
 					}
 
-					put(res.str());
+					// Only expansions free of side effects on the define map can
+					// be replayed; anything else must be expanded every time.
+					if(!cache_key.empty() && expansion_generation == generation) {
+						store_expansion(cache_key, res.str());
+					}
+
+					if(slowpath_) {
+						put(res.str());
+					} else {
+						std::ostringstream v;
+						v << res.str() << OUTPUT_SEPARATOR << "line " << linenum_ << ' ' << parent_.location_
+						  << "\n" << OUTPUT_SEPARATOR << "textdomain " << parent_.textdomain_ << '\n';
+
+						put(v.str());
+					}
 				}
 			} else if(parent_.depth() < 40) {
 				LOG_PREPROC << "Macro definition not found for " << symbol << " , attempting to open as file.\n";
@@ -1709,6 +1873,10 @@ struct preprocessor_scope_helper : std::basic_istream<char>
 
 		buf_.reset(new preprocessor_streambuf(defines));
 
+		// The files a cached macro expansion read may have changed since the
+		// last scope ended (that is usually why we are preprocessing again).
+		clear_expansion_cache();
+
 		// Begin processing.
 		buf_->add_preprocessor<preprocessor_file>(fname);
 
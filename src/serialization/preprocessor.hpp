@@ -24,6 +24,7 @@
 
 #include <iosfwd>
 #include <map>
+#include <set>
 #include <vector>
 
 class config_writer;
@@ -141,6 +142,23 @@ std::ostream& operator<<(std::ostream& stream, const preproc_map::value_type& de
  */
 filesystem::scoped_istream preprocess_file(const std::string& fname, preproc_map* defines = nullptr);
 
+/**
+ * While an object of this type is in scope, every file the preprocessor
+ * opens and every directory it enumerates is recorded into the given sets.
+ * config_cache uses this to write a per-entry dependency list, so a cache
+ * entry only has to be rebuilt when one of the files it was actually built
+ * from changes. Scopes do not nest.
+ */
+class preproc_dependency_recorder
+{
+public:
+	preproc_dependency_recorder(std::set<std::string>& files, std::set<std::string>& directories);
+	~preproc_dependency_recorder();
+
+	preproc_dependency_recorder(const preproc_dependency_recorder&) = delete;
+	preproc_dependency_recorder& operator=(const preproc_dependency_recorder&) = delete;
+};
+
 void preprocess_resource(const std::string& res_name,
 		preproc_map* defines_map,
 		bool write_cfg = false,
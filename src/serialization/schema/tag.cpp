@@ -106,8 +106,12 @@ void wml_tag::add_link(const std::string& link)
 	links_.emplace(name_link, link);
 }
 
-const wml_key* wml_tag::find_key(const std::string& name, const config& match, bool ignore_super) const
+const wml_key* wml_tag::find_key(const std::string& name, const config& match, bool ignore_super, bool* conditions_used) const
 {
+	if(conditions_used && !conditions_.empty()) {
+		*conditions_used = true;
+	}
+
 	// Check the conditions first, so that conditional definitions
 	// override base definitions in the event of duplicates.
 	for(auto& cond : conditions_) {
@@ -143,7 +147,7 @@ const wml_key* wml_tag::find_key(const std::string& name, const config& match, b
 			}
 		}
 		for(auto& super_tag : super_refs_) {
-			if(const wml_key* found_key = super_tag->find_key(name, match)) {
+			if(const wml_key* found_key = super_tag->find_key(name, match, false, conditions_used)) {
 				return found_key;
 			}
 		}
@@ -162,12 +166,16 @@ const std::string* wml_tag::find_link(const std::string& name) const
 	return nullptr;
 }
 
-const wml_tag* wml_tag::find_tag(const std::string& fullpath, const wml_tag& root, const config& match, bool ignore_super) const
+const wml_tag* wml_tag::find_tag(const std::string& fullpath, const wml_tag& root, const config& match, bool ignore_super, bool* conditions_used) const
 {
 	if(fullpath.empty()) {
 		return nullptr;
 	}
 
+	if(conditions_used && !conditions_.empty()) {
+		*conditions_used = true;
+	}
+
 	std::string::size_type pos = fullpath.find('/');
 	std::string name;
 	std::string next_path;
@@ -194,13 +202,13 @@ const wml_tag* wml_tag::find_tag(const std::string& fullpath, const wml_tag& roo
 		if(next_path.empty()) {
 			return &(it_tags->second);
 		} else {
-			return it_tags->second.find_tag(next_path, root, match);
+			return it_tags->second.find_tag(next_path, root, match, false, conditions_used);
 		}
 	}
 
 	const auto it_links = links_.find(name);
 	if(it_links != links_.end()) {
-		return root.find_tag(it_links->second + "/" + next_path, root, match);
+		return root.find_tag(it_links->second + "/" + next_path, root, match, false, conditions_used);
 	}
 
 	const auto it_fuzzy = std::find_if(tags_.begin(), tags_.end(), [&name](const tag_map::value_type& tag){
@@ -213,7 +221,7 @@ const wml_tag* wml_tag::find_tag(const std::string& fullpath, const wml_tag& roo
 		if(next_path.empty()) {
 			return &(it_fuzzy->second);
 		} else {
-			return it_tags->second.find_tag(next_path, root, match);
+			return it_tags->second.find_tag(next_path, root, match, false, conditions_used);
 		}
 	}
 
@@ -227,7 +235,7 @@ const wml_tag* wml_tag::find_tag(const std::string& fullpath, const wml_tag& roo
 			}
 		}
 		for(auto& super_tag : super_refs_) {
-			if(const wml_tag* found_tag = super_tag->find_tag(fullpath, root, match)) {
+			if(const wml_tag* found_tag = super_tag->find_tag(fullpath, root, match, false, conditions_used)) {
 				return found_tag;
 			}
 		}
@@ -238,7 +246,7 @@ const wml_tag* wml_tag::find_tag(const std::string& fullpath, const wml_tag& roo
 	}
 
 	return nullptr;
- }
+}
 
 void wml_tag::expand_all(wml_tag& root)
 {
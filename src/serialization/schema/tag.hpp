@@ -283,8 +283,13 @@ public:
 		return name_ == other.name_;
 	}
 
-	/** Returns pointer to child key. */
-	const wml_key* find_key(const std::string& name, const config& match, bool ignore_super = false) const;
+	/**
+	 * Returns pointer to child key.
+	 * If @a conditions_used is given, it is set whenever a conditional
+	 * definition was consulted, i.e. whenever the result may depend on the
+	 * @a match config and must not be cached by name alone.
+	 */
+	const wml_key* find_key(const std::string& name, const config& match, bool ignore_super = false, bool* conditions_used = nullptr) const;
 
 	/** Returns pointer to child link. */
 	const std::string* find_link(const std::string& name) const;
@@ -292,8 +297,9 @@ public:
 	/**
 	 * Returns pointer to tag using full path to it.
 	 * Also work with links
+	 * @a conditions_used reports condition use as for find_key().
 	 */
-	const wml_tag* find_tag(const std::string& fullpath, const wml_tag& root, const config& match, bool ignore_super = false) const;
+	const wml_tag* find_tag(const std::string& fullpath, const wml_tag& root, const config& match, bool ignore_super = false, bool* conditions_used = nullptr) const;
 
 	/** Calls the expansion on each child. */
 	void expand_all(wml_tag& root);
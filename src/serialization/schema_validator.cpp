@@ -242,7 +242,7 @@ void schema_validator::open_tag(const std::string& name, const config& parent, i
 		const wml_tag* tag = nullptr;
 
 		if(stack_.top()) {
-			tag = active_tag().find_tag(name, root_, parent);
+			tag = find_tag_cached(name, parent);
 
 			if(!tag) {
 				wrong_tag_error(file, start_line, name, stack_.top()->get_name(), create_exceptions_);
@@ -329,7 +329,7 @@ void schema_validator::validate_key(
 {
 	if(have_active_tag() && !active_tag().get_name().empty() && is_valid()) {
 		// checking existing keys
-		const wml_key* key = active_tag().find_key(name, cfg);
+		const wml_key* key = find_key_cached(name, cfg);
 		if(key) {
 			bool matched = false;
 			for(auto& possible_type : utils::split(key->get_type())) {
@@ -355,6 +355,46 @@ const wml_tag& schema_validator::active_tag() const
 	return *stack_.top();
 }
 
+const wml_tag* schema_validator::find_tag_cached(const std::string& name, const config& match)
+{
+	const wml_tag* parent = &active_tag();
+
+	const auto cached = tag_lookup_cache_.find(std::pair(parent, name));
+	if(cached != tag_lookup_cache_.end()) {
+		return cached->second;
+	}
+
+	bool conditions_used = false;
+	const wml_tag* tag = parent->find_tag(name, root_, match, false, &conditions_used);
+
+	// A lookup that consulted a conditional definition depends on the
+	// matched config, not just the name, and must be redone every time.
+	if(!conditions_used) {
+		tag_lookup_cache_.emplace(std::pair(parent, name), tag);
+	}
+
+	return tag;
+}
+
+const wml_key* schema_validator::find_key_cached(const std::string& name, const config& match)
+{
+	const wml_tag* parent = &active_tag();
+
+	const auto cached = key_lookup_cache_.find(std::pair(parent, name));
+	if(cached != key_lookup_cache_.end()) {
+		return cached->second;
+	}
+
+	bool conditions_used = false;
+	const wml_key* key = parent->find_key(name, match, false, &conditions_used);
+
+	if(!conditions_used) {
+		key_lookup_cache_.emplace(std::pair(parent, name), key);
+	}
+
+	return key;
+}
+
 wml_type::ptr schema_validator::find_type(const std::string& type) const
 {
 	auto it = types_.find(type);
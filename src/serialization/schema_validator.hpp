@@ -145,6 +145,19 @@ private:
 
 	bool validate_schema_;
 
+	/**
+	 * Tag and key lookups whose result did not depend on any conditional
+	 * definition are pure functions of (parent tag, name) and are memoized
+	 * here. The wml_tag tree is stable once the schema is read, so the
+	 * pointers stay valid for the lifetime of the validator.
+	 */
+	std::map<std::pair<const wml_tag*, std::string>, const wml_tag*> tag_lookup_cache_;
+	std::map<std::pair<const wml_tag*, std::string>, const wml_key*> key_lookup_cache_;
+
+	/** Like active_tag().find_tag()/find_key(), but memoized where safe. */
+	const wml_tag* find_tag_cached(const std::string& name, const config& match);
+	const wml_key* find_key_cached(const std::string& name, const config& match);
+
 protected:
 	template<typename... T>
 	void queue_message(const config& cfg, T&&... args)
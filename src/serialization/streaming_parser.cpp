@@ -0,0 +1,305 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "serialization/streaming_parser.hpp"
+
+#include "gettext.hpp"
+#include "serialization/tokenizer.hpp"
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Token-stream walker mirroring the grammar handling of the tree-building
+ * parser in parser.cpp, but emitting events instead of config nodes. The
+ * only retained state is the stack of open tag names.
+ */
+class streaming_parser
+{
+public:
+	streaming_parser(std::istream& in, wml_stream_handler& handler)
+		: tok_(in)
+		, handler_(handler)
+		, open_tags_()
+	{
+	}
+
+	void operator()();
+
+private:
+	void parse_element();
+	void parse_variable();
+
+	[[noreturn]] void error(const std::string& message)
+	{
+		std::ostringstream ss;
+		ss << message << ", " << tok_.get_file() << ":" << tok_.get_start_line();
+		throw config::error(ss.str());
+	}
+
+	tokenizer tok_;
+	wml_stream_handler& handler_;
+	std::vector<std::string> open_tags_;
+};
+
+void streaming_parser::operator()()
+{
+	do {
+		tok_.next_token();
+
+		switch(tok_.current_token().type) {
+		case token::LF:
+			continue;
+
+		case '[':
+			parse_element();
+			break;
+
+		case token::STRING:
+			parse_variable();
+			break;
+
+		default:
+			if(static_cast<unsigned char>(tok_.current_token().value[0]) == 0xEF &&
+			   static_cast<unsigned char>(tok_.next_token().value[0])    == 0xBB &&
+			   static_cast<unsigned char>(tok_.next_token().value[0])    == 0xBF
+			) {
+				// Skip over a utf8 BOM, as the tree parser does.
+			} else {
+				error(_("Unexpected characters at line start"));
+			}
+
+			break;
+
+		case token::END:
+			break;
+		}
+	} while(tok_.current_token().type != token::END && !handler_.stopped());
+
+	if(!open_tags_.empty() && !handler_.stopped()) {
+		error("Missing closing tag for tag [" + open_tags_.back() + "]");
+	}
+}
+
+void streaming_parser::parse_element()
+{
+	tok_.next_token();
+
+	std::string elname;
+
+	switch(tok_.current_token().type) {
+	case token::STRING: // [element]
+		elname = tok_.current_token().value;
+
+		if(tok_.next_token().type != ']') {
+			error(_("Unterminated [element] tag"));
+		}
+
+		open_tags_.push_back(elname);
+		handler_.open_tag(elname, false);
+		break;
+
+	case '+': // [+element]
+		if(tok_.next_token().type != token::STRING) {
+			error(_("Invalid tag name"));
+		}
+
+		elname = tok_.current_token().value;
+
+		if(tok_.next_token().type != ']') {
+			error(_("Unterminated [+element] tag"));
+		}
+
+		open_tags_.push_back(elname);
+		handler_.open_tag(elname, true);
+		break;
+
+	case '/': // [/element]
+		if(tok_.next_token().type != token::STRING) {
+			error(_("Invalid closing tag name"));
+		}
+
+		elname = tok_.current_token().value;
+
+		if(tok_.next_token().type != ']') {
+			error(_("Unterminated closing tag"));
+		}
+
+		if(open_tags_.empty()) {
+			error(_("Unexpected closing tag"));
+		}
+
+		if(elname != open_tags_.back()) {
+			error("Found invalid closing tag [/" + elname + "] for tag [" + open_tags_.back() + "]");
+		}
+
+		open_tags_.pop_back();
+		handler_.close_tag(elname);
+		break;
+
+	default:
+		error(_("Invalid tag name"));
+	}
+}
+
+void streaming_parser::parse_variable()
+{
+	std::vector<std::string> variables;
+	variables.emplace_back();
+
+	while(tok_.current_token().type != '=') {
+		switch(tok_.current_token().type) {
+		case token::STRING:
+			if(!variables.back().empty()) {
+				variables.back() += ' ';
+			}
+
+			variables.back() += tok_.current_token().value;
+			break;
+
+		case ',':
+			if(variables.back().empty()) {
+				error(_("Empty variable name"));
+			} else {
+				variables.emplace_back();
+			}
+
+			break;
+
+		default:
+			error(_("Unexpected characters after variable name (expected , or =)"));
+			break;
+		}
+
+		tok_.next_token();
+	}
+
+	if(variables.back().empty()) {
+		error(_("Empty variable name"));
+	}
+
+	auto emit = [this](const std::string& name, const t_string_base& buffer) {
+		config::attribute_value value;
+		if(buffer.translatable()) {
+			value = t_string(buffer);
+		} else {
+			value = buffer.value();
+		}
+
+		handler_.attribute(name, value);
+	};
+
+	t_string_base buffer;
+
+	std::vector<std::string>::const_iterator curvar = variables.begin();
+
+	bool ignore_next_newlines = false, previous_string = false;
+
+	while(true) {
+		tok_.next_token();
+
+		switch(tok_.current_token().type) {
+		case ',':
+			if((curvar + 1) != variables.end()) {
+				emit(*curvar, buffer);
+				buffer = t_string_base();
+				++curvar;
+			} else {
+				buffer += ",";
+			}
+
+			break;
+
+		case '_':
+			tok_.next_token();
+
+			switch(tok_.current_token().type) {
+			case token::UNTERMINATED_QSTRING:
+				error(_("Unterminated quoted string"));
+				break;
+
+			case token::QSTRING:
+				buffer += t_string_base(tok_.current_token().value, tok_.textdomain());
+				break;
+
+			default:
+				buffer += "_";
+				buffer += tok_.current_token().value;
+				break;
+
+			case token::END:
+			case token::LF:
+				buffer += "_";
+				goto finish;
+			}
+
+			break;
+
+		case '+':
+			ignore_next_newlines = true;
+			continue;
+
+		case token::STRING:
+			if(previous_string) {
+				buffer += " ";
+			}
+
+			[[fallthrough]];
+
+		default:
+			buffer += tok_.current_token().value;
+			break;
+
+		case token::QSTRING:
+			buffer += tok_.current_token().value;
+			break;
+
+		case token::UNTERMINATED_QSTRING:
+			error(_("Unterminated quoted string"));
+			break;
+
+		case token::LF:
+			if(ignore_next_newlines) {
+				continue;
+			}
+
+			[[fallthrough]];
+
+		case token::END:
+			goto finish;
+		}
+
+		previous_string = tok_.current_token().type == token::STRING;
+		ignore_next_newlines = false;
+	}
+
+finish:
+	emit(*curvar, buffer);
+
+	while(++curvar != variables.end()) {
+		config::attribute_value empty_value;
+		empty_value = "";
+		handler_.attribute(*curvar, empty_value);
+	}
+}
+
+} // end anon namespace
+
+void read_events(std::istream& in, wml_stream_handler& handler)
+{
+	streaming_parser(in, handler)();
+}
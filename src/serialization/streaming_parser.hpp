@@ -0,0 +1,65 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+/**
+ * @file
+ * SAX-style streaming WML reader.
+ *
+ * Unlike read() in parser.hpp, which materializes the whole document as a
+ * config tree, read_events() walks the token stream once and reports open
+ * tag / attribute / close tag events to a handler, keeping only O(depth)
+ * state. This lets tools and the server skim multi-hundred-MB saves and
+ * replays for a few fields without paying for a full tree build.
+ */
+
+#pragma once
+
+#include "config.hpp"
+
+#include <iosfwd>
+#include <string>
+
+/**
+ * Receives the events of one streamed WML document.
+ *
+ * Handlers may call stop() from any callback to end the read early, e.g.
+ * once the fields of interest have been seen.
+ */
+class wml_stream_handler
+{
+public:
+	virtual ~wml_stream_handler() = default;
+
+	/** A [name] (or, with @a is_append set, [+name]) tag was opened. */
+	virtual void open_tag(const std::string& name, bool is_append) = 0;
+
+	/** The innermost open tag was closed. */
+	virtual void close_tag(const std::string& name) = 0;
+
+	/** An attribute of the innermost open tag was read. */
+	virtual void attribute(const std::string& name, const config::attribute_value& value) = 0;
+
+	/** Makes read_events() return before consuming further input. */
+	void stop() { stopped_ = true; }
+	bool stopped() const { return stopped_; }
+
+private:
+	bool stopped_ = false;
+};
+
+/**
+ * Streams WML from @a in, reporting each element to @a handler.
+ * Throws config::error on malformed input, like read().
+ */
+void read_events(std::istream& in, wml_stream_handler& handler);
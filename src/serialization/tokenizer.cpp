@@ -17,6 +17,118 @@
 #include "serialization/tokenizer.hpp"
 #include "wesconfig.h"
 
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TOKENIZER_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+// The scan kernels classify 16 bytes per step where SSE2 is available and
+// hand the block containing the run's end back to the scalar tail, so no
+// bit-position extraction is needed. Bytes >= 128 compare as negative in
+// the signed byte comparisons, which correctly excludes them from all of
+// the classes below.
+
+/** Length of the prefix of identifier characters ([0-9A-Za-z_$]). */
+std::size_t scan_name_chars(const char* data, std::size_t n)
+{
+	std::size_t i = 0;
+
+#ifdef TOKENIZER_USE_SSE2
+	while (i + 16 <= n) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		const __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+		const __m128i letter = _mm_and_si128(
+			_mm_cmpgt_epi8(folded, _mm_set1_epi8('a' - 1)),
+			_mm_cmplt_epi8(folded, _mm_set1_epi8('z' + 1)));
+		const __m128i digit = _mm_and_si128(
+			_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+			_mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+		const __m128i other = _mm_or_si128(
+			_mm_cmpeq_epi8(v, _mm_set1_epi8('_')),
+			_mm_cmpeq_epi8(v, _mm_set1_epi8('$')));
+
+		if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letter, digit), other)) != 0xFFFF)
+			break;
+		i += 16;
+	}
+#endif
+
+	while (i < n) {
+		const char c = data[i];
+		if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+		      (c >= '0' && c <= '9') || c == '_' || c == '$'))
+			break;
+		++i;
+	}
+
+	return i;
+}
+
+/** Length of the prefix of blanks (spaces and tabs). */
+std::size_t scan_spaces(const char* data, std::size_t n)
+{
+	std::size_t i = 0;
+
+#ifdef TOKENIZER_USE_SSE2
+	while (i + 16 <= n) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		const __m128i blank = _mm_or_si128(
+			_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+			_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+
+		if (_mm_movemask_epi8(blank) != 0xFFFF)
+			break;
+		i += 16;
+	}
+#endif
+
+	while (i < n && (data[i] == ' ' || data[i] == '\t'))
+		++i;
+
+	return i;
+}
+
+/**
+ * Length of the prefix containing neither @a delim, carriage returns, nor
+ * (with @a stop_at_marker) the 254 inline marker byte.
+ */
+std::size_t scan_until(const char* data, std::size_t n, char delim, bool stop_at_marker)
+{
+	std::size_t i = 0;
+	const char marker = static_cast<char>(254);
+
+#ifdef TOKENIZER_USE_SSE2
+	while (i + 16 <= n) {
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		__m128i stop = _mm_or_si128(
+			_mm_cmpeq_epi8(v, _mm_set1_epi8(delim)),
+			_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+		if (stop_at_marker)
+			stop = _mm_or_si128(stop, _mm_cmpeq_epi8(v, _mm_set1_epi8(marker)));
+
+		if (_mm_movemask_epi8(stop) != 0)
+			break;
+		i += 16;
+	}
+#endif
+
+	while (i < n) {
+		const char c = data[i];
+		if (c == delim || c == '\r' || (stop_at_marker && c == marker))
+			break;
+		++i;
+	}
+
+	return i;
+}
+
+} // namespace
+
 tokenizer::tokenizer(std::istream& in) :
 	current_(EOF),
 	lineno_(1),
@@ -59,6 +171,7 @@ const token &tokenizer::next_token()
 	while(true)
 	{
 		while (is_space(current_)) {
+			skip_space_run();
 			next_char_fast();
 		}
 		if (current_ != 254)
@@ -97,6 +210,7 @@ const token &tokenizer::next_token()
 				break;
 			}
 			token_.value += current_;
+			append_text_run('>', false);
 		}
 		break;
 
@@ -118,6 +232,7 @@ const token &tokenizer::next_token()
 				continue;
 			}
 			token_.value += current_;
+			append_text_run('"', true);
 		}
 		break;
 
@@ -139,6 +254,7 @@ const token &tokenizer::next_token()
 			token_.type = token::STRING;
 			do {
 				token_.value += current_;
+				append_name_run();
 				next_char_fast();
 				while (current_ == 254) {
 					skip_comment();
@@ -171,6 +287,42 @@ bool tokenizer::skip_command(char const *cmd)
 	return true;
 }
 
+void tokenizer::skip_space_run()
+{
+	for (;;) {
+		const unsigned n = in_.avail();
+		if (n == 0) return;
+		const std::size_t len = scan_spaces(in_.data(), n);
+		in_.skip(static_cast<unsigned>(len));
+		if (len < n) return;
+	}
+}
+
+void tokenizer::append_name_run()
+{
+	for (;;) {
+		const unsigned n = in_.avail();
+		if (n == 0) return;
+		const std::size_t len = scan_name_chars(in_.data(), n);
+		token_.value.append(in_.data(), len);
+		in_.skip(static_cast<unsigned>(len));
+		if (len < n) return;
+	}
+}
+
+void tokenizer::append_text_run(char delim, bool stop_at_marker)
+{
+	for (;;) {
+		const unsigned n = in_.avail();
+		if (n == 0) return;
+		const std::size_t len = scan_until(in_.data(), n, delim, stop_at_marker);
+		lineno_ += static_cast<int>(std::count(in_.data(), in_.data() + len, '\n'));
+		token_.value.append(in_.data(), len);
+		in_.skip(static_cast<unsigned>(len));
+		if (len < n) return;
+	}
+}
+
 void tokenizer::skip_comment()
 {
 	next_char_fast();
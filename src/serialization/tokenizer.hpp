@@ -166,6 +166,16 @@ private:
 	 */
 	bool skip_command(char const *cmd);
 
+	/**
+	 * Block-oriented variants of the hot scan loops. Each consumes the
+	 * longest possible run straight from the input buffer (SIMD-accelerated
+	 * where available, see tokenizer.cpp) and leaves the character that
+	 * ended the run for the regular byte-at-a-time handling.
+	 */
+	void skip_space_run();
+	void append_name_run();
+	void append_text_run(char delim, bool stop_at_marker);
+
 	std::string textdomain_;
 	std::string file_;
 	token token_;
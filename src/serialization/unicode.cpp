@@ -26,14 +26,57 @@
 
 #include "log.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UNICODE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
 static lg::log_domain log_engine("engine");
 #define ERR_GENERAL LOG_STREAM(err, lg::general())
 
 namespace utf8 {
 
+/**
+ * Returns the length of the run of single-byte (US-ASCII) characters at the
+ * start of [data, data + len), checking a chunk at a time. Most strings that
+ * pass through here are pure ASCII, so this is the fast path for size(),
+ * index() and the UTF-8 to UCS-4 conversion.
+ */
+static std::size_t ascii_span(const char* data, const std::size_t len)
+{
+	std::size_t i = 0;
+
+#ifdef UNICODE_USE_SSE2
+	for(; i + 16 <= len; i += 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		if(_mm_movemask_epi8(chunk) != 0) {
+			break;
+		}
+	}
+#else
+	std::uint64_t word;
+	for(; i + sizeof(word) <= len; i += sizeof(word)) {
+		std::memcpy(&word, data + i, sizeof(word));
+		if(word & UINT64_C(0x8080808080808080)) {
+			break;
+		}
+	}
+#endif
+
+	// Scan the partial chunk, and find the offending byte of a full one.
+	while(i < len && !(static_cast<unsigned char>(data[i]) & 0x80)) {
+		++i;
+	}
+
+	return i;
+}
+
 static int byte_size_from_utf8_first(const unsigned char ch)
 {
 	if (!(ch & 0x80)) {
@@ -73,10 +116,17 @@ std::size_t index(const std::string& str, const std::size_t index)
 {
 	// chr counts characters, i is the codepoint index
 	// remark: several functions rely on the fallback to str.length()
-	unsigned int i = 0, len = str.size();
+	std::size_t chr = 0, i = 0, len = str.size();
 	try {
-		for (unsigned int chr=0; chr<index && i<len; ++chr) {
-			i += byte_size_from_utf8_first(str[i]);
+		while (chr < index && i < len) {
+			if (!(static_cast<unsigned char>(str[i]) & 0x80)) {
+				const std::size_t run = std::min(ascii_span(str.data() + i, len - i), index - chr);
+				i += run;
+				chr += run;
+			} else {
+				i += byte_size_from_utf8_first(str[i]);
+				++chr;
+			}
 		}
 	} catch(const invalid_utf8_exception&) {
 		ERR_GENERAL << "Invalid UTF-8 string." << std::endl;
@@ -86,10 +136,17 @@ std::size_t index(const std::string& str, const std::size_t index)
 
 std::size_t size(const std::string& str)
 {
-	unsigned int chr, i = 0, len = str.size();
+	std::size_t chr = 0, i = 0, len = str.size();
 	try {
-		for (chr=0; i<len; ++chr) {
-			i += byte_size_from_utf8_first(str[i]);
+		while (i < len) {
+			if (!(static_cast<unsigned char>(str[i]) & 0x80)) {
+				const std::size_t run = ascii_span(str.data() + i, len - i);
+				i += run;
+				chr += run;
+			} else {
+				i += byte_size_from_utf8_first(str[i]);
+				++chr;
+			}
 		}
 	} catch(const invalid_utf8_exception&) {
 		ERR_GENERAL << "Invalid UTF-8 string." << std::endl;
@@ -130,3 +187,39 @@ void truncate_as_ucs4(std::string &str, const std::size_t size)
 }
 
 } // end namespace utf8
+
+template<>
+std::u32string unicode_cast<std::u32string, std::string>(const std::string& source)
+{
+	std::u32string res;
+	res.reserve(source.size());
+
+	const char* data = source.data();
+	std::size_t i = 0;
+	const std::size_t len = source.size();
+
+	try {
+		while(i < len) {
+			// Copy a whole run of ASCII at once.
+			const std::size_t run = utf8::ascii_span(data + i, len - i);
+			for(std::size_t j = i; j < i + run; ++j) {
+				res.push_back(static_cast<unsigned char>(data[j]));
+			}
+			i += run;
+
+			if(i >= len) {
+				break;
+			}
+
+			// A multi-byte sequence; decode it the usual way.
+			std::string::const_iterator input = source.begin() + i;
+			res.push_back(ucs4_convert_impl::utf8_impl::read(input, source.end()));
+			i = input - source.begin();
+		}
+	} catch(const utf8::invalid_utf8_exception&) {
+		ERR_GENERAL << "Failed to convert a string from utf8 to ucs4" << std::endl;
+		return res;
+	}
+
+	return res;
+}
@@ -18,6 +18,7 @@
 #include "ucs4_convert_impl.hpp"
 #include <iostream>   //for std::cerr
 #include <iterator>
+#include <string>
 
 namespace ucs4_convert_impl
 {
@@ -85,6 +86,13 @@ typename ucs4_convert_impl::enableif<TD, typename TS::value_type>::type unicode_
 	return res;
 }
 
+/**
+ * Bulk specialization for the common UTF-8 to UCS-4 direction: runs of
+ * ASCII are copied a chunk at a time. See serialization/unicode.cpp.
+ */
+template<>
+std::u32string unicode_cast<std::u32string, std::string>(const std::string& source);
+
 /**
  * @tparam TD Output, a collection type.
  *
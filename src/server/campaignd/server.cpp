@@ -85,6 +85,8 @@ const std::set<std::string> cap_defaults = {
 	"auth:legacy",
 	// Delta WML packs
 	"delta",
+	// Add-ons list deltas against a client-cached copy
+	"list:sync",
 };
 
 /**
@@ -457,6 +459,7 @@ void server::load_config()
 	}
 
 	LOG_CS << "Loaded addons metadata. " << addons_.size() << " addons found.\n";
+	addons_list_cache_.clear();
 
 #ifdef HAVE_MYSQLPP
 	if(const config& user_handler = cfg_.child("user_handler")) {
@@ -898,6 +901,7 @@ void server::delete_addon(const std::string& id)
 	}
 
 	addons_.erase(id);
+	addons_list_cache_.clear();
 	write_config();
 
 	fire("hook_post_erase", id);
@@ -970,18 +974,46 @@ void server::handle_request_campaign_list(const server::request& req)
 	const std::string& name = req.cfg["name"];
 	const std::string& lang = req.cfg["language"];
 
+	// In sync mode the response is a delta against a list the client already
+	// has, so it additionally carries the ids of every visible add-on. The
+	// client uses those to prune entries deleted or hidden since its copy.
+	const bool sync_mode = req.cfg["sync"].to_bool();
+	std::vector<std::string> sync_ids;
+
+	// Plain list requests are by far the hottest thing this server does and
+	// their response is identical for every client asking for the same
+	// variant, so serve them from a cache of precompressed payloads. The
+	// cache is dropped whenever add-on metadata changes, which also means a
+	// cached timestamp attribute is still a correct "unchanged since" stamp
+	// for list:sync clients. Time-filtered and single-name requests depend
+	// on the individual request and are always built from scratch.
+	const bool cacheable = !before_flag && !after_flag && name.empty();
+	const std::string cache_key = lang + (sync_mode ? "\nsync" : "");
+
+	if(cacheable) {
+		const auto cached = addons_list_cache_.find(cache_key);
+		if(cached != addons_list_cache_.end()) {
+			utils::visit([this, &cached](auto&& sock) { async_send_buffer_queued(sock, cached->second); }, req.sock);
+			return;
+		}
+	}
+
 	for(const auto& addon : addons_)
 	{
-		if(!name.empty() && name != addon.first) {
+		if(addon.second["hidden"].to_bool()) {
 			continue;
 		}
 
-		config i = addon.second;
+		if(sync_mode) {
+			sync_ids.push_back(addon.first);
+		}
 
-		if(i["hidden"].to_bool()) {
+		if(!name.empty() && name != addon.first) {
 			continue;
 		}
 
+		config i = addon.second;
+
 		const auto& tm = i["timestamp"];
 
 		if(before_flag && (tm.empty() || tm.to_time_t(0) >= before)) {
@@ -1030,6 +1062,11 @@ void server::handle_request_campaign_list(const server::request& req)
 		j.clear_children("update_pack");
 	}
 
+	if(sync_mode) {
+		addons_list["sync"] = true;
+		addons_list["ids"] = utils::join(sync_ids);
+	}
+
 	config response;
 	response.add_child("campaigns", std::move(addons_list));
 
@@ -1037,9 +1074,16 @@ void server::handle_request_campaign_list(const server::request& req)
 	write(ostr, response);
 	std::string wml = ostr.str();
 	simple_wml::document doc(wml.c_str(), simple_wml::INIT_STATIC);
-	doc.compress();
 
-	utils::visit([this, &doc](auto&& sock) { async_send_doc_queued(sock, doc); }, req.sock);
+	shared_send_buffer buf = compress_doc(doc);
+
+	// The language attribute is client-supplied, so cap the number of cached
+	// variants instead of letting junk requests grow the cache without bound.
+	if(cacheable && addons_list_cache_.size() < 32) {
+		addons_list_cache_.emplace(cache_key, buf);
+	}
+
+	utils::visit([this, &buf](auto&& sock) { async_send_buffer_queued(sock, std::move(buf)); }, req.sock);
 }
 
 void server::handle_request_campaign(const server::request& req)
@@ -1707,6 +1751,12 @@ void server::handle_upload(const server::request& req)
 	// Create any missing update packs between consecutive versions. This covers
 	// cases where clients were not able to upload those update packs themselves.
 
+	// The most recently parsed full pack in the loop below. A chain of missing
+	// update packs visits each version as 'to' and then as 'from', so keeping
+	// the last parse around halves the amount of decompression and parsing.
+	config cached_pack;
+	std::string cached_pack_path;
+
 	for(auto iter = version_map.begin(); std::distance(iter, version_map.end()) > 1;) {
 		const config& prev_version = iter->second;
 		const config& next_version = (++iter)->second;
@@ -1748,16 +1798,33 @@ void server::handle_upload(const server::request& req)
 		pack_info["expire"] = upload_ts + update_pack_lifespan_;
 		pack_info["filename"] = update_pack_fn;
 
-		// Generate the update pack from both full packs
+		// Generate the update pack from both full packs. The pack belonging to
+		// the version just uploaded is still in memory as rw_full_pack, and
+		// the previous iteration may have parsed prev_path already; only hit
+		// the disk for whatever is left.
 
 		config pack, from, to;
 
-		filesystem::scoped_istream in = filesystem::istream_file(prev_path);
-		read_gz(from, *in);
-		in = filesystem::istream_file(next_path);
-		read_gz(to, *in);
+		if(cached_pack_path == prev_path) {
+			from = std::move(cached_pack);
+			cached_pack_path.clear();
+		} else if(prev_path == full_pack_path) {
+			from = std::move(rw_full_pack);
+		} else {
+			filesystem::scoped_istream in = filesystem::istream_file(prev_path);
+			read_gz(from, *in);
+		}
 
-		make_updatepack(pack, from, to);
+		if(next_path == full_pack_path) {
+			make_updatepack(pack, from, rw_full_pack);
+		} else {
+			filesystem::scoped_istream in = filesystem::istream_file(next_path);
+			read_gz(to, *in);
+			make_updatepack(pack, from, to);
+
+			cached_pack = std::move(to);
+			cached_pack_path = next_path;
+		}
 
 		{
 			filesystem::atomic_commit pack_file{pathstem + '/' + update_pack_fn};
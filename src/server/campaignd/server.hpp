@@ -109,6 +109,14 @@ private:
 	/**The set of unique addon names with pending metadata updates*/
 	std::unordered_set<std::string> dirty_addons_;
 
+	/**
+	 * Precompressed responses for handle_request_campaign_list(), keyed by
+	 * the request's filter variant. Invalidated whenever add-on metadata
+	 * changes, so identical list requests in between are served with a
+	 * plain buffer send instead of rebuilding and recompressing the list.
+	 */
+	std::map<std::string, shared_send_buffer> addons_list_cache_;
+
 	/**Server config*/
 	config cfg_;
 	const std::string cfg_file_;
@@ -185,6 +193,9 @@ private:
 	void mark_dirty(const std::string& addon)
 	{
 		dirty_addons_.emplace(addon);
+		// Any metadata change (uploads, deletions, download count bumps)
+		// shows up in the add-ons list, so cached list responses are stale.
+		addons_list_cache_.clear();
 	}
 
 	/**
@@ -23,6 +23,8 @@
 
 #include <boost/asio/post.hpp>
 
+#include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <sstream>
 
@@ -35,6 +37,11 @@ static lg::log_domain log_mp_user_handler("mp_user_handler");
 namespace {
 	const int USER_INACTIVE = 1;
 	const int USER_IGNORE = 2;
+
+	// How long a positive user_exists() result stays valid, and how many of
+	// them to keep around at most.
+	const std::time_t user_exists_cache_ttl = 60;
+	const std::size_t user_exists_cache_max_size = 1000;
 }
 
 fuh::fuh(const config& c)
@@ -103,7 +110,34 @@ void fuh::user_logged_in(const std::string& name) {
 }
 
 bool fuh::user_exists(const std::string& name) {
-	return conn_.user_exists(name);
+	// The database compares usernames case-insensitively, so so does the cache.
+	std::string key = name;
+	std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	const std::time_t now = std::time(nullptr);
+
+	auto cached = user_exists_cache_.find(key);
+	if(cached != user_exists_cache_.end()) {
+		if(now - cached->second < user_exists_cache_ttl) {
+			return true;
+		}
+
+		user_exists_cache_.erase(cached);
+	}
+
+	// Only positive results are remembered: an account appearing right after a
+	// negative check must be picked up immediately, while a just-deleted one
+	// still fails the later password check.
+	if(!conn_.user_exists(name)) {
+		return false;
+	}
+
+	if(user_exists_cache_.size() >= user_exists_cache_max_size) {
+		user_exists_cache_.clear();
+	}
+
+	user_exists_cache_[std::move(key)] = now;
+	return true;
 }
 
 long fuh::get_forum_id(const std::string& name) {
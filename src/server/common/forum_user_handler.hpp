@@ -19,6 +19,7 @@
 #include "server/common/dbconn.hpp"
 
 #include <vector>
+#include <map>
 #include <memory>
 #include <ctime>
 
@@ -267,6 +268,13 @@ private:
 	/** The group ID of the forums MP Moderators group */
 	int mp_mod_group_;
 
+	/**
+	 * Positive @ref user_exists results, remembered for a short while so the
+	 * handful of existence checks done per login hit the database only once.
+	 * Maps the lowercased username to the time the database was last asked.
+	 */
+	std::map<std::string, std::time_t> user_exists_cache_;
+
 	/**
 	 * @param user The player's username.
 	 * @return The player's hashed password from the phpbb forum database.
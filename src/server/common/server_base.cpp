@@ -42,6 +42,8 @@
 #endif
 #include <boost/asio/write.hpp>
 
+#include <openssl/ssl.h>
+
 #include <array>
 #include <ctime>
 #include <functional>
@@ -65,7 +67,7 @@ bool dump_wml = false;
 server_base::server_base(unsigned short port, bool keep_alive)
 	: port_(port)
 	, keep_alive_(keep_alive)
-	, io_service_()
+	, io_service_(1)
 	, acceptor_v6_(io_service_)
 	, acceptor_v4_(io_service_)
 	, handshake_response_()
@@ -512,12 +514,18 @@ template<class SocketPtr> std::unique_ptr<simple_wml::document> server_base::cor
 		return {};
 	}
 
-	boost::shared_array<char> buffer{ new char[size] };
+	std::unique_ptr<char[]> buffer{ new char[size] };
 	async_read(*socket, boost::asio::buffer(buffer.get(), size), yield);
 
 	try {
 		simple_wml::string_span compressed_buf(buffer.get(), size);
-		return std::make_unique<simple_wml::document>(compressed_buf);
+		auto doc = std::make_unique<simple_wml::document>(compressed_buf);
+		// The document keeps referring to the compressed payload: hand it the
+		// buffer, so a document that is relayed onward unmodified (the common
+		// case for [turn] traffic) goes out as the original compressed bytes
+		// instead of being recompressed per document.
+		doc->take_ownership_of_buffer(buffer.release());
+		return doc;
 	}  catch (simple_wml::error& e) {
 		ERR_SERVER <<
 			log_address(socket) <<
@@ -529,25 +537,97 @@ template<class SocketPtr> std::unique_ptr<simple_wml::document> server_base::cor
 template std::unique_ptr<simple_wml::document> server_base::coro_receive_doc<socket_ptr>(socket_ptr socket, boost::asio::yield_context yield);
 template std::unique_ptr<simple_wml::document> server_base::coro_receive_doc<tls_socket_ptr>(tls_socket_ptr socket, boost::asio::yield_context yield);
 
+server_base::shared_send_buffer server_base::compress_doc(simple_wml::document& doc)
+{
+	if(dump_wml) {
+		std::cout << "Sending WML: \n" << doc.output() << std::endl;
+	}
+
+	simple_wml::string_span s = doc.output_compressed();
+	return std::make_shared<const std::string>(s.begin(), s.end());
+}
+
 template<class SocketPtr> void server_base::async_send_doc_queued(SocketPtr socket, simple_wml::document& doc)
+{
+	try {
+		async_send_buffer_queued(socket, compress_doc(doc));
+	} catch (simple_wml::error& e) {
+		WRN_CONFIG << __func__ << ": simple_wml error: " << e.message << std::endl;
+		throw;
+	}
+}
+
+namespace {
+
+// How much undelivered data may pile up per connection before the server
+// stops buffering for it and drops the client instead.
+const std::size_t send_queue_byte_limit = 16 * 1024 * 1024;
+
+}
+
+template<class SocketPtr> void server_base::async_send_buffer_queued(SocketPtr socket, shared_send_buffer buffer)
 {
 	boost::asio::spawn(
-		io_service_, [this, doc_ptr = doc.clone(), socket](boost::asio::yield_context yield) mutable {
-			static std::map<SocketPtr, std::queue<std::unique_ptr<simple_wml::document>>> queues;
+		io_service_, [this, buffer = std::move(buffer), socket](boost::asio::yield_context yield) mutable {
+			static std::map<SocketPtr, std::queue<shared_send_buffer>> queues;
+			static std::map<SocketPtr, std::size_t> queued_bytes;
+
+			// Backpressure for clients that can't keep up with what we send:
+			// past the limit the connection is closed rather than buffering
+			// without bound. Dropping individual documents instead would
+			// desync the protocol. At least one document is always accepted,
+			// whatever its size.
+			if(!queues[socket].empty() && queued_bytes[socket] + buffer->size() > send_queue_byte_limit) {
+				WRN_SERVER << log_address(socket) << "\tsend queue exceeded "
+						   << send_queue_byte_limit << " bytes, closing the connection\n";
+
+				boost::system::error_code ec;
+				socket->lowest_layer().close(ec);
+				return;
+			}
 
-			queues[socket].push(std::move(doc_ptr));
+			queued_bytes[socket] += buffer->size();
+			queues[socket].push(std::move(buffer));
 			if(queues[socket].size() > 1) {
 				return;
 			}
 
 			while(queues[socket].size() > 0) {
-				coro_send_doc(socket, *(queues[socket].front()), yield);
+				// Keep a reference of our own; the queue can grow (relocating
+				// nothing, but still) while this coroutine is suspended.
+				const shared_send_buffer payload = queues[socket].front();
+
+				union DataSize
+				{
+					uint32_t size;
+					char buf[4];
+				} data_size {};
+				data_size.size = htonl(payload->size());
+
+				std::vector<boost::asio::const_buffer> buffers {
+					{ data_size.buf, 4 },
+					{ payload->data(), payload->size() }
+				};
+
+				boost::system::error_code ec;
+				async_write(*socket, buffers, yield[ec]);
+
+				queued_bytes[socket] -= payload->size();
 				queues[socket].pop();
+
+				if(ec) {
+					// The connection is gone (possibly closed above); the
+					// rest of the queue is undeliverable.
+					break;
+				}
 			}
 			queues.erase(socket);
+			queued_bytes.erase(socket);
 		}
 	);
 }
+template void server_base::async_send_buffer_queued<socket_ptr>(socket_ptr socket, shared_send_buffer buffer);
+template void server_base::async_send_buffer_queued<tls_socket_ptr>(tls_socket_ptr socket, shared_send_buffer buffer);
 
 template<class SocketPtr> void server_base::async_send_error(SocketPtr socket, const std::string& msg, const char* error_code, const info_table& info)
 {
@@ -589,6 +669,14 @@ void server_base::load_tls_config(const config& cfg)
 		| boost::asio::ssl::context::single_dh_use
 	);
 
+	// Reconnection stampedes put every client's full handshake cost on the
+	// one io thread. Cache server-side sessions so clients that were
+	// connected before resume with the abbreviated handshake, and release
+	// per-connection TLS buffers while idle so thousands of concurrently
+	// handshaking sockets don't pin tens of kilobytes each.
+	SSL_CTX_set_session_cache_mode(tls_context_.native_handle(), SSL_SESS_CACHE_SERVER);
+	SSL_CTX_set_mode(tls_context_.native_handle(), SSL_MODE_RELEASE_BUFFERS);
+
 	tls_context_.use_certificate_chain_file(cfg["tls_fullchain"].str());
 	tls_context_.use_private_key_file(cfg["tls_private_key"].str(), boost::asio::ssl::context::pem);
 	if(!cfg["tls_dh"].str().empty()) tls_context_.use_tmp_dh_file(cfg["tls_dh"].str());
@@ -39,7 +39,6 @@
 #include <boost/asio/streambuf.hpp>
 #include <boost/asio/ssl.hpp>
 #include <boost/asio/spawn.hpp>
-#include <boost/shared_array.hpp>
 
 #include <map>
 
@@ -115,6 +114,22 @@ public:
 	 */
 	template<class SocketPtr> void async_send_doc_queued(SocketPtr socket, simple_wml::document& doc);
 
+	/** A compressed WML payload, shareable between the send queues of several recipients. */
+	using shared_send_buffer = std::shared_ptr<const std::string>;
+
+	/**
+	 * Compress a WML document into a payload for @ref async_send_buffer_queued.
+	 *
+	 * Broadcast paths should call this once and hand the same buffer to every
+	 * recipient, instead of letting each recipient recompress the document.
+	 */
+	static shared_send_buffer compress_doc(simple_wml::document& doc);
+
+	/**
+	 * Variant of @ref async_send_doc_queued taking an already compressed payload.
+	 */
+	template<class SocketPtr> void async_send_buffer_queued(SocketPtr socket, shared_send_buffer buffer);
+
 	typedef std::map<std::string, std::string> info_table;
 	template<class SocketPtr> void async_send_error(SocketPtr socket, const std::string& msg, const char* error_code = "", const info_table& info = {});
 	template<class SocketPtr> void async_send_warning(SocketPtr socket, const std::string& msg, const char* warning_code = "", const info_table& info = {});
@@ -147,6 +162,12 @@ public:
 protected:
 	unsigned short port_;
 	bool keep_alive_;
+	/**
+	 * All server logic runs on the one thread that calls run(). The servers'
+	 * state (player/game containers, queued documents) relies on that, so the
+	 * io_service is told about it with a concurrency hint of one, which lets
+	 * it skip its internal synchronization.
+	 */
 	boost::asio::io_service io_service_;
 	boost::asio::ssl::context tls_context_ { boost::asio::ssl::context::sslv23 };
 	bool tls_enabled_ { false };
@@ -14,6 +14,7 @@
 */
 
 #include <iostream>
+#include <new>
 #include <sstream>
 
 #include <boost/iostreams/copy.hpp>
@@ -25,6 +26,9 @@
 #ifdef HAVE_ZLIB
 #include <boost/iostreams/filter/gzip.hpp>
 #endif
+#ifdef HAVE_ZSTD
+#include <boost/iostreams/filter/zstd.hpp>
+#endif
 
 #include "server/common/simple_wml.hpp"
 
@@ -39,8 +43,23 @@ std::size_t document::document_size_limit = 40000000;
 
 namespace {
 
-void debug_delete(node* n) {
-	delete n;
+//number of node-sized slots in each chunk allocated by document::allocate_node().
+const std::size_t node_pool_chunk_size = 256;
+
+//first byte of the on-disk magic of each supported format; used both to sniff
+//incoming buffers and to sanity-check freshly compressed ones.
+char compression_magic(compression::format format)
+{
+	switch(format) {
+	case compression::GZIP:
+		return 31;
+	case compression::BZIP2:
+		return 'B';
+	case compression::ZSTD:
+		return '\x28';
+	default:
+		throw error("unsupported compression format");
+	}
 }
 
 char* uncompress_buffer(const string_span& input, string_span* span)
@@ -52,11 +71,17 @@ char* uncompress_buffer(const string_span& input, string_span* span)
 		state = 1;
 		boost::iostreams::filtering_stream<boost::iostreams::input> filter;
 		state = 2;
-		if (!span->empty() && *span->begin() == 'B') {
+		if (!input.empty() && *input.begin() == compression_magic(compression::BZIP2)) {
 #ifdef HAVE_BZIP2
 			filter.push(boost::iostreams::bzip2_decompressor());
 #else
 			throw error("bzip2 not supported");
+#endif
+		} else if (!input.empty() && *input.begin() == compression_magic(compression::ZSTD)) {
+#ifdef HAVE_ZSTD
+			filter.push(boost::iostreams::zstd_decompressor());
+#else
+			throw error("zstd not supported");
 #endif
 		} else {
 #ifdef HAVE_ZLIB
@@ -112,7 +137,7 @@ char* uncompress_buffer(const string_span& input, string_span* span)
 	}
 }
 
-char* compress_buffer(const char* input, string_span* span, bool bzip2)
+char* compress_buffer(const char* input, string_span* span, compression::format format)
 {
 	int nalloc = strlen(input);
 	int state = 0;
@@ -123,11 +148,17 @@ char* compress_buffer(const char* input, string_span* span, bool bzip2)
 		state = 2;
 		boost::iostreams::filtering_stream<boost::iostreams::output> filter;
 		state = 3;
-		if (bzip2) {
+		if (format == compression::BZIP2) {
 #ifdef HAVE_BZIP2
 			filter.push(boost::iostreams::bzip2_compressor());
 #else
 			throw error("bzip2 not supported");
+#endif
+		} else if (format == compression::ZSTD) {
+#ifdef HAVE_ZSTD
+			filter.push(boost::iostreams::zstd_compressor());
+#else
+			throw error("zstd not supported");
 #endif
 		} else {
 #ifdef HAVE_ZLIB
@@ -162,7 +193,7 @@ char* compress_buffer(const char* input, string_span* span, bool bzip2)
 		state = 8;
 
 		*span = string_span(small_out, len);
-		assert(*small_out == (bzip2 ? 'B' : 31));
+		assert(*small_out == compression_magic(format));
 		state = 9;
 		return small_out;
 	} catch (const std::bad_alloc& e) {
@@ -278,7 +309,7 @@ node::node(document& doc, node* parent, const char** str, int depth) :
 
 			s = end + 1;
 
-			children_[list_index].second.push_back(new node(doc, this, str, depth+1));
+			children_[list_index].second.push_back(new(doc.allocate_node()) node(doc, this, str, depth+1));
 			ordered_children_.emplace_back(list_index, children_[list_index].second.size() - 1);
 			check_ordered_children();
 
@@ -385,7 +416,7 @@ node::~node()
 {
 	for(child_map::iterator i = children_.begin(); i != children_.end(); ++i) {
 		for(child_list::iterator j = i->second.begin(); j != i->second.end(); ++j) {
-			debug_delete(*j);
+			doc_->deallocate_node(*j);
 		}
 	}
 }
@@ -474,7 +505,7 @@ node& node::add_child_at(const char* name, std::size_t index)
 	}
 
 	check_ordered_children();
-	list.insert(list.begin() + index, new node(*doc_, this));
+	list.insert(list.begin() + index, new(doc_->allocate_node()) node(*doc_, this));
 	insert_ordered_child(list_index, index);
 
 	check_ordered_children();
@@ -489,7 +520,7 @@ node& node::add_child(const char* name)
 	const int list_index = get_children(name);
 	check_ordered_children();
 	child_list& list = children_[list_index].second;
-	list.push_back(new node(*doc_, this));
+	list.push_back(new(doc_->allocate_node()) node(*doc_, this));
 	ordered_children_.emplace_back(list_index, list.size() - 1);
 	check_ordered_children();
 	return *list.back();
@@ -512,7 +543,7 @@ void node::remove_child(const string_span& name, std::size_t index)
 
 	remove_ordered_child(std::distance(children_.begin(), itor), index);
 
-	debug_delete(list[index]);
+	doc_->deallocate_node(list[index]);
 	list.erase(list.begin() + index);
 
 	if(list.empty()) {
@@ -959,10 +990,14 @@ document::document() :
 	compressed_buf_(),
 	output_(nullptr),
 	buffers_(),
-	root_(new node(*this, nullptr)),
+	node_pools_(),
+	node_pool_used_(0),
+	node_free_list_(nullptr),
+	root_(nullptr),
 	prev_(nullptr),
 	next_(nullptr)
 {
+	root_ = new(allocate_node()) node(*this, nullptr);
 	attach_list();
 }
 
@@ -970,6 +1005,9 @@ document::document(char* buf, INIT_BUFFER_CONTROL control) :
 	compressed_buf_(),
 	output_(buf),
 	buffers_(),
+	node_pools_(),
+	node_pool_used_(0),
+	node_free_list_(nullptr),
 	root_(nullptr),
 	prev_(nullptr),
 	next_(nullptr)
@@ -978,7 +1016,7 @@ document::document(char* buf, INIT_BUFFER_CONTROL control) :
 		buffers_.push_back(buf);
 	}
 	const char* cbuf = buf;
-	root_ = new node(*this, nullptr, &cbuf);
+	root_ = new(allocate_node()) node(*this, nullptr, &cbuf);
 
 	attach_list();
 }
@@ -987,6 +1025,9 @@ document::document(const char* buf, INIT_STATE state) :
 	compressed_buf_(),
 	output_(buf),
 	buffers_(),
+	node_pools_(),
+	node_pool_used_(0),
+	node_free_list_(nullptr),
 	root_(nullptr),
 	prev_(nullptr),
 	next_(nullptr)
@@ -995,7 +1036,7 @@ document::document(const char* buf, INIT_STATE state) :
 		output_compressed();
 		output_ = nullptr;
 	} else {
-		root_ = new node(*this, nullptr, &buf);
+		root_ = new(allocate_node()) node(*this, nullptr, &buf);
 	}
 
 	attach_list();
@@ -1005,6 +1046,9 @@ document::document(string_span compressed_buf) :
 	compressed_buf_(compressed_buf),
 	output_(nullptr),
 	buffers_(),
+	node_pools_(),
+	node_pool_used_(0),
+	node_free_list_(nullptr),
 	root_(nullptr),
 	prev_(nullptr),
 	next_(nullptr)
@@ -1014,10 +1058,14 @@ document::document(string_span compressed_buf) :
 	output_ = uncompressed_buf.begin();
 	const char* cbuf = output_;
 	try {
-		root_ = new node(*this, nullptr, &cbuf);
+		root_ = new(allocate_node()) node(*this, nullptr, &cbuf);
 	} catch(...) {
 		delete [] buffers_.front();
 		buffers_.clear();
+		for(std::vector<char*>::iterator i = node_pools_.begin(); i != node_pools_.end(); ++i) {
+			delete [] *i;
+		}
+		node_pools_.clear();
 		throw;
 	}
 
@@ -1026,16 +1074,50 @@ document::document(string_span compressed_buf) :
 
 document::~document()
 {
+	if(root_) {
+		deallocate_node(root_);
+	}
+
 	for(std::vector<char*>::iterator i = buffers_.begin(); i != buffers_.end(); ++i) {
 		delete [] *i;
 	}
 
 	buffers_.clear();
-	debug_delete(root_);
+
+	for(std::vector<char*>::iterator i = node_pools_.begin(); i != node_pools_.end(); ++i) {
+		delete [] *i;
+	}
+
+	node_pools_.clear();
 
 	detach_list();
 }
 
+char* document::allocate_node()
+{
+	if(node_free_list_ != nullptr) {
+		void* slot = node_free_list_;
+		node_free_list_ = *reinterpret_cast<void**>(slot);
+		return reinterpret_cast<char*>(slot);
+	}
+
+	if(node_pools_.empty() || node_pool_used_ == node_pool_chunk_size) {
+		node_pools_.push_back(new char[node_pool_chunk_size*sizeof(node)]);
+		node_pool_used_ = 0;
+	}
+
+	return node_pools_.back() + sizeof(node)*node_pool_used_++;
+}
+
+void document::deallocate_node(node* n)
+{
+	n->~node();
+
+	//the dead node's storage doubles as the free list link.
+	*reinterpret_cast<void**>(n) = node_free_list_;
+	node_free_list_ = n;
+}
+
 const char* document::dup_string(const char* str)
 {
 	const int len = strlen(str);
@@ -1089,16 +1171,16 @@ const char* document::output()
 	return output_;
 }
 
-string_span document::output_compressed(bool bzip2)
+string_span document::output_compressed(compression::format format)
 {
 	if(compressed_buf_.empty() == false &&
 	   (root_ == nullptr || root_->is_dirty() == false)) {
-		assert(*compressed_buf_.begin() == (bzip2 ? 'B' : 31));
+		assert(*compressed_buf_.begin() == compression_magic(format));
 		return compressed_buf_;
 	}
 
-	buffers_.push_back(compress_buffer(output(), &compressed_buf_, bzip2));
-	assert(*compressed_buf_.begin() == (bzip2 ? 'B' : 31));
+	buffers_.push_back(compress_buffer(output(), &compressed_buf_, format));
+	assert(*compressed_buf_.begin() == compression_magic(format));
 
 	return compressed_buf_;
 }
@@ -1106,7 +1188,7 @@ string_span document::output_compressed(bool bzip2)
 void document::compress()
 {
 	output_compressed();
-	debug_delete(root_);
+	deallocate_node(root_);
 	root_ = nullptr;
 	output_ = nullptr;
 	std::vector<char*> new_buffers;
@@ -1133,7 +1215,7 @@ void document::generate_root()
 
 	assert(root_ == nullptr);
 	const char* cbuf = output_;
-	root_ = new node(*this, nullptr, &cbuf);
+	root_ = new(allocate_node()) node(*this, nullptr, &cbuf);
 }
 
 std::unique_ptr<document> document::clone()
@@ -1148,6 +1230,13 @@ void document::swap(document& o)
 	std::swap(compressed_buf_, o.compressed_buf_);
 	std::swap(output_, o.output_);
 	buffers_.swap(o.buffers_);
+
+	//the nodes stay in the pools they were carved from, so those move
+	//between the documents along with the trees.
+	node_pools_.swap(o.node_pools_);
+	std::swap(node_pool_used_, o.node_pool_used_);
+	std::swap(node_free_list_, o.node_free_list_);
+
 	std::swap(root_, o.root_);
 
 	root_->set_doc(this);
@@ -1158,8 +1247,10 @@ void document::clear()
 {
 	compressed_buf_ = string_span();
 	output_ = nullptr;
-	debug_delete(root_);
-	root_ = new node(*this, nullptr);
+	deallocate_node(root_);
+
+	//the node pools are kept so the storage gets recycled by the new tree.
+	root_ = new(allocate_node()) node(*this, nullptr);
 	for(std::vector<char*>::iterator i = buffers_.begin(); i != buffers_.end(); ++i) {
 		delete [] *i;
 	}
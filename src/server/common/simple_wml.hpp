@@ -25,6 +25,8 @@
 #include <vector>
 
 #include "exceptions.hpp"
+#include "serialization/compression.hpp"
+#include "utils/alloc_tracking.hpp"
 
 namespace simple_wml {
 
@@ -235,9 +237,15 @@ enum INIT_STATE { INIT_COMPRESSED, INIT_STATIC };
 class document
 {
 public:
+	WESNOTH_TRACK_ALLOCATIONS(SUBSYS_SIMPLE_WML)
+
 	document();
 	explicit document(char* buf, INIT_BUFFER_CONTROL control=INIT_TAKE_OWNERSHIP);
 	document(const char* buf, INIT_STATE state);
+	//parses a compressed payload. The document remembers the compressed
+	//bytes and output_compressed() returns them unchanged for as long as
+	//the document isn't modified, so the buffer must stay valid for the
+	//document's lifetime (see take_ownership_of_buffer()).
 	explicit document(string_span compressed_buf);
 	~document();
 	const char* dup_string(const char* str);
@@ -245,7 +253,7 @@ public:
 	const node& root() const { if(!root_) { const_cast<document*>(this)->generate_root(); } return *root_; }
 
 	const char* output();
-	string_span output_compressed(bool bzip2 = false);
+	string_span output_compressed(compression::format format = compression::GZIP);
 
 	void compress();
 
@@ -290,13 +298,25 @@ public:
 
 	static std::size_t document_size_limit;
 private:
+	friend class node;
+
 	void generate_root();
 	document(const document&) = delete;
 	document& operator=(const document&) = delete;
 
+	//storage the document's nodes are carved from. Nodes are placement-new'd
+	//into fixed-size chunks and recycled through a free list, so parsing a
+	//message doesn't hit the heap once per node, and the chunks are released
+	//wholesale with the document.
+	char* allocate_node();
+	void deallocate_node(node* n);
+
 	string_span compressed_buf_;
 	const char* output_;
 	std::vector<char*> buffers_;
+	std::vector<char*> node_pools_;
+	std::size_t node_pool_used_;
+	void* node_free_list_;
 	node* root_;
 
 	//linked list of documents for accounting purposes
@@ -301,6 +301,39 @@ void ban_manager::read()
 			}
 		}
 	}
+
+	index_dirty_ = true;
+}
+
+void ban_manager::rebuild_index()
+{
+	trie_.clear();
+	trie_.emplace_back(); // root
+	unindexed_bans_.clear();
+
+	for(const auto& b : bans_) {
+		const unsigned int mask = b->mask();
+
+		// A prefix mask has all of its zero bits at the low end.
+		if((~mask & (~mask + 1)) != 0) {
+			unindexed_bans_.push_back(b);
+			continue;
+		}
+
+		std::size_t node = 0;
+		for(unsigned int bit = 0x80000000u; bit & mask; bit >>= 1) {
+			const std::size_t side = (b->get_int_ip() & bit) ? 1 : 0;
+			if(trie_[node].child[side] == 0) {
+				trie_[node].child[side] = trie_.size();
+				trie_.emplace_back();
+			}
+			node = trie_[node].child[side];
+		}
+
+		trie_[node].ban = b;
+	}
+
+	index_dirty_ = false;
 }
 
 void ban_manager::write()
@@ -505,6 +538,7 @@ std::string ban_manager::ban(const std::string& ip,
 			// Already exsiting ban for ip. We have to first remove it
 			ret << "Overwriting ban: " << (**ban) << "\n";
 			bans_.erase(ban);
+			index_dirty_ = true;
 		}
 	} catch(const banned::error& e) {
 		ERR_SERVER << e.message << " while creating dummy ban for finding existing ban" << std::endl;
@@ -524,11 +558,11 @@ std::string ban_manager::ban(const std::string& ip,
 	}
 
 	dirty_ = true;
-	write();
+	index_dirty_ = true;
 	return ret.str();
 }
 
-void ban_manager::unban(std::ostringstream& os, const std::string& ip, bool immediate_write)
+void ban_manager::unban(std::ostringstream& os, const std::string& ip)
 {
 	ban_set::iterator ban;
 	try {
@@ -550,9 +584,7 @@ void ban_manager::unban(std::ostringstream& os, const std::string& ip, bool imme
 	if ((*ban)->get_group().empty()) deleted_bans_.push_back(*ban);
 	bans_.erase(ban);
 	dirty_ = true;
-	if(immediate_write) {
-		write();
-	}
+	index_dirty_ = true;
 }
 
 void ban_manager::unban_group(std::ostringstream& os, const std::string& group)
@@ -564,7 +596,7 @@ void ban_manager::unban_group(std::ostringstream& os, const std::string& group)
 	os << "Removed " << (bans_.size() - temp.size()) << " bans";
 	bans_.swap(temp);
 	dirty_ = true;
-	write();
+	index_dirty_ = true;
 }
 
 void ban_manager::check_ban_times(std::time_t time_now)
@@ -583,12 +615,9 @@ void ban_manager::check_ban_times(std::time_t time_now)
 		LOG_SERVER << "Remove a ban " << ban->get_ip() << ". time: " << time_now << " end_time " << ban->get_end_time()
 				   << "\n";
 		std::ostringstream os;
-		unban(os, ban->get_ip(), false);
+		unban(os, ban->get_ip());
 		time_queue_.pop();
 	}
-
-	// Save bans if there is any new ones
-	write();
 }
 
 void ban_manager::list_deleted_bans(std::ostringstream& out, const std::string& mask) const
@@ -664,10 +693,42 @@ std::string ban_manager::is_ip_banned(const std::string& ip)
 		return "";
 	}
 
-	auto ban = std::find_if(bans_.begin(), bans_.end(), [pair](const banned_ptr& p) { return p->match_ip(pair); });
-	if (ban == bans_.end()) return "";
-	const std::string& nick = (*ban)->get_nick();
-	return (*ban)->get_reason() + (nick.empty() ? "" : " (" + nick + ")") + " (Remaining ban duration: " + (*ban)->get_human_time_span() + ")";
+	if(index_dirty_) {
+		rebuild_index();
+	}
+
+	banned_ptr match;
+
+	// Walk the address bits from the most significant one down; any node
+	// passed on the way may carry a ban whose prefix covers the address.
+	std::size_t node = 0;
+	unsigned int bit = 0x80000000u;
+	while(true) {
+		if(trie_[node].ban && trie_[node].ban->match_ip(pair)) {
+			match = trie_[node].ban;
+			break;
+		}
+
+		const std::size_t next = bit ? trie_[node].child[(pair.first & bit) ? 1 : 0] : 0;
+		if(next == 0) {
+			break;
+		}
+
+		node = next;
+		bit >>= 1;
+	}
+
+	if(!match) {
+		const auto ban = std::find_if(unindexed_bans_.begin(), unindexed_bans_.end(),
+			[&pair](const banned_ptr& p) { return p->match_ip(pair); });
+		if(ban != unindexed_bans_.end()) {
+			match = *ban;
+		}
+	}
+
+	if (!match) return "";
+	const std::string& nick = match->get_nick();
+	return match->get_reason() + (nick.empty() ? "" : " (" + nick + ")") + " (Remaining ban duration: " + match->get_human_time_span() + ")";
 }
 
 void ban_manager::init_ban_help()
@@ -727,6 +788,9 @@ ban_manager::ban_manager()
 	, ban_help_()
 	, filename_()
 	, dirty_(false)
+	, trie_(1)
+	, unindexed_bans_()
+	, index_dirty_(false)
 {
 	init_ban_help();
 }
@@ -22,6 +22,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 class config;
 
@@ -130,6 +131,28 @@ class ban_manager
 	std::string filename_;
 	bool dirty_;
 
+	/**
+	 * Binary trie over address bits used to match bans in O(32) per login.
+	 *
+	 * Bans whose mask is a contiguous prefix (the common case, including
+	 * trailing '*' wildcards) sit at a depth equal to their prefix length.
+	 * The rare bans with a non-contiguous mask (e.g. "12.*.34.*") don't fit
+	 * a prefix trie and are kept in a separate list scanned linearly. The
+	 * index is rebuilt lazily from bans_ after any mutation; bans_ remains
+	 * the authoritative container.
+	 */
+	struct trie_node
+	{
+		std::size_t child[2] {0, 0};
+		banned_ptr ban;
+	};
+
+	std::vector<trie_node> trie_;
+	std::vector<banned_ptr> unindexed_bans_;
+	bool index_dirty_;
+
+	void rebuild_index();
+
 	bool is_digit(const char& c) const
 	{
 		return c >= '0' && c <= '9';
@@ -152,6 +175,14 @@ public:
 	~ban_manager();
 
 	void read();
+
+	/**
+	 * Flushes pending ban changes to disk, if any.
+	 *
+	 * Ban mutations only mark the list dirty; the file is rewritten here,
+	 * from the periodic maintenance timer and on shutdown, instead of
+	 * inline on every change.
+	 */
 	void write();
 
 	/**
@@ -163,7 +194,7 @@ public:
 	bool parse_time(const std::string& duration, std::time_t* time) const;
 
 	std::string ban(const std::string&, const std::time_t&, const std::string&, const std::string&, const std::string&, const std::string& = "");
-	void unban(std::ostringstream& os, const std::string& ip, bool immediate_write=true);
+	void unban(std::ostringstream& os, const std::string& ip);
 	void unban_group(std::ostringstream& os, const std::string& group);
 
 	void list_deleted_bans(std::ostringstream& out, const std::string& mask = "*") const;
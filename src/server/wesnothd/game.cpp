@@ -79,7 +79,8 @@ game::game(wesnothd::server& server, player_connections& player_connections,
 		player_iterator host,
 		const std::string& name,
 		bool save_replays,
-		const std::string& replay_save_path)
+		const std::string& replay_save_path,
+		compression::format replay_compression)
 	: server(server)
 	, player_connections_(player_connections)
 	, id_(id_num++)
@@ -96,6 +97,7 @@ game::game(wesnothd::server& server, player_connections& player_connections,
 	, started_(false)
 	, level_()
 	, history_()
+	, history_merged_(false)
 	, description_(nullptr)
 	, current_turn_(0)
 	, current_side_index_(0)
@@ -107,6 +109,7 @@ game::game(wesnothd::server& server, player_connections& player_connections,
 	, termination_()
 	, save_replays_(save_replays)
 	, replay_save_path_(replay_save_path)
+	, replay_compression_(replay_compression)
 	, rng_()
 	, last_choice_request_id_(-1) /* or maybe 0 ? it shouldn't matter*/
 {
@@ -1624,9 +1627,17 @@ void game::load_next_scenario(player_iterator user)
 template<typename Container>
 void game::send_to_players(simple_wml::document& data, const Container& players, std::optional<player_iterator> exclude)
 {
+	// Compress the document once and hand the same payload to every
+	// recipient's send queue, instead of recompressing it per player.
+	server_base::shared_send_buffer buffer;
+
 	for(const auto& player : players) {
 		if(player != exclude) {
-			server.send_to_player(player, data);
+			if(!buffer) {
+				buffer = server_base::compress_doc(data);
+			}
+
+			server.send_to_player(player, buffer);
 		}
 	}
 }
@@ -1718,6 +1729,13 @@ void game::send_history(player_iterator player) const
 		return;
 	}
 
+	// Nothing was recorded since the last join merged the history into a
+	// single compressed document, so relay that one as-is.
+	if(history_merged_) {
+		server.send_to_player(player, *history_.front());
+		return;
+	}
+
 	// we make a new document based on converting to plain text and
 	// concatenating the buffers.
 	// TODO: Work out how to concentate buffers without decompressing.
@@ -1734,6 +1752,7 @@ void game::send_history(player_iterator player) const
 
 		history_.clear();
 		history_.push_back(std::move(doc));
+		history_merged_ = true;
 	} catch(const simple_wml::error& e) {
 		WRN_CONFIG << __func__ << ": simple_wml error: " << e.message << std::endl;
 	}
@@ -1762,7 +1781,8 @@ static bool is_invalid_filename_char(char c)
 std::string game::get_replay_filename()
 {
 	std::stringstream name;
-	name << (*starting_pos(level_.root()))["name"] << " Turn " << current_turn() << " (" << db_id_ << ").bz2";
+	name << (*starting_pos(level_.root()))["name"] << " Turn " << current_turn() << " (" << db_id_ << ")"
+	     << compression::format_extension(replay_compression_);
 	std::string filename(name.str());
 	std::replace(filename.begin(), filename.end(), ' ', '_');
 	filename.erase(std::remove_if(filename.begin(), filename.end(), is_invalid_filename_char), filename.end());
@@ -1785,6 +1805,7 @@ void game::save_replay()
 	}
 
 	history_.clear();
+	history_merged_ = false;
 
 	std::stringstream replay_data;
 	try {
@@ -1815,7 +1836,7 @@ void game::save_replay()
 		DBG_GAME << "saving replay: " << filename << std::endl;
 
 		filesystem::scoped_ostream os(filesystem::ostream_file(replay_save_path_ + filename));
-		(*os) << replay.output_compressed(true);
+		(*os) << replay.output_compressed(replay_compression_);
 
 		if(!os->good()) {
 			ERR_GAME << "Could not save replay! (" << filename << ")" << std::endl;
@@ -1829,11 +1850,13 @@ void game::record_data(std::unique_ptr<simple_wml::document> data)
 {
 	data->compress();
 	history_.push_back(std::move(data));
+	history_merged_ = false;
 }
 
 void game::clear_history()
 {
 	history_.clear();
+	history_merged_ = false;
 }
 
 void game::set_description(simple_wml::node* desc)
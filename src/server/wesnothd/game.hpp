@@ -46,7 +46,8 @@ public:
 			player_iterator host,
 			const std::string& name = "",
 			bool save_replays = false,
-			const std::string& replay_save_path = "");
+			const std::string& replay_save_path = "",
+			compression::format replay_compression = compression::BZIP2);
 
 	~game();
 
@@ -865,6 +866,13 @@ private:
 	/** Replay data. */
 	mutable std::vector<std::unique_ptr<simple_wml::document>> history_;
 
+	/**
+	 * Whether history_ currently holds a single document produced by the
+	 * merge in send_history(). If so, a later join can relay that compressed
+	 * document as-is instead of merging the history all over again.
+	 */
+	mutable bool history_merged_;
+
 	/** Pointer to the game's description in the games_and_users_list_. */
 	simple_wml::node* description_;
 
@@ -896,6 +904,8 @@ private:
 	bool save_replays_;
 	/** Where to save the replay of this game. */
 	std::string replay_save_path_;
+	/** Which compression format to archive the replay with. */
+	compression::format replay_compression_;
 
 	/** A wrapper for mersenne twister rng which generates randomness for this game */
 	randomness::mt_rng rng_;
@@ -0,0 +1,471 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+/**
+ * @file
+ * Load-generation client swarm for wesnothd.
+ *
+ * Simulates a configurable number of scripted clients speaking the real
+ * wire protocol via simple_wml: login, lobby refreshes, game creation and
+ * [turn] relay between paired clients. Even-numbered clients host a game,
+ * the following odd-numbered client joins it as an observer and measures
+ * how long relayed turn data takes to arrive. Latency percentiles are
+ * reported on exit.
+ *
+ * All clients run in a single io_context in one process, so relay latency
+ * samples rely on one machine's steady clock and are only meaningful when
+ * the swarm runs on (or close to) the server host.
+ */
+
+#include "game_version.hpp"
+#include "server/common/simple_wml.hpp"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using boost::asio::ip::tcp;
+
+namespace
+{
+
+struct swarm_options
+{
+	std::string host = "127.0.0.1";
+	std::string port = "15000";
+	std::string version = game_config::wesnoth_version.str();
+	std::size_t clients = 100;
+	int duration_s = 60;
+	int refresh_period_ms = 5000;
+	int turn_period_ms = 1000;
+};
+
+/** One latency metric: accumulates samples and prints a percentile row. */
+class latency_metric
+{
+public:
+	explicit latency_metric(const std::string& name)
+		: name_(name)
+		, samples_ms_()
+	{
+	}
+
+	void add(const std::chrono::steady_clock::duration& elapsed)
+	{
+		samples_ms_.push_back(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / 1000.0);
+	}
+
+	void report(std::ostream& out)
+	{
+		out << name_ << ":\tsamples = " << samples_ms_.size();
+
+		if(samples_ms_.empty()) {
+			out << '\n';
+			return;
+		}
+
+		std::sort(samples_ms_.begin(), samples_ms_.end());
+
+		const auto percentile = [this](double p) {
+			const std::size_t index = static_cast<std::size_t>(p * (samples_ms_.size() - 1));
+			return samples_ms_[index];
+		};
+
+		out << "\tmin = " << samples_ms_.front() << " ms"
+			<< "\tp50 = " << percentile(0.50) << " ms"
+			<< "\tp90 = " << percentile(0.90) << " ms"
+			<< "\tp99 = " << percentile(0.99) << " ms"
+			<< "\tmax = " << samples_ms_.back() << " ms\n";
+	}
+
+private:
+	std::string name_;
+	std::vector<double> samples_ms_;
+};
+
+struct swarm_stats
+{
+	latency_metric login{"login"};
+	latency_metric refresh{"lobby refresh"};
+	latency_metric relay{"turn relay"};
+
+	std::size_t failed_clients = 0;
+	std::size_t server_errors = 0;
+};
+
+void send_doc(tcp::socket& socket, simple_wml::document& doc, boost::asio::yield_context yield)
+{
+	simple_wml::string_span s = doc.output_compressed();
+
+	union DataSize
+	{
+		uint32_t size;
+		char buf[4];
+	} data_size {};
+	data_size.size = htonl(s.size());
+
+	std::vector<boost::asio::const_buffer> buffers {
+		{ data_size.buf, 4 },
+		{ s.begin(), static_cast<std::size_t>(s.size()) }
+	};
+
+	boost::asio::async_write(socket, buffers, yield);
+}
+
+std::unique_ptr<simple_wml::document> receive_doc(tcp::socket& socket, boost::asio::yield_context yield)
+{
+	union DataSize
+	{
+		uint32_t size;
+		char buf[4];
+	} data_size {};
+
+	boost::asio::async_read(socket, boost::asio::buffer(data_size.buf, 4), yield);
+
+	const uint32_t size = ntohl(data_size.size);
+	if(size == 0 || size > simple_wml::document::document_size_limit) {
+		throw std::runtime_error("invalid payload size received");
+	}
+
+	std::unique_ptr<char[]> buffer{ new char[size] };
+	boost::asio::async_read(socket, boost::asio::buffer(buffer.get(), size), yield);
+
+	simple_wml::string_span compressed_buf(buffer.get(), size);
+	auto doc = std::make_unique<simple_wml::document>(compressed_buf);
+	doc->take_ownership_of_buffer(buffer.release());
+	return doc;
+}
+
+/** One scripted client connection. */
+class client : public std::enable_shared_from_this<client>
+{
+public:
+	client(boost::asio::io_context& io, const swarm_options& options, swarm_stats& stats, std::size_t index)
+		: io_(io)
+		, options_(options)
+		, stats_(stats)
+		, index_(index)
+		, socket_(io)
+		, timer_(io)
+		, name_("lt" + std::to_string(index))
+		, hosted_game_name_("loadtest_" + std::to_string(is_host() ? index : index - 1))
+		, game_id_(0)
+		, refresh_pending_(false)
+		, refresh_sent_()
+	{
+	}
+
+	void start()
+	{
+		auto self = shared_from_this();
+		boost::asio::spawn(io_, [self](boost::asio::yield_context yield) {
+			try {
+				self->run(yield);
+			} catch(const std::exception&) {
+				// Connection failures and protocol errors under overload are
+				// exactly what this tool probes for; count them and move on.
+				++self->stats_.failed_clients;
+			}
+		});
+	}
+
+private:
+	bool is_host() const
+	{
+		return index_ % 2 == 0;
+	}
+
+	void run(boost::asio::yield_context yield)
+	{
+		tcp::resolver resolver(io_);
+		boost::asio::async_connect(socket_, resolver.async_resolve(options_.host, options_.port, yield), yield);
+
+		// Plain (non-TLS) connection handshake.
+		union DataSize
+		{
+			uint32_t size;
+			char buf[4];
+		} handshake {};
+		boost::asio::async_write(socket_, boost::asio::buffer(handshake.buf, 4), yield);
+		boost::asio::async_read(socket_, boost::asio::buffer(handshake.buf, 4), yield);
+
+		// [version] query/response, then login.
+		auto doc = receive_doc(socket_, yield);
+		if(!doc->child("version")) {
+			throw std::runtime_error("expected [version] query");
+		}
+
+		simple_wml::document version;
+		simple_wml::node& v = version.root().add_child("version");
+		v.set_attr_dup("version", options_.version.c_str());
+		v.set_attr_dup("client_source", "loadtest");
+		send_doc(socket_, version, yield);
+
+		doc = receive_doc(socket_, yield);
+		if(!doc->child("mustlogin")) {
+			throw std::runtime_error("expected [mustlogin]");
+		}
+
+		simple_wml::document login;
+		login.root().add_child("login").set_attr_dup("username", name_.c_str());
+
+		const auto login_start = std::chrono::steady_clock::now();
+		send_doc(socket_, login, yield);
+
+		while(true) {
+			doc = receive_doc(socket_, yield);
+			if(doc->child("join_lobby")) {
+				stats_.login.add(std::chrono::steady_clock::now() - login_start);
+				break;
+			}
+			if(doc->child("error")) {
+				throw std::runtime_error("login rejected");
+			}
+		}
+
+		auto self = shared_from_this();
+		boost::asio::spawn(io_, [self](boost::asio::yield_context yield) {
+			try {
+				self->act(yield);
+			} catch(const std::exception&) {
+			}
+		});
+
+		// Everything the server pushes at us from here on - gamelist diffs,
+		// chat, level data, relayed turns - arrives through this loop.
+		while(true) {
+			doc = receive_doc(socket_, yield);
+			handle_doc(*doc);
+		}
+	}
+
+	void handle_doc(simple_wml::document& doc)
+	{
+		if(doc.child("error")) {
+			++stats_.server_errors;
+			return;
+		}
+
+		if(const simple_wml::node* gamelist = doc.child("gamelist")) {
+			if(refresh_pending_) {
+				stats_.refresh.add(std::chrono::steady_clock::now() - refresh_sent_);
+				refresh_pending_ = false;
+			}
+
+			// Joiners look their partner's game up by name to learn its id.
+			if(!is_host() && game_id_ == 0) {
+				for(const simple_wml::node* game : gamelist->children("game")) {
+					if((*game)["name"] == hosted_game_name_.c_str()) {
+						game_id_ = (*game)["id"].to_int();
+						break;
+					}
+				}
+			}
+
+			return;
+		}
+
+		if(const simple_wml::node* turn = doc.child("turn")) {
+			record_relay_latency(*turn);
+		}
+	}
+
+	void record_relay_latency(const simple_wml::node& turn)
+	{
+		for(const simple_wml::node* command : turn.children("command")) {
+			const simple_wml::node* speak = command->child("speak");
+			if(!speak) {
+				continue;
+			}
+
+			// The host stamps its steady clock into the message; see act().
+			const std::string message = (*speak)["message"].to_string();
+			if(message.compare(0, 3, "lt ") != 0) {
+				continue;
+			}
+
+			const auto sent = std::chrono::steady_clock::time_point(
+				std::chrono::steady_clock::duration(std::strtoll(message.c_str() + 3, nullptr, 10)));
+			stats_.relay.add(std::chrono::steady_clock::now() - sent);
+		}
+	}
+
+	void wait(int period_ms, boost::asio::yield_context yield)
+	{
+		timer_.expires_after(std::chrono::milliseconds(period_ms));
+		timer_.async_wait(yield);
+	}
+
+	/** Scripted lobby and game activity, run alongside the receive loop. */
+	void act(boost::asio::yield_context yield)
+	{
+		if(is_host()) {
+			simple_wml::document create;
+			create.root().add_child("create_game").set_attr_dup("name", hosted_game_name_.c_str());
+			send_doc(socket_, create, yield);
+
+			// Minimal level data: enough for the server to initialize the
+			// game, list it in the lobby and accept observers.
+			simple_wml::document level;
+			level.root().add_child("multiplayer").set_attr("observer", "yes");
+			simple_wml::node& scenario = level.root().add_child("scenario");
+			scenario.set_attr("map_data", "");
+			simple_wml::node& side = scenario.add_child("side");
+			side.set_attr("side", "1");
+			side.set_attr("controller", "human");
+			side.set_attr_dup("current_player", name_.c_str());
+			send_doc(socket_, level, yield);
+
+			while(true) {
+				wait(options_.turn_period_ms, yield);
+
+				const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+				simple_wml::document turn;
+				simple_wml::node& speak = turn.root().add_child("turn").add_child("command").add_child("speak");
+				speak.set_attr_dup("id", name_.c_str());
+				speak.set_attr_dup("message", ("lt " + std::to_string(now)).c_str());
+				send_doc(socket_, turn, yield);
+			}
+		} else {
+			// Poll the lobby until the partner's game shows up, then join it.
+			// The polling doubles as the lobby churn every client generates.
+			while(game_id_ == 0) {
+				send_refresh(yield);
+				wait(options_.refresh_period_ms, yield);
+			}
+
+			simple_wml::document join;
+			simple_wml::node& j = join.root().add_child("join");
+			j.set_attr_dup("id", std::to_string(game_id_).c_str());
+			j.set_attr("observe", "yes");
+			send_doc(socket_, join, yield);
+
+			while(true) {
+				wait(options_.refresh_period_ms, yield);
+				send_refresh(yield);
+			}
+		}
+	}
+
+	void send_refresh(boost::asio::yield_context yield)
+	{
+		simple_wml::document refresh;
+		refresh.root().add_child("refresh_lobby");
+
+		refresh_sent_ = std::chrono::steady_clock::now();
+		refresh_pending_ = true;
+		send_doc(socket_, refresh, yield);
+	}
+
+	boost::asio::io_context& io_;
+	const swarm_options& options_;
+	swarm_stats& stats_;
+	std::size_t index_;
+	tcp::socket socket_;
+	boost::asio::steady_timer timer_;
+	std::string name_;
+	std::string hosted_game_name_;
+	int game_id_;
+	bool refresh_pending_;
+	std::chrono::steady_clock::time_point refresh_sent_;
+};
+
+int usage(const char* name, int retval)
+{
+	std::cout << "usage: " << name << " [options]\n"
+		<< "  -H, --host <host>       server host (default: 127.0.0.1)\n"
+		<< "  -p, --port <port>       server port (default: 15000)\n"
+		<< "  -n, --clients <count>   number of simulated clients (default: 100)\n"
+		<< "  -d, --duration <secs>   how long to run (default: 60)\n"
+		<< "  --version <version>     client version to report\n"
+		<< "  --refresh-period <ms>   delay between lobby refreshes (default: 5000)\n"
+		<< "  --turn-period <ms>      delay between relayed turns (default: 1000)\n";
+	return retval;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv)
+{
+	swarm_options options;
+
+	for(int arg = 1; arg != argc; ++arg) {
+		const std::string val(argv[arg]);
+		if(val.empty()) {
+			continue;
+		}
+
+		if((val == "--host" || val == "-H") && arg + 1 != argc) {
+			options.host = argv[++arg];
+		} else if((val == "--port" || val == "-p") && arg + 1 != argc) {
+			options.port = argv[++arg];
+		} else if((val == "--clients" || val == "-n") && arg + 1 != argc) {
+			options.clients = atoi(argv[++arg]);
+		} else if((val == "--duration" || val == "-d") && arg + 1 != argc) {
+			options.duration_s = atoi(argv[++arg]);
+		} else if(val == "--version" && arg + 1 != argc) {
+			options.version = argv[++arg];
+		} else if(val == "--refresh-period" && arg + 1 != argc) {
+			options.refresh_period_ms = atoi(argv[++arg]);
+		} else if(val == "--turn-period" && arg + 1 != argc) {
+			options.turn_period_ms = atoi(argv[++arg]);
+		} else if(val == "--help" || val == "-h") {
+			return usage(argv[0], 0);
+		} else {
+			std::cerr << "unknown option: " << val << '\n';
+			return usage(argv[0], 2);
+		}
+	}
+
+	boost::asio::io_context io;
+	swarm_stats stats;
+
+	std::vector<std::shared_ptr<client>> clients;
+	clients.reserve(options.clients);
+	for(std::size_t i = 0; i < options.clients; ++i) {
+		clients.push_back(std::make_shared<client>(io, options, stats, i));
+		clients.back()->start();
+	}
+
+	boost::asio::steady_timer stop_timer(io);
+	stop_timer.expires_after(std::chrono::seconds(options.duration_s));
+	stop_timer.async_wait([&io](const boost::system::error_code&) { io.stop(); });
+
+	std::cout << "running " << options.clients << " clients against "
+		<< options.host << ":" << options.port << " for " << options.duration_s << "s\n";
+
+	io.run();
+
+	stats.login.report(std::cout);
+	stats.refresh.report(std::cout);
+	stats.relay.report(std::cout);
+	std::cout << "failed clients:\t" << stats.failed_clients << '\n'
+		<< "server errors:\t" << stats.server_errors << '\n';
+
+	return stats.failed_clients == 0 ? 0 : 1;
+}
@@ -36,6 +36,42 @@ struct compare_samples_by_time {
 	}
 };
 
+namespace {
+
+int latency_bucket(clock_t t)
+{
+	int bucket = 0;
+	while(t > 0 && bucket < metrics::num_latency_buckets - 1) {
+		t >>= 1;
+		++bucket;
+	}
+
+	return bucket;
+}
+
+clock_t bucket_upper_bound(int bucket)
+{
+	return bucket <= 0 ? 0 : clock_t(1) << (bucket - 1);
+}
+
+/** Upper bound for the given percentile of the sample's processing times. */
+clock_t approx_percentile(const metrics::sample& s, int percent)
+{
+	const int target = (s.nsamples * percent + 99) / 100;
+
+	int seen = 0;
+	for(int bucket = 0; bucket < metrics::num_latency_buckets; ++bucket) {
+		seen += s.processing_hist[bucket];
+		if(seen >= target) {
+			return bucket_upper_bound(bucket);
+		}
+	}
+
+	return bucket_upper_bound(metrics::num_latency_buckets - 1);
+}
+
+}
+
 metrics::metrics()
 	: samples_()
 	, most_consecutive_requests_(0)
@@ -96,6 +132,7 @@ void metrics::record_sample(const simple_wml::string_span& name, clock_t parsing
 	isample->processing_time += processing_time;
 	isample->max_parsing_time = std::max(parsing_time,isample->max_parsing_time);
 	isample->max_processing_time = std::max(processing_time,isample->max_processing_time);
+	isample->processing_hist[latency_bucket(processing_time)]++;
 }
 
 void metrics::game_terminated(const std::string& reason)
@@ -133,7 +170,10 @@ std::ostream& metrics::requests(std::ostream& out) const
 	for(const auto& s : ordered_samples) {
 		out << "'" << s.name << "' called " << s.nsamples << " times "
 			<< s.parsing_time << "("<< s.max_parsing_time <<") parsing time, "
-			<< s.processing_time << "("<<s.max_processing_time<<") processing time\n";
+			<< s.processing_time << "("<<s.max_processing_time<<") processing time, "
+			<< "processing time <= " << approx_percentile(s, 50) << "/"
+			<< approx_percentile(s, 90) << "/"
+			<< approx_percentile(s, 99) << " for 50%/90%/99% of the requests\n";
 		n += s.nsamples;
 		pa += s.parsing_time;
 		pr += s.processing_time;
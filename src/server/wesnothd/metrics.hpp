@@ -17,6 +17,7 @@
 
 #include "server/common/simple_wml.hpp"
 
+#include <array>
 #include <ctime>
 #include <iosfwd>
 #include <map>
@@ -39,6 +40,14 @@ public:
 	std::ostream& requests(std::ostream& out) const;
 	friend std::ostream& operator<<(std::ostream& out, metrics& met);
 
+	/**
+	 * Number of latency histogram buckets. Bucket n counts samples whose
+	 * processing time was in [2^(n-1), 2^n) clock ticks, so recording is a
+	 * couple of shifts and an increment, and approximate tail percentiles
+	 * can still be read off the distribution.
+	 */
+	static const int num_latency_buckets = 24;
+
 	struct sample
 	{
 		sample()
@@ -48,6 +57,7 @@ public:
 			, processing_time(0)
 			, max_parsing_time(0)
 			, max_processing_time(0)
+			, processing_hist()
 		{
 		}
 
@@ -55,6 +65,7 @@ public:
 		int nsamples;
 		clock_t parsing_time, processing_time;
 		clock_t max_parsing_time, max_processing_time;
+		std::array<int, num_latency_buckets> processing_hist;
 
 		operator const simple_wml::string_span&()
 		{
@@ -246,6 +246,7 @@ server::server(int port,
 	, deny_unregistered_login_(false)
 	, save_replays_(false)
 	, replay_save_path_()
+	, replay_compression_(compression::BZIP2)
 	, allow_remote_shutdown_(false)
 	, client_sources_()
 	, tor_ip_list_()
@@ -448,6 +449,21 @@ void server::load_config()
 	save_replays_ = cfg_["save_replays"].to_bool();
 	replay_save_path_ = cfg_["replay_save_path"].str();
 
+	// bzip2 is the historical default; zstd archives nearly as small an order
+	// of magnitude faster, but has to be opted into so old tooling that only
+	// expects .bz2 replays keeps working.
+	const std::string& replay_compression = cfg_["replay_compression"].str();
+	if(replay_compression == "zstd") {
+		replay_compression_ = compression::ZSTD;
+	} else if(replay_compression == "gzip") {
+		replay_compression_ = compression::GZIP;
+	} else {
+		if(!replay_compression.empty() && replay_compression != "bzip2") {
+			ERR_SERVER << "Unknown replay_compression '" << replay_compression << "', using bzip2\n";
+		}
+		replay_compression_ = compression::BZIP2;
+	}
+
 	tor_ip_list_ = utils::split(cfg_["tor_ip_list_path"].empty()
 		? ""
 		: filesystem::read_file(cfg_["tor_ip_list_path"]), '\n');
@@ -605,6 +621,10 @@ void server::dump_stats(const boost::system::error_code& ec)
 	LOG_SERVER << "Statistics:"
 			   << "\tnumber_of_games = " << games().size() << "\tnumber_of_users = " << player_connections_.size()
 			   << "\n";
+
+	// Ban changes are no longer written inline; flush any pending ones here.
+	ban_manager_.write();
+
 	start_dump_stats();
 }
 
@@ -1103,31 +1123,25 @@ template<class SocketPtr> void server::handle_player(boost::asio::yield_context
 		if(check_error(ec, socket) || !doc) return;
 
 		// DBG_SERVER << client_address(socket) << "\tWML received:\n" << doc->output() << std::endl;
+		metrics_.service_request();
+		const clock_t processing_start = std::clock();
+
 		if(doc->child("refresh_lobby")) {
 			async_send_doc_queued(socket, games_and_users_list_);
-			continue;
-		}
-
-		if(simple_wml::node* whisper = doc->child("whisper")) {
+		} else if(simple_wml::node* whisper = doc->child("whisper")) {
 			handle_whisper(player, *whisper);
-			continue;
-		}
-
-		if(simple_wml::node* query = doc->child("query")) {
+		} else if(simple_wml::node* query = doc->child("query")) {
 			handle_query(player, *query);
-			continue;
-		}
-
-		if(simple_wml::node* nickserv = doc->child("nickserv")) {
+		} else if(simple_wml::node* nickserv = doc->child("nickserv")) {
 			handle_nickserv(player, *nickserv);
-			continue;
-		}
-
-		if(!player_is_in_game(player)) {
+		} else if(!player_is_in_game(player)) {
 			handle_player_in_lobby(player, *doc);
 		} else {
 			handle_player_in_game(player, *doc);
 		}
+
+		// Sample by the request type, i.e. the first tag of the document.
+		metrics_.record_sample(doc->root().first_child(), 0, std::clock() - processing_start);
 	}
 }
 
@@ -1346,7 +1360,7 @@ void server::handle_create_game(player_iterator player, simple_wml::node& create
 	// and set the player as the host/owner.
 	player_connections_.modify(player, [this, player, &game_name](player_record& host_record) {
 		host_record.get_game().reset(
-			new wesnothd::game(*this, player_connections_, player, game_name, save_replays_, replay_save_path_),
+			new wesnothd::game(*this, player_connections_, player, game_name, save_replays_, replay_save_path_, replay_compression_),
 			std::bind(&server::cleanup_game, this, std::placeholders::_1)
 		);
 	});
@@ -1980,10 +1994,18 @@ void server::remove_player(player_iterator iter)
 
 void server::send_to_lobby(simple_wml::document& data, std::optional<player_iterator> exclude)
 {
+	// Compress the document once and hand the same payload to every
+	// recipient's send queue, instead of recompressing it per player.
+	shared_send_buffer buffer;
+
 	for(const auto& p : player_connections_.get<game_t>().equal_range(0)) {
 		auto player { player_connections_.iterator_to(p) };
 		if(player != exclude) {
-			send_to_player(player, data);
+			if(!buffer) {
+				buffer = compress_doc(data);
+			}
+
+			send_to_player(player, buffer);
 		}
 	}
 }
@@ -3036,6 +3058,31 @@ int main(int argc, char** argv)
 					return 2;
 				}
 
+				p = q;
+			}
+		} else if(val.substr(0, 13) == "--log-sample=") {
+			// --log-sample=<rate>,<domain1>,<domain2>,...
+			std::size_t p = val.find(',', 13);
+			if(p == std::string::npos) {
+				std::cerr << "bad option: " << val << '\n';
+				return 2;
+			}
+
+			const int rate = atoi(val.substr(13, p - 13).c_str());
+			if(rate < 1) {
+				std::cerr << "bad sample rate in: " << val << '\n';
+				return 2;
+			}
+
+			while(p != std::string::npos) {
+				std::size_t q = val.find(',', p + 1);
+				const std::string s = val.substr(p + 1, q == std::string::npos ? q : q - (p + 1));
+
+				if(!lg::set_log_domain_sample_rate(s, rate)) {
+					std::cerr << "unknown debug domain: " << s << '\n';
+					return 2;
+				}
+
 				p = q;
 			}
 		} else if((val == "--port" || val == "-p") && arg + 1 != argc) {
@@ -3052,6 +3099,9 @@ int main(int argc, char** argv)
 					  << "                             sets the severity level of the debug domains.\n"
 					  << "                             'all' can be used to match any debug domain.\n"
 					  << "                             Available levels: error, warning, info, debug.\n"
+					  << "  --log-sample=<rate>,<domain1>,<domain2>,...\n"
+					  << "                             keeps only one out of every <rate> log records\n"
+					  << "                             of the given debug domains.\n"
 					  << "  -p, --port <port>          Binds the server to the specified port.\n"
 					  << "  --keepalive                Enable TCP keepalive.\n"
 					  << "  -t, --threads <n>          Uses n worker threads for network I/O (default: 5).\n"
@@ -3093,5 +3143,9 @@ int main(int argc, char** argv)
 		}
 	}
 
+	// Hand log writing to a background thread, so that verbose logging does
+	// not stall the main loop on a slow stderr or log file.
+	lg::set_async_logging(true);
+
 	return wesnothd::server(port, keep_alive, config_file, min_threads, max_threads).run();
 }
@@ -82,6 +82,12 @@ public:
 			player->socket()
 		);
 	}
+	void send_to_player(player_iterator player, const shared_send_buffer& data) {
+		utils::visit(
+			[this, &data](auto&& socket) { async_send_buffer_queued(socket, data); },
+			player->socket()
+		);
+	}
 	void send_server_message_to_lobby(const std::string& message, std::optional<player_iterator> exclude = {});
 	void send_server_message_to_all(const std::string& message, std::optional<player_iterator> exclude = {});
 
@@ -161,6 +167,7 @@ private:
 	bool deny_unregistered_login_;
 	bool save_replays_;
 	std::string replay_save_path_;
+	compression::format replay_compression_;
 	bool allow_remote_shutdown_;
 	std::set<std::string> client_sources_;
 	std::vector<std::string> tor_ip_list_;
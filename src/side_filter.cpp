@@ -271,6 +271,11 @@ bool side_filter::match(int side) const
 
 bool side_filter::match(const team& t) const
 {
+	const auto cached = match_cache_.find(t.side());
+	if(cached != match_cache_.end()) {
+		return cached->second;
+	}
+
 	bool matches = match_internal(t);
 
 	// Handle [and], [or], and [not] with in-order precedence
@@ -289,5 +294,6 @@ bool side_filter::match(const team& t) const
 		}
 	}
 
+	match_cache_.emplace(t.side(), matches);
 	return matches;
 }
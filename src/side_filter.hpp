@@ -17,6 +17,7 @@
 
 #include "variable.hpp"
 
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -60,4 +61,13 @@ private:
 	mutable std::unique_ptr<side_filter> enemy_filter_;
 	mutable std::unique_ptr<side_filter> has_ally_filter_;
 	mutable std::unique_ptr<side_filter> has_enemy_filter_;
+
+	/**
+	 * Results of match() by side number. Filters are constructed per check
+	 * and the game state can't change during one, so once a side has been
+	 * evaluated the answer can be reused. This matters for the nested
+	 * [enemy_of] etc. filters, whose get_teams() used to rescan every team
+	 * (including any [has_unit] sweep of the unit map) once per outer team.
+	 */
+	mutable std::map<int, bool> match_cache_;
 };
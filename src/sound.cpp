@@ -15,6 +15,7 @@
 
 #include "sound.hpp"
 #include "config.hpp"
+#include "events.hpp"
 #include "filesystem.hpp"
 #include "log.hpp"
 #include "preferences/game.hpp"
@@ -26,8 +27,10 @@
 #include <SDL2/SDL_mixer.h>
 
 #include <list>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 
 static lg::log_domain log_audio("audio");
 #define DBG_AUDIO LOG_STREAM(debug, log_audio)
@@ -181,6 +184,14 @@ std::shared_ptr<sound::music_track> current_track;
 unsigned int current_track_index = 0;
 std::shared_ptr<sound::music_track> previous_track;
 
+// The track we expect choose_track() to pick at the next switchover,
+// selected ahead of time so its file can be opened and prebuffered in the
+// background while the current track is still playing.
+std::shared_ptr<sound::music_track> predicted_track;
+
+// Localized music file names with a background load still in flight.
+std::set<std::string> music_preloads_pending;
+
 std::vector<std::shared_ptr<sound::music_track>>::const_iterator find_track(const sound::music_track& track)
 {
 	return std::find_if(current_track_list.begin(), current_track_list.end(),
@@ -331,6 +342,21 @@ static std::shared_ptr<sound::music_track> choose_track()
 {
 	assert(!current_track_list.empty());
 
+	// Honour the pick made ahead of time by predict_next_track(), whose file
+	// is already prebuffered, unless the playlist changed underneath it.
+	if(predicted_track) {
+		auto iter = find_track(*predicted_track);
+		predicted_track.reset();
+
+		if(iter != current_track_list.end()) {
+			current_track_index = iter - current_track_list.begin();
+
+			DBG_AUDIO << "Next track will be " << (*iter)->file_path() << " (predicted)\n";
+			played_before.push_back((*iter)->file_path());
+			return *iter;
+		}
+	}
+
 	if(current_track_index >= current_track_list.size()) {
 		current_track_index = 0;
 	}
@@ -639,6 +665,62 @@ void play_track(unsigned int i)
 	play_music();
 }
 
+/** Opens and prebuffers @a file_path into the music cache on a throwaway worker. */
+static void preload_music_async(const std::string& file_path)
+{
+	const std::string localized = filesystem::get_localized_path(file_path);
+	const std::string filename = localized.empty() ? file_path : localized;
+
+	if(music_cache.count(filename) != 0 || music_preloads_pending.count(filename) != 0) {
+		return;
+	}
+
+	music_preloads_pending.insert(filename);
+
+	// Only the file open and decoder setup happen off-thread; the cache is
+	// touched from the main thread again through the events queue.
+	std::thread([filename]() {
+		filesystem::rwops_ptr rwops = filesystem::make_read_RWops(filename);
+		// SDL takes ownership of rwops
+		std::shared_ptr<Mix_Music> music(Mix_LoadMUSType_RW(rwops.release(), MUS_NONE, true), &Mix_FreeMusic);
+		const std::string error = music == nullptr ? Mix_GetError() : "";
+
+		events::call_in_main_thread([filename, music, error]() {
+			music_preloads_pending.erase(filename);
+			if(music != nullptr) {
+				music_cache.emplace(filename, music);
+			} else {
+				ERR_AUDIO << "Could not prebuffer music file '" << filename << "': " << error << "\n";
+			}
+		});
+	}).detach();
+}
+
+/**
+ * Picks the track the next switchover is expected to use and starts loading
+ * its file in the background, so that play_new_music() finds it already in
+ * the cache and the transition neither gaps nor hitches the main thread.
+ */
+static void predict_next_track()
+{
+	if(predicted_track || current_track_list.empty() || !preferences::music_on() || !mix_ok) {
+		return;
+	}
+
+	// Mirror choose_track()'s selection without committing its bookkeeping;
+	// the pick only enters played_before once it actually plays.
+	unsigned int index = current_track_index >= current_track_list.size() ? 0 : current_track_index;
+
+	if(current_track_list[index]->shuffle() && current_track_list.size() > 1) {
+		do {
+			index = randomness::rng::default_instance().get_random_int(0, current_track_list.size() - 1);
+		} while(!track_ok(current_track_list[index]->file_path()));
+	}
+
+	predicted_track = current_track_list[index];
+	preload_music_async(predicted_track->file_path());
+}
+
 static void play_new_music()
 {
 	music_start_time = 0; // reset status: no start time
@@ -679,6 +761,9 @@ static void play_new_music()
 	}
 
 	want_new_music = false;
+
+	// Line up and prebuffer the expected next track while this one plays.
+	predict_next_track();
 }
 
 void play_music_repeatedly(const std::string& id)
@@ -1026,6 +1111,23 @@ void play_sound(const std::string& files, channel_group group, unsigned int repe
 	}
 }
 
+void preload_sound(const std::string& files)
+{
+	if(files.empty() || !mix_ok || !preferences::sound_on()) {
+		return;
+	}
+
+	audio_lock lock;
+
+	for(const std::string& file : utils::square_parenthetical_split(files, ',', "[", "]")) {
+		try {
+			load_chunk(file, NULL_CHANNEL);
+		} catch(const chunk_load_exception&) {
+			// Missing files were already logged; playing will retry anyway.
+		}
+	}
+}
+
 void play_sound_positioned(const std::string& files, int id, int repeats, unsigned int distance)
 {
 	if(preferences::sound_on()) {
@@ -84,6 +84,10 @@ void stop_sound(int id);
 // Play sound, or random one of comma-separated sounds.
 void play_sound(const std::string& files, channel_group group = SOUND_FX, unsigned int repeats = 0);
 
+// Decode all of the comma-separated sounds into the chunk cache without
+// playing them, so the first real play doesn't hitch on disk and decode.
+void preload_sound(const std::string& files);
+
 // Play sound, or random one of comma-separated sounds. Use specified
 // distance and associate it with specified id (of a sound source).
 void play_sound_positioned(const std::string &files, int id, int repeats, unsigned int distance);
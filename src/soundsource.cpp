@@ -21,17 +21,40 @@
 
 #include <SDL2/SDL_timer.h>
 
+#include <algorithm>
+
 namespace soundsource {
 
 const unsigned DEFAULT_CHANCE           = 100;
 const unsigned DEFAULT_DELAY            = 1000;
 
+namespace {
+
+// Edge length of a spatial grid cell, in hexes.
+const int GRID_CELL_SIZE                = 8;
+
+// Period between play attempts while a source is audible but idle; matches
+// the documented "chance every second" semantics.
+const unsigned CHANCE_INTERVAL          = 1000;
+
+std::pair<int, int> grid_cell(const map_location& loc)
+{
+	// Shift before dividing so negative (off-map) coordinates round down.
+	return { (loc.x + 1000000) / GRID_CELL_SIZE, (loc.y + 1000000) / GRID_CELL_SIZE };
+}
+
+} // namespace
+
 unsigned int positional_source::last_id = 0;
 
 manager::manager(const display &disp) :
 	observer(),
 	sources_(),
-	disp_(disp)
+	disp_(disp),
+	grid_(),
+	max_audible_range_(0),
+	audible_(),
+	schedule_()
 {
 	disp_.scroll_event().attach_handler(this);
 	update_positions();
@@ -51,6 +74,63 @@ void manager::handle_generic_event(const std::string &event_name)
 void manager::add(const sourcespec &spec)
 {
 	sources_[spec.id()].reset(new positional_source(spec));
+	rebuild_grid();
+
+	positional_source& source = *sources_[spec.id()];
+	source.update_geometry(viewport_center());
+	if(source.is_audible() || source.is_global()) {
+		audible_.insert(&source);
+		schedule(source, SDL_GetTicks());
+	}
+}
+
+void manager::rebuild_grid()
+{
+	grid_.clear();
+	audible_.clear();
+	max_audible_range_ = 0;
+
+	for(positional_source_iterator it = sources_.begin(); it != sources_.end(); ++it) {
+		positional_source& source = *it->second;
+		source.set_queued(false);
+
+		if(source.is_global()) {
+			// Global sources are always audible; they bypass the grid.
+			audible_.insert(&source);
+			continue;
+		}
+
+		max_audible_range_ = std::max(max_audible_range_, source.max_range());
+
+		std::set<std::pair<int, int>> cells;
+		for(const map_location& loc : source.get_locations()) {
+			cells.insert(grid_cell(loc));
+		}
+
+		for(const std::pair<int, int>& cell : cells) {
+			grid_[cell].push_back(&source);
+		}
+
+		if(source.is_audible()) {
+			audible_.insert(&source);
+		}
+	}
+}
+
+map_location manager::viewport_center() const
+{
+	const SDL_Rect area = disp_.map_area();
+	return disp_.hex_clicked_on(area.x + area.w / 2, area.y + area.h / 2);
+}
+
+void manager::schedule(positional_source& source, unsigned int time)
+{
+	if(source.queued()) {
+		return;
+	}
+
+	source.set_queued(true);
+	schedule_.emplace(time, source.name());
 }
 
 sourcespec manager::get(const std::string &id)
@@ -71,6 +151,7 @@ void manager::remove(const std::string &id)
 		return;
 	else {
 		sources_.erase(it);
+		rebuild_grid();
 	}
 }
 
@@ -81,19 +162,62 @@ bool manager::contains(const std::string& id)
 
 void manager::update()
 {
-	unsigned int time = SDL_GetTicks();
+	const unsigned int time = SDL_GetTicks();
 
-	for(positional_source_iterator it = sources_.begin(); it != sources_.end(); ++it) {
-		(*it).second->update(time, disp_);
+	while(!schedule_.empty() && schedule_.top().first <= time) {
+		const std::string id = schedule_.top().second;
+		schedule_.pop();
+
+		positional_source_iterator it = sources_.find(id);
+		if(it == sources_.end()) {
+			// The source was removed or replaced after being queued.
+			continue;
+		}
+
+		positional_source& source = *it->second;
+		source.set_queued(false);
+
+		if(!source.is_global() && !source.is_audible()) {
+			// Dropped from the schedule; scrolling it back into range
+			// re-enters it through update_positions().
+			continue;
+		}
+
+		source.update(time, disp_);
+		schedule(source, source.next_due(time));
 	}
 }
 
 void manager::update_positions()
 {
-	unsigned int time = SDL_GetTicks();
+	const unsigned int time = SDL_GetTicks();
+	const map_location center = viewport_center();
+
+	// Everything audible before the scroll needs its volume refreshed (it may
+	// have just gone out of range), plus whatever the grid says is near the
+	// new center. Sources far from both viewports are not touched at all.
+	std::set<positional_source*> process = audible_;
+
+	const std::pair<int, int> center_cell = grid_cell(center);
+	const int cell_radius = max_audible_range_ / GRID_CELL_SIZE + 1;
+	for(int x = center_cell.first - cell_radius; x <= center_cell.first + cell_radius; ++x) {
+		for(int y = center_cell.second - cell_radius; y <= center_cell.second + cell_radius; ++y) {
+			const auto cell = grid_.find({x, y});
+			if(cell != grid_.end()) {
+				process.insert(cell->second.begin(), cell->second.end());
+			}
+		}
+	}
 
-	for(positional_source_iterator it = sources_.begin(); it != sources_.end(); ++it) {
-		(*it).second->update_positions(time, disp_);
+	audible_.clear();
+	for(positional_source* source : process) {
+		source->update_geometry(center);
+		source->update_positions(time, disp_);
+
+		if(source->is_audible() || source->is_global()) {
+			audible_.insert(source);
+			schedule(*source, time);
+		}
 	}
 }
 
@@ -119,7 +243,10 @@ positional_source::positional_source(const sourcespec &spec) :
 	check_fogged_(spec.check_fogged()),
 	check_shrouded_(spec.check_shrouded()),
 	files_(spec.files()),
-	locations_(spec.get_locations())
+	locations_(spec.get_locations()),
+	name_(spec.id()),
+	cached_volume_(DISTANCE_SILENT),
+	queued_(false)
 {
 	assert(range_ > 0);
 	assert(faderange_ > 0);
@@ -135,6 +262,40 @@ bool positional_source::is_global() const
 	return locations_.empty();
 }
 
+bool positional_source::is_audible() const
+{
+	return cached_volume_ < DISTANCE_SILENT;
+}
+
+void positional_source::update_geometry(const map_location &center)
+{
+	if(is_global()) {
+		cached_volume_ = 0;
+		return;
+	}
+
+	// Distance-only variant of calculate_volume(); the fog and shroud checks
+	// are left to the exact computation once this gate has been passed.
+	int best = DISTANCE_SILENT;
+	for(const map_location& loc : locations_) {
+		const int distance = distance_between(loc, center);
+		const int v = distance <= range_
+			? 0
+			: static_cast<int>(((distance - range_)
+					/ static_cast<double>(faderange_)) * DISTANCE_SILENT);
+		if(v < best) {
+			best = v;
+		}
+	}
+
+	cached_volume_ = best;
+}
+
+unsigned int positional_source::next_due(unsigned int time) const
+{
+	return std::max(time + CHANCE_INTERVAL, last_played_ + static_cast<unsigned>(min_delay_));
+}
+
 void positional_source::update(unsigned int time, const display &disp)
 {
 	if (time - last_played_ < static_cast<unsigned>(min_delay_) || sound::is_sound_playing(id_))
@@ -173,6 +334,14 @@ void positional_source::update_positions(unsigned int time, const display &disp)
 		return;
 	}
 
+	if(!is_audible()) {
+		// Too far away regardless of fog; silence it if it is still playing.
+		if(sound::is_sound_playing(id_)) {
+			sound::reposition_sound(id_, DISTANCE_SILENT);
+		}
+		return;
+	}
+
 	int distance_volume = DISTANCE_SILENT;
 	for(std::vector<map_location>::iterator i = locations_.begin(); i != locations_.end(); ++i) {
 		int v = calculate_volume(*i, disp);
@@ -16,6 +16,10 @@
 #pragma once
 
 #include <map>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "generic_event.hpp"
 #include "map/location.hpp"
@@ -46,6 +50,19 @@ class positional_source {
 	std::string files_;
 	std::vector<map_location> locations_;
 
+	/** The [sound_source] id this source was registered under. */
+	std::string name_;
+
+	/**
+	 * Distance-only volume against the last seen viewport center, ignoring
+	 * fog; see update_geometry(). Acts as a cheap audibility gate so silent
+	 * sources are skipped entirely between scroll events.
+	 */
+	int cached_volume_;
+
+	/** Whether an entry for this source sits in the manager's schedule. */
+	bool queued_;
+
 	// Last assigned id; this can, of course, overflow, but I'd
 	// never expect to see 4 billions sound sources being created...
 	static unsigned int last_id;
@@ -62,6 +79,25 @@ public:
 
 	bool is_global() const;
 
+	/** Whether the cached distance-only volume is above the silence cutoff. */
+	bool is_audible() const;
+
+	const std::string& name() const { return name_; }
+
+	const std::vector<map_location>& get_locations() const { return locations_; }
+
+	/** Hex distance at which this source fades out completely. */
+	int max_range() const { return range_ + faderange_; }
+
+	bool queued() const { return queued_; }
+	void set_queued(bool value) { queued_ = value; }
+
+	/** Recomputes the cached distance-only volume against @a center. */
+	void update_geometry(const map_location &center);
+
+	/** Earliest time the next play attempt can succeed or be retried. */
+	unsigned int next_due(unsigned int time) const;
+
 	void update(unsigned int time, const display &disp);
 	void update_positions(unsigned int time, const display &disp);
 
@@ -84,6 +120,38 @@ class manager : public events::observer
 	positional_source_map sources_;
 	const display &disp_;
 
+	/**
+	 * Coarse spatial grid over the sources' locations: grid cell -> the
+	 * sources with a location in that cell. Rebuilt when the source set
+	 * changes; lets scroll handling query only the viewport's surroundings.
+	 */
+	std::map<std::pair<int, int>, std::vector<positional_source*>> grid_;
+
+	/** Largest max_range() over the registered sources. */
+	int max_audible_range_;
+
+	/** Sources audible against the last seen viewport center. */
+	std::set<positional_source*> audible_;
+
+	/**
+	 * Play attempts scheduled by due time: (time, source id). Inaudible
+	 * sources are not requeued when popped; scrolling them back into range
+	 * re-enters them.
+	 */
+	std::priority_queue<std::pair<unsigned int, std::string>,
+			std::vector<std::pair<unsigned int, std::string>>,
+			std::greater<std::pair<unsigned int, std::string>>>
+			schedule_;
+
+	/** Rebuilds grid_ and max_audible_range_ and prunes stale pointers. */
+	void rebuild_grid();
+
+	/** The hex at the middle of the viewport. */
+	map_location viewport_center() const;
+
+	/** Queues a play attempt for @a source at @a time, once. */
+	void schedule(positional_source& source, unsigned int time);
+
 public:
 	manager(const display &disp);
 	~manager();
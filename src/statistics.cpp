@@ -60,8 +60,20 @@ struct scenario_stats
 	config write() const;
 	void write(config_writer &out) const;
 
+	/**
+	 * Serialized form of a completed scenario's stats. Only the last entry
+	 * of master_stats ever changes, so everything before it is converted to
+	 * the save format once and the result replayed into every later save,
+	 * instead of rebuilding megabytes of campaign history each autosave.
+	 */
+	const config& cached_write() const;
+	void invalidate_write_cache() { write_cache_.clear(); }
+
 	team_stats_t team_stats;
 	std::string scenario_name;
+
+private:
+	mutable config write_cache_;
 };
 
 scenario_stats::scenario_stats(const config& cfg) :
@@ -84,6 +96,15 @@ config scenario_stats::write() const
 	return res;
 }
 
+const config& scenario_stats::cached_write() const
+{
+	if(write_cache_.empty()) {
+		write_cache_ = write();
+	}
+
+	return write_cache_;
+}
+
 void scenario_stats::write(config_writer &out) const
 {
 	out.write_key_val("scenario", scenario_name);
@@ -752,8 +773,14 @@ config write_stats()
 	config res;
 	res["mid_scenario"] = mid_scenario;
 
-	for(std::vector<scenario_stats>::const_iterator i = master_stats.begin(); i != master_stats.end(); ++i) {
-		res.add_child("scenario",i->write());
+	// Only the current scenario's stats can still change; past scenarios
+	// are serialized once and the cached form reused.
+	for(std::size_t i = 0; i != master_stats.size(); ++i) {
+		if(i + 1 != master_stats.size()) {
+			res.add_child("scenario", master_stats[i].cached_write());
+		} else {
+			res.add_child("scenario", master_stats[i].write());
+		}
 	}
 
 	return res;
@@ -763,9 +790,15 @@ void write_stats(config_writer &out)
 {
 	out.write_key_val("mid_scenario", mid_scenario);
 
-	for(std::vector<scenario_stats>::const_iterator i = master_stats.begin(); i != master_stats.end(); ++i) {
+	// Only the current scenario's stats can still change; past scenarios
+	// are serialized once and the cached form reused.
+	for(std::size_t i = 0; i != master_stats.size(); ++i) {
 		out.open_child("scenario");
-		i->write(out);
+		if(i + 1 != master_stats.size()) {
+			out.write(master_stats[i].cached_write());
+		} else {
+			master_stats[i].write(out);
+		}
 		out.close_child("scenario");
 	}
 }
@@ -791,6 +824,12 @@ void clear_current_scenario()
 	if(master_stats.empty() == false) {
 		master_stats.pop_back();
 		mid_scenario = false;
+
+		// The previous scenario becomes the mutable tail again; its cached
+		// serialized form can no longer be trusted.
+		if(!master_stats.empty()) {
+			master_stats.back().invalidate_write_cache();
+		}
 	}
 }
 
@@ -69,12 +69,30 @@ bool synced_checkup::local_checkup(const config& expected_data, config& real_dat
 		//copying objects :o
 		real_data = buffer_.child("result",pos_);
 		pos_ ++;
+		if(real_data.has_attribute("digest")) {
+			// New-style entry: only a digest of the original result was
+			// recorded. The original data is gone, so dump our side of the
+			// comparison for diagnosis before reporting the mismatch.
+			const bool matches = real_data["digest"] == expected_data.hash();
+			if(!matches) {
+				ERR_REPLAY << "digest mismatch, we calculated:\n"
+					<< expected_data.debug()
+					<< "which hashes to " << expected_data.hash()
+					<< " instead of the recorded " << real_data["digest"] << "\n";
+			}
+			return matches;
+		}
+		// Entry written by an older version with the full result config.
 		return real_data == expected_data;
 	}
 	else
 	{
 		assert(buffer_.child_count("result") == pos_);
-		buffer_.add_child("result", expected_data);
+		// Store a fixed-size digest instead of the result itself; this keeps
+		// the replay size independent of the result size and makes the replay
+		// side of the comparison a string compare instead of a deep config
+		// compare.
+		buffer_.add_child("result", config{"digest", expected_data.hash()});
 		pos_++;
 		return true;
 	}
@@ -27,12 +27,14 @@
 #include "game_events/pump.hpp"
 #include "lexical_cast.hpp"
 #include "map/map.hpp"
+#include "picture.hpp"
 #include "play_controller.hpp"
 #include "playsingle_controller.hpp"
 #include "preferences/game.hpp"
 #include "resources.hpp"
 #include "serialization/string_utils.hpp"
 #include "synced_context.hpp"
+#include "units/abilities.hpp"
 #include "units/types.hpp"
 #include "whiteboard/side_actions.hpp"
 
@@ -469,11 +471,24 @@ void team::lose_village(const map_location& loc)
 	villages_.erase(vil);
 }
 
+// Start decoding a recruitable unit type's sprite in the background, so the
+// first render after recruiting doesn't hitch on image loading.
+static void prefetch_recruit_image(const std::string& type_id)
+{
+	if(const unit_type* t = unit_types.find(type_id, unit_type::CREATED)) {
+		image::prefetch_image(t->image());
+	}
+}
+
 void team::set_recruits(const std::set<std::string>& recruits)
 {
 	info_.can_recruit = recruits;
 	info_.minimum_recruit_price = 0;
 	ai::manager::get_singleton().raise_recruit_list_changed();
+
+	for(const std::string& recruit : recruits) {
+		prefetch_recruit_image(recruit);
+	}
 }
 
 void team::add_recruit(const std::string& recruit)
@@ -481,6 +496,8 @@ void team::add_recruit(const std::string& recruit)
 	info_.can_recruit.insert(recruit);
 	info_.minimum_recruit_price = 0;
 	ai::manager::get_singleton().raise_recruit_list_changed();
+
+	prefetch_recruit_image(recruit);
 }
 
 int team::minimum_recruit_price() const
@@ -626,6 +643,10 @@ void team::change_team(const std::string& name, const t_string& user_name)
 	}
 
 	clear_caches();
+
+	// Diplomacy decides which adjacent auras apply (affect_allies vs
+	// affect_enemies), so cached ability aggregates are stale now.
+	unit_abilities::invalidate_cache();
 }
 
 void team::clear_caches()
@@ -637,6 +658,9 @@ void team::clear_caches()
 			t.ally_shroud_.clear();
 			t.ally_fog_.clear();
 		}
+
+		// Alliance and vision sharing changes alter what each side can see.
+		shroud_map::bump_vision_generation();
 	}
 }
 
@@ -753,6 +777,8 @@ void team::remove_fog_override(const std::set<map_location>& hexes)
 	// Put the result into fog_clearer_.
 	fog_clearer_.clear();
 	fog_clearer_.insert(result.begin(), result_end);
+
+	shroud_map::bump_vision_generation();
 }
 
 void validate_side(int side)
@@ -766,17 +792,41 @@ void validate_side(int side)
 	}
 }
 
+std::size_t shroud_map::vision_generation_ = 0;
+
 int shroud_map::width() const
 {
-	return data_.size();
+	return width_;
 }
 
 int shroud_map::height() const
 {
-	if(data_.size() == 0) return 0;
-	return std::max_element(data_.begin(), data_.end(), [](const auto& a, const auto& b) {
-		return a.size() < b.size();
-	})->size();
+	if(col_height_.empty()) return 0;
+	return *std::max_element(col_height_.begin(), col_height_.end());
+}
+
+void shroud_map::ensure(int x, int y)
+{
+	// Grow the per-column block count first, re-packing the existing
+	// columns. This happens at most once per block_bits rows, so the
+	// amortized cost is negligible.
+	const int word = y / block_bits;
+	if(word >= stride_) {
+		const int new_stride = word + 1;
+		std::vector<std::uint64_t> new_data(width_ * new_stride, 0);
+		for(int col = 0; col < width_; ++col) {
+			std::copy_n(data_.begin() + col * stride_, stride_,
+			            new_data.begin() + col * new_stride);
+		}
+		data_.swap(new_data);
+		stride_ = new_stride;
+	}
+
+	if(x >= width_) {
+		data_.resize((x + 1) * stride_, 0);
+		col_height_.resize(x + 1, 0);
+		width_ = x + 1;
+	}
 }
 
 bool shroud_map::clear(int x, int y)
@@ -785,16 +835,16 @@ bool shroud_map::clear(int x, int y)
 		return false;
 	}
 
-	if(x >= static_cast<int>(data_.size())) {
-		data_.resize(x + 1);
-	}
-
-	if(y >= static_cast<int>(data_[x].size())) {
-		data_[x].resize(y + 1);
+	ensure(x, y);
+	if(col_height_[x] < y + 1) {
+		col_height_[x] = y + 1;
 	}
 
-	if(data_[x][y] == false) {
-		data_[x][y] = true;
+	std::uint64_t& block = data_[x * stride_ + y / block_bits];
+	const std::uint64_t mask = std::uint64_t(1) << (y % block_bits);
+	if((block & mask) == 0) {
+		block |= mask;
+		bump_vision_generation();
 		return true;
 	}
 
@@ -807,14 +857,15 @@ void shroud_map::place(int x, int y)
 		return;
 	}
 
-	if(x >= static_cast<int>(data_.size())) {
+	if(x >= width_) {
 		DBG_NG << "Couldn't place shroud on invalid x coordinate: (" << x << ", " << y
-			   << ") - max x: " << data_.size() - 1 << "\n";
-	} else if(y >= static_cast<int>(data_[x].size())) {
+			   << ") - max x: " << width_ - 1 << "\n";
+	} else if(y >= col_height_[x]) {
 		DBG_NG << "Couldn't place shroud on invalid y coordinate: (" << x << ", " << y
-			   << ") - max y: " << data_[x].size() - 1 << "\n";
+			   << ") - max y: " << col_height_[x] - 1 << "\n";
 	} else {
-		data_[x][y] = false;
+		data_[x * stride_ + y / block_bits] &= ~(std::uint64_t(1) << (y % block_bits));
+		bump_vision_generation();
 	}
 }
 
@@ -824,9 +875,8 @@ void shroud_map::reset()
 		return;
 	}
 
-	for(auto& i : data_) {
-		std::fill(i.begin(), i.end(), false);
-	}
+	std::fill(data_.begin(), data_.end(), 0);
+	bump_vision_generation();
 }
 
 bool shroud_map::value(int x, int y) const
@@ -836,17 +886,17 @@ bool shroud_map::value(int x, int y) const
 	}
 
 	// Locations for which we have no data are assumed to still be covered.
-	if(x < 0 || x >= static_cast<int>(data_.size())) {
+	if(x < 0 || x >= width_) {
 		return true;
 	}
 
-	if(y < 0 || y >= static_cast<int>(data_[x].size())) {
+	if(y < 0 || y / block_bits >= stride_) {
 		return true;
 	}
 
 	// data_ stores whether or not a location has been cleared, while
 	// we want to return whether or not a location is covered.
-	return !data_[x][y];
+	return !test(x, y);
 }
 
 bool shroud_map::shared_value(const std::vector<const shroud_map*>& maps, int x, int y) const
@@ -873,11 +923,11 @@ bool shroud_map::shared_value(const std::vector<const shroud_map*>& maps, int x,
 std::string shroud_map::write() const
 {
 	std::stringstream shroud_str;
-	for(const auto& sh : data_) {
+	for(int x = 0; x < width_; ++x) {
 		shroud_str << '|';
 
-		for(bool i : sh) {
-			shroud_str << (i ? '1' : '0');
+		for(int y = 0; y < col_height_[x]; ++y) {
+			shroud_str << (test(x, y) ? '1' : '0');
 		}
 
 		shroud_str << '\n';
@@ -888,21 +938,30 @@ std::string shroud_map::write() const
 
 void shroud_map::read(const std::string& str)
 {
+	width_ = 0;
+	stride_ = 0;
 	data_.clear();
+	col_height_.clear();
 
+	int x = -1, y = 0;
 	for(const char sh : str) {
 		if(sh == '|') {
-			data_.resize(data_.size() + 1);
+			++x;
+			y = 0;
+			ensure(x, 0);
 		}
 
-		if(data_.empty() == false) {
+		if(x >= 0 && (sh == '1' || sh == '0')) {
+			ensure(x, y);
 			if(sh == '1') {
-				data_.back().push_back(true);
-			} else if(sh == '0') {
-				data_.back().push_back(false);
+				data_[x * stride_ + y / block_bits] |= std::uint64_t(1) << (y % block_bits);
 			}
+			col_height_[x] = y + 1;
+			++y;
 		}
 	}
+
+	bump_vision_generation();
 }
 
 void shroud_map::merge(const std::string& str)
@@ -929,20 +988,33 @@ bool shroud_map::copy_from(const std::vector<const shroud_map*>& maps)
 
 	bool cleared = false;
 	for(const shroud_map* m : maps) {
-		if(m->enabled_ == false) {
+		if(m->enabled_ == false || m->width_ == 0 || m->stride_ == 0) {
 			continue;
 		}
 
-		const std::vector<std::vector<bool>>& v = m->data_;
-		for(std::size_t x = 0; x != v.size(); ++x) {
-			for(std::size_t y = 0; y != v[x].size(); ++y) {
-				if(v[x][y]) {
-					cleared |= clear(x, y);
+		// Make sure our storage covers the source, then merge the cleared
+		// bits a block at a time.
+		ensure(m->width_ - 1, m->stride_ * block_bits - 1);
+		for(int x = 0; x < m->width_; ++x) {
+			const std::uint64_t* src = &m->data_[x * m->stride_];
+			std::uint64_t* dst = &data_[x * stride_];
+			for(int w = 0; w < m->stride_; ++w) {
+				const std::uint64_t gained = src[w] & ~dst[w];
+				if(gained) {
+					dst[w] |= gained;
+					cleared = true;
 				}
 			}
+			if(col_height_[x] < m->col_height_[x]) {
+				col_height_[x] = m->col_height_[x];
+			}
 		}
 	}
 
+	if(cleared) {
+		bump_vision_generation();
+	}
+
 	return cleared;
 }
 
@@ -38,9 +38,17 @@ namespace wb {
 	class side_actions;
 }
 
+/**
+ * Per-team visibility map (used for both shroud and fog).
+ *
+ * The cleared bits are packed into 64-bit blocks, stored column-major to
+ * match the '|'-separated column format used by write() and read(). This
+ * lets reset() and copy_from() work a word at a time instead of hex by hex,
+ * which matters when shared vision merges several allies' maps.
+ */
 class shroud_map {
 public:
-	shroud_map() : enabled_(false), data_() {}
+	shroud_map() : enabled_(false), width_(0), stride_(0), data_(), col_height_() {}
 
 	void place(int x, int y);
 	bool clear(int x, int y);
@@ -56,13 +64,54 @@ public:
 	void merge(const std::string& shroud_data);
 
 	bool enabled() const { return enabled_; }
-	void set_enabled(bool enabled) { enabled_ = enabled; }
+	void set_enabled(bool enabled)
+	{
+		if(enabled != enabled_) {
+			enabled_ = enabled;
+			bump_vision_generation();
+		}
+	}
 
 	int width() const;
 	int height() const;
+
+	/**
+	 * Monotonically increasing counter, bumped whenever any side's shroud or
+	 * fog data changes — including fog overrides and alliance changes, see
+	 * team::add_fog_override() and team::clear_caches(). Lets the display
+	 * cache per-hex visibility instead of re-running the fog logic for every
+	 * hex on every frame.
+	 */
+	static std::size_t vision_generation() { return vision_generation_; }
+
+	/** See vision_generation(). */
+	static void bump_vision_generation() { ++vision_generation_; }
+
 private:
+	/** Number of bits each 64-bit block holds. */
+	static constexpr int block_bits = 64;
+
+	/** Grows the storage so that the bit for (x, y) exists. */
+	void ensure(int x, int y);
+
+	/** Returns whether the cleared bit for (x, y) is set (no bounds checks). */
+	bool test(int x, int y) const
+	{
+		return (data_[x * stride_ + y / block_bits] >> (y % block_bits)) & 1;
+	}
+
 	bool enabled_;
-	std::vector<std::vector<bool>> data_;
+	/** Number of columns with data. */
+	int width_;
+	/** Number of blocks allocated per column. */
+	int stride_;
+	/** The cleared bits; bit y of column x lives in data_[x * stride_ + y / block_bits]. */
+	std::vector<std::uint64_t> data_;
+	/** Per-column data height, preserving the ragged extents of the save format. */
+	std::vector<int> col_height_;
+
+	/** See vision_generation(). */
+	static std::size_t vision_generation_;
 };
 
 /**
@@ -344,7 +393,11 @@ public:
 
 	bool knows_about_team(std::size_t index) const;
 	/** Records hexes that were cleared of fog via WML. */
-	void add_fog_override(const std::set<map_location> &hexes) { fog_clearer_.insert(hexes.begin(), hexes.end()); }
+	void add_fog_override(const std::set<map_location> &hexes)
+	{
+		fog_clearer_.insert(hexes.begin(), hexes.end());
+		shroud_map::bump_vision_generation();
+	}
 	/** Removes the record of hexes that were cleared of fog via WML. */
 	void remove_fog_override(const std::set<map_location> &hexes);
 
@@ -27,6 +27,10 @@
 #include "preferences/game.hpp"
 #include "serialization/string_utils.hpp"
 #include "game_config_view.hpp"
+#include "utils/frame_profiler.hpp"
+
+#include <algorithm>
+#include <unordered_set>
 
 static lg::log_domain log_engine("engine");
 #define ERR_NG LOG_STREAM(err, log_engine)
@@ -265,6 +269,8 @@ terrain_builder::terrain_builder(const config& level, const gamemap* m, const st
 	// parse local rules
 	parse_config(level);
 
+	build_rule_index();
+
 	if(m)
 		build_terrains();
 }
@@ -1136,9 +1142,51 @@ unsigned int terrain_builder::building_rule::get_hash() const
 	return hash_;
 }
 
+bool terrain_builder::is_exact_match(const t_translation::ter_match& match)
+{
+	if(match.has_wildcard || match.is_empty) {
+		return false;
+	}
+
+	return std::find(match.terrain.begin(), match.terrain.end(), t_translation::NOT) == match.terrain.end();
+}
+
+void terrain_builder::build_rule_index()
+{
+	rules_by_terrain_.clear();
+	unindexed_rules_.clear();
+
+	for(const building_rule& rule : building_rules_) {
+		// Register the rule under its smallest plain-list constraint; the
+		// rule can only ever match a map containing one of those codes.
+		const terrain_constraint* probe = nullptr;
+
+		for(const terrain_constraint& constraint : rule.constraints) {
+			if(!is_exact_match(constraint.terrain_types_match)) {
+				continue;
+			}
+
+			if(probe == nullptr
+					|| constraint.terrain_types_match.terrain.size() < probe->terrain_types_match.terrain.size()) {
+				probe = &constraint;
+			}
+		}
+
+		if(probe == nullptr) {
+			unindexed_rules_.push_back(&rule);
+			continue;
+		}
+
+		for(const t_translation::terrain_code& t : probe->terrain_types_match.terrain) {
+			rules_by_terrain_.emplace(t, &rule);
+		}
+	}
+}
+
 void terrain_builder::build_terrains()
 {
 	log_scope("terrain_builder::build_terrains");
+	PROFILE_ZONE("terrain_builder::build_terrains");
 
 	// Builds the terrain_by_type_ cache
 	for(int x = -2; x <= map().w(); ++x) {
@@ -1158,7 +1206,24 @@ void terrain_builder::build_terrains()
 		}
 	}
 
+	// Gather the rules which can match terrain actually present on this map.
+	// Rules indexed only under absent terrain codes are skipped without ever
+	// touching their constraints, which on typical maps removes most of the
+	// rule set from the per-rule matching pass below.
+	std::unordered_set<const building_rule*> active_rules(unindexed_rules_.begin(), unindexed_rules_.end());
+
+	for(const terrain_by_type_map::value_type& type_entry : terrain_by_type_) {
+		const auto range = rules_by_terrain_.equal_range(type_entry.first);
+		for(auto rule_it = range.first; rule_it != range.second; ++rule_it) {
+			active_rules.insert(rule_it->second);
+		}
+	}
+
 	for(const building_rule& rule : building_rules_) {
+		if(active_rules.find(&rule) == active_rules.end()) {
+			continue;
+		}
+
 		// Find the constraint that contains the less terrain of all terrain rules.
 		// We will keep a track of the matching terrains of this constraint
 		// and later try to apply the rule only on them
@@ -1174,17 +1239,39 @@ void terrain_builder::build_terrains()
 			t_translation::ter_list matching_types;
 			std::size_t constraint_size = 0;
 
-			for(terrain_by_type_map::iterator type_it = terrain_by_type_.begin(); type_it != terrain_by_type_.end();
-					++type_it) {
-				const t_translation::terrain_code t = type_it->first;
-				if(terrain_matches(t, match)) {
-					const std::size_t match_size = type_it->second.size();
-					constraint_size += match_size;
+			if(is_exact_match(match)) {
+				// A plain list can be intersected with the terrain present on
+				// the map directly, instead of probing every terrain type
+				// against the match structure.
+				for(const t_translation::terrain_code& t : match.terrain) {
+					const terrain_by_type_map::const_iterator type_it = terrain_by_type_.find(t);
+					if(type_it == terrain_by_type_.end()) {
+						continue;
+					}
+
+					if(std::find(matching_types.begin(), matching_types.end(), t) != matching_types.end()) {
+						continue;
+					}
+
+					constraint_size += type_it->second.size();
 					if(constraint_size >= min_size) {
 						break; // not a minimum, bail out
 					}
 					matching_types.push_back(t);
 				}
+			} else {
+				for(terrain_by_type_map::iterator type_it = terrain_by_type_.begin(); type_it != terrain_by_type_.end();
+						++type_it) {
+					const t_translation::terrain_code t = type_it->first;
+					if(terrain_matches(t, match)) {
+						const std::size_t match_size = type_it->second.size();
+						constraint_size += match_size;
+						if(constraint_size >= min_size) {
+							break; // not a minimum, bail out
+						}
+						matching_types.push_back(t);
+					}
+				}
 			}
 
 			if(constraint_size < min_size) {
@@ -1214,6 +1301,29 @@ void terrain_builder::build_terrains()
 			}
 		}
 	}
+
+	// Queue every image the applied rules can draw for background decoding,
+	// so the first draw of the map finds them already in the cache instead
+	// of hitting the disk hex by hex.
+	std::unordered_set<std::string> prefetched;
+	for(int x = -2; x <= map().w(); ++x) {
+		for(int y = -2; y <= map().h(); ++y) {
+			const tile& btile = tile_map_[map_location(x, y)];
+
+			for(const tile::rule_image_rand& ri : btile.images) {
+				for(const rule_image_variant& variant : ri.ri->variants) {
+					for(const animated<image::locator>& img : variant.images) {
+						for(std::size_t i = 0; i < img.get_frames_count(); ++i) {
+							const std::string& name = img.get_frame(i).get_filename();
+							if(prefetched.insert(name).second) {
+								image::prefetch_image(name);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
 }
 
 terrain_builder::tile* terrain_builder::get_tile(const map_location& loc)
@@ -834,6 +834,23 @@ private:
 	 */
 	void build_terrains();
 
+	/**
+	 * Returns whether @a match boils down to a plain list of terrain codes,
+	 * without wildcards or inversions, so that its matching terrain types can
+	 * be looked up directly instead of probing every type on the map.
+	 */
+	static bool is_exact_match(const t_translation::ter_match& match);
+
+	/**
+	 * (Re)builds rules_by_terrain_ and unindexed_rules_ from building_rules_.
+	 *
+	 * Each rule is registered under the terrain codes of its smallest
+	 * plain-list constraint; build_terrains() then only considers the rules
+	 * registered for terrain codes actually present on the map, instead of
+	 * scanning the whole rule set per map rebuild.
+	 */
+	void build_rule_index();
+
 	/**
 	 * A pointer to the gamemap class used in the current level.
 	 */
@@ -859,6 +876,15 @@ private:
 	/** Whether the map border should be drawn. */
 	bool draw_border_;
 
+	/**
+	 * Index of the building rules by the exact terrain codes their smallest
+	 * plain-list constraint can match, see build_rule_index().
+	 */
+	std::multimap<t_translation::terrain_code, const building_rule*> rules_by_terrain_;
+
+	/** Rules which cannot be indexed by terrain code and are always considered. */
+	std::vector<const building_rule*> unindexed_rules_;
+
 	/** Parsed terrain rules. Cached between instances */
 	static building_ruleset building_rules_;
 
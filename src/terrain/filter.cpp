@@ -91,7 +91,9 @@ terrain_filter::terrain_filter_cache::terrain_filter_cache() :
 	parsed_terrain(nullptr),
 	adjacent_matches(nullptr),
 	adjacent_match_cache(),
-	ufilter_()
+	ufilter_(),
+	matching_locs(nullptr),
+	compound_filters(nullptr)
 {}
 
 bool terrain_filter::match_internal(const map_location& loc, const unit* ref_unit, const bool ignore_xy) const
@@ -156,14 +158,16 @@ bool terrain_filter::match_internal(const map_location& loc, const unit* ref_uni
 			}
 		}
 		if (cfg_.has_attribute("location_id")) {
-			std::set<map_location> matching_locs;
-			for(const auto& id : utils::split(cfg_["location_id"])) {
-				map_location test_loc = fc_->get_disp_context().map().special_location(id);
-				if(test_loc.valid()) {
-					matching_locs.insert(test_loc);
+			if(cache_.matching_locs == nullptr) {
+				cache_.matching_locs.reset(new std::set<map_location>());
+				for(const auto& id : utils::split(cfg_["location_id"])) {
+					map_location test_loc = fc_->get_disp_context().map().special_location(id);
+					if(test_loc.valid()) {
+						cache_.matching_locs->insert(test_loc);
+					}
 				}
 			}
-			if (matching_locs.count(loc) == 0) {
+			if (cache_.matching_locs->count(loc) == 0) {
 				return false;
 			}
 		}
@@ -407,24 +411,35 @@ bool terrain_filter::match_impl(const map_location& loc, const unit* ref_unit) c
 		get_tiles_radius(fc_->get_disp_context().map(), loc_vec, radius, hexes);
 	}
 
+	// Compile the [and]/[or]/[not] children once; constructing them per
+	// location would throw away their parsed caches on every hex.
+	if(cache_.compound_filters == nullptr) {
+		cache_.compound_filters.reset(new std::vector<std::pair<std::string, terrain_filter>>());
+		for(const auto& [key, filter] : cfg_.all_ordered()) {
+			if(key == "and" || key == "or" || key == "not") {
+				cache_.compound_filters->emplace_back(key, terrain_filter(filter.make_safe(), *this));
+			}
+		}
+	}
+
 	std::size_t loop_count = 0;
 	std::set<map_location>::const_iterator i;
 	for(i = hexes.begin(); i != hexes.end(); ++i) {
 		bool matches = match_internal(*i, ref_unit, false);
 
 		// Handle [and], [or], and [not] with in-order precedence
-		for(const auto& [key, filter] : cfg_.all_ordered()) {
+		for(const auto& [key, filter] : *cache_.compound_filters) {
 			// Handle [and]
 			if(key == "and") {
-				matches = matches && terrain_filter(filter, *this).match_impl(*i, ref_unit);
+				matches = matches && filter.match_impl(*i, ref_unit);
 			}
 			// Handle [or]
 			else if(key == "or") {
-				matches = matches || terrain_filter(filter, *this).match_impl(*i, ref_unit);
+				matches = matches || filter.match_impl(*i, ref_unit);
 			}
 			// Handle [not]
 			else if(key == "not") {
-				matches = matches && !terrain_filter(filter, *this).match_impl(*i, ref_unit);
+				matches = matches && !filter.match_impl(*i, ref_unit);
 			}
 		}
 
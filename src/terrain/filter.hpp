@@ -100,6 +100,14 @@ private:
 		std::vector< std::pair<terrain_filter, std::map<map_location,bool>>> adjacent_match_cache;
 
 		std::unique_ptr<unit_filter> ufilter_;
+
+		//matching_locs: locations named by location_id=, resolved once
+		std::unique_ptr<std::set<map_location>> matching_locs;
+
+		//compound_filters: compiled [and]/[or]/[not] children in WML order, so
+		//match() over many locations reuses their parsed caches instead of
+		//re-interpreting each subtree's vconfig per location
+		std::unique_ptr<std::vector<std::pair<std::string, terrain_filter>>> compound_filters;
 	};
 
 	mutable terrain_filter_cache cache_;
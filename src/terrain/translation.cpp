@@ -28,6 +28,9 @@
 #include "utils/iterable_pair.hpp" //equal_range returns a std:pair instead of sometihng iterable for some reason.
 #include "wml_exception.hpp"
 
+#include <future>
+#include <thread>
+
 
 #define ERR_G LOG_STREAM(err, lg::general())
 #define WRN_G LOG_STREAM(warn, lg::general())
@@ -293,7 +296,6 @@ static std::pair<int, int> get_map_size(const char* begin, const char* end)
 ter_map read_game_map(std::string_view str, starting_positions& starting_positions, coordinate border_offset)
 {
 	std::size_t offset = 0;
-	int x = 0, y = 0, width = 0;
 
 	// Skip the leading newlines
 	while(!str.empty() && utils::isnewline(str.front())) {
@@ -307,82 +309,105 @@ ter_map read_game_map(std::string_view str, starting_positions& starting_positio
 
 	auto map_size = get_map_size(&str[0], &str[0] + str.size());
 	ter_map result(map_size.first, map_size.second);
+	const int width = result.w;
 
-	while(offset < str.length()) {
-
-		// Get a terrain chunk
-		const std::string separators = ",\n\r";
-		const std::size_t pos_separator = str.find_first_of(separators, offset);
-		std::string_view terrain = str.substr(offset, pos_separator - offset);
+	if(result.h - 1 > max_map_size()) {
+		ERR_G << "Map size exceeds limit (y > " << max_map_size() << ")" << std::endl;
+		throw error("Map height limit exceeded.");
+	}
 
-		// Process the chunk
-		std::vector<std::string> sp;
-		// The gamemap never has a wildcard
-		const terrain_code tile = string_to_number_(terrain, sp, NO_LAYER);
-
-		// Add to the resulting starting position
-		for(const auto& starting_position : sp) {
-			if (starting_positions.left.find(starting_position) != starting_positions.left.end()) {
-				WRN_G << "Starting position " << starting_position << " is redefined." << std::endl;
-			}
-			starting_positions.insert(starting_positions::value_type(starting_position, coordinate(x - border_offset.x, y - border_offset.y)));
+	// Cut the data into one view per row, so each row can be parsed
+	// independently. Runs of newlines are collapsed, matching get_map_size().
+	std::vector<std::string_view> lines;
+	lines.reserve(result.h);
+	while(offset < str.length()) {
+		std::size_t eol = str.find_first_of("\n\r", offset);
+		if(eol == std::string_view::npos) {
+			eol = str.length();
 		}
-
-		if(result.w <= x || result.h <= y) {
-			throw error("Map not a rectangle.");
+		lines.push_back(str.substr(offset, eol - offset));
+		offset = eol;
+		while(offset < str.length() && utils::isnewline(str[offset])) {
+			++offset;
 		}
+	}
 
-		// Add the resulting terrain number
-		result.get(x, y) = tile;
+	// Starting positions found by each row, merged into the bimap afterwards
+	// in row order so redefinition warnings stay deterministic.
+	std::vector<std::vector<std::pair<std::string, coordinate>>> found_positions(lines.size());
 
-		// Evaluate the separator
-		if(pos_separator == std::string::npos || utils::isnewline(str[pos_separator])) {
-			// the first line we set the with the other lines we check the width
-			if(y == 0) {
-				// x contains the offset in the map
-				width = x + 1;
-			} else {
-				if((x + 1) != width ) {
+	auto parse_rows = [&](std::size_t y_begin, std::size_t y_end) {
+		for(std::size_t row = y_begin; row < y_end; ++row) {
+			const std::string_view line = lines[row];
+			const int y = static_cast<int>(row);
+			int x = 0;
+			std::size_t pos = 0;
+
+			while(true) {
+				// Get a terrain chunk
+				const std::size_t pos_separator = line.find(',', pos);
+				std::string_view terrain = line.substr(pos, pos_separator - pos);
+
+				if(x >= width) {
 					ERR_G << "Map not a rectangle error occurred at line offset " << y << " position offset " << x << std::endl;
 					throw error("Map not a rectangle.");
 				}
-				if (y > max_map_size()) {
-					ERR_G << "Map size exceeds limit (y > " << max_map_size() << ")" << std::endl;
-					throw error("Map height limit exceeded.");
+				if(x > max_map_size()) {
+					ERR_G << "Map size exceeds limit (x > " << max_map_size() << ")" << std::endl;
+					throw error("Map width limit exceeded.");
 				}
-			}
-
-			// Prepare next iteration
-			++y;
-			x = 0;
 
-			// Avoid in infinite loop if the last line ends without an EOL
-			if(pos_separator == std::string::npos) {
-				offset = str.length();
+				// Process the chunk
+				std::vector<std::string> sp;
+				// The gamemap never has a wildcard
+				result.get(x, y) = string_to_number_(terrain, sp, NO_LAYER);
 
-			} else {
+				for(std::string& starting_position : sp) {
+					found_positions[row].emplace_back(std::move(starting_position), coordinate(x - border_offset.x, y - border_offset.y));
+				}
 
-				offset = pos_separator + 1;
-				// Skip the following newlines
-				while(offset < str.length() && utils::isnewline(str[offset])) {
-					++offset;
+				if(pos_separator == std::string_view::npos) {
+					break;
 				}
+
+				pos = pos_separator + 1;
+				++x;
 			}
 
-		} else {
-			++x;
-			offset = pos_separator + 1;
-			if (x > max_map_size()) {
-				ERR_G << "Map size exceeds limit (x > " << max_map_size() << ")" << std::endl;
-				throw error("Map width limit exceeded.");
+			if((x + 1) != width) {
+				ERR_G << "Map not a rectangle error occurred at line offset " << y << " position offset " << x << std::endl;
+				throw error("Map not a rectangle.");
 			}
 		}
+	};
+
+	// Large maps spend seconds in parsing alone, and rows only touch their
+	// own cells, so fan the rows out over the hardware threads.
+	const std::size_t num_rows = lines.size();
+	const std::size_t num_threads = std::thread::hardware_concurrency();
 
+	if(num_rows < 64 || num_threads <= 1) {
+		parse_rows(0, num_rows);
+	} else {
+		const std::size_t rows_per_thread = (num_rows + num_threads - 1) / num_threads;
+		std::vector<std::future<void>> workers;
+
+		for(std::size_t begin = 0; begin < num_rows; begin += rows_per_thread) {
+			workers.push_back(std::async(std::launch::async, parse_rows, begin, std::min(begin + rows_per_thread, num_rows)));
+		}
+
+		for(std::future<void>& worker : workers) {
+			worker.get();
+		}
 	}
 
-	if(x != 0 && (x + 1) != width) {
-		ERR_G << "Map not a rectangle error occurred at the end" << std::endl;
-		throw error("Map not a rectangle.");
+	for(const auto& row : found_positions) {
+		for(const auto& found : row) {
+			if(starting_positions.left.find(found.first) != starting_positions.left.end()) {
+				WRN_G << "Starting position " << found.first << " is redefined." << std::endl;
+			}
+			starting_positions.insert(starting_positions::value_type(found.first, found.second));
+		}
 	}
 
 	return result;
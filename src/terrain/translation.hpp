@@ -18,6 +18,7 @@
 #include <vector>
 #include <map>
 #include <cstdint>
+#include <functional>
 #include <boost/bimap.hpp>
 #include <boost/bimap/set_of.hpp>
 #include <boost/bimap/multiset_of.hpp>
@@ -366,3 +367,14 @@ namespace t_translation {
 	ter_map read_builder_map(const std::string& str);
 
 } // end namespace t_translation
+
+/** Hashes a terrain code as a single 64-bit (base, overlay) value. */
+template<>
+struct std::hash<t_translation::terrain_code>
+{
+	std::size_t operator()(const t_translation::terrain_code& t) const
+	{
+		const uint64_t packed = (static_cast<uint64_t>(t.base) << 32) | t.overlay;
+		return std::hash<uint64_t>{}(packed);
+	}
+};
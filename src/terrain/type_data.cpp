@@ -44,8 +44,7 @@ void terrain_type_data::lazy_initialization() const
 		DBG_G << "create_terrain_maps: " << terrain.number() << " "
 			<< terrain.id() << " " << terrain.name() << " : " << terrain.editor_group() << "\n";
 
-		std::pair<std::map<t_translation::terrain_code, terrain_type>::iterator, bool> res;
-		res = tcodeToTerrain_.emplace(terrain.number(), terrain);
+		const auto res = tcodeToTerrain_.emplace(terrain.number(), terrain);
 		if (!res.second) {
 			terrain_type& curr = res.first->second;
 			if(terrain == curr) {
@@ -93,7 +92,7 @@ const t_translation::ter_list & terrain_type_data::list() const
 }
 
 
-const std::map<t_translation::terrain_code, terrain_type> & terrain_type_data::map() const
+const terrain_type_data::tcodeToTerrain_t & terrain_type_data::map() const
 {
 	lazy_initialization();
 	return tcodeToTerrain_;
@@ -17,7 +17,7 @@
 
 #include "terrain/terrain.hpp"
 
-#include <map>
+#include <unordered_map>
 
 class game_config_view;
 
@@ -40,7 +40,9 @@ class game_config_view;
 class terrain_type_data {
 private:
 	mutable t_translation::ter_list terrainList_;
-	using tcodeToTerrain_t = std::map<t_translation::terrain_code, terrain_type>;
+	// Hashed on the packed 64-bit code; get_terrain_info() is hit per hex
+	// during draw preparation and pathfinding, so lookups must be O(1).
+	using tcodeToTerrain_t = std::unordered_map<t_translation::terrain_code, terrain_type>;
 	mutable tcodeToTerrain_t tcodeToTerrain_;
 	mutable bool initialized_;
 	const game_config_view & game_config_;
@@ -58,7 +60,7 @@ public:
 	void lazy_initialization() const;
 
 	const t_translation::ter_list & list() const;
-	const std::map<t_translation::terrain_code, terrain_type> & map() const;
+	const tcodeToTerrain_t & map() const;
 
 	/**
 	 * Get the corresponding terrain_type information object for a given type
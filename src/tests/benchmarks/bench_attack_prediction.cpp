@@ -0,0 +1,58 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+// Unlocks the numbers-only battle_context_unit_stats constructor that the
+// stand-alone attack_prediction harness uses; without it building the stats
+// would need full unit and weapon objects.
+#define BENCHMARK
+
+#include "tests/benchmarks/benchmark.hpp"
+
+// attack.hpp's benchmark-only constructor uses round_damage() without
+// including it; the stand-alone harness gets it the same way.
+#include "utils/math.hpp"
+
+#include "actions/attack.hpp"
+#include "attack_prediction.hpp"
+
+namespace
+{
+
+// damage, blows, hp, max_hp, hit chance, drain, slows, slowed, berserk, firststrike, swarm
+
+/** An everyday melee exchange: the common case in AI attack evaluation. */
+const battle_context_unit_stats basic_attacker(8, 3, 38, 38, 60, false, false, false, false, false, false);
+const battle_context_unit_stats basic_defender(5, 4, 33, 33, 50, false, false, false, false, true, false);
+
+/** The nasty special combinations that stress the probability matrix. */
+const battle_context_unit_stats ugly_attacker(6, 4, 55, 55, 70, true, false, false, true, false, false);
+const battle_context_unit_stats ugly_defender(4, 8, 60, 60, 40, false, true, false, false, false, true);
+
+} // namespace
+
+BENCHMARK_CASE(combatant_fight_basic)
+{
+	combatant attacker(basic_attacker);
+	combatant defender(basic_defender);
+	attacker.fight(defender);
+	benchmark::do_not_optimize(defender.untouched);
+}
+
+BENCHMARK_CASE(combatant_fight_specials)
+{
+	combatant attacker(ugly_attacker);
+	combatant defender(ugly_defender);
+	attacker.fight(defender);
+	benchmark::do_not_optimize(defender.untouched);
+}
@@ -0,0 +1,74 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "tests/benchmarks/benchmark.hpp"
+
+#include "map/location.hpp"
+#include "pathfind/pathfind.hpp"
+
+namespace
+{
+
+const int map_width = 64;
+const int map_height = 64;
+
+/**
+ * Deterministic pseudo-terrain: mostly plains with scattered pockets of
+ * rough ground, which is what a_star_search typically runs against without
+ * dragging the whole game state into the benchmark.
+ */
+struct plains_calculator : pathfind::cost_calculator
+{
+	double cost(const map_location& loc, const double) const override
+	{
+		return 1.0 + ((loc.x * 7 + loc.y * 13) % 11 == 0 ? 2.0 : 0.0);
+	}
+};
+
+/**
+ * Horizontal bands of near-impassable terrain with staggered gaps; forces
+ * the search away from the straight line and touches most of the map.
+ */
+struct maze_calculator : pathfind::cost_calculator
+{
+	double cost(const map_location& loc, const double) const override
+	{
+		if(loc.y % 8 == 4 && loc.x != (loc.y * 5) % map_width) {
+			return 40.0;
+		}
+		return 1.0;
+	}
+};
+
+} // namespace
+
+BENCHMARK_CASE(a_star_search_plains)
+{
+	static const plains_calculator calc;
+
+	const pathfind::plain_route route = pathfind::a_star_search(
+		map_location(0, 0), map_location(map_width - 1, map_height - 1),
+		10000.0, calc, map_width, map_height);
+	benchmark::do_not_optimize(route.move_cost);
+}
+
+BENCHMARK_CASE(a_star_search_maze)
+{
+	static const maze_calculator calc;
+
+	const pathfind::plain_route route = pathfind::a_star_search(
+		map_location(0, 0), map_location(map_width - 1, map_height - 1),
+		10000.0, calc, map_width, map_height);
+	benchmark::do_not_optimize(route.move_cost);
+}
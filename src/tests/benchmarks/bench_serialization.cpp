@@ -0,0 +1,122 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "tests/benchmarks/benchmark.hpp"
+
+#include "config.hpp"
+#include "serialization/parser.hpp"
+#include "serialization/preprocessor.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+/** A unit-list shaped document, the kind of WML save files are full of. */
+std::string make_unit_list_wml(int count)
+{
+	std::ostringstream out;
+	for(int i = 0; i < count; ++i) {
+		out << "[unit]\n"
+			<< "\tid=unit_" << i << "\n"
+			<< "\ttype=Elvish Fighter\n"
+			<< "\tside=" << (i % 4 + 1) << "\n"
+			<< "\thitpoints=" << (i % 33 + 1) << "\n"
+			<< "\tmax_hitpoints=33\n"
+			<< "\texperience=" << (i % 40) << "\n"
+			<< "\tfacing=se\n"
+			<< "\tdescription=_\"An army of benchmark units\"\n"
+			<< "\t[attack]\n"
+			<< "\t\tname=sword\n"
+			<< "\t\tdamage=5\n"
+			<< "\t\tnumber=4\n"
+			<< "\t[/attack]\n"
+			<< "\t[modifications]\n"
+			<< "\t\t[trait]\n"
+			<< "\t\t\tid=strong\n"
+			<< "\t\t[/trait]\n"
+			<< "\t[/modifications]\n"
+			<< "[/unit]\n";
+	}
+	return out.str();
+}
+
+/** Writes a macro-heavy file on construction and cleans it up again. */
+struct preproc_fixture
+{
+	const std::string path = "wesnoth_bench_preproc.cfg";
+
+	preproc_fixture()
+	{
+		std::ofstream out(path);
+		out << "#define BENCH_UNIT ID HP\n"
+			<< "[unit]\n"
+			<< "\tid={ID}\n"
+			<< "\thitpoints={HP}\n"
+			<< "\tmax_hitpoints={HP}\n"
+			<< "[/unit]\n"
+			<< "#enddef\n"
+			<< "#define BENCH_SIDE SIDE\n"
+			<< "[side]\n"
+			<< "\tside={SIDE}\n";
+		for(int i = 0; i < 40; ++i) {
+			out << "\t{BENCH_UNIT unit_" << i << " " << (i % 33 + 1) << "}\n";
+		}
+		out << "[/side]\n"
+			<< "#enddef\n";
+		for(int side = 1; side <= 20; ++side) {
+			out << "{BENCH_SIDE " << side << "}\n";
+		}
+	}
+
+	~preproc_fixture()
+	{
+		std::remove(path.c_str());
+	}
+};
+
+} // namespace
+
+BENCHMARK_CASE(wml_parse)
+{
+	static const std::string text = make_unit_list_wml(200);
+
+	config cfg;
+	read(cfg, text);
+	benchmark::do_not_optimize(cfg.all_children_count());
+}
+
+BENCHMARK_CASE(wml_write)
+{
+	static const config cfg = []() {
+		config c;
+		read(c, make_unit_list_wml(200));
+		return c;
+	}();
+
+	std::ostringstream out;
+	write(out, cfg);
+	benchmark::do_not_optimize(out.str().size());
+}
+
+BENCHMARK_CASE(wml_preprocess)
+{
+	static const preproc_fixture fixture;
+
+	filesystem::scoped_istream stream = preprocess_file(fixture.path);
+	const std::string expanded{std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()};
+	benchmark::do_not_optimize(expanded.size());
+}
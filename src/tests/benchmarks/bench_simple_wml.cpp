@@ -0,0 +1,75 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "tests/benchmarks/benchmark.hpp"
+
+#include "server/common/simple_wml.hpp"
+
+#include <sstream>
+
+namespace
+{
+
+/** Shaped like the [scenario_diff]/[turn] traffic wesnothd relays. */
+std::string make_server_wml(int turns)
+{
+	std::ostringstream out;
+	for(int i = 0; i < turns; ++i) {
+		out << "[turn]\n"
+			<< "\t[command]\n"
+			<< "\t\t[move]\n"
+			<< "\t\t\tx=\"" << (i % 40 + 1) << "," << (i % 40 + 3) << "\"\n"
+			<< "\t\t\ty=\"" << (i % 30 + 1) << "," << (i % 30 + 2) << "\"\n"
+			<< "\t\t[/move]\n"
+			<< "\t\t[checkup]\n"
+			<< "\t\t\t[result]\n"
+			<< "\t\t\t\tmp=\"5\"\n"
+			<< "\t\t\t[/result]\n"
+			<< "\t\t[/checkup]\n"
+			<< "\t[/command]\n"
+			<< "[/turn]\n";
+	}
+	return out.str();
+}
+
+const std::string& server_wml()
+{
+	static const std::string text = make_server_wml(200);
+	return text;
+}
+
+} // namespace
+
+BENCHMARK_CASE(simple_wml_parse)
+{
+	simple_wml::document doc(server_wml().c_str(), simple_wml::INIT_STATIC);
+	benchmark::do_not_optimize(doc.root().children("turn").size());
+}
+
+BENCHMARK_CASE(simple_wml_compress)
+{
+	simple_wml::document doc(server_wml().c_str(), simple_wml::INIT_STATIC);
+	benchmark::do_not_optimize(doc.output_compressed().size());
+}
+
+BENCHMARK_CASE(simple_wml_decompress)
+{
+	// The source document owns the compressed buffer; parsing it back is
+	// exactly what happens to every document arriving over the network.
+	static simple_wml::document source(server_wml().c_str(), simple_wml::INIT_STATIC);
+	static const simple_wml::string_span compressed = source.output_compressed();
+
+	simple_wml::document doc(compressed);
+	benchmark::do_not_optimize(doc.root().children("turn").size());
+}
@@ -0,0 +1,122 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "tests/benchmarks/benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace benchmark
+{
+
+namespace
+{
+
+struct case_entry
+{
+	std::string name;
+	std::function<void()> fn;
+};
+
+std::vector<case_entry>& cases()
+{
+	// Function-local so registration from static initializers in other
+	// translation units cannot run before the vector is constructed.
+	static std::vector<case_entry> instance;
+	return instance;
+}
+
+/** How long a single sample should at least run, in nanoseconds. */
+const long long min_sample_time_ns = 200000000;
+
+/** Samples per case; the fastest one is reported to suppress scheduler noise. */
+const int num_samples = 5;
+
+long long time_iterations(const std::function<void()>& fn, long long iterations)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for(long long i = 0; i < iterations; ++i) {
+		fn();
+	}
+	const auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+}
+
+} // namespace
+
+void register_case(const std::string& name, std::function<void()> fn)
+{
+	cases().push_back(case_entry{name, std::move(fn)});
+}
+
+int run_all(int argc, char** argv)
+{
+	const std::vector<std::string> filters(argv + 1, argv + argc);
+
+	std::sort(cases().begin(), cases().end(),
+		[](const case_entry& a, const case_entry& b) { return a.name < b.name; });
+
+	std::cout << "benchmark,iterations,ns_per_iteration\n";
+
+	bool ran_any = false;
+	for(const case_entry& entry : cases()) {
+		if(!filters.empty()
+			&& std::none_of(filters.begin(), filters.end(), [&entry](const std::string& f) {
+				return entry.name.find(f) != std::string::npos;
+			}))
+		{
+			continue;
+		}
+
+		ran_any = true;
+
+		// Grow the iteration count until one sample runs long enough for the
+		// clock resolution not to matter.
+		long long iterations = 1;
+		long long elapsed = time_iterations(entry.fn, iterations);
+		while(elapsed < min_sample_time_ns) {
+			iterations *= std::max<long long>(2, min_sample_time_ns / std::max<long long>(elapsed, 1));
+			elapsed = time_iterations(entry.fn, iterations);
+		}
+
+		long long best = elapsed;
+		for(int sample = 1; sample < num_samples; ++sample) {
+			best = std::min(best, time_iterations(entry.fn, iterations));
+		}
+
+		std::cout << entry.name << ',' << iterations << ','
+				  << static_cast<double>(best) / iterations << std::endl;
+	}
+
+	if(!ran_any) {
+		std::cerr << "no benchmark matches the given filter\n";
+		return 1;
+	}
+
+	return 0;
+}
+
+} // namespace benchmark
+
+int main(int argc, char** argv)
+{
+	try {
+		return benchmark::run_all(argc, argv);
+	} catch(const std::exception& e) {
+		std::cerr << "benchmark aborted: " << e.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,71 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+/**
+ * @file
+ * Minimal microbenchmark harness for the wesnoth_benchmarks target.
+ *
+ * Cases register themselves with BENCHMARK_CASE and are run by main() in
+ * benchmark.cpp, which auto-scales the iteration count, takes several
+ * samples and prints one CSV line per case so the results can be tracked
+ * per commit. No third-party benchmark library is involved.
+ */
+
+namespace benchmark
+{
+
+/** Keeps the compiler from discarding a result it thinks is unused. */
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(_MSC_VER)
+	static volatile const void* sink;
+	sink = &value;
+#else
+	asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/**
+ * Registers @a fn under @a name; the function body is one iteration of the
+ * measured work. Use through BENCHMARK_CASE rather than directly.
+ */
+void register_case(const std::string& name, std::function<void()> fn);
+
+struct registrar
+{
+	registrar(const std::string& name, std::function<void()> fn)
+	{
+		register_case(name, std::move(fn));
+	}
+};
+
+/**
+ * Runs every registered case whose name contains one of the @a filters
+ * (all of them when no filter is given) and writes CSV to stdout.
+ * Returns a main()-style exit status.
+ */
+int run_all(int argc, char** argv);
+
+} // namespace benchmark
+
+#define BENCHMARK_CASE(name)                                                   \
+	static void bench_body_##name();                                           \
+	static const benchmark::registrar bench_reg_##name(#name, &bench_body_##name); \
+	static void bench_body_##name()
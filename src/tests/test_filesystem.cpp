@@ -215,9 +215,12 @@ BOOST_AUTO_TEST_CASE( test_fs_fluff )
 	BOOST_CHECK( !is_gzip_file("foo.gz.bz2") );
 	BOOST_CHECK( is_bzip2_file("foo.bz2") );
 	BOOST_CHECK( !is_bzip2_file("foo.bz2.gz") );
+	BOOST_CHECK( is_zstd_file("foo.zst") );
+	BOOST_CHECK( !is_zstd_file("foo.zst.gz") );
 
 	BOOST_CHECK( is_compressed_file("foo.gz") );
 	BOOST_CHECK( is_compressed_file("foo.bz2") );
+	BOOST_CHECK( is_compressed_file("foo.zst") );
 	BOOST_CHECK( !is_compressed_file("foo.txt") );
 
 	// FIXME: Is this even intended?
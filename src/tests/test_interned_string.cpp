@@ -0,0 +1,58 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#define GETTEXT_DOMAIN "wesnoth-test"
+
+#include <boost/test/unit_test.hpp>
+
+#include "utils/interned_string.hpp"
+
+BOOST_AUTO_TEST_SUITE( interned_string )
+
+BOOST_AUTO_TEST_CASE( pooling )
+{
+	utils::interned_string a("a_fairly_long_tag_name_with_no_sso");
+	utils::interned_string b("a_fairly_long_tag_name_with_no_sso");
+
+	// Equal content pools to one string object.
+	BOOST_CHECK_EQUAL(&a.str(), &b.str());
+	BOOST_CHECK(a == b);
+
+	utils::interned_string c("something_else");
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(c.str(), "something_else");
+}
+
+BOOST_AUTO_TEST_CASE( string_semantics )
+{
+	utils::interned_string empty;
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK_EQUAL(empty.size(), 0u);
+
+	utils::interned_string s("terrain");
+	BOOST_CHECK(s == "terrain");
+	BOOST_CHECK(s != "unit");
+	BOOST_CHECK_EQUAL(s.size(), 7u);
+
+	const std::string& ref = s;
+	BOOST_CHECK_EQUAL(ref, "terrain");
+
+	// Ordering follows string content, not pool addresses.
+	utils::interned_string x("abc"), y("abd");
+	BOOST_CHECK(x < y);
+	BOOST_CHECK(!(y < x));
+	BOOST_CHECK(!(x < x));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
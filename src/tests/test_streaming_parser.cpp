@@ -0,0 +1,98 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#define GETTEXT_DOMAIN "wesnoth-test"
+
+#include <boost/test/unit_test.hpp>
+
+#include "serialization/streaming_parser.hpp"
+
+#include <sstream>
+
+namespace
+{
+
+/** Flattens the event stream into one string for easy comparison. */
+struct recording_handler : wml_stream_handler
+{
+	std::string events;
+
+	void open_tag(const std::string& name, bool is_append) override
+	{
+		events += (is_append ? "+" : "[") + name + " ";
+	}
+
+	void close_tag(const std::string& name) override
+	{
+		events += "/" + name + " ";
+	}
+
+	void attribute(const std::string& name, const config::attribute_value& value) override
+	{
+		events += name + "=" + value.str() + " ";
+	}
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( streaming_parser )
+
+BOOST_AUTO_TEST_CASE( events )
+{
+	std::istringstream in(
+		"version=1.2\n"
+		"[unit]\n"
+		"type=Elvish Archer\n"
+		"x,y=3,4\n"
+		"[/unit]\n"
+		"[+unit]\n"
+		"[/unit]\n");
+
+	recording_handler handler;
+	read_events(in, handler);
+
+	BOOST_CHECK_EQUAL(handler.events,
+		"version=1.2 [unit type=Elvish Archer x=3 y=4 /unit +unit /unit ");
+}
+
+BOOST_AUTO_TEST_CASE( early_stop )
+{
+	std::istringstream in(
+		"[replay]\n"
+		"version=1.0\n"
+		"[/replay]\n"
+		"[garbage\n");
+
+	struct stopping_handler : recording_handler
+	{
+		void attribute(const std::string& name, const config::attribute_value& value) override
+		{
+			recording_handler::attribute(name, value);
+			stop();
+		}
+	} handler;
+
+	// The malformed tail is never reached.
+	read_events(in, handler);
+	BOOST_CHECK_EQUAL(handler.events, "[replay version=1.0 ");
+}
+
+BOOST_AUTO_TEST_CASE( malformed )
+{
+	std::istringstream in("[unit]\n");
+	recording_handler handler;
+	BOOST_CHECK_THROW(read_events(in, handler), config::error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -594,6 +594,7 @@ theme::theme(const config& cfg, const SDL_Rect& screen)
 	, screen_dimensions_(screen)
 	, cur_spec_width_(0)
 	, cur_spec_height_(0)
+	, cur_resolution_(nullptr)
 {
 	do_resolve_rects(expand_partialresolution(cfg), cfg_);
 	set_resolution(screen);
@@ -633,6 +634,16 @@ bool theme::set_resolution(const SDL_Rect& screen)
 		}
 		return false;
 	}
+
+	// Live-resizing comes through here for every size change, but the
+	// objects only depend on the chosen [resolution] block; they rescale
+	// themselves to the real screen size in object::location(). Rebuilding
+	// is thus only needed when a different block wins.
+	if(current == cur_resolution_) {
+		return result;
+	}
+	cur_resolution_ = current;
+
 	cur_spec_width_ = (*current)["width"];
 	cur_spec_height_ = (*current)["height"];
 
@@ -315,4 +315,7 @@ private:
 
 	SDL_Rect screen_dimensions_;
 	std::size_t cur_spec_width_, cur_spec_height_;
+
+	/** The [resolution] block the current objects were built from. */
+	const config* cur_resolution_;
 };
@@ -48,6 +48,14 @@ int tooltip_id = 0;
 
 surface current_background = nullptr;
 
+/**
+ * Rendered tooltip surfaces, keyed by the tooltip text. Big markup
+ * tooltips take long enough to shape that the first hover hitches;
+ * keeping the render lets every later hover of the same text reuse it.
+ * Cleared with the tooltips themselves to bound growth.
+ */
+std::map<std::string, surface> rendered_tips;
+
 }
 
 static void clear_tooltip()
@@ -73,7 +81,19 @@ static void show_tooltip(const tooltip& tip)
 
 	unsigned int border = 10;
 
-	font::floating_label flabel(tip.message, tip.foreground);
+	// Plain and markup renders of the same text differ, so they get
+	// separate cache entries.
+	const std::string render_key = (tip.markup ? "m" : "p") + tip.message;
+
+	surface premade = tip.foreground;
+	if(premade == nullptr) {
+		const auto cached = rendered_tips.find(render_key);
+		if(cached != rendered_tips.end()) {
+			premade = cached->second;
+		}
+	}
+
+	font::floating_label flabel(tip.message, premade);
 	flabel.use_markup(tip.markup);
 	flabel.set_font_size(font_size);
 	flabel.set_color(font::NORMAL_COLOR);
@@ -87,6 +107,10 @@ static void show_tooltip(const tooltip& tip)
 
 	SDL_Rect rect = font::get_floating_label_rect(tooltip_handle);
 
+	if(premade == nullptr) {
+		rendered_tips.emplace(render_key, font::get_floating_label_surface(tooltip_handle));
+	}
+
 	//see if there is enough room to fit it above the tip area
 	if(tip.rect.y > rect.h) {
 		rect.y = tip.rect.y - rect.h;
@@ -122,6 +146,7 @@ void clear_tooltips()
 {
 	clear_tooltip();
 	tips.clear();
+	rendered_tips.clear();
 	current_tooltip = tips.end();
 }
 
@@ -34,7 +34,12 @@ static lg::log_domain log_config("config");
 #define LOG_CF LOG_STREAM(info, log_config)
 #define ERR_CF LOG_STREAM(err, log_config)
 
-static unsigned language_counter = 0;
+/**
+ * Bumped on every language change. Starts at 1 so that a fresh t_string_base
+ * (translation_timestamp_ == 0) can never look up to date, which lets str()
+ * cache empty translation results too.
+ */
+static unsigned language_counter = 1;
 
 namespace
 {
@@ -43,6 +48,25 @@ const char UNTRANSLATABLE_PART = 0x02;
 const char TEXTDOMAIN_SEPARATOR = 0x03;
 const char ID_TRANSLATABLE_PART = 0x04;
 const char PLURAL_PART = 0x05;
+
+/**
+ * Translations shared between all t_string_base instances with the same raw
+ * value, so that the thousands of short-lived copies a unit list or menu
+ * creates per frame hit this map instead of calling into gettext again.
+ * Cleared on language change.
+ */
+std::map<std::string, std::string> translation_memo;
+std::mutex translation_memo_mutex;
+
+/** Keeps a runaway string set (e.g. generated unit names) from growing the memo forever. */
+const std::size_t translation_memo_max_size = 100000;
+
+/**
+ * Guards the textdomain id registry (textdomain_to_id / id_to_textdomain):
+ * parallel WML parsing constructs translatable t_strings on worker threads,
+ * which register their textdomains concurrently.
+ */
+std::mutex textdomain_id_mutex;
 }
 
 std::size_t t_string_base::hash_value() const
@@ -114,13 +138,16 @@ void t_string_base::walker::update()
 		}
 
 		id = static_cast<unsigned char>(string_[begin_ + 1]) + static_cast<unsigned char>(string_[begin_ + 2]) * 256;
-		if(id >= id_to_textdomain.size()) {
-			ERR_CF << "Error: invalid string: " << string_ << std::endl;
-			begin_ = string_.size();
-			return;
-		}
+		{
+			std::scoped_lock lock(textdomain_id_mutex);
+			if(id >= id_to_textdomain.size()) {
+				ERR_CF << "Error: invalid string: " << string_ << std::endl;
+				begin_ = string_.size();
+				return;
+			}
 
-		textdomain_ = id_to_textdomain[id];
+			textdomain_ = id_to_textdomain[id];
+		}
 		begin_ += 3;
 		translatable_ = true;
 
@@ -262,15 +289,18 @@ t_string_base::t_string_base(const std::string& string, const std::string& textd
 		return;
 	}
 
-	std::map<std::string, unsigned int>::const_iterator idi = textdomain_to_id.find(textdomain);
 	unsigned int id;
-
-	if(idi == textdomain_to_id.end()) {
-		id = id_to_textdomain.size();
-		textdomain_to_id[textdomain] = id;
-		id_to_textdomain.push_back(textdomain);
-	} else {
-		id = idi->second;
+	{
+		std::scoped_lock lock(textdomain_id_mutex);
+		std::map<std::string, unsigned int>::const_iterator idi = textdomain_to_id.find(textdomain);
+
+		if(idi == textdomain_to_id.end()) {
+			id = id_to_textdomain.size();
+			textdomain_to_id[textdomain] = id;
+			id_to_textdomain.push_back(textdomain);
+		} else {
+			id = idi->second;
+		}
 	}
 
 	value_ += static_cast<char>(id & 0xff);
@@ -291,15 +321,18 @@ t_string_base::t_string_base(const std::string& sing, const std::string& pl, int
 		return;
 	}
 
-	std::map<std::string, unsigned int>::const_iterator idi = textdomain_to_id.find(textdomain);
 	unsigned int id;
-
-	if(idi == textdomain_to_id.end()) {
-		id = id_to_textdomain.size();
-		textdomain_to_id[textdomain] = id;
-		id_to_textdomain.push_back(textdomain);
-	} else {
-		id = idi->second;
+	{
+		std::scoped_lock lock(textdomain_id_mutex);
+		std::map<std::string, unsigned int>::const_iterator idi = textdomain_to_id.find(textdomain);
+
+		if(idi == textdomain_to_id.end()) {
+			id = id_to_textdomain.size();
+			textdomain_to_id[textdomain] = id;
+			id_to_textdomain.push_back(textdomain);
+		} else {
+			id = idi->second;
+		}
 	}
 
 	value_ += static_cast<char>(id & 0xff);
@@ -562,10 +595,20 @@ const std::string& t_string_base::str() const
 		return value_;
 	}
 
-	if(translatable_ && !translated_value_.empty() && translation_timestamp_ == language_counter) {
+	if(translation_timestamp_ == language_counter) {
 		return translated_value_;
 	}
 
+	{
+		std::scoped_lock lock(translation_memo_mutex);
+		auto cached = translation_memo.find(value_);
+		if(cached != translation_memo.end()) {
+			translated_value_ = cached->second;
+			translation_timestamp_ = language_counter;
+			return translated_value_;
+		}
+	}
+
 	translated_value_.clear();
 
 	for(walker w(*this); !w.eos(); w.next()) {
@@ -586,6 +629,14 @@ const std::string& t_string_base::str() const
 	}
 
 	translation_timestamp_ = language_counter;
+
+	{
+		std::scoped_lock lock(translation_memo_mutex);
+		if(translation_memo.size() < translation_memo_max_size) {
+			translation_memo.emplace(value_, translated_value_);
+		}
+	}
+
 	return translated_value_;
 }
 
@@ -652,6 +703,9 @@ void t_string::add_textdomain(const std::string& name, const std::string& path)
 void t_string::reset_translations()
 {
 	++language_counter;
+
+	std::scoped_lock lock(translation_memo_mutex);
+	translation_memo.clear();
 }
 
 void swap(t_string& lhs, t_string& rhs)
@@ -29,6 +29,7 @@
 #include "resources.hpp"
 #include "team.hpp"
 #include "terrain/filter.hpp"
+#include "tod_manager.hpp"
 #include "units/unit.hpp"
 #include "units/abilities.hpp"
 #include "units/filter.hpp"
@@ -144,6 +145,52 @@ bool affects_side(const config& cfg, std::size_t side, std::size_t other_side)
 		return cfg["affect_allies"].to_bool();
 }
 
+/** Bumped by unit_abilities::invalidate_cache() whenever units change. */
+std::size_t ability_cache_epoch = 1;
+
+/**
+ * Whether an ability's activity can only change together with a cache
+ * generation bump. Activity filters ([filter], [filter_self],
+ * [filter_adjacent], [filter_adjacent_location], nested [filter] inside
+ * [affect_adjacent], ...) can match on hitpoints, WML variables, formulas
+ * or terrain, none of which have a central mutation point to invalidate
+ * the cache from, so filtered abilities are never memoized.
+ */
+bool ability_cacheable(const config& cfg)
+{
+	for(const config::any_child child : cfg.all_children_range()) {
+		if(child.key == "filter" || child.key.compare(0, 7, "filter_") == 0) {
+			return false;
+		}
+		if(child.key == "affect_adjacent" && child.cfg.has_child("filter")) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+namespace unit_abilities
+{
+
+std::size_t cache_generation()
+{
+	// Fold in the time of day, since ability filters can match on it and
+	// the schedule advances without any unit map mutation.
+	std::size_t gen = ability_cache_epoch;
+	if(resources::tod_manager) {
+		gen = gen * 8191 + resources::tod_manager->turn();
+		gen = gen * 8191 + resources::tod_manager->get_current_time();
+	}
+	return gen;
+}
+
+void invalidate_cache()
+{
+	++ability_cache_epoch;
+}
+
 }
 
 bool unit::get_ability_bool(const std::string& tag_name, const map_location& loc) const
@@ -187,9 +234,26 @@ bool unit::get_ability_bool(const std::string& tag_name, const map_location& loc
 
 unit_ability_list unit::get_abilities(const std::string& tag_name, const map_location& loc) const
 {
+	const std::size_t generation = unit_abilities::cache_generation();
+	if(ability_cache_generation_ != generation) {
+		ability_cache_.clear();
+		ability_cache_generation_ = generation;
+	}
+
+	const auto cached = ability_cache_.find(std::pair(tag_name, loc));
+	if(cached != ability_cache_.end()) {
+		return cached->second;
+	}
+
 	unit_ability_list res(loc_);
 
+	// Whether the result may be memoized. Every examined ability config must
+	// be free of activity filters, including ones that are inactive right now:
+	// a filtered ability could become active without the generation moving.
+	bool cacheable = true;
+
 	for(const config& i : this->abilities_.child_range(tag_name)) {
+		cacheable = cacheable && ability_cacheable(i);
 		if(ability_active(tag_name, i, loc)
 			&& ability_affects_self(tag_name, i, loc))
 			{
@@ -213,6 +277,7 @@ unit_ability_list unit::get_abilities(const std::string& tag_name, const map_loc
 		if ( &*it == this )
 			continue;
 		for(const config& j : it->abilities_.child_range(tag_name)) {
+			cacheable = cacheable && ability_cacheable(j);
 			if(affects_side(j, side(), it->side())
 				&& it->ability_active(tag_name, j, adjacent[i])
 				&& ability_affects_adjacent(tag_name, j, i, loc, *it))
@@ -222,6 +287,9 @@ unit_ability_list unit::get_abilities(const std::string& tag_name, const map_loc
 		}
 	}
 
+	if(cacheable) {
+		ability_cache_.emplace(std::pair(tag_name, loc), res);
+	}
 
 	return res;
 }
@@ -698,8 +766,35 @@ namespace {
  * active in the current context (see set_specials_context), including
  * specials obtained from the opponent's attack.
  */
+bool attack_type::may_have_special(const std::string& id) const
+{
+	if(!special_names_valid_) {
+		special_names_.clear();
+		for(const config::any_child sp : specials_.all_children_range()) {
+			special_names_.push_back(sp.key);
+			const std::string& sp_id = sp.cfg["id"];
+			if(!sp_id.empty()) {
+				special_names_.push_back(sp_id);
+			}
+		}
+		std::sort(special_names_.begin(), special_names_.end());
+		special_names_valid_ = true;
+	}
+
+	return std::binary_search(special_names_.begin(), special_names_.end(), id);
+}
+
 bool attack_type::has_special(const std::string& special, bool simple_check, bool special_id, bool special_tags) const
 {
+	// Most callers (battle_context_unit_stats among them) probe for a
+	// handful of specials the weapon doesn't have; reject those from the
+	// cached name lists before walking any configs.
+	if(!may_have_special(special)
+		&& (simple_check || !other_attack_ || !other_attack_->may_have_special(special)))
+	{
+		return false;
+	}
+
 	{
 		std::vector<special_match> special_tag_matches;
 		std::vector<special_match> special_id_matches;
@@ -23,6 +23,23 @@ namespace unit_abilities
 {
 bool filter_base_matches(const config& cfg, int def);
 
+/**
+ * Returns the current generation of the per-unit ability aggregation cache.
+ *
+ * unit::get_abilities() memoizes its aggregate of own plus adjacent
+ * abilities; cached entries are only reused while this value is unchanged.
+ */
+std::size_t cache_generation();
+
+/**
+ * Invalidates all cached ability aggregates.
+ *
+ * Called whenever a unit is added to, removed from or moved on the unit
+ * map, when unit state that ability filters can observe changes, and when
+ * a unit's side or a team's diplomacy changes.
+ */
+void invalidate_cache();
+
 enum value_modifier {NOT_USED,SET,ADD,MUL,DIV};
 
 struct individual_effect
@@ -23,8 +23,102 @@
 #include "units/unit.hpp"
 #include "units/types.hpp"
 
+#include <algorithm>
 #include <set>
 
+namespace
+{
+/**
+ * The animation upkeep registries. Components enroll themselves on
+ * construction and whenever an animation starts, so the per-frame upkeep in
+ * refresh_active() only touches animating units instead of the whole roster.
+ *
+ * Components running a non-standing animation sit in the active list and are
+ * refreshed every frame. Standing components sit in the standing list with a
+ * wake tick (their pending idle time); the per-frame work for them is one
+ * comparison against a contiguous array of ticks. Both lists use swap-remove
+ * through the component's stored index, so churn is O(1).
+ */
+std::vector<unit_animation_component*> active_components;
+std::vector<unit_animation_component*> standing_components;
+/** Wake ticks parallel to standing_components. */
+std::vector<int> standing_wakes;
+
+/** Retry period for a standing component that declined to idle when woken. */
+constexpr int standing_retry_ms = 1000;
+}
+
+unit_animation_component::~unit_animation_component()
+{
+	unenroll();
+}
+
+void unit_animation_component::enroll()
+{
+	unenroll();
+
+	if(state_ == STATE_STANDING) {
+		registry_standing_ = true;
+		registry_index_ = standing_components.size();
+		standing_components.push_back(this);
+		standing_wakes.push_back(next_idling_);
+	} else {
+		registry_standing_ = false;
+		registry_index_ = active_components.size();
+		active_components.push_back(this);
+	}
+}
+
+void unit_animation_component::unenroll()
+{
+	if(registry_index_ == registry_npos) {
+		return;
+	}
+
+	std::vector<unit_animation_component*>& vec = registry_standing_ ? standing_components : active_components;
+	const std::size_t last = vec.size() - 1;
+
+	if(registry_index_ != last) {
+		vec[registry_index_] = vec[last];
+		vec[registry_index_]->registry_index_ = registry_index_;
+		if(registry_standing_) {
+			standing_wakes[registry_index_] = standing_wakes[last];
+		}
+	}
+
+	vec.pop_back();
+	if(registry_standing_) {
+		standing_wakes.pop_back();
+	}
+
+	registry_index_ = registry_npos;
+}
+
+void unit_animation_component::refresh_active()
+{
+	// Iterate backwards: refresh() can re-enroll a component, which
+	// swap-removes it and moves an already visited entry into its place.
+	for(std::size_t i = active_components.size(); i-- != 0;) {
+		active_components[i]->refresh();
+	}
+
+	const int now = get_current_animation_tick();
+	for(std::size_t i = standing_components.size(); i-- != 0;) {
+		if(standing_wakes[i] > now) {
+			continue;
+		}
+
+		unit_animation_component& comp = *standing_components[i];
+		comp.refresh();
+
+		if(comp.registry_standing_ && comp.registry_index_ == i) {
+			// Still standing: either refresh() pushed next_idling_ out, or it
+			// declined to idle (off-screen, incapacitated) - retry soon.
+			standing_wakes[i] = std::max(comp.next_idling_, now + standing_retry_ms);
+		}
+	}
+}
+
 const unit_animation* unit_animation_component::choose_animation(const display& disp, const map_location& loc,const std::string& event,
 		const map_location& second_loc,const int value,const unit_animation::hit_type hit,
 		const_attack_ptr attack, const_attack_ptr second_attack, int swing_num)
@@ -32,7 +126,7 @@ const unit_animation* unit_animation_component::choose_animation(const display&
 	// Select one of the matching animations at random
 	std::vector<const unit_animation*> options;
 	int max_val = unit_animation::MATCH_FAIL;
-	for(const unit_animation& anim : animations_) {
+	for(const unit_animation& anim : *animations_) {
 		int matching = anim.matches(disp,loc,second_loc,u_.shared_from_this(),event,value,hit,attack,second_attack,swing_num);
 		if(matching > unit_animation::MATCH_FAIL && matching == max_val) {
 			options.push_back(&anim);
@@ -101,8 +195,10 @@ void unit_animation_component::start_animation (int start_time, const unit_anima
 {
 	const display * disp =  display::get_singleton();
 	if (!animation) {
-		if (state == STATE_STANDING)
+		if (state == STATE_STANDING) {
 			state_ = state;
+			enroll();
+		}
 		if (!anim_ && state_ != STATE_STANDING)
 			set_standing(with_bars);
 		return ;
@@ -122,6 +218,8 @@ void unit_animation_component::start_animation (int start_time, const unit_anima
 	} else {
 		next_idling_ = INT_MAX;
 	}
+
+	enroll();
 }
 
 void unit_animation_component::refresh()
@@ -188,7 +286,7 @@ bool unit_animation_component::invalidate (const display & disp)
 void unit_animation_component::reset_after_advance(const unit_type * newtype)
 {
 	if (newtype) {
-		animations_ = newtype->animations();
+		animations_ = newtype->animations_ptr();
 	}
 
 	refreshing_ = false;
@@ -196,21 +294,25 @@ void unit_animation_component::reset_after_advance(const unit_type * newtype)
 }
 
 void unit_animation_component::apply_new_animation_effect(const config & effect) {
+	// The animation list is shared with the unit type, so give this unit its
+	// own copy before appending to it.
+	auto animations = std::make_shared<std::vector<unit_animation>>(*animations_);
 	if(effect["id"].empty()) {
-		unit_animation::add_anims(animations_, effect);
+		unit_animation::add_anims(*animations, effect);
 	} else {
 		static std::map< std::string, std::vector<unit_animation>> animation_cache;
 		std::vector<unit_animation> &built = animation_cache[effect["id"]];
 		if(built.empty()) {
 			unit_animation::add_anims(built, effect);
 		}
-		animations_.insert(animations_.end(),built.begin(),built.end());
+		animations->insert(animations->end(),built.begin(),built.end());
 	}
+	animations_ = std::move(animations);
 }
 
 std::vector<std::string> unit_animation_component::get_flags() {
 	std::set<std::string> result;
-	for(const auto& anim : animations_) {
+	for(const auto& anim : *animations_) {
 		const std::vector<std::string>& flags = anim.get_flags();
 		std::copy_if(flags.begin(), flags.end(), std::inserter(result, result.begin()), [](const std::string flag) {
 			return !(flag.empty() || (flag.front() == '_' && flag.back() == '_'));
@@ -20,6 +20,8 @@
 #include "halo.hpp"
 #include "units/animation.hpp" //Note: only needed for enum
 
+#include <memory>
+
 class config;
 class unit;
 class unit_drawer;
@@ -38,13 +40,18 @@ public:
 	unit_animation_component(unit & my_unit) :
 		u_(my_unit),
 		anim_(nullptr),
-		animations_(),
+		animations_(std::make_shared<std::vector<unit_animation>>()),
 		state_(STATE_STANDING),
 		next_idling_(0),
 		frame_begin_time_(0),
 		draw_bars_(false),
 		refreshing_(false),
-		unit_halo_() {}
+		unit_halo_(),
+		registry_index_(registry_npos),
+		registry_standing_(false)
+	{
+		enroll();
+	}
 
 	/** Copy construct a unit animation component, for use when copy constructing a unit. */
 	unit_animation_component(unit & my_unit, const unit_animation_component & o) :
@@ -56,7 +63,19 @@ public:
 		frame_begin_time_(o.frame_begin_time_),
 		draw_bars_(o.draw_bars_),
 		refreshing_(o.refreshing_),
-		unit_halo_() {}
+		unit_halo_(),
+		registry_index_(registry_npos),
+		registry_standing_(false)
+	{
+		enroll();
+	}
+
+	~unit_animation_component();
+
+	// The registry bookkeeping must not be copied wholesale; copies go
+	// through the two-argument constructor above.
+	unit_animation_component(const unit_animation_component&) = delete;
+	unit_animation_component& operator=(const unit_animation_component&) = delete;
 
 	/** Chooses an appropriate animation from the list of known animations. */
 	const unit_animation* choose_animation(const display& disp,
@@ -93,6 +112,16 @@ public:
 	/** Intermittently activates the idling animations in place of the standing animations. Used by display object. */
 	void refresh();
 
+	/**
+	 * Runs the per-frame animation upkeep over the enrolled components only.
+	 *
+	 * Components with a running non-standing animation are refreshed every
+	 * frame; standing components are only refreshed once their idle wake
+	 * time comes up. This replaces refreshing every unit of the map each
+	 * frame. Must only be called while a display exists.
+	 */
+	static void refresh_active();
+
 	/** Clear the haloes associated to the unit */
 	void clear_haloes();
 
@@ -116,8 +145,14 @@ private:
 
 	/** The current animation. */
 	std::unique_ptr<unit_animation> anim_;
-	/** List of registered animations for this unit. */
-	std::vector<unit_animation> animations_;
+	/**
+	 * List of registered animations for this unit.
+	 *
+	 * This is normally the unit type's list, shared read-only by every unit
+	 * of that type; it is only cloned when a WML effect adds animations to
+	 * this particular unit.
+	 */
+	std::shared_ptr<const std::vector<unit_animation>> animations_;
 
 	/** animation state */
 	STATE state_;
@@ -134,4 +169,22 @@ private:
 
 	/** handle to the halo of this unit */
 	halo::handle unit_halo_;
+
+	/** Not enrolled in any registry. */
+	static constexpr std::size_t registry_npos = static_cast<std::size_t>(-1);
+
+	/**
+	 * (Re-)enrolls this component in the registry matching its state: the
+	 * active list for non-standing animations, the wake-scheduled standing
+	 * list otherwise. Called whenever an animation starts.
+	 */
+	void enroll();
+
+	/** Removes this component from its registry, if enrolled. */
+	void unenroll();
+
+	/** Position in the registry this component is enrolled in, or registry_npos. */
+	std::size_t registry_index_;
+	/** Whether registry_index_ refers to the standing (wake-scheduled) registry. */
+	bool registry_standing_;
 };
@@ -31,6 +31,7 @@
 #include "serialization/string_utils.hpp"
 #include "gettext.hpp"
 #include "utils/math.hpp"
+#include "utils/object_pool.hpp"
 
 #include <cassert>
 
@@ -47,6 +48,27 @@ static lg::log_domain log_unit("unit");
 static lg::log_domain log_wml("wml");
 #define ERR_WML LOG_STREAM(err, log_wml)
 
+void* attack_type::operator new(std::size_t size)
+{
+	// Sizes other than sizeof(attack_type) can only come from a derived
+	// class, which the pool's fixed block size cannot serve.
+	if(size != sizeof(attack_type)) {
+		return ::operator new(size);
+	}
+
+	return utils::object_pool<attack_type>::allocate();
+}
+
+void attack_type::operator delete(void* p, std::size_t size)
+{
+	if(size != sizeof(attack_type)) {
+		::operator delete(p);
+		return;
+	}
+
+	utils::object_pool<attack_type>::deallocate(p);
+}
+
 attack_type::attack_type(const config& cfg) :
 	self_loc_(),
 	other_loc_(),
@@ -67,6 +89,8 @@ attack_type::attack_type(const config& cfg) :
 	movement_used_(cfg["movement_used"].to_int(100000)),
 	parry_(cfg["parry"]),
 	specials_(cfg.child_or_empty("specials")),
+	special_names_(),
+	special_names_valid_(false),
 	changed_(true)
 {
 	if (description_.empty())
@@ -102,14 +126,19 @@ std::string attack_type::accuracy_parry_description() const
  */
 static bool matches_simple_filter(const attack_type & attack, const config & filter)
 {
-	const std::vector<std::string>& filter_range = utils::split(filter["range"]);
+	// The membership lists are only scanned, so views into the attribute
+	// strings suffice; the backing strings must outlive them.
+	const std::string& filter_range_str = filter["range"];
+	const std::vector<std::string_view> filter_range = utils::split_view(filter_range_str);
 	const std::string& filter_damage = filter["damage"];
 	const std::string& filter_attacks = filter["number"];
 	const std::string& filter_accuracy = filter["accuracy"];
 	const std::string& filter_parry = filter["parry"];
 	const std::string& filter_movement = filter["movement_used"];
-	const std::vector<std::string> filter_name = utils::split(filter["name"]);
-	const std::vector<std::string> filter_type = utils::split(filter["type"]);
+	const std::string& filter_name_str = filter["name"];
+	const std::vector<std::string_view> filter_name = utils::split_view(filter_name_str);
+	const std::string& filter_type_str = filter["type"];
+	const std::vector<std::string_view> filter_type = utils::split_view(filter_type_str);
 	const std::vector<std::string> filter_special = utils::split(filter["special"]);
 	const std::vector<std::string> filter_special_id = utils::split(filter["special_id"]);
 	const std::vector<std::string> filter_special_type = utils::split(filter["special_type"]);
@@ -329,6 +358,7 @@ bool attack_type::apply_modification(const config& cfg)
 			}
 		}
 		specials_ = new_specials;
+		special_names_valid_ = false;
 	}
 
 	if(set_specials) {
@@ -344,6 +374,7 @@ bool attack_type::apply_modification(const config& cfg)
 		for(const config::any_child value : set_specials.all_children_range()) {
 			specials_.add_child(value.key, value.cfg);
 		}
+		special_names_valid_ = false;
 	}
 
 	if(set_damage.empty() == false) {
@@ -38,6 +38,12 @@ namespace wfl {
 class attack_type : public std::enable_shared_from_this<attack_type>
 {
 public:
+	/**
+	 * Attack lists are deep-copied whenever a unit is cloned, so their
+	 * storage comes from a recycling pool instead of the global allocator.
+	 */
+	static void* operator new(std::size_t size);
+	static void operator delete(void* p, std::size_t size);
 
 	explicit attack_type(const config& cfg);
 	const t_string& name() const { return description_; }
@@ -67,7 +73,7 @@ public:
 	void set_num_attacks(int value) { num_attacks_ = value; set_changed(true); }
 	void set_attack_weight(double value) { attack_weight_ = value; set_changed(true); }
 	void set_defense_weight(double value) { defense_weight_ = value; set_changed(true); }
-	void set_specials(config value) { specials_ = value; set_changed(true); }
+	void set_specials(config value) { specials_ = value; special_names_valid_ = false; set_changed(true); }
 
 
 	// In unit_abilities.cpp:
@@ -281,6 +287,19 @@ private:
 	int movement_used_;
 	int parry_;
 	config specials_;
+
+	/**
+	 * Returns false only if no child of specials_ has @a id as its tag or
+	 * id=. A superset check: callers still have to match the exact special,
+	 * but most queries ask about a special the weapon doesn't carry at all
+	 * and can bail out here without walking the special configs.
+	 */
+	bool may_have_special(const std::string& id) const;
+
+	/** Sorted tag and id names of the children of specials_, see may_have_special(). */
+	mutable std::vector<std::string> special_names_;
+	mutable bool special_names_valid_;
+
 	bool changed_;
 };
 
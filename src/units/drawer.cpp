@@ -32,6 +32,7 @@
 #include "units/frame.hpp"
 #include "units/types.hpp"
 #include "units/unit.hpp"
+#include "utils/frame_profiler.hpp"
 
 // Map of different energy bar surfaces and their dimensions.
 static std::map<surface, SDL_Rect> energy_bar_rects;
@@ -91,6 +92,8 @@ unit_drawer::unit_drawer(display & thedisp) :
 
 void unit_drawer::redraw_unit (const unit & u) const
 {
+	PROFILE_ZONE("unit_drawer::redraw_unit");
+
 	unit_animation_component & ac = u.anim_comp();
 	map_location loc = u.get_location();
 
@@ -240,12 +243,20 @@ void unit_drawer::redraw_unit (const unit & u) const
 			const std::string selected = is_selected_hex? "selected-" : "";
 			const std::string tc       = team::get_side_color_id(side);
 
-			const std::string ellipse_top = formatter() << ellipse << "-" << leader << nozoc << selected << "top.png~RC(ellipse_red>" << tc << ")";
-			const std::string ellipse_bot = formatter() << ellipse << "-" << leader << nozoc << selected << "bottom.png~RC(ellipse_red>" << tc << ")";
+			const std::string key = formatter() << ellipse << "-" << leader << nozoc << selected << tc;
+
+			auto cached = ellipse_cache_.find(key);
+			if(cached == ellipse_cache_.end()) {
+				const std::string ellipse_top = formatter() << ellipse << "-" << leader << nozoc << selected << "top.png~RC(ellipse_red>" << tc << ")";
+				const std::string ellipse_bot = formatter() << ellipse << "-" << leader << nozoc << selected << "bottom.png~RC(ellipse_red>" << tc << ")";
+
+				cached = ellipse_cache_.emplace(key,
+					std::pair(image::locator(ellipse_top), image::locator(ellipse_bot))).first;
+			}
 
 			// Load the ellipse parts recolored to match team color
-			ellipse_back = image::get_image(image::locator(ellipse_top), image::SCALED_TO_ZOOM);
-			ellipse_front = image::get_image(image::locator(ellipse_bot), image::SCALED_TO_ZOOM);
+			ellipse_back = image::get_image(cached->second.first, image::SCALED_TO_ZOOM);
+			ellipse_front = image::get_image(cached->second.second, image::SCALED_TO_ZOOM);
 		}
 	}
 	if (ellipse_back != nullptr) {
@@ -278,10 +289,10 @@ void unit_drawer::redraw_unit (const unit & u) const
 		const std::string* energy_file = &game_config::images::energy;
 
 		using namespace orb_status_helper;
-		std::unique_ptr<image::locator> orb_img = nullptr;
+		const image::locator* orb_img = nullptr;
 		if(viewing_team_ref.is_enemy(side)) {
 			if(!u.incapacitated())
-				orb_img = get_orb_image(orb_status::enemy);
+				orb_img = get_orb_image_cached(orb_status::enemy).get();
 		} else if(static_cast<std::size_t>(side) != playing_team + 1) {
 			// We're looking at either the player's own unit or an ally's unit, but either way it
 			// doesn't belong to the playing_team and isn't expected to move until after its next
@@ -289,12 +300,12 @@ void unit_drawer::redraw_unit (const unit & u) const
 			auto os = orb_status::moved;
 			if(static_cast<std::size_t>(side) != viewing_team + 1)
 				os = orb_status::allied;
-			orb_img = get_orb_image(os);
+			orb_img = get_orb_image_cached(os).get();
 		} else {
 			// We're looking at either the player's own unit, or an ally's unit, during the unit's
 			// owner's turn.
 			auto os = dc.unit_orb_status(u);
-			orb_img = get_orb_image(os);
+			orb_img = get_orb_image_cached(os).get();
 		}
 
 		if(orb_img != nullptr) {
@@ -362,6 +373,16 @@ void unit_drawer::redraw_unit (const unit & u) const
 	ac.refreshing_ = false;
 }
 
+const std::unique_ptr<image::locator>& unit_drawer::get_orb_image_cached(orb_status os) const
+{
+	auto cached = orb_cache_.find(os);
+	if(cached == orb_cache_.end()) {
+		cached = orb_cache_.emplace(os, get_orb_image(os)).first;
+	}
+
+	return cached->second;
+}
+
 void unit_drawer::draw_bar(const std::string& image, int xpos, int ypos,
 		const map_location& loc, std::size_t height, double filled,
 		const color_t& col, fixed_t alpha) const
@@ -25,9 +25,14 @@
 #pragma once
 
 #include "map/location.hpp"
+#include "picture.hpp"
+#include "units/orb_status.hpp"
 #include "utils/math.hpp"
 
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 class display;
@@ -82,4 +87,18 @@ private:
 	 * White pixels are substituted for the color of the energy.
 	 */
 	const SDL_Rect& calculate_energy_bar(surface surf) const;
+
+	/** As the file-local get_orb_image(), but cached per status for this draw pass. */
+	const std::unique_ptr<image::locator>& get_orb_image_cached(orb_status os) const;
+
+	/**
+	 * Composed ellipse locators, keyed by every state that feeds their image
+	 * path. A drawer lives for a single draw pass, so the many idle units
+	 * sharing ellipse, team and ZoC state reuse one locator pair instead of
+	 * rebuilding the path strings and parsing their modifications per unit.
+	 */
+	mutable std::map<std::string, std::pair<image::locator, image::locator>> ellipse_cache_;
+
+	/** Orb locators by orb_status, cached for the same reason as @ref ellipse_cache_. */
+	mutable std::map<orb_status, std::unique_ptr<image::locator>> orb_cache_;
 };
@@ -114,6 +114,9 @@ struct unit_filter_xy : public unit_filter_base
 		}
 	}
 
+	// Interpolates variables on every evaluation.
+	virtual int cost() const override { return 2; }
+
 	const std::string x_;
 	const std::string y_;
 };
@@ -156,6 +159,9 @@ struct unit_filter_adjacent : public unit_filter_base
 		return in_ranges(match_count, !i_count.blank() ? utils::parse_ranges(i_count) : default_counts);
 	}
 
+	// Evaluates the child filter against up to six adjacent units.
+	virtual int cost() const override { return 4; }
+
 	const unit_filter_compound child_;
 	const vconfig cfg_;
 };
@@ -164,40 +170,46 @@ struct unit_filter_adjacent : public unit_filter_base
 template<typename F>
 struct unit_filter_child_literal : public unit_filter_base
 {
-	unit_filter_child_literal(const vconfig& v, const F& f) : v_(v) , f_(f) {}
+	unit_filter_child_literal(const vconfig& v, const F& f, int cost) : v_(v) , f_(f), cost_(cost) {}
 	virtual bool matches(const unit_filter_args& args) const override
 	{
 		return f_(v_, args);
 	}
+	virtual int cost() const override { return cost_; }
 	vconfig v_;
 	F f_;
+	int cost_;
 };
 
 template<typename T, typename F>
 struct unit_filter_attribute_parsed : public unit_filter_base
 {
-	unit_filter_attribute_parsed(T&& v, F&& f) : v_(std::move(v)), f_(std::move(f)) {}
+	unit_filter_attribute_parsed(T&& v, F&& f, int cost) : v_(std::move(v)), f_(std::move(f)), cost_(cost) {}
 	virtual bool matches(const unit_filter_args& args) const override
 	{
 		return f_(v_, args);
 	}
+	virtual int cost() const override { return cost_; }
 	T v_;
 	F f_;
+	int cost_;
 };
 
 template<typename C, typename F>
 struct unit_filter_attribute_literal : public unit_filter_base
 {
-	unit_filter_attribute_literal(std::string&& v, C&& c, F&& f) : v_(std::move(v)), c_(std::move(c)), f_(std::move(f)) {}
+	unit_filter_attribute_literal(std::string&& v, C&& c, F&& f, int cost) : v_(std::move(v)), c_(std::move(c)), f_(std::move(f)), cost_(cost) {}
 	virtual bool matches(const unit_filter_args& args) const override
 	{
 		config::attribute_value v;
 		v = utils::interpolate_variables_into_string(v_, *(resources::gamedata));
 		return f_(c_(v), args);
 	}
+	virtual int cost() const override { return cost_; }
 	std::string v_;
 	C c_;
 	F f_;
+	int cost_;
 };
 
 class contains_dollar_visitor
@@ -276,21 +288,23 @@ bool unit_filter_compound::filter_impl(const unit_filter_args& args) const
 }
 
 template<typename F>
-void unit_filter_compound::create_child(const vconfig& c, F func)
+void unit_filter_compound::create_child(const vconfig& c, F func, int cost)
 {
-	children_.emplace_back(new unit_filter_child_literal<F>(c, func));
+	children_.emplace_back(new unit_filter_child_literal<F>(c, func, cost));
 }
 
 template<typename C, typename F>
-void unit_filter_compound::create_attribute(const config::attribute_value v, C conv, F func)
+void unit_filter_compound::create_attribute(const config::attribute_value v, C conv, F func, int cost)
 {
 	if(v.blank()) {
 	}
 	else if(v.apply_visitor(contains_dollar_visitor())) {
-		children_.emplace_back(new unit_filter_attribute_literal<C, F>(std::move(v.str()), std::move(conv), std::move(func)));
+		// Re-interpreting the value on every evaluation makes this pricier
+		// than the pre-parsed form.
+		children_.emplace_back(new unit_filter_attribute_literal<C, F>(std::move(v.str()), std::move(conv), std::move(func), cost + 1));
 	}
 	else {
-		children_.emplace_back(new unit_filter_attribute_parsed<decltype(conv(v)), F>(std::move(conv(v)), std::move(func)));
+		children_.emplace_back(new unit_filter_attribute_parsed<decltype(conv(v)), F>(std::move(conv(v)), std::move(func), cost));
 	}
 }
 
@@ -445,7 +459,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return false;
-			}
+			},
+			3 // scans adjacent units
 		);
 
 		create_attribute(literal["ability_type_active"],
@@ -458,7 +473,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return false;
-			}
+			},
+			2 // active ability resolution
 		);
 
 		create_attribute(literal["trait"],
@@ -639,7 +655,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return false;
-			}
+			},
+			2 // terrain lookup
 		);
 
 		create_attribute(literal["movement_cost"],
@@ -653,7 +670,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return false;
-			}
+			},
+			2 // terrain lookup
 		);
 
 		create_attribute(literal["vision_cost"],
@@ -667,7 +685,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return false;
-			}
+			},
+			2 // terrain lookup
 		);
 
 		create_attribute(literal["jamming_cost"],
@@ -681,7 +700,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return false;
-			}
+			},
+			2 // terrain lookup
 		);
 
 		create_attribute(literal["lua_function"],
@@ -692,7 +712,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					return lk->run_filter(lua_function.c_str(), args.u);
 				}
 				return true;
-			}
+			},
+			3 // lua call
 		);
 
 		create_attribute(literal["formula"],
@@ -721,7 +742,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					// Formulae with syntax errors match nothing
 					return false;
 				}
-			}
+			},
+			3 // formula evaluation
 		);
 
 		create_attribute(literal["find_in"],
@@ -746,7 +768,8 @@ void unit_filter_compound::fill(vconfig cfg)
 					}
 				}
 				return true;
-			}
+			},
+			2 // variable array scan
 		);
 
 		if (!literal["x"].blank() || !literal["y"].blank()) {
@@ -823,4 +846,14 @@ void unit_filter_compound::fill(vconfig cfg)
 			}
 
 		}
+
+		// The predicates in children_ are all ANDed together, so evaluate
+		// the cheap ones first to reject non-matching units before the
+		// lua/formula/sub-filter checks run. The sort is stable, so
+		// predicates of equal cost keep their WML order.
+		std::stable_sort(children_.begin(), children_.end(),
+			[](const std::shared_ptr<unit_filter_base>& a, const std::shared_ptr<unit_filter_base>& b) {
+				return a->cost() < b->cost();
+			}
+		);
 	}
@@ -85,6 +85,13 @@ namespace unit_filter_impl
 	struct unit_filter_base
 	{
 		virtual bool matches(const unit_filter_args&) const = 0;
+
+		/**
+		 * Relative cost of evaluating this predicate, used to order the
+		 * cheap checks before the expensive ones inside a compound filter.
+		 */
+		virtual int cost() const { return 1; }
+
 		virtual ~unit_filter_base() {}
 	};
 
@@ -93,9 +100,9 @@ namespace unit_filter_impl
 		unit_filter_compound(vconfig cfg);
 
 		template<typename C, typename F>
-		void create_attribute(const config::attribute_value c, C conv, F func);
+		void create_attribute(const config::attribute_value c, C conv, F func, int cost = 1);
 		template<typename F>
-		void create_child(const vconfig& c, F func);
+		void create_child(const vconfig& c, F func, int cost = 4);
 
 		void fill(vconfig cfg);
 
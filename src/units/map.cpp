@@ -15,10 +15,12 @@
 */
 
 #include "log.hpp"
+#include "units/abilities.hpp"
 #include "units/id.hpp"
 #include "units/unit.hpp"
 
 #include "units/map.hpp"
+#include <algorithm>
 #include <functional>
 
 static lg::log_domain log_engine("engine");
@@ -28,14 +30,22 @@ static lg::log_domain log_engine("engine");
 #define DBG_NG LOG_STREAM(debug, log_engine)
 
 unit_map::unit_map()
-	: umap_()
+	: slots_()
+	, free_head_(npos)
+	, uid_index_()
 	, lmap_()
+	, occupied_()
+	, idmap_()
 {
 }
 
 unit_map::unit_map(const unit_map& that)
-	: umap_()
+	: slots_()
+	, free_head_(npos)
+	, uid_index_()
 	, lmap_()
+	, occupied_()
+	, idmap_()
 {
 	for(const auto& u : that) {
 		add(u.get_location(), u);
@@ -53,8 +63,12 @@ void unit_map::swap(unit_map& o)
 {
 	assert(num_iters() == 0 && o.num_iters() == 0);
 
-	std::swap(umap_, o.umap_);
+	std::swap(slots_, o.slots_);
+	std::swap(free_head_, o.free_head_);
+	std::swap(uid_index_, o.uid_index_);
 	std::swap(lmap_, o.lmap_);
+	std::swap(occupied_, o.occupied_);
+	std::swap(idmap_, o.idmap_);
 }
 
 unit_map::~unit_map()
@@ -62,16 +76,49 @@ unit_map::~unit_map()
 	clear(true);
 }
 
-unit_map::umap::iterator unit_map::begin_core() const
+unit_map::uid_index_t::iterator unit_map::uid_pos(std::size_t uid) const
+{
+	return std::lower_bound(uid_index_.begin(), uid_index_.end(), uid,
+			[](const uid_index_t::value_type& entry, std::size_t val) { return entry.first < val; });
+}
+
+void unit_map::release_slot(std::size_t slot) const
+{
+	unit_pod& pod = slots_[slot];
+	assert(pod.ref_count == 0 && !pod.unit);
+
+	uid_index_t::iterator pos = uid_pos(pod.uid);
+	assert(pos != uid_index_.end() && pos->second == slot);
+	uid_index_.erase(pos);
+
+	pod.uid = 0;
+	pod.next_free = free_head_;
+	free_head_ = slot;
+}
+
+std::size_t unit_map::acquire_slot()
+{
+	if(free_head_ != npos) {
+		const std::size_t slot = free_head_;
+		free_head_ = slots_[slot].next_free;
+		slots_[slot].next_free = npos;
+		return slot;
+	}
+
+	slots_.emplace_back();
+	return slots_.size() - 1;
+}
+
+std::size_t unit_map::begin_core() const
 {
 	self_check();
 
-	umap::iterator i = umap_.begin();
-	while(i != umap_.end() && (!i->second.unit)) {
-		++i;
+	uid_index_t::const_iterator pos = uid_index_.begin();
+	while(pos != uid_index_.end() && (!slots_[pos->second].unit)) {
+		++pos;
 	}
 
-	return i;
+	return pos == uid_index_.end() ? npos : pos->second;
 }
 
 unit_map::umap_retval_pair_t unit_map::add(const map_location& l, const unit& u)
@@ -98,72 +145,91 @@ unit_map::umap_retval_pair_t unit_map::move(const map_location& src, const map_l
 	// Find the unit at the src location
 	lmap::iterator i = lmap_.find(src);
 	if(i == lmap_.end()) {
-		return std::pair(make_unit_iterator(i), false);
+		return std::pair(make_unit_iterator(npos), false);
 	}
 
-	umap::iterator uit(i->second);
+	const std::size_t slot = i->second;
 
 	if(src == dst) {
-		return std::pair(make_unit_iterator(uit), true);
+		return std::pair(make_unit_iterator(slot), true);
 	}
 
 	// Fail if there is no unit to move.
-	unit_ptr p = uit->second.unit;
+	unit_ptr p = slots_[slot].unit;
 	if(!p) {
-		return std::pair(make_unit_iterator(uit), false);
+		return std::pair(make_unit_iterator(slot), false);
 	}
 
 	p->set_location(dst);
 
 	lmap_.erase(i);
+	occupied_erase(src);
 
-	std::pair<lmap::iterator, bool> res = lmap_.emplace(dst, uit);
+	std::pair<lmap::iterator, bool> res = lmap_.emplace(dst, slot);
 
 	// Fail and don't move if the destination is already occupied.
 	if(res.second == false) {
 		p->set_location(src);
-		lmap_.emplace(src, uit);
-		return std::pair(make_unit_iterator(uit), false);
+		lmap_.emplace(src, slot);
+		occupied_insert(src);
+		return std::pair(make_unit_iterator(slot), false);
 	}
 
+	occupied_insert(dst);
+	unit_abilities::invalidate_cache();
+
 	self_check();
 
-	return std::pair(make_unit_iterator(uit), true);
+	return std::pair(make_unit_iterator(slot), true);
 }
 
 unit_map::umap_retval_pair_t unit_map::insert(unit_ptr p)
 {
-	// 1. Construct a unit_pod.
-	// 2. Try insertion into the umap.
-	// 3. Try insertion in the lmap and remove the umap entry on failure.
+	// 1. Find a slot: a fresh one, or the ghost slot still wearing this uid.
+	// 2. Try insertion in the lmap and undo the slot changes on failure.
 
 	self_check();
 	assert(p);
 
-	std::size_t unit_id = p->underlying_id();
 	const map_location& loc = p->get_location();
 
 	if(!loc.valid()) {
 		ERR_NG << "Trying to add " << p->name() << " - " << p->id() << " at an invalid location; Discarding.\n";
-		return std::pair(make_unit_iterator(umap_.end()), false);
+		return std::pair(make_unit_iterator(npos), false);
 	}
 
-	unit_pod upod;
-	upod.unit = p;
-
 	DBG_NG << "Adding unit " << p->underlying_id() << " - " << p->id() << " to location: (" << loc << ")\n";
 
-	std::pair<umap::iterator, bool> uinsert = umap_.emplace(unit_id, upod);
+	std::size_t slot = npos;
+	bool virgin = true;
+	int guard(0);
+
+	while(true) {
+		const std::size_t unit_id = p->underlying_id();
+		uid_index_t::iterator pos = uid_pos(unit_id);
+
+		if(pos == uid_index_.end() || pos->first != unit_id) {
+			// Unused uid; take a fresh slot.
+			slot = acquire_slot();
+			slots_[slot].unit = p;
+			slots_[slot].uid = unit_id;
+			uid_index_.insert(pos, {unit_id, slot});
+			virgin = true;
+			break;
+		}
+
+		if(!slots_[pos->second].unit) {
+			// If the slot is empty reinsert the unit in the same slot.
+			slot = pos->second;
+			slots_[slot].unit = p;
 
-	if(!uinsert.second) {
-		// If the pod is empty reinsert the unit in the same list element.
-		if(!uinsert.first->second.unit) {
-			unit_pod& opod = uinsert.first->second;
-			opod.unit = p;
+			assert(slots_[slot].ref_count != 0);
+			virgin = false;
+			break;
+		}
 
-			assert(opod.ref_count != 0);
-		} else {
-			unit_ptr q = uinsert.first->second.unit;
+		unit_ptr q = slots_[pos->second].unit;
+		if(guard == 0) {
 			ERR_NG << "Trying to add " << p->name()
 				   << " - " << p->id() << " - " << p->underlying_id()
 				   << " ("  << loc << ") over " << q->name()
@@ -174,51 +240,47 @@ unit_map::umap_retval_pair_t unit_map::insert(unit_ptr p)
 			p->mark_clone(false);
 			ERR_NG << "The new unit was assigned underlying_id=" << p->underlying_id()
 				   << " to prevent duplicate id conflicts.\n";
-
-			uinsert = umap_.emplace(p->underlying_id(), upod);
-
-			int guard(0);
-			while(!uinsert.second && (++guard < 1e6)) {
-				if(guard % 10 == 9) {
-					ERR_NG << "\n\nPlease Report this error to https://gna.org/bugs/index.php?18591 "
-						"\nIn addition to the standard details of operating system and wesnoth version "
-						"and how it happened, please answer the following questions "
-						"\n 1. Were you playing multi-player?"
-						"\n 2. Did you start/restart/reload the game/scenario?"
-						"\nThank you for your help in fixing this bug.\n";
-				}
-
-				p->mark_clone(false);
-				uinsert = umap_.emplace(p->underlying_id(), upod);
+		} else {
+			if(guard % 10 == 9) {
+				ERR_NG << "\n\nPlease Report this error to https://gna.org/bugs/index.php?18591 "
+					"\nIn addition to the standard details of operating system and wesnoth version "
+					"and how it happened, please answer the following questions "
+					"\n 1. Were you playing multi-player?"
+					"\n 2. Did you start/restart/reload the game/scenario?"
+					"\nThank you for your help in fixing this bug.\n";
 			}
 
-			if(!uinsert.second) {
-				throw game::error("One million collisions in unit_map");
-			}
+			p->mark_clone(false);
+		}
+
+		if(++guard >= 1e6) {
+			throw game::error("One million collisions in unit_map");
 		}
 	}
 
-	std::pair<lmap::iterator, bool> linsert = lmap_.emplace(loc, uinsert.first);
+	std::pair<lmap::iterator, bool> linsert = lmap_.emplace(loc, slot);
 
 	// Fail if the location is occupied
 	if(!linsert.second) {
-		if(upod.ref_count == 0) {
+		slots_[slot].unit.reset();
+		if(virgin) {
 			// Undo a virgin insertion
-			umap_.erase(uinsert.first);
-		} else {
-			// undo a reinsertion
-			uinsert.first->second.unit.reset();
+			release_slot(slot);
 		}
 
 		DBG_NG << "Trying to add " << p->name() << " - " << p->id() << " at location (" << loc << "); Occupied  by "
-			   << (linsert.first->second->second).unit->name() << " - " << linsert.first->second->second.unit->id()
+			   << slots_[linsert.first->second].unit->name() << " - " << slots_[linsert.first->second].unit->id()
 			   << "\n";
 
-		return std::pair(make_unit_iterator(umap_.end()), false);
+		return std::pair(make_unit_iterator(npos), false);
 	}
 
+	occupied_insert(loc);
+	idmap_[p->id()] = slots_[slot].uid;
+	unit_abilities::invalidate_cache();
+
 	self_check();
-	return std::pair(make_unit_iterator(uinsert.first), true);
+	return std::pair(make_unit_iterator(slot), true);
 }
 
 unit_map::umap_retval_pair_t unit_map::replace(const map_location& l, unit_ptr p)
@@ -233,17 +295,15 @@ std::size_t unit_map::num_iters() const
 {
 	/** Add up number of extant iterators */
 	std::size_t num_iters(0);
-	umap::const_iterator ui = umap_.begin();
-	umap::const_iterator uend = umap_.end();
 
-	for(; ui != uend; ++ui) {
-		if(ui->second.ref_count < 0) {
+	for(const unit_pod& pod : slots_) {
+		if(pod.ref_count < 0) {
 			// Somewhere, someone generated 2^31 iterators to this unit.
 			bool a_reference_counter_overflowed(false);
 			assert(a_reference_counter_overflowed);
 		}
 
-		num_iters += ui->second.ref_count;
+		num_iters += pod.ref_count;
 	}
 
 	return num_iters;
@@ -253,15 +313,19 @@ void unit_map::clear(bool force)
 {
 	assert(force || (num_iters() == 0));
 
-	for(umap::iterator i = umap_.begin(); i != umap_.end(); ++i) {
-		if(is_valid(i)) {
-			DBG_NG << "Delete unit " << i->second.unit->underlying_id() << "\n";
-			i->second.unit.reset();
+	for(unit_pod& pod : slots_) {
+		if(pod.unit) {
+			DBG_NG << "Delete unit " << pod.unit->underlying_id() << "\n";
+			pod.unit.reset();
 		}
 	}
 
 	lmap_.clear();
-	umap_.clear();
+	slots_.clear();
+	uid_index_.clear();
+	free_head_ = npos;
+	occupied_.clear();
+	idmap_.clear();
 }
 
 unit_ptr unit_map::extract(const map_location& loc)
@@ -273,22 +337,30 @@ unit_ptr unit_map::extract(const map_location& loc)
 		return unit_ptr();
 	}
 
-	umap::iterator uit(i->second);
+	const std::size_t slot = i->second;
+	unit_pod& pod = slots_[slot];
 
-	unit_ptr u = uit->second.unit;
+	unit_ptr u = pod.unit;
 	std::size_t uid(u->underlying_id());
 
 	DBG_NG << "Extract unit " << uid << " - " << u->id() << " from location: (" << loc << ")\n";
 
-	assert(uit->first == uit->second.unit->underlying_id());
-	if(uit->second.ref_count == 0) {
-		umap_.erase(uit);
-	} else {
-		// Soft extraction keeps the old lit item if any iterators reference it
-		uit->second.unit.reset();
+	assert(pod.uid == uid);
+	pod.unit.reset();
+	if(pod.ref_count == 0) {
+		release_slot(slot);
 	}
+	// A soft extraction keeps the slot pinned while iterators reference it.
 
 	lmap_.erase(i);
+	occupied_erase(loc);
+
+	const auto idhint = idmap_.find(u->id());
+	if(idhint != idmap_.end() && idhint->second == uid) {
+		idmap_.erase(idhint);
+	}
+
+	unit_abilities::invalidate_cache();
 	self_check();
 
 	return u;
@@ -311,18 +383,46 @@ unit_map::unit_iterator unit_map::find(std::size_t id)
 {
 	self_check();
 
-	umap::iterator i(umap_.find(id));
-	if((i != umap_.end()) && !i->second.unit) {
-		i = umap_.end();
+	uid_index_t::iterator pos = uid_pos(id);
+	std::size_t slot = npos;
+	if(pos != uid_index_.end() && pos->first == id && slots_[pos->second].unit) {
+		slot = pos->second;
 	}
 
-	return make_unit_iterator<umap::iterator>(i);
+	return make_unit_iterator(slot);
 }
 
 unit_map::unit_iterator unit_map::find(const map_location& loc)
 {
 	self_check();
-	return make_unit_iterator<lmap::iterator>(lmap_.find(loc));
+
+	lmap::iterator i = lmap_.find(loc);
+	return make_unit_iterator(is_found(i) ? i->second : npos);
+}
+
+unit_map::unit_iterator unit_map::find(const std::string& id)
+{
+	self_check();
+
+	const auto hint = idmap_.find(id);
+	if(hint != idmap_.end()) {
+		unit_iterator res = find(hint->second);
+		if(res.valid() && res->id() == id) {
+			return res;
+		}
+
+		// The unit wearing this id is gone or has been renamed.
+		idmap_.erase(hint);
+	}
+
+	for(unit_iterator it = begin(); it != end(); ++it) {
+		if(it->id() == id) {
+			idmap_[id] = it->underlying_id();
+			return it;
+		}
+	}
+
+	return end();
 }
 
 unit_map::unit_iterator unit_map::find_leader(int side)
@@ -380,41 +480,51 @@ bool unit_map::self_check() const
 #ifdef DEBUG_UNIT_MAP
 	bool good(true);
 
-	umap::const_iterator uit(umap_.begin());
-	for(; uit != umap_.end(); ++uit) {
-		if(uit->second.ref_count < 0) {
+	for(std::size_t slot = 0; slot != slots_.size(); ++slot) {
+		const unit_pod& pod = slots_[slot];
+
+		if(pod.ref_count < 0) {
 			good = false;
-			ERR_NG << "unit_map pod ref_count <0 is " << uit->second.ref_count << std::endl;
+			ERR_NG << "unit_map pod ref_count <0 is " << pod.ref_count << std::endl;
 		}
 
-		if(uit->second.unit) {
-			uit->second.unit->id(); // crash if bad pointer
+		if(pod.unit) {
+			pod.unit->id(); // crash if bad pointer
 		}
 
-		if(uit->first <= 0) {
+		if(!pod.unit && pod.ref_count == 0 && pod.uid != 0) {
 			good = false;
-			ERR_NG << "unit_map umap uid <=0 is " << uit->first << std::endl;
+			ERR_NG << "unit_map slot unit==nullptr when refcount == 0" << std::endl;
 		}
 
-		if(!uit->second.unit && uit->second.ref_count == 0) {
+		if(pod.unit && pod.unit->underlying_id() != pod.uid) {
 			good = false;
-			ERR_NG << "unit_map umap unit==nullptr when refcount == 0" << std::endl;
+			ERR_NG << "unit_map slot uid(" << pod.uid << ") != underlying_id()[" << pod.unit->underlying_id() << "]"
+				   << std::endl;
 		}
+	}
 
-		if(uit->second.unit && uit->second.unit->underlying_id() != uit->first) {
+	std::size_t prev_uid(0);
+	for(const uid_index_t::value_type& entry : uid_index_) {
+		if(entry.first <= prev_uid) {
 			good = false;
-			ERR_NG << "unit_map umap uid(" << uit->first << ") != underlying_id()[" << uit->second.unit->underlying_id()
-				   << "]" << std::endl;
+			ERR_NG << "unit_map uid_index out of order at uid " << entry.first << std::endl;
+		}
+		prev_uid = entry.first;
+
+		if(entry.second >= slots_.size() || slots_[entry.second].uid != entry.first) {
+			good = false;
+			ERR_NG << "unit_map uid_index entry does not match its slot " << std::endl;
 		}
 	}
 
 	lmap::const_iterator locit(lmap_.begin());
 	for(; locit != lmap_.end(); ++locit) {
-		if(locit->second == umap_.end()) {
+		if(locit->second >= slots_.size()) {
 			good = false;
-			ERR_NG << "unit_map lmap element == umap_.end() " << std::endl;
+			ERR_NG << "unit_map lmap slot out of range " << std::endl;
 		}
-		if(locit->first != locit->second->second.unit->get_location()) {
+		if(locit->first != slots_[locit->second].unit->get_location()) {
 			good = false;
 			ERR_NG << "unit_map lmap location != unit->get_location() " << std::endl;
 		}
@@ -431,8 +541,8 @@ bool unit_map::has_unit(const unit* const u) const
 {
 	assert(u);
 
-	for(const umap::value_type& item : umap_) {
-		if(item.second.unit.get() == u) {
+	for(const unit_pod& pod : slots_) {
+		if(pod.unit.get() == u) {
 			return true;
 		}
 	}
@@ -445,6 +555,74 @@ bool unit_map::has_unit_at(const map_location& loc) const
 	return find(loc) != end();
 }
 
+void unit_map::occupied_insert(const map_location& loc)
+{
+	occupied_[loc.y].insert(loc.x);
+}
+
+void unit_map::occupied_erase(const map_location& loc)
+{
+	std::map<int, std::set<int>>::iterator row = occupied_.find(loc.y);
+	if(row == occupied_.end()) {
+		return;
+	}
+
+	row->second.erase(loc.x);
+	if(row->second.empty()) {
+		occupied_.erase(row);
+	}
+}
+
+std::vector<unit_map::unit_iterator> unit_map::units_in_rect(int x1, int y1, int x2, int y2)
+{
+	self_check();
+
+	std::vector<unit_iterator> res;
+
+	std::map<int, std::set<int>>::const_iterator row = occupied_.lower_bound(y1);
+	for(; row != occupied_.end() && row->first <= y2; ++row) {
+		std::set<int>::const_iterator x = row->second.lower_bound(x1);
+		for(; x != row->second.end() && *x <= x2; ++x) {
+			lmap::iterator i = lmap_.find(map_location(*x, row->first));
+			if(is_valid(i)) {
+				res.push_back(make_unit_iterator(i->second));
+			}
+		}
+	}
+
+	return res;
+}
+
+std::vector<unit_map::const_unit_iterator> unit_map::units_in_rect(int x1, int y1, int x2, int y2) const
+{
+	const std::vector<unit_iterator>& units = const_cast<unit_map*>(this)->units_in_rect(x1, y1, x2, y2);
+	return std::vector<const_unit_iterator>(units.begin(), units.end());
+}
+
+std::vector<unit_map::unit_iterator> unit_map::units_in_radius(const map_location& center, int radius)
+{
+	std::vector<unit_iterator> res;
+	if(radius < 0) {
+		return res;
+	}
+
+	// Probe the bounding rectangle, then discard the corners that the
+	// hex distance metric excludes.
+	for(unit_iterator& ui : units_in_rect(center.x - radius, center.y - radius, center.x + radius, center.y + radius)) {
+		if(distance_between(center, ui->get_location()) <= std::size_t(radius)) {
+			res.push_back(ui);
+		}
+	}
+
+	return res;
+}
+
+std::vector<unit_map::const_unit_iterator> unit_map::units_in_radius(const map_location& center, int radius) const
+{
+	const std::vector<unit_iterator>& units = const_cast<unit_map*>(this)->units_in_radius(center, radius);
+	return std::vector<const_unit_iterator>(units.begin(), units.end());
+}
+
 void swap(unit_map& lhs, unit_map& rhs)
 {
 	lhs.swap(rhs);
@@ -23,24 +23,31 @@
 #include <cassert>
 #include <list>
 #include <map>
+#include <set>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 //#define DEBUG_UNIT_MAP
 
 /**
  * Container associating units to locations.
  *
- * The indirection location -> underlying_id -> unit ensures that iterators stay valid even if WML
+ * The indirection location -> slot -> unit ensures that iterators stay valid even if WML
  * modifies or moves units on the fly. They even stay valid if a unit is erased from the map and
  * another unit with the same underlying id is inserted in the map. In other words, it is a doubly
  * indexed ordered map with persistent iterators (that never invalidate).
  *
- * @note The unit_map is implemented as 2 maps: an unordered map that stores iterators from the
- * ordered map of reference-counted pointers to units.
+ * @note The unit_map stores its units in a contiguous slot vector with free-list reuse, so
+ * whole-roster passes stream through memory instead of chasing tree nodes. A flat vector sorted
+ * by underlying_id maps ids to slots and drives iteration, and an unordered map resolves
+ * locations to slots in O(1).
  *
- * The unordered map provides O(1) find times. The ordered map ensures ordering of units by
- * underlying_id. The reference counting is what guarantees the persistent iterators. Storing an
- * iterator only prevents that dead unit's id-map entry from being recovered.
+ * Iteration visits units ordered by underlying_id. That order only depends on the ids of the
+ * units present - not on the insertion and erasure history - which keeps whole-map passes
+ * deterministic across clients and across save/reload. The per-slot reference counting is what
+ * guarantees the persistent iterators: a slot whose unit died is only recycled once no iterator
+ * points at it anymore.
  *
  * @note Preferred usages for tight loops follows:
  *
@@ -74,51 +81,59 @@
  *
  * ================================================================================================
  *
- *
- * @note The previous implementation was 2 binary tree based maps: a location map pointing to another.
- * Lookups were O(2*log(N)) and O(log(N)). Order was implicit in the id map chosen as the base.
- * Persistence was provided by reference counting all iterators collectively and only recovering space
- * when there were no iterators outstanding. Even 1 iterator being stored caused a leak, because all
- * space for dead units was not recovered.
- *
  * @note Units are owned by the container.
  *
  * @note The indirection does not involve map lookups whenever an iterator is dereferenced, it just
- * causes a pointer indirection. The downside is that incrementing iterators is not O(1).
+ * causes an index into the slot vector. The downside is that incrementing iterators is not O(1).
  *
  * @note The code does not involve any magic, so units moved while being iterated upon may be skipped
  * or visited twice.
  *
- * @note Iterators prevent ghost units from being collected, so they should never be stored in data
- * structures, as it will cause slowdowns!
+ * @note Iterators prevent ghost units' slots from being recycled, so they should never be stored
+ * in data structures, as it will cause slowdowns!
  *
  * @note By popular demand iterators are effectively permanent. They are handles and not iterators.
  * Any access might cause a full lookup. Keeping iterators around holds onto memory.
  */
 class unit_map
 {
-	/** The pointer to the unit and a reference counter to record the number of extant iteratorspointing to this unit. */
+public:
+	/** Invalid slot index; used as the end() sentinel. */
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+	/**
+	 * One storage slot: the unit, its underlying id, and a reference counter recording the number
+	 * of extant iterators pointing at the slot. Dead units have a unit pointer equal to nullptr;
+	 * the slot is recycled through the free list iff the reference counter equals zero and there
+	 * are no more iterators pointing to this unit.
+	 */
 	struct unit_pod
 	{
 		unit_pod()
 			: unit()
+			, uid(0)
+			, next_free(npos)
 			, ref_count()
 		{
 		}
 
 		unit_ptr unit;
+		/** underlying_id of the unit this slot holds (or held, while iterators remain). */
+		std::size_t uid;
+		/** Free-list link while the slot is unoccupied. */
+		std::size_t next_free;
 		mutable n_ref_counter::ref_counter<signed int> ref_count;
 	};
 
-	/*
-	 * Map of underlying_id to unit and a reference counter. Dead units have a unit pointer equal to nullptr.
-	 * The map entry is removed iff the reference counter equals zero and there are no more
-	 * iterators pointing to this unit.
-	 */
-	typedef std::map<std::size_t, unit_pod> umap;
+	/** Contiguous slot storage. Mutable so const iterators can recycle abandoned slots. */
+	typedef std::vector<unit_pod> slot_vector;
+
+	/** underlying_id -> slot, kept sorted by id; drives ordered iteration. */
+	typedef std::vector<std::pair<std::size_t, std::size_t>> uid_index_t;
 
-	/** Map of location to umap iterator. */
-	typedef std::unordered_map<map_location, umap::iterator> lmap;
+	/** Map of location to slot index. */
+	typedef std::unordered_map<map_location, std::size_t> lmap;
 
 public:
 	// ~~~ Begin iterator code ~~~
@@ -126,14 +141,14 @@ public:
 	struct standard_iter_types
 	{
 		typedef unit_map container_type;
-		typedef unit_map::umap::iterator iterator_type;
+		typedef std::size_t iterator_type;
 		typedef unit value_type;
 	};
 
 	struct const_iter_types
 	{
 		typedef unit_map const container_type;
-		typedef unit_map::umap::iterator iterator_type;
+		typedef std::size_t iterator_type;
 		typedef const unit value_type;
 	};
 
@@ -154,7 +169,7 @@ public:
 		}
 
 		iterator_base()
-			: i_()
+			: i_(npos)
 			, tank_(nullptr)
 		{
 		}
@@ -193,22 +208,11 @@ public:
 			return iterator_base<const_iter_types>(i_, tank_);
 		}
 
-	private:
-		/** Constructs an iterator from the location map. */
-		iterator_base(lmap::iterator ui, container_type* m)
-			: i_(ui->second)
-			, tank_(m)
-		{
-			inc();
-			valid_exit();
-		}
-
-	public:
 		pointer operator->() const
 		{
 			assert(valid());
 			tank_->self_check();
-			return i_->second.unit;
+			return pod().unit;
 		}
 
 		/**
@@ -224,17 +228,24 @@ public:
 		{
 			tank_->self_check();
 			assert(valid());
-			return *i_->second.unit;
+			return *pod().unit;
 		}
 
 		iterator_base& operator++()
 		{
 			assert(valid_entry());
 			tank_->self_check();
-			iterator_type new_i(i_);
+
+			// Find the next live slot in id order before dec() possibly
+			// recycles the current one.
+			auto pos = tank_->uid_pos(pod().uid);
+			assert(pos != tank_->uid_index_.end());
 			do {
-				++new_i;
-			} while((new_i != the_map().end()) && (!new_i->second.unit));
+				++pos;
+			} while(pos != tank_->uid_index_.end() && !tank_->slots_[pos->second].unit);
+
+			const iterator_type new_i = (pos == tank_->uid_index_.end()) ? npos : pos->second;
+
 			dec();
 			i_ = new_i;
 			inc();
@@ -251,13 +262,20 @@ public:
 
 		iterator_base& operator--()
 		{
-			assert(tank_ && i_ != the_map().begin());
+			assert(tank_);
 			tank_->self_check();
-			iterator_type begin(the_map().begin());
-			dec();
+
+			auto begin = tank_->uid_index_.begin();
+			auto pos = (i_ == npos) ? tank_->uid_index_.end() : tank_->uid_pos(pod().uid);
+			assert(pos != begin);
 			do {
-				--i_;
-			} while(i_ != begin && (!i_->second.unit));
+				--pos;
+			} while(pos != begin && !tank_->slots_[pos->second].unit);
+
+			const iterator_type new_i = pos->second;
+
+			dec();
+			i_ = new_i;
 			inc();
 
 			valid_exit();
@@ -273,7 +291,7 @@ public:
 
 		bool valid() const
 		{
-			return (valid_for_dereference() && i_->second.unit);
+			return (valid_for_dereference() && pod().unit);
 		}
 
 		explicit operator bool() const
@@ -297,59 +315,58 @@ public:
 	private:
 		bool valid_for_dereference() const
 		{
-			return (tank_ != nullptr) && (i_ != the_map().end());
+			return (tank_ != nullptr) && (i_ != npos);
 		}
 
 		bool valid_entry() const
 		{
-			return ((tank_ != nullptr) && (i_ != the_map().end()));
+			return ((tank_ != nullptr) && (i_ != npos));
 		}
 
 		void valid_exit() const
 		{
-			if((tank_ != nullptr) && i_ != the_map().end()) {
-				assert(i_->second.ref_count > 0);
+			if((tank_ != nullptr) && i_ != npos) {
+				assert(pod().ref_count > 0);
 			}
 		}
 
 		bool valid_ref_count() const
 		{
-			return (tank_ != nullptr) && (i_ != the_map().end());
+			return (tank_ != nullptr) && (i_ != npos);
+		}
+
+		/** The slot this iterator pins. */
+		const unit_pod& pod() const
+		{
+			return tank_->slots_[i_];
 		}
 
 		/** Increment the reference counter. */
 		void inc()
 		{
 			if(valid_ref_count()) {
-				++(i_->second.ref_count);
+				++(pod().ref_count);
 			}
 		}
 
 		/**
 		 * Decrement the reference counter
-		 * Delete the umap entry if the unit is gone and the reference counter is zero.
-		 *
-		 * @note this deletion will advance i_ to the next umap entry.
+		 * Recycle the slot if the unit is gone and the reference counter is zero.
 		 */
 		void dec()
 		{
 			if(valid_ref_count()) {
-				assert(i_->second.ref_count != 0);
-				if((--(i_->second.ref_count) == 0) && (!i_->second.unit)) {
-					iterator_type old = i_++;
-					tank_->umap_.erase(old);
+				assert(pod().ref_count != 0);
+				if((--(pod().ref_count) == 0) && (!pod().unit)) {
+					tank_->release_slot(i_);
+					i_ = npos;
 				}
 			}
 		}
 
-		unit_map::umap& the_map() const
-		{
-			return tank_->umap_;
-		}
-
 		friend class unit_map;
 
-		/** local iterator */
+		/** slot index, or npos for the end iterator */
 		iterator_type i_;
 		/** the unit_map for i_ */
 		container_type* tank_;
@@ -374,6 +391,9 @@ public:
 	unit_iterator find(std::size_t id);
 	unit_iterator find(const map_location& loc);
 
+	/** Finds the unit with the given string id. O(1) in the common case, see @ref idmap_. */
+	unit_iterator find(const std::string& id);
+
 	const_unit_iterator find(const map_location& loc) const
 	{
 		return const_cast<unit_map*>(this)->find(loc);
@@ -384,6 +404,11 @@ public:
 		return const_cast<unit_map*>(this)->find(id);
 	}
 
+	const_unit_iterator find(const std::string& id) const
+	{
+		return const_cast<unit_map*>(this)->find(id);
+	}
+
 	template<typename T>
 	unit_ptr find_unit_ptr(const T& val)
 	{
@@ -428,12 +453,12 @@ public:
 
 	unit_iterator end()
 	{
-		return make_unit_iterator(umap_.end());
+		return make_unit_iterator(npos);
 	}
 
 	const_unit_iterator end() const
 	{
-		return make_const_unit_iterator(umap_.end());
+		return make_const_unit_iterator(npos);
 	}
 
 	std::size_t size() const
@@ -467,10 +492,10 @@ public:
 	/**
 	 * Inserts the unit pointed to by @a p into the map.
 	 *
-	 * If insertion into either the unit or location map fails, all operations are reverted.
+	 * If insertion into either the id or location index fails, all operations are reverted.
 	 *
-	 * The one oddity is that to facilitate non-invalidating iterators, the list sometimes has
-	 * nullptr pointers which should be used when they correspond to uids previously used.
+	 * The one oddity is that to facilitate non-invalidating iterators, a slot sometimes holds a
+	 * nullptr unit which should be refilled when it corresponds to a uid previously used.
 	 *
 	 * @returns         A pair consisting of an iterator pointing to the new unit (or the unit
 	 *                  already occupying that location) and a bool indicating success.
@@ -540,22 +565,40 @@ public:
 	/** Tests whether a unit exists at the given location. */
 	bool has_unit_at(const map_location& loc) const;
 
+	/**
+	 * Finds all units inside the given rectangle of hexes (inclusive bounds).
+	 *
+	 * Backed by the row index, so the cost scales with the number of units
+	 * inside the rectangle rather than the number of units on the map.
+	 */
+	std::vector<unit_iterator> units_in_rect(int x1, int y1, int x2, int y2);
+
+	std::vector<const_unit_iterator> units_in_rect(int x1, int y1, int x2, int y2) const;
+
+	/** Finds all units within @a radius hexes of @a center, including one at @a center itself. */
+	std::vector<unit_iterator> units_in_radius(const map_location& center, int radius);
+
+	std::vector<const_unit_iterator> units_in_radius(const map_location& center, int radius) const;
+
 private:
-	umap::iterator begin_core() const;
+	/** First live slot in id order, or npos. */
+	std::size_t begin_core() const;
 
-	bool is_valid(const umap::const_iterator& i) const
-	{
-		return is_found(i) && (i->second.unit != nullptr);
-	}
+	/** Position of @a uid in @ref uid_index_ (lower bound). */
+	uid_index_t::iterator uid_pos(std::size_t uid) const;
 
-	bool is_valid(const lmap::const_iterator& i) const
-	{
-		return is_found(i) && (i->second->second.unit != nullptr);
-	}
+	/**
+	 * Returns the slot of an abandoned unit to the free list and drops its id index entry.
+	 * @pre The slot's unit is gone and no iterators reference it.
+	 */
+	void release_slot(std::size_t slot) const;
+
+	/** Takes a slot off the free list, or grows the slot vector. */
+	std::size_t acquire_slot();
 
-	bool is_found(const umap::const_iterator& i) const
+	bool is_valid(const lmap::const_iterator& i) const
 	{
-		return i != umap_.end();
+		return is_found(i) && (slots_[i->second].unit != nullptr);
 	}
 
 	bool is_found(const lmap::const_iterator& i) const
@@ -563,36 +606,62 @@ private:
 		return i != lmap_.end();
 	}
 
-	template<typename X>
-	unit_map::unit_iterator make_unit_iterator(const X& i)
+	unit_iterator make_unit_iterator(std::size_t slot)
 	{
-		if(!is_found(i)) {
-			return unit_iterator(umap_.end(), this);
-		}
-
-		return unit_iterator(i, this);
+		return unit_iterator(slot, this);
 	}
 
-	template<typename X>
-	unit_map::const_unit_iterator make_const_unit_iterator(const X& i) const
+	const_unit_iterator make_const_unit_iterator(std::size_t slot) const
 	{
-		if(!is_found(i)) {
-			return const_unit_iterator(umap_.end(), this);
-		}
-
-		return const_unit_iterator(i, this);
+		return const_unit_iterator(slot, this);
 	}
 
 	/**
-	 * underlying_id -> unit_pod.
-	 * This requires that underlying_id be unique (which is enforced in unit_map::insert).
+	 * The units, stored contiguously. Slots of erased units are reused through @ref free_head_
+	 * once no iterators pin them.
 	 */
-	mutable umap umap_;
+	mutable slot_vector slots_;
+
+	/** Head of the free-slot list threaded through unit_pod::next_free, or npos. */
+	mutable std::size_t free_head_;
+
+	/**
+	 * underlying_id -> slot, sorted by id. Iteration walks this flat vector, so whole-roster
+	 * passes stream linearly. Slots of dead-but-referenced units stay indexed (and are skipped)
+	 * until the last iterator lets go. This requires that underlying_id be unique (which is
+	 * enforced in unit_map::insert).
+	 */
+	mutable uid_index_t uid_index_;
+
+	/** Records @a loc in @ref occupied_. */
+	void occupied_insert(const map_location& loc);
+
+	/** Removes @a loc from @ref occupied_. */
+	void occupied_erase(const map_location& loc);
 
 	/**
-	 * location -> umap::iterator.
+	 * location -> slot.
 	 */
 	lmap lmap_;
+
+	/**
+	 * Occupied hexes indexed by row: y -> the sorted x coordinates.
+	 *
+	 * Kept in sync with @ref lmap_ so units_in_rect() and units_in_radius()
+	 * can visit only the occupied hexes of the queried area instead of
+	 * iterating the whole map.
+	 */
+	std::map<int, std::set<int>> occupied_;
+
+	/**
+	 * String id -> underlying_id of the unit last seen wearing it.
+	 *
+	 * Maintained by insert() and extract(), but a unit's string id can also
+	 * be rewritten in place (unit::set_id) without the map noticing, so the
+	 * entries are hints rather than invariants: find(const std::string&)
+	 * verifies them and falls back to a scan that re-learns the mapping.
+	 */
+	mutable std::unordered_map<std::string, std::size_t> idmap_;
 };
 
 /** Implement non-member swap function for std::swap (calls @ref unit_map::swap). */
@@ -202,12 +202,6 @@ void unit_type::build_full(
 	// Make sure we are built to the preceding build level.
 	build_help_index(mv_types, races, traits);
 
-	for(int i = 0; i < 2; ++i) {
-		if(gender_types_[i]) {
-			gender_types_[i]->build_full(mv_types, races, traits);
-		}
-	}
-
 	if(race_ != &unit_race::null_race) {
 		if(undead_variation_.empty()) {
 			undead_variation_ = race_->undead_variation();
@@ -221,10 +215,8 @@ void unit_type::build_full(
 	hp_bar_scaling_ = get_cfg()["hp_bar_scaling"].to_double(game_config::hp_bar_scaling);
 	xp_bar_scaling_ = get_cfg()["xp_bar_scaling"].to_double(game_config::xp_bar_scaling);
 
-	// Propagate the build to the variations.
-	for(variations_map::value_type& variation : variations_) {
-		variation.second.build_full(mv_types, races, traits);
-	}
+	// Gender variants and variations are built on demand when accessed
+	// through get_gender_unit_type() / get_variation().
 
 	// Deprecation messages, only seen when unit is parsed for the first time.
 
@@ -274,16 +266,6 @@ void unit_type::build_help_index(
 	alignment_ = unit_type::ALIGNMENT::NEUTRAL;
 	alignment_.parse(cfg["alignment"].str());
 
-	for(int i = 0; i < 2; ++i) {
-		if(gender_types_[i]) {
-			gender_types_[i]->build_help_index(mv_types, races, traits);
-		}
-	}
-
-	for(auto& pair : variations_) {
-		pair.second.build_help_index(mv_types, races, traits);
-	}
-
 	const race_map::const_iterator race_it = races.find(cfg["race"]);
 	if(race_it != races.end()) {
 		race_ = &race_it->second;
@@ -468,6 +450,7 @@ const unit_type& unit_type::get_gender_unit_type(unit_race::GENDER gender) const
 {
 	const std::size_t i = gender;
 	if(i < gender_types_.size() && gender_types_[i] != nullptr) {
+		ensure_variant_built(*gender_types_[i]);
 		return *gender_types_[i];
 	}
 
@@ -478,12 +461,31 @@ const unit_type& unit_type::get_variation(const std::string& id) const
 {
 	const variations_map::const_iterator i = variations_.find(id);
 	if(i != variations_.end()) {
+		ensure_variant_built(i->second);
 		return i->second;
 	}
 
 	return *this;
 }
 
+const unit_type::variations_map& unit_type::variation_types() const
+{
+	for(const variations_map::value_type& variation : variations_) {
+		ensure_variant_built(variation.second);
+	}
+
+	return variations_;
+}
+
+void unit_type::ensure_variant_built(const unit_type& variant) const
+{
+	// Variants are no longer built as part of building their parent; bring
+	// the requested one up to the parent's level before handing it out.
+	if(variant.build_status_ < build_status_) {
+		unit_types.build_unit_type(variant, build_status_);
+	}
+}
+
 t_string unit_type::unit_description() const
 {
 	if(description_.empty()) {
@@ -536,8 +538,15 @@ std::vector<t_string> combine_special_notes(const std::vector<t_string> direct,
 
 const std::vector<unit_animation>& unit_type::animations() const
 {
-	if(animations_.empty()) {
-		unit_animation::fill_initial_animations(animations_, get_cfg());
+	return *animations_ptr();
+}
+
+const std::shared_ptr<const std::vector<unit_animation>>& unit_type::animations_ptr() const
+{
+	if(!animations_) {
+		auto animations = std::make_shared<std::vector<unit_animation>>();
+		unit_animation::fill_initial_animations(*animations, get_cfg());
+		animations_ = std::move(animations);
 	}
 
 	return animations_;
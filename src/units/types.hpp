@@ -94,6 +94,13 @@ private: // These will be called by build().
 	/** Load the most needed data into an empty unit_type (build to CREATE). */
 	void build_created();
 
+	/**
+	 * Brings a gender variant or variation of this type up to this type's
+	 * own build level. Called by the variant accessors, which build lazily
+	 * instead of cascading through every variant when the parent is built.
+	 */
+	void ensure_variant_built(const unit_type& variant) const;
+
 	typedef std::map<std::string,unit_type> variations_map;
 public:
 	/** Performs a build of this to the indicated stage. */
@@ -185,6 +192,14 @@ public:
 	bool generate_name() const { return get_cfg()["generate_name"].to_bool(true); }
 	const std::vector<unit_animation>& animations() const;
 
+	/**
+	 * The same list as animations(), in shareable form.
+	 *
+	 * Units keep a reference to this instead of copying the list; see
+	 * unit_animation_component.
+	 */
+	const std::shared_ptr<const std::vector<unit_animation>>& animations_ptr() const;
+
 	const std::string& flag_rgb() const;
 
 	const_attack_itors attacks() const;
@@ -257,7 +272,7 @@ public:
 	}
 
 	std::vector<std::string> variations() const;
-	const variations_map& variation_types() const {return variations_; }
+	const variations_map& variation_types() const;
 
 	/**
 	 * @param variation_id		The id of the variation we search for.
@@ -380,7 +395,7 @@ private:
 	std::vector<unit_race::GENDER> genders_;
 
 	// animations are loaded only after the first animations() call
-	mutable std::vector<unit_animation> animations_;
+	mutable std::shared_ptr<const std::vector<unit_animation>> animations_;
 
 	BUILD_STATUS build_status_;
 };
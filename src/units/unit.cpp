@@ -52,6 +52,7 @@
 #include "units/id.hpp"
 #include "units/map.hpp" // for unit_map, etc
 #include "units/types.hpp"
+#include "utils/object_pool.hpp"
 #include "variable.hpp" // for vconfig, etc
 
 #include <cassert>                     // for assert
@@ -301,6 +302,27 @@ unit::unit(const unit& o)
 	}
 }
 
+void* unit::operator new(std::size_t size)
+{
+	// Sizes other than sizeof(unit) can only come from a derived class,
+	// which the pool's fixed block size cannot serve.
+	if(size != sizeof(unit)) {
+		return ::operator new(size);
+	}
+
+	return utils::object_pool<unit>::allocate();
+}
+
+void unit::operator delete(void* p, std::size_t size)
+{
+	if(size != sizeof(unit)) {
+		::operator delete(p);
+		return;
+	}
+
+	utils::object_pool<unit>::deallocate(p);
+}
+
 unit::unit(unit_ctor_t)
 	: std::enable_shared_from_this<unit>()
 	, loc_()
@@ -664,7 +686,7 @@ void unit::init(const config& cfg, bool use_traits, const vconfig* vcfg)
 
 #if 0
 	// Debug unit animations for units as they appear in game
-	for(const auto& anim : anim_comp_->animations_) {
+	for(const auto& anim : *anim_comp_->animations_) {
 		std::cout << anim.debug() << std::endl;
 	}
 #endif
@@ -785,6 +807,8 @@ void unit::swap(unit & o)
 	swap(hidden_, o.hidden_);
 	swap(modifications_, o.modifications_);
 	swap(invisibility_cache_, o.invisibility_cache_);
+	swap(ability_cache_, o.ability_cache_);
+	swap(ability_cache_generation_, o.ability_cache_generation_);
 }
 
 void unit::generate_name()
@@ -1329,6 +1353,17 @@ bool unit::get_state(const std::string& state) const
 void unit::set_state(state_t state, bool value)
 {
 	known_boolean_states_[state] = value;
+	// States such as petrified are observable by ability filters on
+	// adjacent units, so cached aggregates must be rebuilt.
+	unit_abilities::invalidate_cache();
+}
+
+void unit::set_side(unsigned int new_side)
+{
+	side_ = new_side;
+	// Which adjacent auras apply depends on side enmity, even for abilities
+	// without activity filters.
+	unit_abilities::invalidate_cache();
 }
 
 bool unit::get_state(state_t state) const
@@ -1377,6 +1412,8 @@ void unit::set_state(const std::string& state, bool value)
 	} else {
 		states_.erase(state);
 	}
+
+	unit_abilities::invalidate_cache();
 }
 
 bool unit::has_ability_by_id(const std::string& ability) const
@@ -2394,6 +2431,9 @@ void unit::add_modification(const std::string& mod_type, const config& mod, bool
 		add_trait_description(mod, description);
 	}
 
+	// Effects may have granted or removed abilities.
+	unit_abilities::invalidate_cache();
+
 	//NOTE: if not a trait, description is currently not used
 }
 
@@ -22,6 +22,7 @@
 #include "units/attack_type.hpp"
 #include "units/race.hpp"
 #include "units/alignment.hpp"
+#include "utils/alloc_tracking.hpp"
 #include "utils/variant.hpp"
 
 #include <boost/dynamic_bitset_fwd.hpp>
@@ -121,6 +122,8 @@ private:
 class unit : public std::enable_shared_from_this<unit>
 {
 public:
+	WESNOTH_TRACK_ALLOCATIONS(SUBSYS_UNIT)
+
 	/**
 	 * Clear this unit status cache for all units. Currently only the hidden
 	 * status of units is cached this way.
@@ -141,7 +144,7 @@ private:
 	struct unit_ctor_t {};
 
 public:
-	//private default ctor, butusing constructor to allow calling make_shared<unit> in create().
+	//default ctor gated by the tag type so that only create() builds units.
 	unit(unit_ctor_t);
 	unit() = delete;
 
@@ -186,10 +189,20 @@ private:
 	void clear_changed_attributes();
 
 public:
+	/**
+	 * Units are created and destroyed in bulk by AI simulation and the undo
+	 * stack, so their storage comes from a recycling pool instead of the
+	 * global allocator.
+	 */
+	static void* operator new(std::size_t size);
+	static void operator delete(void* p, std::size_t size);
+
 	/** Initializes a unit from a config */
 	static unit_ptr create(const config& cfg, bool use_traits = false, const vconfig* vcfg = nullptr)
 	{
-		unit_ptr res = std::make_shared<unit>(unit_ctor_t());
+		// Plain new rather than make_shared, so the unit itself comes from
+		// the pool and only the control block hits the global allocator.
+		unit_ptr res(new unit(unit_ctor_t()));
 		res->init(cfg, use_traits, vcfg);
 		return res;
 	}
@@ -201,7 +214,7 @@ public:
 	 */
 	static unit_ptr create(const unit_type& t, int side, bool real_unit, unit_race::GENDER gender = unit_race::NUM_GENDERS, const std::string& variation = "")
 	{
-		unit_ptr res = std::make_shared<unit>(unit_ctor_t());
+		unit_ptr res(new unit(unit_ctor_t()));
 		res->init(t, side, real_unit, gender, variation);
 
 		return res;
@@ -336,11 +349,13 @@ public:
 		return side_;
 	}
 
-	/** Sets the side this unit belongs to. */
-	void set_side(unsigned int new_side)
-	{
-		side_ = new_side;
-	}
+	/**
+	 * Sets the side this unit belongs to.
+	 *
+	 * Out of line since the side feeds into which adjacent auras affect the
+	 * unit, so changing it invalidates the ability cache.
+	 */
+	void set_side(unsigned int new_side);
 
 	/** This unit's type, accounting for gender and variation. */
 	const unit_type& type() const
@@ -1978,6 +1993,20 @@ private:
 	{
 		invisibility_cache_.clear();
 	}
+
+	/**
+	 * Cached results of get_abilities(), keyed by ability tag and query
+	 * location. Entries are valid only while @ref ability_cache_generation_
+	 * matches unit_abilities::cache_generation(); the cache is cleared
+	 * whenever the generations disagree. Queries involving abilities with
+	 * activity filters are never cached, since filters can observe state
+	 * (hitpoints, variables, formulas, terrain) with no central mutation
+	 * point to invalidate from.
+	 */
+	mutable std::map<std::pair<std::string, map_location>, unit_ability_list> ability_cache_;
+
+	/** The generation @ref ability_cache_ was filled in. */
+	mutable std::size_t ability_cache_generation_ = 0;
 };
 
 /** Implement non-member swap function for std::swap (calls @ref unit::swap). */
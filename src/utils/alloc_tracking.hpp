@@ -0,0 +1,160 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+/**
+ * @file
+ * Opt-in per-subsystem heap instrumentation (-DENABLE_ALLOC_TRACKING=ON).
+ *
+ * Tagged classes get class-scope operator new/delete that attribute their
+ * heap traffic to a subsystem counter: live bytes, peak watermark, and
+ * allocation totals (from which rates follow). Placing
+ * WESNOTH_TRACK_ALLOCATIONS(<subsystem>) inside a class body is all a new
+ * subsystem needs; when the build mode is off the macro expands to nothing
+ * and the tree is unchanged.
+ *
+ * Only whole-object allocations made through plain new are attributed -
+ * internal container churn and std::make_shared (which allocates through an
+ * allocator) bypass class operator new. That still catches the node-heavy
+ * types the counters exist for.
+ */
+
+#pragma once
+
+#ifdef WESNOTH_ALLOC_TRACKING
+
+#include "log.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace alloc_tracking
+{
+
+enum subsystem
+{
+	SUBSYS_CONFIG,
+	SUBSYS_SIMPLE_WML,
+	SUBSYS_UNIT,
+	SUBSYS_GUI2,
+
+	SUBSYS_COUNT
+};
+
+inline const char* subsystem_name(subsystem s)
+{
+	switch(s) {
+	case SUBSYS_CONFIG:
+		return "config";
+	case SUBSYS_SIMPLE_WML:
+		return "simple_wml";
+	case SUBSYS_UNIT:
+		return "unit";
+	case SUBSYS_GUI2:
+		return "gui2";
+	default:
+		return "unknown";
+	}
+}
+
+struct counters
+{
+	std::atomic<std::size_t> live_bytes{0};
+	std::atomic<std::size_t> peak_bytes{0};
+	std::atomic<std::size_t> alloc_count{0};
+	std::atomic<std::size_t> alloc_bytes{0};
+};
+
+inline std::array<counters, SUBSYS_COUNT>& stats()
+{
+	static std::array<counters, SUBSYS_COUNT> instance;
+	return instance;
+}
+
+inline void record_alloc(subsystem s, std::size_t size)
+{
+	counters& c = stats()[s];
+
+	c.alloc_count.fetch_add(1, std::memory_order_relaxed);
+	c.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+	const std::size_t live = c.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+	std::size_t peak = c.peak_bytes.load(std::memory_order_relaxed);
+	while(live > peak && !c.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+}
+
+inline void record_dealloc(subsystem s, std::size_t size)
+{
+	stats()[s].live_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+/** Logs one line per subsystem; @a elapsed_ms scales the allocation rate. */
+inline void log_report(unsigned elapsed_ms)
+{
+	static lg::log_domain log_alloc("alloc");
+
+	for(int s = 0; s < SUBSYS_COUNT; ++s) {
+		const counters& c = stats()[s];
+
+		LOG_STREAM(info, log_alloc)
+			<< "subsystem " << subsystem_name(static_cast<subsystem>(s))
+			<< ": live = " << c.live_bytes.load() << " bytes"
+			<< ", peak = " << c.peak_bytes.load() << " bytes"
+			<< ", allocations = " << c.alloc_count.load()
+			<< " (" << c.alloc_bytes.load() << " bytes"
+			<< ", " << (elapsed_ms ? c.alloc_count.load() * 1000 / elapsed_ms : 0) << "/s)\n";
+	}
+}
+
+} // namespace alloc_tracking
+
+/**
+ * Statement forms for classes that already define their own class-scope
+ * operator new/delete and only need the bookkeeping calls.
+ */
+#define WESNOTH_RECORD_ALLOC(subsys, size) alloc_tracking::record_alloc(alloc_tracking::subsys, size)
+#define WESNOTH_RECORD_DEALLOC(subsys, size) alloc_tracking::record_dealloc(alloc_tracking::subsys, size)
+
+#define WESNOTH_TRACK_ALLOCATIONS(subsys) \
+	static void* operator new(std::size_t size) \
+	{ \
+		alloc_tracking::record_alloc(alloc_tracking::subsys, size); \
+		return ::operator new(size); \
+	} \
+	static void* operator new[](std::size_t size) \
+	{ \
+		alloc_tracking::record_alloc(alloc_tracking::subsys, size); \
+		return ::operator new[](size); \
+	} \
+	static void operator delete(void* p, std::size_t size) \
+	{ \
+		alloc_tracking::record_dealloc(alloc_tracking::subsys, size); \
+		::operator delete(p); \
+	} \
+	static void operator delete[](void* p, std::size_t size) \
+	{ \
+		alloc_tracking::record_dealloc(alloc_tracking::subsys, size); \
+		::operator delete[](p); \
+	}
+
+#else
+
+#define WESNOTH_RECORD_ALLOC(subsys, size) ((void)0)
+#define WESNOTH_RECORD_DEALLOC(subsys, size) ((void)0)
+#define WESNOTH_TRACK_ALLOCATIONS(subsys)
+
+#endif // WESNOTH_ALLOC_TRACKING
@@ -0,0 +1,116 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include "config.hpp"
+
+#include <memory>
+
+namespace utils
+{
+
+/**
+ * A copy-on-write handle around a config tree.
+ *
+ * Copying a cow_config shares the underlying tree instead of deep-copying
+ * it; the first mutable access through write() after such a copy clones the
+ * tree again. This is intended for large, rarely-mutated snapshots, such as
+ * the starting position and replay start held by saved_game, where most
+ * copies are never modified and a deep copy would only waste memory.
+ *
+ * A handle may be read from another thread while the owning thread keeps
+ * mutating its own handles: write() clones a shared tree instead of touching
+ * it, so the other thread only ever sees read-only access to its tree. Two
+ * threads must not share a single handle object, though.
+ */
+class cow_config
+{
+public:
+	cow_config()
+		: cfg_(std::make_shared<config>())
+	{
+	}
+
+	explicit cow_config(config&& cfg)
+		: cfg_(std::make_shared<config>(std::move(cfg)))
+	{
+	}
+
+	explicit cow_config(const config& cfg)
+		: cfg_(std::make_shared<config>(cfg))
+	{
+	}
+
+	/** Replaces the held tree, detaching from any sharing. */
+	cow_config& operator=(config&& cfg)
+	{
+		cfg_ = std::make_shared<config>(std::move(cfg));
+		return *this;
+	}
+
+	cow_config& operator=(const config& cfg)
+	{
+		cfg_ = std::make_shared<config>(cfg);
+		return *this;
+	}
+
+	/** Drops the held tree, detaching from any sharing. */
+	void clear()
+	{
+		cfg_ = std::make_shared<config>();
+	}
+
+	/** Swaps the trees held by two handles; never clones. */
+	void swap(cow_config& other)
+	{
+		cfg_.swap(other.cfg_);
+	}
+
+	/**
+	 * Swaps the held tree with @a cfg. If the tree is shared, the other
+	 * handles keep the previous contents and @a cfg receives a copy of them.
+	 */
+	void swap(config& cfg)
+	{
+		if(cfg_.use_count() > 1) {
+			auto fresh = std::make_shared<config>(std::move(cfg));
+			cfg = *cfg_;
+			cfg_ = std::move(fresh);
+		} else {
+			cfg_->swap(cfg);
+		}
+	}
+
+	/** Read-only access to the tree; never clones. */
+	const config& read() const
+	{
+		return *cfg_;
+	}
+
+	/** Mutable access to the tree; clones it first if it is shared. */
+	config& write()
+	{
+		if(cfg_.use_count() > 1) {
+			cfg_ = std::make_shared<config>(*cfg_);
+		}
+
+		return *cfg_;
+	}
+
+private:
+	std::shared_ptr<config> cfg_;
+};
+
+} // namespace utils
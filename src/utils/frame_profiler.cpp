@@ -0,0 +1,252 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "utils/frame_profiler.hpp"
+
+#include "filesystem.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+static lg::log_domain log_display("display");
+#define LOG_DP LOG_STREAM(info, log_display)
+#define ERR_DP LOG_STREAM(err, log_display)
+
+namespace prof
+{
+
+namespace
+{
+
+struct zone_node
+{
+	zone_node(const char* n, zone_node* p)
+		: name(n)
+		, parent(p)
+	{
+	}
+
+	const char* name;
+	zone_node* parent;
+	/** Children keyed by their literal pointer; cheaper than string compares. */
+	std::map<const char*, std::unique_ptr<zone_node>> children;
+
+	/** Accumulated in the frame being recorded. */
+	uint64_t frame_ns = 0;
+	unsigned frame_calls = 0;
+
+	/** Rolling aggregation over all closed frames. */
+	uint64_t total_ns = 0;
+	uint64_t total_calls = 0;
+	uint64_t worst_frame_ns = 0;
+};
+
+bool enabled_ = false;
+/** Desired state; transitions are applied between frames so no zone dangles. */
+bool requested_ = false;
+uint64_t frames_ = 0;
+zone_node root_("frame", nullptr);
+zone_node* current_ = &root_;
+
+void fold_frame(zone_node& node)
+{
+	node.total_ns += node.frame_ns;
+	node.total_calls += node.frame_calls;
+	node.worst_frame_ns = std::max(node.worst_frame_ns, node.frame_ns);
+	node.frame_ns = 0;
+	node.frame_calls = 0;
+
+	for(auto& child : node.children) {
+		fold_frame(*child.second);
+	}
+}
+
+void reset_tree()
+{
+	root_.children.clear();
+	root_.frame_ns = 0;
+	root_.frame_calls = 0;
+	root_.total_ns = 0;
+	root_.total_calls = 0;
+	root_.worst_frame_ns = 0;
+	current_ = &root_;
+	frames_ = 0;
+}
+
+double avg_ms(const zone_node& node)
+{
+	return frames_ > 0 ? static_cast<double>(node.total_ns) / frames_ / 1e6 : 0.0;
+}
+
+void dump_node(std::ostream& out, const zone_node& node, int depth)
+{
+	out << std::setw(10) << std::fixed << std::setprecision(3) << avg_ms(node)
+		<< std::setw(10) << static_cast<double>(node.worst_frame_ns) / 1e6
+		<< std::setw(10) << std::setprecision(2)
+		<< (frames_ > 0 ? static_cast<double>(node.total_calls) / frames_ : 0.0)
+		<< "  ";
+	for(int i = 0; i < depth; ++i) {
+		out << "  ";
+	}
+	out << node.name << "\n";
+
+	// Expensive children first; ties broken by name for stable reports.
+	std::vector<const zone_node*> children;
+	for(const auto& child : node.children) {
+		children.push_back(child.second.get());
+	}
+	std::sort(children.begin(), children.end(), [](const zone_node* a, const zone_node* b) {
+		return a->total_ns != b->total_ns ? a->total_ns > b->total_ns : strcmp(a->name, b->name) < 0;
+	});
+
+	for(const zone_node* child : children) {
+		dump_node(out, *child, depth + 1);
+	}
+}
+
+void dump_to_file()
+{
+	try {
+		const std::string filename = filesystem::get_user_data_dir() + "/frame_profile.txt";
+		filesystem::scoped_ostream out = filesystem::ostream_file(filename);
+		dump(*out);
+		LOG_DP << "frame profile written to " << filename << '\n';
+	} catch(const filesystem::io_exception& e) {
+		ERR_DP << "could not write the frame profile: " << e.what() << '\n';
+	}
+}
+
+} // namespace
+
+void enable(bool on)
+{
+	requested_ = on;
+
+	// Starting is safe right away when no zone is open; stopping always
+	// waits for the frame boundary in new_frame(), so open zones never
+	// point into a discarded tree.
+	if(on && !enabled_ && current_ == &root_) {
+		reset_tree();
+		enabled_ = true;
+	}
+}
+
+bool enabled()
+{
+	return enabled_;
+}
+
+void new_frame()
+{
+	if(enabled_) {
+		fold_frame(root_);
+		++frames_;
+	}
+
+	if(requested_ != enabled_ && current_ == &root_) {
+		if(requested_) {
+			reset_tree();
+			enabled_ = true;
+		} else {
+			enabled_ = false;
+			if(frames_ > 0) {
+				dump_to_file();
+			}
+			reset_tree();
+		}
+	}
+}
+
+std::string overlay_report()
+{
+	if(!enabled_ || frames_ == 0) {
+		return "";
+	}
+
+	// Flat list of the most expensive zones, whatever their depth.
+	std::vector<const zone_node*> zones;
+	std::vector<const zone_node*> stack{&root_};
+	while(!stack.empty()) {
+		const zone_node* node = stack.back();
+		stack.pop_back();
+		if(node != &root_) {
+			zones.push_back(node);
+		}
+		for(const auto& child : node->children) {
+			stack.push_back(child.second.get());
+		}
+	}
+
+	std::sort(zones.begin(), zones.end(), [](const zone_node* a, const zone_node* b) {
+		return a->total_ns > b->total_ns;
+	});
+
+	std::ostringstream out;
+	const std::size_t shown = std::min<std::size_t>(zones.size(), 5);
+	for(std::size_t i = 0; i < shown; ++i) {
+		out << "\n<tt>" << std::setw(6) << std::fixed << std::setprecision(2)
+			<< avg_ms(*zones[i]) << " ms " << zones[i]->name << "</tt>";
+	}
+	return out.str();
+}
+
+void dump(std::ostream& out)
+{
+	out << "frame profile over " << frames_ << " frames\n"
+		<< std::setw(10) << "avg ms" << std::setw(10) << "worst ms" << std::setw(10) << "calls"
+		<< "  zone\n";
+	for(const auto& child : root_.children) {
+		dump_node(out, *child.second, 0);
+	}
+}
+
+zone::zone(const char* name)
+	: node_(nullptr)
+	, start_()
+{
+	if(!enabled_) {
+		return;
+	}
+
+	std::unique_ptr<zone_node>& slot = current_->children[name];
+	if(!slot) {
+		slot.reset(new zone_node(name, current_));
+	}
+
+	current_ = slot.get();
+	node_ = current_;
+	start_ = std::chrono::steady_clock::now();
+}
+
+zone::~zone()
+{
+	if(!node_) {
+		return;
+	}
+
+	zone_node* node = static_cast<zone_node*>(node_);
+	node->frame_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - start_).count();
+	++node->frame_calls;
+	current_ = node->parent;
+}
+
+} // namespace prof
@@ -0,0 +1,74 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+/**
+ * @file
+ * Hierarchical frame-time profiler.
+ *
+ * Scoped zones (see PROFILE_ZONE) nest into a call tree that is aggregated
+ * once per mainloop iteration. The result can be shown next to the FPS
+ * overlay (see display::update_display) and is dumped to
+ * <userdata>/frame_profile.txt when profiling stops, giving players a
+ * report they can attach for map-specific slowdowns.
+ *
+ * Collection only happens on the main thread; zones entered while the
+ * profiler is disabled cost a single branch.
+ */
+
+namespace prof
+{
+
+/** Starts or stops collection. Stopping writes the dump file if any data was gathered. */
+void enable(bool on);
+
+bool enabled();
+
+/**
+ * Closes the current frame: folds the per-frame counters into the rolling
+ * statistics. Called from events::pump(), once per mainloop iteration.
+ */
+void new_frame();
+
+/** Few-line summary of the most expensive zones, for the in-game overlay. */
+std::string overlay_report();
+
+/** Writes the whole aggregated zone tree in a plain-text table. */
+void dump(std::ostream& out);
+
+/** Scoped profiling zone; use through PROFILE_ZONE. */
+class zone
+{
+public:
+	/** @param name   Zone label; must be a string literal (stored by pointer). */
+	explicit zone(const char* name);
+	~zone();
+
+	zone(const zone&) = delete;
+	zone& operator=(const zone&) = delete;
+
+private:
+	/** The tree node the time gets charged to; null when the profiler is off. */
+	void* node_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace prof
+
+#define PROFILE_ZONE(name) const prof::zone profile_zone_object__(name)
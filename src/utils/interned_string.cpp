@@ -0,0 +1,72 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#include "utils/interned_string.hpp"
+
+#include <mutex>
+#include <ostream>
+#include <unordered_set>
+
+namespace utils
+{
+
+namespace
+{
+
+struct string_view_hash
+{
+	using is_transparent = void;
+	std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>()(s); }
+	std::size_t operator()(const std::string& s) const { return std::hash<std::string_view>()(s); }
+};
+
+struct pool_type
+{
+	std::mutex mutex;
+	// Node-based so pooled strings keep their address as the pool grows.
+	std::unordered_set<std::string, string_view_hash, std::equal_to<>> strings;
+};
+
+pool_type& pool()
+{
+	// Deliberately leaked so handles stay valid during static teardown.
+	static pool_type* p = new pool_type();
+	return *p;
+}
+
+} // namespace
+
+interned_string::interned_string()
+	: interned_string(std::string_view())
+{
+}
+
+interned_string::interned_string(std::string_view str)
+	: str_(nullptr)
+{
+	pool_type& p = pool();
+	std::lock_guard<std::mutex> lock(p.mutex);
+
+	// The C++17 unordered container API cannot look up by string_view, so
+	// interning always materializes one std::string; it is discarded again
+	// when the string was already pooled.
+	str_ = &*p.strings.emplace(str).first;
+}
+
+std::ostream& operator<<(std::ostream& os, const interned_string& s)
+{
+	return os << s.str();
+}
+
+} // namespace utils
@@ -0,0 +1,81 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace utils
+{
+
+/**
+ * A handle to a string stored exactly once in a global pool.
+ *
+ * Interning the same character sequence always yields a handle to the same
+ * pooled std::string, so equality and hashing are pointer operations and the
+ * duplicated heap storage for frequently repeated names (tag names, image
+ * paths, unit type ids, ...) collapses to one copy. Pooled strings are
+ * immutable and never freed, which keeps handles trivially copyable and safe
+ * to hold anywhere; the pool itself is thread-safe.
+ */
+class interned_string
+{
+public:
+	/** An empty string handle. */
+	interned_string();
+
+	/** Interns @a str, pooling it on first sight. */
+	explicit interned_string(std::string_view str);
+
+	const std::string& str() const { return *str_; }
+	operator const std::string&() const { return *str_; }
+
+	const char* c_str() const { return str_->c_str(); }
+	bool empty() const { return str_->empty(); }
+	std::size_t size() const { return str_->size(); }
+
+	/** Pointer identity; two handles are equal iff their strings are. */
+	bool operator==(const interned_string& other) const { return str_ == other.str_; }
+	bool operator!=(const interned_string& other) const { return str_ != other.str_; }
+
+	bool operator==(std::string_view other) const { return *str_ == other; }
+	bool operator!=(std::string_view other) const { return *str_ != other; }
+
+	/** Orders by string content, so interned keys sort like plain ones. */
+	bool operator<(const interned_string& other) const
+	{
+		return str_ != other.str_ && *str_ < *other.str_;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const interned_string& s);
+
+private:
+	const std::string* str_;
+};
+
+} // namespace utils
+
+namespace std
+{
+template<>
+struct hash<utils::interned_string>
+{
+	std::size_t operator()(const utils::interned_string& s) const
+	{
+		return hash<const std::string*>()(&s.str());
+	}
+};
+}
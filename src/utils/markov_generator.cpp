@@ -45,7 +45,7 @@ static markov_prefix_map markov_prefixes(const std::vector<std::string>& items,
 }
 
 static std::u32string markov_generate_name(const markov_prefix_map& prefixes,
-	std::size_t chain_size, std::size_t max_len)
+	std::size_t chain_size, std::size_t max_len, std::vector<int>& random)
 {
 	if(prefixes.empty() || chain_size == 0) {
 		return std::u32string();
@@ -63,7 +63,8 @@ static std::u32string markov_generate_name(const markov_prefix_map& prefixes,
 	// following calls to get_random() return different results, which caused
 	// traits to be different. To avoid that problem we call get_random()
 	// the maximum number of times and store the result in a lookup table.
-	std::vector<int> random(max_len);
+	// The table is caller-provided so batch generation can reuse it.
+	random.resize(max_len);
 	std::size_t j = 0;
 	for(; j < max_len; ++j) {
 		random[j] = randomness::generator->next_random();
@@ -133,6 +134,20 @@ markov_generator::markov_generator(const std::vector<std::string>& items, std::s
 
 std::string markov_generator::generate() const
 {
-	std::u32string name = markov_generate_name(prefixes_, chain_size_, max_len_);
+	std::vector<int> random;
+	std::u32string name = markov_generate_name(prefixes_, chain_size_, max_len_, random);
 	return unicode_cast<std::string>(name);
 }
+
+std::vector<std::string> markov_generator::generate(std::size_t count) const
+{
+	std::vector<std::string> res;
+	res.reserve(count);
+
+	std::vector<int> random;
+	for(std::size_t i = 0; i != count; ++i) {
+		res.push_back(unicode_cast<std::string>(markov_generate_name(prefixes_, chain_size_, max_len_, random)));
+	}
+
+	return res;
+}
@@ -17,6 +17,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <exception>
 
 class name_generator_invalid_exception : public std::exception {
@@ -34,6 +35,12 @@ public:
 	// Defined in name_generator_factory.cpp
 	std::string generate(const std::map<std::string,std::string>& variables) const;
 	virtual std::string generate() const { return ""; }
+	/**
+	 * Generates @a count names in one call, drawing the same random sequence
+	 * a loop over generate() would. Implementations can reuse their working
+	 * buffers across the batch; the default simply loops.
+	 */
+	virtual std::vector<std::string> generate(std::size_t count) const;
 	name_generator() {}
 	virtual ~name_generator() {}
 };
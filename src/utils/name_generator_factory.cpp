@@ -27,6 +27,17 @@ std::string name_generator::generate(const std::map<std::string,std::string>& va
 	return utils::interpolate_variables_into_string(generate(), &variables);
 }
 
+std::vector<std::string> name_generator::generate(std::size_t count) const {
+	std::vector<std::string> res;
+	res.reserve(count);
+
+	for(std::size_t i = 0; i != count; ++i) {
+		res.push_back(generate());
+	}
+
+	return res;
+}
+
 name_generator_factory::name_generator_factory(const config& config, std::vector<std::string> ids) : name_generators_() {
 	add_name_generator_from_config(config, "", "");
 
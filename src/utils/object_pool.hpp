@@ -0,0 +1,84 @@
+/*
+	Copyright (C) 2021
+	Part of the Battle for Wesnoth Project https://www.wesnoth.org/
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY.
+
+	See the COPYING file for more details.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace utils
+{
+
+/**
+ * A slab allocator recycling fixed-size blocks for one object type.
+ *
+ * Intended for game-state objects that are created and destroyed in bulk,
+ * such as units during AI simulation. Storage is carved out of large slabs
+ * and freed blocks go onto a free list instead of back to the global
+ * allocator, so churn costs a pointer swap rather than a heap round trip.
+ *
+ * The pool is not thread-safe; it is meant for objects that only live on
+ * the main game-logic thread. Slabs are never returned to the system, so a
+ * burst of allocations leaves capacity ready for the next one.
+ */
+template<typename T>
+class object_pool
+{
+public:
+	/** Returns storage for one T, recycling a freed block when possible. */
+	static void* allocate()
+	{
+		free_node*& head = free_list();
+		if(!head) {
+			grow();
+		}
+
+		free_node* res = head;
+		head = res->next;
+		return res;
+	}
+
+	/** Returns a block obtained from allocate() to the free list. */
+	static void deallocate(void* p)
+	{
+		free_node* node = static_cast<free_node*>(p);
+		node->next = free_list();
+		free_list() = node;
+	}
+
+private:
+	union free_node
+	{
+		free_node* next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	static constexpr std::size_t slab_size = 256;
+
+	static free_node*& free_list()
+	{
+		static free_node* head = nullptr;
+		return head;
+	}
+
+	static void grow()
+	{
+		free_node* slab = static_cast<free_node*>(::operator new(slab_size * sizeof(free_node)));
+		for(std::size_t i = 0; i < slab_size; ++i) {
+			deallocate(&slab[i]);
+		}
+	}
+};
+
+}
@@ -29,6 +29,9 @@
 #include "units/unit.hpp"
 #include "units/map.hpp"
 #include "team.hpp"
+#include "utils/scope_exit.hpp"
+
+#include <map>
 
 static lg::log_domain log_engine("engine");
 #define LOG_NG LOG_STREAM(info, log_engine)
@@ -48,6 +51,17 @@ namespace
 		return as_nonempty_range_default.child_range("_");
 	}
 
+	config::const_child_itors as_nonempty_range(const variable_path& varpath, const variable_set& vars)
+	{
+		config::const_child_itors range = vars.get_variable_access_read(varpath).as_array();
+
+		if(!range.empty()) {
+			return range;
+		}
+
+		return as_nonempty_range_default.child_range("_");
+	}
+
 	// doxygen didn't like this as an anonymous struct
 	struct anon : public variable_set
 	{
@@ -60,6 +74,19 @@ namespace
 			return variable_access_const(varname, config());
 		}
 	} null_variable_set;
+
+	/**
+	 * Memo of fully expanded vconfigs, see vconfig::get_parsed_config().
+	 * An entry is valid while the game variables' generation matches; the
+	 * source copy guards against a new config reusing a cached address.
+	 */
+	struct parsed_config_cache_entry
+	{
+		config source;
+		config parsed;
+	};
+	std::map<const config*, parsed_config_cache_entry> parsed_config_cache;
+	std::size_t parsed_config_cache_generation = 0;
 }
 
 config::attribute_value config_variable_set::get_variable_const(const std::string &id) const {
@@ -76,6 +103,10 @@ variable_access_const config_variable_set::get_variable_access_read(const std::s
 	return variable_access_const(id, cfg_);
 }
 
+variable_access_const config_variable_set::get_variable_access_read(const variable_path &path) const {
+	return variable_access_const(path, cfg_);
+}
+
 const config vconfig::default_empty_config = config();
 
 static const variable_set* try_get_gamedata()
@@ -177,6 +208,29 @@ config vconfig::get_parsed_config() const
 {
 	// Keeps track of insert_tag variables.
 	static std::set<std::string> vconfig_recursion;
+	// Depth of nested get_parsed_config() calls; only the outermost call
+	// consults the cache, so subtrees aren't cached a second time.
+	static int parse_depth = 0;
+
+	// Event handlers traverse the same body over and over with unchanged
+	// variables; remember the expansion until a game variable changes.
+	// Only the game's own variables carry a generation counter, so vconfigs
+	// bound to any other variable set bypass the cache.
+	const bool cacheable = parse_depth == 0 && resources::gamedata && variables_ == resources::gamedata;
+	if(cacheable) {
+		if(game_data::variable_generation() != parsed_config_cache_generation) {
+			parsed_config_cache.clear();
+			parsed_config_cache_generation = game_data::variable_generation();
+		}
+
+		const auto cached = parsed_config_cache.find(cfg_);
+		if(cached != parsed_config_cache.end() && cached->second.source == *cfg_) {
+			return cached->second.parsed;
+		}
+	}
+
+	++parse_depth;
+	ON_SCOPE_EXIT() { --parse_depth; };
 
 	config res;
 
@@ -220,6 +274,23 @@ config vconfig::get_parsed_config() const
 			res.add_child(child.key, vconfig(child.cfg, *variables_).get_parsed_config());
 		}
 	}
+
+	if(cacheable) {
+		// Expanding may itself have changed the variables (a scoped variable
+		// like $unit is auto-stored on first read), so resync the generation
+		// before remembering the result.
+		if(game_data::variable_generation() != parsed_config_cache_generation) {
+			parsed_config_cache.clear();
+			parsed_config_cache_generation = game_data::variable_generation();
+		}
+
+		if(parsed_config_cache.size() >= 512) {
+			parsed_config_cache.clear();
+		}
+
+		parsed_config_cache[cfg_] = parsed_config_cache_entry{*cfg_, res};
+	}
+
 	return res;
 }
 
@@ -372,13 +443,25 @@ vconfig::attribute_iterator::pointer vconfig::attribute_iterator::operator->() c
 }
 
 vconfig::all_children_iterator::all_children_iterator(const Itor &i, const variable_set& vars) :
-	i_(i), inner_index_(0), cache_(), variables_(&vars)
+	i_(i), inner_index_(0), cache_(), variables_(&vars), var_path_()
 {
 }
 
 vconfig::all_children_iterator::all_children_iterator(const Itor &i, const variable_set& vars, const std::shared_ptr<const config> & cache) :
-	i_(i), inner_index_(0), cache_(cache), variables_(&vars)
+	i_(i), inner_index_(0), cache_(cache), variables_(&vars), var_path_()
+{
+}
+
+const variable_path& vconfig::all_children_iterator::compiled_variable_path(const std::string& name) const
 {
+	// Iterating over an expanded [insert_tag] resolves the same variable once
+	// per element; compile its name the first time and reuse the path while it
+	// stays the same. The variable itself is still looked up on every step so
+	// mid-iteration changes to its contents behave as before.
+	if(!var_path_ || var_path_->name() != name) {
+		var_path_ = std::make_shared<const variable_path>(name);
+	}
+	return *var_path_;
 }
 
 vconfig::all_children_iterator& vconfig::all_children_iterator::operator++()
@@ -387,7 +470,7 @@ vconfig::all_children_iterator& vconfig::all_children_iterator::operator++()
 	{
 		try
 		{
-			variable_access_const vinfo = variables_->get_variable_access_read(vconfig(i_->cfg, *variables_)["variable"]);
+			variable_access_const vinfo = variables_->get_variable_access_read(compiled_variable_path(vconfig(i_->cfg, *variables_)["variable"]));
 
 			config::const_child_itors range = vinfo.as_array();
 
@@ -459,7 +542,7 @@ vconfig vconfig::all_children_iterator::get_child() const
 	{
 		try
 		{
-			config::const_child_itors range = as_nonempty_range(vconfig(i_->cfg, *variables_)["variable"], *variables_);
+			config::const_child_itors range = as_nonempty_range(compiled_variable_path(vconfig(i_->cfg, *variables_)["variable"]), *variables_);
 
 			range.advance_begin(inner_index_);
 			return vconfig(range.front(), true, variables_);
@@ -492,8 +575,12 @@ scoped_wml_variable::scoped_wml_variable(const std::string& var_name) :
 	var_name_(var_name),
 	activated_(false)
 {
-	if (resources::gamedata)
+	if (resources::gamedata) {
 		resources::gamedata->scoped_variables.push_back(this);
+		// Even before auto-storing, registration changes what var_name_
+		// resolves to.
+		game_data::bump_variable_generation();
+	}
 }
 
 config &scoped_wml_variable::store(const config &var_value)
@@ -540,6 +627,7 @@ scoped_wml_variable::~scoped_wml_variable()
 
 	assert(resources::gamedata->scoped_variables.back() == this);
 	resources::gamedata->scoped_variables.pop_back();
+	game_data::bump_variable_generation();
 }
 
 void scoped_xy_unit::activate()
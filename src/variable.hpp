@@ -30,6 +30,7 @@ public:
 	config_variable_set(const config& cfg) : cfg_(cfg) {}
 	virtual config::attribute_value get_variable_const(const std::string &id) const;
 	virtual variable_access_const get_variable_access_read(const std::string& varname) const;
+	virtual variable_access_const get_variable_access_read(const variable_path& path) const override;
 };
 
 /**
@@ -178,6 +179,14 @@ public:
 		int inner_index_;
 		std::shared_ptr<const config> cache_;
 		const variable_set* variables_;
+		/**
+		 * Compiled form of the variable name an [insert_tag] resolves, kept
+		 * between increments so stepping over an expanded array doesn't
+		 * re-parse the name once per element.
+		 */
+		mutable std::shared_ptr<const variable_path> var_path_;
+
+		const variable_path& compiled_variable_path(const std::string& name) const;
 	};
 
 	struct recursion_error : public config::error {
@@ -62,6 +62,52 @@ typename V::result_t apply_visitor(typename V::param_t state, T&&... args)
 
 using namespace variable_info_implementation;
 
+variable_path::variable_path(const std::string& varname)
+	: name_(varname)
+	, steps_()
+	, invalid_(false)
+{
+	// Mirrors the grammar of variable_info::calculate_value, recording the
+	// steps instead of applying them.
+	try {
+		std::size_t previous_index = 0, name_size = name_.size();
+
+		for(std::size_t loop_index = 0; loop_index < name_size; loop_index++) {
+			switch(name_[loop_index]) {
+			case '.':
+			case '[':
+				steps_.push_back({name_.substr(previous_index, loop_index - previous_index), -1});
+
+				previous_index = loop_index + 1;
+				break;
+			case ']':
+				steps_.push_back({std::string(), parse_index(&name_[previous_index])});
+
+				// After ']' we always expect a '.' or the end of the string
+				// Ignore the next char which is a '.'
+				loop_index++;
+				if(loop_index < name_.length() && name_[loop_index] != '.') {
+					throw invalid_variablename_exception();
+				}
+
+				previous_index = loop_index + 1;
+				break;
+			default:
+				break;
+			}
+		}
+
+		if(previous_index != name_.length() + 1) {
+			// The string didn't end with ']'
+			// In this case we still didn't add the key behind the last '.'
+			steps_.push_back({name_.substr(previous_index), -1});
+		}
+	} catch(const invalid_variablename_exception&) {
+		steps_.clear();
+		invalid_ = true;
+	}
+}
+
 template<typename V>
 variable_info<V>::variable_info(const std::string& varname, maybe_const_t<config, V>& vars) noexcept
 	: name_(varname)
@@ -75,6 +121,29 @@ variable_info<V>::variable_info(const std::string& varname, maybe_const_t<config
 	}
 }
 
+template<typename V>
+variable_info<V>::variable_info(const variable_path& path, maybe_const_t<config, V>& vars) noexcept
+	: name_(path.name())
+	, state_(vars)
+	, valid_(!path.invalid())
+{
+	if(!valid_) {
+		return;
+	}
+
+	try {
+		for(const variable_path::step& s : path.steps_) {
+			if(s.index < 0) {
+				apply_visitor<get_variable_key_visitor<V>>(state_, s.key);
+			} else {
+				apply_visitor<get_variable_index_visitor<V>>(state_, s.index);
+			}
+		}
+	} catch(const invalid_variablename_exception&) {
+		valid_ = false;
+	}
+}
+
 template<typename V>
 void variable_info<V>::calculate_value()
 {
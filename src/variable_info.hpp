@@ -20,6 +20,7 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 class invalid_variablename_exception : public std::exception
 {
@@ -36,6 +37,48 @@ public:
 // so include this after declaring it.
 #include "variable_info_detail.hpp"
 
+/**
+ * A dotted variable name such as "unit_store[5].type" parsed once into its
+ * sequence of key and index steps.
+ *
+ * Resolving a variable through the plain-string interface re-scans the name
+ * character by character on every access. When the same name gets resolved
+ * repeatedly - per element of an array loop, for instance - compile it into
+ * a variable_path up front and pass that in place of the string.
+ */
+class variable_path
+{
+public:
+	explicit variable_path(const std::string& varname);
+
+	const std::string& name() const
+	{
+		return name_;
+	}
+
+	/** True when parsing failed; any access through this path is invalid. */
+	bool invalid() const
+	{
+		return invalid_;
+	}
+
+private:
+	template<typename>
+	friend class variable_info;
+
+	/** One resolution step: either descend into a key or select an index. */
+	struct step
+	{
+		std::string key;
+		/** The array index selected, or -1 when this step descends into @ref key. */
+		int index = -1;
+	};
+
+	std::string name_;
+	std::vector<step> steps_;
+	bool invalid_;
+};
+
 /** Information on a WML variable. */
 template<typename V>
 class variable_info
@@ -43,6 +86,9 @@ class variable_info
 public:
 	variable_info(const std::string& varname, maybe_const_t<config, V>& vars) noexcept;
 
+	/** As above, but walks an already compiled path instead of re-parsing the name. */
+	variable_info(const variable_path& path, maybe_const_t<config, V>& vars) noexcept;
+
 	std::string get_error_message() const;
 
 	bool explicit_index() const;
@@ -104,6 +150,15 @@ public:
 		);
 	}
 
+	variable_info_mutable(const variable_path& path, config& game_vars)
+		: variable_info<V>(path, game_vars)
+	{
+		static_assert(!std::is_same_v<
+			variable_info_implementation::vi_policy_const, std::remove_const_t<V>>,
+			"variable_info_mutable cannot be specialized with 'vi_policy_const'"
+		);
+	}
+
 	/**
 	 * @returns                 The new appended range.
 	 * @throws                  invalid_variablename_exception
@@ -155,4 +210,14 @@ public:
 	virtual ~variable_set() {}
 	virtual config::attribute_value get_variable_const(const std::string &id) const = 0;
 	virtual variable_access_const get_variable_access_read(const std::string& varname) const = 0;
+
+	/**
+	 * As above, for a precompiled path. The default falls back to re-parsing
+	 * the name; implementations holding their variables in a plain config
+	 * should resolve the compiled steps directly.
+	 */
+	virtual variable_access_const get_variable_access_read(const variable_path& path) const
+	{
+		return get_variable_access_read(path.name());
+	}
 };
@@ -22,6 +22,7 @@
 #include "log.hpp"
 #include "preferences/general.hpp"
 #include "sdl/point.hpp"
+#include "sdl/rect.hpp"
 #include "sdl/userevent.hpp"
 #include "sdl/utils.hpp"
 #include "sdl/window.hpp"
@@ -90,6 +91,7 @@ CVideo::CVideo(FAKE_TYPES type)
 	, updated_locked_(0)
 	, flip_locked_(0)
 	, refresh_rate_(0)
+	, framebuffer_changes_(0)
 {
 	assert(!singleton_);
 	singleton_ = this;
@@ -315,6 +317,31 @@ void CVideo::flip()
 	}
 }
 
+void CVideo::flip(SDL_Rect damage)
+{
+	if(fake_screen_ || flip_locked_ > 0) {
+		return;
+	}
+
+	if(!window) {
+		return;
+	}
+
+	// Clamp to the framebuffer; a partial update with an out-of-range
+	// rectangle would fail and present nothing at all.
+	damage = sdl::intersect_rects(damage, {0, 0, frameBuffer->w, frameBuffer->h});
+
+	if(damage.w <= 0 || damage.h <= 0) {
+		return;
+	}
+
+	if(damage.w >= frameBuffer->w && damage.h >= frameBuffer->h) {
+		window->render();
+	} else {
+		window->update_rects(&damage, 1);
+	}
+}
+
 void CVideo::lock_updates(bool value)
 {
 	if(value == true) {
@@ -187,6 +187,33 @@ public:
 	/** Renders the screen. Should normally not be called directly! */
 	void flip();
 
+	/**
+	 * Renders only the given part of the screen, so that presenting a frame
+	 * that touched a few hexes doesn't copy the whole framebuffer to the
+	 * display. Falls back to a full present when the damage covers the
+	 * framebuffer. Should normally not be called directly!
+	 *
+	 * @param damage              The changed area, in framebuffer coordinates.
+	 */
+	void flip(SDL_Rect damage);
+
+	/**
+	 * Records that the framebuffer was modified outside of display's own
+	 * drawing routines, e.g. by a legacy widget painting itself during event
+	 * handling. display compares the counter against its value at the last
+	 * presented frame to decide whether the screen needs to be presented again.
+	 */
+	void mark_framebuffer_changed()
+	{
+		++framebuffer_changes_;
+	}
+
+	/** Returns the number of times mark_framebuffer_changed() has been called. */
+	unsigned int framebuffer_change_count() const
+	{
+		return framebuffer_changes_;
+	}
+
 	/**
 	 * Updates and ensures the framebuffer surface is valid.
 	 * This needs to be invoked immediately after a resize event or the game will crash.
@@ -293,6 +320,9 @@ private:
 	int updated_locked_;
 	int flip_locked_;
 	int refresh_rate_;
+
+	/** Bumped by mark_framebuffer_changed(). */
+	unsigned int framebuffer_changes_;
 };
 
 /** An object which will lock the display for the duration of its lifetime. */
@@ -52,6 +52,7 @@
 #include "serialization/schema_validator.hpp" // for strict_validation_enabled and schema_validator
 #include "sound.hpp"                   // for commit_music_changes, etc
 #include "statistics.hpp"              // for fresh_stats
+#include "utils/alloc_tracking.hpp"    // for log_report
 #include <functional>
 #include "game_version.hpp"        // for version_info
 #include "video.hpp"          // for CVideo
@@ -93,6 +94,7 @@
 #include <ctime>     // for time, ctime, std::time_t
 #include <exception> // for exception
 #include <fstream>   // for operator<<, basic_ostream, etc
+#include <future>    // for async, future
 #include <iostream>  // for cerr, cout
 #include <vector>
 
@@ -122,6 +124,9 @@ static lg::log_domain log_preprocessor("preprocessor");
 static void safe_exit(int res)
 {
 	LOG_GENERAL << "exiting with code " << res << "\n";
+#ifdef WESNOTH_ALLOC_TRACKING
+	alloc_tracking::log_report(SDL_GetTicks());
+#endif
 	exit(res);
 }
 
@@ -675,6 +680,22 @@ static int do_gameloop(const std::vector<std::string>& args)
 		return 1;
 	}
 
+	// The heavyweight startup pieces that touch neither SDL nor the config
+	// cache can overlap the video and GUI2 initialization below: walking the
+	// data tree for the cache-validation checksum, and parsing the installed
+	// add-ons' _info.cfg files. Everything SDL-related has to stay on this
+	// thread, so the rest of the sequence is unchanged. Both futures are
+	// joined before the main thread touches the same state.
+	std::future<void> checksum_future = std::async(std::launch::async, []() {
+		filesystem::data_tree_checksum();
+	});
+
+	std::future<void> addon_versions_future = std::async(std::launch::async, [&cmdline_opts]() {
+		if(!cmdline_opts.noaddons) {
+			refresh_addon_version_info_cache();
+		}
+	});
+
 	res = game->init_video();
 	if(res == false) {
 		std::cerr << "could not initialize display\n";
@@ -694,8 +715,13 @@ static int do_gameloop(const std::vector<std::string>& args)
 		gui2::dialogs::migrate_version_selection::execute();
 	}
 
-	gui2::dialogs::loading_screen::display([&res, &config_manager, &cmdline_opts]() {
+	gui2::dialogs::loading_screen::display([&res, &config_manager, &checksum_future, &addon_versions_future]() {
 		gui2::dialogs::loading_screen::progress(loading_stage::load_config);
+
+		// The data tree checksum the cache validation wants has been
+		// computing in the background since before the video init.
+		checksum_future.get();
+
 		res = config_manager.init_game_config(game_config_manager::NO_FORCE_RELOAD);
 
 		if(res == false) {
@@ -711,11 +737,11 @@ static int do_gameloop(const std::vector<std::string>& args)
 			return;
 		}
 
-		if(!game_config::no_addons && !cmdline_opts.noaddons)  {
-			gui2::dialogs::loading_screen::progress(loading_stage::refresh_addons);
+		gui2::dialogs::loading_screen::progress(loading_stage::refresh_addons);
 
-			refresh_addon_version_info_cache();
-		}
+		// Same for the add-on version info cache, which only reads the
+		// add-ons' _info.cfg files; usually this join is a no-op by now.
+		addon_versions_future.get();
 	});
 
 	if(res == false) {
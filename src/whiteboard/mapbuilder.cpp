@@ -56,11 +56,6 @@ mapbuilder::~mapbuilder()
 
 void mapbuilder::pre_build()
 {
-	for (team& t : resources::gameboard->teams()) {
-		//Reset spent gold to zero, it'll be recalculated during the map building
-		t.get_side_actions()->reset_gold_spent();
-	}
-
 	int current_side = resources::controller->current_side();
 	for (unit& u : resources::gameboard->units()) {
 		bool on_current_side = (u.side() == current_side);
@@ -88,11 +83,20 @@ void mapbuilder::pre_build()
 
 void mapbuilder::build_map()
 {
-	pre_build();
+	for (team& t : resources::gameboard->teams()) {
+		//Reset spent gold to zero, it'll be recalculated during the map building
+		t.get_side_actions()->reset_gold_spent();
+	}
+
+	// Future map scopes are opened for most mouse interactions whether or
+	// not any plan exists; without actions the map stays as it is, so skip
+	// the per-unit movement resets and visibility removals of pre_build().
 	if(!wb::has_actions()) {
 		return;
 	}
 
+	pre_build();
+
 	bool stop = false;
 	for(std::size_t turn=0; !stop; ++turn) {
 		stop = true;
@@ -379,6 +379,7 @@ void menu::set_heading(const std::vector<std::string>& heading)
 {
 	itemRects_.clear();
 	column_widths_.clear();
+	rendered_cells_.clear();
 
 	heading_ = heading;
 	max_items_ = -1;
@@ -394,6 +395,7 @@ void menu::set_items(const std::vector<std::string>& items, bool strip_spaces, b
 	item_pos_.clear();
 	itemRects_.clear();
 	column_widths_.clear();
+	rendered_cells_.clear();
 	//undrawn_items_.clear();
 	max_items_ = -1; // Force recalculation of the max items.
 	item_height_ = -1; // Force recalculation of the item height.
@@ -861,6 +863,21 @@ void menu::clear_item(int item)
 	bg_restore(rect);
 }
 
+const menu::rendered_cell& menu::render_cell(const std::string& text, int max_width)
+{
+	const auto key = std::pair(text, max_width);
+	auto iter = rendered_cells_.find(key);
+	if(iter == rendered_cells_.end()) {
+		rendered_cell cell;
+		cell.line_size = font::pango_line_size(text, style_->get_font_size());
+		cell.text = font::pango_render_text(text, style_->get_font_size(), font::NORMAL_COLOR,
+			font::pango_text::STYLE_NORMAL, false, max_width);
+		iter = rendered_cells_.emplace(key, std::move(cell)).first;
+	}
+
+	return iter->second;
+}
+
 void menu::draw_row(const std::size_t row_index, const SDL_Rect& rect, ROW_TYPE type)
 {
 	//called from style, draws one row's contents in a generic and adaptable way
@@ -919,14 +936,12 @@ void menu::draw_row(const std::size_t row_index, const SDL_Rect& rect, ROW_TYPE
 			} else {
 				column.x = xpos;
 
-				const auto text_size = font::pango_line_size(str, style_->get_font_size());
+				const int avail_width = rect.w - (xpos - rect.x) - 2 * style_->get_thickness();
+				const rendered_cell& cell = render_cell(str, avail_width);
+				const std::pair<int, int>& text_size = cell.line_size;
 				const std::size_t y = rect.y + (rect.h - text_size.second)/2;
 				const std::size_t padding = 2;
-				SDL_Rect text_rect = column;
-				text_rect.w = rect.w - (xpos - rect.x) - 2 * style_->get_thickness();
-				text_rect.h = text_size.second;
-				font::pango_draw_text(&video(), text_rect, style_->get_font_size(), font::NORMAL_COLOR, str,
-					(type == HEADING_ROW ? xpos+padding : xpos), y);
+				video().blit_surface((type == HEADING_ROW ? xpos+padding : xpos), y, cell.text);
 
 				if(type == HEADING_ROW && sortby_ == int(i)) {
 					const surface sort_img = image::get_image(sortreversed_ ? "buttons/sliders/slider_arrow_blue.png" :
@@ -995,6 +1010,7 @@ void menu::draw()
 			clip_rect_setter(video().getSurface(), clip_rect(), clip_rect() != nullptr);
 
 	draw_contents();
+	video().mark_framebuffer_changed();
 
 	set_dirty(false);
 }
@@ -251,6 +251,20 @@ private:
 
 	mutable std::vector<int> column_widths_;
 
+	/**
+	 * Cached text renders of row cells, keyed by the cell text and the
+	 * width available to it. Hovering redraws rows continuously; without
+	 * this every redraw re-shapes and re-rasterizes all the row's text.
+	 */
+	struct rendered_cell
+	{
+		std::pair<int, int> line_size;
+		surface text;
+	};
+	std::map<std::pair<std::string, int>, rendered_cell> rendered_cells_;
+
+	const rendered_cell& render_cell(const std::string& text, int max_width);
+
 	std::size_t selected_;
 	bool click_selects_;
 	bool out_;
@@ -247,6 +247,7 @@ void widget::bg_restore() const
 		    i_end = restorer_.end(); i != i_end; ++i)
 			i->restore();
 		needs_restore_ = false;
+		video().mark_framebuffer_changed();
 	}
 }
 
@@ -257,6 +258,7 @@ void widget::bg_restore(const SDL_Rect& rect) const
 	for(std::vector< surface_restorer >::const_iterator i = restorer_.begin(),
 	    i_end = restorer_.end(); i != i_end; ++i)
 		i->restore(rect);
+	video().mark_framebuffer_changed();
 }
 
 void widget::set_volatile(bool val)
@@ -276,6 +278,7 @@ void widget::draw()
 	clip_rect_setter clipper(video().getSurface(), &clip_rect_, clip_);
 
 	draw_contents();
+	video().mark_framebuffer_changed();
 
 	set_dirty(false);
 }